@@ -76,6 +76,8 @@
 #import "AlfrescoWorkflowProcess.h"
 #import "AlfrescoWorkflowTask.h"
 #import "AlfrescoSearchLanguage.h"
+#import "AlfrescoDeltaSyncToken.h"
+#import "AlfrescoDeltaSyncResult.h"
 
 /**
  * Services
@@ -91,6 +93,8 @@
 #import "AlfrescoActivityStreamService.h"
 #import "AlfrescoWorkflowService.h"
 #import "AlfrescoPlaceholderDocumentFolderService.h"
+#import "AlfrescoDeltaSyncService.h"
+#import "AlfrescoUploadQueue.h"
 
 /**
  * Utils
@@ -98,5 +102,7 @@
 #import "AlfrescoConstants.h"
 #import "AlfrescoLog.h"
 #import "AlfrescoRequest.h"
+#import "AlfrescoRequestMetrics.h"
+#import "AlfrescoRequestMetricsHistogram.h"
 #import "AlfrescoErrors.h"
 #import "AlfrescoNetworkProvider.h"
@@ -38,6 +38,7 @@
 #import "AlfrescoTaskTypeDefinition.h"
 #import "AlfrescoAspectDefinition.h"
 #import "AlfrescoSAMLData.h"
+#import "AlfrescoDeltaSyncResult.h"
 
 @protocol AlfrescoSession;
 /** The AlfrescoConstants used in the SDK.
@@ -80,6 +81,7 @@ typedef void (^AlfrescoDocumentTypeDefinitionCompletionBlock)(AlfrescoDocumentTy
 typedef void (^AlfrescoFolderTypeDefinitionCompletionBlock)(AlfrescoFolderTypeDefinition *typeDefinition, NSError *error);
 typedef void (^AlfrescoTaskTypeDefinitionCompletionBlock)(AlfrescoTaskTypeDefinition *typeDefinition, NSError *error);
 typedef void (^AlfrescoAspectDefinitionCompletionBlock)(AlfrescoAspectDefinition *aspectDefinition, NSError *error);
+typedef void (^AlfrescoDeltaSyncCompletionBlock)(AlfrescoDeltaSyncResult *result, NSError *error);
 
 /**---------------------------------------------------------------------------------------
  * @name Session parameters
@@ -91,7 +93,17 @@ extern NSString * const kAlfrescoRequestTimeout;
 extern NSString * const kAlfrescoUseBackgroundNetworkSession;
 extern NSString * const kAlfrescoBackgroundNetworkSessionId;
 extern NSString * const kAlfrescoBackgroundNetworkSessionSharedContainerId;
+extern NSString * const kAlfrescoBackgroundNetworkSessionMaxConcurrentTransfers;
 extern NSString * const kAlfrescoHTTPShouldHandleCookies;
+extern NSString * const kAlfrescoRequestMetricsObserver;
+extern NSString * const kAlfrescoRetryPolicy;
+extern NSString * const kAlfrescoResponseCache;
+extern NSString * const kAlfrescoModelDefinitionSnapshotPath;
+extern NSString * const kAlfrescoModelDefinitionSnapshotMaxAge;
+extern NSString * const kAlfrescoContentDeduplication;
+extern NSString * const kAlfrescoContentFingerprintProperty;
+extern NSString * const kAlfrescoContentFingerprintSnapshotPath;
+extern NSString * const kAlfrescoCompletionQueue;
 
 /**---------------------------------------------------------------------------------------
  * @name thumbnail constant
@@ -321,6 +333,12 @@ extern NSString * const kAlfrescoWorkflowTaskTransitionApprove;
 extern NSString * const kAlfrescoWorkflowTaskTransitionAccept;
 extern NSString * const kAlfrescoWorkflowTaskTransitionReject;
 
+/**---------------------------------------------------------------------------------------
+ * @name OAuth Constants
+ --------------------------------------------------------------------------------------- */
+/// Posted by an AlfrescoCloudSession after it refreshed its access token, the object is the session and its oauthData holds the new tokens.
+extern NSString * const kAlfrescoOAuthDataRefreshedNotification;
+
 /**---------------------------------------------------------------------------------------
  * @name Connection Diagnostic Constants
  --------------------------------------------------------------------------------------- */
@@ -37,10 +37,20 @@ NSString * const kAlfrescoRequestTimeout = @"org.alfresco.mobile.features.reques
 NSString * const kAlfrescoUseBackgroundNetworkSession = @"org.alfresco.mobile.features.usebackgroundnetworksession";
 NSString * const kAlfrescoBackgroundNetworkSessionId = @"org.alfresco.mobile.features.networksessionid";
 NSString * const kAlfrescoBackgroundNetworkSessionSharedContainerId = @"org.alfresco.mobile.features.networksessionsharedcontainerid";
+NSString * const kAlfrescoBackgroundNetworkSessionMaxConcurrentTransfers = @"org.alfresco.mobile.features.networksessionmaxconcurrenttransfers";
 NSString * const kAlfrescoAllowUntrustedSSLCertificate = @"org.alfresco.mobile.features.allowuntrustedsslcertificate";
 NSString * const kAlfrescoConnectUsingClientSSLCertificate = @"org.alfresco.mobile.features.connectusingclientsslcertificate";
 NSString * const kAlfrescoClientCertificateCredentials = @"org.alfresco.mobile.features.clientcertificatecredentials";
 NSString * const kAlfrescoHTTPShouldHandleCookies = @"org.alfresco.mobile.features.httpshouldhandlecookies";
+NSString * const kAlfrescoRequestMetricsObserver = @"org.alfresco.mobile.features.requestmetricsobserver";
+NSString * const kAlfrescoRetryPolicy = @"org.alfresco.mobile.features.retrypolicy";
+NSString * const kAlfrescoResponseCache = @"org.alfresco.mobile.features.responsecache";
+NSString * const kAlfrescoModelDefinitionSnapshotPath = @"org.alfresco.mobile.features.modeldefinitionsnapshotpath";
+NSString * const kAlfrescoModelDefinitionSnapshotMaxAge = @"org.alfresco.mobile.features.modeldefinitionsnapshotmaxage";
+NSString * const kAlfrescoContentDeduplication = @"org.alfresco.mobile.features.contentdeduplication";
+NSString * const kAlfrescoContentFingerprintProperty = @"org.alfresco.mobile.features.contentfingerprintproperty";
+NSString * const kAlfrescoContentFingerprintSnapshotPath = @"org.alfresco.mobile.features.contentfingerprintsnapshotpath";
+NSString * const kAlfrescoCompletionQueue = @"org.alfresco.mobile.features.completionqueue";
 
 /**
  Thumbnail constants
@@ -265,6 +275,11 @@ NSString * const kAlfrescoWorkflowTaskTransitionApprove = @"Approve";
 NSString * const kAlfrescoWorkflowTaskTransitionAccept = @"Accept";
 NSString * const kAlfrescoWorkflowTaskTransitionReject = @"Reject";
 
+/**
+ OAuth Constants
+ */
+NSString * const kAlfrescoOAuthDataRefreshedNotification = @"AlfrescoOAuthDataRefreshedNotification";
+
 /**
  Connection Diagnostic Constants
  */
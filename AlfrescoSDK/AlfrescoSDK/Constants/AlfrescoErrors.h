@@ -32,6 +32,7 @@ typedef NS_ENUM(NSInteger, AlfrescoErrorCodes)
     kAlfrescoErrorCodeRequestedNodeNotFound = 2,
     kAlfrescoErrorCodeAccessDenied = 3,
     kAlfrescoErrorCodeNoNetworkConnection = 4,
+    kAlfrescoErrorCodeServerUnavailable = 5,
 
     kAlfrescoErrorCodeSession = 100,
     kAlfrescoErrorCodeUnauthorisedAccess = 101,
@@ -104,6 +105,7 @@ extern NSString * const kAlfrescoErrorDescriptionUnknown;
 extern NSString * const kAlfrescoErrorDescriptionRequestedNodeNotFound;
 extern NSString * const kAlfrescoErrorDescriptionAccessDenied;
 extern NSString * const kAlfrescoErrorDescriptionNoNetworkConnection;
+extern NSString * const kAlfrescoErrorDescriptionServerUnavailable;
 
 extern NSString * const kAlfrescoErrorDescriptionSession;
 extern NSString * const kAlfrescoErrorDescriptionNoRepositoryFound;
@@ -169,6 +171,8 @@ extern NSString * const kAlfrescoErrorDescriptionModelDefinitionNotFound;
 // Keys used in userInfo dictionary
 extern NSString * const kAlfrescoErrorKeyHTTPResponseCode;
 extern NSString * const kAlfrescoErrorKeyHTTPResponseBody;
+/// Present when some items of a multi item operation failed, maps the identifier of each failed item to its NSError.
+extern NSString * const kAlfrescoErrorKeyItemErrors;
 
 /** AlfrescoErrors is used in case an error occurs when executing an operation against the Alfresco repository.
  
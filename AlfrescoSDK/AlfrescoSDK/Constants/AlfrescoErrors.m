@@ -26,6 +26,7 @@ NSString * const kAlfrescoErrorDescriptionHTTPResponse= @"An error occurred on t
 NSString * const kAlfrescoErrorDescriptionRequestedNodeNotFound = @"The requested node wasn't found";
 NSString * const kAlfrescoErrorDescriptionAccessDenied = @"Access Denied";
 NSString * const kAlfrescoErrorDescriptionNoNetworkConnection = @"No Network Connection.";
+NSString * const kAlfrescoErrorDescriptionServerUnavailable = @"The server is unavailable, requests are not sent until it recovers";
 
 NSString * const kAlfrescoErrorDescriptionSession = @"Session Error";
 NSString * const kAlfrescoErrorDescriptionNoRepositoryFound = @"Session Error: No Alfresco repository found";
@@ -91,6 +92,7 @@ NSString * const kAlfrescoErrorDescriptionModelDefinitionNotFound = @"Model Defi
 // Keys used in userInfo dictionary
 NSString * const kAlfrescoErrorKeyHTTPResponseCode = @"org.alfresco.mobile.error.http.response.code";
 NSString * const kAlfrescoErrorKeyHTTPResponseBody = @"org.alfresco.mobile.error.http.response.body";
+NSString * const kAlfrescoErrorKeyItemErrors = @"org.alfresco.mobile.error.item.errors";
 
 
 @implementation AlfrescoErrors
@@ -260,6 +262,9 @@ NSString * const kAlfrescoErrorKeyHTTPResponseBody = @"org.alfresco.mobile.error
         case kAlfrescoErrorCodeNoNetworkConnection:
             alfrescoErrorDescription = kAlfrescoErrorDescriptionNoNetworkConnection;
             break;
+        case kAlfrescoErrorCodeServerUnavailable:
+            alfrescoErrorDescription = kAlfrescoErrorDescriptionServerUnavailable;
+            break;
         case kAlfrescoErrorCodeSession:
             alfrescoErrorDescription = kAlfrescoErrorDescriptionSession;
             break;
@@ -99,8 +99,9 @@ extern NSString * const kAlfrescoSessionUsername;
 extern NSString * const kAlfrescoSessionPassword;
 extern NSString * const kAlfrescoSessionCacheSites;
 extern NSString * const kAlfrescoSessionCacheFavorites;
-extern NSString * const kAlfrescoSessionCacheDefinitionType;
-extern NSString * const kAlfrescoSessionCacheDefinitionAspect;
+extern NSString * const kAlfrescoSessionCacheListings;
+extern NSString * const kAlfrescoSessionCacheDefinitions;
+extern NSString * const kAlfrescoSessionCacheFingerprints;
 extern NSString * const kAlfrescoSessionAlternatePersonIdentifier;
 extern NSTimeInterval const kAlfrescoSessionExpirationTimeIntervalCheck;
 
@@ -109,6 +110,9 @@ extern NSString * const kAlfrescoSiteIsMember;
 extern NSString * const kAlfrescoSiteIsPendingMember;
 
 extern NSString * const kAlfrescoAuthenticationProviderObjectKey;
+extern NSString * const kAlfrescoRequestMetricsObserverObjectKey;
+extern NSString * const kAlfrescoRetryPolicyObjectKey;
+extern NSString * const kAlfrescoResponseCacheObjectKey;
 
 extern NSString *const kAlfrescoJSONAccessToken;
 extern NSString *const kAlfrescoJSONRefreshToken;
@@ -128,6 +132,7 @@ extern NSString *const kAlfrescoOAuthScope;
 extern NSString *const kAlfrescoOAuthResponseType;
 extern NSString *const kAlfrescoOAuthGrantTypeRefresh;
 extern NSString *const kAlfrescoOAuthRefreshToken;
+extern NSString *const kAlfrescoOAuthFormContentType;
 
 extern NSString * const kAlfrescoLegacyAPIPath;
 extern NSString * const kAlfrescoLegacyCMISPath;
@@ -198,6 +203,7 @@ extern NSString * const kAlfrescoPublicAPIFavoriteFolders;
 extern NSString * const kAlfrescoPublicAPIFavoritesAll;
 extern NSString * const kAlfrescoPublicAPIFavorite;
 extern NSString * const kAlfrescoPublicAPIAddFavorite;
+extern NSString * const kAlfrescoPublicAPINodeRenditionContent;
 extern NSString * const kAlfrescoLegacyServerAPI;
 
 extern NSString * const kAlfrescoDocumentLibrary;
@@ -355,6 +361,7 @@ extern NSString * const kAlfrescoLegacyJSONHasMoreItems;
 
 extern NSString * const kAlfrescoNodeAspects;
 extern NSString * const kAlfrescoNodeProperties;
+extern NSString * const kAlfrescoNodeRecord;
 extern NSString * const kAlfrescoPropertyType;
 extern NSString * const kAlfrescoPropertyValue;
 extern NSString * const kAlfrescoPropertyIsMultiValued;
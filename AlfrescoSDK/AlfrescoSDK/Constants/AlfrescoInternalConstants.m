@@ -116,8 +116,9 @@ NSString * const kAlfrescoSessionUsername = @"org.alfresco.mobile.internal.sessi
 NSString * const kAlfrescoSessionPassword = @"org.alfresco.mobile.internal.session.password";
 NSString * const kAlfrescoSessionCacheSites = @"org.alfresco.mobile.internal.cache.sites";
 NSString * const kAlfrescoSessionCacheFavorites = @"org.alfresco.mobile.internal.cache.favorites";
-NSString * const kAlfrescoSessionCacheDefinitionType = @"org.alfresco.mobile.internal.cache.definition.type";
-NSString * const kAlfrescoSessionCacheDefinitionAspect = @"org.alfresco.mobile.internal.cache.definition.aspect";
+NSString * const kAlfrescoSessionCacheListings = @"org.alfresco.mobile.internal.cache.listings";
+NSString * const kAlfrescoSessionCacheDefinitions = @"org.alfresco.mobile.internal.cache.definitions";
+NSString * const kAlfrescoSessionCacheFingerprints = @"org.alfresco.mobile.internal.cache.fingerprints";
 NSTimeInterval const kAlfrescoSessionExpirationTimeIntervalCheck = 20;
 // Temporary for ACE-1445
 NSString * const kAlfrescoSessionAlternatePersonIdentifier = @"org.alfresco.mobile.internal.session.personIdentifier";
@@ -130,6 +131,9 @@ NSString * const kAlfrescoSiteIsPendingMember = @"isPendingMember";
  Associated object key constants
  */
 NSString * const kAlfrescoAuthenticationProviderObjectKey = @"AuthenticationProviderObjectKey";
+NSString * const kAlfrescoRequestMetricsObserverObjectKey = @"RequestMetricsObserverObjectKey";
+NSString * const kAlfrescoRetryPolicyObjectKey = @"RetryPolicyObjectKey";
+NSString * const kAlfrescoResponseCacheObjectKey = @"ResponseCacheObjectKey";
 
 /**
  OAuth Constants
@@ -152,6 +156,7 @@ NSString *const kAlfrescoOAuthScope = @"scope=pub_api";
 NSString *const kAlfrescoOAuthResponseType = @"response_type=code";
 NSString *const kAlfrescoOAuthGrantTypeRefresh = @"grant_type=refresh_token";
 NSString *const kAlfrescoOAuthRefreshToken = @"refresh_token={refreshID}";
+NSString *const kAlfrescoOAuthFormContentType = @"application/x-www-form-urlencoded";
 
 
 /**
@@ -233,6 +238,7 @@ NSString * const kAlfrescoPublicAPIFavoriteFolders = @"people/{personID}/favorit
 NSString * const kAlfrescoPublicAPIFavoritesAll = @"people/{personID}/favorites?where=(EXISTS(target/file) OR EXISTS(target/folder))";
 NSString * const kAlfrescoPublicAPIFavorite = @"people/{personID}/favorites/{nodeRef}";
 NSString * const kAlfrescoPublicAPIAddFavorite = @"people/-me-/favorites";
+NSString * const kAlfrescoPublicAPINodeRenditionContent = @"nodes/{nodeRef}/renditions/{renditionID}/content?attachment=false&placeholder=false";
 
 NSString * const kAlfrescoDocumentLibrary = @"documentLibrary";
 
@@ -395,6 +401,7 @@ NSString * const kAlfrescoLegacyJSONHasMoreItems = @"legacyHasMoreItems";
 
 NSString * const kAlfrescoNodeAspects = @"cmis.aspects";
 NSString * const kAlfrescoNodeProperties = @"cmis.properties";
+NSString * const kAlfrescoNodeRecord = @"cmis.record";
 NSString * const kAlfrescoPropertyType = @"type";
 NSString * const kAlfrescoPropertyValue = @"value";
 NSString * const kAlfrescoPropertyIsMultiValued = @"isMultiValued";
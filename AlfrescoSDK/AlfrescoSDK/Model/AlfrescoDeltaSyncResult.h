@@ -0,0 +1,56 @@
+/*
+ ******************************************************************************
+ * Copyright (C) 2005-2020 Alfresco Software Limited.
+ * 
+ * This file is part of the Alfresco Mobile SDK.
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *  
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *****************************************************************************
+ */
+
+#import <Foundation/Foundation.h>
+#import "AlfrescoDeltaSyncToken.h"
+
+/** The AlfrescoDeltaSyncResult is used to return the nodes that changed since the previous delta sync.
+ */
+
+@interface AlfrescoDeltaSyncResult : NSObject
+
+
+/// Returns the nodes that appeared in the watched folders, or watched nodes seen for the first time.
+@property (nonatomic, strong, readonly) NSArray *createdNodes;
+
+
+/// Returns the nodes that were modified.
+@property (nonatomic, strong, readonly) NSArray *updatedNodes;
+
+
+/// Returns the identifiers of the nodes that were deleted or moved out of the watched folders.
+@property (nonatomic, strong, readonly) NSArray *deletedNodeIdentifiers;
+
+
+/// Returns the token to store and pass to the next sync.
+@property (nonatomic, strong, readonly) AlfrescoDeltaSyncToken *syncToken;
+
+
+/// Returns YES if the changes were determined using the repository change log, NO if every watched folder and node was compared.
+@property (nonatomic, assign, readonly) BOOL usedChangeLog;
+
+
+- (id)initWithCreatedNodes:(NSArray *)createdNodes
+              updatedNodes:(NSArray *)updatedNodes
+    deletedNodeIdentifiers:(NSArray *)deletedNodeIdentifiers
+                 syncToken:(AlfrescoDeltaSyncToken *)syncToken
+             usedChangeLog:(BOOL)usedChangeLog;
+
+@end
@@ -0,0 +1,52 @@
+/*
+ ******************************************************************************
+ * Copyright (C) 2005-2020 Alfresco Software Limited.
+ * 
+ * This file is part of the Alfresco Mobile SDK.
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *  
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *****************************************************************************
+ */
+
+#import "AlfrescoDeltaSyncResult.h"
+
+@interface AlfrescoDeltaSyncResult ()
+@property (nonatomic, strong, readwrite) NSArray *createdNodes;
+@property (nonatomic, strong, readwrite) NSArray *updatedNodes;
+@property (nonatomic, strong, readwrite) NSArray *deletedNodeIdentifiers;
+@property (nonatomic, strong, readwrite) AlfrescoDeltaSyncToken *syncToken;
+@property (nonatomic, assign, readwrite) BOOL usedChangeLog;
+@end
+
+@implementation AlfrescoDeltaSyncResult
+
+
+- (id)initWithCreatedNodes:(NSArray *)createdNodes
+              updatedNodes:(NSArray *)updatedNodes
+    deletedNodeIdentifiers:(NSArray *)deletedNodeIdentifiers
+                 syncToken:(AlfrescoDeltaSyncToken *)syncToken
+             usedChangeLog:(BOOL)usedChangeLog
+{
+    self = [super init];
+    if (self)
+    {
+        self.createdNodes = createdNodes;
+        self.updatedNodes = updatedNodes;
+        self.deletedNodeIdentifiers = deletedNodeIdentifiers;
+        self.syncToken = syncToken;
+        self.usedChangeLog = usedChangeLog;
+    }
+    return self;
+}
+
+@end
@@ -0,0 +1,44 @@
+/*
+ ******************************************************************************
+ * Copyright (C) 2005-2020 Alfresco Software Limited.
+ * 
+ * This file is part of the Alfresco Mobile SDK.
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *  
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *****************************************************************************
+ */
+
+#import <Foundation/Foundation.h>
+
+/** The AlfrescoDeltaSyncToken captures the state of a set of watched folders and nodes at the end of a delta sync,
+ it should be stored by the client and handed back to the next sync to only retrieve what changed since.
+ */
+
+@interface AlfrescoDeltaSyncToken : NSObject <NSCoding>
+
+
+/// Returns the change log token the next sync continues reading the repository change log from, nil if the repository has no change log.
+@property (nonatomic, strong, readonly) NSString *changeLogToken;
+
+
+/// Returns the last known state (change token or modification date) of every synced node, keyed by version free node identifier.
+@property (nonatomic, strong, readonly) NSDictionary *nodeStates;
+
+
+/// Returns the identifiers of the children of every watched folder, keyed by version free folder identifier.
+@property (nonatomic, strong, readonly) NSDictionary *folderChildren;
+
+
+- (id)initWithChangeLogToken:(NSString *)changeLogToken nodeStates:(NSDictionary *)nodeStates folderChildren:(NSDictionary *)folderChildren;
+
+@end
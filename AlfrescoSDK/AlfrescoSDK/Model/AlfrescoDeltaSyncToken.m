@@ -0,0 +1,68 @@
+/*
+ ******************************************************************************
+ * Copyright (C) 2005-2020 Alfresco Software Limited.
+ * 
+ * This file is part of the Alfresco Mobile SDK.
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *  
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *****************************************************************************
+ */
+
+#import "AlfrescoDeltaSyncToken.h"
+
+static NSInteger kDeltaSyncTokenModelVersion = 1;
+
+@interface AlfrescoDeltaSyncToken ()
+@property (nonatomic, strong, readwrite) NSString *changeLogToken;
+@property (nonatomic, strong, readwrite) NSDictionary *nodeStates;
+@property (nonatomic, strong, readwrite) NSDictionary *folderChildren;
+@end
+
+@implementation AlfrescoDeltaSyncToken
+
+
+- (id)initWithChangeLogToken:(NSString *)changeLogToken nodeStates:(NSDictionary *)nodeStates folderChildren:(NSDictionary *)folderChildren
+{
+    self = [super init];
+    if (self)
+    {
+        self.changeLogToken = changeLogToken;
+        self.nodeStates = nodeStates ?: @{};
+        self.folderChildren = folderChildren ?: @{};
+    }
+    return self;
+}
+
+- (void)encodeWithCoder:(NSCoder *)aCoder
+{
+    [aCoder encodeInteger:kDeltaSyncTokenModelVersion forKey:@"AlfrescoDeltaSyncToken"];
+    [aCoder encodeObject:self.changeLogToken forKey:@"changeLogToken"];
+    [aCoder encodeObject:self.nodeStates forKey:@"nodeStates"];
+    [aCoder encodeObject:self.folderChildren forKey:@"folderChildren"];
+}
+
+- (id)initWithCoder:(NSCoder *)aDecoder
+{
+    self = [super init];
+    if (nil != self)
+    {
+        //uncomment this line if you need to check the model version
+//        NSInteger version = [aDecoder decodeIntForKey:@"AlfrescoDeltaSyncToken"];
+        self.changeLogToken = [aDecoder decodeObjectForKey:@"changeLogToken"];
+        self.nodeStates = [aDecoder decodeObjectForKey:@"nodeStates"] ?: @{};
+        self.folderChildren = [aDecoder decodeObjectForKey:@"folderChildren"] ?: @{};
+    }
+    return self;
+}
+
+@end
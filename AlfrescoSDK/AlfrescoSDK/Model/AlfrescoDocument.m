@@ -19,7 +19,6 @@
 #import "AlfrescoDocument.h"
 #import "CMISConstants.h"
 #import "AlfrescoInternalConstants.h"
-#import "AlfrescoProperty.h"
 
 static NSInteger kDocumentModelVersion = 1;
 
@@ -60,7 +59,7 @@ static NSInteger kDocumentModelVersion = 1;
     self.contentLength = [[properties valueForKey:kCMISPropertyContentStreamLength] unsignedLongLongValue];
     self.contentMimeType = [properties valueForKey:kCMISPropertyContentStreamMediaType];
     self.versionLabel = [properties valueForKey:kCMISPropertyVersionLabel];
-    self.versionComment = [(AlfrescoProperty *)[properties[kAlfrescoNodeProperties] valueForKey:kCMISPropertyCheckinComment] value];
+    self.versionComment = [self propertyValueWithName:kCMISPropertyCheckinComment];
 }
 
 - (void)encodeWithCoder:(NSCoder *)aCoder
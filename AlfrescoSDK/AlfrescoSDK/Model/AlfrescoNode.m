@@ -21,6 +21,7 @@
 #import "AlfrescoConstants.h"
 #import "AlfrescoInternalConstants.h"
 #import "CMISConstants.h"
+#import "AlfrescoCMISNodeRecord.h"
 
 static NSInteger kNodeModelVersion = 1;
 NSString * const kAlfrescoPermissionsObjectKey = @"AlfrescoPermissionsObjectKey";
@@ -39,6 +40,7 @@ NSString * const kAlfrescoPermissionsObjectKey = @"AlfrescoPermissionsObjectKey"
 @property (nonatomic, strong, readwrite) NSArray *aspects;
 @property (nonatomic, assign, readwrite) BOOL isFolder;
 @property (nonatomic, assign, readwrite) BOOL isDocument;
+@property (nonatomic, strong) AlfrescoCMISNodeRecord *record;
 @end
 
 
@@ -114,6 +116,45 @@ NSString * const kAlfrescoPermissionsObjectKey = @"AlfrescoPermissionsObjectKey"
     {
         self.properties = [properties valueForKey:kAlfrescoNodeProperties];
     }
+    if ([[properties allKeys] containsObject:kAlfrescoNodeRecord])
+    {
+        self.record = [properties valueForKey:kAlfrescoNodeRecord];
+    }
+}
+
+- (NSDictionary *)properties
+{
+    @synchronized(self)
+    {
+        if (nil == _properties && nil != self.record)
+        {
+            _properties = [self.record properties];
+            [self releaseRecordIfConverted];
+        }
+        return _properties;
+    }
+}
+
+- (NSArray *)aspects
+{
+    @synchronized(self)
+    {
+        if (nil == _aspects && nil != self.record)
+        {
+            // a node without aspects gets an empty array, otherwise the record would never be released
+            _aspects = [self.record aspects] ?: @[];
+            [self releaseRecordIfConverted];
+        }
+        return _aspects;
+    }
+}
+
+- (void)releaseRecordIfConverted
+{
+    if (nil != _properties && nil != _aspects)
+    {
+        self.record = nil;
+    }
 }
 
 - (void)encodeWithCoder:(NSCoder *)aCoder
@@ -156,6 +197,15 @@ NSString * const kAlfrescoPermissionsObjectKey = @"AlfrescoPermissionsObjectKey"
 
 - (id)propertyValueWithName:(NSString *)propertyName
 {
+    @synchronized(self)
+    {
+        // a single value is read straight from the record rather than converting every property
+        if (nil == _properties && nil != self.record)
+        {
+            return [self.record propertyValueWithName:propertyName];
+        }
+    }
+    
     AlfrescoProperty *property = (self.properties)[propertyName];
     id value;
     if(property != nil)
@@ -0,0 +1,65 @@
+/*
+ ******************************************************************************
+ * Copyright (C) 2005-2020 Alfresco Software Limited.
+ * 
+ * This file is part of the Alfresco Mobile SDK.
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *  
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *****************************************************************************
+ */
+
+#import <Foundation/Foundation.h>
+#import "AlfrescoConstants.h"
+#import "AlfrescoRequest.h"
+#import "AlfrescoDeltaSyncToken.h"
+#import "AlfrescoDeltaSyncResult.h"
+
+/** The AlfrescoDeltaSyncService determines which nodes changed in a set of watched folders and nodes (for example favorites)
+ since a previous sync, using the repository change log where available so unchanged content is not fetched again.
+ */
+
+@interface AlfrescoDeltaSyncService : NSObject
+
+/**---------------------------------------------------------------------------------------
+ * @name Initialisation
+ *  ---------------------------------------------------------------------------------------
+ */
+
+/** Initialises with a standard Cloud or OnPremise session
+ 
+ @param session the AlfrescoSession to initialise the delta sync service with.
+ */
+- (id)initWithSession:(id<AlfrescoSession>)session;
+
+/**---------------------------------------------------------------------------------------
+ * @name Sync methods.
+ *  ---------------------------------------------------------------------------------------
+ */
+
+/** Determines the nodes created, updated and deleted since the given sync token.
+ 
+ When the token carries a change log token and the repository supports change logs only the watched folders and nodes touched
+ by a change are fetched, otherwise every watched folder is listed and every watched node retrieved and compared with the token.
+ When no token is given every child and node is reported as created.
+ 
+ @param folderIdentifiers The identifiers of the folders whose direct children should be synced, can be nil.
+ @param nodeIdentifiers The identifiers of individual nodes to sync i.e. favorites, can be nil.
+ @param syncToken The token returned by the previous sync, nil for the first sync.
+ @param completionBlock The block that's called with the changes and the token to use for the next sync.
+ */
+- (AlfrescoRequest *)syncFolderIdentifiers:(NSArray *)folderIdentifiers
+                           nodeIdentifiers:(NSArray *)nodeIdentifiers
+                                 syncToken:(AlfrescoDeltaSyncToken *)syncToken
+                           completionBlock:(AlfrescoDeltaSyncCompletionBlock)completionBlock;
+
+@end
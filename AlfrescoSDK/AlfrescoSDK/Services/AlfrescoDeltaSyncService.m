@@ -0,0 +1,478 @@
+/*
+ ******************************************************************************
+ * Copyright (C) 2005-2020 Alfresco Software Limited.
+ * 
+ * This file is part of the Alfresco Mobile SDK.
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *  
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *****************************************************************************
+ */
+
+#import "AlfrescoDeltaSyncService.h"
+#import "AlfrescoInternalConstants.h"
+#import "AlfrescoCMISToAlfrescoObjectConverter.h"
+#import "AlfrescoObjectConverter.h"
+#import "AlfrescoCMISUtil.h"
+#import "AlfrescoErrors.h"
+#import "CMISSession.h"
+#import "CMISObjectList.h"
+#import "CMISObjectData.h"
+#import "CMISChangeEventInfo.h"
+#import "CMISStringInOutParameter.h"
+#import "CMISConstants.h"
+#import "CMISErrors.h"
+
+static NSInteger kDeltaSyncPageSize = 100;
+
+/**
+ Holds the working state of a single sync while its requests are chained one after the other.
+ */
+@interface AlfrescoDeltaSyncState : NSObject
+@property (nonatomic, strong) AlfrescoDeltaSyncToken *previousToken;
+@property (nonatomic, strong) NSString *changeLogToken;
+@property (nonatomic, assign) BOOL usedChangeLog;
+@property (nonatomic, strong) NSSet *watchedFolders;
+@property (nonatomic, strong) NSSet *watchedNodes;
+@property (nonatomic, strong) NSMutableSet *changedIdentifiers;
+@property (nonatomic, strong) NSMutableOrderedSet *foldersToList;
+@property (nonatomic, strong) NSMutableOrderedSet *nodesToRetrieve;
+@property (nonatomic, strong) NSMutableDictionary *seenNodes;
+@property (nonatomic, strong) NSMutableDictionary *seenStates;
+@property (nonatomic, strong) NSMutableDictionary *folderChildren;
+@property (nonatomic, strong) NSMutableSet *removedCandidates;
+@end
+
+@implementation AlfrescoDeltaSyncState
+@end
+
+@interface AlfrescoDeltaSyncService ()
+@property (nonatomic, strong, readwrite) id<AlfrescoSession> session;
+@property (nonatomic, strong, readwrite) CMISSession *cmisSession;
+@property (nonatomic, strong, readwrite) AlfrescoCMISToAlfrescoObjectConverter *objectConverter;
+@end
+
+@implementation AlfrescoDeltaSyncService
+
+- (id)initWithSession:(id<AlfrescoSession>)session
+{
+    // we can't do much without a session so just return nil
+    if (session == nil)
+    {
+        return nil;
+    }
+    
+    self = [super init];
+    if (nil != self)
+    {
+        self.session = session;
+        self.cmisSession = [session objectForParameter:kAlfrescoSessionKeyCmisSession];
+        self.objectConverter = [[AlfrescoCMISToAlfrescoObjectConverter alloc] initWithSession:self.session];
+    }
+    return self;
+}
+
+- (AlfrescoRequest *)syncFolderIdentifiers:(NSArray *)folderIdentifiers
+                           nodeIdentifiers:(NSArray *)nodeIdentifiers
+                                 syncToken:(AlfrescoDeltaSyncToken *)syncToken
+                           completionBlock:(AlfrescoDeltaSyncCompletionBlock)completionBlock
+{
+    [AlfrescoErrors assertArgumentNotNil:completionBlock argumentName:@"completionBlock"];
+    
+    AlfrescoDeltaSyncState *state = [AlfrescoDeltaSyncState new];
+    state.previousToken = syncToken ?: [[AlfrescoDeltaSyncToken alloc] initWithChangeLogToken:nil nodeStates:nil folderChildren:nil];
+    state.foldersToList = [NSMutableOrderedSet orderedSet];
+    state.nodesToRetrieve = [NSMutableOrderedSet orderedSet];
+    state.changedIdentifiers = [NSMutableSet set];
+    state.seenNodes = [NSMutableDictionary dictionary];
+    state.seenStates = [NSMutableDictionary dictionary];
+    state.folderChildren = [NSMutableDictionary dictionary];
+    state.removedCandidates = [NSMutableSet set];
+    for (NSString *identifier in folderIdentifiers)
+    {
+        [state.foldersToList addObject:[AlfrescoObjectConverter nodeRefWithoutVersionID:identifier]];
+    }
+    for (NSString *identifier in nodeIdentifiers)
+    {
+        [state.nodesToRetrieve addObject:[AlfrescoObjectConverter nodeRefWithoutVersionID:identifier]];
+    }
+    state.watchedFolders = state.foldersToList.set;
+    state.watchedNodes = state.nodesToRetrieve.set;
+    
+    AlfrescoRequest *request = [[AlfrescoRequest alloc] initWithService:self operation:_cmd];
+    
+    CMISRepositoryInfo *repositoryInfo = self.cmisSession.repositoryInfo;
+    BOOL supportsChangeLog = (repositoryInfo.repositoryCapabilities.capabilityChanges != CMISCapabilityChangesNone);
+    if (supportsChangeLog && nil != syncToken.changeLogToken)
+    {
+        [self readChangeLogFromToken:syncToken.changeLogToken state:state request:request completionBlock:^(BOOL succeeded) {
+            if (succeeded)
+            {
+                state.usedChangeLog = YES;
+                [self narrowWorkToChangesForState:state];
+            }
+            else
+            {
+                // the token may have expired or the change log been cleared, compare everything instead
+                state.changeLogToken = repositoryInfo.latestChangeLogToken;
+            }
+            [self listFoldersForState:state request:request completionBlock:completionBlock];
+        }];
+    }
+    else
+    {
+        // read before listing, replaying changes made while listing on the next sync is harmless
+        state.changeLogToken = supportsChangeLog ? repositoryInfo.latestChangeLogToken : nil;
+        [self listFoldersForState:state request:request completionBlock:completionBlock];
+    }
+    
+    return request;
+}
+
+#pragma mark - Change log
+
+- (void)readChangeLogFromToken:(NSString *)changeLogToken
+                         state:(AlfrescoDeltaSyncState *)state
+                       request:(AlfrescoRequest *)request
+               completionBlock:(void (^)(BOOL succeeded))completionBlock
+{
+    if (request.isCancelled)
+    {
+        completionBlock(NO);
+        return;
+    }
+    
+    CMISStringInOutParameter *tokenParameter = [CMISStringInOutParameter inOutParameterUsingInParameter:changeLogToken];
+    request.httpRequest = [self.cmisSession.binding.discoveryService retrieveContentChanges:tokenParameter
+                                                                         includeProperties:NO
+                                                                                    filter:nil
+                                                                                  maxItems:@(kDeltaSyncPageSize)
+                                                                           completionBlock:^(CMISObjectList *objectList, NSError *error) {
+        if (nil == objectList)
+        {
+            AlfrescoLogDebug(@"Could not read the change log, falling back to a full comparison: %@", error);
+            completionBlock(NO);
+            return;
+        }
+        
+        for (CMISObjectData *objectData in objectList.objects)
+        {
+            if (nil != objectData.identifier)
+            {
+                [state.changedIdentifiers addObject:[AlfrescoObjectConverter nodeRefWithoutVersionID:objectData.identifier]];
+            }
+        }
+        
+        NSString *nextToken = tokenParameter.outParameter ?: changeLogToken;
+        state.changeLogToken = nextToken;
+        if (objectList.hasMoreItems && ![nextToken isEqualToString:changeLogToken])
+        {
+            [self readChangeLogFromToken:nextToken state:state request:request completionBlock:completionBlock];
+        }
+        else
+        {
+            completionBlock(YES);
+        }
+    }];
+}
+
+- (void)narrowWorkToChangesForState:(AlfrescoDeltaSyncState *)state
+{
+    NSDictionary *previousChildren = state.previousToken.folderChildren;
+    NSDictionary *previousStates = state.previousToken.nodeStates;
+    
+    // an unknown identifier may be a new child of any of the watched folders
+    BOOL hasUnknownChange = NO;
+    for (NSString *identifier in state.changedIdentifiers)
+    {
+        if (nil == previousStates[identifier] && nil == previousChildren[identifier])
+        {
+            hasUnknownChange = YES;
+            break;
+        }
+    }
+    
+    if (!hasUnknownChange)
+    {
+        NSMutableOrderedSet *foldersToList = [NSMutableOrderedSet orderedSet];
+        for (NSString *folderIdentifier in state.foldersToList)
+        {
+            NSArray *children = previousChildren[folderIdentifier];
+            if (nil == children || [state.changedIdentifiers containsObject:folderIdentifier] ||
+                [state.changedIdentifiers intersectsSet:[NSSet setWithArray:children]])
+            {
+                [foldersToList addObject:folderIdentifier];
+            }
+        }
+        state.foldersToList = foldersToList;
+    }
+    
+    NSMutableOrderedSet *nodesToRetrieve = [NSMutableOrderedSet orderedSet];
+    for (NSString *nodeIdentifier in state.nodesToRetrieve)
+    {
+        if (nil == previousStates[nodeIdentifier] || [state.changedIdentifiers containsObject:nodeIdentifier])
+        {
+            [nodesToRetrieve addObject:nodeIdentifier];
+        }
+    }
+    state.nodesToRetrieve = nodesToRetrieve;
+    
+    // carry forward what is known about the folders that don't need listing again
+    for (NSString *folderIdentifier in state.watchedFolders)
+    {
+        if (![state.foldersToList containsObject:folderIdentifier] && nil != previousChildren[folderIdentifier])
+        {
+            state.folderChildren[folderIdentifier] = previousChildren[folderIdentifier];
+        }
+    }
+}
+
+#pragma mark - Listing and retrieval
+
+- (void)listFoldersForState:(AlfrescoDeltaSyncState *)state
+                    request:(AlfrescoRequest *)request
+            completionBlock:(AlfrescoDeltaSyncCompletionBlock)completionBlock
+{
+    if (state.foldersToList.count == 0)
+    {
+        [self retrieveNodesForState:state request:request completionBlock:completionBlock];
+        return;
+    }
+    
+    NSString *folderIdentifier = state.foldersToList.firstObject;
+    [state.foldersToList removeObjectAtIndex:0];
+    [self listChildrenOfFolder:folderIdentifier
+                     skipCount:0
+                      children:[NSMutableArray array]
+                         state:state
+                       request:request
+               completionBlock:^(NSError *error) {
+        if (nil != error)
+        {
+            completionBlock(nil, error);
+        }
+        else
+        {
+            [self listFoldersForState:state request:request completionBlock:completionBlock];
+        }
+    }];
+}
+
+- (void)listChildrenOfFolder:(NSString *)folderIdentifier
+                   skipCount:(NSInteger)skipCount
+                    children:(NSMutableArray *)children
+                       state:(AlfrescoDeltaSyncState *)state
+                     request:(AlfrescoRequest *)request
+             completionBlock:(void (^)(NSError *error))completionBlock
+{
+    if (request.isCancelled)
+    {
+        completionBlock([AlfrescoErrors alfrescoErrorWithAlfrescoErrorCode:kAlfrescoErrorCodeNetworkRequestCancelled]);
+        return;
+    }
+    
+    request.httpRequest = [self.cmisSession.binding.navigationService retrieveChildren:folderIdentifier
+                                                                               orderBy:nil
+                                                                                filter:nil
+                                                                         relationships:CMISIncludeRelationshipNone
+                                                                       renditionFilter:nil
+                                                               includeAllowableActions:YES
+                                                                    includePathSegment:NO
+                                                                             skipCount:@(skipCount)
+                                                                              maxItems:@(kDeltaSyncPageSize)
+                                                                       completionBlock:^(CMISObjectList *objectList, NSError *cmisError) {
+        if (nil == objectList)
+        {
+            if (cmisError.code == kCMISErrorCodeObjectNotFound)
+            {
+                // the watched folder itself has gone, so have all of its children
+                [state.removedCandidates addObject:folderIdentifier];
+                [state.removedCandidates addObjectsFromArray:state.previousToken.folderChildren[folderIdentifier]];
+                completionBlock(nil);
+            }
+            else
+            {
+                completionBlock([AlfrescoCMISUtil alfrescoErrorWithCMISError:cmisError]);
+            }
+            return;
+        }
+        
+        for (CMISObjectData *objectData in objectList.objects)
+        {
+            AlfrescoNode *node = [self.objectConverter nodeFromCMISObjectData:objectData];
+            if (nil != node)
+            {
+                [children addObject:[self recordNode:node state:state]];
+            }
+        }
+        
+        if (objectList.hasMoreItems && objectList.objects.count > 0)
+        {
+            [self listChildrenOfFolder:folderIdentifier
+                             skipCount:skipCount + objectList.objects.count
+                              children:children
+                                 state:state
+                               request:request
+                       completionBlock:completionBlock];
+        }
+        else
+        {
+            NSMutableSet *removedChildren = [NSMutableSet setWithArray:state.previousToken.folderChildren[folderIdentifier]];
+            [removedChildren minusSet:[NSSet setWithArray:children]];
+            [state.removedCandidates unionSet:removedChildren];
+            state.folderChildren[folderIdentifier] = [children copy];
+            completionBlock(nil);
+        }
+    }];
+}
+
+- (void)retrieveNodesForState:(AlfrescoDeltaSyncState *)state
+                      request:(AlfrescoRequest *)request
+              completionBlock:(AlfrescoDeltaSyncCompletionBlock)completionBlock
+{
+    if (state.nodesToRetrieve.count == 0)
+    {
+        completionBlock([self resultForState:state], nil);
+        return;
+    }
+    
+    if (request.isCancelled)
+    {
+        completionBlock(nil, [AlfrescoErrors alfrescoErrorWithAlfrescoErrorCode:kAlfrescoErrorCodeNetworkRequestCancelled]);
+        return;
+    }
+    
+    NSString *nodeIdentifier = state.nodesToRetrieve.firstObject;
+    [state.nodesToRetrieve removeObjectAtIndex:0];
+    
+    // nodes already listed as a child of a watched folder don't need fetching twice
+    if (nil != state.seenNodes[nodeIdentifier])
+    {
+        [self retrieveNodesForState:state request:request completionBlock:completionBlock];
+        return;
+    }
+    
+    request.httpRequest = [self.cmisSession.binding.objectService retrieveObject:nodeIdentifier
+                                                                          filter:nil
+                                                                   relationships:CMISIncludeRelationshipNone
+                                                                includePolicyIds:NO
+                                                                 renditionFilter:nil
+                                                                      includeACL:NO
+                                                         includeAllowableActions:YES
+                                                                 completionBlock:^(CMISObjectData *objectData, NSError *cmisError) {
+        if (nil == objectData)
+        {
+            if (cmisError.code != kCMISErrorCodeObjectNotFound)
+            {
+                completionBlock(nil, [AlfrescoCMISUtil alfrescoErrorWithCMISError:cmisError]);
+                return;
+            }
+            [state.removedCandidates addObject:nodeIdentifier];
+        }
+        else
+        {
+            AlfrescoNode *node = [self.objectConverter nodeFromCMISObjectData:objectData];
+            if (nil != node)
+            {
+                [self recordNode:node state:state];
+            }
+        }
+        [self retrieveNodesForState:state request:request completionBlock:completionBlock];
+    }];
+}
+
+#pragma mark - Comparison
+
+- (NSString *)recordNode:(AlfrescoNode *)node state:(AlfrescoDeltaSyncState *)state
+{
+    NSString *identifier = [AlfrescoObjectConverter nodeRefWithoutVersionID:node.identifier];
+    state.seenNodes[identifier] = node;
+    state.seenStates[identifier] = [self stateOfNode:node];
+    return identifier;
+}
+
+- (NSString *)stateOfNode:(AlfrescoNode *)node
+{
+    // the change token is the node's ETag, only fall back to the modification date if the repository doesn't expose one
+    id changeToken = [node propertyValueWithName:kCMISPropertyChangeToken];
+    if ([changeToken isKindOfClass:[NSString class]] && [changeToken length] > 0)
+    {
+        return changeToken;
+    }
+    return [NSString stringWithFormat:@"%.3f", node.modifiedAt.timeIntervalSince1970];
+}
+
+- (AlfrescoDeltaSyncResult *)resultForState:(AlfrescoDeltaSyncState *)state
+{
+    NSDictionary *previousStates = state.previousToken.nodeStates;
+    NSMutableArray *createdNodes = [NSMutableArray array];
+    NSMutableArray *updatedNodes = [NSMutableArray array];
+    
+    [state.seenNodes enumerateKeysAndObjectsUsingBlock:^(NSString *identifier, AlfrescoNode *node, BOOL *stop) {
+        NSString *previousState = previousStates[identifier];
+        if (nil == previousState)
+        {
+            [createdNodes addObject:node];
+        }
+        else if (![previousState isEqualToString:state.seenStates[identifier]])
+        {
+            [updatedNodes addObject:node];
+        }
+    }];
+    
+    NSMutableSet *childIdentifiers = [NSMutableSet set];
+    for (NSArray *children in state.folderChildren.allValues)
+    {
+        [childIdentifiers addObjectsFromArray:children];
+    }
+    
+    // a node moved between two watched folders is still present
+    NSMutableSet *removedIdentifiers = [state.removedCandidates mutableCopy];
+    [removedIdentifiers minusSet:[NSSet setWithArray:state.seenNodes.allKeys]];
+    [removedIdentifiers minusSet:childIdentifiers];
+    
+    NSMutableSet *currentIdentifiers = [NSMutableSet setWithArray:state.folderChildren.allKeys];
+    [currentIdentifiers unionSet:childIdentifiers];
+    [currentIdentifiers unionSet:state.watchedNodes];
+    [currentIdentifiers addObjectsFromArray:state.seenNodes.allKeys];
+    [currentIdentifiers minusSet:removedIdentifiers];
+    
+    NSMutableDictionary *nodeStates = [NSMutableDictionary dictionaryWithCapacity:currentIdentifiers.count];
+    for (NSString *identifier in currentIdentifiers)
+    {
+        NSString *nodeState = state.seenStates[identifier] ?: previousStates[identifier];
+        if (nil != nodeState)
+        {
+            nodeStates[identifier] = nodeState;
+        }
+    }
+    
+    NSMutableArray *deletedIdentifiers = [NSMutableArray array];
+    for (NSString *identifier in removedIdentifiers)
+    {
+        if (nil != previousStates[identifier] || nil != state.previousToken.folderChildren[identifier])
+        {
+            [deletedIdentifiers addObject:identifier];
+        }
+    }
+    
+    AlfrescoDeltaSyncToken *syncToken = [[AlfrescoDeltaSyncToken alloc] initWithChangeLogToken:state.changeLogToken
+                                                                                    nodeStates:nodeStates
+                                                                                folderChildren:state.folderChildren];
+    return [[AlfrescoDeltaSyncResult alloc] initWithCreatedNodes:createdNodes
+                                                    updatedNodes:updatedNodes
+                                          deletedNodeIdentifiers:deletedIdentifiers
+                                                       syncToken:syncToken
+                                                   usedChangeLog:state.usedChangeLog];
+}
+
+@end
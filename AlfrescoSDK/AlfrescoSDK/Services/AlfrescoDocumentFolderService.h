@@ -97,6 +97,9 @@
 
 /** Creates a new document using the contents of a local file. The new document is created within the given folder.
  
+ If the kAlfrescoContentDeduplication session parameter is set and the document created before with the same name, properties,
+ type and aspects in the folder still has the file's content, that document is returned and nothing is uploaded.
+ 
  @param documentName The name of the document to be created in the repository
  @param folder The parent folder to create the document in.
  @param file The local file to be uploaded.
@@ -362,6 +365,20 @@
                              completionBlock:(AlfrescoBOOLCompletionBlock)completionBlock;
 
 
+/** Retrieves the thumbnail rendition files for the given nodes, a limited number of renditions are downloaded at once.
+
+ If any rendition could not be retrieved the error contains the error for each of those nodes, keyed by node identifier,
+ under kAlfrescoErrorKeyItemErrors.
+
+ @param nodes The AlfrescoNodes for which thumbnail rendition images are to be retrieved.
+ @param renditionName The type of thumbnail to be retrieved. For example 'doclib' can be used (defined as _AlfrescoThumbnailRendition_ )
+ @param completionBlock The block that's called with a dictionary of AlfrescoContentFile objects keyed by node identifier.
+ */
+- (AlfrescoRequest *)retrieveRenditionsOfNodes:(NSArray *)nodes
+                                 renditionName:(NSString *)renditionName
+                               completionBlock:(AlfrescoDictionaryCompletionBlock)completionBlock;
+
+
 
 /**---------------------------------------------------------------------------------------
  * @name Updating/downloading documents and properties.
@@ -400,6 +417,9 @@
  Versioning is not guaranteed with this method, if the document is versioned on the server the update will generate
  a new minor version. If a new version is required use the checkout and checkin methods in AlfrescoVersionService.
  
+ If the kAlfrescoContentDeduplication session parameter is set, nothing is uploaded when the file's content matches the
+ content of the document's current version, the document is returned as it is.
+ 
  @param document The document that needs to be updated.
  @param contentFile The Alfresco Content File to be updated.
  @param completionBlock The block that's called with the updated document in case the operation succeeds.
@@ -463,6 +483,18 @@
                               aspects:(NSArray *)aspects
                       completionBlock:(AlfrescoNodeCompletionBlock)completionBlock;
 
+/** Moves a node from one folder to another.
+ 
+ @param node The node that needs to be moved.
+ @param sourceFolder The folder the node is currently in.
+ @param targetFolder The folder the node is moved to.
+ @param completionBlock The block that's called with the moved node in case the operation succeeds.
+ */
+- (AlfrescoRequest *)moveNode:(AlfrescoNode *)node
+                   fromFolder:(AlfrescoFolder *)sourceFolder
+                     toFolder:(AlfrescoFolder *)targetFolder
+              completionBlock:(AlfrescoNodeCompletionBlock)completionBlock;
+
 
 /**---------------------------------------------------------------------------------------
  * @name Deletes a node.
@@ -478,6 +510,60 @@
                 completionBlock:(AlfrescoBOOLCompletionBlock)completionBlock;
 
 
+/**---------------------------------------------------------------------------------------
+ * @name Bulk operations
+ *  ---------------------------------------------------------------------------------------
+ */
+
+/** Deletes the given nodes, a limited number of nodes are processed at once.
+ Folders are deleted with their whole tree first, nodes within a deleted tree need no request of their own.
+ 
+ If any node could not be deleted the error contains the error for each of those nodes, keyed by node identifier,
+ under kAlfrescoErrorKeyItemErrors. Cancelling the request reports the nodes not deleted yet as cancelled.
+ 
+ @param nodes The nodes that need to be deleted.
+ @param completionBlock The block that's called with the nodes that were deleted once every node has been processed.
+ @param progressBlock The block that's called with the number of nodes processed and the total number of nodes.
+ */
+- (AlfrescoRequest *)deleteNodes:(NSArray *)nodes
+                 completionBlock:(AlfrescoArrayCompletionBlock)completionBlock
+                   progressBlock:(AlfrescoProgressBlock)progressBlock;
+
+/** Moves the given nodes from one folder to another, a limited number of nodes are processed at once.
+ 
+ If any node could not be moved the error contains the error for each of those nodes, keyed by node identifier,
+ under kAlfrescoErrorKeyItemErrors. Cancelling the request reports the nodes not moved yet as cancelled.
+ 
+ @param nodes The nodes that need to be moved.
+ @param sourceFolder The folder the nodes are currently in.
+ @param targetFolder The folder the nodes are moved to.
+ @param completionBlock The block that's called with the moved nodes once every node has been processed.
+ @param progressBlock The block that's called with the number of nodes processed and the total number of nodes.
+ */
+- (AlfrescoRequest *)moveNodes:(NSArray *)nodes
+                    fromFolder:(AlfrescoFolder *)sourceFolder
+                      toFolder:(AlfrescoFolder *)targetFolder
+               completionBlock:(AlfrescoArrayCompletionBlock)completionBlock
+                 progressBlock:(AlfrescoProgressBlock)progressBlock;
+
+/** Applies the same property values to each of the given nodes, a limited number of nodes are processed at once.
+ Unlike updatePropertiesOfNode:properties:completionBlock: the nodes are not retrieved again after the update,
+ the completion block is called with the nodes as they were given.
+ 
+ If any node could not be updated the error contains the error for each of those nodes, keyed by node identifier,
+ under kAlfrescoErrorKeyItemErrors. Cancelling the request reports the nodes not updated yet as cancelled.
+ 
+ @param nodes The nodes that need to be updated.
+ @param properties The properties that need to be updated for each of the nodes.
+ @param completionBlock The block that's called with the nodes that were updated once every node has been processed.
+ @param progressBlock The block that's called with the number of nodes processed and the total number of nodes.
+ */
+- (AlfrescoRequest *)updatePropertiesOfNodes:(NSArray *)nodes
+                                  properties:(NSDictionary *)properties
+                             completionBlock:(AlfrescoArrayCompletionBlock)completionBlock
+                               progressBlock:(AlfrescoProgressBlock)progressBlock;
+
+
 /**---------------------------------------------------------------------------------------
  * @name Favorite or Unfavorite Documents, Folders, Nodes
  *  ---------------------------------------------------------------------------------------
@@ -558,6 +644,14 @@
                     completionBlock:(AlfrescoFavoritedCompletionBlock)completionBlock;
 
 
+/** The errors of the favorites that could not be resolved when the favorites were last retrieved, keyed by node identifier.
+ 
+ Favorites that have been deleted or are no longer accessible are left out of the retrieved favorites without failing
+ the call, they are reported here instead. Empty until the favorites have been retrieved.
+ */
+@property (nonatomic, strong, readonly) NSDictionary *unresolvedFavoriteErrors;
+
+
 /**---------------------------------------------------------------------------------------
  * @name Special folder handling
  *  ---------------------------------------------------------------------------------------
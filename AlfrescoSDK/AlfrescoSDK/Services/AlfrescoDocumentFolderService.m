@@ -38,6 +38,11 @@
 #import "AlfrescoLog.h"
 #import "AlfrescoCMISUtil.h"
 #import "AlfrescoFavoritesCache.h"
+#import "AlfrescoObjectConverter.h"
+#import "AlfrescoBulkNodeOperation.h"
+#import "AlfrescoContentFingerprint.h"
+#import "AlfrescoContentFingerprintStore.h"
+#import "AlfrescoSessionUtils.h"
 
 @interface AlfrescoDocumentFolderService ()
 @property (nonatomic, strong, readwrite) id<AlfrescoSession> session;
@@ -110,9 +115,14 @@
     [AlfrescoErrors assertArgumentNotNil:completionBlock argumentName:@"completionBlock"];
     
     NSDictionary *processedProperties = [self propertiesForName:folderName properties:properties type:type aspects:aspects isFolder:YES];
-    AlfrescoRequest *request = [[AlfrescoRequest alloc] init];
+    AlfrescoRequest *request = [[AlfrescoRequest alloc] initWithService:self operation:_cmd];
     request.httpRequest = [self.cmisSession createFolder:processedProperties inFolder:folder.identifier completionBlock:^(NSString *folderRef, NSError *error){
-        if (nil != folderRef)
+        if (nil != folderRef && request.isCancelled)
+        {
+            // the folder exists but the caller is no longer interested in it, so don't retrieve it
+            completionBlock(nil, [AlfrescoErrors alfrescoErrorWithAlfrescoErrorCode:kAlfrescoErrorCodeNetworkRequestCancelled]);
+        }
+        else if (nil != folderRef)
         {
             AlfrescoRequest *retrieveRequest = [self retrieveNodeWithIdentifier:folderRef completionBlock:^(AlfrescoNode *node, NSError *error) {
                 completionBlock((AlfrescoFolder *)node, error);
@@ -180,40 +190,45 @@
     [AlfrescoErrors assertArgumentNotNil:completionBlock argumentName:@"completionBlock"];
     
     NSDictionary *processedProperties = [self propertiesForName:documentName properties:properties type:type aspects:aspects isFolder:NO];
-    AlfrescoRequest *request = [[AlfrescoRequest alloc] init];
-    request.httpRequest = [self.cmisSession createDocumentFromFilePath:[file.fileUrl path] mimeType:file.mimeType properties:processedProperties inFolder:folder.identifier completionBlock:^(NSString *identifier, NSError *error){
-        if (nil == identifier)
+    AlfrescoRequest *request = [[AlfrescoRequest alloc] initWithService:self operation:_cmd];
+    if (![self isContentDeduplicationEnabled])
+    {
+        [self uploadDocumentWithName:documentName inParentFolder:folder contentFile:file properties:processedProperties
+                         fingerprint:nil request:request completionBlock:completionBlock progressBlock:progressBlock];
+        return request;
+    }
+    
+    [self fingerprintContentFile:file completionBlock:^(NSString *fingerprint) {
+        // only a document created with the same properties, type and aspects stands in for the one asked for
+        NSString *existingIdentifier = [[AlfrescoContentFingerprintStore fingerprintStoreForSession:self.session] identifierOfDocumentWithName:documentName
+                                                                                                                                  inFolder:folder
+                                                                                                                                properties:processedProperties];
+        if (request.isCancelled)
         {
-            NSError *alfrescoError = [AlfrescoCMISUtil alfrescoErrorWithCMISError:error];
-            completionBlock(nil, alfrescoError);
+            completionBlock(nil, [AlfrescoErrors alfrescoErrorWithAlfrescoErrorCode:kAlfrescoErrorCodeNetworkRequestCancelled]);
+        }
+        else if (nil == fingerprint || nil == existingIdentifier)
+        {
+            [self uploadDocumentWithName:documentName inParentFolder:folder contentFile:file properties:processedProperties
+                             fingerprint:fingerprint request:request completionBlock:completionBlock progressBlock:progressBlock];
         }
         else
         {
-            AlfrescoRequest *retrieveRequest = [self retrieveNodeWithIdentifier:identifier completionBlock:^(AlfrescoNode *node, NSError *error) {
-                
-                completionBlock((AlfrescoDocument *)node, error);
-                if (nil != node)
+            // the document created from the same content before is returned, as long as its content hasn't changed since
+            AlfrescoRequest *retrieveRequest = [self retrieveNodeWithIdentifier:existingIdentifier completionBlock:^(AlfrescoNode *node, NSError *retrieveError) {
+                if ([node isKindOfClass:[AlfrescoDocument class]] && [self document:(AlfrescoDocument *)node hasContentWithFingerprint:fingerprint])
                 {
-                    BOOL isExtractMetadata = [[self.session objectForParameter:kAlfrescoMetadataExtraction] boolValue];
-                    if (isExtractMetadata)
-                    {
-                        [self extractMetadataForNode:node alfrescoRequest:request];
-                    }
-                    BOOL isGenerateThumbnails = [[self.session objectForParameter:kAlfrescoThumbnailCreation] boolValue];
-                    if (isGenerateThumbnails)
-                    {
-                        [self generateThumbnailForNode:node alfrescoRequest:request];
-                    }
+                    AlfrescoLogDebug(@"Not uploading %@, the repository already has its content", documentName);
+                    completionBlock((AlfrescoDocument *)node, nil);
+                }
+                else
+                {
+                    [self uploadDocumentWithName:documentName inParentFolder:folder contentFile:file properties:processedProperties
+                                     fingerprint:fingerprint request:request completionBlock:completionBlock progressBlock:progressBlock];
                 }
             }];
-            
             request.httpRequest = retrieveRequest.httpRequest;
         }
-    } progressBlock:^(unsigned long long bytesUploaded, unsigned long long bytesTotal){
-        if (progressBlock)
-        {
-            progressBlock(bytesUploaded, bytesTotal);
-        }
     }];
     return request;
 }
@@ -271,7 +286,7 @@
     [AlfrescoErrors assertArgumentNotNil:completionBlock argumentName:@"completionBlock"];
 
     NSDictionary *processedProperties = [self propertiesForName:documentName properties:properties type:type aspects:aspects isFolder:NO];
-    AlfrescoRequest *request = [[AlfrescoRequest alloc] init];
+    AlfrescoRequest *request = [[AlfrescoRequest alloc] initWithService:self operation:_cmd];
     request.httpRequest = [self.cmisSession createDocumentFromInputStream:contentStream.inputStream
                                                                  mimeType:contentStream.mimeType
                                                                properties:processedProperties
@@ -283,6 +298,10 @@
             NSError *alfrescoError = [AlfrescoCMISUtil alfrescoErrorWithCMISError:error];
             completionBlock(nil, alfrescoError);
         }
+        else if (request.isCancelled)
+        {
+            completionBlock(nil, [AlfrescoErrors alfrescoErrorWithAlfrescoErrorCode:kAlfrescoErrorCodeNetworkRequestCancelled]);
+        }
         else
         {
             AlfrescoRequest *retrieveRequest = [self retrieveNodeWithIdentifier:objectId completionBlock:^(AlfrescoNode *node, NSError *error) {
@@ -318,7 +337,7 @@
 - (AlfrescoRequest *)retrieveRootFolderWithCompletionBlock:(AlfrescoFolderCompletionBlock)completionBlock
 {
     [AlfrescoErrors assertArgumentNotNil:completionBlock argumentName:@"completionBlock"];
-    AlfrescoRequest *request = [[AlfrescoRequest alloc] init];
+    AlfrescoRequest *request = [[AlfrescoRequest alloc] initWithService:self operation:_cmd];
     request.httpRequest = [self.cmisSession retrieveRootFolderWithCompletionBlock:^(CMISFolder *cmisFolder, NSError *error){
         AlfrescoFolder *rootFolder = nil;
         if (nil != cmisFolder)
@@ -405,7 +424,7 @@
         maxItems = [NSNumber numberWithInt:listingContext.maxItems];
     }
     
-    AlfrescoRequest *request = [[AlfrescoRequest alloc] init];
+    AlfrescoRequest *request = [[AlfrescoRequest alloc] initWithService:self operation:_cmd];
 
     request.httpRequest = [self.cmisSession.binding.navigationService retrieveChildren:folder.identifier
                                                                                orderBy:[self cmisOrderByPropertyForListingContext:listingContext]
@@ -538,7 +557,7 @@
     [AlfrescoErrors assertArgumentNotNil:identifier argumentName:@"identifier"];
     [AlfrescoErrors assertArgumentNotNil:completionBlock argumentName:@"completionBlock"];
 
-    AlfrescoRequest *request = [[AlfrescoRequest alloc] init];
+    AlfrescoRequest *request = [[AlfrescoRequest alloc] initWithService:self operation:_cmd];
     request.httpRequest = [self.cmisSession retrieveObject:identifier completionBlock:^(CMISObject *cmisObject, NSError *error){
         if (nil == cmisObject)
         {
@@ -569,7 +588,7 @@
     [AlfrescoErrors assertArgumentNotNil:path argumentName:@"path"];
     [AlfrescoErrors assertArgumentNotNil:completionBlock argumentName:@"completionBlock"];
     
-    AlfrescoRequest *request = [[AlfrescoRequest alloc] init];
+    AlfrescoRequest *request = [[AlfrescoRequest alloc] initWithService:self operation:_cmd];
     request.httpRequest = [self.cmisSession retrieveObjectByPath:path completionBlock:^(CMISObject *cmisObject, NSError *error){
         if (nil == cmisObject)
         {
@@ -600,13 +619,17 @@
     [AlfrescoErrors assertArgumentNotNil:folder.identifier argumentName:@"folder.identifer"];
     [AlfrescoErrors assertArgumentNotNil:completionBlock argumentName:@"completionBlock"];
     
-    AlfrescoRequest *request = [[AlfrescoRequest alloc] init];
+    AlfrescoRequest *request = [[AlfrescoRequest alloc] initWithService:self operation:_cmd];
     request.httpRequest = [self.cmisSession retrieveObject:folder.identifier completionBlock:^(CMISObject *cmisObject, NSError *error){
         if (nil == cmisObject)
         {
             NSError *alfrescoError = [AlfrescoCMISUtil alfrescoErrorWithCMISError:error];
             completionBlock(nil, alfrescoError);
         }
+        else if (request.isCancelled)
+        {
+            completionBlock(nil, [AlfrescoErrors alfrescoErrorWithAlfrescoErrorCode:kAlfrescoErrorCodeNetworkRequestCancelled]);
+        }
         else
         {
             CMISFolder *folder = (CMISFolder *)cmisObject;
@@ -625,7 +648,7 @@
     [AlfrescoErrors assertArgumentNotNil:node.identifier argumentName:@"node.identifer"];
     [AlfrescoErrors assertArgumentNotNil:completionBlock argumentName:@"completionBlock"];
     
-    AlfrescoRequest *request = [[AlfrescoRequest alloc] init];
+    AlfrescoRequest *request = [[AlfrescoRequest alloc] initWithService:self operation:_cmd];
     request.httpRequest = [self.cmisSession.binding.navigationService retrieveParentsForObject:node.identifier
                                                                                         filter:nil
                                                                                  relationships:CMISIncludeRelationshipBoth
@@ -678,6 +701,31 @@
     return nil;
 }
 
+- (AlfrescoRequest *)retrieveRenditionsOfNodes:(NSArray *)nodes
+                                 renditionName:(NSString *)renditionName
+                               completionBlock:(AlfrescoDictionaryCompletionBlock)completionBlock
+{
+    [AlfrescoErrors assertArgumentNotNil:nodes argumentName:@"nodes"];
+    [AlfrescoErrors assertArgumentNotNil:renditionName argumentName:@"renditionName"];
+    [AlfrescoErrors assertArgumentNotNil:completionBlock argumentName:@"completionBlock"];
+    
+    AlfrescoRequest *request = [[AlfrescoRequest alloc] initWithService:self operation:_cmd];
+    AlfrescoBulkNodeOperation *renditionsOperation = [[AlfrescoBulkNodeOperation alloc] initWithNodes:nodes operationBlock:^AlfrescoRequest *(AlfrescoNode *node, AlfrescoBulkNodeItemCompletionBlock itemCompletionBlock) {
+        return [self retrieveRenditionOfNode:node renditionName:renditionName completionBlock:^(AlfrescoContentFile *contentFile, NSError *error) {
+            if (nil == contentFile && nil == error)
+            {
+                error = [AlfrescoErrors alfrescoErrorWithAlfrescoErrorCode:kAlfrescoErrorCodeDocumentFolderNoThumbnail];
+            }
+            itemCompletionBlock(contentFile, error);
+        }];
+    }];
+    renditionsOperation.completionQueue = [AlfrescoSessionUtils completionQueueForSession:self.session];
+    [renditionsOperation startWithRequest:request completionBlock:^(NSDictionary *contentFiles, NSDictionary *itemErrors) {
+        completionBlock(contentFiles, [AlfrescoBulkNodeOperation errorWithCode:kAlfrescoErrorCodeDocumentFolder itemErrors:itemErrors]);
+    }];
+    return request;
+}
+
 - (AlfrescoRequest *)retrieveContentOfDocument:(AlfrescoDocument *)document
                                completionBlock:(AlfrescoContentFileCompletionBlock)completionBlock
                                  progressBlock:(AlfrescoProgressBlock)progressBlock
@@ -688,7 +736,7 @@
 
     NSString *identifier = [document.identifier stringByReplacingOccurrencesOfString:kAlfrescoLegacyAPINodeRefPrefix withString:@""];
     NSString *tmpFile = [[NSTemporaryDirectory() stringByAppendingPathComponent:identifier] stringByAppendingPathExtension:[document.name pathExtension]];
-    AlfrescoRequest *request = [[AlfrescoRequest alloc] init];
+    AlfrescoRequest *request = [[AlfrescoRequest alloc] initWithService:self operation:_cmd];
     request.httpRequest = [self.cmisSession downloadContentOfCMISObject:document.identifier toFile:tmpFile completionBlock:^(NSError *error){
         if (error)
         {
@@ -698,7 +746,19 @@
         else
         {
             AlfrescoContentFile *downloadedFile = [[AlfrescoContentFile alloc]initWithUrl:[NSURL fileURLWithPath:tmpFile]];
-            completionBlock(downloadedFile, nil);
+            if ([self isContentDeduplicationEnabled])
+            {
+                // remember what the content of this version is, so uploading it back unchanged can be skipped,
+                // before the caller gets the file and may change or move it
+                [self fingerprintContentFile:downloadedFile completionBlock:^(NSString *fingerprint) {
+                    [[AlfrescoContentFingerprintStore fingerprintStoreForSession:self.session] recordFingerprint:fingerprint ofDocument:document];
+                    completionBlock(downloadedFile, nil);
+                }];
+            }
+            else
+            {
+                completionBlock(downloadedFile, nil);
+            }
         }
     } progressBlock:^(unsigned long long bytesDownloaded, unsigned long long bytesTotal){
         if (progressBlock)
@@ -718,7 +778,7 @@
     [AlfrescoErrors assertArgumentNotNil:document.identifier argumentName:@"document.identifer"];
     [AlfrescoErrors assertArgumentNotNil:completionBlock argumentName:@"completionBlock"];
     
-    AlfrescoRequest *request = [[AlfrescoRequest alloc] init];
+    AlfrescoRequest *request = [[AlfrescoRequest alloc] initWithService:self operation:_cmd];
     request.httpRequest = [self.cmisSession downloadContentOfCMISObject:document.identifier toOutputStream:outputStream completionBlock:^(NSError *error) {
         if (error)
         {
@@ -749,57 +809,17 @@
     [AlfrescoErrors assertArgumentNotNil:document.identifier argumentName:@"document.identifer"];
     [AlfrescoErrors assertArgumentNotNil:completionBlock argumentName:@"completionBlock"];
     
-    AlfrescoRequest *request = [[AlfrescoRequest alloc] init];
-    request.httpRequest = [self.cmisSession retrieveObject:document.identifier completionBlock:^(CMISObject *cmisObject, NSError *error){
-        if (nil == cmisObject)
-        {
-            NSError *alfrescoError = [AlfrescoCMISUtil alfrescoErrorWithCMISError:error];
-            completionBlock(nil, alfrescoError);
-        }
-        else
-        {
-            CMISDocument *cmisDocument = (CMISDocument *)cmisObject;
-            request.httpRequest = [cmisDocument changeContentToContentOfInputStream:contentStream.inputStream
-                                                                      bytesExpected:contentStream.length
-                                                                           fileName:document.name
-                                                                           mimeType:contentStream.mimeType
-                                                                          overwrite:YES
-                                                                    completionBlock:^(NSError *error){
-                if (error)
-                {
-                    completionBlock(nil, error);
-                }
-                else
-                {
-                    NSString *versionSeriesId = [cmisObject.properties propertyValueForId:@"cmis:versionSeriesId"];
-                    request.httpRequest = [self.cmisSession retrieveObject:versionSeriesId completionBlock:^(CMISObject *updatedObject, NSError *updatedError){
-                        if (nil == updatedObject)
-                        {
-                            NSError *alfrescoError = [AlfrescoCMISUtil alfrescoErrorWithCMISError:updatedError];
-                            completionBlock(nil, alfrescoError);
-                        }
-                        else
-                        {
-                            AlfrescoDocument *alfrescoDocument = (AlfrescoDocument *)[self.objectConverter nodeFromCMISObject:updatedObject];
-                            NSError *alfrescoError = nil;
-                            if (nil == alfrescoDocument)
-                            {
-                                alfrescoError = [AlfrescoErrors alfrescoErrorWithAlfrescoErrorCode:kAlfrescoErrorCodeDocumentFolderFailedToConvertNode];
-                            }
-                            completionBlock(alfrescoDocument, alfrescoError);
-                        }
-                    }];
-                }
-            } progressBlock:^(unsigned long long bytesUploaded, unsigned long long bytesTotal){
-                if(progressBlock && 0 < contentStream.length)
-                {
-                    progressBlock(bytesUploaded, bytesTotal);
-                }
-            }];
-        }
-    }];
-    return request;
-    
+    return [self updateContentOfDocument:document
+                             inputStream:contentStream.inputStream
+                           bytesExpected:contentStream.length
+                                mimeType:contentStream.mimeType
+                         completionBlock:completionBlock
+                           progressBlock:^(unsigned long long bytesUploaded, unsigned long long bytesTotal){
+                               if(progressBlock && 0 < contentStream.length)
+                               {
+                                   progressBlock(bytesUploaded, bytesTotal);
+                               }
+                           }];
 }
 
 - (AlfrescoRequest *)updateContentOfDocument:(AlfrescoDocument *)document
@@ -812,51 +832,50 @@
     [AlfrescoErrors assertArgumentNotNil:document.identifier argumentName:@"document.identifer"];
     [AlfrescoErrors assertArgumentNotNil:completionBlock argumentName:@"completionBlock"];
     
-    AlfrescoRequest *request = [[AlfrescoRequest alloc] init];
-    request.httpRequest = [self.cmisSession retrieveObject:document.identifier completionBlock:^(CMISObject *cmisObject, NSError *error){
-        if (nil == cmisObject)
+    if (![self isContentDeduplicationEnabled])
+    {
+        return [self uploadContentOfDocument:document contentFile:file completionBlock:completionBlock progressBlock:progressBlock];
+    }
+    
+    AlfrescoRequest *request = [[AlfrescoRequest alloc] initWithService:self operation:_cmd];
+    [self fingerprintContentFile:file completionBlock:^(NSString *fingerprint) {
+        if (request.isCancelled)
         {
-            NSError *alfrescoError = [AlfrescoCMISUtil alfrescoErrorWithCMISError:error];
-            completionBlock(nil, alfrescoError);
+            completionBlock(nil, [AlfrescoErrors alfrescoErrorWithAlfrescoErrorCode:kAlfrescoErrorCodeNetworkRequestCancelled]);
+        }
+        else if (nil == fingerprint)
+        {
+            [self uploadContentOfDocument:document contentFile:file fingerprint:nil request:request completionBlock:completionBlock progressBlock:progressBlock];
         }
         else
         {
-            CMISDocument *document = (CMISDocument *)cmisObject;
-            request.httpRequest = [document changeContentToContentOfFile:[file.fileUrl path] mimeType:file.mimeType overwrite:YES completionBlock:^(NSError *error){
-                if (error)
+            // the caller's document may be out of date, the content is compared with the current version in the repository
+            NSString *versionSeriesId = [document propertyValueWithName:kCMISPropertyVersionSeriesId];
+            if (nil == versionSeriesId)
+            {
+                versionSeriesId = [AlfrescoObjectConverter nodeRefWithoutVersionID:document.identifier];
+            }
+            AlfrescoRequest *retrieveRequest = [self retrieveNodeWithIdentifier:versionSeriesId completionBlock:^(AlfrescoNode *node, NSError *retrieveError) {
+                if (request.isCancelled)
                 {
-                    completionBlock(nil, error);
+                    completionBlock(nil, [AlfrescoErrors alfrescoErrorWithAlfrescoErrorCode:kAlfrescoErrorCodeNetworkRequestCancelled]);
                 }
-                else
+                else if ([node isKindOfClass:[AlfrescoDocument class]] && [self document:(AlfrescoDocument *)node hasContentWithFingerprint:fingerprint])
                 {
-                    NSString *versionSeriesId = [cmisObject.properties propertyValueForId:@"cmis:versionSeriesId"];
-                    request.httpRequest = [self.cmisSession retrieveObject:versionSeriesId completionBlock:^(CMISObject *updatedObject, NSError *updatedError){
-                        if (nil == updatedObject)
-                        {
-                            NSError *alfrescoError = [AlfrescoCMISUtil alfrescoErrorWithCMISError:updatedError];
-                            completionBlock(nil, alfrescoError);
-                        }
-                        else
-                        {
-                            AlfrescoDocument *alfrescoDocument = (AlfrescoDocument *)[self.objectConverter nodeFromCMISObject:updatedObject];
-                            NSError *alfrescoError = nil;
-                            if (nil == alfrescoDocument)
-                            {
-                                alfrescoError = [AlfrescoErrors alfrescoErrorWithAlfrescoErrorCode:kAlfrescoErrorCodeDocumentFolderFailedToConvertNode];
-                            }
-                            completionBlock(alfrescoDocument, alfrescoError);
-                        }
-                    }];
+                    AlfrescoLogDebug(@"Not uploading the content of %@, it matches the content of the current version", document.name);
+                    completionBlock((AlfrescoDocument *)node, nil);
                 }
-            } progressBlock:^(unsigned long long bytesUploaded, unsigned long long bytesTotal){
-                if(progressBlock)
+                else
                 {
-                    progressBlock(bytesUploaded, bytesTotal);
+                    AlfrescoDocument *currentDocument = [node isKindOfClass:[AlfrescoDocument class]] ? (AlfrescoDocument *)node : document;
+                    [self uploadContentOfDocument:currentDocument contentFile:file fingerprint:fingerprint request:request
+                                  completionBlock:completionBlock progressBlock:progressBlock];
                 }
             }];
+            request.httpRequest = retrieveRequest.httpRequest;
         }
     }];
-    return request;    
+    return request;
 }
 
 
@@ -879,7 +898,7 @@
     // remember the versionSeriesId of the node
     NSString *versionSeriesId = [node propertyValueWithName:kCMISPropertyVersionSeriesId];
     
-    AlfrescoRequest *request = [[AlfrescoRequest alloc] init];
+    AlfrescoRequest *request = [[AlfrescoRequest alloc] initWithService:self operation:_cmd];
     [AlfrescoCMISUtil preparePropertiesForUpdate:properties
                                          aspects:aspects
                                             node:node
@@ -903,6 +922,10 @@
                     NSError *alfrescoError = [AlfrescoCMISUtil alfrescoErrorWithCMISError:updateError];
                     completionBlock(nil, alfrescoError);
                 }
+                else if (request.isCancelled)
+                {
+                    completionBlock(nil, [AlfrescoErrors alfrescoErrorWithAlfrescoErrorCode:kAlfrescoErrorCodeNetworkRequestCancelled]);
+                }
                 else
                 {
                     request.httpRequest = [self.cmisSession retrieveObject:versionSeriesId completionBlock:^(CMISObject *updatedCMISObject, NSError *retrievalError) {
@@ -943,7 +966,7 @@
     [AlfrescoErrors assertArgumentNotNil:node.identifier argumentName:@"node.identifer"];
     [AlfrescoErrors assertArgumentNotNil:completionBlock argumentName:@"completionBlock"];
 
-    AlfrescoRequest *request = [[AlfrescoRequest alloc] init];
+    AlfrescoRequest *request = [[AlfrescoRequest alloc] initWithService:self operation:_cmd];
     if ([node isKindOfClass:[AlfrescoDocument class]])
     {
         request.httpRequest = [self.cmisSession.binding.objectService deleteObject:node.identifier allVersions:YES completionBlock:^(BOOL objectDeleted, NSError *error){
@@ -976,8 +999,510 @@
         
 }
 
+- (AlfrescoRequest *)moveNode:(AlfrescoNode *)node
+                   fromFolder:(AlfrescoFolder *)sourceFolder
+                     toFolder:(AlfrescoFolder *)targetFolder
+              completionBlock:(AlfrescoNodeCompletionBlock)completionBlock
+{
+    [AlfrescoErrors assertArgumentNotNil:node argumentName:@"node"];
+    [AlfrescoErrors assertArgumentNotNil:node.identifier argumentName:@"node.identifer"];
+    [AlfrescoErrors assertArgumentNotNil:sourceFolder argumentName:@"sourceFolder"];
+    [AlfrescoErrors assertArgumentNotNil:targetFolder argumentName:@"targetFolder"];
+    [AlfrescoErrors assertArgumentNotNil:completionBlock argumentName:@"completionBlock"];
+    
+    AlfrescoRequest *request = [[AlfrescoRequest alloc] initWithService:self operation:_cmd];
+    request.httpRequest = [self.cmisSession.binding.objectService moveObject:node.identifier
+                                                                  fromFolder:sourceFolder.identifier
+                                                                    toFolder:targetFolder.identifier
+                                                             completionBlock:^(CMISObjectData *objectData, NSError *error) {
+        if (nil == objectData)
+        {
+            NSError *alfrescoError = [AlfrescoCMISUtil alfrescoErrorWithCMISError:error];
+            completionBlock(nil, alfrescoError);
+        }
+        else
+        {
+            AlfrescoNode *movedNode = [self.objectConverter nodeFromCMISObjectData:objectData];
+            NSError *conversionError = nil;
+            if (nil == movedNode)
+            {
+                conversionError = [AlfrescoErrors alfrescoErrorWithAlfrescoErrorCode:kAlfrescoErrorCodeDocumentFolderFailedToConvertNode];
+            }
+            completionBlock(movedNode, conversionError);
+        }
+    }];
+    return request;
+}
+
+#pragma mark - Bulk methods
+
+- (AlfrescoRequest *)deleteNodes:(NSArray *)nodes
+                 completionBlock:(AlfrescoArrayCompletionBlock)completionBlock
+                   progressBlock:(AlfrescoProgressBlock)progressBlock
+{
+    [AlfrescoErrors assertArgumentNotNil:nodes argumentName:@"nodes"];
+    [AlfrescoErrors assertArgumentNotNil:completionBlock argumentName:@"completionBlock"];
+    
+    // folders are deleted with their whole tree first, selected folders within one of those trees need no request of their own
+    NSMutableDictionary *folderPaths = [NSMutableDictionary dictionary];
+    for (AlfrescoNode *node in nodes)
+    {
+        NSString *path = node.isFolder ? [node propertyValueWithName:kCMISPropertyPath] : nil;
+        if (nil != path && nil != node.identifier)
+        {
+            folderPaths[node.identifier] = path;
+        }
+    }
+    
+    NSMutableArray *treeFolders = [NSMutableArray array];
+    NSMutableArray *remainingNodes = [NSMutableArray array];
+    NSMutableSet *identifiers = [NSMutableSet set];
+    for (AlfrescoNode *node in nodes)
+    {
+        if (nil == node.identifier)
+        {
+            continue;
+        }
+        [identifiers addObject:node.identifier];
+    
+        if (node.isFolder && nil == [self ancestorOfPath:folderPaths[node.identifier] inFolderPaths:folderPaths])
+        {
+            [treeFolders addObject:node];
+        }
+        else
+        {
+            [remainingNodes addObject:node];
+        }
+    }
+    unsigned long long totalCount = identifiers.count;
+    dispatch_queue_t completionQueue = [AlfrescoSessionUtils completionQueueForSession:self.session];
+    
+    AlfrescoRequest *request = [[AlfrescoRequest alloc] initWithService:self operation:_cmd];
+    AlfrescoBulkNodeOperationBlock deleteBlock = ^AlfrescoRequest *(AlfrescoNode *node, AlfrescoBulkNodeItemCompletionBlock itemCompletionBlock) {
+        return [self deleteNode:node completionBlock:^(BOOL succeeded, NSError *error) {
+            itemCompletionBlock(succeeded ? node : nil, error);
+        }];
+    };
+    
+    AlfrescoBulkNodeOperation *treeOperation = [[AlfrescoBulkNodeOperation alloc] initWithNodes:treeFolders operationBlock:deleteBlock];
+    treeOperation.completionQueue = completionQueue;
+    treeOperation.progressBlock = (nil == progressBlock) ? nil : ^(unsigned long long completedCount, unsigned long long treeCount) {
+        progressBlock(completedCount, totalCount);
+    };
+    [treeOperation startWithRequest:request completionBlock:^(NSDictionary *deletedFolders, NSDictionary *folderErrors) {
+        NSMutableDictionary *deletedNodes = [NSMutableDictionary dictionaryWithDictionary:deletedFolders];
+        NSMutableDictionary *itemErrors = [NSMutableDictionary dictionaryWithDictionary:folderErrors];
+    
+        NSMutableDictionary *deletedFolderPaths = [NSMutableDictionary dictionary];
+        for (NSString *identifier in deletedFolders)
+        {
+            if (nil != folderPaths[identifier])
+            {
+                deletedFolderPaths[identifier] = folderPaths[identifier];
+            }
+        }
+    
+        NSMutableArray *pendingNodes = [NSMutableArray array];
+        for (AlfrescoNode *node in remainingNodes)
+        {
+            if (nil != [self ancestorOfPath:folderPaths[node.identifier] inFolderPaths:deletedFolderPaths])
+            {
+                deletedNodes[node.identifier] = node;
+            }
+            else
+            {
+                [pendingNodes addObject:node];
+            }
+        }
+    
+        // documents carry no path, one that went with a deleted tree is reported as not found
+        BOOL treesDeleted = (deletedFolders.count > 0);
+        AlfrescoBulkNodeOperation *nodeOperation = [[AlfrescoBulkNodeOperation alloc] initWithNodes:pendingNodes operationBlock:^AlfrescoRequest *(AlfrescoNode *node, AlfrescoBulkNodeItemCompletionBlock itemCompletionBlock) {
+            return deleteBlock(node, ^(id result, NSError *error) {
+                BOOL deletedWithTree = treesDeleted && kAlfrescoErrorCodeRequestedNodeNotFound == error.code;
+                itemCompletionBlock(deletedWithTree ? node : result, deletedWithTree ? nil : error);
+            });
+        }];
+        nodeOperation.completionQueue = completionQueue;
+        unsigned long long completedBefore = deletedNodes.count + itemErrors.count;
+        nodeOperation.progressBlock = (nil == progressBlock) ? nil : ^(unsigned long long completedCount, unsigned long long nodeCount) {
+            progressBlock(completedBefore + completedCount, totalCount);
+        };
+        [nodeOperation startWithRequest:request completionBlock:^(NSDictionary *results, NSDictionary *nodeErrors) {
+            [deletedNodes addEntriesFromDictionary:results];
+            [itemErrors addEntriesFromDictionary:nodeErrors];
+            completionBlock([self nodes:nodes withResults:deletedNodes], [AlfrescoBulkNodeOperation errorWithCode:kAlfrescoErrorCodeDocumentFolder itemErrors:itemErrors]);
+        }];
+    }];
+    return request;
+}
+
+- (AlfrescoRequest *)moveNodes:(NSArray *)nodes
+                    fromFolder:(AlfrescoFolder *)sourceFolder
+                      toFolder:(AlfrescoFolder *)targetFolder
+               completionBlock:(AlfrescoArrayCompletionBlock)completionBlock
+                 progressBlock:(AlfrescoProgressBlock)progressBlock
+{
+    [AlfrescoErrors assertArgumentNotNil:nodes argumentName:@"nodes"];
+    [AlfrescoErrors assertArgumentNotNil:sourceFolder argumentName:@"sourceFolder"];
+    [AlfrescoErrors assertArgumentNotNil:targetFolder argumentName:@"targetFolder"];
+    [AlfrescoErrors assertArgumentNotNil:completionBlock argumentName:@"completionBlock"];
+    
+    AlfrescoRequest *request = [[AlfrescoRequest alloc] initWithService:self operation:_cmd];
+    AlfrescoBulkNodeOperation *moveOperation = [[AlfrescoBulkNodeOperation alloc] initWithNodes:nodes operationBlock:^AlfrescoRequest *(AlfrescoNode *node, AlfrescoBulkNodeItemCompletionBlock itemCompletionBlock) {
+        return [self moveNode:node fromFolder:sourceFolder toFolder:targetFolder completionBlock:itemCompletionBlock];
+    }];
+    moveOperation.completionQueue = [AlfrescoSessionUtils completionQueueForSession:self.session];
+    moveOperation.progressBlock = progressBlock;
+    [moveOperation startWithRequest:request completionBlock:^(NSDictionary *movedNodes, NSDictionary *itemErrors) {
+        completionBlock([self nodes:nodes withResults:movedNodes], [AlfrescoBulkNodeOperation errorWithCode:kAlfrescoErrorCodeDocumentFolder itemErrors:itemErrors]);
+    }];
+    return request;
+}
+
+- (AlfrescoRequest *)updatePropertiesOfNodes:(NSArray *)nodes
+                                  properties:(NSDictionary *)properties
+                             completionBlock:(AlfrescoArrayCompletionBlock)completionBlock
+                               progressBlock:(AlfrescoProgressBlock)progressBlock
+{
+    [AlfrescoErrors assertArgumentNotNil:nodes argumentName:@"nodes"];
+    [AlfrescoErrors assertArgumentNotNil:properties argumentName:@"properties"];
+    [AlfrescoErrors assertArgumentNotNil:completionBlock argumentName:@"completionBlock"];
+    
+    // unlike a single update the nodes are not retrieved again afterwards, that would double the number of requests
+    AlfrescoRequest *request = [[AlfrescoRequest alloc] initWithService:self operation:_cmd];
+    AlfrescoBulkNodeOperation *updateOperation = [[AlfrescoBulkNodeOperation alloc] initWithNodes:nodes operationBlock:^AlfrescoRequest *(AlfrescoNode *node, AlfrescoBulkNodeItemCompletionBlock itemCompletionBlock) {
+        AlfrescoRequest *nodeRequest = [[AlfrescoRequest alloc] initWithService:self operation:@selector(updatePropertiesOfNode:properties:completionBlock:)];
+        [AlfrescoCMISUtil preparePropertiesForUpdate:properties
+                                             aspects:nil
+                                                node:node
+                                         cmisSession:self.cmisSession
+                                     completionBlock:^(CMISProperties *cmisProperties, NSError *prepareError) {
+            if (nil == cmisProperties)
+            {
+                itemCompletionBlock(nil, [AlfrescoCMISUtil alfrescoErrorWithCMISError:prepareError]);
+            }
+            else
+            {
+                CMISStringInOutParameter *inOutParam = [CMISStringInOutParameter inOutParameterUsingInParameter:node.identifier];
+                nodeRequest.httpRequest = [self.cmisSession.binding.objectService updatePropertiesForObject:inOutParam
+                                                                                                 properties:cmisProperties
+                                                                                                changeToken:nil
+                                                                                            completionBlock:^(NSError *updateError) {
+                    if (nil != updateError)
+                    {
+                        itemCompletionBlock(nil, [AlfrescoCMISUtil alfrescoErrorWithCMISError:updateError]);
+                    }
+                    else
+                    {
+                        itemCompletionBlock(node, nil);
+                    }
+                }];
+            }
+        }];
+        return nodeRequest;
+    }];
+    updateOperation.completionQueue = [AlfrescoSessionUtils completionQueueForSession:self.session];
+    updateOperation.progressBlock = progressBlock;
+    [updateOperation startWithRequest:request completionBlock:^(NSDictionary *updatedNodes, NSDictionary *itemErrors) {
+        completionBlock([self nodes:nodes withResults:updatedNodes], [AlfrescoBulkNodeOperation errorWithCode:kAlfrescoErrorCodeDocumentFolder itemErrors:itemErrors]);
+    }];
+    return request;
+}
+
 #pragma mark - Internal methods
 
+/// Returns the identifier of the folder whose tree contains the given path, nil if there is none or the path is unknown.
+- (NSString *)ancestorOfPath:(NSString *)path inFolderPaths:(NSDictionary *)folderPaths
+{
+    if (nil == path)
+    {
+        return nil;
+    }
+    
+    for (NSString *identifier in folderPaths)
+    {
+        NSString *folderPath = folderPaths[identifier];
+        NSString *folderPrefix = [folderPath hasSuffix:@"/"] ? folderPath : [folderPath stringByAppendingString:@"/"];
+        if (path.length > folderPrefix.length && [path hasPrefix:folderPrefix])
+        {
+            return identifier;
+        }
+    }
+    return nil;
+}
+
+/// Returns the results of a bulk operation in the order the nodes were given, nodes without a result are left out.
+- (NSArray *)nodes:(NSArray *)nodes withResults:(NSDictionary *)results
+{
+    NSMutableArray *resultNodes = [NSMutableArray arrayWithCapacity:results.count];
+    NSMutableSet *identifiers = [NSMutableSet setWithCapacity:results.count];
+    for (AlfrescoNode *node in nodes)
+    {
+        id result = (nil != node.identifier) ? results[node.identifier] : nil;
+        if (nil != result && ![identifiers containsObject:node.identifier])
+        {
+            [identifiers addObject:node.identifier];
+            [resultNodes addObject:result];
+        }
+    }
+    return resultNodes;
+}
+
+/**
+ Updates the content of the given document in a single round trip where the binding allows it.
+ The object id and change token already known from the document are sent straight to the binding, the returned node
+ is built from the object data contained in the update response. Only if the response carries no object data
+ (AtomPub servers answering with 204 No Content) the latest version is retrieved afterwards.
+ */
+- (AlfrescoRequest *)updateContentOfDocument:(AlfrescoDocument *)document
+                                 inputStream:(NSInputStream *)inputStream
+                               bytesExpected:(unsigned long long)bytesExpected
+                                    mimeType:(NSString *)mimeType
+                             completionBlock:(AlfrescoDocumentCompletionBlock)completionBlock
+                               progressBlock:(AlfrescoProgressBlock)progressBlock
+{
+    // remember the versionSeriesId of the document, the update may create a new version with a different identifier
+    NSString *versionSeriesId = [document propertyValueWithName:kCMISPropertyVersionSeriesId];
+    if (nil == versionSeriesId)
+    {
+        versionSeriesId = [AlfrescoObjectConverter nodeRefWithoutVersionID:document.identifier];
+    }
+    
+    CMISStringInOutParameter *objectIdParam = [CMISStringInOutParameter inOutParameterUsingInParameter:document.identifier];
+    CMISStringInOutParameter *changeTokenParam = [CMISStringInOutParameter inOutParameterUsingInParameter:[document propertyValueWithName:kCMISPropertyChangeToken]];
+    
+    AlfrescoRequest *request = [[AlfrescoRequest alloc] initWithService:self operation:_cmd];
+    request.httpRequest = [self.cmisSession.binding.objectService changeContentOfObject:objectIdParam
+                                                                 toContentOfInputStream:inputStream
+                                                                          bytesExpected:bytesExpected
+                                                                               filename:document.name
+                                                                               mimeType:mimeType
+                                                                      overwriteExisting:YES
+                                                                            changeToken:changeTokenParam
+                                                              objectDataCompletionBlock:^(CMISObjectData *objectData, NSError *updateError) {
+        if (nil != updateError)
+        {
+            completionBlock(nil, [AlfrescoCMISUtil alfrescoErrorWithCMISError:updateError]);
+        }
+        else if (request.isCancelled)
+        {
+            completionBlock(nil, [AlfrescoErrors alfrescoErrorWithAlfrescoErrorCode:kAlfrescoErrorCodeNetworkRequestCancelled]);
+        }
+        else if (nil != objectData)
+        {
+            [self.cmisSession.objectConverter convertObject:objectData completionBlock:^(CMISObject *updatedObject, NSError *conversionError) {
+                [self completeContentUpdateWithCMISObject:updatedObject error:conversionError completionBlock:completionBlock];
+            }];
+        }
+        else
+        {
+            request.httpRequest = [self.cmisSession retrieveObject:versionSeriesId completionBlock:^(CMISObject *updatedObject, NSError *retrievalError) {
+                [self completeContentUpdateWithCMISObject:updatedObject error:retrievalError completionBlock:completionBlock];
+            }];
+        }
+    }
+                                                                          progressBlock:progressBlock];
+    return request;
+}
+
+- (void)uploadDocumentWithName:(NSString *)documentName
+                inParentFolder:(AlfrescoFolder *)folder
+                   contentFile:(AlfrescoContentFile *)file
+                    properties:(NSDictionary *)properties
+                   fingerprint:(NSString *)fingerprint
+                       request:(AlfrescoRequest *)request
+               completionBlock:(AlfrescoDocumentCompletionBlock)completionBlock
+                 progressBlock:(AlfrescoProgressBlock)progressBlock
+{
+    NSDictionary *createdProperties = properties;
+    NSString *fingerprintProperty = [self.session objectForParameter:kAlfrescoContentFingerprintProperty];
+    if (nil != fingerprint && nil != fingerprintProperty)
+    {
+        NSMutableDictionary *fingerprintedProperties = [properties mutableCopy];
+        fingerprintedProperties[fingerprintProperty] = fingerprint;
+        properties = fingerprintedProperties;
+    }
+    
+    request.httpRequest = [self.cmisSession createDocumentFromFilePath:[file.fileUrl path] mimeType:file.mimeType properties:properties inFolder:folder.identifier completionBlock:^(NSString *identifier, NSError *error){
+        if (nil == identifier)
+        {
+            NSError *alfrescoError = [AlfrescoCMISUtil alfrescoErrorWithCMISError:error];
+            completionBlock(nil, alfrescoError);
+        }
+        else if (request.isCancelled)
+        {
+            completionBlock(nil, [AlfrescoErrors alfrescoErrorWithAlfrescoErrorCode:kAlfrescoErrorCodeNetworkRequestCancelled]);
+        }
+        else
+        {
+            AlfrescoRequest *retrieveRequest = [self retrieveNodeWithIdentifier:identifier completionBlock:^(AlfrescoNode *node, NSError *error) {
+                if (nil != fingerprint && [node isKindOfClass:[AlfrescoDocument class]])
+                {
+                    [[AlfrescoContentFingerprintStore fingerprintStoreForSession:self.session] recordFingerprint:fingerprint
+                                                                                                      ofDocument:(AlfrescoDocument *)node
+                                                                                                            name:documentName
+                                                                                                        inFolder:folder
+                                                                                                      properties:createdProperties];
+                }
+                completionBlock((AlfrescoDocument *)node, error);
+                if (nil != node)
+                {
+                    BOOL isExtractMetadata = [[self.session objectForParameter:kAlfrescoMetadataExtraction] boolValue];
+                    if (isExtractMetadata)
+                    {
+                        [self extractMetadataForNode:node alfrescoRequest:request];
+                    }
+                    BOOL isGenerateThumbnails = [[self.session objectForParameter:kAlfrescoThumbnailCreation] boolValue];
+                    if (isGenerateThumbnails)
+                    {
+                        [self generateThumbnailForNode:node alfrescoRequest:request];
+                    }
+                }
+            }];
+            
+            request.httpRequest = retrieveRequest.httpRequest;
+        }
+    } progressBlock:^(unsigned long long bytesUploaded, unsigned long long bytesTotal){
+        if (progressBlock)
+        {
+            progressBlock(bytesUploaded, bytesTotal);
+        }
+    }];
+}
+
+- (AlfrescoRequest *)uploadContentOfDocument:(AlfrescoDocument *)document
+                                 contentFile:(AlfrescoContentFile *)file
+                             completionBlock:(AlfrescoDocumentCompletionBlock)completionBlock
+                               progressBlock:(AlfrescoProgressBlock)progressBlock
+{
+    NSString *filePath = [file.fileUrl path];
+    NSError *fileError = nil;
+    NSDictionary *fileAttributes = [[NSFileManager defaultManager] attributesOfItemAtPath:filePath error:&fileError];
+    if (nil == fileAttributes)
+    {
+        // without the size the content can't be sent with an exact Content-Length
+        AlfrescoLogError(@"Could not determine size of file %@: %@", filePath, fileError);
+        NSError *alfrescoError = [AlfrescoErrors alfrescoErrorWithUnderlyingError:fileError andAlfrescoErrorCode:kAlfrescoErrorCodeDocumentFolder];
+        dispatch_async([AlfrescoSessionUtils completionQueueForSession:self.session], ^{
+            completionBlock(nil, alfrescoError);
+        });
+        return [[AlfrescoRequest alloc] initWithService:self operation:_cmd];
+    }
+    
+    return [self updateContentOfDocument:document
+                             inputStream:[NSInputStream inputStreamWithFileAtPath:filePath]
+                           bytesExpected:[fileAttributes fileSize]
+                                mimeType:file.mimeType
+                         completionBlock:completionBlock
+                           progressBlock:progressBlock];
+}
+
+- (void)uploadContentOfDocument:(AlfrescoDocument *)document
+                    contentFile:(AlfrescoContentFile *)file
+                    fingerprint:(NSString *)fingerprint
+                        request:(AlfrescoRequest *)request
+                completionBlock:(AlfrescoDocumentCompletionBlock)completionBlock
+                  progressBlock:(AlfrescoProgressBlock)progressBlock
+{
+    AlfrescoRequest *updateRequest = [self uploadContentOfDocument:document contentFile:file completionBlock:^(AlfrescoDocument *updatedDocument, NSError *updateError) {
+        if (nil == updatedDocument || nil == fingerprint)
+        {
+            completionBlock(updatedDocument, updateError);
+        }
+        else
+        {
+            [self storeFingerprint:fingerprint ofDocument:updatedDocument request:request completionBlock:completionBlock];
+        }
+    } progressBlock:progressBlock];
+    request.httpRequest = updateRequest.httpRequest;
+}
+
+/**
+ Remembers the fingerprint of the updated document's content. If the kAlfrescoContentFingerprintProperty session parameter
+ is set the fingerprint is also stored in that property, the content update itself can't carry properties.
+ */
+- (void)storeFingerprint:(NSString *)fingerprint
+              ofDocument:(AlfrescoDocument *)document
+                 request:(AlfrescoRequest *)request
+         completionBlock:(AlfrescoDocumentCompletionBlock)completionBlock
+{
+    AlfrescoContentFingerprintStore *fingerprintStore = [AlfrescoContentFingerprintStore fingerprintStoreForSession:self.session];
+    NSString *fingerprintProperty = [self.session objectForParameter:kAlfrescoContentFingerprintProperty];
+    if (nil == fingerprintProperty)
+    {
+        [fingerprintStore recordFingerprint:fingerprint ofDocument:document];
+        completionBlock(document, nil);
+        return;
+    }
+    
+    AlfrescoRequest *propertiesRequest = [self updatePropertiesOfNode:document properties:@{fingerprintProperty: fingerprint} completionBlock:^(AlfrescoNode *node, NSError *error) {
+        AlfrescoDocument *updatedDocument = document;
+        if ([node isKindOfClass:[AlfrescoDocument class]])
+        {
+            updatedDocument = (AlfrescoDocument *)node;
+        }
+        else
+        {
+            // the content has been updated all the same, only later uploads of it can't be skipped by other clients
+            AlfrescoLogWarning(@"Could not store the content fingerprint of %@: %@", document.name, error);
+        }
+        [fingerprintStore recordFingerprint:fingerprint ofDocument:updatedDocument];
+        completionBlock(updatedDocument, nil);
+    }];
+    request.httpRequest = propertiesRequest.httpRequest;
+}
+
+- (BOOL)isContentDeduplicationEnabled
+{
+    return [[self.session objectForParameter:kAlfrescoContentDeduplication] boolValue];
+}
+
+- (void)fingerprintContentFile:(AlfrescoContentFile *)file completionBlock:(void (^)(NSString *fingerprint))completionBlock
+{
+    // reading a large file takes a while, it is fingerprinted off the caller's thread
+    dispatch_async(dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
+        NSString *fingerprint = [AlfrescoContentFingerprint fingerprintOfFileAtPath:[file.fileUrl path] error:nil];
+        dispatch_async([AlfrescoSessionUtils completionQueueForSession:self.session], ^{
+            completionBlock(fingerprint);
+        });
+    });
+}
+
+- (BOOL)document:(AlfrescoDocument *)document hasContentWithFingerprint:(NSString *)fingerprint
+{
+    NSString *fingerprintProperty = [self.session objectForParameter:kAlfrescoContentFingerprintProperty];
+    if (nil != fingerprintProperty)
+    {
+        id storedFingerprint = [document propertyValueWithName:fingerprintProperty];
+        if ([storedFingerprint isKindOfClass:[NSString class]] && [storedFingerprint isEqualToString:fingerprint])
+        {
+            return YES;
+        }
+    }
+    return [fingerprint isEqualToString:[[AlfrescoContentFingerprintStore fingerprintStoreForSession:self.session] fingerprintOfDocument:document]];
+}
+
+- (void)completeContentUpdateWithCMISObject:(CMISObject *)cmisObject
+                                      error:(NSError *)error
+                            completionBlock:(AlfrescoDocumentCompletionBlock)completionBlock
+{
+    if (nil == cmisObject)
+    {
+        completionBlock(nil, [AlfrescoCMISUtil alfrescoErrorWithCMISError:error]);
+    }
+    else
+    {
+        AlfrescoDocument *alfrescoDocument = (AlfrescoDocument *)[self.objectConverter nodeFromCMISObject:cmisObject];
+        NSError *alfrescoError = nil;
+        if (nil == alfrescoDocument)
+        {
+            alfrescoError = [AlfrescoErrors alfrescoErrorWithAlfrescoErrorCode:kAlfrescoErrorCodeDocumentFolderFailedToConvertNode];
+        }
+        completionBlock(alfrescoDocument, alfrescoError);
+    }
+}
+
 // filter the provided array with items that match the provided class type
 - (NSArray *)retrieveItemsWithClassFilter:(Class) typeClass withArray:(NSArray *)itemArray
 {
@@ -1216,6 +1741,11 @@
     return request;
 }
 
+- (NSDictionary *)unresolvedFavoriteErrors
+{
+    return self.favoritesCache.unresolvedFavoriteErrors;
+}
+
 - (void)clear
 {
     [self.favoritesCache clear];
@@ -22,21 +22,22 @@
 #import "AlfrescoInternalConstants.h"
 #import "AlfrescoErrors.h"
 #import "AlfrescoCMISToAlfrescoObjectConverter.h"
+#import "AlfrescoModelDefinitionRegistry.h"
 #import "AlfrescoRequest.h"
+#import "AlfrescoRequestGroup.h"
 #import "AlfrescoLog.h"
 #import "CMISConstants.h"
 #import "CMISSession.h"
 #import "CMISRequest.h"
 
 typedef void (^AlfrescoNodeTypeDefinitionCompletionBlock)(AlfrescoNodeTypeDefinition *typeDefinition, NSError *error);
+typedef AlfrescoModelDefinition * (^AlfrescoModelDefinitionConversionBlock)(CMISTypeDefinition *typeDefinition);
 
 @interface AlfrescoModelDefinitionService ()
 @property (nonatomic, strong) id<AlfrescoSession> session;
 @property (nonatomic, strong) CMISSession *cmisSession;
 @property (nonatomic, strong) AlfrescoCMISToAlfrescoObjectConverter *objectConverter;
-
-@property (nonatomic, strong) NSMutableDictionary *typeCache;
-@property (nonatomic, strong) NSMutableDictionary *aspectCache;
+@property (nonatomic, strong) AlfrescoModelDefinitionRegistry *registry;
 @end
 
 @implementation AlfrescoModelDefinitionService
@@ -58,32 +59,8 @@ typedef void (^AlfrescoNodeTypeDefinitionCompletionBlock)(AlfrescoNodeTypeDefini
         self.cmisSession = [session objectForParameter:kAlfrescoSessionKeyCmisSession];
         self.objectConverter = [[AlfrescoCMISToAlfrescoObjectConverter alloc] initWithSession:self.session];
         
-        // setup caches
-        id cachedTypeObj = [self.session objectForParameter:kAlfrescoSessionCacheDefinitionType];
-        if (cachedTypeObj)
-        {
-            AlfrescoLogDebug(@"Found an existing type definition cache in session");
-            self.typeCache = (NSMutableDictionary *)cachedTypeObj;
-        }
-        else
-        {
-            self.typeCache = [NSMutableDictionary dictionary];
-            [self.session setObject:self.typeCache forParameter:kAlfrescoSessionCacheDefinitionType];
-            AlfrescoLogDebug(@"Created new type definition cache");
-        }
-        
-        id cachedAspectObj = [self.session objectForParameter:kAlfrescoSessionCacheDefinitionAspect];
-        if (cachedAspectObj)
-        {
-            AlfrescoLogDebug(@"Found an existing aspect definition cache in session");
-            self.aspectCache = (NSMutableDictionary *)cachedAspectObj;
-        }
-        else
-        {
-            self.aspectCache = [NSMutableDictionary dictionary];
-            [self.session setObject:self.aspectCache forParameter:kAlfrescoSessionCacheDefinitionAspect];
-            AlfrescoLogDebug(@"Created new aspect definition cache");
-        }
+        // the registry is shared by every service created for the session
+        self.registry = [AlfrescoModelDefinitionRegistry registryForSession:self.session];
     }
     
     return self;
@@ -91,8 +68,7 @@ typedef void (^AlfrescoNodeTypeDefinitionCompletionBlock)(AlfrescoNodeTypeDefini
 
 - (void)clear
 {
-    [self.typeCache removeAllObjects];
-    [self.aspectCache removeAllObjects];
+    [self.registry clear];
 }
 
 #pragma mark - Retrieval methods
@@ -107,45 +83,11 @@ typedef void (^AlfrescoNodeTypeDefinitionCompletionBlock)(AlfrescoNodeTypeDefini
         cmisType = [kAlfrescoCMISDocumentTypePrefix stringByAppendingString:type];
     }
     
-    AlfrescoRequest *request = nil;
-    
-    // check cache first
-    AlfrescoDocumentTypeDefinition *cachedTypeDefinition = self.typeCache[cmisType];
-    if (cachedTypeDefinition != nil)
-    {
-        AlfrescoLogDebug(@"Cache hit: returning document type definition for %@ from cache", cmisType);
-        completionBlock(cachedTypeDefinition, nil);
-    }
-    else
-    {
-        request = [self retrieveDefinition:cmisType completionBlock:^(CMISTypeDefinition *typeDefinition, NSError *error) {
-            if (typeDefinition != nil)
-            {
-                // convert the CMIS type definition
-                AlfrescoDocumentTypeDefinition *documentTypeDefinition = [self.objectConverter documentTypeDefinitionFromCMISTypeDefinition:typeDefinition];
-                if (documentTypeDefinition != nil)
-                {
-                    // cache the type definition
-                    AlfrescoLogDebug(@"Cached document type definition for %@", cmisType);
-                    self.typeCache[cmisType] = documentTypeDefinition;
-                    
-                    // call completion block
-                    completionBlock(documentTypeDefinition, nil);
-                }
-                else
-                {
-                    completionBlock(nil, [AlfrescoErrors alfrescoErrorWithAlfrescoErrorCode:kAlfrescoErrorCodeModelDefinitionNotFound]);
-                }
-            }
-            else
-            {
-                completionBlock(nil, [AlfrescoErrors alfrescoErrorWithUnderlyingError:error
-                                                                 andAlfrescoErrorCode:kAlfrescoErrorCodeModelDefinitionNotFound]);
-            }
-        }];
-    }
-    
-    return request;
+    return [self retrieveDefinition:cmisType operation:_cmd conversionBlock:^AlfrescoModelDefinition *(CMISTypeDefinition *typeDefinition) {
+        return [self.objectConverter documentTypeDefinitionFromCMISTypeDefinition:typeDefinition];
+    } completionBlock:^(AlfrescoModelDefinition *definition, NSError *error) {
+        completionBlock((AlfrescoDocumentTypeDefinition *)definition, error);
+    }];
 }
 
 - (AlfrescoRequest *)retrieveDefinitionForFolderType:(NSString *)type
@@ -158,45 +100,11 @@ typedef void (^AlfrescoNodeTypeDefinitionCompletionBlock)(AlfrescoNodeTypeDefini
         cmisType = [kAlfrescoCMISFolderTypePrefix stringByAppendingString:type];
     }
     
-    AlfrescoRequest *request = nil;
-    
-    // check cache first
-    AlfrescoFolderTypeDefinition *cachedTypeDefinition = self.typeCache[cmisType];
-    if (cachedTypeDefinition != nil)
-    {
-        AlfrescoLogDebug(@"Cache hit: returning folder type definition for %@ from cache", cmisType);
-        completionBlock(cachedTypeDefinition, nil);
-    }
-    else
-    {
-        request =  [self retrieveDefinition:cmisType completionBlock:^(CMISTypeDefinition *typeDefinition, NSError *error) {
-            if (typeDefinition != nil)
-            {
-                // convert the CMIS type definition
-                AlfrescoFolderTypeDefinition *folderTypeDefinition = [self.objectConverter folderTypeDefinitionFromCMISTypeDefinition:typeDefinition];
-                if (folderTypeDefinition != nil)
-                {
-                    // cache the type definition
-                    AlfrescoLogDebug(@"Cached folder type definition for %@", cmisType);
-                    self.typeCache[cmisType] = folderTypeDefinition;
-                    
-                    // call completion block
-                    completionBlock(folderTypeDefinition, nil);
-                }
-                else
-                {
-                    completionBlock(nil, [AlfrescoErrors alfrescoErrorWithAlfrescoErrorCode:kAlfrescoErrorCodeModelDefinitionNotFound]);
-                }
-            }
-            else
-            {
-                completionBlock(nil, [AlfrescoErrors alfrescoErrorWithUnderlyingError:error
-                                                                 andAlfrescoErrorCode:kAlfrescoErrorCodeModelDefinitionNotFound]);
-            }
-        }];
-    }
-    
-    return request;
+    return [self retrieveDefinition:cmisType operation:_cmd conversionBlock:^AlfrescoModelDefinition *(CMISTypeDefinition *typeDefinition) {
+        return [self.objectConverter folderTypeDefinitionFromCMISTypeDefinition:typeDefinition];
+    } completionBlock:^(AlfrescoModelDefinition *definition, NSError *error) {
+        completionBlock((AlfrescoFolderTypeDefinition *)definition, error);
+    }];
 }
 
 - (AlfrescoRequest *)retrieveDefinitionForTaskType:(NSString *)type
@@ -204,45 +112,11 @@ typedef void (^AlfrescoNodeTypeDefinitionCompletionBlock)(AlfrescoNodeTypeDefini
 {
     NSString *cmisType = [kAlfrescoCMISDocumentTypePrefix stringByAppendingString:type];
     
-    AlfrescoRequest *request = nil;
-    
-    // check cache first
-    AlfrescoTaskTypeDefinition *cachedTypeDefinition = self.typeCache[cmisType];
-    if (cachedTypeDefinition != nil)
-    {
-        AlfrescoLogDebug(@"Cache hit: returning task type definition for %@ from cache", cmisType);
-        completionBlock(cachedTypeDefinition, nil);
-    }
-    else
-    {
-        request = [self retrieveDefinition:cmisType completionBlock:^(CMISTypeDefinition *typeDefinition, NSError *error) {
-            if (typeDefinition != nil)
-            {
-                // convert the CMIS type definition
-                AlfrescoTaskTypeDefinition *taskTypeDefinition = [self.objectConverter taskTypeDefinitionFromCMISTypeDefinition:typeDefinition];
-                if (taskTypeDefinition != nil)
-                {
-                    // cache the type definition
-                    AlfrescoLogDebug(@"Cached task type definition for %@", cmisType);
-                    self.typeCache[cmisType] = taskTypeDefinition;
-                    
-                    // call completion block
-                    completionBlock(taskTypeDefinition, nil);
-                }
-                else
-                {
-                    completionBlock(nil, [AlfrescoErrors alfrescoErrorWithAlfrescoErrorCode:kAlfrescoErrorCodeModelDefinitionNotFound]);
-                }
-            }
-            else
-            {
-                completionBlock(nil, [AlfrescoErrors alfrescoErrorWithUnderlyingError:error
-                                                                 andAlfrescoErrorCode:kAlfrescoErrorCodeModelDefinitionNotFound]);
-            }
-        }];
-    }
-    
-    return request;
+    return [self retrieveDefinition:cmisType operation:_cmd conversionBlock:^AlfrescoModelDefinition *(CMISTypeDefinition *typeDefinition) {
+        return [self.objectConverter taskTypeDefinitionFromCMISTypeDefinition:typeDefinition];
+    } completionBlock:^(AlfrescoModelDefinition *definition, NSError *error) {
+        completionBlock((AlfrescoTaskTypeDefinition *)definition, error);
+    }];
 }
 
 - (AlfrescoRequest *)retrieveDefinitionForAspect:(NSString *)aspect
@@ -251,52 +125,21 @@ typedef void (^AlfrescoNodeTypeDefinitionCompletionBlock)(AlfrescoNodeTypeDefini
     // construct CMIS specific type identifier
     NSString *cmisType = [kAlfrescoCMISAspectPrefix stringByAppendingString:aspect];
     
-    AlfrescoRequest *request = nil;
-    
-    // check cache first
-    AlfrescoAspectDefinition *cachedDefinition = self.aspectCache[cmisType];
-    if (cachedDefinition != nil)
-    {
-        AlfrescoLogDebug(@"Cache hit: returning aspect definition for %@ from cache", cmisType);
-        completionBlock(cachedDefinition, nil);
-    }
-    else
-    {
-        request = [self retrieveDefinition:cmisType completionBlock:^(CMISTypeDefinition *typeDefinition, NSError *error) {
-            if (typeDefinition != nil)
-            {
-                // convert the CMIS type definition
-                AlfrescoAspectDefinition *aspectDefinition = [self.objectConverter aspectDefinitionFromCMISTypeDefinition:typeDefinition];
-                if (aspectDefinition != nil)
-                {
-                    // cache the definition
-                    AlfrescoLogDebug(@"Cached aspect definition for %@", cmisType);
-                    self.aspectCache[cmisType] = aspectDefinition;
-                    
-                    // call completion block
-                    completionBlock(aspectDefinition, nil);
-                }
-                else
-                {
-                    completionBlock(nil, [AlfrescoErrors alfrescoErrorWithAlfrescoErrorCode:kAlfrescoErrorCodeModelDefinitionNotFound]);
-                }
-            }
-            else
-            {
-                completionBlock(nil, [AlfrescoErrors alfrescoErrorWithUnderlyingError:error
-                                                                 andAlfrescoErrorCode:kAlfrescoErrorCodeModelDefinitionNotFound]);
-            }
-        }];
-    }
-    
-    return request;
+    return [self retrieveDefinition:cmisType operation:_cmd conversionBlock:^AlfrescoModelDefinition *(CMISTypeDefinition *typeDefinition) {
+        return [self.objectConverter aspectDefinitionFromCMISTypeDefinition:typeDefinition];
+    } completionBlock:^(AlfrescoModelDefinition *definition, NSError *error) {
+        completionBlock((AlfrescoAspectDefinition *)definition, error);
+    }];
 }
 
 - (AlfrescoRequest *)retrieveDefinitionForDocument:(AlfrescoDocument *)document
                                    completionBlock:(AlfrescoDocumentTypeDefinitionCompletionBlock)completionBlock
 {
-    AlfrescoRequest *request = nil;
-    request = [self retrieveDefinitionForDocumentType:document.type completionBlock:^(AlfrescoDocumentTypeDefinition *typeDefinition, NSError *typeError) {
+    AlfrescoRequest *request = [[AlfrescoRequest alloc] initWithService:self operation:_cmd];
+    AlfrescoRequestGroup *requestGroup = [AlfrescoRequestGroup new];
+    request.httpRequest = requestGroup;
+    
+    AlfrescoRequest *typeRequest = [self retrieveDefinitionForDocumentType:document.type completionBlock:^(AlfrescoDocumentTypeDefinition *typeDefinition, NSError *typeError) {
         if (typeDefinition == nil)
         {
             completionBlock(nil, typeError);
@@ -306,12 +149,16 @@ typedef void (^AlfrescoNodeTypeDefinitionCompletionBlock)(AlfrescoNodeTypeDefini
             // add all properties from applied aspects to the type definition
             [self typeDefinitonWithAspectsFromNode:document
                                     typeDefinition:typeDefinition
-                                           request:request
+                                      requestGroup:requestGroup
                                    completionBlock:^(AlfrescoNodeTypeDefinition *typeDefinition, NSError *aspectError) {
                                        completionBlock((AlfrescoDocumentTypeDefinition*)typeDefinition, aspectError);
                                    }];
         }
     }];
+    if (nil != typeRequest)
+    {
+        [requestGroup addRequest:typeRequest];
+    }
     
     return request;
 }
@@ -319,8 +166,11 @@ typedef void (^AlfrescoNodeTypeDefinitionCompletionBlock)(AlfrescoNodeTypeDefini
 - (AlfrescoRequest *)retrieveDefinitionForFolder:(AlfrescoFolder *)folder
                                  completionBlock:(AlfrescoFolderTypeDefinitionCompletionBlock)completionBlock
 {
-    AlfrescoRequest *request = nil;
-    request = [self retrieveDefinitionForFolderType:folder.type completionBlock:^(AlfrescoFolderTypeDefinition *typeDefinition, NSError *typeError) {
+    AlfrescoRequest *request = [[AlfrescoRequest alloc] initWithService:self operation:_cmd];
+    AlfrescoRequestGroup *requestGroup = [AlfrescoRequestGroup new];
+    request.httpRequest = requestGroup;
+    
+    AlfrescoRequest *typeRequest = [self retrieveDefinitionForFolderType:folder.type completionBlock:^(AlfrescoFolderTypeDefinition *typeDefinition, NSError *typeError) {
         if (typeDefinition == nil)
         {
             completionBlock(nil, typeError);
@@ -330,12 +180,16 @@ typedef void (^AlfrescoNodeTypeDefinitionCompletionBlock)(AlfrescoNodeTypeDefini
             // add all properties from applied aspects to the type definition
             [self typeDefinitonWithAspectsFromNode:folder
                                     typeDefinition:typeDefinition
-                                           request:request
+                                      requestGroup:requestGroup
                                    completionBlock:^(AlfrescoNodeTypeDefinition *typeDefinition, NSError *aspectError) {
                                        completionBlock((AlfrescoFolderTypeDefinition*)typeDefinition, aspectError);
                                    }];
         }
     }];
+    if (nil != typeRequest)
+    {
+        [requestGroup addRequest:typeRequest];
+    }
     
     return request;
 }
@@ -348,15 +202,48 @@ typedef void (^AlfrescoNodeTypeDefinitionCompletionBlock)(AlfrescoNodeTypeDefini
 
 #pragma mark - Private methods
 
-- (AlfrescoRequest *)retrieveDefinition:(NSString *)definitionName completionBlock:(void (^)(CMISTypeDefinition *typeDefinition, NSError *error))completionBlock
+- (AlfrescoRequest *)retrieveDefinition:(NSString *)cmisType
+                              operation:(SEL)operation
+                        conversionBlock:(AlfrescoModelDefinitionConversionBlock)conversionBlock
+                        completionBlock:(void (^)(AlfrescoModelDefinition *definition, NSError *error))completionBlock
 {
-    // ask CMIS for the definition of the type or aspect
-    CMISRequest *cmisRequest = [self.cmisSession retrieveTypeDefinition:definitionName completionBlock:completionBlock];
+    id<AlfrescoCancellableRequest> registryRequest = [self.registry retrieveDefinitionForIdentifier:cmisType loader:^AlfrescoRequest *(AlfrescoModelDefinitionRegistryCompletionBlock loadCompletionBlock) {
+        // ask CMIS for the definition of the type or aspect, it is only converted once for every caller waiting for it
+        CMISRequest *cmisRequest = [self.cmisSession retrieveTypeDefinition:cmisType completionBlock:^(CMISTypeDefinition *typeDefinition, NSError *error) {
+            if (typeDefinition != nil)
+            {
+                AlfrescoModelDefinition *definition = conversionBlock(typeDefinition);
+                if (definition != nil)
+                {
+                    AlfrescoLogDebug(@"Loaded definition for %@", cmisType);
+                    loadCompletionBlock(definition, nil);
+                }
+                else
+                {
+                    loadCompletionBlock(nil, [AlfrescoErrors alfrescoErrorWithAlfrescoErrorCode:kAlfrescoErrorCodeModelDefinitionNotFound]);
+                }
+            }
+            else
+            {
+                loadCompletionBlock(nil, [AlfrescoErrors alfrescoErrorWithUnderlyingError:error
+                                                                    andAlfrescoErrorCode:kAlfrescoErrorCodeModelDefinitionNotFound]);
+            }
+        }];
+        
+        AlfrescoRequest *loadRequest = [[AlfrescoRequest alloc] initWithService:self operation:operation];
+        loadRequest.httpRequest = cmisRequest;
+        return loadRequest;
+    } completionBlock:completionBlock];
     
-    // return a request object
-    AlfrescoRequest *alfrescoRequest = [AlfrescoRequest new];
-    alfrescoRequest.httpRequest = cmisRequest.httpRequest;
-    return alfrescoRequest;
+    // the definition was known if there is nothing to wait for
+    if (nil == registryRequest)
+    {
+        return nil;
+    }
+    
+    AlfrescoRequest *request = [[AlfrescoRequest alloc] initWithService:self operation:operation];
+    request.httpRequest = registryRequest;
+    return request;
 }
 
 #pragma clang diagnostic push
@@ -364,44 +251,80 @@ typedef void (^AlfrescoNodeTypeDefinitionCompletionBlock)(AlfrescoNodeTypeDefini
 
 - (void)typeDefinitonWithAspectsFromNode:(AlfrescoNode *)node
                           typeDefinition:(AlfrescoNodeTypeDefinition *)typeDefinition
-                                 request:(AlfrescoRequest *)request
+                            requestGroup:(AlfrescoRequestGroup *)requestGroup
                          completionBlock:(AlfrescoNodeTypeDefinitionCompletionBlock)completionBlock
 {
-    NSMutableArray *aspectPropertyDefinitions = [NSMutableArray array];
+    NSArray *aspects = node.aspects;
+    
+    // the type definition is shared through the registry, so the aspect properties are added to a copy of it
+    AlfrescoNodeTypeDefinition *nodeTypeDefinition = [NSKeyedUnarchiver unarchiveObjectWithData:[NSKeyedArchiver archivedDataWithRootObject:typeDefinition]];
+    if (0 == aspects.count)
+    {
+        completionBlock(nodeTypeDefinition, nil);
+        return;
+    }
     
-    // retrieve the definition of each aspect applied to the node and extract the property definitions
-    __block int aspectsRetrieved = 0;
-    for (NSString *aspect in node.aspects)
+    // the aspect definitions are retrieved in parallel, completion blocks may arrive on different threads
+    NSMutableArray *aspectDefinitions = [NSMutableArray arrayWithCapacity:aspects.count];
+    for (NSUInteger index = 0; index < aspects.count; index++)
     {
-        AlfrescoRequest *aspectRequest = nil;
-        aspectRequest = [self retrieveDefinitionForAspect:aspect completionBlock:^(AlfrescoAspectDefinition *aspectDefinition, NSError *error) {
+        [aspectDefinitions addObject:[NSNull null]];
+    }
+    __block NSUInteger aspectsRetrieved = 0;
+    __block BOOL finished = NO;
+    
+    [aspects enumerateObjectsUsingBlock:^(NSString *aspect, NSUInteger index, BOOL *stop) {
+        AlfrescoRequest *aspectRequest = [self retrieveDefinitionForAspect:aspect completionBlock:^(AlfrescoAspectDefinition *aspectDefinition, NSError *error) {
+            BOOL complete = NO;
+            @synchronized(aspectDefinitions)
+            {
+                if (finished)
+                {
+                    return;
+                }
+                if (aspectDefinition == nil)
+                {
+                    finished = YES;
+                }
+                else
+                {
+                    aspectDefinitions[index] = aspectDefinition;
+                    aspectsRetrieved++;
+                    finished = complete = (aspectsRetrieved == aspects.count);
+                }
+            }
+            
             if (aspectDefinition == nil)
             {
+                // the first failure completes the retrieval, the remaining aspects are no longer needed
                 completionBlock(nil, error);
+                [requestGroup cancel];
             }
-            else
+            else if (complete)
             {
-                aspectsRetrieved++;
-                
-                for (NSString *propertyName in aspectDefinition.propertyNames)
+                // add the property definitions in the order the aspects are applied, whatever order they arrived in
+                NSMutableArray *aspectPropertyDefinitions = [NSMutableArray array];
+                for (AlfrescoAspectDefinition *retrievedDefinition in aspectDefinitions)
                 {
-                    AlfrescoPropertyDefinition *propertyDefinition = [aspectDefinition propertyDefinitionForPropertyWithName:propertyName];
-                    [aspectPropertyDefinitions addObject:propertyDefinition];
+                    for (NSString *propertyName in retrievedDefinition.propertyNames)
+                    {
+                        [aspectPropertyDefinitions addObject:[retrievedDefinition propertyDefinitionForPropertyWithName:propertyName]];
+                    }
                 }
                 
-                if (aspectsRetrieved == node.aspects.count)
-                {
-                    // using a selector add the extra property definitons to the existing type definition
-                    SEL addPropertyDefinitions = sel_registerName("addPropertyDefinitions:");
-                    [typeDefinition performSelector:addPropertyDefinitions withObject:aspectPropertyDefinitions];
-                    
-                    completionBlock(typeDefinition, nil);
-                }
+                // using a selector add the extra property definitons to the existing type definition
+                SEL addPropertyDefinitions = sel_registerName("addPropertyDefinitions:");
+                [nodeTypeDefinition performSelector:addPropertyDefinitions withObject:aspectPropertyDefinitions];
+                
+                completionBlock(nodeTypeDefinition, nil);
             }
         }];
         
-        request.httpRequest = aspectRequest.httpRequest;
-    }
+        if (nil != aspectRequest)
+        {
+            [requestGroup addRequest:aspectRequest];
+        }
+    }];
 }
 
 #pragma clang diagnostic pop
@@ -71,7 +71,7 @@
     [AlfrescoErrors assertArgumentNotNil:statement argumentName:@"statement"];
     [AlfrescoErrors assertArgumentNotNil:completionBlock argumentName:@"completionBlock"];
     
-    AlfrescoRequest *request = [[AlfrescoRequest alloc] init];
+    AlfrescoRequest *request = [[AlfrescoRequest alloc] initWithService:self operation:_cmd];
     if (AlfrescoSearchLanguageCMIS == language)
     {
         request.httpRequest = [self.cmisSession.binding.discoveryService
@@ -117,7 +117,7 @@
         listingContext = self.session.defaultListingContext;
     }    
     
-    AlfrescoRequest *request = [[AlfrescoRequest alloc] init];
+    AlfrescoRequest *request = [[AlfrescoRequest alloc] initWithService:self operation:_cmd];
 
     if (AlfrescoSearchLanguageCMIS == language)
     {
@@ -164,7 +164,7 @@
     [AlfrescoErrors assertArgumentNotNil:completionBlock argumentName:@"completionBlock"];
 
     NSString *query = [self createSearchQuery:keywords options:options];
-    AlfrescoRequest *request = [[AlfrescoRequest alloc] init];
+    AlfrescoRequest *request = [[AlfrescoRequest alloc] initWithService:self operation:_cmd];
     request.httpRequest = [self.cmisSession query:query searchAllVersions:NO completionBlock:^(CMISPagedResult *pagedResult, NSError *error){
         if (nil == pagedResult)
         {
@@ -198,7 +198,7 @@
         listingContext = self.session.defaultListingContext;
     }
 
-    AlfrescoRequest *request = [[AlfrescoRequest alloc] init];
+    AlfrescoRequest *request = [[AlfrescoRequest alloc] initWithService:self operation:_cmd];
     NSString *query = [self createSearchQuery:keywords options:options];
     CMISOperationContext *operationContext = [AlfrescoPagingUtils operationContextFromListingContext:listingContext];
     request.httpRequest = [self.cmisSession query:query searchAllVersions:NO operationContext:operationContext completionBlock:^(CMISPagedResult *pagedResult, NSError *error){
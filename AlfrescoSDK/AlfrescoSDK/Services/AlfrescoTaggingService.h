@@ -96,4 +96,19 @@
                       toNode:(AlfrescoNode *)node
              completionBlock:(AlfrescoBOOLCompletionBlock)completionBlock;
 
+/** Adds the given tags to each of the given nodes, a limited number of nodes are processed at once.
+ 
+ If the tags could not be added to any node the error contains the error for each of those nodes, keyed by node identifier,
+ under kAlfrescoErrorKeyItemErrors. Cancelling the request reports the nodes not tagged yet as cancelled.
+ 
+ @param tags The tags that should be added.
+ @param nodes The nodes to which the tags should be added.
+ @param completionBlock The block that's called with the nodes that were tagged once every node has been processed.
+ @param progressBlock The block that's called with the number of nodes processed and the total number of nodes.
+ */
+- (AlfrescoRequest *)addTags:(NSArray *)tags
+                     toNodes:(NSArray *)nodes
+             completionBlock:(AlfrescoArrayCompletionBlock)completionBlock
+               progressBlock:(AlfrescoProgressBlock)progressBlock;
+
 @end
@@ -18,9 +18,18 @@
 
 #import "AlfrescoTaggingService.h"
 #import "AlfrescoPlaceholderTaggingService.h"
+#import "AlfrescoBulkNodeOperation.h"
+#import "AlfrescoSessionUtils.h"
+
+@interface AlfrescoTaggingService ()
+// provided by the concrete services
+@property (nonatomic, strong, readonly) id<AlfrescoSession> session;
+@end
 
 @implementation AlfrescoTaggingService
 
+@dynamic session;
+
 + (id)alloc
 {
     if (self == [AlfrescoTaggingService self])
@@ -71,4 +80,38 @@
     return nil;
 }
 
+- (AlfrescoRequest *)addTags:(NSArray *)tags
+                     toNodes:(NSArray *)nodes
+             completionBlock:(AlfrescoArrayCompletionBlock)completionBlock
+               progressBlock:(AlfrescoProgressBlock)progressBlock
+{
+    [AlfrescoErrors assertArgumentNotNil:tags argumentName:@"tags"];
+    [AlfrescoErrors assertArgumentNotNil:nodes argumentName:@"nodes"];
+    [AlfrescoErrors assertArgumentNotNil:completionBlock argumentName:@"completionBlock"];
+    
+    AlfrescoRequest *request = [[AlfrescoRequest alloc] initWithService:self operation:_cmd];
+    AlfrescoBulkNodeOperation *tagOperation = [[AlfrescoBulkNodeOperation alloc] initWithNodes:nodes operationBlock:^AlfrescoRequest *(AlfrescoNode *node, AlfrescoBulkNodeItemCompletionBlock itemCompletionBlock) {
+        return [self addTags:tags toNode:node completionBlock:^(BOOL succeeded, NSError *error) {
+            itemCompletionBlock(succeeded ? node : nil, error);
+        }];
+    }];
+    tagOperation.completionQueue = [AlfrescoSessionUtils completionQueueForSession:self.session];
+    tagOperation.progressBlock = progressBlock;
+    [tagOperation startWithRequest:request completionBlock:^(NSDictionary *taggedNodes, NSDictionary *itemErrors) {
+        // the tagged nodes in the order they were given
+        NSMutableArray *resultNodes = [NSMutableArray arrayWithCapacity:taggedNodes.count];
+        NSMutableSet *identifiers = [NSMutableSet setWithCapacity:taggedNodes.count];
+        for (AlfrescoNode *node in nodes)
+        {
+            if (nil != node.identifier && nil != taggedNodes[node.identifier] && ![identifiers containsObject:node.identifier])
+            {
+                [identifiers addObject:node.identifier];
+                [resultNodes addObject:node];
+            }
+        }
+        completionBlock(resultNodes, [AlfrescoBulkNodeOperation errorWithCode:kAlfrescoErrorCodeTagging itemErrors:itemErrors]);
+    }];
+    return request;
+}
+
 @end
@@ -0,0 +1,171 @@
+/*
+ ******************************************************************************
+ * Copyright (C) 2005-2020 Alfresco Software Limited.
+ * 
+ * This file is part of the Alfresco Mobile SDK.
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *  
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *****************************************************************************
+ */
+
+#import <Foundation/Foundation.h>
+#import "AlfrescoSession.h"
+#import "AlfrescoFolder.h"
+#import "AlfrescoDocument.h"
+#import "AlfrescoContentFile.h"
+
+typedef NS_ENUM(NSInteger, AlfrescoUploadItemState)
+{
+    AlfrescoUploadItemStateQueued = 0,
+    AlfrescoUploadItemStateUploading,
+    AlfrescoUploadItemStateWaitingToRetry,
+    AlfrescoUploadItemStateCompleted,
+    AlfrescoUploadItemStateFailed,
+    AlfrescoUploadItemStateCancelled
+};
+
+/** An AlfrescoUploadItem represents one file added to an AlfrescoUploadQueue.
+ */
+
+@interface AlfrescoUploadItem : NSObject <NSCoding>
+
+@property (nonatomic, strong, readonly) NSString *identifier;
+@property (nonatomic, strong, readonly) NSString *documentName;
+@property (nonatomic, strong, readonly) AlfrescoFolder *folder;
+@property (nonatomic, strong, readonly) AlfrescoContentFile *contentFile;
+@property (nonatomic, strong, readonly) NSDictionary *properties;
+@property (nonatomic, assign, readonly) NSInteger priority;
+@property (nonatomic, assign, readonly) AlfrescoUploadItemState state;
+@property (nonatomic, assign, readonly) unsigned long long bytesUploaded;
+@property (nonatomic, assign, readonly) unsigned long long bytesTotal;
+/// The number of times the upload has been started
+@property (nonatomic, assign, readonly) NSUInteger attemptCount;
+/// The created document, once the state is AlfrescoUploadItemStateCompleted
+@property (nonatomic, strong, readonly) AlfrescoDocument *document;
+/// The error of the last attempt, the final one once the state is AlfrescoUploadItemStateFailed
+@property (nonatomic, strong, readonly) NSError *error;
+
+@end
+
+
+@class AlfrescoUploadQueue;
+
+@protocol AlfrescoUploadQueueDelegate <NSObject>
+
+@optional
+
+/// Called whenever more of the item has been uploaded.
+- (void)uploadQueue:(AlfrescoUploadQueue *)uploadQueue didUpdateProgressOfItem:(AlfrescoUploadItem *)item;
+
+/// Called whenever the item changes state, i.e. starts uploading, completes, fails or waits to be retried.
+- (void)uploadQueue:(AlfrescoUploadQueue *)uploadQueue didChangeStateOfItem:(AlfrescoUploadItem *)item;
+
+/// Called once no items are queued, uploading or waiting to be retried.
+- (void)uploadQueueDidFinish:(AlfrescoUploadQueue *)uploadQueue;
+
+@end
+
+
+/** The AlfrescoUploadQueue uploads any number of local files as new documents, running a bounded number of
+ uploads at once and starting queued ones by descending priority. Uploads failing with a network or server error
+ are retried with an exponential backoff. When a persistence path is given the unfinished items are saved, and
+ re-queued when a queue is initialised with the same path after the app restarts.
+ 
+ The queue, its items and its delegate are used on the main thread. Uploads are called back on the session's
+ kAlfrescoCompletionQueue, their outcome is handed over to the main queue before the queue's state is touched.
+ */
+
+@interface AlfrescoUploadQueue : NSObject
+
+@property (nonatomic, weak) id<AlfrescoUploadQueueDelegate> delegate;
+
+/// The maximum number of uploads running at once, defaults to 3
+@property (nonatomic, assign) NSUInteger maxConcurrentUploads;
+
+/// The number of times a failed upload is retried, defaults to 3
+@property (nonatomic, assign) NSUInteger maxRetryCount;
+
+/// The delay before the first retry of an upload, doubled for every further retry, defaults to 2 seconds
+@property (nonatomic, assign) NSTimeInterval retryDelay;
+
+@property (nonatomic, assign, readonly, getter = isPaused) BOOL paused;
+
+/// All items in the order they were added, finished items are kept until removeFinishedItems is called
+@property (nonatomic, strong, readonly) NSArray *items;
+
+/// The bytes uploaded by the completed and running items
+@property (nonatomic, assign, readonly) unsigned long long bytesUploaded;
+
+/// The bytes of all items except the failed and cancelled ones
+@property (nonatomic, assign, readonly) unsigned long long bytesTotal;
+
+/// The upload rate over the last few seconds in bytes per second
+@property (nonatomic, assign, readonly) double throughput;
+
+/// The estimated time to upload the remaining bytes at the current throughput, negative when unknown
+@property (nonatomic, assign, readonly) NSTimeInterval estimatedTimeRemaining;
+
+/**---------------------------------------------------------------------------------------
+ * @name Initialisation
+ *  ---------------------------------------------------------------------------------------
+ */
+
+/** Initialises with a standard Cloud or OnPremise session, items are not persisted.
+ 
+ @param session the AlfrescoSession to upload documents with.
+ */
+- (id)initWithSession:(id<AlfrescoSession>)session;
+
+/** Initialises with a standard Cloud or OnPremise session, saving the unfinished items to the given path.
+ Items saved by a previous queue with the same path are restored and queued straight away.
+ 
+ @param session the AlfrescoSession to upload documents with.
+ @param persistencePath The file the unfinished items are saved to.
+ */
+- (id)initWithSession:(id<AlfrescoSession>)session persistencePath:(NSString *)persistencePath;
+
+/**---------------------------------------------------------------------------------------
+ * @name Queue methods.
+ *  ---------------------------------------------------------------------------------------
+ */
+
+/** Adds a file to be uploaded as a new document.
+ 
+ @param documentName The name of the document to be created in the repository
+ @param folder The parent folder to create the document in.
+ @param file The local file to be uploaded, it must remain in place until the item has finished.
+ @param properties Additional properties that are used to create the document, they must support NSCoding when the queue is persisted.
+ @param priority Items with a higher priority are started first, items with the same priority in the order they were added.
+ */
+- (AlfrescoUploadItem *)addUploadWithName:(NSString *)documentName
+                           inParentFolder:(AlfrescoFolder *)folder
+                              contentFile:(AlfrescoContentFile *)file
+                               properties:(NSDictionary *)properties
+                                 priority:(NSInteger)priority;
+
+/// Cancels the item, whether it is queued, uploading or waiting to be retried.
+- (void)cancelItem:(AlfrescoUploadItem *)item;
+
+/// Queues a failed item again, resetting its attempt count.
+- (void)retryItem:(AlfrescoUploadItem *)item;
+
+/// Stops starting queued items, running uploads are cancelled and queued again.
+- (void)pause;
+
+/// Starts queued items again.
+- (void)resume;
+
+/// Removes the completed, failed and cancelled items.
+- (void)removeFinishedItems;
+
+@end
@@ -0,0 +1,670 @@
+/*
+ ******************************************************************************
+ * Copyright (C) 2005-2020 Alfresco Software Limited.
+ * 
+ * This file is part of the Alfresco Mobile SDK.
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *  
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *****************************************************************************
+ */
+
+#import "AlfrescoUploadQueue.h"
+#import "AlfrescoDocumentFolderService.h"
+#import "AlfrescoErrors.h"
+#import "AlfrescoLog.h"
+#import "CMISErrors.h"
+
+static NSInteger kUploadItemModelVersion = 1;
+static NSUInteger const kUploadQueueDefaultMaxConcurrentUploads = 3;
+static NSUInteger const kUploadQueueDefaultMaxRetryCount = 3;
+static NSTimeInterval const kUploadQueueDefaultRetryDelay = 2.0;
+static NSTimeInterval const kUploadQueueMaxRetryDelay = 60.0;
+static NSTimeInterval const kUploadQueueThroughputWindow = 5.0;
+
+@interface AlfrescoUploadItem ()
+@property (nonatomic, strong, readwrite) NSString *identifier;
+@property (nonatomic, strong, readwrite) NSString *documentName;
+@property (nonatomic, strong, readwrite) AlfrescoFolder *folder;
+@property (nonatomic, strong, readwrite) AlfrescoContentFile *contentFile;
+@property (nonatomic, strong, readwrite) NSDictionary *properties;
+@property (nonatomic, assign, readwrite) NSInteger priority;
+@property (nonatomic, assign, readwrite) AlfrescoUploadItemState state;
+@property (nonatomic, assign, readwrite) unsigned long long bytesUploaded;
+@property (nonatomic, assign, readwrite) unsigned long long bytesTotal;
+@property (nonatomic, assign, readwrite) NSUInteger attemptCount;
+@property (nonatomic, strong, readwrite) AlfrescoDocument *document;
+@property (nonatomic, strong, readwrite) NSError *error;
+@property (nonatomic, assign) unsigned long long sequenceNumber;
+@property (nonatomic, strong) AlfrescoRequest *request;
+@property (nonatomic, assign) BOOL requeueWhenCancelled;
+@end
+
+@implementation AlfrescoUploadItem
+
+- (id)initWithDocumentName:(NSString *)documentName
+                    folder:(AlfrescoFolder *)folder
+               contentFile:(AlfrescoContentFile *)contentFile
+                properties:(NSDictionary *)properties
+                  priority:(NSInteger)priority
+{
+    self = [super init];
+    if (nil != self)
+    {
+        self.identifier = [[NSUUID UUID] UUIDString];
+        self.documentName = documentName;
+        self.folder = folder;
+        self.contentFile = contentFile;
+        self.properties = properties;
+        self.priority = priority;
+        self.state = AlfrescoUploadItemStateQueued;
+        self.bytesTotal = contentFile.length;
+    }
+    return self;
+}
+
+- (BOOL)isFinished
+{
+    return (self.state == AlfrescoUploadItemStateCompleted || self.state == AlfrescoUploadItemStateFailed || self.state == AlfrescoUploadItemStateCancelled);
+}
+
+- (void)encodeWithCoder:(NSCoder *)aCoder
+{
+    [aCoder encodeInteger:kUploadItemModelVersion forKey:@"AlfrescoUploadItem"];
+    [aCoder encodeObject:self.identifier forKey:@"identifier"];
+    [aCoder encodeObject:self.documentName forKey:@"documentName"];
+    [aCoder encodeObject:self.folder forKey:@"folder"];
+    [aCoder encodeObject:self.contentFile.fileUrl forKey:@"fileUrl"];
+    [aCoder encodeObject:self.contentFile.mimeType forKey:@"mimeType"];
+    [aCoder encodeObject:self.properties forKey:@"properties"];
+    [aCoder encodeInteger:self.priority forKey:@"priority"];
+    [aCoder encodeInteger:self.state forKey:@"state"];
+    [aCoder encodeInteger:self.attemptCount forKey:@"attemptCount"];
+    
+    // the user info of an error may hold objects that can't be archived, only what's needed to report it is kept
+    if (nil != self.error)
+    {
+        [aCoder encodeObject:self.error.domain forKey:@"errorDomain"];
+        [aCoder encodeInteger:self.error.code forKey:@"errorCode"];
+        [aCoder encodeObject:self.error.localizedDescription forKey:@"errorDescription"];
+    }
+}
+
+- (id)initWithCoder:(NSCoder *)aDecoder
+{
+    self = [super init];
+    if (nil != self)
+    {
+        //uncomment this line if you need to check the model version
+//        NSInteger version = [aDecoder decodeIntegerForKey:@"AlfrescoUploadItem"];
+        self.identifier = [aDecoder decodeObjectForKey:@"identifier"];
+        self.documentName = [aDecoder decodeObjectForKey:@"documentName"];
+        self.folder = [aDecoder decodeObjectForKey:@"folder"];
+        NSURL *fileUrl = [aDecoder decodeObjectForKey:@"fileUrl"];
+        if (nil != fileUrl)
+        {
+            self.contentFile = [[AlfrescoContentFile alloc] initWithUrl:fileUrl mimeType:[aDecoder decodeObjectForKey:@"mimeType"]];
+        }
+        self.properties = [aDecoder decodeObjectForKey:@"properties"];
+        self.priority = [aDecoder decodeIntegerForKey:@"priority"];
+        self.state = [aDecoder decodeIntegerForKey:@"state"];
+        self.attemptCount = [aDecoder decodeIntegerForKey:@"attemptCount"];
+        NSString *errorDomain = [aDecoder decodeObjectForKey:@"errorDomain"];
+        if (nil != errorDomain)
+        {
+            NSString *errorDescription = [aDecoder decodeObjectForKey:@"errorDescription"];
+            self.error = [NSError errorWithDomain:errorDomain
+                                             code:[aDecoder decodeIntegerForKey:@"errorCode"]
+                                         userInfo:errorDescription ? @{NSLocalizedDescriptionKey: errorDescription} : nil];
+        }
+        self.bytesTotal = self.contentFile.length;
+    }
+    return self;
+}
+
+@end
+
+
+@interface AlfrescoUploadQueue ()
+@property (nonatomic, strong) id<AlfrescoSession> session;
+@property (nonatomic, strong) AlfrescoDocumentFolderService *documentFolderService;
+@property (nonatomic, strong) NSString *persistencePath;
+@property (nonatomic, strong) NSMutableArray *allItems;
+@property (nonatomic, strong) NSMutableArray *queuedItems;
+@property (nonatomic, strong) NSMutableArray *runningItems;
+@property (nonatomic, assign) NSUInteger waitingItemCount;
+@property (nonatomic, assign, readwrite) BOOL paused;
+@property (nonatomic, assign, readwrite) unsigned long long bytesUploaded;
+@property (nonatomic, strong) NSMutableArray *throughputSamples;
+@property (nonatomic, assign) unsigned long long nextSequenceNumber;
+@property (nonatomic, assign) BOOL saveScheduled;
+@end
+
+@implementation AlfrescoUploadQueue
+
+- (id)initWithSession:(id<AlfrescoSession>)session
+{
+    return [self initWithSession:session persistencePath:nil];
+}
+
+- (id)initWithSession:(id<AlfrescoSession>)session persistencePath:(NSString *)persistencePath
+{
+    // we can't do much without a session so just return nil
+    if (session == nil)
+    {
+        return nil;
+    }
+    
+    self = [super init];
+    if (nil != self)
+    {
+        self.session = session;
+        self.documentFolderService = [[AlfrescoDocumentFolderService alloc] initWithSession:session];
+        self.persistencePath = persistencePath;
+        self.maxConcurrentUploads = kUploadQueueDefaultMaxConcurrentUploads;
+        self.maxRetryCount = kUploadQueueDefaultMaxRetryCount;
+        self.retryDelay = kUploadQueueDefaultRetryDelay;
+        self.allItems = [NSMutableArray array];
+        self.queuedItems = [NSMutableArray array];
+        self.runningItems = [NSMutableArray array];
+        self.throughputSamples = [NSMutableArray array];
+        
+        [self restoreItems];
+    }
+    return self;
+}
+
+#pragma mark - Queue methods
+
+- (NSArray *)items
+{
+    return [self.allItems copy];
+}
+
+- (AlfrescoUploadItem *)addUploadWithName:(NSString *)documentName
+                           inParentFolder:(AlfrescoFolder *)folder
+                              contentFile:(AlfrescoContentFile *)file
+                               properties:(NSDictionary *)properties
+                                 priority:(NSInteger)priority
+{
+    [AlfrescoErrors assertArgumentNotNil:documentName argumentName:@"documentName"];
+    [AlfrescoErrors assertArgumentNotNil:folder argumentName:@"folder"];
+    [AlfrescoErrors assertArgumentNotNil:file argumentName:@"file"];
+    
+    AlfrescoUploadItem *item = [[AlfrescoUploadItem alloc] initWithDocumentName:documentName
+                                                                         folder:folder
+                                                                    contentFile:file
+                                                                     properties:properties
+                                                                       priority:priority];
+    [self.allItems addObject:item];
+    [self enqueueItem:item];
+    [self scheduleSave];
+    [self startQueuedItems];
+    
+    return item;
+}
+
+- (void)cancelItem:(AlfrescoUploadItem *)item
+{
+    if ([item isFinished])
+    {
+        return;
+    }
+    
+    AlfrescoUploadItemState previousState = item.state;
+    [self.queuedItems removeObject:item];
+    [self changeState:AlfrescoUploadItemStateCancelled ofItem:item];
+    
+    if (previousState == AlfrescoUploadItemStateUploading)
+    {
+        // the completion block of the cancelled request finds the item cancelled already and ignores the outcome
+        [self stopRunningItem:item];
+        [item.request cancel];
+    }
+    else if (previousState == AlfrescoUploadItemStateWaitingToRetry)
+    {
+        self.waitingItemCount--;
+    }
+    
+    [self scheduleSave];
+    [self startQueuedItems];
+}
+
+- (void)retryItem:(AlfrescoUploadItem *)item
+{
+    if (item.state != AlfrescoUploadItemStateFailed)
+    {
+        return;
+    }
+    
+    item.attemptCount = 0;
+    item.error = nil;
+    [self changeState:AlfrescoUploadItemStateQueued ofItem:item];
+    [self enqueueItem:item];
+    [self scheduleSave];
+    [self startQueuedItems];
+}
+
+- (void)pause
+{
+    if (self.paused)
+    {
+        return;
+    }
+    self.paused = YES;
+    
+    // uploads can't be resumed part way through, running items start from the beginning once the queue is resumed
+    for (AlfrescoUploadItem *item in [self.runningItems copy])
+    {
+        item.requeueWhenCancelled = YES;
+        [item.request cancel];
+    }
+}
+
+- (void)resume
+{
+    if (!self.paused)
+    {
+        return;
+    }
+    self.paused = NO;
+    [self startQueuedItems];
+}
+
+- (void)removeFinishedItems
+{
+    NSIndexSet *finishedIndexes = [self.allItems indexesOfObjectsPassingTest:^BOOL(AlfrescoUploadItem *item, NSUInteger index, BOOL *stop) {
+        return [item isFinished];
+    }];
+    [self.allItems removeObjectsAtIndexes:finishedIndexes];
+    [self scheduleSave];
+}
+
+#pragma mark - Progress
+
+- (unsigned long long)bytesTotal
+{
+    unsigned long long bytesTotal = 0;
+    for (AlfrescoUploadItem *item in self.allItems)
+    {
+        if (item.state != AlfrescoUploadItemStateFailed && item.state != AlfrescoUploadItemStateCancelled)
+        {
+            bytesTotal += item.bytesTotal;
+        }
+    }
+    return bytesTotal;
+}
+
+- (double)throughput
+{
+    [self discardThroughputSamplesBefore:[NSDate dateWithTimeIntervalSinceNow:-kUploadQueueThroughputWindow]];
+    if (self.throughputSamples.count < 2)
+    {
+        return 0;
+    }
+    
+    NSArray *firstSample = self.throughputSamples.firstObject;
+    NSArray *lastSample = self.throughputSamples.lastObject;
+    NSTimeInterval duration = [lastSample[0] timeIntervalSinceDate:firstSample[0]];
+    if (duration <= 0)
+    {
+        return 0;
+    }
+    return ([lastSample[1] doubleValue] - [firstSample[1] doubleValue]) / duration;
+}
+
+- (NSTimeInterval)estimatedTimeRemaining
+{
+    double throughput = self.throughput;
+    if (throughput <= 0)
+    {
+        return -1;
+    }
+    
+    unsigned long long bytesTotal = self.bytesTotal;
+    unsigned long long bytesRemaining = (bytesTotal > self.bytesUploaded) ? bytesTotal - self.bytesUploaded : 0;
+    return bytesRemaining / throughput;
+}
+
+- (void)addBytesUploaded:(long long)bytes
+{
+    self.bytesUploaded += bytes;
+    
+    // the samples only ever count bytes sent, bytes of restarted uploads are not taken off again
+    if (bytes > 0)
+    {
+        NSArray *lastSample = self.throughputSamples.lastObject;
+        unsigned long long bytesSent = [lastSample[1] unsignedLongLongValue] + bytes;
+        [self.throughputSamples addObject:@[[NSDate date], @(bytesSent)]];
+        [self discardThroughputSamplesBefore:[NSDate dateWithTimeIntervalSinceNow:-kUploadQueueThroughputWindow]];
+    }
+}
+
+- (void)discardThroughputSamplesBefore:(NSDate *)date
+{
+    // keep the newest sample outside the window as the starting point of the one inside it
+    NSUInteger discardCount = 0;
+    while (discardCount + 1 < self.throughputSamples.count && [self.throughputSamples[discardCount + 1][0] compare:date] == NSOrderedAscending)
+    {
+        discardCount++;
+    }
+    if (discardCount > 0)
+    {
+        [self.throughputSamples removeObjectsInRange:NSMakeRange(0, discardCount)];
+    }
+}
+
+#pragma mark - Private methods
+
+- (void)enqueueItem:(AlfrescoUploadItem *)item
+{
+    item.sequenceNumber = self.nextSequenceNumber++;
+    
+    // the queue is kept ordered by descending priority, and first in first out within a priority
+    NSUInteger index = [self.queuedItems indexOfObject:item
+                                         inSortedRange:NSMakeRange(0, self.queuedItems.count)
+                                               options:NSBinarySearchingInsertionIndex | NSBinarySearchingLastEqual
+                                       usingComparator:^NSComparisonResult(AlfrescoUploadItem *item1, AlfrescoUploadItem *item2) {
+        if (item1.priority != item2.priority)
+        {
+            return (item1.priority > item2.priority) ? NSOrderedAscending : NSOrderedDescending;
+        }
+        if (item1.sequenceNumber != item2.sequenceNumber)
+        {
+            return (item1.sequenceNumber < item2.sequenceNumber) ? NSOrderedAscending : NSOrderedDescending;
+        }
+        return NSOrderedSame;
+    }];
+    [self.queuedItems insertObject:item atIndex:index];
+}
+
+- (void)startQueuedItems
+{
+    NSUInteger maxConcurrentUploads = MAX(self.maxConcurrentUploads, 1);
+    while (!self.paused && self.queuedItems.count > 0 && self.runningItems.count < maxConcurrentUploads)
+    {
+        AlfrescoUploadItem *item = self.queuedItems.firstObject;
+        [self.queuedItems removeObjectAtIndex:0];
+        [self startItem:item];
+    }
+    
+    if (self.queuedItems.count == 0 && self.runningItems.count == 0 && self.waitingItemCount == 0)
+    {
+        if ([self.delegate respondsToSelector:@selector(uploadQueueDidFinish:)])
+        {
+            [self.delegate uploadQueueDidFinish:self];
+        }
+    }
+}
+
+- (void)startItem:(AlfrescoUploadItem *)item
+{
+    item.attemptCount++;
+    item.bytesUploaded = 0;
+    [self.runningItems addObject:item];
+    [self changeState:AlfrescoUploadItemStateUploading ofItem:item];
+    
+    // the service calls back on the session's completion queue, which may be concurrent, the queue's state is only used on the main queue
+    __weak AlfrescoUploadQueue *weakSelf = self;
+    item.request = [self.documentFolderService createDocumentWithName:item.documentName inParentFolder:item.folder contentFile:item.contentFile properties:item.properties completionBlock:^(AlfrescoDocument *document, NSError *error) {
+        dispatch_async(dispatch_get_main_queue(), ^{
+            [weakSelf item:item didCompleteWithDocument:document error:error];
+        });
+    } progressBlock:^(unsigned long long bytesTransferred, unsigned long long bytesTotal) {
+        dispatch_async(dispatch_get_main_queue(), ^{
+            [weakSelf item:item didUploadBytes:bytesTransferred];
+        });
+    }];
+}
+
+- (void)stopRunningItem:(AlfrescoUploadItem *)item
+{
+    [self.runningItems removeObject:item];
+    [self addBytesUploaded:-(long long)item.bytesUploaded];
+    item.bytesUploaded = 0;
+}
+
+- (void)item:(AlfrescoUploadItem *)item didUploadBytes:(unsigned long long)bytesUploaded
+{
+    if (item.state != AlfrescoUploadItemStateUploading || bytesUploaded <= item.bytesUploaded)
+    {
+        return;
+    }
+    
+    [self addBytesUploaded:(long long)(bytesUploaded - item.bytesUploaded)];
+    item.bytesUploaded = bytesUploaded;
+    
+    if ([self.delegate respondsToSelector:@selector(uploadQueue:didUpdateProgressOfItem:)])
+    {
+        [self.delegate uploadQueue:self didUpdateProgressOfItem:item];
+    }
+}
+
+- (void)item:(AlfrescoUploadItem *)item didCompleteWithDocument:(AlfrescoDocument *)document error:(NSError *)error
+{
+    item.request = nil;
+    if (item.state != AlfrescoUploadItemStateUploading)
+    {
+        // the item has been cancelled
+        return;
+    }
+    
+    [self stopRunningItem:item];
+    
+    if (nil != document)
+    {
+        [self addBytesUploaded:(long long)item.bytesTotal];
+        item.bytesUploaded = item.bytesTotal;
+        item.document = document;
+        item.error = nil;
+        item.requeueWhenCancelled = NO;
+        [self changeState:AlfrescoUploadItemStateCompleted ofItem:item];
+    }
+    else if (item.requeueWhenCancelled)
+    {
+        // cancelled by pause, the attempt doesn't count
+        item.requeueWhenCancelled = NO;
+        item.attemptCount--;
+        [self changeState:AlfrescoUploadItemStateQueued ofItem:item];
+        [self enqueueItem:item];
+    }
+    else if ([AlfrescoUploadQueue isTransientError:error] && item.attemptCount <= self.maxRetryCount)
+    {
+        item.error = error;
+        [self retryItemAfterDelay:item];
+    }
+    else
+    {
+        AlfrescoLogDebug(@"Upload of %@ failed after %lu attempts: %@", item.documentName, (unsigned long)item.attemptCount, error);
+        item.error = error;
+        [self changeState:AlfrescoUploadItemStateFailed ofItem:item];
+    }
+    
+    [self scheduleSave];
+    [self startQueuedItems];
+}
+
+- (void)retryItemAfterDelay:(AlfrescoUploadItem *)item
+{
+    NSTimeInterval delay = MIN(self.retryDelay * pow(2, item.attemptCount - 1), kUploadQueueMaxRetryDelay);
+    AlfrescoLogDebug(@"Retrying upload of %@ in %.1f seconds after: %@", item.documentName, delay, item.error);
+    
+    self.waitingItemCount++;
+    [self changeState:AlfrescoUploadItemStateWaitingToRetry ofItem:item];
+    
+    __weak AlfrescoUploadQueue *weakSelf = self;
+    dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(delay * NSEC_PER_SEC)), dispatch_get_main_queue(), ^{
+        AlfrescoUploadQueue *strongSelf = weakSelf;
+        if (nil != strongSelf && item.state == AlfrescoUploadItemStateWaitingToRetry)
+        {
+            strongSelf.waitingItemCount--;
+            [strongSelf changeState:AlfrescoUploadItemStateQueued ofItem:item];
+            [strongSelf enqueueItem:item];
+            [strongSelf startQueuedItems];
+        }
+    });
+}
+
+- (void)changeState:(AlfrescoUploadItemState)state ofItem:(AlfrescoUploadItem *)item
+{
+    item.state = state;
+    if ([self.delegate respondsToSelector:@selector(uploadQueue:didChangeStateOfItem:)])
+    {
+        [self.delegate uploadQueue:self didChangeStateOfItem:item];
+    }
+}
+
+/**
+ Network failures, time outs and 5xx responses are worth retrying. Anything else, i.e. an existing name, missing
+ permissions or a response that couldn't be parsed, will fail again.
+ */
++ (BOOL)isTransientError:(NSError *)error
+{
+    for (NSError *currentError = error; nil != currentError; currentError = currentError.userInfo[NSUnderlyingErrorKey])
+    {
+        if ([currentError.domain isEqualToString:NSURLErrorDomain])
+        {
+            return [AlfrescoUploadQueue isNetworkErrorCode:currentError.code];
+        }
+        if ([currentError.domain isEqualToString:kCMISErrorDomainName])
+        {
+            NSNumber *statusCode = currentError.userInfo[kCMISErrorKeyHTTPStatusCode];
+            if (nil != statusCode)
+            {
+                return (statusCode.integerValue >= 500);
+            }
+            if (currentError.code == kCMISErrorCodeNoNetworkConnection)
+            {
+                return YES;
+            }
+            if (currentError.code != kCMISErrorCodeConnection)
+            {
+                return NO;
+            }
+            // connection errors wrap the error of the failed task, those without one were failed by an open circuit
+            if (nil == currentError.userInfo[NSUnderlyingErrorKey])
+            {
+                return YES;
+            }
+        }
+        else if ([currentError.domain isEqualToString:kAlfrescoErrorDomainName])
+        {
+            if (currentError.code == kAlfrescoErrorCodeNoNetworkConnection || currentError.code == kAlfrescoErrorCodeServerUnavailable)
+            {
+                return YES;
+            }
+            NSNumber *statusCode = currentError.userInfo[kAlfrescoErrorKeyHTTPResponseCode];
+            if (nil != statusCode)
+            {
+                return (statusCode.integerValue >= 500);
+            }
+        }
+    }
+    return NO;
+}
+
++ (BOOL)isNetworkErrorCode:(NSInteger)code
+{
+    switch (code)
+    {
+        case NSURLErrorTimedOut:
+        case NSURLErrorCannotFindHost:
+        case NSURLErrorCannotConnectToHost:
+        case NSURLErrorNetworkConnectionLost:
+        case NSURLErrorDNSLookupFailed:
+        case NSURLErrorNotConnectedToInternet:
+        case NSURLErrorInternationalRoamingOff:
+        case NSURLErrorCallIsActive:
+        case NSURLErrorDataNotAllowed:
+            return YES;
+        default:
+            return NO;
+    }
+}
+
+#pragma mark - Persistence
+
+- (void)scheduleSave
+{
+    if (nil == self.persistencePath || self.saveScheduled)
+    {
+        return;
+    }
+    
+    // changes made in the same run loop iteration, i.e. adding many items, are written once
+    self.saveScheduled = YES;
+    __weak AlfrescoUploadQueue *weakSelf = self;
+    dispatch_async(dispatch_get_main_queue(), ^{
+        weakSelf.saveScheduled = NO;
+        [weakSelf saveItems];
+    });
+}
+
+- (void)saveItems
+{
+    NSIndexSet *unfinishedIndexes = [self.allItems indexesOfObjectsPassingTest:^BOOL(AlfrescoUploadItem *item, NSUInteger index, BOOL *stop) {
+        return (item.state != AlfrescoUploadItemStateCompleted && item.state != AlfrescoUploadItemStateCancelled);
+    }];
+    NSArray *unfinishedItems = [self.allItems objectsAtIndexes:unfinishedIndexes];
+    
+    if (![NSKeyedArchiver archiveRootObject:unfinishedItems toFile:self.persistencePath])
+    {
+        AlfrescoLogError(@"Could not save the upload queue to %@", self.persistencePath);
+    }
+}
+
+- (void)restoreItems
+{
+    if (nil == self.persistencePath || ![[NSFileManager defaultManager] fileExistsAtPath:self.persistencePath])
+    {
+        return;
+    }
+    
+    NSArray *restoredItems = nil;
+    @try
+    {
+        restoredItems = [NSKeyedUnarchiver unarchiveObjectWithFile:self.persistencePath];
+    }
+    @catch (NSException *exception)
+    {
+        AlfrescoLogError(@"Could not restore the upload queue from %@: %@", self.persistencePath, exception);
+    }
+    
+    for (AlfrescoUploadItem *item in restoredItems)
+    {
+        if (nil == item.contentFile || nil == item.folder)
+        {
+            continue;
+        }
+        
+        [self.allItems addObject:item];
+        if (item.state != AlfrescoUploadItemStateFailed)
+        {
+            // whatever was uploading when the app stopped starts from the beginning
+            item.state = AlfrescoUploadItemStateQueued;
+            [self enqueueItem:item];
+        }
+    }
+    
+    if (self.queuedItems.count > 0)
+    {
+        AlfrescoLogDebug(@"Restored %lu queued uploads", (unsigned long)self.queuedItems.count);
+        
+        // start once the caller has had the chance to set a delegate
+        __weak AlfrescoUploadQueue *weakSelf = self;
+        dispatch_async(dispatch_get_main_queue(), ^{
+            [weakSelf startQueuedItems];
+        });
+    }
+}
+
+@end
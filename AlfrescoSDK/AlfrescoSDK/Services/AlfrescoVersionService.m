@@ -67,7 +67,7 @@
     [AlfrescoErrors assertArgumentNotNil:document.identifier argumentName:@"document.identifier"];
     [AlfrescoErrors assertArgumentNotNil:completionBlock argumentName:@"completionBlock"];
     
-    AlfrescoRequest *request = [[AlfrescoRequest alloc] init];
+    AlfrescoRequest *request = [[AlfrescoRequest alloc] initWithService:self operation:_cmd];
     request.httpRequest = [self.cmisSession.binding.versioningService
                            retrieveAllVersions:document.identifier
                            filter:nil
@@ -106,7 +106,16 @@
         listingContext = self.session.defaultListingContext;
     }
     
-    AlfrescoRequest *request = [[AlfrescoRequest alloc] init];
+    // the CMIS version history can't be paged, so the following pages are taken from the versions fetched for the first one
+    NSString *listing = [NSString stringWithFormat:@"versions/%@", document.identifier];
+    AlfrescoPagingResult *cachedResult = [AlfrescoPagingUtils pagedResultFromCachedListing:listing listingContext:listingContext session:self.session];
+    if (nil != cachedResult)
+    {
+        completionBlock(cachedResult, nil);
+        return nil;
+    }
+    
+    AlfrescoRequest *request = [[AlfrescoRequest alloc] initWithService:self operation:_cmd];
     request.httpRequest = [self.cmisSession.binding.versioningService
                            retrieveAllVersions:document.identifier
                            filter:nil
@@ -130,7 +139,8 @@
                                                                        supportedKeys:self.supportedSortKeys
                                                                           defaultKey:self.defaultSortKey
                                                                            ascending:listingContext.sortAscending];
-             AlfrescoPagingResult *pagingResult = [AlfrescoPagingUtils pagedResultFromArray:sortedVersionArray listingContext:listingContext];
+             AlfrescoPagingResult *pagingResult = [AlfrescoPagingUtils pagedResultFromArray:sortedVersionArray listingContext:listingContext
+                                                                             cachingListing:listing session:self.session];
              completionBlock(pagingResult, nil);
              
          }
@@ -145,7 +155,7 @@
     [AlfrescoErrors assertArgumentNotNil:document.identifier argumentName:@"document.identifier"];
     [AlfrescoErrors assertArgumentNotNil:completionBlock argumentName:@"completionBlock"];
     
-    AlfrescoRequest *request = [[AlfrescoRequest alloc] init];
+    AlfrescoRequest *request = [[AlfrescoRequest alloc] initWithService:self operation:_cmd];
     CMISOperationContext *operationContext = [CMISOperationContext defaultOperationContext];
     request.httpRequest = [self.cmisSession.binding.versioningService retrieveObjectOfLatestVersion:document.identifier
                                                                                               major:NO
@@ -179,7 +189,7 @@
     // make sure the version identifier is stripped if present
     NSString *versionFreeIdentifier = [AlfrescoObjectConverter nodeRefWithoutVersionID:document.identifier];
     
-    AlfrescoRequest *request = [AlfrescoRequest new];
+    AlfrescoRequest *request = [[AlfrescoRequest alloc] initWithService:self operation:_cmd];
     request.httpRequest = [self.cmisSession.binding.versioningService checkOut:versionFreeIdentifier completionBlock:^(CMISObjectData *objectData, NSError *error) {
         if (objectData == nil)
         {
@@ -207,7 +217,7 @@
     [AlfrescoErrors assertArgumentNotNil:document argumentName:@"document"];
     [AlfrescoErrors assertArgumentNotNil:completionBlock argumentName:@"completionBlock"];
     
-    AlfrescoRequest *request = [AlfrescoRequest new];
+    AlfrescoRequest *request = [[AlfrescoRequest alloc] initWithService:self operation:_cmd];
     request.httpRequest = [self.cmisSession.binding.versioningService cancelCheckOut:document.identifier
                                                                      completionBlock:^(BOOL checkOutCancelled, NSError *error) {
         if (!checkOutCancelled)
@@ -273,7 +283,7 @@
         }];
     };
     
-    AlfrescoRequest *request = [AlfrescoRequest new];
+    AlfrescoRequest *request = [[AlfrescoRequest alloc] initWithService:self operation:_cmd];
     if (properties != nil)
     {
         [AlfrescoCMISUtil preparePropertiesForUpdate:properties
@@ -349,7 +359,7 @@
         }];
     };
     
-    AlfrescoRequest *request = [AlfrescoRequest new];
+    AlfrescoRequest *request = [[AlfrescoRequest alloc] initWithService:self operation:_cmd];
     if (properties != nil)
     {
         [AlfrescoCMISUtil preparePropertiesForUpdate:properties
@@ -394,7 +404,7 @@
         listingContext = self.session.defaultListingContext;
     }
     
-    AlfrescoRequest *request = [[AlfrescoRequest alloc] init];
+    AlfrescoRequest *request = [[AlfrescoRequest alloc] initWithService:self operation:_cmd];
     
     CMISOperationContext *opContext = [CMISOperationContext defaultOperationContext];
     if (listingContext.maxItems > 0)
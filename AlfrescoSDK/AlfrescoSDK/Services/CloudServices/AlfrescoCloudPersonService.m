@@ -89,7 +89,7 @@
     }
     
     // Execute HTTP call
-    AlfrescoRequest *alfrescoRequest = [[AlfrescoRequest alloc] init];
+    AlfrescoRequest *alfrescoRequest = [[AlfrescoRequest alloc] initWithService:self operation:_cmd];
     [self.session.networkProvider executeRequestWithURL:queryURL session:self.session requestBody:[[atomEntryWriter generateAtomEntryXML] dataUsingEncoding:NSUTF8StringEncoding] method:kAlfrescoHTTPPost alfrescoRequest:alfrescoRequest completionBlock:^(NSData *data, NSError *error) {
         if (data)
         {
@@ -83,7 +83,16 @@
     }
      
     NSURL *url = [AlfrescoURLUtils buildURLFromBaseURLString:self.baseApiUrl extensionURL:kAlfrescoLegacyActivityAPI];
-    AlfrescoRequest *alfrescoRequest = [[AlfrescoRequest alloc] init];
+    
+    // the activity feed can't be paged, so the following pages are taken from the feed fetched for the first one
+    AlfrescoPagingResult *cachedResult = [AlfrescoPagingUtils pagedResultFromCachedListing:url.absoluteString listingContext:listingContext session:self.session];
+    if (nil != cachedResult)
+    {
+        completionBlock(cachedResult, nil);
+        return nil;
+    }
+    
+    AlfrescoRequest *alfrescoRequest = [[AlfrescoRequest alloc] initWithService:self operation:_cmd];
     [self.session.networkProvider executeRequestWithURL:url session:self.session alfrescoRequest:alfrescoRequest completionBlock:^(NSData *responseData, NSError *error){
         if (nil == responseData)
         {
@@ -94,7 +103,8 @@
             NSError *conversionError = nil;
             NSArray *activityStreamArray = [self activityStreamArrayFromJSONData:responseData error:&conversionError];
             NSArray *filteredActivityStream = [self activityArrayByApplyingFilter:listingContext.listingFilter activities:activityStreamArray];
-            AlfrescoPagingResult *pagingResult = [AlfrescoPagingUtils pagedResultFromArray:filteredActivityStream listingContext:listingContext];
+            AlfrescoPagingResult *pagingResult = [AlfrescoPagingUtils pagedResultFromArray:filteredActivityStream listingContext:listingContext
+                                                                            cachingListing:url.absoluteString session:self.session];
             completionBlock(pagingResult, conversionError);
         }
     }];
@@ -126,7 +136,16 @@
     
     NSString *requestString = [kAlfrescoLegacyActivityForSiteAPI stringByReplacingOccurrencesOfString:kAlfrescoSiteId withString:site.shortName];
     NSURL *url = [AlfrescoURLUtils buildURLFromBaseURLString:self.baseApiUrl extensionURL:requestString];
-    AlfrescoRequest *alfrescoRequest = [[AlfrescoRequest alloc] init];
+    
+    // following pages are taken from the feed fetched for the first one
+    AlfrescoPagingResult *cachedResult = [AlfrescoPagingUtils pagedResultFromCachedListing:url.absoluteString listingContext:listingContext session:self.session];
+    if (nil != cachedResult)
+    {
+        completionBlock(cachedResult, nil);
+        return nil;
+    }
+    
+    AlfrescoRequest *alfrescoRequest = [[AlfrescoRequest alloc] initWithService:self operation:_cmd];
     [self.session.networkProvider executeRequestWithURL:url session:self.session alfrescoRequest:alfrescoRequest completionBlock:^(NSData *responseData, NSError *error){
         if (nil == responseData)
         {
@@ -137,7 +156,8 @@
             NSError *conversionError = nil;
             NSArray *activityStreamArray = [self activityStreamArrayFromJSONData:responseData error:&conversionError];
             NSArray *filteredActivityStream = [self activityArrayByApplyingFilter:listingContext.listingFilter activities:activityStreamArray];
-            AlfrescoPagingResult *pagingResult = [AlfrescoPagingUtils pagedResultFromArray:filteredActivityStream listingContext:listingContext];
+            AlfrescoPagingResult *pagingResult = [AlfrescoPagingUtils pagedResultFromArray:filteredActivityStream listingContext:listingContext
+                                                                            cachingListing:url.absoluteString session:self.session];
             completionBlock(pagingResult, conversionError);
         }
     }];
@@ -81,7 +81,7 @@
     requestString = [requestString stringByAppendingString:queryString];
     
     NSURL *url = [AlfrescoURLUtils buildURLFromBaseURLString:self.baseApiUrl extensionURL:requestString];
-    AlfrescoRequest *alfrescoRequest = [[AlfrescoRequest alloc] init];
+    AlfrescoRequest *alfrescoRequest = [[AlfrescoRequest alloc] initWithService:self operation:_cmd];
     [self.session.networkProvider executeRequestWithURL:url session:self.session alfrescoRequest:alfrescoRequest completionBlock:^(NSData *responseData, NSError *error){
         if (nil == responseData)
         {
@@ -139,7 +139,7 @@
     requestString = [requestString stringByAppendingString:queryString];
     
     NSURL *url = [AlfrescoURLUtils buildURLFromBaseURLString:self.baseApiUrl extensionURL:requestString];
-    AlfrescoRequest *alfrescoRequest = [[AlfrescoRequest alloc] init];
+    AlfrescoRequest *alfrescoRequest = [[AlfrescoRequest alloc] initWithService:self operation:_cmd];
     [self.session.networkProvider executeRequestWithURL:url session:self.session alfrescoRequest:alfrescoRequest completionBlock:^(NSData *responseData, NSError *error){
         if (nil == responseData)
         {
@@ -197,7 +197,7 @@
     NSString *requestString = [kAlfrescoLegacyCommentsAPI stringByReplacingOccurrencesOfString:kAlfrescoNodeRef
                                                                                        withString:cleanNodeId];
     NSURL *url = [AlfrescoURLUtils buildURLFromBaseURLString:self.baseApiUrl extensionURL:requestString];
-    AlfrescoRequest *alfrescoRequest = [[AlfrescoRequest alloc] init];
+    AlfrescoRequest *alfrescoRequest = [[AlfrescoRequest alloc] initWithService:self operation:_cmd];
     
     [self.session.networkProvider executeRequestWithURL:url
                                                 session:self.session
@@ -240,7 +240,7 @@
                                                                                              withString:[commentId stringByReplacingOccurrencesOfString:@"://" withString:@"/"]];
     
     NSURL *url = [AlfrescoURLUtils buildURLFromBaseURLString:self.baseApiUrl extensionURL:requestString];
-    AlfrescoRequest *alfrescoRequest = [[AlfrescoRequest alloc] init];
+    AlfrescoRequest *alfrescoRequest = [[AlfrescoRequest alloc] initWithService:self operation:_cmd];
     
     [self.session.networkProvider executeRequestWithURL:url
                                                 session:self.session
@@ -279,7 +279,7 @@
     NSString *requestString = [kAlfrescoLegacyCommentForNodeAPI stringByReplacingOccurrencesOfString:kAlfrescoCommentId
                                                                                              withString:[commentId stringByReplacingOccurrencesOfString:@"://" withString:@"/"]];
     NSURL *url = [AlfrescoURLUtils buildURLFromBaseURLString:self.baseApiUrl extensionURL:requestString];
-    AlfrescoRequest *alfrescoRequest = [[AlfrescoRequest alloc] init];
+    AlfrescoRequest *alfrescoRequest = [[AlfrescoRequest alloc] initWithService:self operation:_cmd];
     [self.session.networkProvider executeRequestWithURL:url
                                                 session:self.session
                                             requestBody:jsonData
@@ -19,6 +19,7 @@
  */
 
 #import "AlfrescoLegacyAPIDocumentFolderService.h"
+#import "AlfrescoSessionUtils.h"
 #import "AlfrescoInternalConstants.h"
 #import "AlfrescoErrors.h"
 #import "AlfrescoURLUtils.h"
@@ -44,18 +45,10 @@
         self.baseApiUrl = [[self.session.baseUrl absoluteString] stringByAppendingString:kAlfrescoLegacyAPIPath];
         
         // setup favorites cache
-        id cachedObj = [self.session objectForParameter:kAlfrescoSessionCacheFavorites];
-        if (cachedObj)
-        {
-            AlfrescoLogDebug(@"Found an existing FavoritesCache in session");
-            self.favoritesCache = (AlfrescoFavoritesCache *)cachedObj;
-        }
-        else
-        {
-            self.favoritesCache = [AlfrescoFavoritesCache new];
-            [self.session setObject:self.favoritesCache forParameter:kAlfrescoSessionCacheFavorites];
+        self.favoritesCache = [AlfrescoSessionUtils objectForParameter:kAlfrescoSessionCacheFavorites ofSession:self.session createIfAbsentWithBlock:^id{
             AlfrescoLogDebug(@"Created new FavoritesCache object");
-        }
+            return [AlfrescoFavoritesCache new];
+        }];
     }
     return self;
 }
@@ -69,7 +62,7 @@
     [AlfrescoErrors assertArgumentNotNil:completionBlock argumentName:@"completionBlock"];
     
     NSURL *url = [self renditionURLForNode:node renditionName:renditionName];
-    AlfrescoRequest *alfrescoRequest = [[AlfrescoRequest alloc] init];
+    AlfrescoRequest *alfrescoRequest = [[AlfrescoRequest alloc] initWithService:self operation:_cmd];
     
     [self.session.networkProvider executeRequestWithURL:url session:self.session alfrescoRequest:alfrescoRequest completionBlock:^(NSData *responseData, NSError *error) {
         if (error)
@@ -96,7 +89,7 @@
     [AlfrescoErrors assertArgumentNotNil:completionBlock argumentName:@"completionBlock"];
     
     NSURL *url = [self renditionURLForNode:node renditionName:renditionName];
-    AlfrescoRequest *alfrescoRequest = [[AlfrescoRequest alloc] init];
+    AlfrescoRequest *alfrescoRequest = [[AlfrescoRequest alloc] initWithService:self operation:_cmd];
     
     [self.session.networkProvider executeRequestWithURL:url session:self.session alfrescoRequest:alfrescoRequest outputStream:outputStream completionBlock:^(NSData *responseData, NSError *error) {
         if (error)
@@ -366,7 +359,7 @@
     NSString *requestString = [kAlfrescoLegacyPreferencesAPI stringByReplacingOccurrencesOfString:kAlfrescoPersonId withString:self.session.personIdentifier];
     NSURL *url = [AlfrescoURLUtils buildURLFromBaseURLString:self.baseApiUrl extensionURL:requestString];
     
-    AlfrescoRequest *request = [[AlfrescoRequest alloc] init];
+    AlfrescoRequest *request = [[AlfrescoRequest alloc] initWithService:self operation:_cmd];
     __weak typeof(self) weakSelf = self;
     [self.session.networkProvider executeRequestWithURL:url session:self.session method:kAlfrescoHTTPGet alfrescoRequest:request
                                         completionBlock:^(NSData *data, NSError *requestError) {
@@ -556,7 +549,7 @@
         url = [AlfrescoURLUtils buildURLFromBaseURLString:self.baseApiUrl extensionURL:requestString];
     }
     
-    AlfrescoRequest *request = [[AlfrescoRequest alloc] init];    
+    AlfrescoRequest *request = [[AlfrescoRequest alloc] initWithService:self operation:_cmd];    
     [self.session.networkProvider executeRequestWithURL:url
                                                 session:self.session
                                             requestBody:data
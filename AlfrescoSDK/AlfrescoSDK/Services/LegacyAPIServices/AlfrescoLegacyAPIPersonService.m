@@ -55,7 +55,7 @@
     [AlfrescoErrors assertArgumentNotNil:completionBlock argumentName:@"completionBlock"];
     NSString *requestString = [kAlfrescoLegacyPersonAPI stringByReplacingOccurrencesOfString:kAlfrescoPersonId withString:identifier];
     NSURL *url = [AlfrescoURLUtils buildURLFromBaseURLString:self.baseApiUrl extensionURL:requestString];
-    AlfrescoRequest *alfrescoRequest = [[AlfrescoRequest alloc] init];
+    AlfrescoRequest *alfrescoRequest = [[AlfrescoRequest alloc] initWithService:self operation:_cmd];
     [self.session.networkProvider executeRequestWithURL:url
                                                 session:self.session
                                         alfrescoRequest:alfrescoRequest
@@ -91,7 +91,7 @@
 {
     NSString *requestString = [kAlfrescoLegacyAvatarForPersonAPI stringByReplacingOccurrencesOfString:kAlfrescoPersonId withString:person.identifier];
     NSURL *url = [AlfrescoURLUtils buildURLFromBaseURLString:[self.session.baseUrl absoluteString] extensionURL:requestString];
-    AlfrescoRequest *alfrescoRequest = [[AlfrescoRequest alloc] init];
+    AlfrescoRequest *alfrescoRequest = [[AlfrescoRequest alloc] initWithService:self operation:_cmd];
     [self.session.networkProvider executeRequestWithURL:url
                                                 session:self.session
                                         alfrescoRequest:alfrescoRequest
@@ -119,7 +119,7 @@
     }
     NSString *requestString = [NSString stringWithFormat:@"%@/service/%@",[self.session.baseUrl absoluteString],avatarId];
     NSURL *url = [NSURL URLWithString:requestString];
-    AlfrescoRequest *alfrescoRequest = [[AlfrescoRequest alloc] init];
+    AlfrescoRequest *alfrescoRequest = [[AlfrescoRequest alloc] initWithService:self operation:_cmd];
     [self.session.networkProvider executeRequestWithURL:url
                                                 session:self.session
                                         alfrescoRequest:alfrescoRequest
@@ -154,9 +154,18 @@
         listingContext = self.session.defaultListingContext;
     }
     
+    // the people search can't be paged, so the following pages are taken from the people found for the first one
+    NSString *listing = [kAlfrescoLegacyPersonSearchAPI stringByReplacingOccurrencesOfString:kAlfrescoSearchFilter withString:keywords];
+    AlfrescoPagingResult *cachedResult = [AlfrescoPagingUtils pagedResultFromCachedListing:listing listingContext:listingContext session:self.session];
+    if (nil != cachedResult)
+    {
+        completionBlock(cachedResult, nil);
+        return nil;
+    }
+    
     AlfrescoRequest *request = [self searchPeople:keywords completionBlock:^(NSArray *array, NSError *error) {
-        
-        AlfrescoPagingResult *pagingResult = [AlfrescoPagingUtils pagedResultFromArray:array listingContext:listingContext];
+        AlfrescoPagingResult *pagingResult = [AlfrescoPagingUtils pagedResultFromArray:array listingContext:listingContext
+                                                                        cachingListing:listing session:self.session];
         completionBlock(pagingResult, error);
     }];    
     return request;
@@ -168,7 +177,7 @@
 {
     NSString *requestString = [kAlfrescoLegacyPersonSearchAPI stringByReplacingOccurrencesOfString:kAlfrescoSearchFilter withString:keywords];
     NSURL *url = [AlfrescoURLUtils buildURLFromBaseURLString:self.baseApiUrl extensionURL:requestString];
-    AlfrescoRequest *alfrescoRequest = [[AlfrescoRequest alloc] init];
+    AlfrescoRequest *alfrescoRequest = [[AlfrescoRequest alloc] initWithService:self operation:_cmd];
     [self.session.networkProvider executeRequestWithURL:url
                                                 session:self.session
                                         alfrescoRequest:alfrescoRequest
@@ -17,6 +17,7 @@
  ******************************************************************************/
 
 #import "AlfrescoLegacyAPISiteService.h"
+#import "AlfrescoSessionUtils.h"
 #import "AlfrescoInternalConstants.h"
 #import "AlfrescoCMISToAlfrescoObjectConverter.h"
 #import "AlfrescoURLUtils.h"
@@ -64,18 +65,12 @@
         self.supportedSortKeys = @[kAlfrescoSortByTitle, kAlfrescoSortByShortname];
         self.joinRequests = [NSMutableArray array];
 
-        id cachedObj = [self.session objectForParameter:kAlfrescoSessionCacheSites];
-        if (cachedObj)
-        {
-            AlfrescoLogTrace(@"Found an existing SiteCache in session");
-            self.siteCache = (AlfrescoSiteCache *)cachedObj;
-        }
-        else
-        {
-            self.siteCache = [AlfrescoSiteCache new];
-            [self.session setObject:self.siteCache forParameter:kAlfrescoSessionCacheSites];
+        self.siteCache = [AlfrescoSessionUtils objectForParameter:kAlfrescoSessionCacheSites ofSession:self.session createIfAbsentWithBlock:^id{
             AlfrescoLogDebug(@"Created new SiteCache object");
-        }
+            AlfrescoSiteCache *siteCache = [AlfrescoSiteCache new];
+            siteCache.completionQueue = [AlfrescoSessionUtils completionQueueForSession:session];
+            return siteCache;
+        }];
     }
     return self;
 }
@@ -317,7 +312,7 @@
     __block AlfrescoDocumentFolderService *docService = [[AlfrescoDocumentFolderService alloc] initWithSession:self.session];
     NSString *requestString = [kAlfrescoLegacySiteDoclibAPI stringByReplacingOccurrencesOfString:kAlfrescoSiteId withString:siteShortName];
     NSURL *url = [AlfrescoURLUtils buildURLFromBaseURLString:[self.session.baseUrl absoluteString] extensionURL:requestString];
-    AlfrescoRequest *request = [[AlfrescoRequest alloc] init];
+    AlfrescoRequest *request = [[AlfrescoRequest alloc] initWithService:self operation:_cmd];
     [self.session.networkProvider executeRequestWithURL:url session:self.session alfrescoRequest:request completionBlock:^(NSData *data, NSError *error){
         if (nil == data)
         {
@@ -369,7 +364,7 @@
                                                                                                       withString:self.session.personIdentifier];
     NSURL *url = [AlfrescoURLUtils buildURLFromBaseURLString:self.baseApiUrl extensionURL:requestString];
     NSData *jsonData = [self jsonDataForFavoriteSites:site.shortName addFavorite:YES];
-    AlfrescoRequest *request = [[AlfrescoRequest alloc] init];
+    AlfrescoRequest *request = [[AlfrescoRequest alloc] initWithService:self operation:_cmd];
     __weak typeof(self) weakSelf = self;
     [self.session.networkProvider executeRequestWithURL:url
                                                 session:self.session
@@ -402,7 +397,7 @@
                                                                                                       withString:self.session.personIdentifier];
     NSURL *url = [AlfrescoURLUtils buildURLFromBaseURLString:self.baseApiUrl extensionURL:requestString];
     NSData *jsonData = [self jsonDataForFavoriteSites:site.shortName addFavorite:NO];
-    AlfrescoRequest *request = [[AlfrescoRequest alloc] init];
+    AlfrescoRequest *request = [[AlfrescoRequest alloc] initWithService:self operation:_cmd];
     __weak typeof(self) weakSelf = self;
     [self.session.networkProvider executeRequestWithURL:url
                                                 session:self.session
@@ -518,7 +513,7 @@
                                                                                                   withString:site.identifier];
     requestString = [requestString stringByReplacingOccurrencesOfString:kAlfrescoInviteId withString:foundRequest.identifier];
     NSURL *url = [AlfrescoURLUtils buildURLFromBaseURLString:self.baseApiUrl extensionURL:requestString];
-    AlfrescoRequest *request = [[AlfrescoRequest alloc] init];
+    AlfrescoRequest *request = [[AlfrescoRequest alloc] initWithService:self operation:_cmd];
     __weak typeof(self) weakSelf = self;
     [self.session.networkProvider executeRequestWithURL:url
                                                 session:self.session
@@ -551,7 +546,7 @@
                                                                                         withString:self.session.personIdentifier];
     requestString = [requestString stringByReplacingOccurrencesOfString:kAlfrescoSiteId withString:site.identifier];
     NSURL *url = [AlfrescoURLUtils buildURLFromBaseURLString:self.baseApiUrl extensionURL:requestString];
-    AlfrescoRequest *request = [[AlfrescoRequest alloc] init];
+    AlfrescoRequest *request = [[AlfrescoRequest alloc] initWithService:self operation:_cmd];
     __weak typeof(self) weakSelf = self;
     [self.session.networkProvider executeRequestWithURL:url session:self.session method:kAlfrescoHTTPDelete alfrescoRequest:request completionBlock:^(NSData *data, NSError *error){
         if (error)
@@ -592,7 +587,16 @@
     NSString *requestString = [kAlfrescoLegacyJoinPublicSiteAPI stringByReplacingOccurrencesOfString:kAlfrescoSiteId
                                                                                              withString:site.identifier];
     NSURL *url = [AlfrescoURLUtils buildURLFromBaseURLString:self.baseApiUrl extensionURL:requestString];
-    AlfrescoRequest *request = [[AlfrescoRequest alloc] init];
+    
+    // the membership API can't page, so the following pages are taken from the members fetched for the first one
+    AlfrescoPagingResult *cachedResult = [AlfrescoPagingUtils pagedResultFromCachedListing:url.absoluteString listingContext:listingContext session:self.session];
+    if (nil != cachedResult)
+    {
+        completionBlock(cachedResult, nil);
+        return nil;
+    }
+    
+    AlfrescoRequest *request = [[AlfrescoRequest alloc] initWithService:self operation:_cmd];
     __weak typeof(self) weakSelf = self;
     [self.session.networkProvider executeRequestWithURL:url session:self.session alfrescoRequest:request completionBlock:^(NSData *data, NSError *error) {
         if (nil == data)
@@ -605,7 +609,8 @@
             NSArray *members = [weakSelf membersArrayFromJSONData:data error:&conversionError];
             if (conversionError == nil)
             {
-                AlfrescoPagingResult *pagingResult = [AlfrescoPagingUtils pagedResultFromArray:members listingContext:listingContext];
+                AlfrescoPagingResult *pagingResult = [AlfrescoPagingUtils pagedResultFromArray:members listingContext:listingContext
+                                                                                cachingListing:url.absoluteString session:weakSelf.session];
                 completionBlock(pagingResult, nil);
             }
             else
@@ -637,7 +642,15 @@
     requestString = [requestString stringByReplacingOccurrencesOfString:kAlfrescoSearchFilter withString:keywords];
     NSURL *url = [AlfrescoURLUtils buildURLFromBaseURLString:self.baseApiUrl extensionURL:requestString];
     
-    AlfrescoRequest *request = [[AlfrescoRequest alloc] init];
+    // following pages of the search are taken from the members found for the first one
+    AlfrescoPagingResult *cachedResult = [AlfrescoPagingUtils pagedResultFromCachedListing:url.absoluteString listingContext:listingContext session:self.session];
+    if (nil != cachedResult)
+    {
+        completionBlock(cachedResult, nil);
+        return nil;
+    }
+    
+    AlfrescoRequest *request = [[AlfrescoRequest alloc] initWithService:self operation:_cmd];
     __weak typeof(self) weakSelf = self;
     [self.session.networkProvider executeRequestWithURL:url session:self.session alfrescoRequest:request completionBlock:^(NSData *data, NSError *error) {
         if (nil == data)
@@ -650,7 +663,8 @@
             NSArray *members = [weakSelf membersArrayFromJSONData:data error:&conversionError];
             if (conversionError == nil)
             {
-                AlfrescoPagingResult *pagingResult = [AlfrescoPagingUtils pagedResultFromArray:members listingContext:listingContext];
+                AlfrescoPagingResult *pagingResult = [AlfrescoPagingUtils pagedResultFromArray:members listingContext:listingContext
+                                                                                cachingListing:url.absoluteString session:weakSelf.session];
                 completionBlock(pagingResult, error);
             }
             else
@@ -674,7 +688,7 @@
     requestString = [requestString stringByReplacingOccurrencesOfString:kAlfrescoSiteId withString:site.identifier];
     NSURL *url = [AlfrescoURLUtils buildURLFromBaseURLString:self.baseApiUrl extensionURL:requestString];
     
-    AlfrescoRequest *request = [[AlfrescoRequest alloc] init];
+    AlfrescoRequest *request = [[AlfrescoRequest alloc] initWithService:self operation:_cmd];
     [self.session.networkProvider executeRequestWithURL:url session:self.session method:kAlfrescoHTTPGet alfrescoRequest:request completionBlock:^(NSData *data, NSError *error) {
         
         // if person is not member : the request returns error and data is nil so its difficult to differentiate if request failed or person is not member
@@ -699,7 +713,7 @@
     NSString *requestString = [kAlfrescoLegacySiteSearchAPI stringByReplacingOccurrencesOfString:kAlfrescoSearchFilter withString:keywords];
     NSURL *url = [AlfrescoURLUtils buildURLFromBaseURLString:self.baseApiUrl extensionURL:requestString];
     
-    AlfrescoRequest *request = [[AlfrescoRequest alloc] init];
+    AlfrescoRequest *request = [[AlfrescoRequest alloc] initWithService:self operation:_cmd];
 
     [self.session.networkProvider executeRequestWithURL:url session:self.session method:kAlfrescoHTTPGet alfrescoRequest:request completionBlock:^(NSData *data, NSError *error) {
         if (error || data == nil)
@@ -731,7 +745,15 @@
     NSString *requestString = [kAlfrescoLegacySiteSearchAPI stringByReplacingOccurrencesOfString:kAlfrescoSearchFilter withString:keywords];
     NSURL *url = [AlfrescoURLUtils buildURLFromBaseURLString:self.baseApiUrl extensionURL:requestString];
     
-    AlfrescoRequest *request = [[AlfrescoRequest alloc] init];
+    // the site search API can't page, so the following pages are taken from the sites found for the first one
+    AlfrescoPagingResult *cachedResult = [AlfrescoPagingUtils pagedResultFromCachedListing:url.absoluteString listingContext:listingContext session:self.session];
+    if (nil != cachedResult)
+    {
+        completionBlock(cachedResult, nil);
+        return nil;
+    }
+    
+    AlfrescoRequest *request = [[AlfrescoRequest alloc] initWithService:self operation:_cmd];
     
     [self.session.networkProvider executeRequestWithURL:url session:self.session method:kAlfrescoHTTPGet alfrescoRequest:request completionBlock:^(NSData *data, NSError *error) {
         if (error || data == nil)
@@ -742,7 +764,8 @@
         {
             NSError *conversionError = nil;
             NSArray *siteData = [self siteArrayFromJSONData:data error:&conversionError];
-            AlfrescoPagingResult *pagingResult = [AlfrescoPagingUtils pagedResultFromArray:siteData listingContext:listingContext];
+            AlfrescoPagingResult *pagingResult = [AlfrescoPagingUtils pagedResultFromArray:siteData listingContext:listingContext
+                                                                            cachingListing:url.absoluteString session:self.session];
             completionBlock(pagingResult, error);
         }
     }];
@@ -1156,7 +1179,7 @@
 
 - (AlfrescoRequest *)retrieveMemberSiteDataWithCompletionBlock:(AlfrescoArrayCompletionBlock)completionBlock
 {
-    AlfrescoRequest *alfrescoRequest = [[AlfrescoRequest alloc] init];
+    AlfrescoRequest *alfrescoRequest = [[AlfrescoRequest alloc] initWithService:self operation:_cmd];
     __weak typeof(self) weakSelf = self;
     
     NSString *siteString = [kAlfrescoLegacySiteForPersonAPI stringByReplacingOccurrencesOfString:kAlfrescoPersonId withString:self.session.personIdentifier];
@@ -1180,7 +1203,7 @@
 
 - (AlfrescoRequest *)retrieveFavoriteSiteDataWithCompletionBlock:(AlfrescoArrayCompletionBlock)completionBlock
 {
-    AlfrescoRequest *alfrescoRequest = [[AlfrescoRequest alloc] init];
+    AlfrescoRequest *alfrescoRequest = [[AlfrescoRequest alloc] initWithService:self operation:_cmd];
     __weak typeof(self) weakSelf = self;
     
     NSString *favRequestString = [kAlfrescoLegacyFavoriteSiteForPersonAPI stringByReplacingOccurrencesOfString:kAlfrescoPersonId
@@ -1205,7 +1228,7 @@
 
 - (AlfrescoRequest *)retrievePendingSiteDataWithCompletionBlock:(AlfrescoArrayCompletionBlock)completionBlock
 {
-    AlfrescoRequest *alfrescoRequest = [[AlfrescoRequest alloc] init];
+    AlfrescoRequest *alfrescoRequest = [[AlfrescoRequest alloc] initWithService:self operation:_cmd];
     __weak typeof(self) weakSelf = self;
     
     NSString *pendingString = [kAlfrescoLegacyPendingJoinRequestsAPI stringByReplacingOccurrencesOfString:kAlfrescoPersonId
@@ -1236,7 +1259,7 @@
 
 - (AlfrescoRequest *)retrieveDataForSiteWithShortName:(NSString *)shortName completionBlock:(AlfrescoSiteCompletionBlock)completionBlock
 {
-    AlfrescoRequest *alfrescoRequest = [[AlfrescoRequest alloc] init];
+    AlfrescoRequest *alfrescoRequest = [[AlfrescoRequest alloc] initWithService:self operation:_cmd];
     __weak typeof(self) weakSelf = self;
     
     NSString *requestString = [kAlfrescoLegacySitesShortnameAPI stringByReplacingOccurrencesOfString:kAlfrescoSiteId withString:shortName];
@@ -1269,7 +1292,7 @@
                                                                                              withString:site.identifier];
     NSURL *url = [AlfrescoURLUtils buildURLFromBaseURLString:self.baseApiUrl extensionURL:requestString];
     NSData *jsonData = [self jsonDataForJoiningPublicSite:self.session.personIdentifier];
-    AlfrescoRequest *request = [[AlfrescoRequest alloc] init];
+    AlfrescoRequest *request = [[AlfrescoRequest alloc] initWithService:self operation:_cmd];
     __weak typeof(self) weakSelf = self;
     [self.session.networkProvider executeRequestWithURL:url session:self.session requestBody:jsonData method:kAlfrescoHTTPPost alfrescoRequest:request completionBlock:^(NSData *data, NSError *error){
         if (nil == data)
@@ -1298,7 +1321,7 @@
                                                                                                 withString:site.identifier];
     NSURL *url = [AlfrescoURLUtils buildURLFromBaseURLString:self.baseApiUrl extensionURL:requestString];
     NSData *jsonData = [self jsonDataForJoiningModeratedSite:self.session.personIdentifier comment:nil];
-    AlfrescoRequest *request = [[AlfrescoRequest alloc] init];
+    AlfrescoRequest *request = [[AlfrescoRequest alloc] initWithService:self operation:_cmd];
     __weak typeof(self) weakSelf = self;
     [self.session.networkProvider executeRequestWithURL:url session:self.session requestBody:jsonData method:kAlfrescoHTTPPost alfrescoRequest:request completionBlock:^(NSData *data, NSError *error){
         if (nil == data)
@@ -56,7 +56,7 @@
 {
     [AlfrescoErrors assertArgumentNotNil:completionBlock argumentName:@"completionBlock"];
     NSURL *url = [AlfrescoURLUtils buildURLFromBaseURLString:self.baseApiUrl extensionURL:kAlfrescoLegacyTagsAPI];
-    AlfrescoRequest *request = [[AlfrescoRequest alloc] init];
+    AlfrescoRequest *request = [[AlfrescoRequest alloc] initWithService:self operation:_cmd];
     [self.session.networkProvider executeRequestWithURL:url
                                                 session:self.session
                                         alfrescoRequest:request
@@ -85,7 +85,16 @@
     }
     
     NSURL *url = [AlfrescoURLUtils buildURLFromBaseURLString:self.baseApiUrl extensionURL:kAlfrescoLegacyTagsAPI];
-    AlfrescoRequest *request = [[AlfrescoRequest alloc] init];
+    
+    // the tags API only pages its detailed format, so the following pages are taken from the tags fetched for the first one
+    AlfrescoPagingResult *cachedResult = [AlfrescoPagingUtils pagedResultFromCachedListing:url.absoluteString listingContext:listingContext session:self.session];
+    if (nil != cachedResult)
+    {
+        completionBlock(cachedResult, nil);
+        return nil;
+    }
+    
+    AlfrescoRequest *request = [[AlfrescoRequest alloc] initWithService:self operation:_cmd];
     [self.session.networkProvider executeRequestWithURL:url
                                                 session:self.session
                                         alfrescoRequest:request
@@ -98,7 +107,8 @@
         {
             NSError *conversionError = nil;
             NSArray *tagArray = [self tagArrayFromJSONData:data error:&conversionError];
-            AlfrescoPagingResult *pagingResults = [AlfrescoPagingUtils pagedResultFromArray:tagArray listingContext:listingContext];
+            AlfrescoPagingResult *pagingResults = [AlfrescoPagingUtils pagedResultFromArray:tagArray listingContext:listingContext
+                                                                             cachingListing:url.absoluteString session:self.session];
             completionBlock(pagingResults, conversionError);
         }
     }];
@@ -117,7 +127,7 @@
     NSString *requestString = [kAlfrescoLegacyTagsForNodeAPI stringByReplacingOccurrencesOfString:kAlfrescoNodeRef
                                                                                           withString:cleanNodeId];
     NSURL *url = [AlfrescoURLUtils buildURLFromBaseURLString:self.baseApiUrl extensionURL:requestString];
-    AlfrescoRequest *request = [[AlfrescoRequest alloc] init];
+    AlfrescoRequest *request = [[AlfrescoRequest alloc] initWithService:self operation:_cmd];
     [self.session.networkProvider executeRequestWithURL:url
                                                 session:self.session
                                         alfrescoRequest:request
@@ -153,7 +163,16 @@
     NSString *requestString = [kAlfrescoLegacyTagsForNodeAPI stringByReplacingOccurrencesOfString:kAlfrescoNodeRef
                                                                                           withString:cleanNodeId];
     NSURL *url = [AlfrescoURLUtils buildURLFromBaseURLString:self.baseApiUrl extensionURL:requestString];
-    AlfrescoRequest *request = [[AlfrescoRequest alloc] init];
+    
+    // following pages are taken from the tags fetched for the first one
+    AlfrescoPagingResult *cachedResult = [AlfrescoPagingUtils pagedResultFromCachedListing:url.absoluteString listingContext:listingContext session:self.session];
+    if (nil != cachedResult)
+    {
+        completionBlock(cachedResult, nil);
+        return nil;
+    }
+    
+    AlfrescoRequest *request = [[AlfrescoRequest alloc] initWithService:self operation:_cmd];
     [self.session.networkProvider executeRequestWithURL:url
                                                 session:self.session
                                         alfrescoRequest:request
@@ -166,7 +185,8 @@
         {
             NSError *conversionError = nil;
             NSArray *tagArray = [self tagArrayFromJSONData:data error:&conversionError];
-            AlfrescoPagingResult *pagingResult = [AlfrescoPagingUtils pagedResultFromArray:tagArray listingContext:listingContext];
+            AlfrescoPagingResult *pagingResult = [AlfrescoPagingUtils pagedResultFromArray:tagArray listingContext:listingContext
+                                                                            cachingListing:url.absoluteString session:self.session];
             completionBlock(pagingResult, conversionError);
         }
     }];
@@ -190,7 +210,7 @@
     NSData *jsonData = [NSJSONSerialization dataWithJSONObject:tags options:0 error:&jsonError];
     NSURL *url = [AlfrescoURLUtils buildURLFromBaseURLString:self.baseApiUrl extensionURL:requestString];
     
-    AlfrescoRequest *request = [[AlfrescoRequest alloc] init];
+    AlfrescoRequest *request = [[AlfrescoRequest alloc] initWithService:self operation:_cmd];
     [self.session.networkProvider executeRequestWithURL:url
                                                 session:self.session
                                             requestBody:jsonData
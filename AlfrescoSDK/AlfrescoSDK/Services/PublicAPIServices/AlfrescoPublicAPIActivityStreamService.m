@@ -131,7 +131,7 @@
         requestString = [kAlfrescoPublicAPIActivities stringByReplacingOccurrencesOfString:kAlfrescoPersonId withString:self.session.personIdentifier];
     }
     NSURL *url = [AlfrescoURLUtils buildURLFromBaseURLString:self.baseApiUrl extensionURL:requestString listingContext:listingContext];
-    AlfrescoRequest *alfrescoRequest = [[AlfrescoRequest alloc] init];
+    AlfrescoRequest *alfrescoRequest = [[AlfrescoRequest alloc] initWithService:self operation:_cmd];
     [self.session.networkProvider executeRequestWithURL:url session:self.session alfrescoRequest:alfrescoRequest completionBlock:^(NSData *responseData, NSError *error){
         if (nil == responseData)
         {
@@ -147,10 +147,11 @@
         else
         {
             NSError *conversionError = nil;
-            NSArray *activityStreamArray = [self activityStreamArrayFromJSONData:responseData error:&conversionError];
+            AlfrescoListResponse *listResponse = [[AlfrescoListResponse alloc] initWithData:responseData];
+            NSArray *activityStreamArray = [self activityStreamArrayFromListResponse:listResponse error:&conversionError];
             if (usePaging)
             {
-                NSDictionary *pagingInfo = [AlfrescoObjectConverter paginationJSONFromData:responseData error:&conversionError];
+                NSDictionary *pagingInfo = [AlfrescoObjectConverter paginationJSONFromListResponse:listResponse error:&conversionError];
                 AlfrescoPagingResult *pagingResult = nil;
                 if (activityStreamArray && pagingInfo)
                 {
@@ -167,7 +168,6 @@
             }
             else
             {
-                NSArray *activityStreamArray = [self activityStreamArrayFromJSONData:responseData error:&conversionError];
                 NSArray *filteredActivityStream = [self activityArrayByApplyingFilter:listingContext.listingFilter activities:activityStreamArray];
                 arrayCompletionBlock(filteredActivityStream, conversionError);
             }
@@ -178,9 +178,9 @@
     return alfrescoRequest;
 }
 
-- (NSArray *) activityStreamArrayFromJSONData:(NSData *)data error:(NSError **)outError
+- (NSArray *) activityStreamArrayFromListResponse:(AlfrescoListResponse *)listResponse error:(NSError **)outError
 {
-    NSArray *entriesArray = [AlfrescoObjectConverter arrayJSONEntriesFromListData:data error:outError];
+    NSArray *entriesArray = [AlfrescoObjectConverter arrayJSONEntriesFromListResponse:listResponse error:outError];
     if (nil == entriesArray)
     {
         if (nil == *outError)
@@ -107,7 +107,7 @@
     NSString *requestString = [kAlfrescoPublicAPIComments stringByReplacingOccurrencesOfString:kAlfrescoNodeRef
                                                                                    withString:[node.identifier stringByReplacingOccurrencesOfString:@"://" withString:@"/"]];
     NSURL *url = [AlfrescoURLUtils buildURLFromBaseURLString:self.baseApiUrl extensionURL:requestString];
-    AlfrescoRequest *alfrescoRequest = [[AlfrescoRequest alloc] init];
+    AlfrescoRequest *alfrescoRequest = [[AlfrescoRequest alloc] initWithService:self operation:_cmd];
     [self.session.networkProvider executeRequestWithURL:url
                                                 session:self.session
                                             requestBody:jsonData
@@ -148,7 +148,7 @@
     NSString *requestString = [nodeRefString stringByReplacingOccurrencesOfString:kAlfrescoCommentId
                                                                        withString:[comment.identifier stringByReplacingOccurrencesOfString:@"://" withString:@"/"]];
     NSURL *url = [AlfrescoURLUtils buildURLFromBaseURLString:self.baseApiUrl extensionURL:requestString];
-    AlfrescoRequest *alfrescoRequest = [[AlfrescoRequest alloc] init];
+    AlfrescoRequest *alfrescoRequest = [[AlfrescoRequest alloc] initWithService:self operation:_cmd];
     [self.session.networkProvider executeRequestWithURL:url
                                                 session:self.session
                                             requestBody:jsonData
@@ -185,7 +185,7 @@
     NSString *requestString = [nodeRefString stringByReplacingOccurrencesOfString:kAlfrescoCommentId
                                                                        withString:[comment.identifier stringByReplacingOccurrencesOfString:@"://" withString:@"/"]];
     NSURL *url = [AlfrescoURLUtils buildURLFromBaseURLString:self.baseApiUrl extensionURL:requestString];
-    AlfrescoRequest *alfrescoRequest = [[AlfrescoRequest alloc] init];
+    AlfrescoRequest *alfrescoRequest = [[AlfrescoRequest alloc] initWithService:self operation:_cmd];
     [self.session.networkProvider executeRequestWithURL:url
                                                 session:self.session
                                             requestBody:nil
@@ -211,7 +211,7 @@
     NSString *requestString = [kAlfrescoPublicAPIComments stringByReplacingOccurrencesOfString:kAlfrescoNodeRef
                                                                                    withString:[node.identifier stringByReplacingOccurrencesOfString:@"://" withString:@"/"]];
     NSURL *url = [AlfrescoURLUtils buildURLFromBaseURLString:self.baseApiUrl extensionURL:requestString listingContext:listingContext];
-    AlfrescoRequest *alfrescoRequest = [[AlfrescoRequest alloc] init];
+    AlfrescoRequest *alfrescoRequest = [[AlfrescoRequest alloc] initWithService:self operation:_cmd];
     [self.session.networkProvider executeRequestWithURL:url session:self.session alfrescoRequest:alfrescoRequest completionBlock:^(NSData *responseData, NSError *error){
         if (nil == responseData)
         {
@@ -227,10 +227,11 @@
         else
         {
             NSError *conversionError = nil;
-            NSArray *comments = [self commentArrayFromJSONData:responseData error:&conversionError];
+            AlfrescoListResponse *listResponse = [[AlfrescoListResponse alloc] initWithData:responseData];
+            NSArray *comments = [self commentArrayFromListResponse:listResponse error:&conversionError];
             if (usePaging)
             {
-                NSDictionary *pagingInfo = [AlfrescoObjectConverter paginationJSONFromData:responseData error:&conversionError];
+                NSDictionary *pagingInfo = [AlfrescoObjectConverter paginationJSONFromListResponse:listResponse error:&conversionError];
                 AlfrescoPagingResult *pagingResult = nil;
                 if (nil != comments && pagingInfo)
                 {
@@ -270,9 +271,9 @@
 }
 
 
-- (NSArray *) commentArrayFromJSONData:(NSData *)data error:(NSError *__autoreleasing *)outError
+- (NSArray *) commentArrayFromListResponse:(AlfrescoListResponse *)listResponse error:(NSError *__autoreleasing *)outError
 {
-    NSArray *entriesArray = [AlfrescoObjectConverter arrayJSONEntriesFromListData:data error:outError];
+    NSArray *entriesArray = [AlfrescoObjectConverter arrayJSONEntriesFromListResponse:listResponse error:outError];
     if (nil == entriesArray)
     {
         if (nil == *outError)
@@ -19,14 +19,17 @@
  */
 
 #import "AlfrescoPublicAPIDocumentFolderService.h"
+#import "AlfrescoSessionUtils.h"
 #import "AlfrescoErrors.h"
 #import "CMISOperationContext.h"
 #import "CMISPagedResult.h"
 #import "CMISQueryResult.h"
+#import "CMISQueryStatement.h"
 #import "CMISSession.h"
 #import "AlfrescoCMISUtil.h"
 #import "CMISDocument.h"
 #import "CMISRendition.h"
+#import "CMISConstants.h"
 #import "AlfrescoLog.h"
 #import "AlfrescoFileManager.h"
 #import "AlfrescoInternalConstants.h"
@@ -35,12 +38,14 @@
 #import "AlfrescoURLUtils.h"
 #import "AlfrescoObjectConverter.h"
 #import "AlfrescoPagingUtils.h"
+#import "AlfrescoCMISToAlfrescoObjectConverter.h"
 
-static const double kFavoritesRequestRateLimit = 0.1; // seconds between requests
+static const NSUInteger kFavoritesQueryBatchSize = 100; // identifiers per query, keeps the IN clause within the server's limits
 
 @interface AlfrescoPublicAPIDocumentFolderService ()
 @property (nonatomic, strong, readwrite) id<AlfrescoSession> session;
 @property (nonatomic, strong, readwrite) CMISSession *cmisSession;
+@property (nonatomic, strong, readwrite) AlfrescoCMISToAlfrescoObjectConverter *objectConverter;
 @property (nonatomic, strong, readwrite) AlfrescoFavoritesCache *favoritesCache;
 @property (nonatomic, strong, readwrite) NSString *defaultSortKey;
 @property (nonatomic, strong, readwrite) NSString *baseApiUrl;
@@ -55,18 +60,10 @@ static const double kFavoritesRequestRateLimit = 0.1; // seconds between request
         self.baseApiUrl = [[self.session.baseUrl absoluteString] stringByAppendingString:kAlfrescoPublicAPIPath];
         
         // setup favorites cache
-        id cachedObj = [self.session objectForParameter:kAlfrescoSessionCacheFavorites];
-        if (cachedObj)
-        {
-            AlfrescoLogTrace(@"Found an existing FavoritesCache in session");
-            self.favoritesCache = (AlfrescoFavoritesCache *)cachedObj;
-        }
-        else
-        {
-            self.favoritesCache = [AlfrescoFavoritesCache new];
-            [self.session setObject:self.favoritesCache forParameter:kAlfrescoSessionCacheFavorites];
+        self.favoritesCache = [AlfrescoSessionUtils objectForParameter:kAlfrescoSessionCacheFavorites ofSession:self.session createIfAbsentWithBlock:^id{
             AlfrescoLogDebug(@"Created new FavoritesCache object");
-        }
+            return [AlfrescoFavoritesCache new];
+        }];
     }
     return self;
 }
@@ -79,70 +76,31 @@ static const double kFavoritesRequestRateLimit = 0.1; // seconds between request
     [AlfrescoErrors assertArgumentNotNil:renditionName argumentName:@"renditionName"];
     [AlfrescoErrors assertArgumentNotNil:completionBlock argumentName:@"completionBlock"];
     
-    AlfrescoRequest *request = [[AlfrescoRequest alloc] init];
-    CMISOperationContext *operationContext = [CMISOperationContext defaultOperationContext];
-    operationContext.renditionFilterString = @"*";
-    request.httpRequest = [self.cmisSession retrieveObject:node.identifier operationContext:operationContext completionBlock:^(CMISObject *cmisObject, NSError *error) {
-        if (nil == cmisObject)
-        {
-            NSError *alfrescoError = [AlfrescoCMISUtil alfrescoErrorWithCMISError:error];
-            completionBlock(nil, alfrescoError);
-        }
-        else if([cmisObject isKindOfClass:[CMISFolder class]])
-        {
-            NSError *wrongTypeError = [AlfrescoErrors alfrescoErrorWithAlfrescoErrorCode:kAlfrescoErrorCodeDocumentFolderNoThumbnail];
-            completionBlock(nil, wrongTypeError);
-        }
-        else
+    // download to a file of our own and only move it into place once complete, so a failed or
+    // concurrent download of the same rendition never leaves a partial file behind
+    AlfrescoFileManager *fileManager = [AlfrescoFileManager sharedManager];
+    NSString *mimeType = [self mimeTypeForRenditionName:renditionName];
+    NSString *filePath = [self renditionFilePathForNode:node renditionName:renditionName mimeType:mimeType];
+    NSString *downloadFilePath = [filePath stringByAppendingFormat:@".%@.part", [[NSUUID UUID] UUIDString]];
+    NSOutputStream *outputStream = [fileManager outputStreamToFileAtPath:downloadFilePath append:NO];
+    
+    AlfrescoRequest *request = [[AlfrescoRequest alloc] initWithService:self operation:_cmd];
+    [self retrieveRenditionOfNode:node renditionName:renditionName outputStream:outputStream alfrescoRequest:request completionBlock:^(BOOL succeeded, NSError *error) {
+        if (succeeded)
         {
-            NSError *renditionsError = nil;
-            CMISDocument *document = (CMISDocument *)cmisObject;
-            NSArray *renditions = document.renditions;
-            if (!renditions || renditions.count == 0)
+            NSError *fileError = nil;
+            [fileManager removeItemAtPath:filePath error:nil];
+            if ([fileManager moveItemAtPath:downloadFilePath toPath:filePath error:&fileError])
             {
-                renditionsError = [AlfrescoErrors alfrescoErrorWithAlfrescoErrorCode:kAlfrescoErrorCodeDocumentFolderNoThumbnail];
-                completionBlock(nil, renditionsError);
-            }
-            else
-            {
-                CMISRendition *thumbnailRendition = nil;
-                for (CMISRendition *rendition in renditions)
-                {
-                    if ([rendition.title isEqualToString:renditionName])
-                    {
-                        thumbnailRendition = rendition;
-                        break;
-                    }
-                }
-                
-                if (!thumbnailRendition)
-                {
-                    // Couldn't find the requested renditionName
-                    renditionsError = [AlfrescoErrors alfrescoErrorWithAlfrescoErrorCode:kAlfrescoErrorCodeDocumentFolderNoThumbnail];
-                    completionBlock(nil, renditionsError);
-                }
-                else
-                {
-                    AlfrescoLogDebug(@"Found %d renditions, thumbnail documentId is %@", renditions.count, thumbnailRendition.renditionDocumentId);
-                    NSString *tmpFileExtension = [thumbnailRendition.mimeType isEqualToString:@"image/png"] ? @"png" : @"jpg";
-                    NSString *tmpFileName = [[[AlfrescoFileManager sharedManager] temporaryDirectory] stringByAppendingFormat:@"%@.%@", node.name, tmpFileExtension];
-                    request.httpRequest = [thumbnailRendition downloadRenditionContentToFile:tmpFileName completionBlock:^(NSError *downloadError) {
-                        if (downloadError)
-                        {
-                            NSError *alfrescoError = [AlfrescoCMISUtil alfrescoErrorWithCMISError:downloadError];
-                            completionBlock(nil, alfrescoError);
-                        }
-                        else
-                        {
-                            AlfrescoContentFile *contentFile = [[AlfrescoContentFile alloc] initWithUrl:[NSURL fileURLWithPath:tmpFileName] mimeType:@"image/png"];
-                            completionBlock(contentFile, nil);
-                        }
-                    } progressBlock:^(unsigned long long bytesDownloaded, unsigned long long bytesTotal) {
-                        AlfrescoLogTrace(@"Download progress, transferred %llu bytes of %llu", bytesDownloaded, bytesTotal);
-                    }];
-                }
+                AlfrescoContentFile *contentFile = [[AlfrescoContentFile alloc] initWithUrl:[NSURL fileURLWithPath:filePath] mimeType:mimeType];
+                completionBlock(contentFile, nil);
+                return;
             }
+            error = [AlfrescoErrors alfrescoErrorWithUnderlyingError:fileError andAlfrescoErrorCode:kAlfrescoErrorCodeDocumentFolder];
         }
+        
+        [fileManager removeItemAtPath:downloadFilePath error:nil];
+        completionBlock(nil, error);
     }];
     return request;
 }
@@ -157,68 +115,8 @@ static const double kFavoritesRequestRateLimit = 0.1; // seconds between request
     [AlfrescoErrors assertArgumentNotNil:outputStream argumentName:@"outputStream"];
     [AlfrescoErrors assertArgumentNotNil:completionBlock argumentName:@"completionBlock"];
     
-    AlfrescoRequest *request = [[AlfrescoRequest alloc] init];
-    CMISOperationContext *operationContext = [CMISOperationContext defaultOperationContext];
-    operationContext.renditionFilterString = @"*";
-    request.httpRequest = [self.cmisSession retrieveObject:node.identifier operationContext:operationContext completionBlock:^(CMISObject *cmisObject, NSError *error) {
-        if (nil == cmisObject)
-        {
-            NSError *alfrescoError = [AlfrescoCMISUtil alfrescoErrorWithCMISError:error];
-            completionBlock(NO, alfrescoError);
-        }
-        else if([cmisObject isKindOfClass:[CMISFolder class]])
-        {
-            NSError *wrongTypeError = [AlfrescoErrors alfrescoErrorWithAlfrescoErrorCode:kAlfrescoErrorCodeDocumentFolderNoThumbnail];
-            completionBlock(NO, wrongTypeError);
-        }
-        else
-        {
-            NSError *renditionsError = nil;
-            CMISDocument *document = (CMISDocument *)cmisObject;
-            NSArray *renditions = document.renditions;
-            if (!renditions || renditions.count == 0)
-            {
-                renditionsError = [AlfrescoErrors alfrescoErrorWithAlfrescoErrorCode:kAlfrescoErrorCodeDocumentFolderNoThumbnail];
-                completionBlock(NO, renditionsError);
-            }
-            else
-            {
-                CMISRendition *thumbnailRendition = nil;
-                for (CMISRendition *rendition in renditions)
-                {
-                    if ([rendition.title isEqualToString:renditionName])
-                    {
-                        thumbnailRendition = rendition;
-                        break;
-                    }
-                }
-                
-                if (!thumbnailRendition)
-                {
-                    // Couldn't find the requested renditionName
-                    renditionsError = [AlfrescoErrors alfrescoErrorWithAlfrescoErrorCode:kAlfrescoErrorCodeDocumentFolderNoThumbnail];
-                    completionBlock(NO, renditionsError);
-                }
-                else
-                {
-                    AlfrescoLogDebug(@"Found %d renditions, thumbnail documentId is %@", renditions.count, thumbnailRendition.renditionDocumentId);
-                    request.httpRequest = [thumbnailRendition downloadRenditionContentToOutputStream:outputStream completionBlock:^(NSError *downloadError) {
-                        if (downloadError)
-                        {
-                            NSError *alfrescoError = [AlfrescoCMISUtil alfrescoErrorWithCMISError:downloadError];
-                            completionBlock(NO, alfrescoError);
-                        }
-                        else
-                        {
-                            completionBlock(YES, nil);
-                        }
-                    } progressBlock:^(unsigned long long bytesDownloaded, unsigned long long bytesTotal) {
-                        AlfrescoLogTrace(@"Download progress, transferred %llu bytes of %llu", bytesDownloaded, bytesTotal);
-                    }];
-                }
-            }
-        }
-    }];
+    AlfrescoRequest *request = [[AlfrescoRequest alloc] initWithService:self operation:_cmd];
+    [self retrieveRenditionOfNode:node renditionName:renditionName outputStream:outputStream alfrescoRequest:request completionBlock:completionBlock];
     return request;
 }
 
@@ -429,7 +327,7 @@ static const double kFavoritesRequestRateLimit = 0.1; // seconds between request
     
     NSURL *url = [AlfrescoURLUtils buildURLFromBaseURLString:self.baseApiUrl extensionURL:kAlfrescoPublicAPIAddFavorite listingContext:nil];
     NSData *bodyData = [self jsonDataForAddingFavorite:node];
-    AlfrescoRequest *request = [[AlfrescoRequest alloc] init];
+    AlfrescoRequest *request = [[AlfrescoRequest alloc] initWithService:self operation:_cmd];
     
     [self.session.networkProvider executeRequestWithURL:url
                                                 session:self.session
@@ -461,7 +359,7 @@ static const double kFavoritesRequestRateLimit = 0.1; // seconds between request
     requestString = [requestString stringByReplacingOccurrencesOfString:kAlfrescoNodeRef withString:nodeIdWithoutVersionNumber];
     
     NSURL *url = [AlfrescoURLUtils buildURLFromBaseURLString:self.baseApiUrl extensionURL:requestString listingContext:nil];
-    AlfrescoRequest *request = [[AlfrescoRequest alloc] init];
+    AlfrescoRequest *request = [[AlfrescoRequest alloc] initWithService:self operation:_cmd];
     
     [self.session.networkProvider executeRequestWithURL:url
                                                 session:self.session
@@ -498,7 +396,7 @@ static const double kFavoritesRequestRateLimit = 0.1; // seconds between request
     // Construct the URL
     NSString *queryStatement = [NSString stringWithFormat:@"SELECT cm:homeFolder FROM cm:person WHERE cm:userName = '%@'", self.session.personIdentifier];
     
-    __block AlfrescoRequest *alfrescoRequest = [[AlfrescoRequest alloc] init];
+    __block AlfrescoRequest *alfrescoRequest = [[AlfrescoRequest alloc] initWithService:self operation:_cmd];
     
     CMISOperationContext *operationContext = [CMISOperationContext defaultOperationContext];
     operationContext.includeAllowableActions = NO;
@@ -542,7 +440,7 @@ static const double kFavoritesRequestRateLimit = 0.1; // seconds between request
     NSString *requestString = [kAlfrescoPublicAPIFavoritesAll stringByReplacingOccurrencesOfString:kAlfrescoPersonId withString:self.session.personIdentifier];
     NSURL *url = [AlfrescoURLUtils buildURLFromBaseURLString:self.baseApiUrl extensionURL:requestString];
     
-    AlfrescoRequest *request = [[AlfrescoRequest alloc] init];
+    AlfrescoRequest *request = [[AlfrescoRequest alloc] initWithService:self operation:_cmd];
     [self.session.networkProvider executeRequestWithURL:url session:self.session alfrescoRequest:request completionBlock:^(NSData *data, NSError *error) {
         if (nil == data)
         {
@@ -550,8 +448,8 @@ static const double kFavoritesRequestRateLimit = 0.1; // seconds between request
         }
         else
         {
-            // retrieve complete node info for each favorite
-            [self favoritesArrayWithData:data completionBlock:completionBlock];
+            // retrieve complete node info for the favorites
+            [self favoritesArrayWithData:data alfrescoRequest:request completionBlock:completionBlock];
         }
     }];
     
@@ -574,40 +472,150 @@ static const double kFavoritesRequestRateLimit = 0.1; // seconds between request
 
 #pragma mark Internal private methods
 
-- (void)favoritesArrayWithData:(NSData *)data completionBlock:(AlfrescoArrayCompletionBlock)completionBlock
+- (void)favoritesArrayWithData:(NSData *)data
+               alfrescoRequest:(AlfrescoRequest *)alfrescoRequest
+               completionBlock:(AlfrescoArrayCompletionBlock)completionBlock
 {
     NSError *conversionError = nil;
     NSArray *entriesArray = [AlfrescoObjectConverter arrayJSONEntriesFromListData:data error:&conversionError];
-    NSMutableArray *resultsArray = [NSMutableArray arrayWithCapacity:entriesArray.count];
+    if (nil == entriesArray || entriesArray.count == 0)
+    {
+        completionBlock([NSMutableArray array], conversionError);
+        return;
+    }
     
-    if (nil != entriesArray && entriesArray.count > 0)
+    // split the favorites by type so each can be resolved with a query against the matching base type
+    NSMutableArray *documentIdentifiers = [NSMutableArray array];
+    NSMutableArray *folderIdentifiers = [NSMutableArray array];
+    NSMutableDictionary *unresolvedIdentifiers = [NSMutableDictionary dictionary];
+    NSString *targetKeyPath = [[NSString alloc] initWithFormat:@"%@.%@", kAlfrescoPublicAPIJSONEntry, kAlfrescoJSONTarget];
+    for (NSDictionary *entry in entriesArray)
     {
-        NSArray *identifiers = [entriesArray valueForKeyPath:@"entry.targetGuid"];
-        __block NSInteger total = identifiers.count;
-        int delay = 0;
+        NSString *identifier = [entry valueForKeyPath:@"entry.targetGuid"];
+        if (nil == identifier)
+        {
+            continue;
+        }
         
-        for (NSString *identifier in identifiers)
+        NSDictionary *targetDictionary = [entry valueForKeyPath:targetKeyPath];
+        if (nil != targetDictionary[kAlfrescoJSONFolder])
         {
-            // Rate-limit the requests
-            dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(delay++ * kFavoritesRequestRateLimit * NSEC_PER_SEC)), dispatch_get_main_queue(), ^{
-                [self retrieveNodeWithIdentifier:identifier completionBlock:^(AlfrescoNode *node, NSError *error) {
-                    if (!error)
-                    {
-                        [resultsArray addObject:node];
-                    }
-
-                    if (--total == 0)
-                    {
-                        completionBlock(resultsArray, nil);
-                    }
-                }];
-            });
+            [folderIdentifiers addObject:identifier];
         }
+        else
+        {
+            [documentIdentifiers addObject:identifier];
+        }
+        unresolvedIdentifiers[[self favoriteKeyForIdentifier:identifier]] = identifier;
     }
-    else
+    
+    NSMutableArray *batches = [NSMutableArray array];
+    [batches addObjectsFromArray:[self favoriteBatchesForIdentifiers:documentIdentifiers typeName:kCMISPropertyObjectTypeIdValueDocument]];
+    [batches addObjectsFromArray:[self favoriteBatchesForIdentifiers:folderIdentifiers typeName:kCMISPropertyObjectTypeIdValueFolder]];
+    
+    [self resolveFavoriteBatches:batches
+                      batchIndex:0
+           unresolvedIdentifiers:unresolvedIdentifiers
+                    resultsArray:[NSMutableArray arrayWithCapacity:unresolvedIdentifiers.count]
+                      itemErrors:[NSMutableDictionary dictionary]
+                 alfrescoRequest:alfrescoRequest
+                 completionBlock:completionBlock];
+}
+
+- (NSArray *)favoriteBatchesForIdentifiers:(NSArray *)identifiers typeName:(NSString *)typeName
+{
+    NSMutableArray *batches = [NSMutableArray array];
+    for (NSUInteger location = 0; location < identifiers.count; location += kFavoritesQueryBatchSize)
+    {
+        NSUInteger length = MIN(kFavoritesQueryBatchSize, identifiers.count - location);
+        [batches addObject:@{@"typeName": typeName, @"identifiers": [identifiers subarrayWithRange:NSMakeRange(location, length)]}];
+    }
+    return batches;
+}
+
+- (void)resolveFavoriteBatches:(NSArray *)batches
+                    batchIndex:(NSUInteger)batchIndex
+         unresolvedIdentifiers:(NSMutableDictionary *)unresolvedIdentifiers
+                  resultsArray:(NSMutableArray *)resultsArray
+                    itemErrors:(NSMutableDictionary *)itemErrors
+               alfrescoRequest:(AlfrescoRequest *)alfrescoRequest
+               completionBlock:(AlfrescoArrayCompletionBlock)completionBlock
+{
+    if (batchIndex == batches.count)
     {
-        completionBlock(resultsArray, conversionError);
+        // anything the queries didn't return has been deleted or is no longer accessible
+        for (NSString *identifier in unresolvedIdentifiers.allValues)
+        {
+            itemErrors[identifier] = [AlfrescoErrors alfrescoErrorWithAlfrescoErrorCode:kAlfrescoErrorCodeRequestedNodeNotFound];
+        }
+        
+        NSError *error = nil;
+        if (itemErrors.count > 0)
+        {
+            AlfrescoLogWarning(@"Failed to resolve %lu of %lu favorites", (unsigned long)itemErrors.count, (unsigned long)(itemErrors.count + resultsArray.count));
+            NSError *documentFolderError = [AlfrescoErrors alfrescoErrorWithAlfrescoErrorCode:kAlfrescoErrorCodeDocumentFolder];
+            NSMutableDictionary *userInfo = [NSMutableDictionary dictionaryWithDictionary:documentFolderError.userInfo];
+            userInfo[kAlfrescoErrorKeyItemErrors] = itemErrors;
+            error = [NSError errorWithDomain:kAlfrescoErrorDomainName code:kAlfrescoErrorCodeDocumentFolder userInfo:userInfo];
+        }
+        completionBlock(resultsArray, error);
+        return;
     }
+    
+    NSDictionary *batch = batches[batchIndex];
+    NSArray *identifiers = batch[@"identifiers"];
+    CMISQueryStatement *statement = [[CMISQueryStatement alloc] initWithStatement:@"SELECT * FROM ? WHERE cmis:objectId IN (?)"];
+    [statement setTypeAtIndex:1 type:batch[@"typeName"]];
+    [statement setStringArrayAtIndex:2 stringArray:identifiers];
+    NSString *queryStatement = [statement queryString];
+    
+    CMISOperationContext *operationContext = [CMISOperationContext defaultOperationContext];
+    operationContext.maxItemsPerPage = (int)identifiers.count;
+    alfrescoRequest.httpRequest = [self.cmisSession query:queryStatement searchAllVersions:NO operationContext:operationContext completionBlock:^(CMISPagedResult *pagedResult, NSError *error) {
+        if (nil == pagedResult)
+        {
+            NSError *alfrescoError = [AlfrescoCMISUtil alfrescoErrorWithCMISError:error];
+            if (alfrescoRequest.isCancelled)
+            {
+                completionBlock(nil, alfrescoError);
+                return;
+            }
+            
+            // the items in a failed batch are reported individually, the remaining batches are still resolved
+            for (NSString *identifier in identifiers)
+            {
+                itemErrors[identifier] = alfrescoError;
+                [unresolvedIdentifiers removeObjectForKey:[self favoriteKeyForIdentifier:identifier]];
+            }
+        }
+        else
+        {
+            for (CMISQueryResult *queryResult in pagedResult.resultArray)
+            {
+                AlfrescoNode *node = [self.objectConverter nodeFromCMISQueryResult:queryResult];
+                NSString *key = [self favoriteKeyForIdentifier:node.identifier];
+                if (nil != node && nil != unresolvedIdentifiers[key])
+                {
+                    [resultsArray addObject:node];
+                    [unresolvedIdentifiers removeObjectForKey:key];
+                }
+            }
+        }
+        
+        [self resolveFavoriteBatches:batches
+                          batchIndex:batchIndex + 1
+               unresolvedIdentifiers:unresolvedIdentifiers
+                        resultsArray:resultsArray
+                          itemErrors:itemErrors
+                     alfrescoRequest:alfrescoRequest
+                     completionBlock:completionBlock];
+    }];
+}
+
+- (NSString *)favoriteKeyForIdentifier:(NSString *)identifier
+{
+    // favorites reference nodes by GUID whereas query results may return a versioned node reference
+    return [[AlfrescoObjectConverter nodeRefWithoutVersionID:identifier] lastPathComponent];
 }
 
 - (NSData *)jsonDataForAddingFavorite:(AlfrescoNode *)node
@@ -626,7 +634,7 @@ static const double kFavoritesRequestRateLimit = 0.1; // seconds between request
     requestString = [requestString stringByReplacingOccurrencesOfString:kAlfrescoNodeRef withString:node.identifier];
     NSURL *url = [AlfrescoURLUtils buildURLFromBaseURLString:self.baseApiUrl extensionURL:requestString listingContext:nil];
     
-    AlfrescoRequest *request = [[AlfrescoRequest alloc] init];
+    AlfrescoRequest *request = [[AlfrescoRequest alloc] initWithService:self operation:_cmd];
     
     [self.session.networkProvider executeRequestWithURL:url session:self.session alfrescoRequest:request completionBlock:^(NSData *data, NSError *error) {
         if (error && error.code != kAlfrescoErrorCodeHTTPResponse)
@@ -677,4 +685,139 @@ static const double kFavoritesRequestRateLimit = 0.1; // seconds between request
     return request;
 }
 
+#pragma mark Rendition private methods
+
+- (void)retrieveRenditionOfNode:(AlfrescoNode *)node
+                  renditionName:(NSString *)renditionName
+                   outputStream:(NSOutputStream *)outputStream
+                alfrescoRequest:(AlfrescoRequest *)alfrescoRequest
+                completionBlock:(AlfrescoBOOLCompletionBlock)completionBlock
+{
+    if (![self doesSupportRenditionContentAPI])
+    {
+        [self retrieveCMISRenditionOfNode:node renditionName:renditionName outputStream:outputStream alfrescoRequest:alfrescoRequest completionBlock:completionBlock];
+        return;
+    }
+    
+    // the rendition content is requested directly, a missing rendition is reported as 404 rather than a placeholder image
+    NSString *nodeGUID = [[AlfrescoObjectConverter nodeRefWithoutVersionID:node.identifier] lastPathComponent];
+    NSString *requestString = [kAlfrescoPublicAPINodeRenditionContent stringByReplacingOccurrencesOfString:kAlfrescoNodeRef withString:nodeGUID];
+    requestString = [requestString stringByReplacingOccurrencesOfString:kAlfrescoRenditionId withString:renditionName];
+    NSURL *url = [AlfrescoURLUtils buildURLFromBaseURLString:self.baseApiUrl extensionURL:requestString];
+    
+    [self.session.networkProvider executeRequestWithURL:url session:self.session alfrescoRequest:alfrescoRequest outputStream:outputStream completionBlock:^(NSData *data, NSError *error) {
+        if (error)
+        {
+            if (error.code == kAlfrescoErrorCodeHTTPResponse && [error.userInfo[kAlfrescoErrorKeyHTTPResponseCode] integerValue] == 404)
+            {
+                error = [AlfrescoErrors alfrescoErrorWithAlfrescoErrorCode:kAlfrescoErrorCodeDocumentFolderNoThumbnail];
+            }
+            completionBlock(NO, error);
+        }
+        else
+        {
+            completionBlock(YES, nil);
+        }
+    }];
+}
+
+- (void)retrieveCMISRenditionOfNode:(AlfrescoNode *)node
+                      renditionName:(NSString *)renditionName
+                       outputStream:(NSOutputStream *)outputStream
+                    alfrescoRequest:(AlfrescoRequest *)alfrescoRequest
+                    completionBlock:(AlfrescoBOOLCompletionBlock)completionBlock
+{
+    // only the renditions are needed to locate the stream, so leave out everything else the object carries
+    CMISOperationContext *operationContext = [CMISOperationContext defaultOperationContext];
+    operationContext.filterString = [NSString stringWithFormat:@"%@,%@,%@", kCMISPropertyObjectId, kCMISPropertyObjectTypeId, kCMISPropertyBaseTypeId];
+    operationContext.includeAllowableActions = NO;
+    operationContext.includeACLs = NO;
+    operationContext.includePolicies = NO;
+    operationContext.relationships = CMISIncludeRelationshipNone;
+    operationContext.renditionFilterString = @"*";
+    alfrescoRequest.httpRequest = [self.cmisSession retrieveObject:node.identifier operationContext:operationContext completionBlock:^(CMISObject *cmisObject, NSError *error) {
+        if (nil == cmisObject)
+        {
+            NSError *alfrescoError = [AlfrescoCMISUtil alfrescoErrorWithCMISError:error];
+            completionBlock(NO, alfrescoError);
+            return;
+        }
+        
+        CMISRendition *thumbnailRendition = nil;
+        if ([cmisObject isKindOfClass:[CMISDocument class]])
+        {
+            for (CMISRendition *rendition in ((CMISDocument *)cmisObject).renditions)
+            {
+                if ([rendition.title isEqualToString:renditionName])
+                {
+                    thumbnailRendition = rendition;
+                    break;
+                }
+            }
+        }
+        
+        if (!thumbnailRendition)
+        {
+            // folders have no renditions, documents may not have the requested one (yet)
+            NSError *renditionsError = [AlfrescoErrors alfrescoErrorWithAlfrescoErrorCode:kAlfrescoErrorCodeDocumentFolderNoThumbnail];
+            completionBlock(NO, renditionsError);
+            return;
+        }
+        
+        AlfrescoLogDebug(@"Found rendition %@, thumbnail documentId is %@", renditionName, thumbnailRendition.renditionDocumentId);
+        alfrescoRequest.httpRequest = [thumbnailRendition downloadRenditionContentToOutputStream:outputStream completionBlock:^(NSError *downloadError) {
+            if (downloadError)
+            {
+                NSError *alfrescoError = [AlfrescoCMISUtil alfrescoErrorWithCMISError:downloadError];
+                completionBlock(NO, alfrescoError);
+            }
+            else
+            {
+                completionBlock(YES, nil);
+            }
+        } progressBlock:^(unsigned long long bytesDownloaded, unsigned long long bytesTotal) {
+            AlfrescoLogTrace(@"Download progress, transferred %llu bytes of %llu", bytesDownloaded, bytesTotal);
+        }];
+    }];
+}
+
+- (BOOL)doesSupportRenditionContentAPI
+{
+    // rendition content is part of the nodes API, available in Alfresco 5.2 and newer
+    AlfrescoRepositoryInfo *repositoryInfo = self.session.repositoryInfo;
+    if ([repositoryInfo.edition isEqualToString:kAlfrescoRepositoryEditionCloud])
+    {
+        return NO;
+    }
+    NSInteger majorVersion = repositoryInfo.majorVersion.integerValue;
+    NSInteger minorVersion = repositoryInfo.minorVersion.integerValue;
+    return (majorVersion > 5 || (majorVersion == 5 && minorVersion >= 2));
+}
+
+- (NSString *)mimeTypeForRenditionName:(NSString *)renditionName
+{
+    static NSDictionary *renditionMimeTypes = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        renditionMimeTypes = @{@"doclib": @"image/png",
+                               @"avatar": @"image/png",
+                               @"avatar32": @"image/png",
+                               @"imgpreview": @"image/jpeg",
+                               @"medium": @"image/jpeg",
+                               @"pdf": @"application/pdf"};
+    });
+    return renditionMimeTypes[renditionName] ?: @"image/png";
+}
+
+- (NSString *)renditionFilePathForNode:(AlfrescoNode *)node renditionName:(NSString *)renditionName mimeType:(NSString *)mimeType
+{
+    // named after the node, rendition and modification date so same-named nodes don't collide
+    // and an unchanged node maps to the same file every time
+    NSString *nodeGUID = [[AlfrescoObjectConverter nodeRefWithoutVersionID:node.identifier] lastPathComponent];
+    NSString *extension = [mimeType isEqualToString:@"image/jpeg"] ? @"jpg" : mimeType.lastPathComponent;
+    long long modifiedAt = (long long)[node.modifiedAt timeIntervalSince1970];
+    NSString *fileName = [NSString stringWithFormat:@"%@-%@-%lld.%@", nodeGUID, renditionName, modifiedAt, extension];
+    return [[[AlfrescoFileManager sharedManager] temporaryDirectory] stringByAppendingPathComponent:fileName];
+}
+
 @end
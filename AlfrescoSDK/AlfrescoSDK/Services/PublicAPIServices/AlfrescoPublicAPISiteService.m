@@ -17,6 +17,7 @@
  ******************************************************************************/
 
 #import "AlfrescoPublicAPISiteService.h"
+#import "AlfrescoSessionUtils.h"
 #import "AlfrescoLegacyAPISiteService.h"
 #import "AlfrescoInternalConstants.h"
 #import "AlfrescoAuthenticationProvider.h"
@@ -59,18 +60,12 @@
         self.defaultSortKey = kAlfrescoSortByTitle;
         self.supportedSortKeys = @[kAlfrescoSortByTitle, kAlfrescoSortByShortname];
 
-        id cachedObj = [self.session objectForParameter:kAlfrescoSessionCacheSites];
-        if (cachedObj)
-        {
-            AlfrescoLogTrace(@"Found an existing SiteCache in session");
-            self.siteCache = (AlfrescoSiteCache *)cachedObj;
-        }
-        else
-        {
-            self.siteCache = [AlfrescoSiteCache new];
-            [self.session setObject:self.siteCache forParameter:kAlfrescoSessionCacheSites];
+        self.siteCache = [AlfrescoSessionUtils objectForParameter:kAlfrescoSessionCacheSites ofSession:self.session createIfAbsentWithBlock:^id{
             AlfrescoLogDebug(@"Created new SiteCache object");
-        }
+            AlfrescoSiteCache *siteCache = [AlfrescoSiteCache new];
+            siteCache.completionQueue = [AlfrescoSessionUtils completionQueueForSession:session];
+            return siteCache;
+        }];
     }
     return self;
 }
@@ -308,7 +303,7 @@
     
     NSString *requestString = [kAlfrescoPublicAPISiteContainers stringByReplacingOccurrencesOfString:kAlfrescoSiteId withString:siteShortName];
     NSURL *url = [AlfrescoURLUtils buildURLFromBaseURLString:self.baseApiUrl extensionURL:requestString];
-    AlfrescoRequest *request = [[AlfrescoRequest alloc] init];
+    AlfrescoRequest *request = [[AlfrescoRequest alloc] initWithService:self operation:_cmd];
     __weak typeof(self) weakSelf = self;
     [self.session.networkProvider executeRequestWithURL:url
                                                 session:self.session
@@ -427,7 +422,7 @@
     [AlfrescoErrors assertArgumentNotNil:completionBlock argumentName:@"completionBlock"];
     NSURL *url = [AlfrescoURLUtils buildURLFromBaseURLString:self.baseApiUrl extensionURL:kAlfrescoPublicAPIAddFavoriteSite];
     NSData *jsonData = [self jsonDataForAddingFavoriteSite:site.GUID];
-    AlfrescoRequest *request = [[AlfrescoRequest alloc] init];
+    AlfrescoRequest *request = [[AlfrescoRequest alloc] initWithService:self operation:_cmd];
     __weak typeof(self) weakSelf = self;
     [self.session.networkProvider executeRequestWithURL:url
                                                 session:self.session
@@ -458,7 +453,7 @@
     NSString *requestString = [kAlfrescoPublicAPIRemoveFavoriteSite stringByReplacingOccurrencesOfString:kAlfrescoSiteGUID
                                                                                              withString:site.GUID];
     NSURL *url = [AlfrescoURLUtils buildURLFromBaseURLString:self.baseApiUrl extensionURL:requestString];
-    AlfrescoRequest *request = [[AlfrescoRequest alloc] init];
+    AlfrescoRequest *request = [[AlfrescoRequest alloc] initWithService:self operation:_cmd];
     __weak typeof(self) weakSelf = self;
     [self.session.networkProvider executeRequestWithURL:url
                                                 session:self.session
@@ -488,7 +483,7 @@
     [AlfrescoErrors assertArgumentNotNil:completionBlock argumentName:@"completionBlock"];
     NSURL *url = [AlfrescoURLUtils buildURLFromBaseURLString:self.baseApiUrl extensionURL:kAlfrescoPublicAPIJoinSite];
     NSData *jsonData = [self jsonDataForJoiningSite:site.identifier comment:@""];
-    AlfrescoRequest *request = [[AlfrescoRequest alloc] init];
+    AlfrescoRequest *request = [[AlfrescoRequest alloc] initWithService:self operation:_cmd];
     __weak typeof(self) weakSelf = self;
     [self.session.networkProvider executeRequestWithURL:url
                                                 session:self.session
@@ -539,7 +534,7 @@
     NSString *requestString = [kAlfrescoPublicAPICancelJoinRequests stringByReplacingOccurrencesOfString:kAlfrescoSiteId
                                                                                              withString:site.identifier];
     NSURL *url = [AlfrescoURLUtils buildURLFromBaseURLString:self.baseApiUrl extensionURL:requestString];
-    AlfrescoRequest *request = [[AlfrescoRequest alloc] init];
+    AlfrescoRequest *request = [[AlfrescoRequest alloc] initWithService:self operation:_cmd];
     __weak typeof(self) weakSelf = self;
     [self.session.networkProvider executeRequestWithURL:url
                                                 session:self.session
@@ -571,7 +566,7 @@
                                                                                     withString:site.identifier];
     requestString = [requestString stringByReplacingOccurrencesOfString:kAlfrescoPersonId withString:self.session.personIdentifier];
     NSURL *url = [AlfrescoURLUtils buildURLFromBaseURLString:self.baseApiUrl extensionURL:requestString];
-    AlfrescoRequest *request = [[AlfrescoRequest alloc] init];
+    AlfrescoRequest *request = [[AlfrescoRequest alloc] initWithService:self operation:_cmd];
     __weak typeof(self) weakSelf = self;
     [self.session.networkProvider executeRequestWithURL:url
                                                 session:self.session
@@ -619,7 +614,7 @@
                                                                                       withString:site.identifier];
     NSURL *url = [AlfrescoURLUtils buildURLFromBaseURLString:self.baseApiUrl extensionURL:requestString listingContext:listingContext];
     
-    AlfrescoRequest *request = [[AlfrescoRequest alloc] init];
+    AlfrescoRequest *request = [[AlfrescoRequest alloc] initWithService:self operation:_cmd];
     __weak typeof(self) weakSelf = self;
     [self.session.networkProvider executeRequestWithURL:url session:self.session alfrescoRequest:request completionBlock:^(NSData *data, NSError *error) {
         if (nil == data)
@@ -629,10 +624,11 @@
         else
         {
             NSError *conversionError = nil;
-            NSArray *members = [weakSelf membersArrayWithData:data error:&conversionError];
+            AlfrescoListResponse *listResponse = [[AlfrescoListResponse alloc] initWithData:data];
+            NSArray *members = [weakSelf membersArrayWithListResponse:listResponse error:&conversionError];
             if (conversionError == nil)
             {
-                NSDictionary *pagingInfo = [AlfrescoObjectConverter paginationJSONFromData:data error:&conversionError];
+                NSDictionary *pagingInfo = [AlfrescoObjectConverter paginationJSONFromListResponse:listResponse error:&conversionError];
                 AlfrescoPagingResult *pagingResult = nil;
                 if (members && pagingInfo)
                 {
@@ -670,7 +666,16 @@
     NSString *requestString = [kAlfrescoPublicAPISiteMembers stringByReplacingOccurrencesOfString:kAlfrescoSiteId withString:site.identifier];
     NSURL *url = [AlfrescoURLUtils buildURLFromBaseURLString:self.baseApiUrl extensionURL:requestString listingContext:nil];
     
-    AlfrescoRequest *request = [[AlfrescoRequest alloc] init];
+    // the following pages are taken from the members filtered for the first one
+    NSString *listing = [url.absoluteString stringByAppendingFormat:@"#%@", keywords];
+    AlfrescoPagingResult *cachedResult = [AlfrescoPagingUtils pagedResultFromCachedListing:listing listingContext:listingContext session:self.session];
+    if (nil != cachedResult)
+    {
+        completionBlock(cachedResult, nil);
+        return nil;
+    }
+    
+    AlfrescoRequest *request = [[AlfrescoRequest alloc] initWithService:self operation:_cmd];
     __weak typeof(self) weakSelf = self;
     [self.session.networkProvider executeRequestWithURL:url session:self.session alfrescoRequest:request completionBlock:^(NSData *data, NSError *error) {
         if (nil == data)
@@ -680,7 +685,7 @@
         else
         {
             NSError *conversionError = nil;
-            NSArray *members = [weakSelf membersArrayWithData:data error:&conversionError];
+            NSArray *members = [weakSelf membersArrayWithListResponse:[[AlfrescoListResponse alloc] initWithData:data] error:&conversionError];
             if (conversionError == nil)
             {
                 // do manual filtering of users until the Cloud supports it
@@ -688,7 +693,8 @@
                 NSArray *filteredMembers = [members filteredArrayUsingPredicate:predicate];
                 
                 // apply paging
-                AlfrescoPagingResult *pagingResult = [AlfrescoPagingUtils pagedResultFromArray:filteredMembers listingContext:listingContext];
+                AlfrescoPagingResult *pagingResult = [AlfrescoPagingUtils pagedResultFromArray:filteredMembers listingContext:listingContext
+                                                                                cachingListing:listing session:weakSelf.session];
                 completionBlock(pagingResult, error);
             }
             else
@@ -714,7 +720,7 @@
     requestString = [requestString stringByReplacingOccurrencesOfString:kAlfrescoPersonId withString:person.identifier];
     NSURL *url = [AlfrescoURLUtils buildURLFromBaseURLString:self.baseApiUrl extensionURL:requestString];
     
-    AlfrescoRequest *request = [[AlfrescoRequest alloc] init];
+    AlfrescoRequest *request = [[AlfrescoRequest alloc] initWithService:self operation:_cmd];
     [self.session.networkProvider executeRequestWithURL:url session:self.session requestBody:nil method:kAlfrescoHTTPGet alfrescoRequest:request completionBlock:^(NSData *data, NSError *error) {
         
         // if person is not member : the request returns error and data is nil so its difficult to differenciate if request failed or person is not member
@@ -900,9 +906,9 @@
     return [[AlfrescoSite alloc] initWithProperties:siteProperties];
 }
 
-- (NSArray *)membersArrayWithData:(NSData *)data error:(NSError **)outError
+- (NSArray *)membersArrayWithListResponse:(AlfrescoListResponse *)listResponse error:(NSError **)outError
 {
-    NSArray *entriesArray = [AlfrescoObjectConverter arrayJSONEntriesFromListData:data error:outError];
+    NSArray *entriesArray = [AlfrescoObjectConverter arrayJSONEntriesFromListResponse:listResponse error:outError];
     if (nil != entriesArray)
     {
         NSMutableArray *resultsArray = [NSMutableArray arrayWithCapacity:entriesArray.count];
@@ -1035,7 +1041,7 @@
 
 - (AlfrescoRequest *)retrieveMemberSiteDataWithCompletionBlock:(AlfrescoArrayCompletionBlock)completionBlock
 {
-    AlfrescoRequest *alfrescoRequest = [[AlfrescoRequest alloc] init];
+    AlfrescoRequest *alfrescoRequest = [[AlfrescoRequest alloc] initWithService:self operation:_cmd];
     __weak typeof(self) weakSelf = self;
     
     NSString *mySitesRequestString = [kAlfrescoPublicAPISiteForPerson stringByReplacingOccurrencesOfString:kAlfrescoPersonId
@@ -1060,7 +1066,7 @@
 
 - (AlfrescoRequest *)retrieveFavoriteSiteDataWithCompletionBlock:(AlfrescoArrayCompletionBlock)completionBlock
 {
-    AlfrescoRequest *alfrescoRequest = [[AlfrescoRequest alloc] init];
+    AlfrescoRequest *alfrescoRequest = [[AlfrescoRequest alloc] initWithService:self operation:_cmd];
     __weak typeof(self) weakSelf = self;
     
     NSString *favSitesRequestString = [kAlfrescoPublicAPIFavoriteSiteForPerson stringByReplacingOccurrencesOfString:kAlfrescoPersonId
@@ -1085,7 +1091,7 @@
 
 - (AlfrescoRequest *)retrievePendingSiteDataWithCompletionBlock:(AlfrescoArrayCompletionBlock)completionBlock
 {
-    AlfrescoRequest *alfrescoRequest = [[AlfrescoRequest alloc] init];
+    AlfrescoRequest *alfrescoRequest = [[AlfrescoRequest alloc] initWithService:self operation:_cmd];
     __weak typeof(self) weakSelf = self;
     
     NSString *pendingRequestString = kAlfrescoPublicAPIJoinSite;
@@ -1109,7 +1115,7 @@
 
 - (AlfrescoRequest *)retrieveDataForSiteWithShortName:(NSString *)shortName completionBlock:(AlfrescoSiteCompletionBlock)completionBlock
 {
-    AlfrescoRequest *alfrescoRequest = [[AlfrescoRequest alloc] init];
+    AlfrescoRequest *alfrescoRequest = [[AlfrescoRequest alloc] initWithService:self operation:_cmd];
     __weak typeof(self) weakSelf = self;
     
     NSString *requestString = [kAlfrescoPublicAPISiteForShortname stringByReplacingOccurrencesOfString:kAlfrescoSiteId withString:shortName];
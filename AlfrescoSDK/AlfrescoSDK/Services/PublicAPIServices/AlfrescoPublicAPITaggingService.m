@@ -73,7 +73,7 @@
 - (AlfrescoRequest *)retrieveAllTagsWithArrayCompletionBlock:(AlfrescoArrayCompletionBlock)arrayCompletionBlock pagingCompletionBlock:(AlfrescoPagingResultCompletionBlock)pagingCompletionBlock listingContext:(AlfrescoListingContext *)listingContext usePaging:(BOOL)usePaging
 {
     NSURL *url = [AlfrescoURLUtils buildURLFromBaseURLString:self.baseApiUrl extensionURL:kAlfrescoPublicAPITags listingContext:listingContext];
-    AlfrescoRequest *request = [[AlfrescoRequest alloc] init];
+    AlfrescoRequest *request = [[AlfrescoRequest alloc] initWithService:self operation:_cmd];
     [self.session.networkProvider executeRequestWithURL:url session:self.session alfrescoRequest:request completionBlock:^(NSData *data, NSError *error) {
         if (nil == data)
         {
@@ -89,10 +89,11 @@
         else
         {
             NSError *conversionError = nil;
-            NSArray *tagArray = [self tagArrayFromJSONData:data error:&conversionError];
+            AlfrescoListResponse *listResponse = [[AlfrescoListResponse alloc] initWithData:data];
+            NSArray *tagArray = [self tagArrayFromListResponse:listResponse error:&conversionError];
             if (usePaging)
             {
-                NSDictionary *pagingInfo = [AlfrescoObjectConverter paginationJSONFromData:data error:&conversionError];
+                NSDictionary *pagingInfo = [AlfrescoObjectConverter paginationJSONFromListResponse:listResponse error:&conversionError];
                 AlfrescoPagingResult *pagingResult = nil;
                 if (tagArray && pagingInfo)
                 {
@@ -123,7 +124,7 @@
     NSString *requestString = [kAlfrescoPublicAPITagsForNode stringByReplacingOccurrencesOfString:kAlfrescoNodeRef
                                                                                       withString:[node.identifier stringByReplacingOccurrencesOfString:@"://" withString:@"/"]];
     NSURL *url = [AlfrescoURLUtils buildURLFromBaseURLString:self.baseApiUrl extensionURL:requestString];
-    AlfrescoRequest *request = [[AlfrescoRequest alloc] init];
+    AlfrescoRequest *request = [[AlfrescoRequest alloc] initWithService:self operation:_cmd];
     [self.session.networkProvider executeRequestWithURL:url
                                                 session:self.session
                                         alfrescoRequest:request
@@ -135,7 +136,7 @@
         else
         {
             NSError *conversionError = nil;
-            NSArray *tagArray = [self tagArrayFromJSONData:data error:&conversionError];
+            NSArray *tagArray = [self tagArrayFromListResponse:[[AlfrescoListResponse alloc] initWithData:data] error:&conversionError];
             completionBlock(tagArray, conversionError);
         }
     }];
@@ -157,7 +158,7 @@
     NSString *requestString = [kAlfrescoPublicAPITagsForNode stringByReplacingOccurrencesOfString:kAlfrescoNodeRef
                                                                                       withString:[node.identifier stringByReplacingOccurrencesOfString:@"://" withString:@"/"]];
     NSURL *url = [AlfrescoURLUtils buildURLFromBaseURLString:self.baseApiUrl extensionURL:requestString listingContext:listingContext];
-    AlfrescoRequest *request = [[AlfrescoRequest alloc] init];
+    AlfrescoRequest *request = [[AlfrescoRequest alloc] initWithService:self operation:_cmd];
     [self.session.networkProvider executeRequestWithURL:url
                                                 session:self.session
                                         alfrescoRequest:request
@@ -169,8 +170,9 @@
         else
         {
             NSError *conversionError = nil;
-            NSDictionary *pagingInfo = [AlfrescoObjectConverter paginationJSONFromData:data error:&conversionError];
-            NSArray *tagArray = [self tagArrayFromJSONData:data error:&conversionError];
+            AlfrescoListResponse *listResponse = [[AlfrescoListResponse alloc] initWithData:data];
+            NSDictionary *pagingInfo = [AlfrescoObjectConverter paginationJSONFromListResponse:listResponse error:&conversionError];
+            NSArray *tagArray = [self tagArrayFromListResponse:listResponse error:&conversionError];
             AlfrescoPagingResult *pagingResult = nil;
             if (tagArray && pagingInfo)
             {
@@ -225,7 +227,7 @@ completionBlock:(AlfrescoBOOLCompletionBlock)completionBlock
     }
     if (nil != jsonData)
     {
-        AlfrescoRequest *request = [[AlfrescoRequest alloc] init];
+        AlfrescoRequest *request = [[AlfrescoRequest alloc] initWithService:self operation:_cmd];
         [self.session.networkProvider executeRequestWithURL:url
                                                     session:self.session
                                                 requestBody:jsonData
@@ -254,9 +256,9 @@ completionBlock:(AlfrescoBOOLCompletionBlock)completionBlock
 
 #pragma mark Site service internal methods
 
-- (NSArray *) tagArrayFromJSONData:(NSData *)data error:(NSError **)outError
+- (NSArray *) tagArrayFromListResponse:(AlfrescoListResponse *)listResponse error:(NSError **)outError
 {
-    NSArray *entriesArray = [AlfrescoObjectConverter arrayJSONEntriesFromListData:data error:outError];
+    NSArray *entriesArray = [AlfrescoObjectConverter arrayJSONEntriesFromListResponse:listResponse error:outError];
     if (nil == entriesArray)
     {
         return nil;
@@ -25,4 +25,13 @@
 
 - (NSDictionary *)willApplyHTTPHeadersForSession:(id<AlfrescoSession>)session;
 
+@optional
+
+/**
+ Called when the server rejected a request with a 401 status code, the request is sent again if the credentials could be renewed.
+ @param headers - the headers the rejected request was sent with
+ @param completionBlock - called with YES once headers with renewed credentials are available
+ */
+- (void)renewCredentialsRejectedWithHTTPHeaders:(NSDictionary *)headers completionBlock:(void (^)(BOOL renewed))completionBlock;
+
 @end
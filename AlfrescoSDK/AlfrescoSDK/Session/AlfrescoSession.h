@@ -99,4 +99,16 @@
  */
 - (void)clear;
 
+@optional
+
+/** Gets a session data value for a specific key, creating and adding it if there is none.
+ 
+ The create block is called at most once per key, even when several threads ask for the missing value at the same time.
+ 
+ @param key The key for the object to be retrieved.
+ @param createBlock Creates the object if the session data has no value for the key.
+ @return Session data value.
+ */
+- (id)objectForParameter:(id)key createIfAbsentWithBlock:(id (^)(void))createBlock;
+
 @end
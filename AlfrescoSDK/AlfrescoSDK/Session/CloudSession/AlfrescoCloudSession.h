@@ -39,7 +39,8 @@
 @property (nonatomic, strong, readonly) NSArray *networks;
 
 /**
- There is a custom setter method of oauthData, which is used for refreshing access tokens. This resets the authentication and CMIS session.
+ The session refreshes the access token itself when it is about to expire or has been rejected, and posts kAlfrescoOAuthDataRefreshedNotification
+ so the new tokens can be stored. Setting oauthData hands tokens the application refreshed itself to the session.
  For initialising a AlfrescoCloudSession, one of the connectWithOAuthData methods must be used.
  */
 @property (nonatomic, strong) AlfrescoOAuthData *oauthData;
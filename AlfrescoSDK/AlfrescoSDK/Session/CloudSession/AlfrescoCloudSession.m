@@ -19,11 +19,13 @@
 #import "AlfrescoCloudSession.h"
 #import "CMISSession.h"
 #import "CMISDateUtil.h"
+#import "CMISParameterStore.h"
 #import "AlfrescoCMISToAlfrescoObjectConverter.h"
 #import "AlfrescoAuthenticationProvider.h"
 #import "AlfrescoBasicAuthenticationProvider.h"
 #import "AlfrescoInternalConstants.h"
 #import "AlfrescoOAuthAuthenticationProvider.h"
+#import "AlfrescoOAuthTokenRefresher.h"
 #import "AlfrescoCMISPassThroughAuthenticationProvider.h"
 #import "AlfrescoCMISObjectConverter.h"
 #import "AlfrescoDefaultNetworkProvider.h"
@@ -32,12 +34,16 @@
 #import "AlfrescoRepositoryInfoBuilder.h"
 #import "AlfrescoPersonService.h"
 #import "AlfrescoCMISUtil.h"
+#import "AlfrescoCMISRequestMetricsObserver.h"
+#import "AlfrescoCMISRetryPolicy.h"
+#import "AlfrescoCMISResponseCache.h"
+#import "AlfrescoSessionUtils.h"
 
 @interface AlfrescoCloudSession ()
 @property (nonatomic, strong, readwrite) NSURL *baseUrl;
 @property (nonatomic, strong, readwrite) NSURL *baseURLWithoutNetwork;
 @property (nonatomic, strong) NSURL *cmisUrl;
-@property (nonatomic, strong, readwrite) NSMutableDictionary *sessionData;
+@property (nonatomic, strong, readwrite) CMISParameterStore *sessionData;
 @property (nonatomic, strong, readwrite) NSString *personIdentifier;
 @property (nonatomic, strong, readwrite) AlfrescoRepositoryInfo *repositoryInfo;
 @property (nonatomic, strong, readwrite) AlfrescoRepositoryInfoBuilder *repositoryInfoBuilder;
@@ -51,6 +57,7 @@
 @property (nonatomic, strong, readwrite) NSArray *unremovableSessionKeys;
 @property (nonatomic, strong, readwrite) AlfrescoCloudNetwork *network;
 @property (nonatomic, strong, readwrite) NSArray *networks;
+@property (nonatomic, strong, readwrite) AlfrescoOAuthTokenRefresher *tokenRefresher;
 @end
 
 
@@ -179,14 +186,10 @@
 }
 
 /**
- This is a custom setter method for oauthData. The only use case for this is in case the access token has to be refreshed (AlfrescoCloudSession is instantiated with oauth data).
- This has 2 major consequences:
- 1.) we need to recreate the Authentication Provider. This also needs to filter through to the CMIS library/CMIS Session. 
- 2.) because we use a custom setter for the oauthData property, AlfrescoCloudSession uses the instance variable _oauthData internally to avoid calling the setter inadvertently.
- 
- TODO:
- For now we need to re-initialise/create the CMIS session entirely, even though we only change one parameter on the CMISSessionParameter property of the session.
- Future versions of ObjectiveCMIS lib need to ensure that this won't be necessary and that we will be able to change the parameter 'on the fly'.
+ This is a custom setter method for oauthData. The only use case for this is in case the access token has been refreshed by the application (AlfrescoCloudSession is instantiated with oauth data).
+ The session refreshes expired access tokens itself through its token refresher, which this setter hands the new oauth data to. The authentication providers always
+ apply the refresher's current access token, so neither they nor the CMIS session have to be recreated.
+ Because we use a custom setter for the oauthData property, AlfrescoCloudSession uses the instance variable _oauthData internally to avoid calling the setter inadvertently.
  */
 - (void)setOauthData:(AlfrescoOAuthData *)oauthData
 {
@@ -194,40 +197,11 @@
     {
         return;
     }
-    if (nil != _oauthData)
-    {
-        _oauthData = nil;
-    }
     _oauthData = oauthData;
 
     if (nil != _oauthData)
     {
-        id<AlfrescoAuthenticationProvider> authProvider = [[AlfrescoOAuthAuthenticationProvider alloc] initWithOAuthData:oauthData];
-        [self setObject:authProvider forParameter:kAlfrescoAuthenticationProviderObjectKey];
-        AlfrescoCMISPassThroughAuthenticationProvider *passthroughAuthProvider = [[AlfrescoCMISPassThroughAuthenticationProvider alloc] initWithAlfrescoAuthenticationProvider:authProvider];
-        CMISSession *cmisSession = [self objectForParameter:kAlfrescoSessionKeyCmisSession];
-        if (cmisSession)
-        {
-            __block CMISSessionParameters *params = [[CMISSessionParameters alloc] initWithBindingType:CMISBindingTypeAtomPub];
-            params.atomPubUrl = cmisSession.sessionParameters.atomPubUrl;
-            params.authenticationProvider = passthroughAuthProvider;
-            params.repositoryId = cmisSession.sessionParameters.repositoryId;
-            [params setObject:NSStringFromClass([AlfrescoCMISObjectConverter class]) forKey:kCMISSessionParameterObjectConverterClassName];
-            [CMISSession connectWithSessionParameters:params completionBlock:^(CMISSession *newCMISSession, NSError *error){
-                if (newCMISSession)
-                {
-                    [self setObject:newCMISSession forParameter:kAlfrescoSessionKeyCmisSession];
-                    [newCMISSession retrieveRootFolderWithCompletionBlock:^(CMISFolder *rootFolder, NSError *error){
-                        if (rootFolder)
-                        {
-                            AlfrescoCMISToAlfrescoObjectConverter *objectConverter = [[AlfrescoCMISToAlfrescoObjectConverter alloc] initWithSession:self];
-                            self.rootFolder = (AlfrescoFolder *)[objectConverter nodeFromCMISObject:rootFolder];
-                        }
-                    }];
-                    
-                }
-            }];
-        }
+        [self tokenRefresherForOAuthData:_oauthData];
     }
 }
 
@@ -246,6 +220,11 @@
     (self.sessionData)[key] = object;
 }
 
+- (id)objectForParameter:(id)key createIfAbsentWithBlock:(id (^)(void))createBlock
+{
+    return [self.sessionData objectForKey:key createIfAbsentWithBlock:createBlock];
+}
+
 - (void)addParametersFromDictionary:(NSDictionary *)dictionary
 {
     [self.sessionData addEntriesFromDictionary:dictionary];
@@ -262,7 +241,7 @@
 - (void)clear
 {
     // call the clear method on any objects stored in the session that have the method
-    [self.sessionData enumerateKeysAndObjectsUsingBlock:^(NSString *cacheName, id cacheObj, BOOL *stop){
+    [[self.sessionData dictionaryRepresentation] enumerateKeysAndObjectsUsingBlock:^(NSString *cacheName, id cacheObj, BOOL *stop){
         if ([cacheObj respondsToSelector:@selector(clear)])
         {
             [cacheObj clear];
@@ -276,7 +255,7 @@
 {
     id<AlfrescoAuthenticationProvider> authProvider = [self authProviderToBeUsed];
     [self setObject:authProvider forParameter:kAlfrescoAuthenticationProviderObjectKey];
-    AlfrescoRequest *request = [[AlfrescoRequest alloc] init];
+    AlfrescoRequest *request = [[AlfrescoRequest alloc] initWithService:self operation:_cmd];
     [self.networkProvider executeRequestWithURL:self.baseURLWithoutNetwork
                                         session:self alfrescoRequest:request
                                 completionBlock:^(NSData *data, NSError *error){
@@ -304,7 +283,37 @@
     {
         /// strictly speaking we could use the property, i.e. self.oauthData here. however, i wanted to be consistent in the use of oauthData and only
         /// use the instance variable internally to avoid the use of self.oauthData as a setter
-        return [[AlfrescoOAuthAuthenticationProvider alloc] initWithOAuthData:_oauthData];
+        return [[AlfrescoOAuthAuthenticationProvider alloc] initWithTokenRefresher:[self tokenRefresherForOAuthData:_oauthData]];
+    }
+}
+
+/**
+ All requests of the session share one token refresher, so an expired access token is only refreshed once however many requests it was rejected for.
+ */
+- (AlfrescoOAuthTokenRefresher *)tokenRefresherForOAuthData:(AlfrescoOAuthData *)oauthData
+{
+    // the refresher is looked up from whichever thread the oauth data is set or an authentication provider is created on
+    @synchronized(self)
+    {
+        if (nil == self.tokenRefresher)
+        {
+            self.tokenRefresher = [[AlfrescoOAuthTokenRefresher alloc] initWithOAuthData:oauthData parameters:[self.sessionData dictionaryRepresentation]];
+            self.tokenRefresher.session = self;
+            __weak AlfrescoCloudSession *weakSelf = self;
+            self.tokenRefresher.tokenRefreshHandler = ^(AlfrescoOAuthData *refreshedOAuthData) {
+                AlfrescoCloudSession *strongSelf = weakSelf;
+                if (nil != strongSelf)
+                {
+                    strongSelf->_oauthData = refreshedOAuthData;
+                    [[NSNotificationCenter defaultCenter] postNotificationName:kAlfrescoOAuthDataRefreshedNotification object:strongSelf];
+                }
+            };
+        }
+        else if (self.tokenRefresher.oauthData != oauthData)
+        {
+            [self.tokenRefresher updateOAuthData:oauthData];
+        }
+        return self.tokenRefresher;
     }
 }
 
@@ -320,9 +329,9 @@
 {
     self.isUsingBaseAuthenticationProvider = NO;
     NSString *baseURL = kAlfrescoCloudURL;
-    if ([[self.sessionData allKeys] containsObject:kAlfrescoSessionCloudURL])
+    if ([self.sessionData objectForKey:kAlfrescoSessionCloudURL])
     {
-        baseURL = [self.sessionData valueForKey:kAlfrescoSessionCloudURL];
+        baseURL = [self.sessionData objectForKey:kAlfrescoSessionCloudURL];
         AlfrescoLogDebug(@"overriding Cloud URL with: %@", baseURL);
     }
     self.baseUrl = [NSURL URLWithString:baseURL];
@@ -366,9 +375,9 @@
 {
     self.isUsingBaseAuthenticationProvider = NO;
     NSString *baseURL = kAlfrescoCloudURL;
-    if ([[self.sessionData allKeys] containsObject:kAlfrescoSessionCloudURL])
+    if ([self.sessionData objectForKey:kAlfrescoSessionCloudURL])
     {
-        baseURL = [self.sessionData valueForKey:kAlfrescoSessionCloudURL];
+        baseURL = [self.sessionData objectForKey:kAlfrescoSessionCloudURL];
         AlfrescoLogDebug(@"overriding Cloud URL with: %@", baseURL);
     }
     self.baseUrl = [NSURL URLWithString:[NSString stringWithFormat:@"%@/%@", baseURL, networkIdentifier]];
@@ -388,8 +397,12 @@
     
     // setup background network session
     [self setupCMISBackgroundNetworkSession:params];
+    [AlfrescoCMISRequestMetricsObserver setupCMISSessionParameters:params forSession:self];
+    [AlfrescoCMISRetryPolicy setupCMISSessionParameters:params forSession:self];
+    [AlfrescoCMISResponseCache setupCMISSessionParameters:params forSession:self];
+    [AlfrescoSessionUtils setupCMISSessionParameters:params forSession:self];
 
-    AlfrescoRequest *request = [[AlfrescoRequest alloc] init];
+    AlfrescoRequest *request = [[AlfrescoRequest alloc] initWithService:self operation:_cmd];
     AlfrescoArrayCompletionBlock repositoryCompletionBlock = [self repositoriesWithParameters:params
                                                                               alfrescoRequest:request
                                                                               completionBlock:completionBlock];
@@ -501,9 +514,9 @@ This authentication method authorises the user to access the home network assign
 {
     self.isUsingBaseAuthenticationProvider = YES;
     NSString *baseURL = kAlfrescoCloudURL;
-    if ([[self.sessionData allKeys] containsObject:kAlfrescoSessionCloudURL])
+    if ([self.sessionData objectForKey:kAlfrescoSessionCloudURL])
     {
-        baseURL = [self.sessionData valueForKey:kAlfrescoSessionCloudURL];
+        baseURL = [self.sessionData objectForKey:kAlfrescoSessionCloudURL];
         AlfrescoLogDebug(@"overriding Cloud URL with: %@", baseURL);
     }
     self.baseUrl = [NSURL URLWithString:baseURL];
@@ -551,9 +564,9 @@ This authentication method authorises the user to access the home network assign
 {
     self.isUsingBaseAuthenticationProvider = YES;
     NSString *baseURL = kAlfrescoCloudURL;
-    if ([[self.sessionData allKeys] containsObject:kAlfrescoSessionCloudURL])
+    if ([self.sessionData objectForKey:kAlfrescoSessionCloudURL])
     {
-        baseURL = [self.sessionData valueForKey:kAlfrescoSessionCloudURL];
+        baseURL = [self.sessionData objectForKey:kAlfrescoSessionCloudURL];
         AlfrescoLogDebug(@"overriding Cloud URL with: %@", baseURL);
     }
     self.baseUrl = [NSURL URLWithString:[NSString stringWithFormat:@"%@/%@", baseURL, networkIdentifier]];
@@ -575,8 +588,12 @@ This authentication method authorises the user to access the home network assign
 
     // setup background network session
     [self setupCMISBackgroundNetworkSession:params];
+    [AlfrescoCMISRequestMetricsObserver setupCMISSessionParameters:params forSession:self];
+    [AlfrescoCMISRetryPolicy setupCMISSessionParameters:params forSession:self];
+    [AlfrescoCMISResponseCache setupCMISSessionParameters:params forSession:self];
+    [AlfrescoSessionUtils setupCMISSessionParameters:params forSession:self];
     
-    AlfrescoRequest *request = [[AlfrescoRequest alloc] init];
+    AlfrescoRequest *request = [[AlfrescoRequest alloc] initWithService:self operation:_cmd];
     AlfrescoArrayCompletionBlock repositoryCompletionBlock = [self repositoriesWithParameters:params
                                                                               alfrescoRequest:request
                                                                               completionBlock:completionBlock];
@@ -604,6 +621,12 @@ This authentication method authorises the user to access the home network assign
         [params setObject:@(YES) forKey:kCMISSessionParameterUseBackgroundNetworkSession];
         [params setObject:backgroundId forKey:kCMISSessionParameterBackgroundNetworkSessionId];
         [params setObject:containerId forKey:kCMISSessionParameterBackgroundNetworkSessionSharedContainerId];
+        
+        id maxConcurrentTransfers = self.sessionData[kAlfrescoBackgroundNetworkSessionMaxConcurrentTransfers];
+        if (maxConcurrentTransfers)
+        {
+            [params setObject:maxConcurrentTransfers forKey:kCMISSessionParameterBackgroundNetworkSessionMaxConcurrentTransfers];
+        }
     }
 }
 
@@ -619,11 +642,11 @@ This authentication method authorises the user to access the home network assign
     {
         if (nil != parameters)
         {
-            self.sessionData = [NSMutableDictionary dictionaryWithDictionary:parameters];
+            self.sessionData = [[CMISParameterStore alloc] initWithDictionary:parameters];
         }
         else
         {
-            self.sessionData = [NSMutableDictionary dictionary];
+            self.sessionData = [[CMISParameterStore alloc] init];
         }
         [self setObject:@NO forParameter:kAlfrescoMetadataExtraction];
         [self setObject:@NO forParameter:kAlfrescoThumbnailCreation];
@@ -646,6 +669,11 @@ This authentication method authorises the user to access the home network assign
             }
         }
         
+        // wrap any request metrics observer and set up the retry policy and response cache so the CMIS library shares them
+        [AlfrescoCMISRequestMetricsObserver setupObserverForSession:self];
+        [AlfrescoCMISRetryPolicy setupRetryPolicyForSession:self];
+        [AlfrescoCMISResponseCache setupResponseCacheForSession:self];
+        
         self.unremovableSessionKeys = @[kAlfrescoSessionKeyCmisSession, kAlfrescoAuthenticationProviderObjectKey];
                 
         // setup defaults
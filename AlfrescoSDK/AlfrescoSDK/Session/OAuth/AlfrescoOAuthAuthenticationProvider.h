@@ -21,7 +21,14 @@
 #import <Foundation/Foundation.h>
 #import "AlfrescoAuthenticationProvider.h"
 #import "AlfrescoOAuthData.h"
+#import "AlfrescoOAuthTokenRefresher.h"
 @interface AlfrescoOAuthAuthenticationProvider : NSObject <AlfrescoAuthenticationProvider>
 
 - (id)initWithOAuthData:(AlfrescoOAuthData *)oauthData;
+
+/**
+ The headers always carry the refresher's current access token and rejected tokens are renewed through the refresher.
+ @param tokenRefresher - the token refresher owned by the session
+ */
+- (id)initWithTokenRefresher:(AlfrescoOAuthTokenRefresher *)tokenRefresher;
 @end
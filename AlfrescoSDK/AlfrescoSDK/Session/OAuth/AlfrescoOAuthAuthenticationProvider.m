@@ -18,9 +18,12 @@
 
 #import "AlfrescoOAuthAuthenticationProvider.h"
 
+static NSString * const kAlfrescoOAuthAuthorizationHeader = @"Authorization";
+
 @interface AlfrescoOAuthAuthenticationProvider ()
-@property (nonatomic, strong, readwrite) NSMutableDictionary *httpHeaders;
+@property (nonatomic, strong, readwrite) NSDictionary *httpHeaders;
 @property (nonatomic, strong, readwrite) AlfrescoOAuthData *oauthData;
+@property (nonatomic, strong, readwrite) AlfrescoOAuthTokenRefresher *tokenRefresher;
 @end
 
 @implementation AlfrescoOAuthAuthenticationProvider
@@ -36,22 +39,48 @@
     return self;
 }
 
+- (id)initWithTokenRefresher:(AlfrescoOAuthTokenRefresher *)tokenRefresher
+{
+    self = [self initWithOAuthData:tokenRefresher.oauthData];
+    if (nil != self)
+    {
+        self.tokenRefresher = tokenRefresher;
+    }
+    return self;
+}
+
 
 #pragma AlfrescoAuthenticationProvider method
 
 - (NSDictionary *)willApplyHTTPHeadersForSession:(id<AlfrescoSession>)session
 {
-    if (nil == self.httpHeaders)
+    @synchronized(self)
     {
-        self.httpHeaders = [NSMutableDictionary dictionary];
-        NSString *authHeader = [NSString stringWithFormat:@"%@ %@",self.oauthData.tokenType ,self.oauthData.accessToken];
-        [self.httpHeaders setValue:authHeader forKey:@"Authorization"];
+        // the headers are rebuilt whenever the refresher has a new access token
+        AlfrescoOAuthData *oauthData = self.tokenRefresher ? self.tokenRefresher.oauthData : self.oauthData;
+        if (nil == self.httpHeaders || oauthData != self.oauthData)
+        {
+            self.oauthData = oauthData;
+            NSString *authHeader = [NSString stringWithFormat:@"%@ %@",self.oauthData.tokenType ,self.oauthData.accessToken];
+            self.httpHeaders = @{kAlfrescoOAuthAuthorizationHeader: authHeader};
+        }
+        return self.httpHeaders;
     }
-    return self.httpHeaders;
 }
 
-
-
-
+- (void)renewCredentialsRejectedWithHTTPHeaders:(NSDictionary *)headers completionBlock:(void (^)(BOOL renewed))completionBlock
+{
+    if (nil == self.tokenRefresher)
+    {
+        completionBlock(NO);
+        return;
+    }
+    
+    // the header value is "<token type> <access token>"
+    NSString *rejectedAccessToken = [[headers[kAlfrescoOAuthAuthorizationHeader] componentsSeparatedByString:@" "] lastObject];
+    [self.tokenRefresher refreshRejectedAccessToken:rejectedAccessToken completionBlock:^(AlfrescoOAuthData *oauthData, NSError *error) {
+        completionBlock(nil != oauthData);
+    }];
+}
 
 @end
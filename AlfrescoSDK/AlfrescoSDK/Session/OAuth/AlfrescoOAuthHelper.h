@@ -25,12 +25,17 @@
 #import "AlfrescoOAuthLoginDelegate.h"
 #import "AlfrescoRequest.h"
 
+@protocol AlfrescoSession;
+
 /** The AlfrescoOAuthHelper handles OAuth authentication processes.
  
  Author: Gavin Cornwell (Alfresco), Tijs Rademakers (Alfresco), Peter Schmidt (Alfresco)
  */
 
-@interface AlfrescoOAuthHelper : NSObject <NSURLConnectionDelegate, NSURLConnectionDataDelegate>
+@interface AlfrescoOAuthHelper : NSObject
+
+/// If set, requests are sent through the session's network provider, which uses its SSL and reachability settings.
+@property (nonatomic, weak) id<AlfrescoSession> session;
 
 /**
  @param baseURLString - the base URL
@@ -21,14 +21,18 @@
 #import "AlfrescoInternalConstants.h"
 #import "AlfrescoErrors.h"
 #import "AlfrescoLog.h"
+#import "AlfrescoSessionUtils.h"
+#import "AlfrescoSession.h"
+#import "AlfrescoNetworkProvider.h"
 
 @interface AlfrescoOAuthHelper ()
-@property (nonatomic, strong, readwrite) NSURLConnection *connection;
+@property (nonatomic, strong, readwrite) NSURLSession *URLSession;
 @property (nonatomic, strong, readwrite) NSMutableData *receivedData;
 @property (nonatomic, copy, readwrite) AlfrescoOAuthCompletionBlock completionBlock;
 @property (nonatomic, strong, readwrite) AlfrescoOAuthData *oauthData;
 @property (nonatomic, strong, readwrite) NSString *baseURL;
 @property (nonatomic, weak, readwrite) id<AlfrescoOAuthLoginDelegate> oauthDelegate;
+@property (nonatomic, strong) dispatch_queue_t completionQueue;
 @end
 
 @implementation AlfrescoOAuthHelper
@@ -49,6 +53,7 @@
     if (nil != self)
     {
         self.baseURL = [NSString stringWithFormat:@"%@%@", kAlfrescoCloudURL, kAlfrescoOAuthToken];
+        self.completionQueue = [AlfrescoSessionUtils completionQueueForParameters:parameters];
         if (nil != parameters)
         {
             if ([[parameters allKeys] containsObject:kAlfrescoSessionCloudURL])
@@ -81,6 +86,7 @@
                                                        timeoutInterval: 60];
     
     [request setHTTPMethod:@"POST"];
+    [request setValue:kAlfrescoOAuthFormContentType forHTTPHeaderField:@"Content-Type"];
     
     NSString *codeID   = [kAlfrescoOAuthCode stringByReplacingOccurrencesOfString:kAlfrescoCode withString:authorizationCode];
     NSString *clientID = [kAlfrescoOAuthClientID stringByReplacingOccurrencesOfString:kAlfrescoClientID withString:self.oauthData.apiKey];
@@ -91,12 +97,9 @@
     NSData *data = [bodyContentString dataUsingEncoding:NSUTF8StringEncoding];
     [request setHTTPBody:data];
     
-    self.connection = [NSURLConnection connectionWithRequest:request delegate:self];
-    
-    // return an AlfrescoRequest object to allow cancelling of connection
-    AlfrescoRequest *alfrescoRequest = [AlfrescoRequest new];
-    // NOTE: setting NSURLConnection as the httpRequest property as it is the connection that handles the cancel
-    alfrescoRequest.httpRequest = self.connection;
+    // return an AlfrescoRequest object to allow cancelling of the task
+    AlfrescoRequest *alfrescoRequest = [[AlfrescoRequest alloc] initWithService:self operation:_cmd];
+    [self startRequest:request alfrescoRequest:alfrescoRequest];
     return alfrescoRequest;
 }
 
@@ -114,6 +117,7 @@
                                                        timeoutInterval: 60];
     
     [request setHTTPMethod:@"POST"];
+    [request setValue:kAlfrescoOAuthFormContentType forHTTPHeaderField:@"Content-Type"];
     
     // add the access token header
     NSString *authHeader = [NSString stringWithFormat:@"%@ %@",self.oauthData.tokenType, self.oauthData.accessToken];
@@ -128,12 +132,9 @@
     NSData *data = [bodyContentString dataUsingEncoding:NSUTF8StringEncoding];
     [request setHTTPBody:data];
     
-    self.connection = [NSURLConnection connectionWithRequest:request delegate:self];
-    
-    // return an AlfrescoRequest object to allow cancelling of connection
-    AlfrescoRequest *alfrescoRequest = [AlfrescoRequest new];
-    // NOTE: setting NSURLConnection as the httpRequest property as it is the connection that handles the cancel
-    alfrescoRequest.httpRequest = self.connection;
+    // return an AlfrescoRequest object to allow cancelling of the task
+    AlfrescoRequest *alfrescoRequest = [[AlfrescoRequest alloc] initWithService:self operation:_cmd];
+    [self startRequest:request alfrescoRequest:alfrescoRequest];
     return alfrescoRequest;
 }
 
@@ -179,34 +180,72 @@
     return nil;
 }
 
-#pragma NSURLConnection Delegate methods
+#pragma private methods
 
-- (void)connection:(NSURLConnection *)connection didReceiveData:(NSData *)data
+- (void)startRequest:(NSURLRequest *)request alfrescoRequest:(AlfrescoRequest *)alfrescoRequest
 {
-    if (nil != data && data.length > 0)
+    self.receivedData = nil;
+    
+    id<AlfrescoSession> session = self.session;
+    id<AlfrescoNetworkProvider> networkProvider = session.networkProvider;
+    if ([networkProvider respondsToSelector:@selector(executeRequestWithURL:session:requestBody:method:headers:alfrescoRequest:completionBlock:)])
     {
-        if (nil == self.receivedData)
+        [networkProvider executeRequestWithURL:request.URL
+                                       session:session
+                                   requestBody:request.HTTPBody
+                                        method:request.HTTPMethod
+                                       headers:request.allHTTPHeaderFields
+                               alfrescoRequest:alfrescoRequest
+                               completionBlock:^(NSData *data, NSError *error) {
+                                   // the server explains a rejected request in the response body
+                                   NSData *responseBody = error.userInfo[kAlfrescoErrorKeyHTTPResponseBody];
+                                   if (nil == data && responseBody.length > 0)
+                                   {
+                                       data = responseBody;
+                                       error = nil;
+                                   }
+                                   [self completeRequestWithData:data error:error];
+                               }];
+        return;
+    }
+    
+    // without a session, e.g. while logging in, the request is sent directly
+    self.URLSession = [NSURLSession sessionWithConfiguration:[NSURLSessionConfiguration defaultSessionConfiguration]];
+    NSURLSessionDataTask *task = [self.URLSession dataTaskWithRequest:request completionHandler:^(NSData *data, NSURLResponse *response, NSError *error) {
+        if (nil != error && error.code == NSURLErrorCancelled)
         {
-            self.receivedData = [NSMutableData data];
+            error = [AlfrescoErrors alfrescoErrorWithAlfrescoErrorCode:kAlfrescoErrorCodeNetworkRequestCancelled];
         }
         
-        NSError *error = nil;
-        id jsonObj = [NSJSONSerialization JSONObjectWithData:data options:0 error:&error];
-        if (nil != jsonObj)
-        {
-            if ([jsonObj isKindOfClass:[NSDictionary class]])
-            {
-                [self.receivedData appendBytes:[data bytes] length:data.length];
-            }
-            
-        }
-    }
+        // the session is only used for the one task
+        [self.URLSession finishTasksAndInvalidate];
+        self.URLSession = nil;
+        
+        dispatch_async(self.completionQueue, ^{
+            [self completeRequestWithData:data error:error];
+        });
+    }];
+    [task resume];
+    alfrescoRequest.httpRequest = task;
 }
 
-- (void)connectionDidFinishLoading:(NSURLConnection *)connection
+- (void)completeRequestWithData:(NSData *)data error:(NSError *)error
 {
-    NSError *error = nil;
-    AlfrescoOAuthData *updatedOAuthData = [self updatedOAuthDataFromJSONWithError:&error];
+    if (nil != data && data.length > 0)
+    {
+        self.receivedData = [data mutableCopy];
+    }
+    
+    AlfrescoOAuthData *updatedOAuthData = nil;
+    if (nil != error)
+    {
+        AlfrescoLogError(@"Error is %@ and code is %d", [error localizedDescription], [error code]);
+    }
+    else
+    {
+        updatedOAuthData = [self updatedOAuthDataFromJSONWithError:&error];
+    }
+    
     if (nil == updatedOAuthData)
     {
         if (nil != self.oauthDelegate)
@@ -220,39 +259,6 @@
     self.completionBlock(updatedOAuthData, error);
 }
 
-- (void)connection:(NSURLConnection *)connection didFailWithError:(NSError *)error
-{
-    AlfrescoLogError(@"Error is %@ and code is %d", [error localizedDescription], [error code]);
-    
-    if (nil != self.oauthDelegate)
-    {
-        if ([self.oauthDelegate respondsToSelector:@selector(oauthLoginDidFailWithError:)])
-        {
-            [self.oauthDelegate oauthLoginDidFailWithError:error];
-        }
-    }
-    
-    if (nil == self.receivedData)
-    {
-        self.completionBlock(nil, error);
-        return;
-    }
-    if (0 == self.receivedData.length)
-    {
-        self.completionBlock(nil, error);
-        return;
-    }
-    else
-    {
-        NSError *error = nil;
-        AlfrescoOAuthData *updatedOAuthData = [self updatedOAuthDataFromJSONWithError:&error];
-        self.completionBlock(updatedOAuthData, error);        
-    }
-
-}
-
-#pragma private methods
-
 - (AlfrescoOAuthData *)updatedOAuthDataFromJSONWithError:(NSError **)error
 {
     if (nil == self.receivedData)
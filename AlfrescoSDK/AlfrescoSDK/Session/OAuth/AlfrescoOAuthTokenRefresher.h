@@ -0,0 +1,78 @@
+/*******************************************************************************
+ * Copyright (C) 2005-2020 Alfresco Software Limited.
+ *
+ * This file is part of the Alfresco Mobile SDK.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ******************************************************************************/
+
+#import <Foundation/Foundation.h>
+#import "AlfrescoConstants.h"
+#import "AlfrescoOAuthData.h"
+
+@protocol AlfrescoSession;
+
+/** The AlfrescoOAuthTokenRefresher keeps the access token of a session valid.
+ 
+ Only one refresh request is sent at a time, requests that are rejected while a refresh is in progress
+ wait for it to finish rather than sending refresh requests of their own, which would invalidate each other's
+ refresh tokens. The access token is also refreshed shortly before it expires.
+ */
+
+@interface AlfrescoOAuthTokenRefresher : NSObject
+
+/// The current OAuth data, replaced every time the access token is refreshed.
+@property (atomic, strong, readonly) AlfrescoOAuthData *oauthData;
+
+/// How many seconds before the access token expires it is refreshed, defaults to 60.
+@property (nonatomic, assign) NSTimeInterval renewalMargin;
+
+/// The number of refresh requests that have been sent.
+@property (atomic, assign, readonly) NSUInteger refreshCount;
+
+/// The session whose network provider sends the refresh requests, they're sent directly if nil.
+@property (nonatomic, weak) id<AlfrescoSession> session;
+
+/// Called on the session's completion queue with the new OAuth data after each successful refresh.
+@property (nonatomic, copy) void (^tokenRefreshHandler)(AlfrescoOAuthData *oauthData);
+
+/**
+ @param oauthData - the AlfrescoOAuthData, which needs to contain the api key, secret key and refresh token
+ @param parameters - session parameters, used to determine the Cloud URL and the completion queue
+ */
+- (id)initWithOAuthData:(AlfrescoOAuthData *)oauthData parameters:(NSDictionary *)parameters;
+
+/**
+ Replaces the OAuth data, e.g. after the application refreshed the access token itself, and reschedules the proactive refresh.
+ @param oauthData - the new AlfrescoOAuthData
+ */
+- (void)updateOAuthData:(AlfrescoOAuthData *)oauthData;
+
+/**
+ Refreshes the access token, joining the refresh that is already in progress if there is one.
+ @param completionBlock - called on the session's completion queue
+ */
+- (void)refreshAccessTokenWithCompletionBlock:(AlfrescoOAuthCompletionBlock)completionBlock;
+
+/**
+ Refreshes the access token a request was rejected with. If the token has been refreshed since the request
+ was sent the completion block is called straight away with the current OAuth data.
+ @param accessToken - the access token the request was sent with
+ @param completionBlock - called on the session's completion queue
+ */
+- (void)refreshRejectedAccessToken:(NSString *)accessToken completionBlock:(AlfrescoOAuthCompletionBlock)completionBlock;
+
+/// Stops the proactive refresh, used when the session no longer needs the token.
+- (void)invalidate;
+
+@end
@@ -0,0 +1,182 @@
+/*******************************************************************************
+ * Copyright (C) 2005-2020 Alfresco Software Limited.
+ *
+ * This file is part of the Alfresco Mobile SDK.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ******************************************************************************/
+
+#import "AlfrescoOAuthTokenRefresher.h"
+#import "AlfrescoOAuthHelper.h"
+#import "AlfrescoLog.h"
+#import "AlfrescoSessionUtils.h"
+
+static NSTimeInterval const kAlfrescoOAuthDefaultRenewalMargin = 60;
+
+@interface AlfrescoOAuthTokenRefresher ()
+@property (atomic, strong, readwrite) AlfrescoOAuthData *oauthData;
+@property (atomic, assign, readwrite) NSUInteger refreshCount;
+@property (nonatomic, strong) NSDictionary *parameters;
+@property (nonatomic, strong) dispatch_queue_t completionQueue;
+@property (nonatomic, strong) AlfrescoOAuthHelper *oauthHelper;
+@property (nonatomic, strong) NSMutableArray *waitingCompletionBlocks;
+@property (nonatomic, assign) NSUInteger renewalGeneration;
+@end
+
+@implementation AlfrescoOAuthTokenRefresher
+
+- (id)initWithOAuthData:(AlfrescoOAuthData *)oauthData parameters:(NSDictionary *)parameters
+{
+    self = [super init];
+    if (nil != self)
+    {
+        self.parameters = parameters;
+        self.completionQueue = [AlfrescoSessionUtils completionQueueForParameters:parameters];
+        self.renewalMargin = kAlfrescoOAuthDefaultRenewalMargin;
+        self.waitingCompletionBlocks = [NSMutableArray array];
+        [self updateOAuthData:oauthData];
+    }
+    return self;
+}
+
+- (void)updateOAuthData:(AlfrescoOAuthData *)oauthData
+{
+    self.oauthData = oauthData;
+    [self scheduleRenewal];
+}
+
+- (void)refreshAccessTokenWithCompletionBlock:(AlfrescoOAuthCompletionBlock)completionBlock
+{
+    AlfrescoOAuthHelper *oauthHelper = nil;
+    AlfrescoOAuthData *oauthData = nil;
+    @synchronized(self)
+    {
+        if (NULL != completionBlock)
+        {
+            [self.waitingCompletionBlocks addObject:[completionBlock copy]];
+        }
+        if (nil != self.oauthHelper)
+        {
+            return; // joins the refresh in progress
+        }
+        
+        oauthHelper = [[AlfrescoOAuthHelper alloc] initWithParameters:self.parameters];
+        oauthHelper.session = self.session;
+        oauthData = self.oauthData;
+        self.oauthHelper = oauthHelper;
+        self.refreshCount++;
+    }
+    
+    AlfrescoLogDebug(@"Refreshing the OAuth access token");
+    [oauthHelper refreshAccessToken:oauthData completionBlock:^(AlfrescoOAuthData *refreshedOAuthData, NSError *error) {
+        NSArray *completionBlocks = nil;
+        @synchronized(self)
+        {
+            if (nil != refreshedOAuthData)
+            {
+                self.oauthData = refreshedOAuthData;
+            }
+            completionBlocks = [self.waitingCompletionBlocks copy];
+            [self.waitingCompletionBlocks removeAllObjects];
+            self.oauthHelper = nil;
+        }
+        
+        if (nil != refreshedOAuthData)
+        {
+            [self scheduleRenewal];
+            if (NULL != self.tokenRefreshHandler)
+            {
+                self.tokenRefreshHandler(refreshedOAuthData);
+            }
+        }
+        else
+        {
+            AlfrescoLogError(@"Failed to refresh the OAuth access token: %@", error);
+        }
+        
+        for (AlfrescoOAuthCompletionBlock waitingCompletionBlock in completionBlocks)
+        {
+            waitingCompletionBlock(refreshedOAuthData, error);
+        }
+    }];
+}
+
+- (void)refreshRejectedAccessToken:(NSString *)accessToken completionBlock:(AlfrescoOAuthCompletionBlock)completionBlock
+{
+    AlfrescoOAuthData *oauthData = nil;
+    @synchronized(self)
+    {
+        // a request sent before the last refresh only needs to be sent again with the current token
+        if (nil == self.oauthHelper && ![accessToken isEqualToString:self.oauthData.accessToken])
+        {
+            oauthData = self.oauthData;
+        }
+    }
+    
+    if (nil != oauthData)
+    {
+        dispatch_async(self.completionQueue, ^{
+            completionBlock(oauthData, nil);
+        });
+        return;
+    }
+    
+    [self refreshAccessTokenWithCompletionBlock:completionBlock];
+}
+
+- (void)invalidate
+{
+    @synchronized(self)
+    {
+        self.renewalGeneration++;
+    }
+}
+
+#pragma mark - Private methods
+
+- (void)scheduleRenewal
+{
+    NSUInteger generation;
+    NSTimeInterval delay;
+    @synchronized(self)
+    {
+        // a newer schedule replaces the pending one
+        generation = ++self.renewalGeneration;
+        
+        NSTimeInterval expiresIn = [self.oauthData.expiresIn doubleValue];
+        if (expiresIn <= 0 || nil == self.oauthData.refreshToken)
+        {
+            return;
+        }
+        delay = MAX(expiresIn - self.renewalMargin, expiresIn / 2);
+    }
+    
+    __weak AlfrescoOAuthTokenRefresher *weakSelf = self;
+    dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(delay * NSEC_PER_SEC)), self.completionQueue, ^{
+        AlfrescoOAuthTokenRefresher *strongSelf = weakSelf;
+        if (nil == strongSelf)
+        {
+            return;
+        }
+        @synchronized(strongSelf)
+        {
+            if (strongSelf.renewalGeneration != generation)
+            {
+                return; // invalidated or rescheduled
+            }
+        }
+        [strongSelf refreshAccessTokenWithCompletionBlock:nil];
+    });
+}
+
+@end
@@ -27,10 +27,15 @@
 #import "AlfrescoURLUtils.h"
 #import "AlfrescoRepositoryInfoBuilder.h"
 #import "AlfrescoCMISUtil.h"
+#import "AlfrescoCMISRequestMetricsObserver.h"
+#import "AlfrescoCMISRetryPolicy.h"
+#import "AlfrescoCMISResponseCache.h"
 #import "CMISConstants.h"
 #import "CMISErrors.h"
 #import "CMISSession.h"
 #import "CMISStandardUntrustedSSLAuthenticationProvider.h"
+#import "CMISParameterStore.h"
+#import "AlfrescoSessionUtils.h"
 #import <objc/runtime.h>
 #import "CMISReachability.h"
 #import "AlfrescoConnectionDiagnostic.h"
@@ -42,7 +47,7 @@
 
 @interface AlfrescoRepositorySession ()
 @property (nonatomic, strong, readwrite) NSURL *baseUrl;
-@property (nonatomic, strong, readwrite) NSMutableDictionary *sessionData;
+@property (nonatomic, strong, readwrite) CMISParameterStore *sessionData;
 @property (nonatomic, strong, readwrite) NSString *personIdentifier;
 
 @property (nonatomic, strong, readwrite) AlfrescoRepositoryInfo *repositoryInfo;
@@ -201,11 +206,11 @@
         self.baseUrl = url;
         if (nil != parameters)
         {
-            self.sessionData = [NSMutableDictionary dictionaryWithDictionary:parameters];
+            self.sessionData = [[CMISParameterStore alloc] initWithDictionary:parameters];
         }
         else
         {
-            self.sessionData = [[NSMutableDictionary alloc] init];
+            self.sessionData = [[CMISParameterStore alloc] init];
         }
         
         if (![parameters.allKeys containsObject:kAlfrescoMetadataExtraction])
@@ -244,6 +249,11 @@
             (self.sessionData)[kAlfrescoHTTPShouldHandleCookies] = @YES;
         }
         
+        // wrap any request metrics observer and set up the retry policy and response cache so the CMIS library shares them
+        [AlfrescoCMISRequestMetricsObserver setupObserverForSession:self];
+        [AlfrescoCMISRetryPolicy setupRetryPolicyForSession:self];
+        [AlfrescoCMISResponseCache setupResponseCacheForSession:self];
+        
         self.unremovableSessionKeys = @[kAlfrescoSessionKeyCmisSession, kAlfrescoAuthenticationProviderObjectKey];
         
         // setup defaults
@@ -259,7 +269,7 @@
                              completionBlock:(AlfrescoSessionCompletionBlock)completionBlock
 {
     // firstly call the "server" webscript to retrieve version information
-    AlfrescoRequest *request = [AlfrescoRequest new];
+    AlfrescoRequest *request = [[AlfrescoRequest alloc] initWithService:self operation:_cmd];
     NSString *serverInfoString = [kAlfrescoLegacyAPIPath stringByAppendingString:kAlfrescoLegacyServerAPI];
     NSURL *serverInfoUrl = [AlfrescoURLUtils buildURLFromBaseURLString:self.baseUrl.absoluteString extensionURL:serverInfoString];
     
@@ -384,8 +394,20 @@
                     [cmisSessionParams setObject:@(YES) forKey:kCMISSessionParameterUseBackgroundNetworkSession];
                     [cmisSessionParams setObject:backgroundId forKey:kCMISSessionParameterBackgroundNetworkSessionId];
                     [cmisSessionParams setObject:containerId forKey:kCMISSessionParameterBackgroundNetworkSessionSharedContainerId];
+                    
+                    id maxConcurrentTransfers = self.sessionData[kAlfrescoBackgroundNetworkSessionMaxConcurrentTransfers];
+                    if (maxConcurrentTransfers)
+                    {
+                        [cmisSessionParams setObject:maxConcurrentTransfers forKey:kCMISSessionParameterBackgroundNetworkSessionMaxConcurrentTransfers];
+                    }
                 }
                 
+                // setup request metrics
+                [AlfrescoCMISRequestMetricsObserver setupCMISSessionParameters:cmisSessionParams forSession:self];
+                [AlfrescoCMISRetryPolicy setupCMISSessionParameters:cmisSessionParams forSession:self];
+                [AlfrescoCMISResponseCache setupCMISSessionParameters:cmisSessionParams forSession:self];
+                [AlfrescoSessionUtils setupCMISSessionParameters:cmisSessionParams forSession:self];
+                
                 AlfrescoConnectionDiagnostic *diagnostic = [[AlfrescoConnectionDiagnostic alloc] initWithEventName:kAlfrescoConfigurationDiagnosticRepositoriesAvailableEvent];
                 [diagnostic notifyEventStart];
                 
@@ -453,7 +475,7 @@
                                                       repositories:(NSArray *)repositories
                                                    completionBlock:(AlfrescoSessionCompletionBlock)completionBlock
 {
-    AlfrescoRequest *request = [AlfrescoRequest new];
+    AlfrescoRequest *request = [[AlfrescoRequest alloc] initWithService:self operation:_cmd];
     
     // check that we found at least one repository
     if (repositories.count == 0)
@@ -586,6 +608,11 @@
     (self.sessionData)[key] = object;
 }
 
+- (id)objectForParameter:(id)key createIfAbsentWithBlock:(id (^)(void))createBlock
+{
+    return [self.sessionData objectForKey:key createIfAbsentWithBlock:createBlock];
+}
+
 - (void)addParametersFromDictionary:(NSDictionary *)dictionary
 {
     [self.sessionData addEntriesFromDictionary:dictionary];
@@ -602,7 +629,7 @@
 - (void)clear
 {
     // call the clear method on any objects stored in the session that have the method
-    [self.sessionData enumerateKeysAndObjectsUsingBlock:^(NSString *cacheName, id cacheObj, BOOL *stop){
+    [[self.sessionData dictionaryRepresentation] enumerateKeysAndObjectsUsingBlock:^(NSString *cacheName, id cacheObj, BOOL *stop){
         if ([cacheObj respondsToSelector:@selector(clear)])
         {
             [cacheObj clear];
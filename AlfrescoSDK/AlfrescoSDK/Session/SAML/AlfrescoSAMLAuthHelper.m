@@ -78,7 +78,7 @@
         [AlfrescoErrors assertArgumentNotNil:url argumentName:@"url"];
         [AlfrescoErrors assertArgumentNotNil:completionBlock argumentName:@"completionBlock"];
 
-        request = [AlfrescoRequest new];
+        request = [[AlfrescoRequest alloc] initWithService:self operation:_cmd];
         
         [helper.networkProvider executeRequestWithURL:url
                                               session:nil
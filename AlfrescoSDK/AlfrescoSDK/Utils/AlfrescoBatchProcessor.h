@@ -82,6 +82,8 @@ typedef void (^AlfrescoBatchProcessorCompletionBlock)(NSDictionary *results, NSD
  */
 @interface AlfrescoBatchProcessorOptions : NSObject
 @property (nonatomic, assign) NSInteger maxConcurrentUnitsOfWork;
+/// The queue the completion block is called on, defaults to the main queue
+@property (nonatomic, strong) dispatch_queue_t completionQueue;
 @end
 
 /** The AlfrescoBatchProcessor allows a set of "units of work" to be executed and 
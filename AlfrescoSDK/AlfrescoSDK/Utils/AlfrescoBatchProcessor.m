@@ -31,6 +31,7 @@
 @property (nonatomic, assign, readwrite) BOOL cancelled;
 
 @property (nonatomic, copy) AlfrescoBatchProcessorCompletionBlock completionBlock;
+@property (nonatomic, strong) dispatch_queue_t completionQueue;
 @property (nonatomic, strong) NSMutableDictionary *results;
 @property (nonatomic, strong) NSMutableDictionary *errors;
 @property (nonatomic, strong) NSMutableDictionary *unitsOfWork;
@@ -52,6 +53,7 @@
         self.errors = [NSMutableDictionary dictionary];
         self.unitsOfWork = [NSMutableDictionary dictionary];
         self.mutexLock = [[NSLock alloc] init];
+        self.completionQueue = dispatch_get_main_queue();
         
         // initialise internal queue
         self.queue = [[NSOperationQueue alloc] init];
@@ -79,6 +81,11 @@
         {
             self.queue.maxConcurrentOperationCount = options.maxConcurrentUnitsOfWork;
         }
+        
+        if (options.completionQueue)
+        {
+            self.completionQueue = options.completionQueue;
+        }
     }
     
     return self;
@@ -181,7 +188,7 @@
         
         if (self.completionBlock != NULL)
         {
-            dispatch_async(dispatch_get_main_queue(), ^{
+            dispatch_async(self.completionQueue, ^{
                 self.completionBlock((self.results.count > 0) ? self.results : nil, (self.errors.count > 0) ? self.errors : nil);
             });
         }
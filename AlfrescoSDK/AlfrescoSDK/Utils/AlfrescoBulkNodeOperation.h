@@ -0,0 +1,66 @@
+/*
+ ******************************************************************************
+ * Copyright (C) 2005-2020 Alfresco Software Limited.
+ *
+ * This file is part of the Alfresco Mobile SDK.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *****************************************************************************
+ */
+
+/** AlfrescoBulkNodeOperation
+ 
+ Runs an operation on each of a list of nodes with a limited number of requests in flight at once,
+ further nodes are started as earlier ones complete. Every node is processed once however many times it appears.
+ The outcome is collected per node, cancelling the request returned by start stops nodes that have not been started yet
+ and cancels those in flight, all of them are reported with a cancelled error.
+ */
+
+#import <Foundation/Foundation.h>
+#import "AlfrescoConstants.h"
+#import "AlfrescoErrors.h"
+#import "AlfrescoNode.h"
+#import "AlfrescoRequest.h"
+
+/// The number of requests a bulk operation has in flight at once unless given otherwise.
+extern NSUInteger const kAlfrescoBulkNodeOperationMaxConcurrent;
+
+/// Called with the result of the operation on a single node, a nil result means the operation failed.
+typedef void (^AlfrescoBulkNodeItemCompletionBlock)(id result, NSError *error);
+
+/// Starts the operation on a single node, the returned request is cancelled if the bulk operation is.
+typedef AlfrescoRequest * (^AlfrescoBulkNodeOperationBlock)(AlfrescoNode *node, AlfrescoBulkNodeItemCompletionBlock completionBlock);
+
+@interface AlfrescoBulkNodeOperation : NSObject
+
+/// The maximum number of nodes being processed at once, defaults to kAlfrescoBulkNodeOperationMaxConcurrent.
+@property (nonatomic, assign) NSUInteger maxConcurrent;
+/// The queue the completion and progress blocks are called on and further nodes are started from, defaults to the main queue.
+@property (nonatomic, strong) dispatch_queue_t completionQueue;
+/// Called as nodes complete with the number of nodes completed and the total number of nodes, may be nil.
+@property (nonatomic, copy) AlfrescoProgressBlock progressBlock;
+
+/// Initialises an operation running the given block for each of the nodes, nodes without an identifier are ignored.
+- (id)initWithNodes:(NSArray *)nodes operationBlock:(AlfrescoBulkNodeOperationBlock)operationBlock;
+
+/**
+ Starts processing the nodes using the given request for cancellation, the request's httpRequest is replaced.
+ The completion block is called once every node has completed with the results and the errors, both keyed by node identifier.
+ */
+- (void)startWithRequest:(AlfrescoRequest *)request
+         completionBlock:(void (^)(NSDictionary *results, NSDictionary *itemErrors))completionBlock;
+
+/// Returns an error with the given code carrying the errors of the failed nodes under kAlfrescoErrorKeyItemErrors, nil if none failed.
++ (NSError *)errorWithCode:(AlfrescoErrorCodes)code itemErrors:(NSDictionary *)itemErrors;
+
+@end
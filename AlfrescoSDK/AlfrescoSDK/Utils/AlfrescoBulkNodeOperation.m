@@ -0,0 +1,225 @@
+/*
+ ******************************************************************************
+ * Copyright (C) 2005-2020 Alfresco Software Limited.
+ *
+ * This file is part of the Alfresco Mobile SDK.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *****************************************************************************
+ */
+
+#import "AlfrescoBulkNodeOperation.h"
+#import "AlfrescoRequestGroup.h"
+#import "AlfrescoLog.h"
+
+NSUInteger const kAlfrescoBulkNodeOperationMaxConcurrent = 4; // every request has its own NSURLSession, so the per host limit does not apply
+
+@interface AlfrescoBulkNodeOperation ()
+@property (nonatomic, copy) AlfrescoBulkNodeOperationBlock operationBlock;
+@property (nonatomic, copy) void (^completionBlock)(NSDictionary *results, NSDictionary *itemErrors);
+@property (nonatomic, strong) NSMutableArray *pendingNodes;
+@property (nonatomic, assign) NSUInteger nodeCount;
+@property (nonatomic, strong) NSMutableDictionary *results;
+@property (nonatomic, strong) NSMutableDictionary *itemErrors;
+@property (nonatomic, strong) AlfrescoRequestGroup *requestGroup;
+@property (nonatomic, assign) BOOL completed;
+@end
+
+@implementation AlfrescoBulkNodeOperation
+
+- (id)initWithNodes:(NSArray *)nodes operationBlock:(AlfrescoBulkNodeOperationBlock)operationBlock
+{
+    self = [super init];
+    if (nil != self)
+    {
+        self.operationBlock = operationBlock;
+        self.maxConcurrent = kAlfrescoBulkNodeOperationMaxConcurrent;
+        self.completionQueue = dispatch_get_main_queue();
+        
+        // each node is only processed once, however many times it appears
+        self.pendingNodes = [NSMutableArray arrayWithCapacity:nodes.count];
+        NSMutableSet *identifiers = [NSMutableSet setWithCapacity:nodes.count];
+        for (AlfrescoNode *node in nodes)
+        {
+            if (nil != node.identifier && ![identifiers containsObject:node.identifier])
+            {
+                [identifiers addObject:node.identifier];
+                [self.pendingNodes addObject:node];
+            }
+        }
+        self.nodeCount = self.pendingNodes.count;
+        self.results = [NSMutableDictionary dictionaryWithCapacity:self.nodeCount];
+        self.itemErrors = [NSMutableDictionary dictionary];
+    }
+    return self;
+}
+
+- (void)startWithRequest:(AlfrescoRequest *)request
+         completionBlock:(void (^)(NSDictionary *results, NSDictionary *itemErrors))completionBlock
+{
+    self.completionBlock = completionBlock;
+    self.requestGroup = [AlfrescoRequestGroup new];
+    // a request cancelled while an earlier step was in flight cancels the group straight away
+    request.httpRequest = self.requestGroup;
+
+    if (0 == self.nodeCount)
+    {
+        [self completeIfFinished];
+        return;
+    }
+    
+    NSUInteger concurrentRequests = MIN(MAX(self.maxConcurrent, 1), self.nodeCount);
+    for (NSUInteger index = 0; index < concurrentRequests; index++)
+    {
+        [self startNextNode];
+    }
+}
+
++ (NSError *)errorWithCode:(AlfrescoErrorCodes)code itemErrors:(NSDictionary *)itemErrors
+{
+    if (0 == itemErrors.count)
+    {
+        return nil;
+    }
+    return [AlfrescoErrors alfrescoErrorWithAlfrescoErrorCode:code userInfo:@{kAlfrescoErrorKeyItemErrors: itemErrors}];
+}
+
+#pragma mark - Private methods
+
+- (void)startNextNode
+{
+    // completion blocks may arrive on different queues, the operation itself guards the shared state
+    AlfrescoNode *node = nil;
+    BOOL skippedNodes = NO;
+    @synchronized(self)
+    {
+        if (self.requestGroup.isCancelled)
+        {
+            // nodes that have not been started are not started at all once the operation is cancelled
+            for (AlfrescoNode *pendingNode in self.pendingNodes)
+            {
+                self.itemErrors[pendingNode.identifier] = [AlfrescoErrors alfrescoErrorWithAlfrescoErrorCode:kAlfrescoErrorCodeNetworkRequestCancelled];
+            }
+            skippedNodes = (self.pendingNodes.count > 0);
+            [self.pendingNodes removeAllObjects];
+        }
+        else
+        {
+            node = self.pendingNodes.firstObject;
+            if (nil != node)
+            {
+                [self.pendingNodes removeObjectAtIndex:0];
+            }
+        }
+    }
+    
+    if (nil == node)
+    {
+        if (skippedNodes)
+        {
+            [self reportProgress];
+        }
+        [self completeIfFinished];
+        return;
+    }
+    
+    // the operation block may complete the node before it returns, the group only holds requests still in flight
+    __block AlfrescoRequest *nodeRequest = nil;
+    __block BOOL nodeCompleted = NO;
+    AlfrescoRequest *request = self.operationBlock(node, ^(id result, NSError *error) {
+        AlfrescoRequest *completedRequest = nil;
+        @synchronized(self)
+        {
+            nodeCompleted = YES;
+            completedRequest = nodeRequest;
+            nodeRequest = nil;
+            
+            if (nil != result)
+            {
+                self.results[node.identifier] = result;
+            }
+            else
+            {
+                self.itemErrors[node.identifier] = error ?: [AlfrescoErrors alfrescoErrorWithAlfrescoErrorCode:kAlfrescoErrorCodeUnknown];
+            }
+        }
+        if (nil != completedRequest)
+        {
+            [self.requestGroup removeRequest:completedRequest];
+        }
+        
+        [self reportProgress];
+        
+        // nodes completing straight away would otherwise start one another recursively
+        dispatch_async(self.completionQueue, ^{
+            [self startNextNode];
+        });
+    });
+    
+    @synchronized(self)
+    {
+        if (nil != request && !nodeCompleted)
+        {
+            nodeRequest = request;
+            [self.requestGroup addRequest:request];
+        }
+    }
+}
+
+- (void)reportProgress
+{
+    AlfrescoProgressBlock progressBlock = self.progressBlock;
+    if (nil == progressBlock)
+    {
+        return;
+    }
+    
+    unsigned long long completedCount = 0;
+    @synchronized(self)
+    {
+        completedCount = self.results.count + self.itemErrors.count;
+    }
+    unsigned long long totalCount = self.nodeCount;
+    dispatch_async(self.completionQueue, ^{
+        progressBlock(completedCount, totalCount);
+    });
+}
+
+- (void)completeIfFinished
+{
+    NSDictionary *results = nil;
+    NSDictionary *itemErrors = nil;
+    @synchronized(self)
+    {
+        if (self.completed || self.results.count + self.itemErrors.count < self.nodeCount)
+        {
+            return;
+        }
+        self.completed = YES;
+        results = [self.results copy];
+        itemErrors = [self.itemErrors copy];
+    }
+    
+    if (itemErrors.count > 0)
+    {
+        AlfrescoLogDebug(@"Bulk operation failed for %lu of %lu nodes", (unsigned long)itemErrors.count, (unsigned long)self.nodeCount);
+    }
+    
+    void (^completionBlock)(NSDictionary *, NSDictionary *) = self.completionBlock;
+    self.completionBlock = nil;
+    dispatch_async(self.completionQueue, ^{
+        completionBlock(results, itemErrors);
+    });
+}
+
+@end
@@ -0,0 +1,116 @@
+/*
+ ******************************************************************************
+ * Copyright (C) 2005-2020 Alfresco Software Limited.
+ *
+ * This file is part of the Alfresco Mobile SDK.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *****************************************************************************
+ */
+
+#import "AlfrescoCMISNodeRecord.h"
+#import "AlfrescoCMISToAlfrescoObjectConverter.h"
+#import "AlfrescoCMISDocument.h"
+#import "AlfrescoCMISFolder.h"
+#import "AlfrescoInternalConstants.h"
+#import "CMISObject.h"
+#import "CMISProperties.h"
+#import "CMISPropertyData.h"
+
+@interface AlfrescoCMISNodeRecord ()
+@property (nonatomic, strong) NSDictionary *propertyDataById;
+@property (nonatomic, strong) NSArray *aspectTypes;
+@end
+
+@implementation AlfrescoCMISNodeRecord
+
+- (id)initWithCMISObject:(CMISObject *)cmisObject
+{
+    self = [super init];
+    if (nil != self)
+    {
+        // only the property data is kept, the object and its query name index are released with the parser's result
+        self.propertyDataById = [cmisObject.properties propertiesDictionary];
+        if ([cmisObject isKindOfClass:[AlfrescoCMISDocument class]])
+        {
+            self.aspectTypes = ((AlfrescoCMISDocument *)cmisObject).aspectTypes;
+        }
+        else if ([cmisObject isKindOfClass:[AlfrescoCMISFolder class]])
+        {
+            self.aspectTypes = ((AlfrescoCMISFolder *)cmisObject).aspectTypes;
+        }
+    }
+    return self;
+}
+
+- (id)propertyValueWithName:(NSString *)propertyName
+{
+    CMISPropertyData *propertyData = self.propertyDataById[propertyName];
+    if (propertyData.values.count > 1)
+    {
+        return propertyData.values;
+    }
+    return propertyData.firstValue;
+}
+
+- (NSDictionary *)properties
+{
+    NSMutableDictionary *properties = [NSMutableDictionary dictionaryWithCapacity:self.propertyDataById.count];
+    [self.propertyDataById enumerateKeysAndObjectsUsingBlock:^(NSString *identifier, CMISPropertyData *propertyData, BOOL *stop) {
+        AlfrescoProperty *property = [self propertyFromPropertyData:propertyData];
+        if (nil != property)
+        {
+            properties[identifier] = property;
+        }
+    }];
+    return properties;
+}
+
+- (NSArray *)aspects
+{
+    if (nil == self.aspectTypes)
+    {
+        return nil;
+    }
+    
+    NSMutableArray *aspects = [NSMutableArray arrayWithCapacity:self.aspectTypes.count];
+    for (NSString *type in self.aspectTypes)
+    {
+        [aspects addObject:[AlfrescoCMISToAlfrescoObjectConverter propertyValueWithoutPrecursor:type]];
+    }
+    return aspects;
+}
+
+#pragma mark - Private methods
+
+- (AlfrescoProperty *)propertyFromPropertyData:(CMISPropertyData *)propertyData
+{
+    if (nil == propertyData.values)
+    {
+        return nil;
+    }
+    
+    BOOL isMultiValued = propertyData.values.count > 1;
+    id value = isMultiValued ? propertyData.values : propertyData.firstValue;
+    if (nil == value)
+    {
+        return nil;
+    }
+    
+    AlfrescoPropertyType type = [AlfrescoCMISToAlfrescoObjectConverter typeForCMISPropertyTypeString:propertyData.identifier];
+    return [[AlfrescoProperty alloc] initWithProperties:@{kAlfrescoPropertyType: @(type),
+                                                          kAlfrescoPropertyIsMultiValued: @(isMultiValued),
+                                                          kAlfrescoPropertyValue: value}];
+}
+
+@end
@@ -57,4 +57,8 @@
 
 - (AlfrescoTaskTypeDefinition *)taskTypeDefinitionFromCMISTypeDefinition:(CMISTypeDefinition *)cmisTypeDefinition;
 
++ (AlfrescoPropertyType)typeForCMISPropertyTypeString:(NSString *)type;
+
++ (NSString *)propertyValueWithoutPrecursor:(NSString *)value;
+
 @end
@@ -31,6 +31,7 @@
 #import "AlfrescoNodeTypeDefinition.h"
 #import "AlfrescoPropertyConstants.h"
 #import "CMISPropertyDefinition.h"
+#import "AlfrescoCMISNodeRecord.h"
 
 static NSString * const kAlfrescoCMISEmptyString = @"(null)";
 
@@ -77,7 +78,7 @@ static NSString * const kAlfrescoCMISEmptyString = @"(null)";
     if (![objectType isEqualToString:kAlfrescoCMISEmptyString])
     {
         NSString *alfrescoObjectType = [objectType stringByReplacingOccurrencesOfString:kCMISPropertyObjectTypeIdValueFolder withString:kAlfrescoModelTypeFolder];
-        properties[kCMISPropertyObjectTypeId] = [self propertyValueWithoutPrecursor:alfrescoObjectType];
+        properties[kCMISPropertyObjectTypeId] = [[self class] propertyValueWithoutPrecursor:alfrescoObjectType];
     }
 
     [properties alf_setValueIfNotEmpty:cmisFolder.identifier forKey:kCMISPropertyObjectId];
@@ -103,7 +104,7 @@ static NSString * const kAlfrescoCMISEmptyString = @"(null)";
     if (![objectType isEqualToString:kAlfrescoCMISEmptyString])
     {
         NSString *alfrescoObjectType = [objectType stringByReplacingOccurrencesOfString:kCMISPropertyObjectTypeIdValueDocument withString:kAlfrescoModelTypeContent];
-        properties[kCMISPropertyObjectTypeId] = [self propertyValueWithoutPrecursor:alfrescoObjectType];
+        properties[kCMISPropertyObjectTypeId] = [[self class] propertyValueWithoutPrecursor:alfrescoObjectType];
     }
 
     [properties alf_setValueIfNotEmpty:cmisDocument.identifier forKey:kCMISPropertyObjectId];
@@ -123,42 +124,9 @@ static NSString * const kAlfrescoCMISEmptyString = @"(null)";
 
 - (AlfrescoNode *)nodeFromCMISObject:(CMISObject *)cmisObject
 {
+    // the properties and aspects are only converted when the node is asked for them
     NSMutableDictionary *propertyDictionary = [NSMutableDictionary dictionary];
-    CMISProperties *properties = cmisObject.properties;
-    NSArray *propertyArray = [properties propertyList];
-    NSMutableDictionary *alfPropertiesDict = [NSMutableDictionary dictionary];
-
-    for (CMISPropertyData *propData in propertyArray)
-    {
-        NSMutableDictionary *propertyDictionary = [NSMutableDictionary dictionary];
-        NSString *propertyStringType = propData.identifier;
-        NSNumber *propTypeIndex = @([self typeForCMISPropertyTypeString:propertyStringType]);
-        propertyDictionary[kAlfrescoPropertyType] = propTypeIndex;
-        if (propData.values != nil)
-        {
-            id value = nil;
-            
-            if (propData.values.count > 1)
-            {
-                propertyDictionary[kAlfrescoPropertyIsMultiValued] = @YES;
-                value = propData.values;
-            }
-            else 
-            {
-                propertyDictionary[kAlfrescoPropertyIsMultiValued] = @NO;
-                value = propData.firstValue;
-            }
-
-            if (value != nil)
-            {
-                propertyDictionary[kAlfrescoPropertyValue] = value;
-                AlfrescoProperty *alfProperty = [[AlfrescoProperty alloc] initWithProperties:propertyDictionary];
-                alfPropertiesDict[propData.identifier] = alfProperty;
-            }
-        }
-    }
-    
-    [propertyDictionary setValue:alfPropertiesDict forKey:kAlfrescoNodeProperties];
+    propertyDictionary[kAlfrescoNodeRecord] = [[AlfrescoCMISNodeRecord alloc] initWithCMISObject:cmisObject];
     
     AlfrescoNode *node = nil;
     if ([cmisObject isKindOfClass:[CMISFolder class]])
@@ -166,14 +134,6 @@ static NSString * const kAlfrescoCMISEmptyString = @"(null)";
         if ([cmisObject isKindOfClass:[AlfrescoCMISFolder class]])
         {
             AlfrescoCMISFolder *folder = (AlfrescoCMISFolder *)cmisObject;
-            NSMutableArray *strippedAspectTypes = [NSMutableArray array];
-            for (NSString * type in folder.aspectTypes)
-            {
-                NSString *correctedString = [self propertyValueWithoutPrecursor:type];
-                [strippedAspectTypes addObject:correctedString];
-            }
-            propertyDictionary[kAlfrescoNodeAspects] = strippedAspectTypes;
-            
             [propertyDictionary alf_setValueIfNotEmpty:[folder.properties propertyValueForId:kAlfrescoModelPropertyTitle] forKey:kAlfrescoModelPropertyTitle];
             [propertyDictionary alf_setValueIfNotEmpty:[folder.properties propertyValueForId:kAlfrescoModelPropertyDescription] forKey:kAlfrescoModelPropertyDescription];
         }
@@ -185,14 +145,6 @@ static NSString * const kAlfrescoCMISEmptyString = @"(null)";
         if ([cmisObject isKindOfClass:[AlfrescoCMISDocument class]])
         {
             AlfrescoCMISDocument *document = (AlfrescoCMISDocument *)cmisObject;
-            NSMutableArray *strippedAspectTypes = [NSMutableArray array];
-            for (NSString * type in document.aspectTypes)
-            {
-                NSString *correctedString = [self propertyValueWithoutPrecursor:type];
-                [strippedAspectTypes addObject:correctedString];
-            }
-            propertyDictionary[kAlfrescoNodeAspects] = strippedAspectTypes;
-
             [propertyDictionary alf_setValueIfNotEmpty:[document.properties propertyValueForId:kAlfrescoModelPropertyTitle] forKey:kAlfrescoModelPropertyTitle];
             [propertyDictionary alf_setValueIfNotEmpty:[document.properties propertyValueForId:kAlfrescoModelPropertyDescription] forKey:kAlfrescoModelPropertyDescription];
         }
@@ -261,25 +213,26 @@ static NSString * const kAlfrescoCMISEmptyString = @"(null)";
 
 #pragma mark internal methods
 
-- (AlfrescoPropertyType)typeForCMISPropertyTypeString:(NSString *)type
++ (AlfrescoPropertyType)typeForCMISPropertyTypeString:(NSString *)type
 {
-    if ([[type lowercaseString] hasSuffix:kAlfrescoCMISPropertyTypeInt])
+    NSString *lowercaseType = [type lowercaseString];
+    if ([lowercaseType hasSuffix:kAlfrescoCMISPropertyTypeInt])
     {
         return AlfrescoPropertyTypeInteger;
     }
-    else if ([[type lowercaseString] hasSuffix:kAlfrescoCMISPropertyTypeBoolean])
+    else if ([lowercaseType hasSuffix:kAlfrescoCMISPropertyTypeBoolean])
     {
         return AlfrescoPropertyTypeBoolean;
     }
-    else if ([[type lowercaseString] hasSuffix:kAlfrescoCMISPropertyTypeDatetime])
+    else if ([lowercaseType hasSuffix:kAlfrescoCMISPropertyTypeDatetime])
     {
         return AlfrescoPropertyTypeDateTime;
     }
-    else if ([[type lowercaseString] hasSuffix:kAlfrescoCMISPropertyTypeDecimal])
+    else if ([lowercaseType hasSuffix:kAlfrescoCMISPropertyTypeDecimal])
     {
         return AlfrescoPropertyTypeDecimal;
     }
-    else if ([[type lowercaseString] hasSuffix:kAlfrescoCMISPropertyTypeId])
+    else if ([lowercaseType hasSuffix:kAlfrescoCMISPropertyTypeId])
     {
         return AlfrescoPropertyTypeId;
     }
@@ -311,7 +264,7 @@ static NSString * const kAlfrescoCMISEmptyString = @"(null)";
     return AlfrescoPropertyTypeString;
 }
 
-- (NSString *)propertyValueWithoutPrecursor:(NSString *)value
++ (NSString *)propertyValueWithoutPrecursor:(NSString *)value
 {
     if ([value hasPrefix:kAlfrescoCMISAspectPrefix])
     {
@@ -366,7 +319,7 @@ static NSString * const kAlfrescoCMISEmptyString = @"(null)";
             NSMutableArray *mandatoryAspects = [NSMutableArray arrayWithCapacity:mandatoryAspectsData.children.count];
             for (CMISExtensionElement *mandatoryAspectData in mandatoryAspectsData.children)
             {
-                [mandatoryAspects addObject:[self propertyValueWithoutPrecursor:mandatoryAspectData.value]];
+                [mandatoryAspects addObject:[[self class] propertyValueWithoutPrecursor:mandatoryAspectData.value]];
             }
             
             // set the mandatory aspects array
@@ -384,7 +337,7 @@ static NSString * const kAlfrescoCMISEmptyString = @"(null)";
         }
         else
         {
-            modelDefinitionProperties[kAlfrescoModelDefinitionPropertyName] = [self propertyValueWithoutPrecursor:cmisTypeDefinition.identifier];
+            modelDefinitionProperties[kAlfrescoModelDefinitionPropertyName] = [[self class] propertyValueWithoutPrecursor:cmisTypeDefinition.identifier];
         }
         
         if (cmisTypeDefinition.parentTypeId != nil)
@@ -395,7 +348,7 @@ static NSString * const kAlfrescoCMISEmptyString = @"(null)";
             }
             else
             {
-                modelDefinitionProperties[kAlfrescoModelDefinitionPropertyParent] = [self propertyValueWithoutPrecursor:cmisTypeDefinition.parentTypeId];
+                modelDefinitionProperties[kAlfrescoModelDefinitionPropertyParent] = [[self class] propertyValueWithoutPrecursor:cmisTypeDefinition.parentTypeId];
             }
         }
         
@@ -409,7 +362,7 @@ static NSString * const kAlfrescoCMISEmptyString = @"(null)";
         }
         else
         {
-            modelDefinitionProperties[kAlfrescoModelDefinitionPropertyName] = [self propertyValueWithoutPrecursor:cmisTypeDefinition.identifier];
+            modelDefinitionProperties[kAlfrescoModelDefinitionPropertyName] = [[self class] propertyValueWithoutPrecursor:cmisTypeDefinition.identifier];
         }
         
         if (cmisTypeDefinition.parentTypeId != nil)
@@ -420,7 +373,7 @@ static NSString * const kAlfrescoCMISEmptyString = @"(null)";
             }
             else
             {
-                modelDefinitionProperties[kAlfrescoModelDefinitionPropertyParent] = [self propertyValueWithoutPrecursor:cmisTypeDefinition.parentTypeId];
+                modelDefinitionProperties[kAlfrescoModelDefinitionPropertyParent] = [[self class] propertyValueWithoutPrecursor:cmisTypeDefinition.parentTypeId];
             }
         }
         
@@ -429,7 +382,7 @@ static NSString * const kAlfrescoCMISEmptyString = @"(null)";
     else
     {
         // if it's not a document or folder, presume it's an aspect
-        modelDefinitionProperties[kAlfrescoModelDefinitionPropertyName] = [self propertyValueWithoutPrecursor:cmisTypeDefinition.identifier];
+        modelDefinitionProperties[kAlfrescoModelDefinitionPropertyName] = [[self class] propertyValueWithoutPrecursor:cmisTypeDefinition.identifier];
         
         // TODO: Determine if an aspect has a parent, for now, presume it doesn't
         
@@ -0,0 +1,43 @@
+/*
+ ******************************************************************************
+ * Copyright (C) 2005-2020 Alfresco Software Limited.
+ *
+ * This file is part of the Alfresco Mobile SDK.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *****************************************************************************
+ */
+#import <Foundation/Foundation.h>
+
+/** The AlfrescoContentFingerprint computes the SHA-256 digest of content while it is read, a chunk at a time, so content
+ of any size can be fingerprinted without holding it in memory.
+ */
+@interface AlfrescoContentFingerprint : NSObject
+
+/// The number of bytes the fingerprint has been computed over so far.
+@property (nonatomic, assign, readonly) unsigned long long length;
+
+/**
+ Reads the file a chunk at a time from a memory mapping, the pages read stay cached for an upload that follows.
+ @param filePath - the file to fingerprint
+ @return the hex encoded SHA-256 digest of the file's content, nil if the file could not be read
+ */
++ (NSString *)fingerprintOfFileAtPath:(NSString *)filePath error:(NSError **)error;
+
+/// Adds the given bytes to the fingerprint.
+- (void)updateWithBytes:(const void *)bytes length:(NSUInteger)length;
+
+/// Completes the fingerprint and returns its hex encoded SHA-256 digest, no bytes can be added afterwards.
+- (NSString *)finish;
+
+@end
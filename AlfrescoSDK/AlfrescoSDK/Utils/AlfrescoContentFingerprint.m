@@ -0,0 +1,100 @@
+/*
+ ******************************************************************************
+ * Copyright (C) 2005-2020 Alfresco Software Limited.
+ *
+ * This file is part of the Alfresco Mobile SDK.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *****************************************************************************
+ */
+#import "AlfrescoContentFingerprint.h"
+#import "AlfrescoErrors.h"
+#import "AlfrescoLog.h"
+#import <CommonCrypto/CommonDigest.h>
+
+// CC_SHA256_Update takes a 32 bit length, larger content is added in chunks of this size
+static NSUInteger const kAlfrescoContentFingerprintChunkLength = 1024 * 1024;
+
+@interface AlfrescoContentFingerprint ()
+@property (nonatomic, assign, readwrite) unsigned long long length;
+@property (nonatomic, assign) BOOL finished;
+@end
+
+@implementation AlfrescoContentFingerprint
+{
+    CC_SHA256_CTX _context;
+}
+
++ (NSString *)fingerprintOfFileAtPath:(NSString *)filePath error:(NSError **)error
+{
+    NSError *readError = nil;
+    NSData *data = [NSData dataWithContentsOfFile:filePath options:NSDataReadingMappedIfSafe error:&readError];
+    if (nil == data)
+    {
+        AlfrescoLogError(@"Could not read file %@ to fingerprint it: %@", filePath, readError);
+        if (error)
+        {
+            *error = [AlfrescoErrors alfrescoErrorWithUnderlyingError:readError andAlfrescoErrorCode:kAlfrescoErrorCodeDocumentFolder];
+        }
+        return nil;
+    }
+    
+    AlfrescoContentFingerprint *fingerprint = [[AlfrescoContentFingerprint alloc] init];
+    const uint8_t *bytes = data.bytes;
+    for (NSUInteger offset = 0; offset < data.length; offset += kAlfrescoContentFingerprintChunkLength)
+    {
+        [fingerprint updateWithBytes:bytes + offset length:MIN(kAlfrescoContentFingerprintChunkLength, data.length - offset)];
+    }
+    return [fingerprint finish];
+}
+
+- (instancetype)init
+{
+    self = [super init];
+    if (nil != self)
+    {
+        CC_SHA256_Init(&_context);
+    }
+    return self;
+}
+
+- (void)updateWithBytes:(const void *)bytes length:(NSUInteger)length
+{
+    NSAssert(!self.finished, @"No bytes can be added to a finished fingerprint");
+    const uint8_t *chunk = bytes;
+    NSUInteger remaining = length;
+    while (remaining > 0)
+    {
+        NSUInteger chunkLength = MIN(remaining, kAlfrescoContentFingerprintChunkLength);
+        CC_SHA256_Update(&_context, chunk, (CC_LONG)chunkLength);
+        chunk += chunkLength;
+        remaining -= chunkLength;
+    }
+    self.length += length;
+}
+
+- (NSString *)finish
+{
+    unsigned char digest[CC_SHA256_DIGEST_LENGTH];
+    CC_SHA256_Final(digest, &_context);
+    self.finished = YES;
+    
+    NSMutableString *fingerprint = [NSMutableString stringWithCapacity:CC_SHA256_DIGEST_LENGTH * 2];
+    for (NSUInteger index = 0; index < CC_SHA256_DIGEST_LENGTH; index++)
+    {
+        [fingerprint appendFormat:@"%02x", digest[index]];
+    }
+    return fingerprint;
+}
+
+@end
@@ -0,0 +1,70 @@
+/*
+ ******************************************************************************
+ * Copyright (C) 2005-2020 Alfresco Software Limited.
+ *
+ * This file is part of the Alfresco Mobile SDK.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *****************************************************************************
+ */
+#import <Foundation/Foundation.h>
+#import "AlfrescoSession.h"
+#import "AlfrescoDocument.h"
+#import "AlfrescoFolder.h"
+
+/** The AlfrescoContentFingerprintStore remembers the fingerprint of the content of document versions uploaded or downloaded
+ in a session, so content that matches the server's current version doesn't need to be uploaded again. It can be used
+ from any thread.
+ 
+ The store is used by the document folder service once the kAlfrescoContentDeduplication session parameter is set to YES.
+ A fingerprint is only returned for the version it was recorded for, the version is told apart by its modification date
+ and content length. If the kAlfrescoContentFingerprintSnapshotPath session parameter is set, the fingerprints are written
+ to that file and read back by the next session. If the kAlfrescoContentFingerprintProperty session parameter names a
+ text property of the documents' type or aspects, fingerprints are also stored on the server so other clients can use them.
+ */
+@interface AlfrescoContentFingerprintStore : NSObject
+
+/// The fingerprint store stored in the session, created on first use.
++ (AlfrescoContentFingerprintStore *)fingerprintStoreForSession:(id<AlfrescoSession>)session;
+
+/**
+ @param snapshotPath - the file fingerprints are persisted in, may be nil
+ */
+- (instancetype)initWithSnapshotPath:(NSString *)snapshotPath;
+
+/// The fingerprint recorded for the content of the given version of the document, nil if there is none.
+- (NSString *)fingerprintOfDocument:(AlfrescoDocument *)document;
+
+- (void)recordFingerprint:(NSString *)fingerprint ofDocument:(AlfrescoDocument *)document;
+
+/**
+ Records the fingerprint and remembers the document as the one created with the given name in the folder.
+ @param name - the name the document was created with, the server may have stored it under another one
+ @param properties - the properties the document was created with, including the object type id that names its type and aspects
+ */
+- (void)recordFingerprint:(NSString *)fingerprint
+               ofDocument:(AlfrescoDocument *)document
+                     name:(NSString *)name
+                 inFolder:(AlfrescoFolder *)folder
+               properties:(NSDictionary *)properties;
+
+/// The identifier of the latest version of the document last created with the given name and properties in the folder, nil if there is none.
+- (NSString *)identifierOfDocumentWithName:(NSString *)name inFolder:(AlfrescoFolder *)folder properties:(NSDictionary *)properties;
+
+/// Writes the fingerprints to the snapshot file, returns NO if there is no snapshot path or writing failed.
+- (BOOL)writeSnapshot;
+
+/// Forgets every fingerprint and removes the snapshot file.
+- (void)clear;
+
+@end
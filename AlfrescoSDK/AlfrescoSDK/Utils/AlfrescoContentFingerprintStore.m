@@ -0,0 +1,248 @@
+/*
+ ******************************************************************************
+ * Copyright (C) 2005-2020 Alfresco Software Limited.
+ *
+ * This file is part of the Alfresco Mobile SDK.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *****************************************************************************
+ */
+#import "AlfrescoContentFingerprintStore.h"
+#import "AlfrescoSessionUtils.h"
+#import "AlfrescoInternalConstants.h"
+#import "AlfrescoObjectConverter.h"
+#import "AlfrescoLog.h"
+
+static NSString * const kAlfrescoContentFingerprintSnapshotVersions = @"versions";
+static NSString * const kAlfrescoContentFingerprintSnapshotNames = @"names";
+static NSString * const kAlfrescoContentFingerprintValue = @"fingerprint";
+static NSString * const kAlfrescoContentFingerprintModifiedAt = @"modifiedAt";
+static NSString * const kAlfrescoContentFingerprintContentLength = @"contentLength";
+static NSString * const kAlfrescoContentFingerprintIdentifier = @"identifier";
+static NSString * const kAlfrescoContentFingerprintProperties = @"properties";
+static NSTimeInterval const kAlfrescoContentFingerprintSnapshotDelay = 1;
+
+@interface AlfrescoContentFingerprintStore ()
+@property (nonatomic, strong) NSString *snapshotPath;
+@property (nonatomic, strong) NSMutableDictionary *versions;
+@property (nonatomic, strong) NSMutableDictionary *names;
+@property (nonatomic, strong) dispatch_queue_t snapshotQueue;
+@property (nonatomic, assign) BOOL snapshotScheduled;
+@end
+
+@implementation AlfrescoContentFingerprintStore
+
++ (AlfrescoContentFingerprintStore *)fingerprintStoreForSession:(id<AlfrescoSession>)session
+{
+    return [AlfrescoSessionUtils objectForParameter:kAlfrescoSessionCacheFingerprints ofSession:session createIfAbsentWithBlock:^id{
+        return [[AlfrescoContentFingerprintStore alloc] initWithSnapshotPath:[session objectForParameter:kAlfrescoContentFingerprintSnapshotPath]];
+    }];
+}
+
+- (instancetype)init
+{
+    return [self initWithSnapshotPath:nil];
+}
+
+- (instancetype)initWithSnapshotPath:(NSString *)snapshotPath
+{
+    self = [super init];
+    if (nil != self)
+    {
+        self.snapshotPath = snapshotPath;
+        self.snapshotQueue = dispatch_queue_create("org.alfresco.mobile.contentfingerprintsnapshot", DISPATCH_QUEUE_SERIAL);
+        self.versions = [NSMutableDictionary dictionary];
+        self.names = [NSMutableDictionary dictionary];
+        [self readSnapshot];
+    }
+    return self;
+}
+
+- (NSString *)fingerprintOfDocument:(AlfrescoDocument *)document
+{
+    NSString *key = [self keyForDocument:document];
+    if (nil == key)
+    {
+        return nil;
+    }
+    
+    NSDictionary *version = nil;
+    @synchronized(self)
+    {
+        version = self.versions[key];
+    }
+    
+    // the content of another version may be different even if the name and identifier are the same
+    BOOL isSameVersion = [version[kAlfrescoContentFingerprintModifiedAt] isEqual:document.modifiedAt] &&
+                         [version[kAlfrescoContentFingerprintContentLength] unsignedLongLongValue] == document.contentLength;
+    return isSameVersion ? version[kAlfrescoContentFingerprintValue] : nil;
+}
+
+- (void)recordFingerprint:(NSString *)fingerprint ofDocument:(AlfrescoDocument *)document
+{
+    [self recordFingerprint:fingerprint ofDocument:document name:nil inFolder:nil properties:nil];
+}
+
+- (void)recordFingerprint:(NSString *)fingerprint
+               ofDocument:(AlfrescoDocument *)document
+                     name:(NSString *)name
+                 inFolder:(AlfrescoFolder *)folder
+               properties:(NSDictionary *)properties
+{
+    NSString *key = [self keyForDocument:document];
+    if (nil == key || nil == fingerprint || nil == document.modifiedAt)
+    {
+        return;
+    }
+    
+    NSDictionary *version = @{kAlfrescoContentFingerprintValue: fingerprint,
+                              kAlfrescoContentFingerprintModifiedAt: document.modifiedAt,
+                              kAlfrescoContentFingerprintContentLength: @(document.contentLength)};
+    @synchronized(self)
+    {
+        self.versions[key] = version;
+        if (nil != name && nil != folder.identifier)
+        {
+            self.names[[self keyForName:name inFolder:folder]] = @{kAlfrescoContentFingerprintIdentifier: key,
+                                                                   kAlfrescoContentFingerprintProperties: properties ?: @{}};
+        }
+    }
+    [self scheduleSnapshot];
+}
+
+- (NSString *)identifierOfDocumentWithName:(NSString *)name inFolder:(AlfrescoFolder *)folder properties:(NSDictionary *)properties
+{
+    if (nil == name || nil == folder.identifier)
+    {
+        return nil;
+    }
+    
+    NSDictionary *createdDocument = nil;
+    @synchronized(self)
+    {
+        createdDocument = self.names[[self keyForName:name inFolder:folder]];
+    }
+    
+    // a document created with other properties, type or aspects is a different document, as is one recorded without them
+    if (![createdDocument isKindOfClass:[NSDictionary class]] ||
+        ![createdDocument[kAlfrescoContentFingerprintProperties] isEqualToDictionary:properties ?: @{}])
+    {
+        return nil;
+    }
+    return createdDocument[kAlfrescoContentFingerprintIdentifier];
+}
+
+- (BOOL)writeSnapshot
+{
+    if (nil == self.snapshotPath)
+    {
+        return NO;
+    }
+    
+    NSDictionary *snapshot = nil;
+    @synchronized(self)
+    {
+        snapshot = @{kAlfrescoContentFingerprintSnapshotVersions: [self.versions copy],
+                     kAlfrescoContentFingerprintSnapshotNames: [self.names copy]};
+    }
+    
+    NSError *error = nil;
+    BOOL written = [[NSKeyedArchiver archivedDataWithRootObject:snapshot] writeToFile:self.snapshotPath options:NSDataWritingAtomic error:&error];
+    if (!written)
+    {
+        AlfrescoLogWarning(@"Could not write the content fingerprint snapshot to %@: %@", self.snapshotPath, error);
+    }
+    return written;
+}
+
+- (void)clear
+{
+    @synchronized(self)
+    {
+        [self.versions removeAllObjects];
+        [self.names removeAllObjects];
+    }
+    
+    if (nil != self.snapshotPath)
+    {
+        dispatch_async(self.snapshotQueue, ^{
+            [[NSFileManager defaultManager] removeItemAtPath:self.snapshotPath error:nil];
+        });
+    }
+}
+
+#pragma mark - Private methods
+
+- (NSString *)keyForDocument:(AlfrescoDocument *)document
+{
+    // every version of a document shares the node reference without the version label
+    return (nil != document.identifier) ? [AlfrescoObjectConverter nodeRefWithoutVersionID:document.identifier] : nil;
+}
+
+- (NSString *)keyForName:(NSString *)name inFolder:(AlfrescoFolder *)folder
+{
+    return [NSString stringWithFormat:@"%@/%@", [AlfrescoObjectConverter nodeRefWithoutVersionID:folder.identifier], name];
+}
+
+- (void)scheduleSnapshot
+{
+    if (nil == self.snapshotPath)
+    {
+        return;
+    }
+    
+    // a sync records fingerprints in bursts, they are written once the burst is over
+    @synchronized(self)
+    {
+        if (self.snapshotScheduled)
+        {
+            return;
+        }
+        self.snapshotScheduled = YES;
+    }
+    
+    dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(kAlfrescoContentFingerprintSnapshotDelay * NSEC_PER_SEC)), self.snapshotQueue, ^{
+        @synchronized(self)
+        {
+            self.snapshotScheduled = NO;
+        }
+        [self writeSnapshot];
+    });
+}
+
+- (void)readSnapshot
+{
+    if (nil == self.snapshotPath || ![[NSFileManager defaultManager] fileExistsAtPath:self.snapshotPath])
+    {
+        return;
+    }
+    
+    @try
+    {
+        NSDictionary *snapshot = [NSKeyedUnarchiver unarchiveObjectWithFile:self.snapshotPath];
+        NSDictionary *versions = snapshot[kAlfrescoContentFingerprintSnapshotVersions];
+        NSDictionary *names = snapshot[kAlfrescoContentFingerprintSnapshotNames];
+        if ([versions isKindOfClass:[NSDictionary class]] && [names isKindOfClass:[NSDictionary class]])
+        {
+            [self.versions addEntriesFromDictionary:versions];
+            [self.names addEntriesFromDictionary:names];
+            AlfrescoLogDebug(@"Read %lu content fingerprints from the snapshot", (unsigned long)versions.count);
+        }
+    }
+    @catch (NSException *exception)
+    {
+        AlfrescoLogWarning(@"Could not read the content fingerprint snapshot: %@", exception);
+    }
+}
+
+@end
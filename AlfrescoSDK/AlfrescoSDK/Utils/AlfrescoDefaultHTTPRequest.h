@@ -27,9 +27,17 @@
 #import "AlfrescoRequest.h"
 #import "AlfrescoSession.h"
 
+@class CMISRequestMetrics;
+
 @interface AlfrescoDefaultHTTPRequest : NSObject <AlfrescoCancellableRequest, NSURLSessionDelegate, NSURLSessionTaskDelegate, NSURLSessionDataDelegate>
 
 @property (nonatomic, strong, readonly) NSURL *requestURL;
+// nil unless a request metrics observer has been set for the session
+@property (nonatomic, strong, readonly) CMISRequestMetrics *metrics;
+// the priority of the underlying task, can be changed while the request is in flight
+@property (nonatomic, assign) AlfrescoRequestPriority priority;
+// sent instead of the session's authentication headers if set, a Content-Type header replaces application/json
+@property (nonatomic, strong) NSDictionary *requestHeaders;
 
 - (void)connectWithURL:(NSURL*)requestURL
                 method:(NSString *)method
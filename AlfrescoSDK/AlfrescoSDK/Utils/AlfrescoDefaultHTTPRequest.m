@@ -24,6 +24,11 @@
 #import "AlfrescoLog.h"
 #import "AlfrescoAuthenticationProvider.h"
 #import "CMISReachability.h"
+#import "CMISRequestMetrics.h"
+#import "CMISHttpRequest.h"
+#import "AlfrescoCMISRetryPolicy.h"
+#import "AlfrescoCMISResponseCache.h"
+#import "AlfrescoSessionUtils.h"
 
 @interface AlfrescoDefaultHTTPRequest()
 @property (nonatomic, strong) NSURLSession *URLSession;
@@ -33,6 +38,19 @@
 @property (nonatomic, copy) AlfrescoDataCompletionBlock completionBlock;
 @property (nonatomic, strong, readwrite) NSURL *requestURL;
 @property (nonatomic, strong) NSOutputStream *outputStream;
+@property (nonatomic, strong, readwrite) CMISRequestMetrics *metrics;
+@property (nonatomic, strong) id<CMISRequestMetricsObserver> metricsObserver;
+@property (nonatomic, strong) id<CMISRetryPolicy> retryPolicy;
+@property (nonatomic, strong) NSURLRequest *urlRequest;
+@property (nonatomic, strong) NSHTTPURLResponse *response;
+@property (nonatomic, assign) NSUInteger attempt;
+@property (nonatomic, assign) BOOL waitingToRetry;
+@property (nonatomic, strong) id<AlfrescoAuthenticationProvider> authenticationProvider;
+@property (nonatomic, assign) BOOL renewedCredentials;
+@property (nonatomic, strong) CMISHttpResponseCache *responseCache;
+@property (nonatomic, strong) NSCachedURLResponse *cachedResponse;
+@property (nonatomic, strong) NSString *user;
+@property (nonatomic, strong) dispatch_queue_t completionQueue;
 @end
 
 @implementation AlfrescoDefaultHTTPRequest
@@ -76,11 +94,24 @@
     }
 
     self.completionBlock = completionBlock;
+    self.completionQueue = [AlfrescoSessionUtils completionQueueForSession:session];
     self.requestURL = requestURL;
     AlfrescoLogDebug(@"%@ %@", method, requestURL);
     
-    id authenticationProvider = [session objectForParameter:kAlfrescoAuthenticationProviderObjectKey];
-    NSDictionary *headers = [authenticationProvider willApplyHTTPHeadersForSession:nil];
+    // metrics are only collected when an observer has been configured
+    self.metricsObserver = [CMISRequestMetrics observerFromParameter:[session objectForParameter:kAlfrescoRequestMetricsObserverObjectKey]];
+    if (self.metricsObserver)
+    {
+        self.metrics = [[CMISRequestMetrics alloc] initWithURL:requestURL httpMethod:method];
+    }
+    
+    // a request with headers of its own isn't authenticated by the session, nor are its credentials renewed if they're rejected
+    NSDictionary *headers = self.requestHeaders;
+    if (nil == headers)
+    {
+        self.authenticationProvider = [session objectForParameter:kAlfrescoAuthenticationProviderObjectKey];
+        headers = [self.authenticationProvider willApplyHTTPHeadersForSession:nil];
+    }
     
     NSTimeInterval timeout = 60;
     NSNumber *timeoutParameter = [session objectForParameter:kAlfrescoRequestTimeout];
@@ -113,7 +144,10 @@
     if (nil != requestBody)
     {
         [urlRequest setHTTPBody:requestBody];
-        [urlRequest addValue:@"application/json" forHTTPHeaderField:@"Content-Type"];
+        if (nil == [urlRequest valueForHTTPHeaderField:@"Content-Type"])
+        {
+            [urlRequest addValue:@"application/json" forHTTPHeaderField:@"Content-Type"];
+        }
         
         if ([AlfrescoLog sharedInstance].logLevel == AlfrescoLogLevelTrace)
         {
@@ -121,6 +155,31 @@
         }
     }
     
+    // GET requests are made conditional if a response with validators is cached for them
+    if (nil == outputStream)
+    {
+        self.responseCache = [AlfrescoCMISResponseCache responseCacheForSession:session];
+        self.user = session.personIdentifier;
+        self.cachedResponse = [self.responseCache prepareConditionalRequest:urlRequest user:self.user];
+    }
+    
+    // failed requests are sent again if the session has a retry policy, unless the response is being streamed already
+    if (nil == outputStream)
+    {
+        self.retryPolicy = [AlfrescoCMISRetryPolicy retryPolicyForSession:session];
+    }
+    self.urlRequest = urlRequest;
+    self.attempt = 1;
+    if (self.retryPolicy && ![self.retryPolicy shouldAttemptRequest:urlRequest])
+    {
+        NSError *unavailableError = [AlfrescoErrors alfrescoErrorWithAlfrescoErrorCode:kAlfrescoErrorCodeServerUnavailable];
+        [self.metrics recordCompletionOfTask:nil statusCode:0 error:unavailableError];
+        self.completionBlock = nil;
+        completionBlock(nil, unavailableError);
+        [self notifyMetricsObserver];
+        return;
+    }
+    
     self.outputStream = outputStream;
     if (self.outputStream)
     {
@@ -131,24 +190,57 @@
     // NOTE: we only create a default session configuration object as file upload/download is performed
     //       by the CMIS library, background mode was setup at session creation time
     
+    // execute the request
+    if (self.metrics)
+    {
+        self.metrics.startDate = [NSDate date];
+        if ([self.metricsObserver respondsToSelector:@selector(requestWillStartWithMetrics:)])
+        {
+            [self.metricsObserver requestWillStartWithMetrics:self.metrics];
+        }
+    }
+    [self startTask];
+}
+
+- (void)startTask
+{
     // create session and task
     self.URLSession = [NSURLSession sessionWithConfiguration:[NSURLSessionConfiguration defaultSessionConfiguration]
                                                     delegate:self
                                                delegateQueue:nil];
-    self.sessionTask = [self.URLSession dataTaskWithRequest:urlRequest];
-    
-    // execute the request
+    self.sessionTask = [self.URLSession dataTaskWithRequest:self.urlRequest];
+    self.sessionTask.priority = [CMISHttpRequest taskPriorityForPriority:self.priority];
     [self.sessionTask resume];
 }
 
+- (void)setPriority:(AlfrescoRequestPriority)priority
+{
+    _priority = priority;
+    self.sessionTask.priority = [CMISHttpRequest taskPriorityForPriority:priority];
+}
+
 #pragma mark Session delegate methods
 
 - (void)URLSession:(NSURLSession *)session task:(NSURLSessionTask *)task didCompleteWithError:(NSError *)error
 {
+    // a request rejected because its credentials expired waits for them to be renewed and is then sent again
+    if (task && self.completionBlock != NULL && [self renewCredentialsAfterCompletionWithError:error])
+    {
+        return;
+    }
+    
+    // the policy is told about every attempt that was actually sent so its circuit breaker sees successes as well as failures
+    if (task && self.retryPolicy && self.completionBlock != NULL && [self retryAfterCompletionWithError:error])
+    {
+        return;
+    }
+    
     NSError *requestError = error;
     
     if (!requestError)
     {
+        [self applyResponseCache];
+        
         // no error returned but we also need to check response code
         if (self.statusCode < 200 || self.statusCode > 299)
         {
@@ -190,6 +282,8 @@
         }
     }
     
+    [self.metrics recordCompletionOfTask:task statusCode:self.statusCode error:requestError];
+    
     if (requestError)
     {
         // log the error (if it's likely to be an unrecoverable error)
@@ -205,11 +299,22 @@
     // call completion block
     if (self.completionBlock != NULL)
     {
-        // call the completion block on the main thread
-        dispatch_async(dispatch_get_main_queue(), ^{
+        // call the completion block on the session's completion queue, the main queue unless configured otherwise
+        dispatch_async(self.completionQueue, ^{
+            // the time spent in the completion block is the time taken to parse and convert the response
+            NSDate *processingStartDate = self.metrics ? [NSDate date] : nil;
             self.completionBlock(self.responseData, requestError);
+            if (processingStartDate)
+            {
+                self.metrics.processingDuration = -[processingStartDate timeIntervalSinceNow];
+            }
+            [self notifyMetricsObserver];
         });
     }
+    else
+    {
+        [self notifyMetricsObserver];
+    }
     
     // clean up
     [self.outputStream close];
@@ -251,6 +356,7 @@
     if ([response isKindOfClass:[NSHTTPURLResponse class]])
     {
         NSHTTPURLResponse *httpResponse = (NSHTTPURLResponse *)response;
+        self.response = httpResponse;
         self.statusCode = httpResponse.statusCode;
         
         if ([AlfrescoLog sharedInstance].logLevel == AlfrescoLogLevelTrace)
@@ -266,23 +372,214 @@
     completionHandler(NSURLSessionResponseAllow);
 }
 
+- (void)URLSession:(NSURLSession *)session task:(NSURLSessionTask *)task didFinishCollectingMetrics:(NSURLSessionTaskMetrics *)metrics API_AVAILABLE(ios(10.0), macos(10.12))
+{
+    [self.metrics recordTaskMetrics:metrics];
+}
+
+#pragma mark Response cache
+
+- (void)applyResponseCache
+{
+    if (nil == self.responseCache)
+    {
+        return;
+    }
+    
+    NSCachedURLResponse *cachedResponse = [self.responseCache cachedResponseForNotModifiedResponse:self.response cachedResponse:self.cachedResponse];
+    if (nil != cachedResponse)
+    {
+        // carry on as if the server had sent the cached response again
+        self.response = (NSHTTPURLResponse *)cachedResponse.response;
+        self.statusCode = self.response.statusCode;
+        self.responseData = [cachedResponse.data mutableCopy];
+        self.metrics.notModified = YES;
+    }
+    else if (nil != self.response)
+    {
+        [self.responseCache storeResponse:self.response data:self.responseData forRequest:self.urlRequest user:self.user];
+    }
+}
+
+#pragma mark Credential renewal
+
+- (BOOL)renewCredentialsAfterCompletionWithError:(NSError *)error
+{
+    if (nil != error || self.statusCode != 401 || self.renewedCredentials || nil != self.outputStream ||
+        ![self.authenticationProvider respondsToSelector:@selector(renewCredentialsRejectedWithHTTPHeaders:completionBlock:)])
+    {
+        return NO;
+    }
+    
+    AlfrescoLogDebug(@"Renewing credentials rejected for %@ %@", self.urlRequest.HTTPMethod, self.requestURL);
+    self.renewedCredentials = YES; // only once, a request rejected with renewed credentials fails
+    NSHTTPURLResponse *rejectedResponse = self.response;
+    NSMutableData *rejectedResponseData = self.responseData;
+    
+    [self.URLSession finishTasksAndInvalidate];
+    @synchronized(self)
+    {
+        self.URLSession = nil;
+        self.sessionTask = nil;
+        self.waitingToRetry = YES;
+    }
+    
+    [self.authenticationProvider renewCredentialsRejectedWithHTTPHeaders:self.urlRequest.allHTTPHeaderFields completionBlock:^(BOOL renewed) {
+        @synchronized(self)
+        {
+            if (!self.waitingToRetry)
+            {
+                return; // cancelled while waiting
+            }
+            self.waitingToRetry = NO;
+            
+            if (renewed)
+            {
+                NSMutableURLRequest *urlRequest = [self.urlRequest mutableCopy];
+                [[self.authenticationProvider willApplyHTTPHeadersForSession:nil] enumerateKeysAndObjectsUsingBlock:^(NSString *headerKey, NSString *headerValue, BOOL *stop) {
+                    [urlRequest setValue:headerValue forHTTPHeaderField:headerKey];
+                }];
+                self.urlRequest = urlRequest;
+                self.response = nil;
+                self.responseData = nil;
+                self.statusCode = 0;
+                [self startTask];
+                return;
+            }
+        }
+        
+        // the credentials could not be renewed, the request fails with the original response
+        self.response = rejectedResponse;
+        self.responseData = rejectedResponseData;
+        [self URLSession:nil task:nil didCompleteWithError:nil];
+    }];
+    return YES;
+}
+
+#pragma mark Retries
+
+- (BOOL)retryAfterCompletionWithError:(NSError *)error
+{
+    // the cloud reports exceeding the API rate limit in the response body rather than with a status code
+    BOOL rateLimited = NO;
+    if (nil == error && (self.statusCode < 200 || self.statusCode > 299) && nil != self.responseData)
+    {
+        NSString *responseString = [[NSString alloc] initWithData:self.responseData encoding:NSUTF8StringEncoding];
+        rateLimited = [responseString rangeOfString:kAlfrescoCloudAPIRateLimitExceeded].location != NSNotFound;
+    }
+    
+    NSTimeInterval delay = [self.retryPolicy retryDelayAfterAttempt:self.attempt
+                                                          ofRequest:self.urlRequest
+                                                           response:self.response
+                                                              error:error
+                                                        rateLimited:rateLimited];
+    if (delay < 0)
+    {
+        return NO;
+    }
+    
+    AlfrescoLogDebug(@"Retrying %@ %@ in %.2f seconds after attempt %lu failed with status %ld, error: %@", self.urlRequest.HTTPMethod,
+                     self.requestURL, delay, (unsigned long)self.attempt, (long)self.statusCode, error);
+    self.attempt++;
+    self.metrics.retryCount++;
+    self.metrics.retryWaitDuration += delay;
+    self.response = nil;
+    self.responseData = nil;
+    self.statusCode = 0;
+    
+    // the session of the failed attempt is done with, a new one is created for the retry
+    [self.URLSession finishTasksAndInvalidate];
+    @synchronized(self)
+    {
+        self.URLSession = nil;
+        self.sessionTask = nil;
+        self.waitingToRetry = YES;
+    }
+    
+    dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(delay * NSEC_PER_SEC)), dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
+        [self startRetry];
+    });
+    return YES;
+}
+
+- (void)startRetry
+{
+    @synchronized(self)
+    {
+        if (!self.waitingToRetry)
+        {
+            return; // cancelled while waiting
+        }
+        self.waitingToRetry = NO;
+        
+        if ([self.retryPolicy shouldAttemptRequest:self.urlRequest])
+        {
+            [self startTask];
+            return;
+        }
+    }
+    
+    NSError *unavailableError = [AlfrescoErrors alfrescoErrorWithAlfrescoErrorCode:kAlfrescoErrorCodeServerUnavailable];
+    [self URLSession:nil task:nil didCompleteWithError:unavailableError];
+}
+
+- (void)reportCancelledAttemptToRetryPolicy
+{
+    // a cancelled trial request must give its trial back, or the circuit of its host stays open
+    NSError *cancelledError = [NSError errorWithDomain:NSURLErrorDomain code:NSURLErrorCancelled userInfo:nil];
+    [self.retryPolicy retryDelayAfterAttempt:self.attempt
+                                   ofRequest:self.urlRequest
+                                    response:nil
+                                       error:cancelledError
+                                 rateLimited:NO];
+}
+
+#pragma mark Metrics
+
+- (void)notifyMetricsObserver
+{
+    if (self.metrics)
+    {
+        CMISRequestMetrics *metrics = self.metrics;
+        self.metrics = nil; // only report a request once
+        [self.metricsObserver requestDidFinishWithMetrics:metrics];
+    }
+}
+
 #pragma mark AlfrescoCancellableRequest method
 
 - (void)cancel
 {
-    if (self.URLSession)
+    BOOL wasWaitingToRetry;
+    @synchronized(self)
+    {
+        wasWaitingToRetry = self.waitingToRetry;
+        self.waitingToRetry = NO;
+    }
+    
+    if (self.URLSession || wasWaitingToRetry)
     {
         AlfrescoDataCompletionBlock dataCompletionBlock = self.completionBlock;
         self.completionBlock = nil;
         
+        // without the completion block the session's callback no longer reaches the policy, the cancelled attempt is reported here
+        BOOL attemptInFlight = !wasWaitingToRetry && nil != self.sessionTask && self.sessionTask.state != NSURLSessionTaskStateCompleted;
+        
         [self.URLSession invalidateAndCancel];
         self.URLSession = nil;
         
+        if (attemptInFlight)
+        {
+            [self reportCancelledAttemptToRetryPolicy];
+        }
+        
         [self.outputStream close];
         self.outputStream = nil;
         
         NSError *alfrescoError = [AlfrescoErrors alfrescoErrorWithAlfrescoErrorCode:kAlfrescoErrorCodeNetworkRequestCancelled];
+        [self.metrics recordCompletionOfTask:self.sessionTask statusCode:self.statusCode error:alfrescoError];
         dataCompletionBlock(nil, alfrescoError);
+        [self notifyMetricsObserver];
     }
 }
 
@@ -70,6 +70,29 @@
                       session:(id<AlfrescoSession>)session
                   requestBody:(NSData *)requestBody
                        method:(NSString *)method
+                      headers:(NSDictionary *)headers
+              alfrescoRequest:(AlfrescoRequest *)alfrescoRequest
+              completionBlock:(AlfrescoDataCompletionBlock)completionBlock
+{
+    [self executeRequestWithURL:url session:session requestBody:requestBody method:method headers:headers alfrescoRequest:alfrescoRequest outputStream:nil completionBlock:completionBlock];
+}
+
+- (void)executeRequestWithURL:(NSURL *)url
+                      session:(id<AlfrescoSession>)session
+                  requestBody:(NSData *)requestBody
+                       method:(NSString *)method
+              alfrescoRequest:(AlfrescoRequest *)alfrescoRequest
+                 outputStream:(NSOutputStream *)outputStream
+              completionBlock:(AlfrescoDataCompletionBlock)completionBlock
+{
+    [self executeRequestWithURL:url session:session requestBody:requestBody method:method headers:nil alfrescoRequest:alfrescoRequest outputStream:outputStream completionBlock:completionBlock];
+}
+
+- (void)executeRequestWithURL:(NSURL *)url
+                      session:(id<AlfrescoSession>)session
+                  requestBody:(NSData *)requestBody
+                       method:(NSString *)method
+                      headers:(NSDictionary *)headers
               alfrescoRequest:(AlfrescoRequest *)alfrescoRequest
                  outputStream:(NSOutputStream *)outputStream
               completionBlock:(AlfrescoDataCompletionBlock)completionBlock
@@ -106,6 +129,7 @@
     
     if (alfrescoHTTPRequest && !alfrescoRequest.isCancelled)
     {
+        alfrescoHTTPRequest.requestHeaders = headers;
         if (outputStream)
         {
             [alfrescoHTTPRequest connectWithURL:url
@@ -22,6 +22,7 @@
 #import "AlfrescoSession.h"
 
 @protocol AlfrescoFavoritesCacheDataDelegate <NSObject>
+// Calls back with the favorite nodes that could be resolved, along with an error listing the others under kAlfrescoErrorKeyItemErrors.
 - (AlfrescoRequest *)retrieveFavoriteNodeDataWithCompletionBlock:(AlfrescoArrayCompletionBlock)completionBlock;
 @end
 
@@ -31,9 +32,11 @@
 @property (nonatomic, strong, readonly) NSArray *favoriteNodes;
 @property (nonatomic, strong, readonly) NSArray *favoriteDocuments;
 @property (nonatomic, strong, readonly) NSArray *favoriteFolders;
+// The errors of the favorites the last build could not resolve, keyed by node identifier.
+@property (nonatomic, strong, readonly) NSDictionary *unresolvedFavoriteErrors;
 
 
-// Builds the cache.
+// Builds the cache, favorites that could not be resolved don't fail the build but are listed in unresolvedFavoriteErrors.
 - (AlfrescoRequest *)buildCacheWithDelegate:(id<AlfrescoFavoritesCacheDataDelegate>)delegate completionBlock:(AlfrescoBOOLCompletionBlock)completionBlock;
 
 // Caches the given node with given flag. If the node already exists in the cache it's favortie state
@@ -47,10 +47,14 @@
 @property (nonatomic, strong, readwrite) NSArray *favoriteNodes;
 @property (nonatomic, strong, readwrite) NSArray *favoriteDocuments;
 @property (nonatomic, strong, readwrite) NSArray *favoriteFolders;
+@property (nonatomic, strong, readwrite) NSDictionary *unresolvedFavoriteErrors;
 @property (nonatomic, strong) NSMutableDictionary *internalFavoritesCache;
 @property (nonatomic, strong) NSMutableArray *deferredCompletionBlocks;
+@property (nonatomic, assign) BOOL isCacheBuilding;
 @end
 
+// the cache is used from the completion blocks of the services' requests and from the caller's thread,
+// everything below is accessed while synchronized on the cache
 @implementation AlfrescoFavoritesCache
 
 - (instancetype)init
@@ -59,6 +63,7 @@
     if (nil != self)
     {
         self.isCacheBuilt = NO;
+        self.unresolvedFavoriteErrors = @{};
         self.internalFavoritesCache = [NSMutableDictionary dictionary];
         self.deferredCompletionBlocks = [NSMutableArray new];
     }
@@ -70,35 +75,47 @@
  */
 - (void)clear
 {
-    self.isCacheBuilt = NO;
-    [self.internalFavoritesCache removeAllObjects];
+    @synchronized(self)
+    {
+        self.isCacheBuilt = NO;
+        self.unresolvedFavoriteErrors = @{};
+        [self.internalFavoritesCache removeAllObjects];
+    }
 }
 
 - (AlfrescoRequest *)buildCacheWithDelegate:(id<AlfrescoFavoritesCacheDataDelegate>)delegate completionBlock:(AlfrescoBOOLCompletionBlock)completionBlock;
 {
-    static BOOL isCacheBuilding = NO;
-    
-    if (completionBlock)
-    {
-        [self.deferredCompletionBlocks addObject:completionBlock];
-    }
-    
-    if (isCacheBuilding)
+    @synchronized(self)
     {
-        AlfrescoLogDebug(@"Favorites cache building already in progress");
-        return nil;
+        if (completionBlock)
+        {
+            [self.deferredCompletionBlocks addObject:[completionBlock copy]];
+        }
+        
+        if (self.isCacheBuilding)
+        {
+            AlfrescoLogDebug(@"Favorites cache building already in progress");
+            return nil;
+        }
+        self.isCacheBuilding = YES;
     }
 
     AlfrescoLogDebug(@"Building favorites cache");
 
-    isCacheBuilding = YES;
     return [self internalBuildCacheWithDelegate:delegate completionBlock:^(BOOL succeeded, NSError *error) {
-        for (AlfrescoBOOLCompletionBlock completionBlock in self.deferredCompletionBlocks)
+        NSArray *completionBlocks = nil;
+        @synchronized(self)
+        {
+            completionBlocks = [self.deferredCompletionBlocks copy];
+            [self.deferredCompletionBlocks removeAllObjects];
+            self.isCacheBuilding = NO;
+        }
+        
+        // called outside of the lock as completion blocks may use the cache
+        for (AlfrescoBOOLCompletionBlock deferredCompletionBlock in completionBlocks)
         {
-            completionBlock(succeeded, error);
+            deferredCompletionBlock(succeeded, error);
         }
-        [self.deferredCompletionBlocks removeAllObjects];
-        isCacheBuilding = NO;
     }];
 }
 
@@ -109,14 +126,21 @@
     return [delegate retrieveFavoriteNodeDataWithCompletionBlock:^(NSArray *array, NSError *error) {
         if (array != nil)
         {
-            // add each node to the cache
-            for (AlfrescoNode *node in array)
+            @synchronized(self)
             {
-                [self cacheNode:node favorite:YES];
+                // add each node to the cache
+                for (AlfrescoNode *node in array)
+                {
+                    [self cacheNode:node favorite:YES];
+                }
+                
+                // the favorites that could not be resolved don't fail the build, they're kept for the caller to inspect
+                self.unresolvedFavoriteErrors = error.userInfo[kAlfrescoErrorKeyItemErrors] ?: @{};
+                
+                self.isCacheBuilt = YES;
             }
             
             // let the original caller know the cache is built
-            self.isCacheBuilt = YES;
             AlfrescoLogDebug(@"Favorites cache successfully built");
             if (completionBlock != NULL)
             {
@@ -130,49 +154,30 @@
     }];
 }
 
-- (NSArray *)favoriteNodes
+- (NSDictionary *)unresolvedFavoriteErrors
 {
-    // get cache entries that are marked as a favorite
-    NSPredicate *favoritedEntriesPredicate = [NSPredicate predicateWithFormat:@"favorite == YES"];
-    NSArray *favoritedEntries =  [[self.internalFavoritesCache allValues] filteredArrayUsingPredicate:favoritedEntriesPredicate];
-    
-    NSMutableArray *nodes = [NSMutableArray arrayWithCapacity:favoritedEntries.count];
-    for (AlfrescoFavoritesCacheEntry *entry in favoritedEntries)
+    @synchronized(self)
     {
-        [nodes addObject:entry.node];
+        return _unresolvedFavoriteErrors;
     }
-    
-    return nodes;
+}
+
+- (NSArray *)favoriteNodes
+{
+    // get cache entries that are marked as a favorite
+    return [self nodesOfEntriesMatchingPredicate:[NSPredicate predicateWithFormat:@"favorite == YES"]];
 }
 
 - (NSArray *)favoriteDocuments
 {
     // get cache entries that are documents and marked as a favorite
-    NSPredicate *favoriteDocumentsPredicate = [NSPredicate predicateWithFormat:@"(favorite == YES) AND (node.isDocument == YES)"];
-    NSArray *favoritedEntries =  [[self.internalFavoritesCache allValues] filteredArrayUsingPredicate:favoriteDocumentsPredicate];
-    
-    NSMutableArray *nodes = [NSMutableArray arrayWithCapacity:favoritedEntries.count];
-    for (AlfrescoFavoritesCacheEntry *entry in favoritedEntries)
-    {
-        [nodes addObject:entry.node];
-    }
-    
-    return nodes;
+    return [self nodesOfEntriesMatchingPredicate:[NSPredicate predicateWithFormat:@"(favorite == YES) AND (node.isDocument == YES)"]];
 }
 
 - (NSArray *)favoriteFolders
 {
     // get cache entries that are folders and marked as a favorite
-    NSPredicate *favoriteFoldersPredicate = [NSPredicate predicateWithFormat:@"(favorite == YES) AND (node.isFolder == YES)"];
-    NSArray *favoritedEntries =  [[self.internalFavoritesCache allValues] filteredArrayUsingPredicate:favoriteFoldersPredicate];
-    
-    NSMutableArray *nodes = [NSMutableArray arrayWithCapacity:favoritedEntries.count];
-    for (AlfrescoFavoritesCacheEntry *entry in favoritedEntries)
-    {
-        [nodes addObject:entry.node];
-    }
-    
-    return nodes;
+    return [self nodesOfEntriesMatchingPredicate:[NSPredicate predicateWithFormat:@"(favorite == YES) AND (node.isFolder == YES)"]];
 }
 
 - (void)cacheNode:(AlfrescoNode *)node favorite:(BOOL)favorite
@@ -182,18 +187,21 @@
     // remove the version suffix (if present) from the identifier prior to adding to cache
     NSString *cacheKey = [AlfrescoObjectConverter nodeRefWithoutVersionID:node.identifier];
     
-    AlfrescoFavoritesCacheEntry *entry = self.internalFavoritesCache[cacheKey];
-    if (entry != nil)
+    @synchronized(self)
     {
-        // update node and favorite state in cache entry
-        entry.node = node;
-        entry.favorite = favorite;
-    }
-    else
-    {
-        // create cache entry and add
-        entry = [[AlfrescoFavoritesCacheEntry alloc] initWithNode:node favorite:favorite];
-        self.internalFavoritesCache[cacheKey] = entry;
+        AlfrescoFavoritesCacheEntry *entry = self.internalFavoritesCache[cacheKey];
+        if (entry != nil)
+        {
+            // update node and favorite state in cache entry
+            entry.node = node;
+            entry.favorite = favorite;
+        }
+        else
+        {
+            // create cache entry and add
+            entry = [[AlfrescoFavoritesCacheEntry alloc] initWithNode:node favorite:favorite];
+            self.internalFavoritesCache[cacheKey] = entry;
+        }
     }
     
     AlfrescoLogTrace(@"Cached node: %@, favorite = %@", cacheKey, favorite ? @"YES" : @"NO");
@@ -208,13 +216,33 @@
     // remove the version suffix (if present) from the identifier prior to checking cache
     NSString *cacheKey = [AlfrescoObjectConverter nodeRefWithoutVersionID:node.identifier];
     
-    AlfrescoFavoritesCacheEntry *entry = self.internalFavoritesCache[cacheKey];
-    if (entry != nil)
+    @synchronized(self)
     {
-        result = [NSNumber numberWithBool:entry.favorite];
+        AlfrescoFavoritesCacheEntry *entry = self.internalFavoritesCache[cacheKey];
+        if (entry != nil)
+        {
+            result = [NSNumber numberWithBool:entry.favorite];
+        }
     }
     
     return result;
 }
 
+#pragma mark - Private methods
+
+- (NSArray *)nodesOfEntriesMatchingPredicate:(NSPredicate *)predicate
+{
+    @synchronized(self)
+    {
+        NSArray *matchingEntries = [[self.internalFavoritesCache allValues] filteredArrayUsingPredicate:predicate];
+        
+        NSMutableArray *nodes = [NSMutableArray arrayWithCapacity:matchingEntries.count];
+        for (AlfrescoFavoritesCacheEntry *entry in matchingEntries)
+        {
+            [nodes addObject:entry.node];
+        }
+        return nodes;
+    }
+}
+
 @end
@@ -0,0 +1,46 @@
+/*
+ ******************************************************************************
+ * Copyright (C) 2005-2020 Alfresco Software Limited.
+ *
+ * This file is part of the Alfresco Mobile SDK.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *****************************************************************************
+ */
+
+/** AlfrescoListResponse
+ 
+ The parsed body of a Public API response. The response is parsed once and the
+ result handed to every converter that needs its entries, pagination or raw JSON.
+ */
+
+#import <Foundation/Foundation.h>
+
+@interface AlfrescoListResponse : NSObject
+
+/// The root JSON object of the response, nil if the response could not be parsed.
+@property (nonatomic, strong, readonly) id JSONObject;
+/// The error reported by NSJSONSerialization, nil if the response was parsed or there was no data.
+@property (nonatomic, strong, readonly) NSError *parseError;
+/// The "list" dictionary, nil if the response is not a list.
+@property (nonatomic, strong, readonly) NSDictionary *list;
+/// The "entries" array of the list, nil if not present.
+@property (nonatomic, strong, readonly) NSArray *entries;
+/// The "pagination" dictionary of the list, nil if not present.
+@property (nonatomic, strong, readonly) NSDictionary *pagination;
+/// The reason the response does not contain a list, nil if it does.
+@property (nonatomic, strong, readonly) NSError *error;
+
+- (instancetype)initWithData:(NSData *)data;
+
+@end
@@ -0,0 +1,79 @@
+/*
+ ******************************************************************************
+ * Copyright (C) 2005-2020 Alfresco Software Limited.
+ *
+ * This file is part of the Alfresco Mobile SDK.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *****************************************************************************
+ */
+
+#import "AlfrescoListResponse.h"
+#import "AlfrescoErrors.h"
+#import "AlfrescoInternalConstants.h"
+
+@interface AlfrescoListResponse ()
+@property (nonatomic, strong, readwrite) id JSONObject;
+@property (nonatomic, strong, readwrite) NSError *parseError;
+@property (nonatomic, strong, readwrite) NSDictionary *list;
+@property (nonatomic, strong, readwrite) NSArray *entries;
+@property (nonatomic, strong, readwrite) NSDictionary *pagination;
+@property (nonatomic, strong, readwrite) NSError *error;
+@end
+
+@implementation AlfrescoListResponse
+
+- (instancetype)initWithData:(NSData *)data
+{
+    self = [super init];
+    if (nil != self)
+    {
+        if (nil == data)
+        {
+            self.error = [AlfrescoErrors alfrescoErrorWithAlfrescoErrorCode:kAlfrescoErrorCodeJSONParsingNilData];
+            return self;
+        }
+        
+        NSError *parseError = nil;
+        self.JSONObject = [NSJSONSerialization JSONObjectWithData:data options:0 error:&parseError];
+        if (nil == self.JSONObject)
+        {
+            self.parseError = parseError;
+            self.error = [AlfrescoErrors alfrescoErrorWithAlfrescoErrorCode:kAlfrescoErrorCodeJSONParsingNilData];
+            return self;
+        }
+        
+        id listObject = [self.JSONObject isKindOfClass:[NSDictionary class]] ? self.JSONObject[kAlfrescoPublicAPIJSONList] : nil;
+        if (![listObject isKindOfClass:[NSDictionary class]])
+        {
+            self.error = [AlfrescoErrors alfrescoErrorWithAlfrescoErrorCode:kAlfrescoErrorCodeJSONParsing];
+            return self;
+        }
+        self.list = listObject;
+        
+        id entriesObject = self.list[kAlfrescoPublicAPIJSONEntries];
+        if ([entriesObject isKindOfClass:[NSArray class]])
+        {
+            self.entries = entriesObject;
+        }
+        
+        id paginationObject = self.list[kAlfrescoPublicAPIJSONPagination];
+        if ([paginationObject isKindOfClass:[NSDictionary class]])
+        {
+            self.pagination = paginationObject;
+        }
+    }
+    return self;
+}
+
+@end
@@ -0,0 +1,47 @@
+/*
+ ******************************************************************************
+ * Copyright (C) 2005-2020 Alfresco Software Limited.
+ *
+ * This file is part of the Alfresco Mobile SDK.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *****************************************************************************
+ */
+
+#import <Foundation/Foundation.h>
+#import "AlfrescoSession.h"
+#import "AlfrescoListingContext.h"
+
+/** The AlfrescoListingCache keeps the complete result set of a listing the server can't page for a short while,
+ so the following pages are sliced from it rather than downloading and converting the whole set again.
+ */
+@interface AlfrescoListingCache : NSObject
+
+/// How many seconds a result set is used for, defaults to 30.
+@property (nonatomic, assign) NSTimeInterval timeToLive;
+
+/// The listing cache stored in the session, created on first use.
++ (AlfrescoListingCache *)listingCacheForSession:(id<AlfrescoSession>)session;
+
+/**
+ @param listing - identifies the listing, usually the URL of the request
+ @param listingContext - the sort order and filters are part of the key, the paging settings are not
+ @return the cached result set, or nil if there is none or it has expired
+ */
+- (NSArray *)objectsForListing:(NSString *)listing listingContext:(AlfrescoListingContext *)listingContext;
+
+- (void)cacheObjects:(NSArray *)objects forListing:(NSString *)listing listingContext:(AlfrescoListingContext *)listingContext;
+
+- (void)clear;
+
+@end
@@ -0,0 +1,109 @@
+/*
+ ******************************************************************************
+ * Copyright (C) 2005-2020 Alfresco Software Limited.
+ *
+ * This file is part of the Alfresco Mobile SDK.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *****************************************************************************
+ */
+
+#import "AlfrescoListingCache.h"
+#import "AlfrescoSessionUtils.h"
+#import "AlfrescoInternalConstants.h"
+
+static NSTimeInterval const kAlfrescoListingCacheDefaultTimeToLive = 30;
+static NSUInteger const kAlfrescoListingCacheCountLimit = 16;
+
+@interface AlfrescoListingCacheEntry : NSObject
+@property (nonatomic, strong) NSArray *objects;
+@property (nonatomic, strong) NSDate *expiryDate;
+@end
+
+@implementation AlfrescoListingCacheEntry
+@end
+
+@interface AlfrescoListingCache ()
+@property (nonatomic, strong) NSCache *entries;
+@end
+
+@implementation AlfrescoListingCache
+
++ (AlfrescoListingCache *)listingCacheForSession:(id<AlfrescoSession>)session
+{
+    return [AlfrescoSessionUtils objectForParameter:kAlfrescoSessionCacheListings ofSession:session createIfAbsentWithBlock:^id{
+        return [[AlfrescoListingCache alloc] init];
+    }];
+}
+
+- (instancetype)init
+{
+    self = [super init];
+    if (nil != self)
+    {
+        self.timeToLive = kAlfrescoListingCacheDefaultTimeToLive;
+        self.entries = [[NSCache alloc] init];
+        self.entries.countLimit = kAlfrescoListingCacheCountLimit;
+    }
+    return self;
+}
+
+- (NSArray *)objectsForListing:(NSString *)listing listingContext:(AlfrescoListingContext *)listingContext
+{
+    NSString *key = [self keyForListing:listing listingContext:listingContext];
+    AlfrescoListingCacheEntry *entry = [self.entries objectForKey:key];
+    if (nil == entry)
+    {
+        return nil;
+    }
+    if ([entry.expiryDate timeIntervalSinceNow] <= 0)
+    {
+        [self.entries removeObjectForKey:key];
+        return nil;
+    }
+    return entry.objects;
+}
+
+- (void)cacheObjects:(NSArray *)objects forListing:(NSString *)listing listingContext:(AlfrescoListingContext *)listingContext
+{
+    if (nil == objects)
+    {
+        return;
+    }
+    
+    AlfrescoListingCacheEntry *entry = [[AlfrescoListingCacheEntry alloc] init];
+    entry.objects = objects;
+    entry.expiryDate = [NSDate dateWithTimeIntervalSinceNow:self.timeToLive];
+    [self.entries setObject:entry forKey:[self keyForListing:listing listingContext:listingContext]];
+}
+
+- (void)clear
+{
+    [self.entries removeAllObjects];
+}
+
+#pragma mark - Private methods
+
+- (NSString *)keyForListing:(NSString *)listing listingContext:(AlfrescoListingContext *)listingContext
+{
+    NSMutableString *key = [NSMutableString stringWithString:listing];
+    [key appendFormat:@"|%@|%d", listingContext.sortProperty ?: @"", listingContext.sortAscending];
+    NSDictionary *filters = listingContext.listingFilter.filters;
+    for (NSString *filter in [[filters allKeys] sortedArrayUsingSelector:@selector(compare:)])
+    {
+        [key appendFormat:@"|%@=%@", filter, filters[filter]];
+    }
+    return key;
+}
+
+@end
@@ -0,0 +1,78 @@
+/*
+ ******************************************************************************
+ * Copyright (C) 2005-2020 Alfresco Software Limited.
+ *
+ * This file is part of the Alfresco Mobile SDK.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *****************************************************************************
+ */
+
+#import <Foundation/Foundation.h>
+#import "AlfrescoSession.h"
+#import "AlfrescoRequest.h"
+#import "AlfrescoModelDefinition.h"
+
+typedef void (^AlfrescoModelDefinitionRegistryCompletionBlock)(AlfrescoModelDefinition *definition, NSError *error);
+
+/// Starts loading a definition from the server, the completion block must be called exactly once.
+typedef AlfrescoRequest * (^AlfrescoModelDefinitionRegistryLoader)(AlfrescoModelDefinitionRegistryCompletionBlock completionBlock);
+
+/** The AlfrescoModelDefinitionRegistry holds the type and aspect definitions loaded for a session and can be used from any thread.
+ 
+ However many callers ask for a definition that isn't known yet, it is only loaded once, every caller is called back
+ when the load completes. Cancelling a caller's request only cancels the load once no other caller is waiting for it.
+ 
+ If the kAlfrescoModelDefinitionSnapshotPath session parameter is set, the definitions are written to that file and read
+ back by the next session, as long as it connects to the same repository at the same URL and version, the snapshot is
+ younger than kAlfrescoModelDefinitionSnapshotMaxAge (an NSNumber of seconds, a week by default) and the file's checksum is intact.
+ The snapshot is read in the background once the registry has been created, the first lookup waits for it.
+ */
+@interface AlfrescoModelDefinitionRegistry : NSObject
+
+/// The number of definitions loaded from the server.
+@property (nonatomic, assign, readonly) NSUInteger loadCount;
+
+/// The registry stored in the session, created on first use.
++ (AlfrescoModelDefinitionRegistry *)registryForSession:(id<AlfrescoSession>)session;
+
+/// Identifies the repository the definitions of the session come from by its identifier, URL and version.
++ (NSString *)repositoryKeyForSession:(id<AlfrescoSession>)session;
+
+/**
+ @param snapshotPath - the file definitions are persisted in, may be nil
+ @param repositoryKey - identifies the repository the definitions come from, a snapshot of another repository is ignored
+ @param maxSnapshotAge - a snapshot written longer ago than this is ignored
+ */
+- (instancetype)initWithSnapshotPath:(NSString *)snapshotPath repositoryKey:(NSString *)repositoryKey maxSnapshotAge:(NSTimeInterval)maxSnapshotAge;
+
+/// The definition with the given CMIS identifier, or nil if it hasn't been loaded.
+- (AlfrescoModelDefinition *)definitionForIdentifier:(NSString *)identifier;
+
+/**
+ Calls the completion block straight away with a known definition, otherwise joins the load in flight or starts one with the loader.
+ @param identifier - the CMIS identifier of the type or aspect
+ @param loader - called to load the definition if it's neither known nor being loaded
+ @return the request to set as the httpRequest of the caller's AlfrescoRequest, nil if the definition was known
+ */
+- (id<AlfrescoCancellableRequest>)retrieveDefinitionForIdentifier:(NSString *)identifier
+                                                           loader:(AlfrescoModelDefinitionRegistryLoader)loader
+                                                  completionBlock:(AlfrescoModelDefinitionRegistryCompletionBlock)completionBlock;
+
+/// Writes the known definitions to the snapshot file, returns NO if there is no snapshot path or writing failed.
+- (BOOL)writeSnapshot;
+
+/// Forgets every definition and removes the snapshot file.
+- (void)clear;
+
+@end
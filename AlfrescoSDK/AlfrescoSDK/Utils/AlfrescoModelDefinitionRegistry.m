@@ -0,0 +1,414 @@
+/*
+ ******************************************************************************
+ * Copyright (C) 2005-2020 Alfresco Software Limited.
+ *
+ * This file is part of the Alfresco Mobile SDK.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *****************************************************************************
+ */
+
+#import "AlfrescoModelDefinitionRegistry.h"
+#import "AlfrescoSessionUtils.h"
+#import "AlfrescoInternalConstants.h"
+#import "AlfrescoErrors.h"
+#import "AlfrescoLog.h"
+#import <CommonCrypto/CommonDigest.h>
+
+static NSString * const kAlfrescoModelDefinitionSnapshotRepositoryKey = @"repositoryKey";
+static NSString * const kAlfrescoModelDefinitionSnapshotDate = @"date";
+static NSString * const kAlfrescoModelDefinitionSnapshotChecksum = @"checksum";
+static NSString * const kAlfrescoModelDefinitionSnapshotDefinitions = @"definitions";
+static NSTimeInterval const kAlfrescoModelDefinitionSnapshotDelay = 1;
+static NSTimeInterval const kAlfrescoModelDefinitionSnapshotDefaultMaxAge = 7 * 24 * 60 * 60;
+
+@class AlfrescoModelDefinitionLoad;
+@class AlfrescoModelDefinitionWaiter;
+
+@interface AlfrescoModelDefinitionRegistry ()
+@property (nonatomic, assign, readwrite) NSUInteger loadCount;
+@property (nonatomic, strong) NSString *snapshotPath;
+@property (nonatomic, strong) NSString *repositoryKey;
+@property (nonatomic, assign) NSTimeInterval maxSnapshotAge;
+@property (nonatomic, strong) NSMutableDictionary *definitions;
+@property (nonatomic, strong) NSMutableDictionary *pendingLoads;
+@property (nonatomic, strong) dispatch_queue_t snapshotQueue;
+@property (nonatomic, assign) BOOL snapshotScheduled;
+@property (atomic, assign) BOOL snapshotRead;
+- (void)cancelWaiter:(AlfrescoModelDefinitionWaiter *)waiter ofLoad:(AlfrescoModelDefinitionLoad *)load;
+@end
+
+// a load in flight and the callers waiting for it, guarded by the registry
+@interface AlfrescoModelDefinitionLoad : NSObject
+@property (nonatomic, strong) NSString *identifier;
+@property (nonatomic, strong) NSMutableArray *waiters;
+@property (nonatomic, strong) AlfrescoRequest *request;
+@property (nonatomic, assign) BOOL finished;
+@property (nonatomic, assign) BOOL cancelled;
+@end
+
+@implementation AlfrescoModelDefinitionLoad
+@end
+
+// a caller waiting for a load, cancelling it takes the caller off the load
+@interface AlfrescoModelDefinitionWaiter : NSObject <AlfrescoCancellableRequest>
+@property (nonatomic, weak) AlfrescoModelDefinitionRegistry *registry;
+@property (nonatomic, strong) AlfrescoModelDefinitionLoad *load;
+@property (nonatomic, copy) AlfrescoModelDefinitionRegistryCompletionBlock completionBlock;
+@end
+
+@implementation AlfrescoModelDefinitionWaiter
+
+- (void)cancel
+{
+    [self.registry cancelWaiter:self ofLoad:self.load];
+}
+
+@end
+
+@implementation AlfrescoModelDefinitionRegistry
+
++ (AlfrescoModelDefinitionRegistry *)registryForSession:(id<AlfrescoSession>)session
+{
+    return [AlfrescoSessionUtils objectForParameter:kAlfrescoSessionCacheDefinitions ofSession:session createIfAbsentWithBlock:^id{
+        NSNumber *maxAgeParameter = [session objectForParameter:kAlfrescoModelDefinitionSnapshotMaxAge];
+        NSTimeInterval maxSnapshotAge = (nil != maxAgeParameter) ? maxAgeParameter.doubleValue : kAlfrescoModelDefinitionSnapshotDefaultMaxAge;
+        return [[AlfrescoModelDefinitionRegistry alloc] initWithSnapshotPath:[session objectForParameter:kAlfrescoModelDefinitionSnapshotPath]
+                                                               repositoryKey:[AlfrescoModelDefinitionRegistry repositoryKeyForSession:session]
+                                                              maxSnapshotAge:maxSnapshotAge];
+    }];
+}
+
++ (NSString *)repositoryKeyForSession:(id<AlfrescoSession>)session
+{
+    // the same version of a different repository, or of the same one behind another URL, can have other models deployed
+    return [NSString stringWithFormat:@"%@|%@|%@",
+            session.repositoryInfo.identifier ?: @"",
+            session.baseUrl.absoluteString ?: @"",
+            session.repositoryInfo.version ?: @""];
+}
+
+- (instancetype)init
+{
+    return [self initWithSnapshotPath:nil repositoryKey:nil maxSnapshotAge:kAlfrescoModelDefinitionSnapshotDefaultMaxAge];
+}
+
+- (instancetype)initWithSnapshotPath:(NSString *)snapshotPath repositoryKey:(NSString *)repositoryKey maxSnapshotAge:(NSTimeInterval)maxSnapshotAge
+{
+    self = [super init];
+    if (nil != self)
+    {
+        self.snapshotPath = snapshotPath;
+        self.repositoryKey = repositoryKey ?: @"";
+        self.maxSnapshotAge = maxSnapshotAge;
+        self.pendingLoads = [NSMutableDictionary dictionary];
+        self.snapshotQueue = dispatch_queue_create("org.alfresco.mobile.modeldefinitionsnapshot", DISPATCH_QUEUE_SERIAL);
+        self.definitions = [NSMutableDictionary dictionary];
+        
+        // the registry is created while the session holds a lock, so the file is read on the snapshot queue instead
+        dispatch_async(self.snapshotQueue, ^{
+            NSDictionary *snapshotDefinitions = [self readSnapshot];
+            @synchronized(self)
+            {
+                [snapshotDefinitions enumerateKeysAndObjectsUsingBlock:^(NSString *identifier, AlfrescoModelDefinition *definition, BOOL *stop) {
+                    if (nil == self.definitions[identifier])
+                    {
+                        self.definitions[identifier] = definition;
+                    }
+                }];
+            }
+            self.snapshotRead = YES;
+        });
+    }
+    return self;
+}
+
+- (AlfrescoModelDefinition *)definitionForIdentifier:(NSString *)identifier
+{
+    [self waitForSnapshot];
+    @synchronized(self)
+    {
+        return self.definitions[identifier];
+    }
+}
+
+- (id<AlfrescoCancellableRequest>)retrieveDefinitionForIdentifier:(NSString *)identifier
+                                                           loader:(AlfrescoModelDefinitionRegistryLoader)loader
+                                                  completionBlock:(AlfrescoModelDefinitionRegistryCompletionBlock)completionBlock
+{
+    [self waitForSnapshot];
+    
+    AlfrescoModelDefinition *definition = nil;
+    AlfrescoModelDefinitionWaiter *waiter = nil;
+    BOOL startLoad = NO;
+    @synchronized(self)
+    {
+        definition = self.definitions[identifier];
+        if (nil == definition)
+        {
+            AlfrescoModelDefinitionLoad *load = self.pendingLoads[identifier];
+            if (nil == load)
+            {
+                load = [AlfrescoModelDefinitionLoad new];
+                load.identifier = identifier;
+                load.waiters = [NSMutableArray array];
+                self.pendingLoads[identifier] = load;
+                self.loadCount++;
+                startLoad = YES;
+            }
+            
+            waiter = [AlfrescoModelDefinitionWaiter new];
+            waiter.registry = self;
+            waiter.load = load;
+            waiter.completionBlock = completionBlock;
+            [load.waiters addObject:waiter];
+        }
+    }
+    
+    if (nil != definition)
+    {
+        AlfrescoLogDebug(@"Cache hit: returning definition for %@ from the registry", identifier);
+        completionBlock(definition, nil);
+        return nil;
+    }
+    
+    if (startLoad)
+    {
+        AlfrescoModelDefinitionLoad *load = waiter.load;
+        AlfrescoRequest *request = loader(^(AlfrescoModelDefinition *loadedDefinition, NSError *error) {
+            [self finishLoad:load definition:loadedDefinition error:error];
+        });
+        
+        // every caller may have gone before the loader returned its request
+        BOOL cancelled = NO;
+        @synchronized(self)
+        {
+            load.request = request;
+            cancelled = load.cancelled;
+        }
+        if (cancelled)
+        {
+            [request cancel];
+        }
+    }
+    else
+    {
+        AlfrescoLogDebug(@"Joining the load of the definition for %@ already in flight", identifier);
+    }
+    
+    return waiter;
+}
+
+- (BOOL)writeSnapshot
+{
+    if (nil == self.snapshotPath)
+    {
+        return NO;
+    }
+    
+    [self waitForSnapshot];
+    NSDictionary *definitions = nil;
+    @synchronized(self)
+    {
+        definitions = [self.definitions copy];
+    }
+    
+    NSData *definitionsData = [NSKeyedArchiver archivedDataWithRootObject:definitions];
+    NSDictionary *snapshot = @{kAlfrescoModelDefinitionSnapshotRepositoryKey: self.repositoryKey,
+                               kAlfrescoModelDefinitionSnapshotDate: [NSDate date],
+                               kAlfrescoModelDefinitionSnapshotChecksum: [self checksumOfData:definitionsData],
+                               kAlfrescoModelDefinitionSnapshotDefinitions: definitionsData};
+    NSData *snapshotData = [NSKeyedArchiver archivedDataWithRootObject:snapshot];
+    
+    NSError *error = nil;
+    BOOL written = [snapshotData writeToFile:self.snapshotPath options:NSDataWritingAtomic error:&error];
+    if (!written)
+    {
+        AlfrescoLogWarning(@"Could not write the model definition snapshot to %@: %@", self.snapshotPath, error);
+    }
+    return written;
+}
+
+- (void)clear
+{
+    [self waitForSnapshot];
+    @synchronized(self)
+    {
+        [self.definitions removeAllObjects];
+    }
+    
+    if (nil != self.snapshotPath)
+    {
+        dispatch_async(self.snapshotQueue, ^{
+            [[NSFileManager defaultManager] removeItemAtPath:self.snapshotPath error:nil];
+        });
+    }
+}
+
+#pragma mark - Private methods
+
+- (void)waitForSnapshot
+{
+    // the snapshot is read by the first block on the serial queue, so it has been read by the time any other block runs there
+    if (!self.snapshotRead)
+    {
+        dispatch_sync(self.snapshotQueue, ^{});
+    }
+}
+
+- (void)finishLoad:(AlfrescoModelDefinitionLoad *)load definition:(AlfrescoModelDefinition *)definition error:(NSError *)error
+{
+    NSArray *waiters = nil;
+    @synchronized(self)
+    {
+        if (load.finished)
+        {
+            return;
+        }
+        load.finished = YES;
+        
+        if (self.pendingLoads[load.identifier] == load)
+        {
+            [self.pendingLoads removeObjectForKey:load.identifier];
+        }
+        if (nil != definition)
+        {
+            self.definitions[load.identifier] = definition;
+        }
+        waiters = [load.waiters copy];
+        [load.waiters removeAllObjects];
+    }
+    
+    // call back outside of the lock as completion blocks may ask for further definitions
+    for (AlfrescoModelDefinitionWaiter *waiter in waiters)
+    {
+        waiter.completionBlock(definition, error);
+    }
+    
+    if (nil != definition)
+    {
+        [self scheduleSnapshot];
+    }
+}
+
+- (void)cancelWaiter:(AlfrescoModelDefinitionWaiter *)waiter ofLoad:(AlfrescoModelDefinitionLoad *)load
+{
+    AlfrescoRequest *requestToCancel = nil;
+    @synchronized(self)
+    {
+        if (load.finished || ![load.waiters containsObject:waiter])
+        {
+            return;
+        }
+        [load.waiters removeObject:waiter];
+        
+        if (0 == load.waiters.count)
+        {
+            // nobody is interested any more, a later caller starts a new load
+            load.cancelled = YES;
+            load.finished = YES;
+            if (self.pendingLoads[load.identifier] == load)
+            {
+                [self.pendingLoads removeObjectForKey:load.identifier];
+            }
+            requestToCancel = load.request;
+        }
+    }
+    
+    waiter.completionBlock(nil, [AlfrescoErrors alfrescoErrorWithAlfrescoErrorCode:kAlfrescoErrorCodeNetworkRequestCancelled]);
+    [requestToCancel cancel];
+}
+
+- (void)scheduleSnapshot
+{
+    if (nil == self.snapshotPath)
+    {
+        return;
+    }
+    
+    // definitions tend to arrive in bursts, they are written once the burst is over
+    @synchronized(self)
+    {
+        if (self.snapshotScheduled)
+        {
+            return;
+        }
+        self.snapshotScheduled = YES;
+    }
+    
+    dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(kAlfrescoModelDefinitionSnapshotDelay * NSEC_PER_SEC)), self.snapshotQueue, ^{
+        @synchronized(self)
+        {
+            self.snapshotScheduled = NO;
+        }
+        [self writeSnapshot];
+    });
+}
+
+- (NSMutableDictionary *)readSnapshot
+{
+    if (nil == self.snapshotPath || ![[NSFileManager defaultManager] fileExistsAtPath:self.snapshotPath])
+    {
+        return nil;
+    }
+    
+    NSMutableDictionary *definitions = nil;
+    @try
+    {
+        NSDictionary *snapshot = [NSKeyedUnarchiver unarchiveObjectWithFile:self.snapshotPath];
+        NSData *definitionsData = snapshot[kAlfrescoModelDefinitionSnapshotDefinitions];
+        NSDate *snapshotDate = snapshot[kAlfrescoModelDefinitionSnapshotDate];
+        if (![snapshot[kAlfrescoModelDefinitionSnapshotRepositoryKey] isEqualToString:self.repositoryKey])
+        {
+            AlfrescoLogDebug(@"Ignoring the model definition snapshot taken from another repository");
+        }
+        else if (![snapshotDate isKindOfClass:[NSDate class]] || -[snapshotDate timeIntervalSinceNow] > self.maxSnapshotAge)
+        {
+            AlfrescoLogDebug(@"Ignoring the model definition snapshot as it is older than %.0f seconds", self.maxSnapshotAge);
+        }
+        else if (nil == definitionsData || ![snapshot[kAlfrescoModelDefinitionSnapshotChecksum] isEqualToString:[self checksumOfData:definitionsData]])
+        {
+            AlfrescoLogWarning(@"Ignoring the model definition snapshot as its checksum does not match");
+        }
+        else
+        {
+            NSDictionary *snapshotDefinitions = [NSKeyedUnarchiver unarchiveObjectWithData:definitionsData];
+            if ([snapshotDefinitions isKindOfClass:[NSDictionary class]])
+            {
+                definitions = [snapshotDefinitions mutableCopy];
+                AlfrescoLogDebug(@"Read %lu model definitions from the snapshot", (unsigned long)definitions.count);
+            }
+        }
+    }
+    @catch (NSException *exception)
+    {
+        AlfrescoLogWarning(@"Could not read the model definition snapshot: %@", exception);
+    }
+    
+    return definitions;
+}
+
+- (NSString *)checksumOfData:(NSData *)data
+{
+    unsigned char digest[CC_SHA256_DIGEST_LENGTH];
+    CC_SHA256(data.bytes, (CC_LONG)data.length, digest);
+    
+    NSMutableString *checksum = [NSMutableString stringWithCapacity:CC_SHA256_DIGEST_LENGTH * 2];
+    for (NSUInteger index = 0; index < CC_SHA256_DIGEST_LENGTH; index++)
+    {
+        [checksum appendFormat:@"%02x", digest[index]];
+    }
+    return checksum;
+}
+
+@end
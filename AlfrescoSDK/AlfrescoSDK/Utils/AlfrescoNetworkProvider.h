@@ -55,4 +55,18 @@
               alfrescoRequest:(AlfrescoRequest *)alfrescoRequest
               completionBlock:(AlfrescoDataCompletionBlock)completionBlock;
 
+@optional
+
+/**
+ Sends the request with the given headers instead of the session's authentication headers, a Content-Type header replaces
+ the default of application/json. OAuth token requests are sent this way, providers that don't implement it leave them to the SDK.
+ */
+- (void)executeRequestWithURL:(NSURL *)url
+                      session:(id<AlfrescoSession>)session
+                  requestBody:(NSData *)requestBody
+                       method:(NSString *)method
+                      headers:(NSDictionary *)headers
+              alfrescoRequest:(AlfrescoRequest *)alfrescoRequest
+              completionBlock:(AlfrescoDataCompletionBlock)completionBlock;
+
 @end
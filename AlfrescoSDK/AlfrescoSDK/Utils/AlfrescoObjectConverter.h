@@ -25,13 +25,18 @@
 
 #import <Foundation/Foundation.h>
 #import "AlfrescoErrors.h"
+#import "AlfrescoListResponse.h"
 
 @interface AlfrescoObjectConverter : NSObject
 
 + (NSArray *)arrayJSONEntriesFromListData:(NSData *)data error:(NSError **)outError;
 
++ (NSArray *)arrayJSONEntriesFromListResponse:(AlfrescoListResponse *)listResponse error:(NSError **)outError;
+
 + (NSDictionary *)paginationJSONFromData:(NSData *)data error:(NSError **)outError;
 
++ (NSDictionary *)paginationJSONFromListResponse:(AlfrescoListResponse *)listResponse error:(NSError **)outError;
+
 + (NSDictionary *)listJSONFromData:(NSData *)data error:(NSError **)outError;
 
 + (NSDictionary *)dictionaryJSONEntryFromListData:(NSData *)data error:(NSError **)outError;
@@ -42,6 +47,8 @@
 
 + (id)parseJSONData:(NSData *)jsonData notFoundErrorCode:(AlfrescoErrorCodes)errorCode parseBlock:(id (^)(id jsonObject, NSError *parseError))parseBlock;
 
++ (id)parseListResponse:(AlfrescoListResponse *)listResponse notFoundErrorCode:(AlfrescoErrorCodes)errorCode parseBlock:(id (^)(id jsonObject, NSError *parseError))parseBlock;
+
 + (NSDictionary *)paginationJSONFromOldAPIData:(NSData *)data error:(NSError **)outError;
 
 + (NSDictionary *)pagingFromOldAPIData:(NSData *)data error:(NSError **)outError;
@@ -30,116 +30,67 @@
 
 + (NSDictionary *)listJSONFromData:(NSData *)data error:(NSError **)outError
 {
-    if (nil == data)
+    AlfrescoListResponse *listResponse = [[AlfrescoListResponse alloc] initWithData:data];
+    if (nil == listResponse.list)
     {
-        if (nil == *outError)
-        {
-            *outError = [AlfrescoErrors alfrescoErrorWithAlfrescoErrorCode:kAlfrescoErrorCodeJSONParsingNilData];
-        }
-        else
-        {
-            NSError *error = [AlfrescoErrors alfrescoErrorWithAlfrescoErrorCode:kAlfrescoErrorCodeJSONParsingNilData];
-            *outError = [AlfrescoErrors alfrescoErrorWithUnderlyingError:error andAlfrescoErrorCode:kAlfrescoErrorCodeJSONParsingNilData];
-        }
-        return nil;
-    }
-    NSError *error = nil;
-    id jsonDictionary = [NSJSONSerialization JSONObjectWithData:data options:0 error:&error];
-    if (nil == jsonDictionary)
-    {
-        if (nil == *outError)
-        {
-            *outError = [AlfrescoErrors alfrescoErrorWithAlfrescoErrorCode:kAlfrescoErrorCodeJSONParsingNilData];
-        }
-        else
-        {
-            NSError *error = [AlfrescoErrors alfrescoErrorWithAlfrescoErrorCode:kAlfrescoErrorCodeJSONParsingNilData];
-            *outError = [AlfrescoErrors alfrescoErrorWithUnderlyingError:error andAlfrescoErrorCode:kAlfrescoErrorCodeJSONParsingNilData];
-        }
-        return nil;
+        [AlfrescoObjectConverter setConversionError:outError withListResponseError:listResponse.error];
     }
-    
-    if (![jsonDictionary isKindOfClass:[NSDictionary class]])
+    return listResponse.list;
+}
+
++ (NSDictionary *)paginationJSONFromData:(NSData *)data error:(NSError **)outError
+{
+    return [AlfrescoObjectConverter paginationJSONFromListResponse:[[AlfrescoListResponse alloc] initWithData:data] error:outError];
+}
+
++ (NSDictionary *)paginationJSONFromListResponse:(AlfrescoListResponse *)listResponse error:(NSError **)outError
+{
+    if (nil == listResponse.list)
     {
-        if (nil == *outError)
-        {
-            *outError = [AlfrescoErrors alfrescoErrorWithAlfrescoErrorCode:kAlfrescoErrorCodeJSONParsing];
-        }
-        else
-        {
-            NSError *underlyingError = [AlfrescoErrors alfrescoErrorWithAlfrescoErrorCode:kAlfrescoErrorCodeJSONParsing];
-            *outError = [AlfrescoErrors alfrescoErrorWithUnderlyingError:underlyingError andAlfrescoErrorCode:kAlfrescoErrorCodeJSONParsing];
-        }
+        [AlfrescoObjectConverter setConversionError:outError withListResponseError:listResponse.error];
         return nil;
     }
-    
-    id listObject = [jsonDictionary valueForKey:kAlfrescoPublicAPIJSONList];
-    if (![listObject isKindOfClass:[NSDictionary class]])
+    if (nil == listResponse.pagination)
     {
-        if (nil == *outError)
-        {
-            *outError = [AlfrescoErrors alfrescoErrorWithAlfrescoErrorCode:kAlfrescoErrorCodeJSONParsing];
-        }
-        else
-        {
-            NSError *underlyingError = [AlfrescoErrors alfrescoErrorWithAlfrescoErrorCode:kAlfrescoErrorCodeJSONParsing];
-            *outError = [AlfrescoErrors alfrescoErrorWithUnderlyingError:underlyingError andAlfrescoErrorCode:kAlfrescoErrorCodeJSONParsing];
-        }
-        return nil;
+        [AlfrescoObjectConverter setConversionError:outError withListResponseError:[AlfrescoErrors alfrescoErrorWithAlfrescoErrorCode:kAlfrescoErrorCodeJSONParsing]];
     }
-    return (NSDictionary *)listObject;
+    return listResponse.pagination;
 }
 
++ (NSArray *)arrayJSONEntriesFromListData:(NSData *)data error:(NSError **)outError
+{
+    return [AlfrescoObjectConverter arrayJSONEntriesFromListResponse:[[AlfrescoListResponse alloc] initWithData:data] error:outError];
+}
 
-
-+ (NSDictionary *)paginationJSONFromData:(NSData *)data error:(NSError **)outError
++ (NSArray *)arrayJSONEntriesFromListResponse:(AlfrescoListResponse *)listResponse error:(NSError **)outError
 {
-    NSDictionary *list = [AlfrescoObjectConverter listJSONFromData:data error:outError];
-    if (nil == list)
+    if (nil == listResponse.list)
     {
+        [AlfrescoObjectConverter setConversionError:outError withListResponseError:listResponse.error];
         return nil;
     }
-    id paginationObj = [list valueForKey:kAlfrescoPublicAPIJSONPagination];
-    if (![paginationObj isKindOfClass:[NSDictionary class]])
+    if (nil == listResponse.entries)
     {
-        if (nil == *outError)
-        {
-            *outError = [AlfrescoErrors alfrescoErrorWithAlfrescoErrorCode:kAlfrescoErrorCodeJSONParsing];
-        }
-        else
-        {
-            NSError *underlyingError = [AlfrescoErrors alfrescoErrorWithAlfrescoErrorCode:kAlfrescoErrorCodeJSONParsing];
-            *outError = [AlfrescoErrors alfrescoErrorWithUnderlyingError:underlyingError andAlfrescoErrorCode:kAlfrescoErrorCodeJSONParsing];
-        }
-        return nil;
+        [AlfrescoObjectConverter setConversionError:outError withListResponseError:[AlfrescoErrors alfrescoErrorWithAlfrescoErrorCode:kAlfrescoErrorCodeJSONParsing]];
     }
-    return (NSDictionary *)paginationObj;
+    return listResponse.entries;
 }
 
-
-+ (NSArray *)arrayJSONEntriesFromListData:(NSData *)data error:(NSError **)outError
++ (void)setConversionError:(NSError **)outError withListResponseError:(NSError *)error
 {
-    NSDictionary *list = [AlfrescoObjectConverter listJSONFromData:data error:outError];
-    if (nil == list)
+    if (NULL == outError)
     {
-        return nil;
+        return;
     }
-    id entries = [list valueForKey:kAlfrescoPublicAPIJSONEntries];
-    if (![entries isKindOfClass:[NSArray class]])
+    
+    if (nil == *outError)
     {
-        if (nil == *outError)
-        {
-            *outError = [AlfrescoErrors alfrescoErrorWithAlfrescoErrorCode:kAlfrescoErrorCodeJSONParsing];
-        }
-        else
-        {
-            NSError *underlyingError = [AlfrescoErrors alfrescoErrorWithAlfrescoErrorCode:kAlfrescoErrorCodeJSONParsing];
-            *outError = [AlfrescoErrors alfrescoErrorWithUnderlyingError:underlyingError andAlfrescoErrorCode:kAlfrescoErrorCodeJSONParsing];
-        }
-        return nil;
+        *outError = error;
+    }
+    else
+    {
+        *outError = [AlfrescoErrors alfrescoErrorWithUnderlyingError:error andAlfrescoErrorCode:error.code];
     }
-    NSArray *entriesArray = [NSArray arrayWithArray:entries];
-    return entriesArray;
 }
 
 
@@ -239,34 +190,29 @@
 }
 
 + (id)parseJSONData:(NSData *)jsonData notFoundErrorCode:(AlfrescoErrorCodes)errorCode parseBlock:(id (^)(id jsonObject, NSError *parseError))parseBlock
+{
+    return [self parseListResponse:[[AlfrescoListResponse alloc] initWithData:jsonData] notFoundErrorCode:errorCode parseBlock:parseBlock];
+}
+
++ (id)parseListResponse:(AlfrescoListResponse *)listResponse notFoundErrorCode:(AlfrescoErrorCodes)errorCode parseBlock:(id (^)(id jsonObject, NSError *parseError))parseBlock
 {
     NSError *conversionError = nil;
     
-    if (jsonData == nil)
+    if (nil == listResponse.JSONObject && nil == listResponse.parseError)
     {
-        if (conversionError == nil)
-        {
-            conversionError = [AlfrescoErrors alfrescoErrorWithAlfrescoErrorCode:kAlfrescoErrorCodeJSONParsingNilData];
-            return parseBlock(nil, conversionError);
-        }
-        else
-        {
-            NSError *error = [AlfrescoErrors alfrescoErrorWithAlfrescoErrorCode:kAlfrescoErrorCodeJSONParsingNilData];
-            conversionError = [AlfrescoErrors alfrescoErrorWithUnderlyingError:error andAlfrescoErrorCode:kAlfrescoErrorCodeJSONParsingNilData];
-            return parseBlock(nil, conversionError);
-        }
+        conversionError = [AlfrescoErrors alfrescoErrorWithAlfrescoErrorCode:kAlfrescoErrorCodeJSONParsingNilData];
+        return parseBlock(nil, conversionError);
     }
     
-    NSError *parseError = nil;
-    id jsonResponseObject = [NSJSONSerialization JSONObjectWithData:jsonData options:0 error:&parseError];
-    if (parseError)
+    id jsonResponseObject = listResponse.JSONObject;
+    if (listResponse.parseError)
     {
-        conversionError = [AlfrescoErrors alfrescoErrorWithUnderlyingError:parseError andAlfrescoErrorCode:errorCode];
+        conversionError = [AlfrescoErrors alfrescoErrorWithUnderlyingError:listResponse.parseError andAlfrescoErrorCode:errorCode];
         return parseBlock(jsonResponseObject, conversionError);
     }
     if ([[jsonResponseObject valueForKeyPath:kAlfrescoJSONStatusCode] isEqualToNumber:@404])
     {
-        conversionError = [AlfrescoErrors alfrescoErrorWithUnderlyingError:parseError andAlfrescoErrorCode:errorCode];
+        conversionError = [AlfrescoErrors alfrescoErrorWithUnderlyingError:listResponse.parseError andAlfrescoErrorCode:errorCode];
         return parseBlock(jsonResponseObject, conversionError);
     }
     
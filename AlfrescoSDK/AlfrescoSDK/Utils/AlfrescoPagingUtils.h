@@ -35,4 +35,15 @@
 
 + (AlfrescoPagingResult *) pagedResultFromArray:(NSArray *)nonPagedArray listingContext:(AlfrescoListingContext *) listingContext;
 
+/**
+ For listings the server can't page. Returns the requested page from the result set cached by an earlier page of the same listing,
+ or nil if it has to be fetched. The first page is always fetched so changes show up when a listing is reloaded.
+ */
++ (AlfrescoPagingResult *) pagedResultFromCachedListing:(NSString *)listing listingContext:(AlfrescoListingContext *)listingContext session:(id<AlfrescoSession>)session;
+
+/**
+ Returns the requested page of the complete result set, which is cached for the following pages if the listing is paged.
+ */
++ (AlfrescoPagingResult *) pagedResultFromArray:(NSArray *)nonPagedArray listingContext:(AlfrescoListingContext *)listingContext cachingListing:(NSString *)listing session:(id<AlfrescoSession>)session;
+
 @end
@@ -20,6 +20,8 @@
 #import "CMISQueryResult.h"
 #import "CMISOperationContext.h"
 #import "CMISPagedResult.h"
+#import "AlfrescoListingCache.h"
+#import "AlfrescoLog.h"
 
 @implementation AlfrescoPagingUtils
 
@@ -81,4 +83,31 @@
     return pagingResult;
 }
 
++ (AlfrescoPagingResult *) pagedResultFromCachedListing:(NSString *)listing listingContext:(AlfrescoListingContext *)listingContext session:(id<AlfrescoSession>)session
+{
+    if (listingContext.skipCount <= 0)
+    {
+        return nil;
+    }
+    
+    NSArray *cachedObjects = [[AlfrescoListingCache listingCacheForSession:session] objectsForListing:listing listingContext:listingContext];
+    if (nil == cachedObjects)
+    {
+        return nil;
+    }
+    
+    AlfrescoLogDebug(@"Cache hit: returning page of %@ from cache", listing);
+    return [self pagedResultFromArray:cachedObjects listingContext:listingContext];
+}
+
++ (AlfrescoPagingResult *) pagedResultFromArray:(NSArray *)nonPagedArray listingContext:(AlfrescoListingContext *)listingContext cachingListing:(NSString *)listing session:(id<AlfrescoSession>)session
+{
+    // an unpaged listing returns everything at once, so there are no further pages to cache the result set for
+    if (listingContext.maxItems > 0)
+    {
+        [[AlfrescoListingCache listingCacheForSession:session] cacheObjects:nonPagedArray forListing:listing listingContext:listingContext];
+    }
+    return [self pagedResultFromArray:nonPagedArray listingContext:listingContext];
+}
+
 @end
@@ -25,8 +25,24 @@
 - (void)cancel;
 @end
 
+/// Priority classes of requests, requests with higher values are more urgent
+typedef NS_ENUM(NSInteger, AlfrescoRequestPriority)
+{
+    AlfrescoRequestPriorityBackgroundSync = -2,
+    AlfrescoRequestPriorityPrefetch = -1,
+    AlfrescoRequestPriorityDefault = 0,
+    AlfrescoRequestPriorityUserInteractive = 1
+};
+
 @interface AlfrescoRequest : NSObject
 @property (nonatomic, readonly, getter = isCancelled) BOOL cancelled;
 @property (nonatomic, strong) id httpRequest;
+/// The service class and method the request was created by, e.g. "AlfrescoVersionService retrieveAllVersionsOfDocument:completionBlock:", nil if unknown.
+@property (nonatomic, strong, readonly) NSString *operationName;
+/// The priority of the network requests made for the request, can be changed while they are in flight e.g. when the item being loaded scrolls off screen.
+@property (nonatomic, assign) AlfrescoRequestPriority priority;
+
+/// Initialises a request made by the given service method, the operation is attached to the metrics of the underlying network requests.
+- (id)initWithService:(id)service operation:(SEL)operation;
 - (void)cancel;
 @end
@@ -19,9 +19,15 @@
  */
 
 #import "AlfrescoRequest.h"
+#import "AlfrescoDefaultHTTPRequest.h"
+#import "AlfrescoRequestGroup.h"
+#import "CMISRequest.h"
+#import "CMISRequestMetrics.h"
 
 @interface AlfrescoRequest()
 @property (nonatomic, getter = isCancelled) BOOL cancelled;
+@property (nonatomic, assign) Class serviceClass;
+@property (nonatomic, assign) SEL operation;
 @end
 
 @implementation AlfrescoRequest
@@ -35,6 +41,27 @@
     return self;
 }
 
+- (id)initWithService:(id)service operation:(SEL)operation
+{
+    self = [self init];
+    if (nil != self)
+    {
+        // the name is only built once the request is handed an HTTP request
+        self.serviceClass = [service class];
+        self.operation = operation;
+    }
+    return self;
+}
+
+- (NSString *)operationName
+{
+    if (NULL == self.operation)
+    {
+        return nil;
+    }
+    return [NSString stringWithFormat:@"%@ %@", NSStringFromClass(self.serviceClass), NSStringFromSelector(self.operation)];
+}
+
 - (void)cancel
 {
     self.cancelled = YES;
@@ -45,9 +72,20 @@
 }
 
 
+- (void)setPriority:(AlfrescoRequestPriority)priority
+{
+    _priority = priority;
+    [self applyPriorityToHTTPRequest:self.httpRequest];
+}
+
 - (void)setHttpRequest:(id)httpRequest
 {
     _httpRequest = httpRequest;
+    [self tagMetricsOfHTTPRequest:httpRequest];
+    if (AlfrescoRequestPriorityDefault != self.priority)
+    {
+        [self applyPriorityToHTTPRequest:httpRequest];
+    }
     if (self.isCancelled)
     {
         if ([httpRequest respondsToSelector:@selector(cancel)])
@@ -56,4 +94,51 @@
         }
     }
 }
+
+- (void)applyPriorityToHTTPRequest:(id)httpRequest
+{
+    if ([httpRequest isKindOfClass:[CMISRequest class]])
+    {
+        ((CMISRequest *)httpRequest).priority = (CMISRequestPriority)self.priority;
+    }
+    else if ([httpRequest isKindOfClass:[AlfrescoDefaultHTTPRequest class]])
+    {
+        ((AlfrescoDefaultHTTPRequest *)httpRequest).priority = self.priority;
+    }
+    else if ([httpRequest isKindOfClass:[AlfrescoRequestGroup class]])
+    {
+        ((AlfrescoRequestGroup *)httpRequest).priority = self.priority;
+    }
+    else if ([httpRequest isKindOfClass:[AlfrescoRequest class]] && httpRequest != self)
+    {
+        ((AlfrescoRequest *)httpRequest).priority = self.priority;
+    }
+}
+
+- (void)tagMetricsOfHTTPRequest:(id)httpRequest
+{
+    if (NULL == self.operation)
+    {
+        return;
+    }
+    
+    if ([httpRequest isKindOfClass:[CMISRequest class]])
+    {
+        // the CMIS request may not have started its HTTP request yet, it names the requests it goes on to make
+        CMISRequest *cmisRequest = httpRequest;
+        if (nil == cmisRequest.operationName)
+        {
+            cmisRequest.operationName = self.operationName;
+        }
+    }
+    else if ([httpRequest isKindOfClass:[AlfrescoDefaultHTTPRequest class]])
+    {
+        CMISRequestMetrics *metrics = [httpRequest metrics];
+        if (nil != metrics && nil == metrics.operationName)
+        {
+            metrics.operationName = self.operationName;
+        }
+    }
+}
+
 @end
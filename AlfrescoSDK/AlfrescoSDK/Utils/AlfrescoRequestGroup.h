@@ -0,0 +1,43 @@
+/*
+ ******************************************************************************
+ * Copyright (C) 2005-2020 Alfresco Software Limited.
+ *
+ * This file is part of the Alfresco Mobile SDK.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *****************************************************************************
+ */
+
+/** AlfrescoRequestGroup
+ 
+ Used as the httpRequest of an AlfrescoRequest that fans out into several requests,
+ cancelling the group cancels every request added to it, including those added after
+ the group was cancelled. Changing the priority of the group changes it for every request in it.
+ */
+
+#import <Foundation/Foundation.h>
+#import "AlfrescoRequest.h"
+
+@interface AlfrescoRequestGroup : NSObject <AlfrescoCancellableRequest>
+
+@property (nonatomic, assign, readonly, getter = isCancelled) BOOL cancelled;
+/// The priority applied to the requests in the group, requests added later take it on as well.
+@property (nonatomic, assign) AlfrescoRequestPriority priority;
+
+/// Adds a request to the group, the request is cancelled straight away if the group already is.
+- (void)addRequest:(AlfrescoRequest *)request;
+
+/// Removes a request once it has completed so the group does not hold on to it.
+- (void)removeRequest:(AlfrescoRequest *)request;
+
+@end
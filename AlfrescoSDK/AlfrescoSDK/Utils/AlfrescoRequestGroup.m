@@ -0,0 +1,105 @@
+/*
+ ******************************************************************************
+ * Copyright (C) 2005-2020 Alfresco Software Limited.
+ *
+ * This file is part of the Alfresco Mobile SDK.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *****************************************************************************
+ */
+
+#import "AlfrescoRequestGroup.h"
+
+@interface AlfrescoRequestGroup ()
+@property (nonatomic, assign, readwrite, getter = isCancelled) BOOL cancelled;
+@property (nonatomic, strong) NSMutableArray *requests;
+@end
+
+@implementation AlfrescoRequestGroup
+
+- (id)init
+{
+    self = [super init];
+    if (nil != self)
+    {
+        self.cancelled = NO;
+        self.requests = [NSMutableArray array];
+    }
+    return self;
+}
+
+- (void)addRequest:(AlfrescoRequest *)request
+{
+    BOOL cancelled = NO;
+    @synchronized(self)
+    {
+        cancelled = self.isCancelled;
+        if (!cancelled)
+        {
+            [self.requests addObject:request];
+        }
+    }
+    
+    if (cancelled)
+    {
+        [request cancel];
+    }
+    else if (AlfrescoRequestPriorityDefault != self.priority)
+    {
+        request.priority = self.priority;
+    }
+}
+
+- (void)setPriority:(AlfrescoRequestPriority)priority
+{
+    NSArray *requests = nil;
+    @synchronized(self)
+    {
+        _priority = priority;
+        requests = [self.requests copy];
+    }
+    
+    for (AlfrescoRequest *request in requests)
+    {
+        request.priority = priority;
+    }
+}
+
+- (void)removeRequest:(AlfrescoRequest *)request
+{
+    @synchronized(self)
+    {
+        [self.requests removeObjectIdenticalTo:request];
+    }
+}
+
+#pragma mark AlfrescoCancellableRequest method
+
+- (void)cancel
+{
+    NSArray *requests = nil;
+    @synchronized(self)
+    {
+        self.cancelled = YES;
+        requests = [self.requests copy];
+        [self.requests removeAllObjects];
+    }
+    
+    // cancel outside of the lock as completion blocks may call back into the group
+    for (AlfrescoRequest *request in requests)
+    {
+        [request cancel];
+    }
+}
+
+@end
@@ -0,0 +1,89 @@
+/*
+ ******************************************************************************
+ * Copyright (C) 2005-2020 Alfresco Software Limited.
+ * 
+ * This file is part of the Alfresco Mobile SDK.
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *  
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *****************************************************************************
+ */
+
+#import <Foundation/Foundation.h>
+
+@class CMISRequestMetrics;
+@class AlfrescoRequestMetrics;
+
+/** The AlfrescoRequestMetricsObserver protocol is implemented by objects that want to receive the metrics of every network request
+ made by a session, it is set using the kAlfrescoRequestMetricsObserver session parameter. When no observer is set no metrics are collected.
+ 
+ Methods may be called on any thread and should return quickly.
+ */
+@protocol AlfrescoRequestMetricsObserver <NSObject>
+
+/// Called once a request has completed and its completion block has returned.
+- (void)requestDidFinishWithMetrics:(AlfrescoRequestMetrics *)metrics;
+
+@optional
+
+/// Called just before a request is sent.
+- (void)requestWillStartWithMetrics:(AlfrescoRequestMetrics *)metrics;
+
+@end
+
+
+/** The AlfrescoRequestMetrics class holds the timings, sizes and outcome of a single network request.
+ */
+@interface AlfrescoRequestMetrics : NSObject
+
+/// The URL and HTTP method of the request.
+@property (nonatomic, strong, readonly) NSURL *url;
+@property (nonatomic, strong, readonly) NSString *httpMethod;
+
+/// The service class and method that caused the request, see AlfrescoRequest, nil if not known.
+@property (nonatomic, strong, readonly) NSString *operationName;
+
+/// When the request was created, sent and completed.
+@property (nonatomic, strong, readonly) NSDate *enqueueDate;
+@property (nonatomic, strong, readonly) NSDate *startDate;
+@property (nonatomic, strong, readonly) NSDate *endDate;
+
+/// Time spent resolving the host name, connecting, negotiating TLS, waiting for the server and receiving the body.
+/// These are only available on iOS 10 and OS X 10.12 onwards, otherwise they are 0.
+@property (nonatomic, assign, readonly) NSTimeInterval domainLookupDuration;
+@property (nonatomic, assign, readonly) NSTimeInterval connectDuration;
+@property (nonatomic, assign, readonly) NSTimeInterval secureConnectionDuration;
+@property (nonatomic, assign, readonly) NSTimeInterval waitDuration;
+@property (nonatomic, assign, readonly) NSTimeInterval responseDuration;
+@property (nonatomic, assign, readonly) BOOL reusedConnection;
+
+/// Time spent parsing the response and converting it to model objects.
+@property (nonatomic, assign, readonly) NSTimeInterval processingDuration;
+
+/// Time from the request being created until the response was processed.
+@property (nonatomic, assign, readonly) NSTimeInterval totalDuration;
+
+@property (nonatomic, assign, readonly) NSInteger statusCode;
+@property (nonatomic, assign, readonly) long long bytesSent;
+@property (nonatomic, assign, readonly) long long bytesReceived;
+/// Size of the response body as transferred, i.e. before it was decompressed, only available from iOS 13, otherwise 0.
+@property (nonatomic, assign, readonly) long long encodedBytesReceived;
+/// YES when the server answered with 304 Not Modified and the response was taken from the session's response cache.
+@property (nonatomic, assign, readonly) BOOL notModified;
+@property (nonatomic, assign, readonly) NSUInteger retryCount;
+/// Time spent waiting between attempts when the request was retried.
+@property (nonatomic, assign, readonly) NSTimeInterval retryWaitDuration;
+@property (nonatomic, strong, readonly) NSError *error;
+
+- (id)initWithCMISRequestMetrics:(CMISRequestMetrics *)metrics;
+
+@end
@@ -0,0 +1,89 @@
+/*
+ ******************************************************************************
+ * Copyright (C) 2005-2020 Alfresco Software Limited.
+ * 
+ * This file is part of the Alfresco Mobile SDK.
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *  
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *****************************************************************************
+ */
+
+#import "AlfrescoRequestMetrics.h"
+#import "CMISRequestMetrics.h"
+
+@interface AlfrescoRequestMetrics ()
+@property (nonatomic, strong, readwrite) NSURL *url;
+@property (nonatomic, strong, readwrite) NSString *httpMethod;
+@property (nonatomic, strong, readwrite) NSString *operationName;
+@property (nonatomic, strong, readwrite) NSDate *enqueueDate;
+@property (nonatomic, strong, readwrite) NSDate *startDate;
+@property (nonatomic, strong, readwrite) NSDate *endDate;
+@property (nonatomic, assign, readwrite) NSTimeInterval domainLookupDuration;
+@property (nonatomic, assign, readwrite) NSTimeInterval connectDuration;
+@property (nonatomic, assign, readwrite) NSTimeInterval secureConnectionDuration;
+@property (nonatomic, assign, readwrite) NSTimeInterval waitDuration;
+@property (nonatomic, assign, readwrite) NSTimeInterval responseDuration;
+@property (nonatomic, assign, readwrite) BOOL reusedConnection;
+@property (nonatomic, assign, readwrite) NSTimeInterval processingDuration;
+@property (nonatomic, assign, readwrite) NSTimeInterval totalDuration;
+@property (nonatomic, assign, readwrite) NSInteger statusCode;
+@property (nonatomic, assign, readwrite) long long bytesSent;
+@property (nonatomic, assign, readwrite) long long bytesReceived;
+@property (nonatomic, assign, readwrite) long long encodedBytesReceived;
+@property (nonatomic, assign, readwrite) BOOL notModified;
+@property (nonatomic, assign, readwrite) NSUInteger retryCount;
+@property (nonatomic, assign, readwrite) NSTimeInterval retryWaitDuration;
+@property (nonatomic, strong, readwrite) NSError *error;
+@end
+
+@implementation AlfrescoRequestMetrics
+
+- (id)initWithCMISRequestMetrics:(CMISRequestMetrics *)metrics
+{
+    self = [super init];
+    if (nil != self)
+    {
+        self.url = metrics.url;
+        self.httpMethod = metrics.httpMethod;
+        self.operationName = metrics.operationName;
+        self.enqueueDate = metrics.enqueueDate;
+        self.startDate = metrics.startDate;
+        self.endDate = metrics.endDate;
+        self.domainLookupDuration = metrics.domainLookupDuration;
+        self.connectDuration = metrics.connectDuration;
+        self.secureConnectionDuration = metrics.secureConnectionDuration;
+        self.waitDuration = metrics.waitDuration;
+        self.responseDuration = metrics.responseDuration;
+        self.reusedConnection = metrics.reusedConnection;
+        self.processingDuration = metrics.processingDuration;
+        self.totalDuration = metrics.totalDuration;
+        self.statusCode = metrics.statusCode;
+        self.bytesSent = metrics.bytesSent;
+        self.bytesReceived = metrics.bytesReceived;
+        self.encodedBytesReceived = metrics.encodedBytesReceived;
+        self.notModified = metrics.notModified;
+        self.retryCount = metrics.retryCount;
+        self.retryWaitDuration = metrics.retryWaitDuration;
+        self.error = metrics.error;
+    }
+    return self;
+}
+
+- (NSString *)description
+{
+    return [NSString stringWithFormat:@"%@ %@ %@ status: %ld, sent: %lld, received: %lld, total: %.3fs, wait: %.3fs, processing: %.3fs",
+            self.operationName ?: @"", self.httpMethod, self.url, (long)self.statusCode, self.bytesSent, self.bytesReceived,
+            self.totalDuration, self.waitDuration, self.processingDuration];
+}
+
+@end
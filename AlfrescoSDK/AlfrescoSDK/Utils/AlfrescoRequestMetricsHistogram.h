@@ -0,0 +1,53 @@
+/*
+ ******************************************************************************
+ * Copyright (C) 2005-2020 Alfresco Software Limited.
+ * 
+ * This file is part of the Alfresco Mobile SDK.
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *  
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *****************************************************************************
+ */
+
+#import <Foundation/Foundation.h>
+#import "AlfrescoRequestMetrics.h"
+
+/** The AlfrescoRequestMetricsHistogram is an in-memory AlfrescoRequestMetricsObserver that records a histogram of request durations
+ per operation, it can be set as the kAlfrescoRequestMetricsObserver session parameter to see where time goes in an app.
+ 
+ Requests without an operation name are recorded against the "unknown" operation. Passing nil as the operation name to the
+ query methods returns the figures for all requests.
+ */
+@interface AlfrescoRequestMetricsHistogram : NSObject <AlfrescoRequestMetricsObserver>
+
+/// Returns the names of the operations requests were recorded for.
+- (NSArray *)operationNames;
+
+/// Returns the number of requests recorded for the operation.
+- (NSUInteger)requestCountForOperation:(NSString *)operationName;
+
+/// Returns the number of requests recorded for the operation that failed.
+- (NSUInteger)errorCountForOperation:(NSString *)operationName;
+
+/// Returns the number of bytes received by the requests recorded for the operation.
+- (long long)bytesReceivedForOperation:(NSString *)operationName;
+
+/// Returns the upper bound of the histogram bucket the given percentile (0 - 100) of total durations falls into, 0 if no requests were recorded.
+- (NSTimeInterval)durationAtPercentile:(double)percentile forOperation:(NSString *)operationName;
+
+/// Returns the average time spent parsing and converting the responses of the operation.
+- (NSTimeInterval)averageProcessingDurationForOperation:(NSString *)operationName;
+
+/// Removes everything recorded so far.
+- (void)reset;
+
+@end
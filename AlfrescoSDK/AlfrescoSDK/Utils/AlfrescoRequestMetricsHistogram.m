@@ -0,0 +1,208 @@
+/*
+ ******************************************************************************
+ * Copyright (C) 2005-2020 Alfresco Software Limited.
+ * 
+ * This file is part of the Alfresco Mobile SDK.
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *  
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *****************************************************************************
+ */
+
+#import "AlfrescoRequestMetricsHistogram.h"
+
+static NSString * const kAlfrescoRequestMetricsUnknownOperation = @"unknown";
+
+// upper bounds of the buckets in seconds, the last bucket holds everything slower
+static const NSTimeInterval kAlfrescoRequestMetricsBucketBounds[] = {0.005, 0.01, 0.025, 0.05, 0.1, 0.25, 0.5, 1, 2.5, 5, 10, 30};
+#define kAlfrescoRequestMetricsBucketCount (sizeof(kAlfrescoRequestMetricsBucketBounds) / sizeof(NSTimeInterval) + 1)
+
+@interface AlfrescoRequestMetricsOperationHistogram : NSObject
+{
+@public
+    NSUInteger buckets[kAlfrescoRequestMetricsBucketCount];
+    NSUInteger requestCount;
+    NSUInteger errorCount;
+    long long bytesReceived;
+    NSTimeInterval processingDuration;
+}
+- (void)addMetrics:(AlfrescoRequestMetrics *)metrics;
+- (void)addHistogram:(AlfrescoRequestMetricsOperationHistogram *)histogram;
+@end
+
+@implementation AlfrescoRequestMetricsOperationHistogram
+
+- (void)addMetrics:(AlfrescoRequestMetrics *)metrics
+{
+    NSUInteger bucket = 0;
+    while (bucket < kAlfrescoRequestMetricsBucketCount - 1 && metrics.totalDuration > kAlfrescoRequestMetricsBucketBounds[bucket])
+    {
+        bucket++;
+    }
+    buckets[bucket]++;
+    requestCount++;
+    if (nil != metrics.error)
+    {
+        errorCount++;
+    }
+    bytesReceived += metrics.bytesReceived;
+    processingDuration += metrics.processingDuration;
+}
+
+- (void)addHistogram:(AlfrescoRequestMetricsOperationHistogram *)histogram
+{
+    for (NSUInteger bucket = 0; bucket < kAlfrescoRequestMetricsBucketCount; bucket++)
+    {
+        buckets[bucket] += histogram->buckets[bucket];
+    }
+    requestCount += histogram->requestCount;
+    errorCount += histogram->errorCount;
+    bytesReceived += histogram->bytesReceived;
+    processingDuration += histogram->processingDuration;
+}
+
+@end
+
+@interface AlfrescoRequestMetricsHistogram ()
+@property (nonatomic, strong) NSMutableDictionary *histograms;
+@end
+
+@implementation AlfrescoRequestMetricsHistogram
+
+- (id)init
+{
+    self = [super init];
+    if (nil != self)
+    {
+        self.histograms = [NSMutableDictionary dictionary];
+    }
+    return self;
+}
+
+#pragma mark - AlfrescoRequestMetricsObserver
+
+- (void)requestDidFinishWithMetrics:(AlfrescoRequestMetrics *)metrics
+{
+    NSString *operationName = metrics.operationName ?: kAlfrescoRequestMetricsUnknownOperation;
+    @synchronized(self)
+    {
+        AlfrescoRequestMetricsOperationHistogram *histogram = self.histograms[operationName];
+        if (nil == histogram)
+        {
+            histogram = [AlfrescoRequestMetricsOperationHistogram new];
+            self.histograms[operationName] = histogram;
+        }
+        [histogram addMetrics:metrics];
+    }
+}
+
+#pragma mark - Queries
+
+- (NSArray *)operationNames
+{
+    @synchronized(self)
+    {
+        return [self.histograms.allKeys sortedArrayUsingSelector:@selector(compare:)];
+    }
+}
+
+- (NSUInteger)requestCountForOperation:(NSString *)operationName
+{
+    return [self histogramForOperation:operationName]->requestCount;
+}
+
+- (NSUInteger)errorCountForOperation:(NSString *)operationName
+{
+    return [self histogramForOperation:operationName]->errorCount;
+}
+
+- (long long)bytesReceivedForOperation:(NSString *)operationName
+{
+    return [self histogramForOperation:operationName]->bytesReceived;
+}
+
+- (NSTimeInterval)durationAtPercentile:(double)percentile forOperation:(NSString *)operationName
+{
+    AlfrescoRequestMetricsOperationHistogram *histogram = [self histogramForOperation:operationName];
+    if (0 == histogram->requestCount)
+    {
+        return 0;
+    }
+    
+    double rank = MIN(MAX(percentile, 0), 100) / 100.0 * histogram->requestCount;
+    NSUInteger seen = 0;
+    for (NSUInteger bucket = 0; bucket < kAlfrescoRequestMetricsBucketCount - 1; bucket++)
+    {
+        seen += histogram->buckets[bucket];
+        if (seen >= rank && seen > 0)
+        {
+            return kAlfrescoRequestMetricsBucketBounds[bucket];
+        }
+    }
+    return INFINITY;
+}
+
+- (NSTimeInterval)averageProcessingDurationForOperation:(NSString *)operationName
+{
+    AlfrescoRequestMetricsOperationHistogram *histogram = [self histogramForOperation:operationName];
+    return (0 == histogram->requestCount) ? 0 : histogram->processingDuration / histogram->requestCount;
+}
+
+- (void)reset
+{
+    @synchronized(self)
+    {
+        [self.histograms removeAllObjects];
+    }
+}
+
+- (NSString *)description
+{
+    NSMutableString *description = [NSMutableString stringWithFormat:@"<%@: %p>", NSStringFromClass(self.class), self];
+    for (NSString *operationName in [self operationNames])
+    {
+        [description appendFormat:@"\n%@: %lu requests, %lu errors, p50 <= %.3fs, p90 <= %.3fs, p99 <= %.3fs, processing avg %.3fs",
+         operationName, (unsigned long)[self requestCountForOperation:operationName], (unsigned long)[self errorCountForOperation:operationName],
+         [self durationAtPercentile:50 forOperation:operationName], [self durationAtPercentile:90 forOperation:operationName],
+         [self durationAtPercentile:99 forOperation:operationName], [self averageProcessingDurationForOperation:operationName]];
+    }
+    return description;
+}
+
+#pragma mark - Private methods
+
+- (AlfrescoRequestMetricsOperationHistogram *)histogramForOperation:(NSString *)operationName
+{
+    // always return a copy so it can be read outside of the lock
+    AlfrescoRequestMetricsOperationHistogram *result = [AlfrescoRequestMetricsOperationHistogram new];
+    @synchronized(self)
+    {
+        if (nil == operationName)
+        {
+            for (AlfrescoRequestMetricsOperationHistogram *histogram in self.histograms.allValues)
+            {
+                [result addHistogram:histogram];
+            }
+        }
+        else
+        {
+            AlfrescoRequestMetricsOperationHistogram *histogram = self.histograms[operationName];
+            if (nil != histogram)
+            {
+                [result addHistogram:histogram];
+            }
+        }
+    }
+    return result;
+}
+
+@end
@@ -0,0 +1,49 @@
+/*
+ ******************************************************************************
+ * Copyright (C) 2005-2020 Alfresco Software Limited.
+ *
+ * This file is part of the Alfresco Mobile SDK.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *****************************************************************************
+ */
+
+#import <Foundation/Foundation.h>
+#import "AlfrescoSession.h"
+
+@class CMISSessionParameters;
+
+@interface AlfrescoSessionUtils : NSObject
+
+/**
+ Returns the session data value for the key, creating and adding it with the block if there is none. The block is called at most once per
+ key, sessions that don't implement objectForParameter:createIfAbsentWithBlock: are locked while the value is looked up and created.
+ */
++ (id)objectForParameter:(id)key ofSession:(id<AlfrescoSession>)session createIfAbsentWithBlock:(id (^)(void))createBlock;
+
+/**
+ Returns the queue completion blocks are called on, set with the kAlfrescoCompletionQueue session parameter, the main queue by default.
+ */
++ (dispatch_queue_t)completionQueueForSession:(id<AlfrescoSession>)session;
+
+/**
+ Returns the completion queue set in session parameters that aren't attached to a session yet, the main queue by default.
+ */
++ (dispatch_queue_t)completionQueueForParameters:(NSDictionary *)parameters;
+
+/**
+ Sets up the CMIS session parameters so the CMIS session calls back on the session's completion queue, if one is set.
+ */
++ (void)setupCMISSessionParameters:(CMISSessionParameters *)parameters forSession:(id<AlfrescoSession>)session;
+
+@end
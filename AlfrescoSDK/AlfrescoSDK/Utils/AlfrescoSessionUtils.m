@@ -0,0 +1,71 @@
+/*
+ ******************************************************************************
+ * Copyright (C) 2005-2020 Alfresco Software Limited.
+ *
+ * This file is part of the Alfresco Mobile SDK.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *****************************************************************************
+ */
+
+#import "AlfrescoSessionUtils.h"
+#import "AlfrescoConstants.h"
+#import "CMISSessionParameters.h"
+
+@implementation AlfrescoSessionUtils
+
++ (id)objectForParameter:(id)key ofSession:(id<AlfrescoSession>)session createIfAbsentWithBlock:(id (^)(void))createBlock
+{
+    if ([session respondsToSelector:@selector(objectForParameter:createIfAbsentWithBlock:)])
+    {
+        return [session objectForParameter:key createIfAbsentWithBlock:createBlock];
+    }
+    
+    @synchronized(session)
+    {
+        id object = [session objectForParameter:key];
+        if (nil == object)
+        {
+            object = createBlock();
+            if (nil != object)
+            {
+                [session setObject:object forParameter:key];
+            }
+        }
+        return object;
+    }
+}
+
++ (dispatch_queue_t)completionQueueForSession:(id<AlfrescoSession>)session
+{
+    dispatch_queue_t completionQueue = [session objectForParameter:kAlfrescoCompletionQueue];
+    return completionQueue ?: dispatch_get_main_queue();
+}
+
++ (dispatch_queue_t)completionQueueForParameters:(NSDictionary *)parameters
+{
+    dispatch_queue_t completionQueue = parameters[kAlfrescoCompletionQueue];
+    return completionQueue ?: dispatch_get_main_queue();
+}
+
++ (void)setupCMISSessionParameters:(CMISSessionParameters *)parameters forSession:(id<AlfrescoSession>)session
+{
+    // without a completion queue the CMIS session calls back on the thread a request was started on, normally the main thread
+    dispatch_queue_t completionQueue = [session objectForParameter:kAlfrescoCompletionQueue];
+    if (nil != completionQueue)
+    {
+        [parameters setObject:completionQueue forKey:kCMISSessionParameterCallbackQueue];
+    }
+}
+
+@end
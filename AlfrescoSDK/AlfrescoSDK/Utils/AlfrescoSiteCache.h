@@ -38,6 +38,8 @@
 @property (nonatomic, strong, readonly) NSArray *allSites;
 @property (nonatomic, assign, readonly) BOOL hasAllSites;
 @property (nonatomic, assign, readonly) int totalSiteCount;
+/// The queue buildCacheWithDelegate:completionBlock: calls back on, defaults to the main queue
+@property (nonatomic, strong) dispatch_queue_t completionQueue;
 
 
 - (AlfrescoRequest *)buildCacheWithDelegate:(id<AlfrescoSiteCacheDataDelegate>)delegate completionBlock:(AlfrescoBOOLCompletionBlock)completionBlock;
@@ -20,6 +20,8 @@
 
 #import "AlfrescoSiteCache.h"
 #import "AlfrescoLog.h"
+#import "AlfrescoErrors.h"
+#import "AlfrescoRequestGroup.h"
 
 #define TIMEOUTINTERVAL 120
 
@@ -38,8 +40,11 @@
 @property (nonatomic, strong) NSMutableArray *allSitesData;
 @property (nonatomic, strong) NSMutableDictionary *internalSiteCache;
 @property (nonatomic, strong) NSMutableArray *deferredCompletionBlocks;
+@property (nonatomic, assign) BOOL isCacheBuilding;
 @end
 
+// the cache is built on a background queue while the services read and update it from their completion blocks,
+// the site data and the caches are only accessed while synchronized on the cache
 @implementation AlfrescoSiteCache
 
 - (instancetype)init
@@ -49,6 +54,7 @@
     {
         self.isCacheBuilt = NO;
         self.deferredCompletionBlocks = [NSMutableArray new];
+        self.completionQueue = dispatch_get_main_queue();
     }
     return self;
 }
@@ -58,31 +64,46 @@
 - (NSArray *)memberSites
 {
     NSPredicate *memberPredicate = [NSPredicate predicateWithFormat:@"isMember == YES"];
-    return [[self.internalSiteCache allValues]  filteredArrayUsingPredicate:memberPredicate];
+    @synchronized(self)
+    {
+        return [[self.internalSiteCache allValues]  filteredArrayUsingPredicate:memberPredicate];
+    }
 }
 
 - (NSArray *)pendingSites
 {
     NSPredicate *pendingPredicate = [NSPredicate predicateWithFormat:@"isPendingMember == YES"];
-    return [[self.internalSiteCache allValues] filteredArrayUsingPredicate:pendingPredicate];
+    @synchronized(self)
+    {
+        return [[self.internalSiteCache allValues] filteredArrayUsingPredicate:pendingPredicate];
+    }
 }
 
 - (NSArray *)favoriteSites
 {
     NSPredicate *favoritePredicate = [NSPredicate predicateWithFormat:@"isFavorite == YES"];
-    return [[self.internalSiteCache allValues] filteredArrayUsingPredicate:favoritePredicate];
+    @synchronized(self)
+    {
+        return [[self.internalSiteCache allValues] filteredArrayUsingPredicate:favoritePredicate];
+    }
 }
 
 - (NSArray *)allSites
 {
-    NSMutableArray *arrayWithNoNullValues = self.allSitesData.mutableCopy;
-    [arrayWithNoNullValues removeObjectIdenticalTo:[NSNull null]];
-    return [NSArray arrayWithArray:arrayWithNoNullValues];
+    @synchronized(self)
+    {
+        NSMutableArray *arrayWithNoNullValues = self.allSitesData.mutableCopy;
+        [arrayWithNoNullValues removeObjectIdenticalTo:[NSNull null]];
+        return [NSArray arrayWithArray:arrayWithNoNullValues];
+    }
 }
 
 - (BOOL)hasAllSites
 {
-    return ![self.allSitesData containsObject:[NSNull null]] && self.allSitesData.count > 0;
+    @synchronized(self)
+    {
+        return ![self.allSitesData containsObject:[NSNull null]] && self.allSitesData.count > 0;
+    }
 }
 
 #pragma mark - Private Methods
@@ -91,28 +112,55 @@
 {
     // start the daisy chained methods to collect all the data required to build the initial caches
     AlfrescoLogDebug(@"Requesting member site data from delegate");
-    AlfrescoRequest *request = [AlfrescoRequest new];
-    request = [delegate retrieveMemberSiteDataWithCompletionBlock:^(NSArray *memberData, NSError *error) {
-        if (memberData != nil)
+    AlfrescoRequest *request = [[AlfrescoRequest alloc] initWithService:self operation:_cmd];
+    
+    // every request of the chain joins the group, cancelling the request cancels whichever of them is in flight
+    AlfrescoRequestGroup *requestGroup = [AlfrescoRequestGroup new];
+    request.httpRequest = requestGroup;
+    
+    AlfrescoRequest *memberRequest = [delegate retrieveMemberSiteDataWithCompletionBlock:^(NSArray *memberData, NSError *error) {
+        if (memberData != nil && request.isCancelled)
+        {
+            // don't carry on down the chain once the caller has cancelled
+            completionBlock(NO, [AlfrescoErrors alfrescoErrorWithAlfrescoErrorCode:kAlfrescoErrorCodeNetworkRequestCancelled]);
+        }
+        else if (memberData != nil)
         {
             // store member site data
-            self.memberSiteData = [NSMutableArray arrayWithArray:memberData];
+            @synchronized(self)
+            {
+                self.memberSiteData = [NSMutableArray arrayWithArray:memberData];
+            }
             
             // get favorite data
             AlfrescoLogDebug(@"Requesting favorite site data from delegate");
             AlfrescoRequest *favoritesRequest = [delegate retrieveFavoriteSiteDataWithCompletionBlock:^(NSArray *favoriteData, NSError *error) {
-                if (favoriteData != nil)
+                if (favoriteData != nil && request.isCancelled)
+                {
+                    completionBlock(NO, [AlfrescoErrors alfrescoErrorWithAlfrescoErrorCode:kAlfrescoErrorCodeNetworkRequestCancelled]);
+                }
+                else if (favoriteData != nil)
                 {
                     // store favorite site data
-                    self.favoriteSiteData = [NSMutableArray arrayWithArray:favoriteData];
+                    @synchronized(self)
+                    {
+                        self.favoriteSiteData = [NSMutableArray arrayWithArray:favoriteData];
+                    }
                     
                     // get pending data
                     AlfrescoLogDebug(@"Requesting pending site data from delegate");
                     AlfrescoRequest *pendingRequest = [delegate retrievePendingSiteDataWithCompletionBlock:^(NSArray *pendingData, NSError *error) {
-                        if (pendingData != nil)
+                        if (pendingData != nil && request.isCancelled)
+                        {
+                            completionBlock(NO, [AlfrescoErrors alfrescoErrorWithAlfrescoErrorCode:kAlfrescoErrorCodeNetworkRequestCancelled]);
+                        }
+                        else if (pendingData != nil)
                         {
                             // store the pending data
-                            self.pendingSiteData = [NSMutableArray arrayWithArray:pendingData];
+                            @synchronized(self)
+                            {
+                                self.pendingSiteData = [NSMutableArray arrayWithArray:pendingData];
+                            }
                             
                             // process the data
                             [self processCacheDataWithDelegate:delegate completionBlock:completionBlock];
@@ -122,22 +170,30 @@
                             completionBlock(NO, error);
                         }
                     }];
-                    
-                    request.httpRequest = pendingRequest.httpRequest;
+                    if (nil != pendingRequest)
+                    {
+                        [requestGroup addRequest:pendingRequest];
+                    }
                 }
                 else
                 {
                     completionBlock(NO, error);
                 }
             }];
-            
-            request.httpRequest = favoritesRequest.httpRequest;
+            if (nil != favoritesRequest)
+            {
+                [requestGroup addRequest:favoritesRequest];
+            }
         }
         else
         {
             completionBlock(NO, error);
         }
     }];
+    if (nil != memberRequest)
+    {
+        [requestGroup addRequest:memberRequest];
+    }
     
     return request;
 }
@@ -148,83 +204,92 @@
     // so move all this off the main thread
     dispatch_async(dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
         NSMutableArray *namesOfMissingSites = [NSMutableArray array];
+        NSArray *favoriteSiteData = nil;
+        NSArray *pendingSiteData = nil;
         
-        self.internalSiteCache = [NSMutableDictionary dictionary];
-        
-        // add sites the user is a member of to the internal cache with member flag set
-        for (AlfrescoSite *site in self.memberSiteData)
+        @synchronized(self)
         {
-            [self cacheSite:site member:YES pending:NO favorite:NO];
-        }
-        
-        // determine what form the favorite data is (onprem will be site names, public api will be site objects)
-        if (self.favoriteSiteData.count > 0)
-        {
-            // retrieve first object to get type
-            id firstObj = self.favoriteSiteData.firstObject;
-            if ([firstObj isKindOfClass:[AlfrescoSite class]])
+            self.internalSiteCache = [NSMutableDictionary dictionary];
+            
+            // add sites the user is a member of to the internal cache with member flag set
+            for (AlfrescoSite *site in self.memberSiteData)
             {
-                for (AlfrescoSite *site in self.favoriteSiteData)
-                {
-                    AlfrescoSite *cachedSite = (self.internalSiteCache)[site.shortName];
-                    if (cachedSite != nil)
-                    {
-                        // if site is already cached just update favorite flag
-                        [self updateFavoriteStateForSite:cachedSite state:YES];
-                    }
-                    else
-                    {
-                        // add the site to the cache marked as a favorite
-                        [self cacheSite:site member:NO pending:NO favorite:YES];
-                    }
-                }
+                [self cacheSite:site member:YES pending:NO favorite:NO];
             }
-            else
+            
+            // determine what form the favorite data is (onprem will be site names, public api will be site objects)
+            if (self.favoriteSiteData.count > 0)
             {
-                for (NSString *siteShortName in self.favoriteSiteData)
+                // retrieve first object to get type
+                id firstObj = self.favoriteSiteData.firstObject;
+                if ([firstObj isKindOfClass:[AlfrescoSite class]])
                 {
-                    AlfrescoSite *cachedSite = (self.internalSiteCache)[siteShortName];
-                    if (cachedSite != nil)
+                    for (AlfrescoSite *site in self.favoriteSiteData)
                     {
-                        // if site is already cached just update favorite flag
-                        [self updateFavoriteStateForSite:cachedSite state:YES];
+                        AlfrescoSite *cachedSite = (self.internalSiteCache)[site.shortName];
+                        if (cachedSite != nil)
+                        {
+                            // if site is already cached just update favorite flag
+                            [self updateFavoriteStateForSite:cachedSite state:YES];
+                        }
+                        else
+                        {
+                            // add the site to the cache marked as a favorite
+                            [self cacheSite:site member:NO pending:NO favorite:YES];
+                        }
                     }
-                    else
+                }
+                else
+                {
+                    for (NSString *siteShortName in self.favoriteSiteData)
                     {
-                        // add site to list to retrieve individually
-                        [namesOfMissingSites addObject:siteShortName];
+                        AlfrescoSite *cachedSite = (self.internalSiteCache)[siteShortName];
+                        if (cachedSite != nil)
+                        {
+                            // if site is already cached just update favorite flag
+                            [self updateFavoriteStateForSite:cachedSite state:YES];
+                        }
+                        else
+                        {
+                            // add site to list to retrieve individually
+                            [namesOfMissingSites addObject:siteShortName];
+                        }
                     }
                 }
             }
-        }
-        
-        // determine what form the pending data is (onprem will be site names, public api will be site objects)
-        if (self.pendingSiteData.count > 0)
-        {
-            // retrieve first object to get type
-            id firstObj = self.pendingSiteData.firstObject;
-            if ([firstObj isKindOfClass:[AlfrescoSite class]])
+            
+            // determine what form the pending data is (onprem will be site names, public api will be site objects)
+            if (self.pendingSiteData.count > 0)
             {
-                for (AlfrescoSite *site in self.pendingSiteData)
+                // retrieve first object to get type
+                id firstObj = self.pendingSiteData.firstObject;
+                if ([firstObj isKindOfClass:[AlfrescoSite class]])
                 {
-                    AlfrescoSite *cachedSite = (self.internalSiteCache)[site.shortName];
-                    if (cachedSite != nil)
+                    for (AlfrescoSite *site in self.pendingSiteData)
                     {
-                        // if site is already cached just update pending flag
-                        [self updatePendingStateForSite:cachedSite state:YES];
-                    }
-                    else
-                    {
-                        // add the site to the cache marked as pending
-                        [self cacheSite:site member:NO pending:YES favorite:NO];
+                        AlfrescoSite *cachedSite = (self.internalSiteCache)[site.shortName];
+                        if (cachedSite != nil)
+                        {
+                            // if site is already cached just update pending flag
+                            [self updatePendingStateForSite:cachedSite state:YES];
+                        }
+                        else
+                        {
+                            // add the site to the cache marked as pending
+                            [self cacheSite:site member:NO pending:YES favorite:NO];
+                        }
                     }
                 }
+                else
+                {
+                    // add all the pending site names to the list of sites that need fetching
+                    [namesOfMissingSites addObjectsFromArray:self.pendingSiteData];
+                }
             }
-            else
-            {
-                // add all the pending site names to the list of sites that need fetching
-                [namesOfMissingSites addObjectsFromArray:self.pendingSiteData];
-            }
+            
+            // the lock is released while this thread waits for the missing sites, the blocks caching them need it
+            favoriteSiteData = [self.favoriteSiteData copy];
+            pendingSiteData = [self.pendingSiteData copy];
         }
         
         if (namesOfMissingSites.count > 0)
@@ -246,8 +311,8 @@
                     {
                         // add site to the internal cache with appropriate state
                         [self cacheSite:site member:NO
-                                pending:[self.pendingSiteData containsObject:site.identifier]
-                               favorite:[self.favoriteSiteData containsObject:site.identifier]];
+                                pending:[pendingSiteData containsObject:site.identifier]
+                               favorite:[favoriteSiteData containsObject:site.identifier]];
                     }
                     
                     // determine whether we've finished
@@ -266,17 +331,20 @@
         }
         
         // now the caches have been built do some cleanup
-        self.isCacheBuilt = YES;
-        [self.memberSiteData removeAllObjects];
-        [self.favoriteSiteData removeAllObjects];
-        [self.pendingSiteData removeAllObjects];
+        @synchronized(self)
+        {
+            self.isCacheBuilt = YES;
+            [self.memberSiteData removeAllObjects];
+            [self.favoriteSiteData removeAllObjects];
+            [self.pendingSiteData removeAllObjects];
+        }
         
         AlfrescoLogDebug(@"Site cache successfully built on background thread");
         
-        // let the original caller know the cache is built on the main thread
+        // let the original caller know the cache is built on the completion queue
         if (completionBlock != NULL)
         {
-            dispatch_async(dispatch_get_main_queue(), ^{
+            dispatch_async(self.completionQueue, ^{
                 completionBlock(YES, nil);
             });
         }
@@ -313,114 +381,143 @@
  */
 - (void)clear
 {
-    self.isCacheBuilt = NO;
-    [self.internalSiteCache removeAllObjects];
-    // nillify to ensure the capacity is created according to number of sites
-    self.allSitesData = nil;
+    @synchronized(self)
+    {
+        self.isCacheBuilt = NO;
+        [self.internalSiteCache removeAllObjects];
+        // nillify to ensure the capacity is created according to number of sites
+        self.allSitesData = nil;
+    }
 }
 
 - (AlfrescoRequest *)buildCacheWithDelegate:(id<AlfrescoSiteCacheDataDelegate>)delegate completionBlock:(AlfrescoBOOLCompletionBlock)completionBlock;
 {
-    static BOOL isCacheBuilding = NO;
-    
-    if (completionBlock)
+    @synchronized(self)
     {
-        [self.deferredCompletionBlocks addObject:completionBlock];
-    }
-    
-    if (isCacheBuilding)
-    {
-        AlfrescoLogDebug(@"Site cache building already in progress");
-        return nil;
+        if (completionBlock)
+        {
+            [self.deferredCompletionBlocks addObject:[completionBlock copy]];
+        }
+        
+        if (self.isCacheBuilding)
+        {
+            AlfrescoLogDebug(@"Site cache building already in progress");
+            return nil;
+        }
+        self.isCacheBuilding = YES;
     }
     
     AlfrescoLogDebug(@"Building site cache");
     
-    isCacheBuilding = YES;
     return [self internalBuildCacheWithDelegate:delegate completionBlock:^(BOOL succeeded, NSError *error) {
-        for (AlfrescoBOOLCompletionBlock completionBlock in self.deferredCompletionBlocks)
+        NSArray *completionBlocks = nil;
+        @synchronized(self)
         {
-            completionBlock(succeeded, error);
+            completionBlocks = [self.deferredCompletionBlocks copy];
+            [self.deferredCompletionBlocks removeAllObjects];
+            self.isCacheBuilding = NO;
+        }
+        
+        // called outside of the lock as completion blocks may use the cache
+        for (AlfrescoBOOLCompletionBlock deferredCompletionBlock in completionBlocks)
+        {
+            deferredCompletionBlock(succeeded, error);
         }
-        [self.deferredCompletionBlocks removeAllObjects];
-        isCacheBuilding = NO;
     }];
 }
 
 - (void)cacheSite:(AlfrescoSite *)site
 {
     // add the site to the internal cache with it's current state
-    (self.internalSiteCache)[site.identifier] = site;
+    @synchronized(self)
+    {
+        (self.internalSiteCache)[site.identifier] = site;
+    }
     
     AlfrescoLogTrace(@"Cached site: %@", site.shortName);
 }
 
 - (void)cacheSite:(AlfrescoSite *)site member:(BOOL)member pending:(BOOL)pending favorite:(BOOL)favorite
 {
-    // apply the given state to the given site object
-    [self updateMemberStateForSite:site state:member];
-    [self updatePendingStateForSite:site state:pending];
-    [self updateFavoriteStateForSite:site state:favorite];
-    
-    // add the site to the internal cache
-    (self.internalSiteCache)[site.identifier] = site;
+    @synchronized(self)
+    {
+        // apply the given state to the given site object
+        [self updateMemberStateForSite:site state:member];
+        [self updatePendingStateForSite:site state:pending];
+        [self updateFavoriteStateForSite:site state:favorite];
+        
+        // add the site to the internal cache
+        (self.internalSiteCache)[site.identifier] = site;
+    }
     
     AlfrescoLogTrace(@"Cached site: %@", site.shortName);
 }
 
 - (AlfrescoSite *)siteWithShortName:(NSString *)shortName
 {
-    return (self.internalSiteCache)[shortName];
+    @synchronized(self)
+    {
+        return (self.internalSiteCache)[shortName];
+    }
 }
 
 - (void)cacheSiteToAllSites:(AlfrescoSite *)site atIndex:(NSUInteger)index totalSites:(NSUInteger)totalSites
 {
-    if (!self.allSitesData)
+    @synchronized(self)
     {
-        self.allSitesData = [NSMutableArray array];
-        self.totalSiteCount = (int)totalSites;
+        if (!self.allSitesData)
+        {
+            self.allSitesData = [NSMutableArray array];
+            self.totalSiteCount = (int)totalSites;
+            
+            // fill array with NSNull values
+            for (int i = 0; i < totalSites; i++)
+            {
+                [self.allSitesData addObject:[NSNull null]];
+            }
+        }
         
-        // fill array with NSNull values
-        for (int i = 0; i < totalSites; i++)
+        // if the site is already cached, use that
+        if ([[self.internalSiteCache allKeys] containsObject:site.identifier])
         {
-            [self.allSitesData addObject:[NSNull null]];
+            site = self.internalSiteCache[site.identifier];
         }
+        
+        [self.allSitesData replaceObjectAtIndex:index withObject:site];
     }
-    
-    // if the site is already cached, use that
-    if ([[self.internalSiteCache allKeys] containsObject:site.identifier])
-    {
-        site = self.internalSiteCache[site.identifier];
-    }
-    
-    [self.allSitesData replaceObjectAtIndex:index withObject:site];
 }
 
 - (BOOL)shouldUseAllSitesCacheForListingContext:(AlfrescoListingContext *)listingContext
 {
-    BOOL useCache = NO;
-    
-    BOOL withinArrayBounds = listingContext.skipCount < self.allSitesData.count;
-    
-    if (self.allSitesData && withinArrayBounds == YES)
+    @synchronized(self)
     {
-        NSUInteger length = MIN(listingContext.maxItems, (self.allSitesData.count - listingContext.skipCount));
-        NSRange subArrayRange = NSMakeRange(listingContext.skipCount, length);
-        NSArray *subArray = [self.allSitesData subarrayWithRange:subArrayRange];
+        BOOL useCache = NO;
+        
+        BOOL withinArrayBounds = listingContext.skipCount < self.allSitesData.count;
+        
+        if (self.allSitesData && withinArrayBounds == YES)
+        {
+            NSUInteger length = MIN(listingContext.maxItems, (self.allSitesData.count - listingContext.skipCount));
+            NSRange subArrayRange = NSMakeRange(listingContext.skipCount, length);
+            NSArray *subArray = [self.allSitesData subarrayWithRange:subArrayRange];
+            
+            useCache = ![subArray containsObject:[NSNull null]];
+        }
         
-        useCache = ![subArray containsObject:[NSNull null]];
+        return useCache;
     }
-    
-    return useCache;
 }
 
 - (NSArray *)cachedAllSitesForListingContext:(AlfrescoListingContext *)listingContext
 {
-    NSUInteger length = MIN(listingContext.maxItems, (self.allSitesData.count - listingContext.skipCount));
-    NSRange subArrayRange = NSMakeRange(listingContext.skipCount, length);
-    NSArray *subArray = [self.allSitesData subarrayWithRange:subArrayRange];
-    
-    return subArray;
+    @synchronized(self)
+    {
+        NSUInteger length = MIN(listingContext.maxItems, (self.allSitesData.count - listingContext.skipCount));
+        NSRange subArrayRange = NSMakeRange(listingContext.skipCount, length);
+        NSArray *subArray = [self.allSitesData subarrayWithRange:subArrayRange];
+        
+        return subArray;
+    }
 }
 
 @end
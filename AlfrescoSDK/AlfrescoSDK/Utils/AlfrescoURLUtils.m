@@ -34,7 +34,7 @@
     [AlfrescoErrors assertStringArgumentNotNilOrEmpty:baseURL argumentName:@"baseURL"];
     [AlfrescoErrors assertStringArgumentNotNilOrEmpty:extensionURL argumentName:@"extensionURL"];
     
-    NSMutableString *mutableRequestString = [NSMutableString string];
+    NSMutableString *mutableRequestString = [NSMutableString stringWithCapacity:baseURL.length + extensionURL.length + kAlfrescoPublicAPIPagingParameters.length + 1];
     if ([baseURL hasSuffix:@"/"] && [extensionURL hasPrefix:@"/"])
     {
         [mutableRequestString appendString:[baseURL substringToIndex:baseURL.length - 1]];
@@ -48,42 +48,35 @@
         [mutableRequestString appendString:extensionURL];
     }
     
-    NSString *pagingExtensionString = [AlfrescoURLUtils buildPagingExtensionFromURL:extensionURL listingContext:listingContext];
-    if (nil != pagingExtensionString)
-    {
-        [mutableRequestString appendString:pagingExtensionString];
-    }
+    [AlfrescoURLUtils appendPagingExtensionToString:mutableRequestString extensionURL:extensionURL listingContext:listingContext];
     
     NSString *requestString = [mutableRequestString stringByAddingPercentEscapesUsingEncoding:NSUTF8StringEncoding];
     return [NSURL URLWithString:requestString];    
 }
 
-+ (NSString *)buildPagingExtensionFromURL:(NSString *)extensionURL listingContext:(AlfrescoListingContext *)listingContext
++ (void)appendPagingExtensionToString:(NSMutableString *)requestString extensionURL:(NSString *)extensionURL listingContext:(AlfrescoListingContext *)listingContext
 {
     if (nil == listingContext)
     {
-        return nil;
+        return;
     }
     if (listingContext.maxItems <= 0)
     {
-        return nil;
-    }
-    NSString *parameterString = nil;
-    if ([extensionURL rangeOfString:@"?"].location == NSNotFound)
-    {
-        parameterString = @"?";
+        return;
     }
-    else
-    {
-        parameterString = @"&";
-    }
-    NSString *parameterExtension = [kAlfrescoPublicAPIPagingParameters stringByReplacingOccurrencesOfString:kAlfrescoMaxItems
-                                                                                                withString:[NSString stringWithFormat:@"%d",listingContext.maxItems]];
-    
-    parameterExtension = [parameterExtension stringByReplacingOccurrencesOfString:kAlfrescoSkipCount
-                                                                       withString:[NSString stringWithFormat:@"%d", listingContext.skipCount]];
+    [requestString appendString:([extensionURL rangeOfString:@"?"].location == NSNotFound) ? @"?" : @"&"];
     
-    return [NSString stringWithFormat:@"%@%@",parameterString, parameterExtension];    
+    // fill in the paging template in place rather than building intermediate strings
+    NSUInteger templateStart = requestString.length;
+    [requestString appendString:kAlfrescoPublicAPIPagingParameters];
+    [requestString replaceOccurrencesOfString:kAlfrescoMaxItems
+                                   withString:[NSString stringWithFormat:@"%d", listingContext.maxItems]
+                                      options:NSLiteralSearch
+                                        range:NSMakeRange(templateStart, requestString.length - templateStart)];
+    [requestString replaceOccurrencesOfString:kAlfrescoSkipCount
+                                   withString:[NSString stringWithFormat:@"%d", listingContext.skipCount]
+                                      options:NSLiteralSearch
+                                        range:NSMakeRange(templateStart, requestString.length - templateStart)];
 }
 
 + (NSString *)buildQueryStringWithDictionary:(NSDictionary *)parameters
@@ -93,17 +86,17 @@
     if (parameters)
     {
         [queryString appendString:@"?"];
-        NSArray *allKeys = [parameters allKeys];
-        for (int i = 0; i < allKeys.count; i++)
-        {
-            id key = allKeys[i];
-            id value = parameters[key];
-            [queryString appendString:[NSString stringWithFormat:@"%@=%@", key, value]];
-            if (i != (allKeys.count -1))
+        __block BOOL firstParameter = YES;
+        [parameters enumerateKeysAndObjectsUsingBlock:^(id key, id value, BOOL *stop) {
+            if (!firstParameter)
             {
                 [queryString appendString:@"&"];
             }
-        }
+            [queryString appendString:[key description]];
+            [queryString appendString:@"="];
+            [queryString appendString:[value description]];
+            firstParameter = NO;
+        }];
     }
     
     return queryString;
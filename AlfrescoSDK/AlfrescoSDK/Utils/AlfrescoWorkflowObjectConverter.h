@@ -29,15 +29,18 @@
 // process definitions
 - (NSArray *)workflowDefinitionsFromLegacyJSONData:(NSData *)jsonData conversionError:(NSError **)error;
 - (NSArray *)workflowDefinitionsFromPublicJSONData:(NSData *)jsonData conversionError:(NSError **)error;
+- (NSArray *)workflowDefinitionsFromPublicListResponse:(AlfrescoListResponse *)listResponse conversionError:(NSError **)error;
 
 // processes
 - (NSArray *)workflowProcessesFromLegacyJSONData:(NSData *)jsonData conversionError:(NSError **)error;
 - (NSArray *)workflowProcessesFromPublicJSONData:(NSData *)jsonData conversionError:(NSError **)error;
+- (NSArray *)workflowProcessesFromPublicListResponse:(AlfrescoListResponse *)listResponse conversionError:(NSError **)error;
 
 // tasks
 - (NSArray *)workflowTasksFromLegacyJSONData:(NSData *)jsonData conversionError:(NSError **)error;
 - (NSArray *)workflowTasksFromLegacyJSONData:(NSData *)jsonData inState:(NSString *)state conversionError:(NSError **)error;
 - (NSArray *)workflowTasksFromPublicJSONData:(NSData *)jsonData conversionError:(NSError **)error;
+- (NSArray *)workflowTasksFromPublicListResponse:(AlfrescoListResponse *)listResponse conversionError:(NSError **)error;
 
 // variables
 + (NSString *)encodeVariableName:(NSString *)name;
@@ -67,7 +67,12 @@
 
 - (NSArray *)workflowDefinitionsFromPublicJSONData:(NSData *)jsonData conversionError:(NSError **)error
 {
-    return [[self class] parseJSONData:jsonData notFoundErrorCode:kAlfrescoErrorCodeWorkflowNoProcessDefinitionFound parseBlock:^id(id jsonObject, NSError *parseError) {
+    return [self workflowDefinitionsFromPublicListResponse:[[AlfrescoListResponse alloc] initWithData:jsonData] conversionError:error];
+}
+
+- (NSArray *)workflowDefinitionsFromPublicListResponse:(AlfrescoListResponse *)listResponse conversionError:(NSError **)error
+{
+    return [[self class] parseListResponse:listResponse notFoundErrorCode:kAlfrescoErrorCodeWorkflowNoProcessDefinitionFound parseBlock:^id(id jsonObject, NSError *parseError) {
         if (parseError)
         {
             *error = parseError;
@@ -120,7 +125,12 @@
 
 - (NSArray *)workflowProcessesFromPublicJSONData:(NSData *)jsonData conversionError:(NSError **)error
 {
-    return [[self class] parseJSONData:jsonData notFoundErrorCode:kAlfrescoErrorCodeWorkflowNoProcessFound parseBlock:^id(id jsonObject, NSError *parseError) {
+    return [self workflowProcessesFromPublicListResponse:[[AlfrescoListResponse alloc] initWithData:jsonData] conversionError:error];
+}
+
+- (NSArray *)workflowProcessesFromPublicListResponse:(AlfrescoListResponse *)listResponse conversionError:(NSError **)error
+{
+    return [[self class] parseListResponse:listResponse notFoundErrorCode:kAlfrescoErrorCodeWorkflowNoProcessFound parseBlock:^id(id jsonObject, NSError *parseError) {
         if (parseError)
         {
             *error = parseError;
@@ -214,7 +224,12 @@
 
 - (NSArray *)workflowTasksFromPublicJSONData:(NSData *)jsonData conversionError:(NSError **)error
 {
-    return [[self class] parseJSONData:jsonData notFoundErrorCode:kAlfrescoErrorCodeWorkflowNoTaskFound parseBlock:^id(id jsonObject, NSError *parseError) {
+    return [self workflowTasksFromPublicListResponse:[[AlfrescoListResponse alloc] initWithData:jsonData] conversionError:error];
+}
+
+- (NSArray *)workflowTasksFromPublicListResponse:(AlfrescoListResponse *)listResponse conversionError:(NSError **)error
+{
+    return [[self class] parseListResponse:listResponse notFoundErrorCode:kAlfrescoErrorCodeWorkflowNoTaskFound parseBlock:^id(id jsonObject, NSError *parseError) {
         if (parseError)
         {
             *error = parseError;
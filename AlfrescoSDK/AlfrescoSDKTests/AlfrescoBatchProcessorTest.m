@@ -408,6 +408,33 @@
     [self waitForExpectationsWithTimeout:30.0 handler:nil];
 }
 
+- (void)testCompletionQueueOption
+{
+    XCTestExpectation *expectation = [self expectationWithDescription:@"Batch processor result expectation"];
+    
+    // deliver the results on a background queue rather than the main queue
+    AlfrescoBatchProcessorOptions *options = [AlfrescoBatchProcessorOptions new];
+    options.completionQueue = dispatch_queue_create("org.alfresco.mobile.test.batchprocessor", DISPATCH_QUEUE_SERIAL);
+    
+    AlfrescoBatchProcessor *bp = [[AlfrescoBatchProcessor alloc] initWithOptions:options completionBlock:^(NSDictionary *results, NSDictionary *errors) {
+        AlfrescoLogDebug(@"Completion queue option batch processor completed");
+        
+        // check results
+        XCTAssertFalse([NSThread isMainThread], @"Expected the completion block to be called on the completion queue");
+        XCTAssertTrue(results.count == 1, @"Expected there to be 1 result but there were: %lu", (unsigned long)results.count);
+        [expectation fulfill];
+    }];
+    
+    // add the work
+    [bp addUnitOfWork:[[SleepingUnitOfWork alloc] initWithKey:@"1"]];
+    
+    // start the processor
+    [bp start];
+    
+    // wait for the future result
+    [self waitForExpectationsWithTimeout:30.0 handler:nil];
+}
+
 - (void)testDuplicateUnitOfWork
 {
     AlfrescoBatchProcessor *bp = [[AlfrescoBatchProcessor alloc] initWithCompletionBlock:nil];
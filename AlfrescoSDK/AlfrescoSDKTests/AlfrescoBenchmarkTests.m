@@ -0,0 +1,1721 @@
+/*******************************************************************************
+ * Copyright (C) 2005-2020 Alfresco Software Limited.
+ *
+ * This file is part of the Alfresco Mobile SDK.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ******************************************************************************/
+
+#import "AlfrescoBenchmarkTests.h"
+#import "AlfrescoStubServer.h"
+#import "AlfrescoConstants.h"
+#import "AlfrescoInternalConstants.h"
+#import "AlfrescoErrors.h"
+#import "AlfrescoRepositorySession.h"
+#import "AlfrescoDocumentFolderService.h"
+#import "AlfrescoSearchService.h"
+#import "AlfrescoSiteService.h"
+#import "AlfrescoPublicAPIDocumentFolderService.h"
+#import "AlfrescoFavoritesCache.h"
+#import "AlfrescoObjectConverter.h"
+#import "AlfrescoSite.h"
+#import "AlfrescoListingContext.h"
+#import "AlfrescoContentFile.h"
+#import "AlfrescoUploadQueue.h"
+#import "AlfrescoCMISToAlfrescoObjectConverter.h"
+#import "CMISSession.h"
+#import "CMISAtomFeedParser.h"
+#import "CMISBase64Encoder.h"
+#import "CMISDateUtil.h"
+#import "CMISBroswerFormDataWriter.h"
+#import "CMISBrowserConstants.h"
+#import "CMISBindingSession.h"
+#import "CMISSessionParameters.h"
+#import "CMISHttpUploadRequest.h"
+#import "CMISHttpResponse.h"
+#import "CMISURLBuilder.h"
+#import "CMISQueryStatement.h"
+#import "CMISConstants.h"
+#import "CMISContentSource.h"
+#import <mach/mach.h>
+#import <malloc/malloc.h>
+#import <sys/resource.h>
+#import <pthread.h>
+
+// Expecting a "BENCHMARK_RESULTS" build setting via the xcconfig file, the benchmarks only run when a results path is given
+#if !defined(BENCHMARK_RESULTS)
+    #define BENCHMARK_RESULTS @""
+#endif
+
+typedef void (^AlfrescoBenchmarkCompletionBlock)(NSError *error);
+typedef void (^AlfrescoBenchmarkOperationBlock)(AlfrescoBenchmarkCompletionBlock completionBlock);
+typedef AlfrescoRequest * (^AlfrescoBenchmarkNodeOperationBlock)(AlfrescoNode *node, AlfrescoBenchmarkCompletionBlock completionBlock);
+
+static NSString * const kBenchmarkRepositoryId = @"7f3ac6e4-1b2a-4c8e-9d0f-2a6b5c4d3e21";
+static NSString * const kBenchmarkRootFolderId = @"workspace://SpacesStore/8a1c2d3e-0000-4000-a000-000000000000";
+static NSString * const kBenchmarkStorePrefix = @"workspace://SpacesStore/";
+static NSString * const kBenchmarkNodeIdPrefix = @"workspace://SpacesStore/8a1c2d3e-0000-4000-8000-";
+static NSString * const kBenchmarkUploadIdPrefix = @"workspace://SpacesStore/8a1c2d3e-0000-4000-9000-";
+static NSString * const kBenchmarkDate = @"2012-01-01T12:00:00.000Z";
+static NSString * const kBenchmarkUsername = @"admin";
+static NSString * const kBenchmarkPassword = @"admin";
+static NSTimeInterval const kBenchmarkTimeout = 600;
+static NSUInteger const kBenchmarkBase64Length = 16 * 1024 * 1024;
+static NSUInteger const kBenchmarkDateCount = 10000;
+static NSUInteger const kBenchmarkRequestBuildCount = 10000;
+static NSUInteger const kBenchmarkListEntryCount = 1000;
+static NSUInteger const kBenchmarkRenditionCount = 100;
+static NSUInteger const kBenchmarkRenditionLength = 8 * 1024;
+static NSUInteger const kBenchmarkUploadQueueSmallFileCount = 1000;
+static NSUInteger const kBenchmarkUploadQueueSmallFileLength = 4 * 1024;
+static NSUInteger const kBenchmarkUploadQueueLargeFileCount = 5;
+static NSUInteger const kBenchmarkSyncFileCount = 50;
+static NSUInteger const kBenchmarkSyncFileLength = 256 * 1024;
+static NSUInteger const kBenchmarkConcurrentListingCount = 20;
+static NSUInteger const kBenchmarkBulkNodeCount = 100;
+static NSString * const kBenchmarkLegacyServerVersion = @"4.0.0";
+static NSString * const kBenchmarkNodesAPIServerVersion = @"5.2.0";
+
+// results of every scenario run by this process, written out as a whole after each scenario
+static NSMutableDictionary *benchmarkResults;
+
+// the hook libmalloc calls for every allocation and deallocation in any zone while it is set, as malloc stack logging does
+typedef void (AlfrescoBenchmarkMallocLogger)(uint32_t type, uintptr_t arg1, uintptr_t arg2, uintptr_t arg3, uintptr_t result, uint32_t numHotFramesToSkip);
+extern AlfrescoBenchmarkMallocLogger *malloc_logger;
+static uint32_t const kBenchmarkMallocLogTypeAllocate = 2;
+
+// allocations are only counted on the thread being measured
+static AlfrescoBenchmarkMallocLogger *previousMallocLogger;
+static pthread_t countedAllocationThread;
+static uint64_t countedAllocations;
+
+static void AlfrescoBenchmarkCountAllocation(uint32_t type, uintptr_t arg1, uintptr_t arg2, uintptr_t arg3, uintptr_t result, uint32_t numHotFramesToSkip)
+{
+    // reallocations are logged as an allocation and a deallocation at once
+    if ((type & kBenchmarkMallocLogTypeAllocate) && pthread_equal(pthread_self(), countedAllocationThread))
+    {
+        countedAllocations++;
+    }
+    if (previousMallocLogger)
+    {
+        previousMallocLogger(type, arg1, arg2, arg3, result, numHotFramesToSkip + 1);
+    }
+}
+
+@interface AlfrescoBenchmarkTests () <AlfrescoUploadQueueDelegate>
+@property (nonatomic, strong) AlfrescoStubServer *server;
+@property (nonatomic, strong) NSString *resultsPath;
+@property (nonatomic, assign) NSUInteger iterations;
+@property (nonatomic, assign) NSUInteger childCount;
+@property (nonatomic, assign) NSUInteger searchResultCount;
+@property (nonatomic, assign) NSUInteger siteCount;
+@property (nonatomic, assign) unsigned long long contentLength;
+@property (nonatomic, strong) NSMutableDictionary *fixtures;
+@property (nonatomic, strong) NSArray *documentEntries;
+@property (nonatomic, strong) NSCache *feedCache;
+@property (nonatomic, assign) NSUInteger uploadCount;
+@property (atomic, assign) NSUInteger favoriteCount;
+@property (atomic, strong) NSString *serverVersion;
+@property (nonatomic, copy) AlfrescoBenchmarkCompletionBlock uploadQueueCompletionBlock;
+@end
+
+@implementation AlfrescoBenchmarkTests
+
+- (void)setUp
+{
+    [super setUp];
+
+    NSDictionary *environment = [[NSProcessInfo processInfo] environment];
+    NSString *resultsPath = BENCHMARK_RESULTS;
+    if (resultsPath.length == 0)
+    {
+        // allow the path to be set via Xcode's "Edit Scheme ⌘<" view
+        resultsPath = environment[@"BENCHMARK_RESULTS"];
+    }
+    if (resultsPath.length == 0)
+    {
+        return;
+    }
+
+    self.resultsPath = resultsPath;
+    self.iterations = [self unsignedIntegerFromEnvironment:@"BENCHMARK_ITERATIONS" defaultValue:5];
+    self.childCount = [self unsignedIntegerFromEnvironment:@"BENCHMARK_CHILD_COUNT" defaultValue:1000];
+    self.searchResultCount = [self unsignedIntegerFromEnvironment:@"BENCHMARK_SEARCH_RESULT_COUNT" defaultValue:100];
+    self.siteCount = [self unsignedIntegerFromEnvironment:@"BENCHMARK_SITE_COUNT" defaultValue:200];
+    self.contentLength = [self unsignedIntegerFromEnvironment:@"BENCHMARK_CONTENT_MB" defaultValue:100] * 1024ULL * 1024ULL;
+    self.serverVersion = kBenchmarkLegacyServerVersion;
+
+    self.server = [[AlfrescoStubServer alloc] init];
+    self.server.latency = [environment[@"BENCHMARK_LATENCY_MS"] doubleValue] / 1000.0;
+    self.server.bytesPerSecond = [self unsignedIntegerFromEnvironment:@"BENCHMARK_BANDWIDTH_KBPS" defaultValue:0] * 1024ULL;
+    self.server.failureRate = [environment[@"BENCHMARK_FAILURE_RATE"] doubleValue];
+
+    NSError *error = nil;
+    BOOL started = [self.server startAndReturnError:&error];
+    XCTAssertTrue(started, @"Failed to start the stub server: %@", error);
+    if (!started)
+    {
+        self.server = nil;
+        return;
+    }
+
+    [self loadFixtures];
+    [self installRoutes];
+}
+
+- (void)tearDown
+{
+    [self.server stop];
+    self.server = nil;
+    [super tearDown];
+}
+
+#pragma mark - Macro benchmarks
+
+- (void)testSessionConnectBenchmark
+{
+    if (nil == self.server)
+    {
+        return;
+    }
+
+    [self runScenario:@"session.connect" bytes:0 operation:^(AlfrescoBenchmarkCompletionBlock completionBlock) {
+        [AlfrescoRepositorySession connectWithUrl:self.server.baseURL username:kBenchmarkUsername password:kBenchmarkPassword completionBlock:^(id<AlfrescoSession> session, NSError *error) {
+            completionBlock(error);
+        }];
+    }];
+}
+
+- (void)testListChildrenBenchmark
+{
+    id<AlfrescoSession> session = [self connectedSession];
+    if (nil == session)
+    {
+        return;
+    }
+
+    AlfrescoDocumentFolderService *documentFolderService = [[AlfrescoDocumentFolderService alloc] initWithSession:session];
+    AlfrescoListingContext *listingContext = [[AlfrescoListingContext alloc] initWithMaxItems:(int)self.childCount];
+    NSString *scenario = [NSString stringWithFormat:@"folder.listChildren.%lu", (unsigned long)self.childCount];
+    [self runScenario:scenario bytes:0 operation:^(AlfrescoBenchmarkCompletionBlock completionBlock) {
+        [documentFolderService retrieveChildrenInFolder:session.rootFolder listingContext:listingContext completionBlock:^(AlfrescoPagingResult *pagingResult, NSError *error) {
+            if (nil != pagingResult && pagingResult.objects.count != self.childCount)
+            {
+                error = [NSError errorWithDomain:kAlfrescoErrorDomainName code:kAlfrescoErrorCodeUnknown
+                                        userInfo:@{NSLocalizedDescriptionKey: @"Unexpected number of children"}];
+            }
+            completionBlock(error);
+        }];
+    }];
+}
+
+- (void)testSearchBenchmark
+{
+    id<AlfrescoSession> session = [self connectedSession];
+    if (nil == session)
+    {
+        return;
+    }
+
+    AlfrescoSearchService *searchService = [[AlfrescoSearchService alloc] initWithSession:session];
+    NSString *statement = @"SELECT * FROM cmis:document WHERE CONTAINS('benchmark')";
+    [self runScenario:@"search.cmis" bytes:0 operation:^(AlfrescoBenchmarkCompletionBlock completionBlock) {
+        [searchService searchWithStatement:statement language:AlfrescoSearchLanguageCMIS completionBlock:^(NSArray *array, NSError *error) {
+            completionBlock(error);
+        }];
+    }];
+}
+
+- (void)testUploadBenchmark
+{
+    id<AlfrescoSession> session = [self connectedSession];
+    if (nil == session)
+    {
+        return;
+    }
+
+    NSURL *fileURL = [self temporaryFileURLWithLength:self.contentLength];
+    AlfrescoContentFile *contentFile = [[AlfrescoContentFile alloc] initWithUrl:fileURL mimeType:@"text/plain"];
+    AlfrescoDocumentFolderService *documentFolderService = [[AlfrescoDocumentFolderService alloc] initWithSession:session];
+    NSString *scenario = [NSString stringWithFormat:@"document.upload.%lluMB", self.contentLength / (1024 * 1024)];
+    [self runScenario:scenario bytes:self.contentLength operation:^(AlfrescoBenchmarkCompletionBlock completionBlock) {
+        [documentFolderService createDocumentWithName:@"benchmark-upload.txt" inParentFolder:session.rootFolder contentFile:contentFile properties:nil completionBlock:^(AlfrescoDocument *document, NSError *error) {
+            completionBlock(error);
+        } progressBlock:nil];
+    }];
+
+    [[NSFileManager defaultManager] removeItemAtURL:fileURL error:nil];
+}
+
+- (void)testDownloadBenchmark
+{
+    id<AlfrescoSession> session = [self connectedSession];
+    if (nil == session)
+    {
+        return;
+    }
+
+    AlfrescoDocumentFolderService *documentFolderService = [[AlfrescoDocumentFolderService alloc] initWithSession:session];
+    __block AlfrescoDocument *document = nil;
+    [self waitForOperation:^(AlfrescoBenchmarkCompletionBlock completionBlock) {
+        [documentFolderService retrieveNodeWithIdentifier:[self nodeIdentifierAtIndex:0] completionBlock:^(AlfrescoNode *node, NSError *error) {
+            document = (AlfrescoDocument *)node;
+            completionBlock(error);
+        }];
+    }];
+    XCTAssertNotNil(document, @"Failed to retrieve the document to download");
+    if (nil == document)
+    {
+        return;
+    }
+
+    NSString *scenario = [NSString stringWithFormat:@"document.download.%lluMB", self.contentLength / (1024 * 1024)];
+    [self runScenario:scenario bytes:self.contentLength operation:^(AlfrescoBenchmarkCompletionBlock completionBlock) {
+        [documentFolderService retrieveContentOfDocument:document completionBlock:^(AlfrescoContentFile *contentFile, NSError *error) {
+            if (nil != contentFile)
+            {
+                [[NSFileManager defaultManager] removeItemAtURL:contentFile.fileUrl error:nil];
+            }
+            completionBlock(error);
+        } progressBlock:nil];
+    }];
+}
+
+- (void)testSiteCacheBenchmark
+{
+    id<AlfrescoSession> session = [self connectedSession];
+    if (nil == session)
+    {
+        return;
+    }
+
+    AlfrescoSiteService *siteService = [[AlfrescoSiteService alloc] initWithSession:session];
+    NSString *scenario = [NSString stringWithFormat:@"sites.buildCache.%lu", (unsigned long)self.siteCount];
+    [self runScenario:scenario bytes:0 operation:^(AlfrescoBenchmarkCompletionBlock completionBlock) {
+        [siteService clear];
+        [siteService retrieveSitesWithCompletionBlock:^(NSArray *array, NSError *error) {
+            completionBlock(error);
+        }];
+    }];
+}
+
+- (void)testFavoritesResolutionBenchmark
+{
+    id<AlfrescoSession> session = [self connectedSession];
+    if (nil == session)
+    {
+        return;
+    }
+
+    // the public API service resolves the favorites listing through the session's CMIS binding
+    AlfrescoPublicAPIDocumentFolderService *documentFolderService = [[AlfrescoPublicAPIDocumentFolderService alloc] initWithSession:session];
+    AlfrescoFavoritesCache *favoritesCache = [session objectForParameter:kAlfrescoSessionCacheFavorites];
+    for (NSNumber *favoriteCount in @[@10, @100, @1000])
+    {
+        self.favoriteCount = MIN(favoriteCount.unsignedIntegerValue, self.childCount);
+        NSString *scenario = [NSString stringWithFormat:@"favorites.resolve.%lu", (unsigned long)self.favoriteCount];
+        [self runScenario:scenario bytes:0 operation:^(AlfrescoBenchmarkCompletionBlock completionBlock) {
+            [favoritesCache clear];
+            [documentFolderService retrieveFavoriteNodesWithCompletionBlock:^(NSArray *array, NSError *error) {
+                if (nil == error && array.count != self.favoriteCount)
+                {
+                    error = [NSError errorWithDomain:kAlfrescoErrorDomainName code:kAlfrescoErrorCodeUnknown
+                                            userInfo:@{NSLocalizedDescriptionKey: @"Unexpected number of favorites"}];
+                }
+                completionBlock(error);
+            }];
+        }];
+    }
+}
+
+- (void)testRenditionGridBenchmark
+{
+    id<AlfrescoSession> legacySession = [self connectedSession];
+    if (nil == legacySession)
+    {
+        return;
+    }
+
+    NSUInteger renditionCount = MIN(kBenchmarkRenditionCount, self.childCount);
+    AlfrescoDocumentFolderService *documentFolderService = [[AlfrescoDocumentFolderService alloc] initWithSession:legacySession];
+    AlfrescoListingContext *listingContext = [[AlfrescoListingContext alloc] initWithMaxItems:(int)renditionCount];
+    __block NSArray *nodes = nil;
+    [self waitForOperation:^(AlfrescoBenchmarkCompletionBlock completionBlock) {
+        [documentFolderService retrieveDocumentsInFolder:legacySession.rootFolder listingContext:listingContext completionBlock:^(AlfrescoPagingResult *pagingResult, NSError *error) {
+            nodes = pagingResult.objects;
+            completionBlock(error);
+        }];
+    }];
+    XCTAssertEqual(nodes.count, renditionCount, @"Failed to retrieve the documents to show thumbnails for");
+    if (nodes.count != renditionCount)
+    {
+        return;
+    }
+
+    // servers without the nodes API locate the rendition stream through the CMIS object first
+    AlfrescoPublicAPIDocumentFolderService *cmisRenditionService = [[AlfrescoPublicAPIDocumentFolderService alloc] initWithSession:legacySession];
+    NSString *scenario = [NSString stringWithFormat:@"renditions.grid.cmis.%lu", (unsigned long)renditionCount];
+    [self runRenditionScenario:scenario documentFolderService:cmisRenditionService nodes:nodes];
+
+    self.serverVersion = kBenchmarkNodesAPIServerVersion;
+    id<AlfrescoSession> session = [self connectedSession];
+    if (nil == session)
+    {
+        return;
+    }
+    AlfrescoPublicAPIDocumentFolderService *renditionService = [[AlfrescoPublicAPIDocumentFolderService alloc] initWithSession:session];
+    scenario = [NSString stringWithFormat:@"renditions.grid.direct.%lu", (unsigned long)renditionCount];
+    [self runRenditionScenario:scenario documentFolderService:renditionService nodes:nodes];
+}
+
+- (void)testUploadQueueBenchmark
+{
+    id<AlfrescoSession> session = [self connectedSession];
+    if (nil == session)
+    {
+        return;
+    }
+
+    // each connection reads request bodies at the shaped rate, as a mobile uplink would
+    self.server.uploadBytesPerSecond = [self unsignedIntegerFromEnvironment:@"BENCHMARK_UPLOAD_BANDWIDTH_KBPS" defaultValue:8192] * 1024ULL;
+    unsigned long long largeFileLength = [self unsignedIntegerFromEnvironment:@"BENCHMARK_UPLOAD_QUEUE_LARGE_MB" defaultValue:10] * 1024ULL * 1024ULL;
+
+    NSMutableArray *contentFiles = [NSMutableArray array];
+    unsigned long long bytes = 0;
+    NSURL *smallFileURL = [self temporaryFileURLWithLength:kBenchmarkUploadQueueSmallFileLength];
+    AlfrescoContentFile *smallContentFile = [[AlfrescoContentFile alloc] initWithUrl:smallFileURL mimeType:@"text/plain"];
+    for (NSUInteger index = 0; index < kBenchmarkUploadQueueSmallFileCount; index++)
+    {
+        [contentFiles addObject:smallContentFile];
+        bytes += kBenchmarkUploadQueueSmallFileLength;
+    }
+    for (NSUInteger index = 0; index < kBenchmarkUploadQueueLargeFileCount; index++)
+    {
+        [contentFiles addObject:[[AlfrescoContentFile alloc] initWithUrl:[self temporaryFileURLWithLength:largeFileLength] mimeType:@"text/plain"]];
+        bytes += largeFileLength;
+    }
+
+    NSString *scenarioSuffix = [NSString stringWithFormat:@"%lux4KB+%lux%lluMB", (unsigned long)kBenchmarkUploadQueueSmallFileCount,
+                                (unsigned long)kBenchmarkUploadQueueLargeFileCount, largeFileLength / (1024 * 1024)];
+    [self runUploadQueueScenario:[@"upload.queue.serial." stringByAppendingString:scenarioSuffix] session:session maxConcurrentUploads:1 contentFiles:contentFiles bytes:bytes];
+    [self runUploadQueueScenario:[@"upload.queue.concurrent." stringByAppendingString:scenarioSuffix] session:session maxConcurrentUploads:4 contentFiles:contentFiles bytes:bytes];
+
+    for (AlfrescoContentFile *contentFile in [NSSet setWithArray:contentFiles])
+    {
+        [[NSFileManager defaultManager] removeItemAtURL:contentFile.fileUrl error:nil];
+    }
+}
+
+- (void)testUnchangedTreeSyncBenchmark
+{
+    id<AlfrescoSession> session = [self connectedSession];
+    if (nil == session)
+    {
+        return;
+    }
+    [session setObject:@YES forParameter:kAlfrescoContentDeduplication];
+
+    NSUInteger fileCount = [self unsignedIntegerFromEnvironment:@"BENCHMARK_SYNC_FILE_COUNT" defaultValue:kBenchmarkSyncFileCount];
+    NSMutableArray *contentFiles = [NSMutableArray arrayWithCapacity:fileCount];
+    for (NSUInteger index = 0; index < fileCount; index++)
+    {
+        [contentFiles addObject:[[AlfrescoContentFile alloc] initWithUrl:[self temporaryFileURLWithLength:kBenchmarkSyncFileLength] mimeType:@"text/plain"]];
+    }
+
+    // every sync creates each file of the tree in the root folder, only the first one has to upload their content
+    AlfrescoDocumentFolderService *documentFolderService = [[AlfrescoDocumentFolderService alloc] initWithSession:session];
+    AlfrescoBenchmarkOperationBlock syncTree = ^(AlfrescoBenchmarkCompletionBlock completionBlock) {
+        __block NSUInteger pendingCount = contentFiles.count;
+        __block NSError *syncError = nil;
+        [contentFiles enumerateObjectsUsingBlock:^(AlfrescoContentFile *contentFile, NSUInteger index, BOOL *stop) {
+            NSString *name = [NSString stringWithFormat:@"sync-%04lu.txt", (unsigned long)index];
+            [documentFolderService createDocumentWithName:name inParentFolder:session.rootFolder contentFile:contentFile properties:nil completionBlock:^(AlfrescoDocument *document, NSError *error) {
+                syncError = syncError ?: error;
+                if (--pendingCount == 0)
+                {
+                    completionBlock(syncError);
+                }
+            } progressBlock:nil];
+        }];
+    };
+
+    unsigned long long bytesReceived = self.server.bodyBytesReceived;
+    NSError *error = [self waitForOperation:syncTree];
+    XCTAssertNil(error, @"Failed to sync the tree the first time: %@", error);
+    unsigned long long firstSyncBytes = self.server.bodyBytesReceived - bytesReceived;
+
+    NSString *scenario = [NSString stringWithFormat:@"sync.unchanged.%lux%luKB", (unsigned long)fileCount, (unsigned long)(kBenchmarkSyncFileLength / 1024)];
+    bytesReceived = self.server.bodyBytesReceived;
+    [self runScenario:scenario bytes:0 operation:syncTree];
+    unsigned long long syncBytes = (self.server.bodyBytesReceived - bytesReceived) / (self.iterations + 1);
+
+    [self recordValue:@(firstSyncBytes) forKey:@"bytesUploadedFirstSync" ofScenario:scenario];
+    [self recordValue:@(syncBytes) forKey:@"bytesUploadedPerSync" ofScenario:scenario];
+    XCTAssertTrue(syncBytes * 100 < firstSyncBytes, @"Expected an unchanged tree not to be uploaded again, but %llu bytes were sent", syncBytes);
+
+    for (AlfrescoContentFile *contentFile in contentFiles)
+    {
+        [[NSFileManager defaultManager] removeItemAtURL:contentFile.fileUrl error:nil];
+    }
+}
+
+- (void)testConcurrentListingsBenchmark
+{
+    if (nil == self.server)
+    {
+        return;
+    }
+
+    // the same listings delivered on the main queue and on a background queue, as a sync engine or extension without UI would use
+    NSUInteger listingCount = [self unsignedIntegerFromEnvironment:@"BENCHMARK_CONCURRENT_LISTINGS" defaultValue:kBenchmarkConcurrentListingCount];
+    dispatch_queue_t backgroundQueue = dispatch_queue_create("org.alfresco.mobile.benchmark.completion", DISPATCH_QUEUE_CONCURRENT);
+    NSDictionary *completionQueues = @{@"main": dispatch_get_main_queue(), @"background": backgroundQueue};
+    for (NSString *queueName in @[@"main", @"background"])
+    {
+        id<AlfrescoSession> session = [self connectedSessionWithParameters:@{kAlfrescoCompletionQueue: completionQueues[queueName]}];
+        if (nil == session)
+        {
+            return;
+        }
+
+        AlfrescoDocumentFolderService *documentFolderService = [[AlfrescoDocumentFolderService alloc] initWithSession:session];
+        AlfrescoListingContext *listingContext = [[AlfrescoListingContext alloc] initWithMaxItems:(int)self.childCount];
+        BOOL expectMainThread = [queueName isEqualToString:@"main"];
+        NSString *scenario = [NSString stringWithFormat:@"folder.listChildren.concurrent.%lux%lu.%@", (unsigned long)listingCount, (unsigned long)self.childCount, queueName];
+        [self runScenario:scenario bytes:0 operation:^(AlfrescoBenchmarkCompletionBlock completionBlock) {
+            NSObject *lock = [NSObject new];
+            __block NSUInteger pendingCount = listingCount;
+            __block NSError *listingError = nil;
+            for (NSUInteger index = 0; index < listingCount; index++)
+            {
+                [documentFolderService retrieveChildrenInFolder:session.rootFolder listingContext:listingContext completionBlock:^(AlfrescoPagingResult *pagingResult, NSError *error) {
+                    if (nil == error && [NSThread isMainThread] != expectMainThread)
+                    {
+                        error = [NSError errorWithDomain:kAlfrescoErrorDomainName code:kAlfrescoErrorCodeUnknown
+                                                userInfo:@{NSLocalizedDescriptionKey: @"Completion block called on the wrong queue"}];
+                    }
+                    else if (nil != pagingResult && pagingResult.objects.count != self.childCount)
+                    {
+                        error = [NSError errorWithDomain:kAlfrescoErrorDomainName code:kAlfrescoErrorCodeUnknown
+                                                userInfo:@{NSLocalizedDescriptionKey: @"Unexpected number of children"}];
+                    }
+
+                    BOOL finished = NO;
+                    @synchronized(lock)
+                    {
+                        listingError = listingError ?: error;
+                        finished = (--pendingCount == 0);
+                    }
+                    if (finished)
+                    {
+                        completionBlock(listingError);
+                    }
+                }];
+            }
+        }];
+
+        double median = [benchmarkResults[scenario][@"median"] doubleValue];
+        if (median > 0)
+        {
+            [self recordValue:@(listingCount / median) forKey:@"listingsPerSecond" ofScenario:scenario];
+        }
+    }
+}
+
+- (void)testBulkNodeOperationsBenchmark
+{
+    id<AlfrescoSession> session = [self connectedSession];
+    if (nil == session)
+    {
+        return;
+    }
+
+    NSUInteger nodeCount = MIN([self unsignedIntegerFromEnvironment:@"BENCHMARK_BULK_NODE_COUNT" defaultValue:kBenchmarkBulkNodeCount], self.childCount);
+    AlfrescoDocumentFolderService *documentFolderService = [[AlfrescoDocumentFolderService alloc] initWithSession:session];
+    AlfrescoListingContext *listingContext = [[AlfrescoListingContext alloc] initWithMaxItems:(int)nodeCount];
+    __block NSArray *nodes = nil;
+    [self waitForOperation:^(AlfrescoBenchmarkCompletionBlock completionBlock) {
+        [documentFolderService retrieveDocumentsInFolder:session.rootFolder listingContext:listingContext completionBlock:^(AlfrescoPagingResult *pagingResult, NSError *error) {
+            nodes = pagingResult.objects;
+            completionBlock(error);
+        }];
+    }];
+    XCTAssertEqual(nodes.count, nodeCount, @"Failed to retrieve the documents to run bulk operations on");
+    if (nodes.count != nodeCount)
+    {
+        return;
+    }
+
+    // one node after the other as before the bulk methods, against the bulk methods
+    NSDictionary *properties = @{@"cm:description": @"Updated by the bulk benchmark"};
+    NSString *scenario = [NSString stringWithFormat:@"nodes.updateProperties.sequential.%lu", (unsigned long)nodeCount];
+    [self runSequentialScenario:scenario nodes:nodes operation:^AlfrescoRequest *(AlfrescoNode *node, AlfrescoBenchmarkCompletionBlock completionBlock) {
+        return [documentFolderService updatePropertiesOfNode:node properties:properties completionBlock:^(AlfrescoNode *updatedNode, NSError *error) {
+            completionBlock(error);
+        }];
+    }];
+
+    scenario = [NSString stringWithFormat:@"nodes.updateProperties.bulk.%lu", (unsigned long)nodeCount];
+    [self runBulkScenario:scenario nodes:nodes operation:^AlfrescoRequest *(AlfrescoArrayCompletionBlock completionBlock) {
+        return [documentFolderService updatePropertiesOfNodes:nodes properties:properties completionBlock:completionBlock progressBlock:nil];
+    }];
+
+    scenario = [NSString stringWithFormat:@"nodes.delete.sequential.%lu", (unsigned long)nodeCount];
+    [self runSequentialScenario:scenario nodes:nodes operation:^AlfrescoRequest *(AlfrescoNode *node, AlfrescoBenchmarkCompletionBlock completionBlock) {
+        return [documentFolderService deleteNode:node completionBlock:^(BOOL succeeded, NSError *error) {
+            completionBlock(error);
+        }];
+    }];
+
+    scenario = [NSString stringWithFormat:@"nodes.delete.bulk.%lu", (unsigned long)nodeCount];
+    [self runBulkScenario:scenario nodes:nodes operation:^AlfrescoRequest *(AlfrescoArrayCompletionBlock completionBlock) {
+        return [documentFolderService deleteNodes:nodes completionBlock:completionBlock progressBlock:nil];
+    }];
+}
+
+- (void)testMultipartUploadBenchmark
+{
+    if (nil == self.server)
+    {
+        return;
+    }
+
+    __block unsigned long long bytesReceived = 0;
+    [self.server addRouteWithMethod:@"POST" pathPrefix:@"/multipart" handler:^AlfrescoStubResponse *(AlfrescoStubRequest *request) {
+        bytesReceived = request.bodyLength;
+        NSInteger statusCode = (nil == request.headers[@"transfer-encoding"]) ? 201 : 411;
+        return [AlfrescoStubResponse responseWithStatusCode:statusCode contentType:@"text/plain" body:[NSData data]];
+    }];
+
+    CMISSessionParameters *parameters = [[CMISSessionParameters alloc] initWithBindingType:CMISBindingTypeBrowser];
+    parameters.browserUrl = self.server.baseURL;
+    [parameters setObject:@(NO) forKey:kCMISSessionParameterCheckNetworkReachability];
+    CMISBindingSession *bindingSession = [[CMISBindingSession alloc] initWithSessionParameters:parameters];
+
+    unsigned long long contentLength = [self unsignedIntegerFromEnvironment:@"BENCHMARK_MULTIPART_MB" defaultValue:1024] * 1024ULL * 1024ULL;
+    NSURL *fileURL = [self temporaryFileURLWithLength:contentLength];
+    NSURL *url = [self.server.baseURL URLByAppendingPathComponent:@"multipart"];
+    __block unsigned long long peakResidentGrowth = 0;
+
+    // the body is streamed from the file with an exact Content-Length, the stub rejects chunked bodies
+    NSString *scenario = [NSString stringWithFormat:@"multipart.upload.%lluMB", contentLength / (1024 * 1024)];
+    [self runScenario:scenario bytes:contentLength operation:^(AlfrescoBenchmarkCompletionBlock completionBlock) {
+        NSInputStream *inputStream = [NSInputStream inputStreamWithURL:fileURL];
+        CMISBroswerFormDataWriter *formData = [[CMISBroswerFormDataWriter alloc] initWithAction:kCMISBrowserJSONActionCreateDocument contentStream:inputStream mediaType:@"text/plain"];
+        [formData setFileName:@"benchmark-multipart.txt"];
+        NSData *startData = formData.startData;
+        NSData *endData = formData.endData;
+
+        NSMutableURLRequest *urlRequest = [NSMutableURLRequest requestWithURL:url];
+        urlRequest.HTTPMethod = @"POST";
+
+        uint64_t residentSizeAtStart = [self residentMemorySize];
+        dispatch_source_t memoryTimer = dispatch_source_create(DISPATCH_SOURCE_TYPE_TIMER, 0, 0, dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0));
+        dispatch_source_set_timer(memoryTimer, DISPATCH_TIME_NOW, 50 * NSEC_PER_MSEC, 10 * NSEC_PER_MSEC);
+        dispatch_source_set_event_handler(memoryTimer, ^{
+            uint64_t residentSize = [self residentMemorySize];
+            if (residentSize > residentSizeAtStart)
+            {
+                @synchronized(self)
+                {
+                    peakResidentGrowth = MAX(peakResidentGrowth, residentSize - residentSizeAtStart);
+                }
+            }
+        });
+        dispatch_resume(memoryTimer);
+
+        [CMISHttpUploadRequest startRequest:urlRequest
+                                 httpMethod:HTTP_POST
+                                inputStream:inputStream
+                                    headers:formData.headers
+                              bytesExpected:contentLength
+                                    session:bindingSession
+                                  startData:startData
+                                    endData:endData
+                          useBase64Encoding:NO
+                            completionBlock:^(CMISHttpResponse *httpResponse, NSError *error) {
+            dispatch_source_cancel(memoryTimer);
+            if (nil == error && bytesReceived != startData.length + contentLength + endData.length)
+            {
+                error = [NSError errorWithDomain:kAlfrescoErrorDomainName code:kAlfrescoErrorCodeUnknown
+                                        userInfo:@{NSLocalizedDescriptionKey: @"Unexpected number of bytes received"}];
+            }
+            completionBlock(error);
+        } progressBlock:nil];
+    }];
+
+    [self recordValue:@(peakResidentGrowth) forKey:@"peakResidentGrowth" ofScenario:scenario];
+    [[NSFileManager defaultManager] removeItemAtURL:fileURL error:nil];
+}
+
+- (void)testMappedFileUploadBenchmark
+{
+    if (nil == self.server)
+    {
+        return;
+    }
+
+    __block unsigned long long bytesReceived = 0;
+    [self.server addRouteWithMethod:@"POST" pathPrefix:@"/mapped" handler:^AlfrescoStubResponse *(AlfrescoStubRequest *request) {
+        bytesReceived = request.bodyLength;
+        return [AlfrescoStubResponse responseWithStatusCode:201 contentType:@"text/plain" body:[NSData data]];
+    }];
+
+    CMISSessionParameters *parameters = [[CMISSessionParameters alloc] initWithBindingType:CMISBindingTypeBrowser];
+    parameters.browserUrl = self.server.baseURL;
+    [parameters setObject:@(NO) forKey:kCMISSessionParameterCheckNetworkReachability];
+    CMISBindingSession *bindingSession = [[CMISBindingSession alloc] initWithSessionParameters:parameters];
+
+    unsigned long long contentLength = [self unsignedIntegerFromEnvironment:@"BENCHMARK_MULTIPART_MB" defaultValue:1024] * 1024ULL * 1024ULL;
+    NSURL *fileURL = [self temporaryFileURLWithLength:contentLength];
+    NSURL *url = [self.server.baseURL URLByAppendingPathComponent:@"mapped"];
+    __block NSTimeInterval processorTime = 0;
+
+    // the content is copied from the mapped file into the session's buffers, the processor time includes the in-process stub server
+    NSString *scenario = [NSString stringWithFormat:@"mapped.upload.%lluMB", contentLength / (1024 * 1024)];
+    [self runScenario:scenario bytes:contentLength operation:^(AlfrescoBenchmarkCompletionBlock completionBlock) {
+        NSError *sourceError = nil;
+        CMISContentSource *contentSource = [CMISContentSource contentSourceWithFileAtPath:fileURL.path error:&sourceError];
+        if (nil == contentSource)
+        {
+            completionBlock(sourceError);
+            return;
+        }
+        CMISBroswerFormDataWriter *formData = [[CMISBroswerFormDataWriter alloc] initWithAction:kCMISBrowserJSONActionCreateDocument contentSource:contentSource mediaType:@"text/plain"];
+        [formData setFileName:@"benchmark-mapped.txt"];
+        NSData *startData = formData.startData;
+        NSData *endData = formData.endData;
+
+        NSMutableURLRequest *urlRequest = [NSMutableURLRequest requestWithURL:url];
+        urlRequest.HTTPMethod = @"POST";
+
+        NSTimeInterval processorTimeAtStart = [self processorTime];
+        [CMISHttpUploadRequest startRequest:urlRequest
+                                 httpMethod:HTTP_POST
+                              contentSource:contentSource
+                                    headers:formData.headers
+                                    session:bindingSession
+                                  startData:startData
+                                    endData:endData
+                          useBase64Encoding:NO
+                            completionBlock:^(CMISHttpResponse *httpResponse, NSError *error) {
+            processorTime += [self processorTime] - processorTimeAtStart;
+            if (nil == error && bytesReceived != startData.length + contentLength + endData.length)
+            {
+                error = [NSError errorWithDomain:kAlfrescoErrorDomainName code:kAlfrescoErrorCodeUnknown
+                                        userInfo:@{NSLocalizedDescriptionKey: @"Unexpected number of bytes received"}];
+            }
+            completionBlock(error);
+        } progressBlock:nil];
+    }];
+
+    // the warm up run is included, hence the division by all runs
+    double gigabytesSent = (double)contentLength * (self.iterations + 1) / (1024.0 * 1024.0 * 1024.0);
+    [self recordValue:@(processorTime / gigabytesSent) forKey:@"cpuSecondsPerGB" ofScenario:scenario];
+    [[NSFileManager defaultManager] removeItemAtURL:fileURL error:nil];
+}
+
+#pragma mark - Micro benchmarks
+
+- (void)testAtomFeedParsingBenchmark
+{
+    if (nil == self.server)
+    {
+        return;
+    }
+
+    NSData *feedData = [self childrenFeedWithFolderIdentifier:kBenchmarkRootFolderId skipCount:0 maxItems:self.childCount];
+    NSString *scenario = [NSString stringWithFormat:@"parse.atomFeed.%lu", (unsigned long)self.childCount];
+    [self runScenario:scenario bytes:feedData.length synchronousOperation:^NSError *{
+        CMISAtomFeedParser *parser = [[CMISAtomFeedParser alloc] initWithData:feedData];
+        NSError *error = nil;
+        [parser parseAndReturnError:&error];
+        return error;
+    }];
+
+    // count the start tags in the feed to express the median as parser callbacks per second
+    NSUInteger elementCount = 0;
+    const char *bytes = feedData.bytes;
+    for (NSUInteger index = 0; index + 1 < feedData.length; index++)
+    {
+        if (bytes[index] == '<' && bytes[index + 1] != '/' && bytes[index + 1] != '?' && bytes[index + 1] != '!')
+        {
+            elementCount++;
+        }
+    }
+    double median = [benchmarkResults[scenario][@"median"] doubleValue];
+    if (median > 0)
+    {
+        [self recordValue:@(elementCount / median) forKey:@"elementsPerSecond" ofScenario:scenario];
+    }
+
+    // every heap allocation made while parsing, and the heap blocks the parsed entries still hold afterwards, per entry
+    malloc_statistics_t statisticsBefore;
+    malloc_statistics_t statisticsAfter;
+    CMISAtomFeedParser *parser = [[CMISAtomFeedParser alloc] initWithData:feedData];
+    malloc_zone_statistics(NULL, &statisticsBefore);
+    uint64_t allocationCount = [self allocationCountOfBlock:^{
+        [parser parseAndReturnError:nil];
+    }];
+    malloc_zone_statistics(NULL, &statisticsAfter);
+    if (parser.entries.count > 0)
+    {
+        [self recordValue:@(allocationCount / parser.entries.count) forKey:@"allocationsPerEntry" ofScenario:scenario];
+        if (statisticsAfter.blocks_in_use > statisticsBefore.blocks_in_use)
+        {
+            [self recordValue:@((statisticsAfter.blocks_in_use - statisticsBefore.blocks_in_use) / parser.entries.count) forKey:@"retainedBlocksPerEntry" ofScenario:scenario];
+        }
+    }
+}
+
+- (void)testJSONParsingBenchmark
+{
+    if (nil == self.server)
+    {
+        return;
+    }
+
+    NSData *sitesData = [self memberSitesData];
+    NSString *scenario = [NSString stringWithFormat:@"parse.json.sites.%lu", (unsigned long)self.siteCount];
+    [self runScenario:scenario bytes:sitesData.length synchronousOperation:^NSError *{
+        NSError *error = nil;
+        NSArray *siteProperties = [NSJSONSerialization JSONObjectWithData:sitesData options:0 error:&error];
+        for (NSDictionary *properties in siteProperties)
+        {
+            __unused AlfrescoSite *site = [[AlfrescoSite alloc] initWithProperties:properties];
+        }
+        return error;
+    }];
+}
+
+- (void)testListResponseParsingBenchmark
+{
+    if (nil == self.server)
+    {
+        return;
+    }
+
+    NSData *listData = [self publicAPIListDataWithEntryCount:kBenchmarkListEntryCount];
+
+    // entries and pagination extracted separately, parsing the page once for each
+    NSString *scenario = [NSString stringWithFormat:@"parse.json.list.separate.%lu", (unsigned long)kBenchmarkListEntryCount];
+    [self runScenario:scenario bytes:listData.length synchronousOperation:^NSError *{
+        NSError *error = nil;
+        NSArray *entries = [AlfrescoObjectConverter arrayJSONEntriesFromListData:listData error:&error];
+        NSDictionary *pagination = [AlfrescoObjectConverter paginationJSONFromData:listData error:&error];
+        return (entries.count == kBenchmarkListEntryCount && nil != pagination) ? nil : error;
+    }];
+
+    // entries and pagination extracted from a single parsed response
+    scenario = [NSString stringWithFormat:@"parse.json.list.single.%lu", (unsigned long)kBenchmarkListEntryCount];
+    [self runScenario:scenario bytes:listData.length synchronousOperation:^NSError *{
+        NSError *error = nil;
+        AlfrescoListResponse *listResponse = [[AlfrescoListResponse alloc] initWithData:listData];
+        NSArray *entries = [AlfrescoObjectConverter arrayJSONEntriesFromListResponse:listResponse error:&error];
+        NSDictionary *pagination = [AlfrescoObjectConverter paginationJSONFromListResponse:listResponse error:&error];
+        return (entries.count == kBenchmarkListEntryCount && nil != pagination) ? nil : error;
+    }];
+}
+
+- (void)testNodeConversionBenchmark
+{
+    id<AlfrescoSession> session = [self connectedSession];
+    if (nil == session)
+    {
+        return;
+    }
+
+    NSData *feedData = [self childrenFeedWithFolderIdentifier:kBenchmarkRootFolderId skipCount:0 maxItems:self.childCount];
+    CMISAtomFeedParser *parser = [[CMISAtomFeedParser alloc] initWithData:feedData];
+    XCTAssertTrue([parser parseAndReturnError:nil], @"Failed to parse the children feed");
+    NSArray *entries = parser.entries;
+
+    AlfrescoCMISToAlfrescoObjectConverter *objectConverter = [[AlfrescoCMISToAlfrescoObjectConverter alloc] initWithSession:session];
+    NSString *scenario = [NSString stringWithFormat:@"convert.nodes.%lu", (unsigned long)entries.count];
+    [self runScenario:scenario bytes:0 synchronousOperation:^NSError *{
+        for (CMISObjectData *objectData in entries)
+        {
+            __unused AlfrescoNode *node = [objectConverter nodeFromCMISObjectData:objectData];
+        }
+        return nil;
+    }];
+}
+
+- (void)testBase64EncodingBenchmark
+{
+    if (nil == self.server)
+    {
+        return;
+    }
+
+    NSMutableData *plainData = [NSMutableData dataWithLength:kBenchmarkBase64Length];
+    arc4random_buf(plainData.mutableBytes, plainData.length);
+    NSString *scenario = [NSString stringWithFormat:@"encode.base64.%luMB", (unsigned long)(kBenchmarkBase64Length / (1024 * 1024))];
+    [self runScenario:scenario bytes:plainData.length synchronousOperation:^NSError *{
+        __unused NSData *encodedData = [CMISBase64Encoder dataByEncodingText:plainData];
+        return nil;
+    }];
+}
+
+- (void)testDateParsingBenchmark
+{
+    if (nil == self.server)
+    {
+        return;
+    }
+
+    NSMutableArray *dateStrings = [NSMutableArray arrayWithCapacity:kBenchmarkDateCount];
+    NSDate *baseDate = [CMISDateUtil dateFromString:kBenchmarkDate];
+    for (NSUInteger index = 0; index < kBenchmarkDateCount; index++)
+    {
+        [dateStrings addObject:[CMISDateUtil stringFromDate:[baseDate dateByAddingTimeInterval:index * 61.25]]];
+    }
+
+    NSString *scenario = [NSString stringWithFormat:@"parse.dates.%lu", (unsigned long)kBenchmarkDateCount];
+    [self runScenario:scenario bytes:0 synchronousOperation:^NSError *{
+        for (NSString *dateString in dateStrings)
+        {
+            if (nil == [CMISDateUtil dateFromString:dateString])
+            {
+                return [NSError errorWithDomain:kAlfrescoErrorDomainName code:kAlfrescoErrorCodeUnknown
+                                       userInfo:@{NSLocalizedDescriptionKey: [NSString stringWithFormat:@"Failed to parse %@", dateString]}];
+            }
+        }
+        return nil;
+    }];
+}
+
+- (void)testRequestBuildingBenchmark
+{
+    if (nil == self.server)
+    {
+        return;
+    }
+
+    // builds the URL of a children listing and a parameterised query per request, as the binding services do
+    NSString *childrenUrl = [NSString stringWithFormat:@"%@/alfresco/api/-default-/public/cmis/versions/1.1/browser/root?objectId=%@&cmisselector=children",
+                             self.server.baseURL.absoluteString, kBenchmarkRootFolderId];
+    CMISQueryStatement *statement = [[CMISQueryStatement alloc] initWithStatement:@"SELECT * FROM cmis:document WHERE IN_FOLDER(?) AND cmis:name LIKE ? AND cmis:creationDate > ?"];
+    NSDate *creationDate = [CMISDateUtil dateFromString:kBenchmarkDate];
+
+    NSString *scenario = [NSString stringWithFormat:@"build.requests.%lu", (unsigned long)kBenchmarkRequestBuildCount];
+    [self runScenario:scenario bytes:0 synchronousOperation:^NSError *{
+        for (NSUInteger index = 0; index < kBenchmarkRequestBuildCount; index++)
+        {
+            CMISURLBuilder *urlBuilder = [CMISURLBuilder builderWithUrlString:childrenUrl];
+            [urlBuilder addParameter:kCMISParameterFilter value:@"cmis:name,cmis:objectId,cmis:baseTypeId,cmis:lastModificationDate"];
+            [urlBuilder addParameter:kCMISParameterOrderBy value:@"cmis:name ASC"];
+            [urlBuilder addParameter:kCMISParameterIncludeAllowableActions boolValue:YES];
+            [urlBuilder addParameter:kCMISParameterIncludeRelationships value:@"none"];
+            [urlBuilder addParameter:kCMISParameterRenditionFilter value:@"cmis:thumbnail"];
+            [urlBuilder addParameter:kCMISParameterIncludePathSegment boolValue:NO];
+            [urlBuilder addParameter:kCMISParameterMaxItems numberValue:@(50)];
+            [urlBuilder addParameter:kCMISParameterSkipCount numberValue:@(index)];
+
+            [statement setStringAtIndex:1 string:kBenchmarkRootFolderId];
+            [statement setStringLikeAtIndex:2 string:[NSString stringWithFormat:@"document-%lu%%", (unsigned long)index]];
+            [statement setDateTimeAtIndex:3 date:creationDate];
+
+            if (nil == urlBuilder.url || 0 == [statement queryString].length)
+            {
+                return [NSError errorWithDomain:kAlfrescoErrorDomainName code:kAlfrescoErrorCodeUnknown
+                                       userInfo:@{NSLocalizedDescriptionKey: @"Failed to build the request"}];
+            }
+        }
+        return nil;
+    }];
+
+    double median = [benchmarkResults[scenario][@"median"] doubleValue];
+    if (median > 0)
+    {
+        [self recordValue:@(kBenchmarkRequestBuildCount / median) forKey:@"requestsPerSecond" ofScenario:scenario];
+    }
+}
+
+#pragma mark - Round trips
+
+- (void)testUpdateContentTakesOneRoundTrip
+{
+    id<AlfrescoSession> session = [self connectedSession];
+    if (nil == session)
+    {
+        return;
+    }
+
+    // the document is retrieved first, as a browsing client would have, so its links and type are known
+    AlfrescoDocumentFolderService *documentFolderService = [[AlfrescoDocumentFolderService alloc] initWithSession:session];
+    __block AlfrescoDocument *document = nil;
+    [self waitForOperation:^(AlfrescoBenchmarkCompletionBlock completionBlock) {
+        [documentFolderService retrieveNodeWithIdentifier:[self nodeIdentifierAtIndex:0] completionBlock:^(AlfrescoNode *node, NSError *error) {
+            document = (AlfrescoDocument *)node;
+            completionBlock(error);
+        }];
+    }];
+    XCTAssertNotNil(document, @"Failed to retrieve the document to update");
+    if (nil == document)
+    {
+        return;
+    }
+
+    NSData *data = [@"updated content for the round trip test" dataUsingEncoding:NSUTF8StringEncoding];
+    AlfrescoContentFile *contentFile = [[AlfrescoContentFile alloc] initWithData:data mimeType:@"text/plain"];
+    NSUInteger requestCount = self.server.requestCount;
+    __block AlfrescoDocument *updatedDocument = nil;
+    NSError *error = [self waitForOperation:^(AlfrescoBenchmarkCompletionBlock completionBlock) {
+        [documentFolderService updateContentOfDocument:document contentFile:contentFile completionBlock:^(AlfrescoDocument *resultDocument, NSError *updateError) {
+            updatedDocument = resultDocument;
+            completionBlock(updateError);
+        } progressBlock:nil];
+    }];
+    NSUInteger updateRequestCount = self.server.requestCount - requestCount;
+
+    XCTAssertNil(error, @"Failed to update the content: %@", error);
+    XCTAssertEqualObjects(updatedDocument.identifier, document.identifier, @"Expected the updated document from the response");
+    XCTAssertTrue(updateRequestCount == 1, @"Expected the content update to take exactly one request but it took %lu", (unsigned long)updateRequestCount);
+    [[NSFileManager defaultManager] removeItemAtURL:contentFile.fileUrl error:nil];
+}
+
+#pragma mark - Scenario execution
+
+- (void)runScenario:(NSString *)scenario bytes:(unsigned long long)bytes synchronousOperation:(NSError * (^)(void))operation
+{
+    [self runScenario:scenario bytes:bytes operation:^(AlfrescoBenchmarkCompletionBlock completionBlock) {
+        completionBlock(operation());
+    }];
+}
+
+- (void)runScenario:(NSString *)scenario bytes:(unsigned long long)bytes operation:(AlfrescoBenchmarkOperationBlock)operation
+{
+    NSMutableArray *samples = [NSMutableArray arrayWithCapacity:self.iterations];
+    NSMutableArray *requestCounts = [NSMutableArray arrayWithCapacity:self.iterations];
+    NSUInteger failures = 0;
+    NSError *lastError = nil;
+
+    // the first run warms up caches and connections and is not recorded
+    for (NSUInteger iteration = 0; iteration <= self.iterations; iteration++)
+    {
+        NSUInteger requestCount = self.server.requestCount;
+        CFAbsoluteTime startTime = CFAbsoluteTimeGetCurrent();
+        NSError *error = [self waitForOperation:operation];
+        CFAbsoluteTime duration = CFAbsoluteTimeGetCurrent() - startTime;
+        requestCount = self.server.requestCount - requestCount;
+
+        if (iteration == 0)
+        {
+            continue;
+        }
+        if (nil != error)
+        {
+            failures++;
+            lastError = error;
+        }
+        else
+        {
+            [samples addObject:@(duration)];
+            [requestCounts addObject:@(requestCount)];
+        }
+    }
+
+    // with failure injection switched off every run is expected to succeed
+    if (self.server.failureRate == 0)
+    {
+        XCTAssertTrue(failures == 0, @"Scenario %@ failed %lu times, last error: %@", scenario, (unsigned long)failures, lastError);
+    }
+
+    [self recordScenario:scenario samples:samples requestCounts:requestCounts failures:failures bytes:bytes];
+}
+
+- (NSError *)waitForOperation:(AlfrescoBenchmarkOperationBlock)operation
+{
+    // completion blocks may be called on a background queue, see testConcurrentListingsBenchmark
+    __block volatile BOOL completed = NO;
+    __block NSError *operationError = nil;
+    operation(^(NSError *error) {
+        operationError = error;
+        completed = YES;
+    });
+
+    NSDate *timeoutDate = [NSDate dateWithTimeIntervalSinceNow:kBenchmarkTimeout];
+    while (!completed && [timeoutDate timeIntervalSinceNow] > 0)
+    {
+        [[NSRunLoop currentRunLoop] runMode:NSDefaultRunLoopMode beforeDate:[NSDate dateWithTimeIntervalSinceNow:0.005]];
+    }
+
+    if (!completed)
+    {
+        XCTFail(@"TIME OUT: operation did not complete within %d seconds", (int)kBenchmarkTimeout);
+        operationError = [AlfrescoErrors alfrescoErrorWithAlfrescoErrorCode:kAlfrescoErrorCodeNetworkRequestCancelled];
+    }
+    return operationError;
+}
+
+- (void)runRenditionScenario:(NSString *)scenario documentFolderService:(AlfrescoDocumentFolderService *)documentFolderService nodes:(NSArray *)nodes
+{
+    [self runScenario:scenario bytes:nodes.count * kBenchmarkRenditionLength operation:^(AlfrescoBenchmarkCompletionBlock completionBlock) {
+        [documentFolderService retrieveRenditionsOfNodes:nodes renditionName:kAlfrescoThumbnailRendition completionBlock:^(NSDictionary *contentFiles, NSError *error) {
+            for (AlfrescoContentFile *contentFile in contentFiles.allValues)
+            {
+                [[NSFileManager defaultManager] removeItemAtURL:contentFile.fileUrl error:nil];
+            }
+            if (nil == error && contentFiles.count != nodes.count)
+            {
+                error = [NSError errorWithDomain:kAlfrescoErrorDomainName code:kAlfrescoErrorCodeUnknown
+                                        userInfo:@{NSLocalizedDescriptionKey: @"Unexpected number of renditions"}];
+            }
+            completionBlock(error);
+        }];
+    }];
+}
+
+- (void)runSequentialScenario:(NSString *)scenario nodes:(NSArray *)nodes operation:(AlfrescoBenchmarkNodeOperationBlock)operation
+{
+    [self runScenario:scenario bytes:0 operation:^(AlfrescoBenchmarkCompletionBlock completionBlock) {
+        [self runOperation:operation onNodes:nodes fromIndex:0 completionBlock:completionBlock];
+    }];
+}
+
+- (void)runOperation:(AlfrescoBenchmarkNodeOperationBlock)operation onNodes:(NSArray *)nodes fromIndex:(NSUInteger)index completionBlock:(AlfrescoBenchmarkCompletionBlock)completionBlock
+{
+    if (index == nodes.count)
+    {
+        completionBlock(nil);
+        return;
+    }
+
+    operation(nodes[index], ^(NSError *error) {
+        if (nil != error)
+        {
+            completionBlock(error);
+        }
+        else
+        {
+            [self runOperation:operation onNodes:nodes fromIndex:index + 1 completionBlock:completionBlock];
+        }
+    });
+}
+
+- (void)runBulkScenario:(NSString *)scenario nodes:(NSArray *)nodes operation:(AlfrescoRequest *(^)(AlfrescoArrayCompletionBlock completionBlock))operation
+{
+    [self runScenario:scenario bytes:0 operation:^(AlfrescoBenchmarkCompletionBlock completionBlock) {
+        operation(^(NSArray *processedNodes, NSError *error) {
+            if (nil == error && processedNodes.count != nodes.count)
+            {
+                error = [NSError errorWithDomain:kAlfrescoErrorDomainName code:kAlfrescoErrorCodeUnknown
+                                        userInfo:@{NSLocalizedDescriptionKey: @"Unexpected number of processed nodes"}];
+            }
+            completionBlock(error);
+        });
+    }];
+}
+
+- (void)runUploadQueueScenario:(NSString *)scenario session:(id<AlfrescoSession>)session maxConcurrentUploads:(NSUInteger)maxConcurrentUploads contentFiles:(NSArray *)contentFiles bytes:(unsigned long long)bytes
+{
+    [self runScenario:scenario bytes:bytes operation:^(AlfrescoBenchmarkCompletionBlock completionBlock) {
+        AlfrescoUploadQueue *uploadQueue = [[AlfrescoUploadQueue alloc] initWithSession:session];
+        uploadQueue.delegate = self;
+        uploadQueue.maxConcurrentUploads = maxConcurrentUploads;
+
+        // the queue is kept alive by the completion block until it has finished
+        self.uploadQueueCompletionBlock = ^(NSError *error) {
+            NSUInteger completedCount = 0;
+            for (AlfrescoUploadItem *item in uploadQueue.items)
+            {
+                if (item.state == AlfrescoUploadItemStateCompleted)
+                {
+                    completedCount++;
+                }
+                else if (nil == error)
+                {
+                    error = item.error;
+                }
+            }
+            if (nil == error && completedCount != contentFiles.count)
+            {
+                error = [NSError errorWithDomain:kAlfrescoErrorDomainName code:kAlfrescoErrorCodeUnknown
+                                        userInfo:@{NSLocalizedDescriptionKey: @"Not all uploads completed"}];
+            }
+            completionBlock(error);
+        };
+
+        [contentFiles enumerateObjectsUsingBlock:^(AlfrescoContentFile *contentFile, NSUInteger index, BOOL *stop) {
+            NSString *name = [NSString stringWithFormat:@"benchmark-queue-%lu.txt", (unsigned long)index];
+            [uploadQueue addUploadWithName:name inParentFolder:session.rootFolder contentFile:contentFile properties:nil priority:0];
+        }];
+    }];
+}
+
+- (void)uploadQueueDidFinish:(AlfrescoUploadQueue *)uploadQueue
+{
+    AlfrescoBenchmarkCompletionBlock completionBlock = self.uploadQueueCompletionBlock;
+    self.uploadQueueCompletionBlock = nil;
+    if (nil != completionBlock)
+    {
+        completionBlock(nil);
+    }
+}
+
+- (id<AlfrescoSession>)connectedSession
+{
+    return [self connectedSessionWithParameters:nil];
+}
+
+- (id<AlfrescoSession>)connectedSessionWithParameters:(NSDictionary *)parameters
+{
+    if (nil == self.server)
+    {
+        return nil;
+    }
+
+    // connect with failure injection switched off so setup does not skew the scenario
+    double failureRate = self.server.failureRate;
+    self.server.failureRate = 0;
+
+    __block id<AlfrescoSession> connectedSession = nil;
+    NSError *error = [self waitForOperation:^(AlfrescoBenchmarkCompletionBlock completionBlock) {
+        [AlfrescoRepositorySession connectWithUrl:self.server.baseURL username:kBenchmarkUsername password:kBenchmarkPassword parameters:parameters completionBlock:^(id<AlfrescoSession> session, NSError *error) {
+            connectedSession = session;
+            completionBlock(error);
+        }];
+    }];
+
+    self.server.failureRate = failureRate;
+    XCTAssertNotNil(connectedSession, @"Failed to connect to the stub server: %@", error);
+    return connectedSession;
+}
+
+#pragma mark - Results
+
+- (void)recordScenario:(NSString *)scenario samples:(NSArray *)samples requestCounts:(NSArray *)requestCounts failures:(NSUInteger)failures bytes:(unsigned long long)bytes
+{
+    NSMutableDictionary *result = [NSMutableDictionary dictionary];
+    result[@"iterations"] = @(samples.count + failures);
+    result[@"failures"] = @(failures);
+    result[@"samples"] = samples;
+
+    if (samples.count > 0)
+    {
+        NSArray *sortedSamples = [samples sortedArrayUsingSelector:@selector(compare:)];
+        double total = [[samples valueForKeyPath:@"@sum.doubleValue"] doubleValue];
+        double median = [self percentile:50 ofSortedSamples:sortedSamples];
+        result[@"min"] = sortedSamples.firstObject;
+        result[@"max"] = sortedSamples.lastObject;
+        result[@"mean"] = @(total / samples.count);
+        result[@"median"] = @(median);
+        result[@"p90"] = @([self percentile:90 ofSortedSamples:sortedSamples]);
+        result[@"requests"] = @([self percentile:50 ofSortedSamples:[requestCounts sortedArrayUsingSelector:@selector(compare:)]]);
+        if (bytes > 0 && median > 0)
+        {
+            result[@"bytes"] = @(bytes);
+            result[@"bytesPerSecond"] = @(bytes / median);
+        }
+    }
+
+    NSDictionary *configuration = @{@"iterations": @(self.iterations),
+                                    @"childCount": @(self.childCount),
+                                    @"searchResultCount": @(self.searchResultCount),
+                                    @"siteCount": @(self.siteCount),
+                                    @"contentLength": @(self.contentLength),
+                                    @"latency": @(self.server.latency),
+                                    @"bytesPerSecond": @(self.server.bytesPerSecond),
+                                    @"failureRate": @(self.server.failureRate)};
+
+    @synchronized([AlfrescoBenchmarkTests class])
+    {
+        if (nil == benchmarkResults)
+        {
+            benchmarkResults = [NSMutableDictionary dictionary];
+        }
+        benchmarkResults[scenario] = result;
+
+        NSDictionary *document = @{@"sdkVersion": kAlfrescoSDKVersion,
+                                   @"date": [CMISDateUtil stringFromDate:[NSDate date]],
+                                   @"device": [[NSProcessInfo processInfo] hostName],
+                                   @"unit": @"seconds",
+                                   @"configuration": configuration,
+                                   @"results": benchmarkResults};
+        NSError *error = nil;
+        NSData *data = [NSJSONSerialization dataWithJSONObject:document options:NSJSONWritingPrettyPrinted error:&error];
+        BOOL written = [data writeToFile:self.resultsPath options:NSDataWritingAtomic error:&error];
+        XCTAssertTrue(written, @"Failed to write benchmark results to %@: %@", self.resultsPath, error);
+    }
+
+    NSLog(@"Benchmark %@: median %.4fs and %lu requests over %lu runs, %lu failures", scenario, [result[@"median"] doubleValue],
+          (unsigned long)[result[@"requests"] unsignedIntegerValue], (unsigned long)samples.count, (unsigned long)failures);
+}
+
+- (void)recordValue:(id)value forKey:(NSString *)key ofScenario:(NSString *)scenario
+{
+    @synchronized([AlfrescoBenchmarkTests class])
+    {
+        benchmarkResults[scenario][key] = value;
+    }
+    NSLog(@"Benchmark %@: %@ %@", scenario, key, value);
+}
+
+- (double)percentile:(double)percentile ofSortedSamples:(NSArray *)sortedSamples
+{
+    // nearest-rank percentile
+    NSUInteger rank = (NSUInteger)ceil((percentile / 100.0) * sortedSamples.count);
+    NSUInteger index = MIN(MAX(rank, 1), sortedSamples.count) - 1;
+    return [sortedSamples[index] doubleValue];
+}
+
+#pragma mark - Stub server routes
+
+- (void)installRoutes
+{
+    __weak typeof(self) weakSelf = self;
+    NSString *apiPath = [@"/alfresco" stringByAppendingString:kAlfrescoLegacyAPIPath];
+    NSString *cmisPath = [@"/alfresco" stringByAppendingString:kAlfrescoLegacyCMISAtomPath];
+    NSString *repositoryPath = [NSString stringWithFormat:@"%@/%@/", cmisPath, kBenchmarkRepositoryId];
+    NSString *json = @"application/json;charset=UTF-8";
+    NSString *atomEntry = @"application/atom+xml;type=entry;charset=UTF-8";
+    NSString *atomFeed = @"application/atom+xml;type=feed;charset=UTF-8";
+
+    // Alfresco web scripts
+    [self.server addRouteWithMethod:@"GET" pathPrefix:[apiPath stringByAppendingString:kAlfrescoLegacyServerAPI] handler:^AlfrescoStubResponse *(AlfrescoStubRequest *request) {
+        NSString *server = [weakSelf renderFixture:@"benchmark-server.json" values:@{@"serverVersion": weakSelf.serverVersion}];
+        return [AlfrescoStubResponse responseWithStatusCode:200 contentType:json body:[server dataUsingEncoding:NSUTF8StringEncoding]];
+    }];
+
+    NSData *workflowData = [self.fixtures[@"benchmark-workflow-definitions.json"] dataUsingEncoding:NSUTF8StringEncoding];
+    [self.server addRouteWithMethod:@"GET" pathPrefix:[apiPath stringByAppendingString:@"workflow-definitions"] handler:^AlfrescoStubResponse *(AlfrescoStubRequest *request) {
+        return [AlfrescoStubResponse responseWithStatusCode:200 contentType:json body:workflowData];
+    }];
+
+    NSData *memberSitesData = [self memberSitesData];
+    [self.server addRouteWithMethod:@"GET" pathPrefix:[NSString stringWithFormat:@"%@people/%@/sites", apiPath, kBenchmarkUsername] handler:^AlfrescoStubResponse *(AlfrescoStubRequest *request) {
+        return [AlfrescoStubResponse responseWithStatusCode:200 contentType:json body:memberSitesData];
+    }];
+
+    NSData *favoriteSitesData = [self favoriteSitesData];
+    [self.server addRouteWithMethod:@"GET" pathPrefix:[NSString stringWithFormat:@"%@people/%@/preferences", apiPath, kBenchmarkUsername] handler:^AlfrescoStubResponse *(AlfrescoStubRequest *request) {
+        return [AlfrescoStubResponse responseWithStatusCode:200 contentType:json body:favoriteSitesData];
+    }];
+
+    NSData *invitationsData = [@"{\"data\":[]}" dataUsingEncoding:NSUTF8StringEncoding];
+    [self.server addRouteWithMethod:@"GET" pathPrefix:[apiPath stringByAppendingString:@"invitations"] handler:^AlfrescoStubResponse *(AlfrescoStubRequest *request) {
+        return [AlfrescoStubResponse responseWithStatusCode:200 contentType:json body:invitationsData];
+    }];
+
+    NSString *publicAPIPath = [@"/alfresco" stringByAppendingString:kAlfrescoPublicAPIPath];
+    [self.server addRouteWithMethod:@"GET" pathPrefix:[NSString stringWithFormat:@"%@people/%@/favorites", publicAPIPath, kBenchmarkUsername] handler:^AlfrescoStubResponse *(AlfrescoStubRequest *request) {
+        return [AlfrescoStubResponse responseWithStatusCode:200 contentType:json body:[weakSelf favoritesData]];
+    }];
+
+    [self.server addRouteWithMethod:@"GET" pathPrefix:[publicAPIPath stringByAppendingString:@"nodes/"] handler:^AlfrescoStubResponse *(AlfrescoStubRequest *request) {
+        // nodes/{id}/renditions/{renditionId}/content
+        if (![request.path hasSuffix:[NSString stringWithFormat:@"/renditions/%@/content", kAlfrescoThumbnailRendition]])
+        {
+            return [AlfrescoStubResponse responseWithStatusCode:404 contentType:json body:nil];
+        }
+        return [AlfrescoStubResponse responseWithStatusCode:200 contentType:@"image/png" generatedBodyLength:kBenchmarkRenditionLength];
+    }];
+
+    [self.server addRouteWithMethod:@"GET" pathPrefix:[apiPath stringByAppendingString:@"sites/"] handler:^AlfrescoStubResponse *(AlfrescoStubRequest *request) {
+        NSString *site = [weakSelf siteWithShortName:request.path.lastPathComponent index:0];
+        return [AlfrescoStubResponse responseWithStatusCode:200 contentType:json body:[site dataUsingEncoding:NSUTF8StringEncoding]];
+    }];
+
+    // CMIS AtomPub binding
+    [self.server addRouteWithMethod:@"GET" pathPrefix:[repositoryPath stringByAppendingString:@"children"] handler:^AlfrescoStubResponse *(AlfrescoStubRequest *request) {
+        NSUInteger skipCount = [request.queryParameters[@"skipCount"] integerValue];
+        NSUInteger maxItems = request.queryParameters[@"maxItems"] ? [request.queryParameters[@"maxItems"] integerValue] : 100;
+        NSData *feedData = [weakSelf childrenFeedWithFolderIdentifier:request.queryParameters[@"id"] skipCount:skipCount maxItems:maxItems];
+        return [AlfrescoStubResponse responseWithStatusCode:200 contentType:atomFeed body:feedData];
+    }];
+
+    [self.server addRouteWithMethod:@"POST" pathPrefix:[repositoryPath stringByAppendingString:@"children"] handler:^AlfrescoStubResponse *(AlfrescoStubRequest *request) {
+        NSString *entry = [weakSelf createdDocumentEntry];
+        return [AlfrescoStubResponse responseWithStatusCode:201 contentType:atomEntry body:[entry dataUsingEncoding:NSUTF8StringEncoding]];
+    }];
+
+    [self.server addRouteWithMethod:@"GET" pathPrefix:[repositoryPath stringByAppendingString:@"id"] handler:^AlfrescoStubResponse *(AlfrescoStubRequest *request) {
+        NSString *entry = [weakSelf entryWithObjectIdentifier:request.queryParameters[@"id"]];
+        NSString *renditionFilter = request.queryParameters[@"renditionFilter"];
+        if (renditionFilter.length > 0 && ![renditionFilter isEqualToString:@"cmis:none"])
+        {
+            entry = [weakSelf entry:entry withRenditionOfObjectIdentifier:request.queryParameters[@"id"]];
+        }
+        return [AlfrescoStubResponse responseWithStatusCode:200 contentType:atomEntry body:[entry dataUsingEncoding:NSUTF8StringEncoding]];
+    }];
+
+    [self.server addRouteWithMethod:@"PUT" pathPrefix:[repositoryPath stringByAppendingString:@"entry"] handler:^AlfrescoStubResponse *(AlfrescoStubRequest *request) {
+        NSString *entry = [weakSelf entryWithObjectIdentifier:request.queryParameters[@"id"]];
+        return [AlfrescoStubResponse responseWithStatusCode:200 contentType:atomEntry body:[entry dataUsingEncoding:NSUTF8StringEncoding]];
+    }];
+
+    // the updated entry is returned with the new content, as Alfresco does, so no retrieval has to follow
+    [self.server addRouteWithMethod:@"PUT" pathPrefix:[repositoryPath stringByAppendingString:@"content"] handler:^AlfrescoStubResponse *(AlfrescoStubRequest *request) {
+        NSString *entry = [weakSelf entryWithObjectIdentifier:request.queryParameters[@"id"]];
+        return [AlfrescoStubResponse responseWithStatusCode:201 contentType:atomEntry body:[entry dataUsingEncoding:NSUTF8StringEncoding]];
+    }];
+
+    [self.server addRouteWithMethod:@"DELETE" pathPrefix:[repositoryPath stringByAppendingString:@"entry"] handler:^AlfrescoStubResponse *(AlfrescoStubRequest *request) {
+        return [AlfrescoStubResponse responseWithStatusCode:204 contentType:atomEntry body:nil];
+    }];
+
+    [self.server addRouteWithMethod:@"GET" pathPrefix:[repositoryPath stringByAppendingString:@"type"] handler:^AlfrescoStubResponse *(AlfrescoStubRequest *request) {
+        NSString *entry = [weakSelf typeEntryWithIdentifier:request.queryParameters[@"id"]];
+        return [AlfrescoStubResponse responseWithStatusCode:200 contentType:atomEntry body:[entry dataUsingEncoding:NSUTF8StringEncoding]];
+    }];
+
+    [self.server addRouteWithMethod:@"POST" pathPrefix:[repositoryPath stringByAppendingString:@"query"] handler:^AlfrescoStubResponse *(AlfrescoStubRequest *request) {
+        NSString *statement = [[NSString alloc] initWithData:request.body encoding:NSUTF8StringEncoding];
+        NSData *feedData = [weakSelf queryFeedWithStatement:statement];
+        return [AlfrescoStubResponse responseWithStatusCode:201 contentType:atomFeed body:feedData];
+    }];
+
+    [self.server addRouteWithMethod:@"GET" pathPrefix:[repositoryPath stringByAppendingString:@"content"] handler:^AlfrescoStubResponse *(AlfrescoStubRequest *request) {
+        if (nil != request.queryParameters[@"streamId"])
+        {
+            return [AlfrescoStubResponse responseWithStatusCode:200 contentType:@"image/png" generatedBodyLength:kBenchmarkRenditionLength];
+        }
+        return [AlfrescoStubResponse responseWithStatusCode:200 contentType:@"text/plain" generatedBodyLength:weakSelf.contentLength];
+    }];
+
+    NSString *serviceDocument = [self renderFixture:@"benchmark-service-document.xml" values:@{@"rootFolderId": kBenchmarkRootFolderId}];
+    NSData *serviceDocumentData = [serviceDocument dataUsingEncoding:NSUTF8StringEncoding];
+    // servers with the public API are asked for the service document at its CMIS binding, the links in it lead back to the routes above
+    for (NSString *serviceDocumentPath in @[cmisPath, [@"/alfresco" stringByAppendingString:kAlfrescoPublicAPICMISAtomPath]])
+    {
+        [self.server addRouteWithMethod:@"GET" pathPrefix:serviceDocumentPath handler:^AlfrescoStubResponse *(AlfrescoStubRequest *request) {
+            if (![request.path isEqualToString:serviceDocumentPath] && ![request.path isEqualToString:[serviceDocumentPath stringByAppendingString:@"/"]])
+            {
+                return nil;
+            }
+            return [AlfrescoStubResponse responseWithStatusCode:200 contentType:@"application/atomsvc+xml;charset=UTF-8" body:serviceDocumentData];
+        }];
+    }
+}
+
+#pragma mark - Fixtures
+
+- (void)loadFixtures
+{
+    self.fixtures = [NSMutableDictionary dictionary];
+    self.feedCache = [[NSCache alloc] init];
+
+    NSBundle *bundle = [NSBundle bundleForClass:[self class]];
+    NSArray *fixtureNames = @[@"benchmark-server.json", @"benchmark-workflow-definitions.json", @"benchmark-site.json",
+                              @"benchmark-service-document.xml", @"benchmark-folder-entry.xml", @"benchmark-document-entry.xml",
+                              @"benchmark-feed.xml", @"benchmark-type-entry.xml", @"benchmark-activity-entry.json"];
+    for (NSString *fixtureName in fixtureNames)
+    {
+        NSString *path = [bundle pathForResource:fixtureName ofType:nil];
+        NSString *fixture = [NSString stringWithContentsOfFile:path encoding:NSUTF8StringEncoding error:nil];
+        XCTAssertNotNil(fixture, @"Missing benchmark fixture %@", fixtureName);
+        self.fixtures[fixtureName] = fixture ?: @"";
+    }
+
+    // render the children up front so generating responses does not count towards the measured time
+    NSMutableArray *documentEntries = [NSMutableArray arrayWithCapacity:self.childCount];
+    for (NSUInteger index = 0; index < self.childCount; index++)
+    {
+        [documentEntries addObject:[self documentEntryWithIdentifier:[self nodeIdentifierAtIndex:index]]];
+    }
+    self.documentEntries = documentEntries;
+}
+
+- (NSString *)renderFixture:(NSString *)fixtureName values:(NSDictionary *)values
+{
+    NSMutableString *rendered = [self.fixtures[fixtureName] mutableCopy];
+    NSMutableDictionary *allValues = [NSMutableDictionary dictionaryWithDictionary:values];
+    allValues[@"baseURL"] = self.server.baseURL.absoluteString;
+    allValues[@"repositoryId"] = kBenchmarkRepositoryId;
+    allValues[@"date"] = kBenchmarkDate;
+
+    for (NSString *key in allValues)
+    {
+        NSString *placeholder = [NSString stringWithFormat:@"{{%@}}", key];
+        [rendered replaceOccurrencesOfString:placeholder withString:allValues[key] options:0 range:NSMakeRange(0, rendered.length)];
+    }
+    return rendered;
+}
+
+- (NSString *)nodeIdentifierAtIndex:(NSUInteger)index
+{
+    return [NSString stringWithFormat:@"%@%012lu", kBenchmarkNodeIdPrefix, (unsigned long)index];
+}
+
+- (NSString *)documentEntryWithIdentifier:(NSString *)identifier
+{
+    NSString *name = [NSString stringWithFormat:@"benchmark-%@.txt", [identifier substringFromIndex:identifier.length - 12]];
+    return [self renderFixture:@"benchmark-document-entry.xml" values:@{@"objectId": identifier,
+                                                                        @"name": name,
+                                                                        @"contentLength": [@(self.contentLength) stringValue]}];
+}
+
+- (NSString *)entryWithObjectIdentifier:(NSString *)objectIdentifier
+{
+    // strip any version label, documents are always returned as their latest version
+    NSString *identifier = [objectIdentifier componentsSeparatedByString:@";"].firstObject;
+    if ([identifier isEqualToString:kBenchmarkRootFolderId])
+    {
+        return [self renderFixture:@"benchmark-folder-entry.xml" values:@{@"objectId": identifier,
+                                                                          @"name": @"Company Home",
+                                                                          @"path": @"/",
+                                                                          @"parentId": @""}];
+    }
+    return [self documentEntryWithIdentifier:identifier];
+}
+
+- (NSString *)entry:(NSString *)entry withRenditionOfObjectIdentifier:(NSString *)objectIdentifier
+{
+    NSString *identifier = [objectIdentifier componentsSeparatedByString:@";"].firstObject;
+    if ([identifier isEqualToString:kBenchmarkRootFolderId])
+    {
+        return entry;
+    }
+
+    NSString *streamId = [identifier stringByAppendingFormat:@"-%@", kAlfrescoThumbnailRendition];
+    NSString *rendition = [NSString stringWithFormat:@"<cmis:rendition><cmis:streamId>%@</cmis:streamId><cmis:mimetype>image/png</cmis:mimetype>"
+                           "<cmis:length>%lu</cmis:length><cmis:kind>cmis:thumbnail</cmis:kind><cmis:title>%@</cmis:title>"
+                           "<cmis:height>100</cmis:height><cmis:width>100</cmis:width><cmis:renditionDocumentId>%@</cmis:renditionDocumentId></cmis:rendition>",
+                           streamId, (unsigned long)kBenchmarkRenditionLength, kAlfrescoThumbnailRendition, streamId];
+    return [entry stringByReplacingOccurrencesOfString:@"</cmisra:object>" withString:[rendition stringByAppendingString:@"</cmisra:object>"]];
+}
+
+- (NSString *)createdDocumentEntry
+{
+    NSUInteger uploadIndex = 0;
+    @synchronized(self)
+    {
+        uploadIndex = ++self.uploadCount;
+    }
+    return [self documentEntryWithIdentifier:[NSString stringWithFormat:@"%@%012lu", kBenchmarkUploadIdPrefix, (unsigned long)uploadIndex]];
+}
+
+- (NSString *)typeEntryWithIdentifier:(NSString *)typeIdentifier
+{
+    NSString *baseIdentifier = @"cmis:document";
+    if ([typeIdentifier hasPrefix:kAlfrescoCMISFolderTypePrefix] || [typeIdentifier isEqualToString:@"cmis:folder"])
+    {
+        baseIdentifier = @"cmis:folder";
+    }
+    else if ([typeIdentifier hasPrefix:kAlfrescoCMISAspectPrefix])
+    {
+        // Alfresco 4.0 exposes aspects as policy types
+        baseIdentifier = @"cmis:policy";
+    }
+    return [self renderFixture:@"benchmark-type-entry.xml" values:@{@"typeId": typeIdentifier ?: @"cmis:document", @"baseId": baseIdentifier}];
+}
+
+- (NSData *)childrenFeedWithFolderIdentifier:(NSString *)folderIdentifier skipCount:(NSUInteger)skipCount maxItems:(NSUInteger)maxItems
+{
+    NSString *cacheKey = [NSString stringWithFormat:@"children-%lu-%lu", (unsigned long)skipCount, (unsigned long)maxItems];
+    NSData *feedData = [self.feedCache objectForKey:cacheKey];
+    if (nil != feedData)
+    {
+        return feedData;
+    }
+
+    NSString *childrenURL = [NSString stringWithFormat:@"%@%@/%@/children?id=%@", self.server.baseURL.absoluteString,
+                             kAlfrescoLegacyCMISAtomPath, kBenchmarkRepositoryId, folderIdentifier ?: kBenchmarkRootFolderId];
+    NSUInteger endIndex = MIN(skipCount + maxItems, self.childCount);
+    NSString *links = @"";
+    if (endIndex < self.childCount)
+    {
+        links = [NSString stringWithFormat:@"<atom:link rel=\"next\" type=\"application/atom+xml;type=feed\" href=\"%@&amp;skipCount=%lu&amp;maxItems=%lu\"/>",
+                 childrenURL, (unsigned long)endIndex, (unsigned long)maxItems];
+    }
+
+    NSRange range = NSMakeRange(MIN(skipCount, self.childCount), endIndex - MIN(skipCount, endIndex));
+    NSString *feed = [self feedWithTitle:@"Company Home" selfURL:childrenURL links:links numItems:self.childCount entries:[self.documentEntries subarrayWithRange:range]];
+    feedData = [feed dataUsingEncoding:NSUTF8StringEncoding];
+    [self.feedCache setObject:feedData forKey:cacheKey];
+    return feedData;
+}
+
+- (NSData *)queryFeedWithStatement:(NSString *)statement
+{
+    NSRange inRange = [statement rangeOfString:@"cmis:objectId IN ("];
+    if (inRange.location == NSNotFound)
+    {
+        return [self searchFeed];
+    }
+
+    // answer lookups by identifier with the matching entries, identifiers are quoted GUIDs or node references
+    NSString *inClause = [statement substringFromIndex:NSMaxRange(inRange)];
+    inClause = [inClause substringToIndex:[inClause rangeOfString:@")"].location];
+    NSMutableArray *entries = [NSMutableArray array];
+    for (NSString *quotedIdentifier in [inClause componentsSeparatedByString:@","])
+    {
+        NSString *identifier = [quotedIdentifier stringByTrimmingCharactersInSet:[NSCharacterSet characterSetWithCharactersInString:@"' "]];
+        if (![identifier hasPrefix:kBenchmarkStorePrefix])
+        {
+            identifier = [kBenchmarkStorePrefix stringByAppendingString:identifier];
+        }
+        [entries addObject:[self documentEntryWithIdentifier:identifier]];
+    }
+
+    NSString *queryURL = [NSString stringWithFormat:@"%@%@/%@/query", self.server.baseURL.absoluteString, kAlfrescoLegacyCMISAtomPath, kBenchmarkRepositoryId];
+    NSString *feed = [self feedWithTitle:@"query" selfURL:queryURL links:@"" numItems:entries.count entries:entries];
+    return [feed dataUsingEncoding:NSUTF8StringEncoding];
+}
+
+- (NSData *)searchFeed
+{
+    NSData *feedData = [self.feedCache objectForKey:@"search"];
+    if (nil == feedData)
+    {
+        NSUInteger resultCount = MIN(self.searchResultCount, self.childCount);
+        NSString *queryURL = [NSString stringWithFormat:@"%@%@/%@/query", self.server.baseURL.absoluteString, kAlfrescoLegacyCMISAtomPath, kBenchmarkRepositoryId];
+        NSString *feed = [self feedWithTitle:@"query" selfURL:queryURL links:@"" numItems:resultCount entries:[self.documentEntries subarrayWithRange:NSMakeRange(0, resultCount)]];
+        feedData = [feed dataUsingEncoding:NSUTF8StringEncoding];
+        [self.feedCache setObject:feedData forKey:@"search"];
+    }
+    return feedData;
+}
+
+- (NSString *)feedWithTitle:(NSString *)title selfURL:(NSString *)selfURL links:(NSString *)links numItems:(NSUInteger)numItems entries:(NSArray *)entries
+{
+    NSString *escapedSelfURL = [selfURL stringByReplacingOccurrencesOfString:@"&" withString:@"&amp;"];
+    return [self renderFixture:@"benchmark-feed.xml" values:@{@"feedId": [[NSUUID UUID] UUIDString],
+                                                              @"title": title,
+                                                              @"selfURL": escapedSelfURL,
+                                                              @"links": links,
+                                                              @"numItems": [@(numItems) stringValue],
+                                                              @"entries": [entries componentsJoinedByString:@"\n"]}];
+}
+
+- (NSString *)siteWithShortName:(NSString *)shortName index:(NSUInteger)index
+{
+    NSString *guid = [NSString stringWithFormat:@"5c1b7e2a-0000-4000-8000-%012lu", (unsigned long)index];
+    return [self renderFixture:@"benchmark-site.json" values:@{@"shortName": shortName,
+                                                               @"title": [NSString stringWithFormat:@"Benchmark Site %lu", (unsigned long)index],
+                                                               @"guid": guid}];
+}
+
+- (NSString *)siteShortNameAtIndex:(NSUInteger)index
+{
+    return [NSString stringWithFormat:@"benchmark-site-%05lu", (unsigned long)index];
+}
+
+- (NSData *)memberSitesData
+{
+    NSMutableArray *sites = [NSMutableArray arrayWithCapacity:self.siteCount];
+    for (NSUInteger index = 0; index < self.siteCount; index++)
+    {
+        [sites addObject:[self siteWithShortName:[self siteShortNameAtIndex:index] index:index]];
+    }
+    NSString *json = [NSString stringWithFormat:@"[%@]", [sites componentsJoinedByString:@",\n"]];
+    return [json dataUsingEncoding:NSUTF8StringEncoding];
+}
+
+- (NSData *)favoriteSitesData
+{
+    // every tenth member site is a favorite, as stored by Share's site preferences
+    NSMutableDictionary *favorites = [NSMutableDictionary dictionary];
+    for (NSUInteger index = 0; index < self.siteCount; index += 10)
+    {
+        favorites[[self siteShortNameAtIndex:index]] = @YES;
+    }
+    NSDictionary *preferences = @{@"org": @{@"alfresco": @{@"share": @{@"sites": @{@"favourites": favorites}}}}};
+    return [NSJSONSerialization dataWithJSONObject:preferences options:0 error:nil];
+}
+
+- (NSData *)publicAPIListDataWithEntryCount:(NSUInteger)entryCount
+{
+    NSMutableArray *entries = [NSMutableArray arrayWithCapacity:entryCount];
+    for (NSUInteger index = 0; index < entryCount; index++)
+    {
+        NSString *identifier = [NSString stringWithFormat:@"%012lu", (unsigned long)index];
+        [entries addObject:[self renderFixture:@"benchmark-activity-entry.json" values:@{@"id": identifier}]];
+    }
+    NSString *pagination = [NSString stringWithFormat:@"{\"count\": %lu, \"hasMoreItems\": true, \"totalItems\": %lu, \"skipCount\": 0, \"maxItems\": %lu}",
+                            (unsigned long)entryCount, (unsigned long)entryCount * 10, (unsigned long)entryCount];
+    NSString *list = [NSString stringWithFormat:@"{\"list\": {\"pagination\": %@, \"entries\": [%@]}}", pagination, [entries componentsJoinedByString:@",\n"]];
+    return [list dataUsingEncoding:NSUTF8StringEncoding];
+}
+
+- (NSData *)favoritesData
+{
+    NSUInteger favoriteCount = self.favoriteCount;
+    NSString *cacheKey = [NSString stringWithFormat:@"favorites-%lu", (unsigned long)favoriteCount];
+    NSData *favoritesData = [self.feedCache objectForKey:cacheKey];
+    if (nil == favoritesData)
+    {
+        // favorites reference their target by GUID, as returned by the public API
+        NSMutableArray *entries = [NSMutableArray arrayWithCapacity:favoriteCount];
+        for (NSUInteger index = 0; index < favoriteCount; index++)
+        {
+            NSString *guid = [[self nodeIdentifierAtIndex:index] substringFromIndex:kBenchmarkStorePrefix.length];
+            NSDictionary *target = @{@"file": @{@"guid": guid, @"id": guid, @"name": [NSString stringWithFormat:@"benchmark-%012lu.txt", (unsigned long)index]}};
+            [entries addObject:@{@"entry": @{@"targetGuid": guid, @"createdAt": kBenchmarkDate, @"target": target}}];
+        }
+        NSDictionary *pagination = @{@"count": @(favoriteCount), @"hasMoreItems": @NO, @"totalItems": @(favoriteCount), @"skipCount": @0, @"maxItems": @(MAX(favoriteCount, 100))};
+        NSDictionary *list = @{@"list": @{@"pagination": pagination, @"entries": entries}};
+        favoritesData = [NSJSONSerialization dataWithJSONObject:list options:0 error:nil];
+        [self.feedCache setObject:favoritesData forKey:cacheKey];
+    }
+    return favoritesData;
+}
+
+#pragma mark - Helpers
+
+- (NSUInteger)unsignedIntegerFromEnvironment:(NSString *)name defaultValue:(NSUInteger)defaultValue
+{
+    NSString *value = [[NSProcessInfo processInfo] environment][name];
+    return (value.length > 0) ? (NSUInteger)[value longLongValue] : defaultValue;
+}
+
+- (uint64_t)residentMemorySize
+{
+    struct mach_task_basic_info info;
+    mach_msg_type_number_t count = MACH_TASK_BASIC_INFO_COUNT;
+    kern_return_t result = task_info(mach_task_self(), MACH_TASK_BASIC_INFO, (task_info_t)&info, &count);
+    return (result == KERN_SUCCESS) ? info.resident_size : 0;
+}
+
+- (uint64_t)allocationCountOfBlock:(void (^)(void))block
+{
+    countedAllocationThread = pthread_self();
+    countedAllocations = 0;
+    previousMallocLogger = malloc_logger;
+    malloc_logger = AlfrescoBenchmarkCountAllocation;
+    block();
+    malloc_logger = previousMallocLogger;
+    previousMallocLogger = NULL;
+    return countedAllocations;
+}
+
+- (NSTimeInterval)processorTime
+{
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0)
+    {
+        return 0;
+    }
+    return usage.ru_utime.tv_sec + usage.ru_stime.tv_sec + (usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) / 1000000.0;
+}
+
+- (NSURL *)temporaryFileURLWithLength:(unsigned long long)length
+{
+    NSString *fileName = [NSString stringWithFormat:@"benchmark-%@.txt", [[NSUUID UUID] UUIDString]];
+    NSURL *fileURL = [NSURL fileURLWithPath:[NSTemporaryDirectory() stringByAppendingPathComponent:fileName]];
+    [[NSFileManager defaultManager] createFileAtPath:fileURL.path contents:nil attributes:nil];
+
+    NSFileHandle *fileHandle = [NSFileHandle fileHandleForWritingToURL:fileURL error:nil];
+    NSMutableData *chunk = [NSMutableData dataWithLength:1024 * 1024];
+    memset(chunk.mutableBytes, 'a', chunk.length);
+    for (unsigned long long written = 0; written < length; written += chunk.length)
+    {
+        NSUInteger chunkLength = (NSUInteger)MIN((unsigned long long)chunk.length, length - written);
+        [fileHandle writeData:[chunk subdataWithRange:NSMakeRange(0, chunkLength)]];
+    }
+    [fileHandle closeFile];
+    return fileURL;
+}
+
+@end
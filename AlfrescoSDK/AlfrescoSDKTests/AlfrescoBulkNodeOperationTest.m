@@ -0,0 +1,221 @@
+/*******************************************************************************
+ * Copyright (C) 2005-2020 Alfresco Software Limited.
+ *
+ * This file is part of the Alfresco Mobile SDK.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ******************************************************************************/
+
+#import <XCTest/XCTest.h>
+#import "AlfrescoBulkNodeOperation.h"
+#import "AlfrescoDocument.h"
+#import "CMISConstants.h"
+
+static NSTimeInterval const kNodeOperationDelay = 0.05;
+
+@interface AlfrescoBulkNodeOperationTest : XCTestCase
+@end
+
+@implementation AlfrescoBulkNodeOperationTest
+
+- (void)testResultsAndItemErrors
+{
+    XCTestExpectation *expectation = [self expectationWithDescription:@"Bulk operation completion expectation"];
+    
+    // a duplicate and a node without an identifier are not processed
+    NSMutableArray *nodes = [NSMutableArray arrayWithArray:[self documentsWithCount:10]];
+    [nodes addObject:nodes.firstObject];
+    [nodes addObject:[[AlfrescoDocument alloc] initWithProperties:@{kCMISPropertyObjectTypeId: @"cmis:document"}]];
+    
+    NSMutableArray *processedIdentifiers = [NSMutableArray array];
+    AlfrescoBulkNodeOperation *operation = [[AlfrescoBulkNodeOperation alloc] initWithNodes:nodes operationBlock:^AlfrescoRequest *(AlfrescoNode *node, AlfrescoBulkNodeItemCompletionBlock completionBlock) {
+        @synchronized(processedIdentifiers)
+        {
+            [processedIdentifiers addObject:node.identifier];
+        }
+        
+        // every other node fails
+        BOOL fails = ([[node.identifier substringFromIndex:node.identifier.length - 1] integerValue] % 2 == 1);
+        return [self requestCompletingNode:node error:(fails ? [AlfrescoErrors alfrescoErrorWithAlfrescoErrorCode:kAlfrescoErrorCodeAccessDenied] : nil) completionBlock:completionBlock];
+    }];
+    
+    [operation startWithRequest:[AlfrescoRequest new] completionBlock:^(NSDictionary *results, NSDictionary *itemErrors) {
+        XCTAssertTrue([NSThread isMainThread], @"Expected the completion block to be called on the main queue");
+        XCTAssertTrue(processedIdentifiers.count == 10, @"Expected every node to be processed once but there were %lu", (unsigned long)processedIdentifiers.count);
+        XCTAssertTrue(results.count == 5, @"Expected 5 results but there were %lu", (unsigned long)results.count);
+        XCTAssertTrue(itemErrors.count == 5, @"Expected 5 errors but there were %lu", (unsigned long)itemErrors.count);
+        XCTAssertEqual([itemErrors[@"workspace://SpacesStore/document-1"] code], kAlfrescoErrorCodeAccessDenied, @"Expected the error of the failed node");
+        
+        NSError *error = [AlfrescoBulkNodeOperation errorWithCode:kAlfrescoErrorCodeDocumentFolder itemErrors:itemErrors];
+        XCTAssertEqual(error.code, kAlfrescoErrorCodeDocumentFolder, @"Expected the given error code");
+        XCTAssertEqualObjects(error.userInfo[kAlfrescoErrorKeyItemErrors], itemErrors, @"Expected the errors of the failed nodes");
+        XCTAssertNil([AlfrescoBulkNodeOperation errorWithCode:kAlfrescoErrorCodeDocumentFolder itemErrors:@{}], @"Expected no error without failed nodes");
+        [expectation fulfill];
+    }];
+    
+    [self waitForExpectationsWithTimeout:30.0 handler:nil];
+}
+
+- (void)testConcurrencyAndProgress
+{
+    XCTestExpectation *expectation = [self expectationWithDescription:@"Bulk operation completion expectation"];
+    
+    NSArray *nodes = [self documentsWithCount:12];
+    NSObject *lock = [NSObject new];
+    __block NSUInteger inFlightCount = 0;
+    __block NSUInteger maxInFlightCount = 0;
+    AlfrescoBulkNodeOperation *operation = [[AlfrescoBulkNodeOperation alloc] initWithNodes:nodes operationBlock:^AlfrescoRequest *(AlfrescoNode *node, AlfrescoBulkNodeItemCompletionBlock completionBlock) {
+        @synchronized(lock)
+        {
+            inFlightCount++;
+            maxInFlightCount = MAX(maxInFlightCount, inFlightCount);
+        }
+        return [self requestCompletingNode:node error:nil completionBlock:^(id result, NSError *error) {
+            @synchronized(lock)
+            {
+                inFlightCount--;
+            }
+            completionBlock(result, error);
+        }];
+    }];
+    operation.maxConcurrent = 3;
+    operation.completionQueue = dispatch_queue_create("org.alfresco.mobile.test.bulknodeoperation", DISPATCH_QUEUE_SERIAL);
+    
+    NSMutableArray *progress = [NSMutableArray array];
+    operation.progressBlock = ^(unsigned long long completedCount, unsigned long long totalCount) {
+        XCTAssertTrue(totalCount == nodes.count, @"Expected the total to be the number of nodes");
+        [progress addObject:@(completedCount)];
+    };
+    
+    [operation startWithRequest:[AlfrescoRequest new] completionBlock:^(NSDictionary *results, NSDictionary *itemErrors) {
+        XCTAssertFalse([NSThread isMainThread], @"Expected the completion block to be called on the completion queue");
+        XCTAssertTrue(results.count == nodes.count, @"Expected a result for every node but there were %lu", (unsigned long)results.count);
+        XCTAssertTrue(maxInFlightCount <= 3, @"Expected at most 3 nodes in flight but there were %lu", (unsigned long)maxInFlightCount);
+        XCTAssertTrue(progress.count == nodes.count, @"Expected progress for every node but there was %lu", (unsigned long)progress.count);
+        XCTAssertEqualObjects(progress.lastObject, @(nodes.count), @"Expected the last progress to include every node");
+        [expectation fulfill];
+    }];
+    
+    [self waitForExpectationsWithTimeout:30.0 handler:nil];
+}
+
+- (void)testCancellation
+{
+    XCTestExpectation *expectation = [self expectationWithDescription:@"Bulk operation completion expectation"];
+    
+    NSArray *nodes = [self documentsWithCount:20];
+    AlfrescoBulkNodeOperation *operation = [[AlfrescoBulkNodeOperation alloc] initWithNodes:nodes operationBlock:^AlfrescoRequest *(AlfrescoNode *node, AlfrescoBulkNodeItemCompletionBlock completionBlock) {
+        return [self requestCompletingNode:node error:nil completionBlock:completionBlock];
+    }];
+    operation.maxConcurrent = 2;
+    
+    // cancel once the first node has completed
+    AlfrescoRequest *request = [AlfrescoRequest new];
+    operation.progressBlock = ^(unsigned long long completedCount, unsigned long long totalCount) {
+        [request cancel];
+    };
+    
+    [operation startWithRequest:request completionBlock:^(NSDictionary *results, NSDictionary *itemErrors) {
+        XCTAssertTrue(results.count + itemErrors.count == nodes.count, @"Expected every node to be reported");
+        XCTAssertTrue(results.count < nodes.count, @"Expected the nodes after the cancellation not to be processed");
+        XCTAssertEqual([itemErrors.allValues.firstObject code], kAlfrescoErrorCodeNetworkRequestCancelled, @"Expected the nodes to be reported as cancelled");
+        [expectation fulfill];
+    }];
+    
+    [self waitForExpectationsWithTimeout:30.0 handler:nil];
+}
+
+- (void)testNodesCompletingStraightAway
+{
+    XCTestExpectation *expectation = [self expectationWithDescription:@"Bulk operation completion expectation"];
+    
+    // enough nodes to run out of stack if each one started the next from its completion block
+    NSArray *nodes = [self documentsWithCount:10000];
+    NSMutableArray *nodeRequests = [NSMutableArray arrayWithCapacity:nodes.count];
+    AlfrescoBulkNodeOperation *operation = [[AlfrescoBulkNodeOperation alloc] initWithNodes:nodes operationBlock:^AlfrescoRequest *(AlfrescoNode *node, AlfrescoBulkNodeItemCompletionBlock completionBlock) {
+        AlfrescoRequest *nodeRequest = [AlfrescoRequest new];
+        @synchronized(nodeRequests)
+        {
+            [nodeRequests addObject:nodeRequest];
+        }
+        completionBlock(node, nil);
+        return nodeRequest;
+    }];
+    operation.maxConcurrent = 1;
+    
+    AlfrescoRequest *request = [AlfrescoRequest new];
+    [operation startWithRequest:request completionBlock:^(NSDictionary *results, NSDictionary *itemErrors) {
+        XCTAssertTrue(results.count == nodes.count, @"Expected a result for every node but there were %lu", (unsigned long)results.count);
+        XCTAssertTrue(itemErrors.count == 0, @"Expected no errors but there were %lu", (unsigned long)itemErrors.count);
+        
+        // the requests of completed nodes are no longer part of the operation
+        [request cancel];
+        for (AlfrescoRequest *nodeRequest in nodeRequests)
+        {
+            XCTAssertFalse(nodeRequest.isCancelled, @"Expected the request of a completed node not to be cancelled");
+        }
+        [expectation fulfill];
+    }];
+    
+    [self waitForExpectationsWithTimeout:30.0 handler:nil];
+}
+
+- (void)testNoNodes
+{
+    XCTestExpectation *expectation = [self expectationWithDescription:@"Bulk operation completion expectation"];
+    
+    AlfrescoBulkNodeOperation *operation = [[AlfrescoBulkNodeOperation alloc] initWithNodes:@[] operationBlock:^AlfrescoRequest *(AlfrescoNode *node, AlfrescoBulkNodeItemCompletionBlock completionBlock) {
+        XCTFail(@"Expected no node to be processed");
+        return nil;
+    }];
+    
+    [operation startWithRequest:[AlfrescoRequest new] completionBlock:^(NSDictionary *results, NSDictionary *itemErrors) {
+        XCTAssertTrue(results.count == 0 && itemErrors.count == 0, @"Expected no results and no errors");
+        [expectation fulfill];
+    }];
+    
+    [self waitForExpectationsWithTimeout:30.0 handler:nil];
+}
+
+#pragma mark - Private methods
+
+- (NSArray *)documentsWithCount:(NSUInteger)count
+{
+    NSMutableArray *documents = [NSMutableArray arrayWithCapacity:count];
+    for (NSUInteger index = 0; index < count; index++)
+    {
+        NSString *identifier = [NSString stringWithFormat:@"workspace://SpacesStore/document-%lu", (unsigned long)index];
+        [documents addObject:[[AlfrescoDocument alloc] initWithProperties:@{kCMISPropertyObjectId: identifier,
+                                                                            kCMISPropertyObjectTypeId: @"cmis:document"}]];
+    }
+    return documents;
+}
+
+/// Completes the node on a background queue after a short delay, a cancelled request completes it with a cancelled error.
+- (AlfrescoRequest *)requestCompletingNode:(AlfrescoNode *)node error:(NSError *)error completionBlock:(AlfrescoBulkNodeItemCompletionBlock)completionBlock
+{
+    AlfrescoRequest *request = [AlfrescoRequest new];
+    dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(kNodeOperationDelay * NSEC_PER_SEC)), dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
+        if (request.isCancelled)
+        {
+            completionBlock(nil, [AlfrescoErrors alfrescoErrorWithAlfrescoErrorCode:kAlfrescoErrorCodeNetworkRequestCancelled]);
+        }
+        else
+        {
+            completionBlock((nil == error) ? node : nil, error);
+        }
+    });
+    return request;
+}
+
+@end
@@ -0,0 +1,150 @@
+/*******************************************************************************
+ * Copyright (C) 2005-2020 Alfresco Software Limited.
+ *
+ * This file is part of the Alfresco Mobile SDK.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ******************************************************************************/
+
+#import <XCTest/XCTest.h>
+#import "AlfrescoContentFingerprint.h"
+#import "AlfrescoContentFingerprintStore.h"
+#import "AlfrescoDocument.h"
+#import "AlfrescoFolder.h"
+#import "CMISConstants.h"
+
+static NSString * const kAbcFingerprint = @"ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad";
+static NSString * const kCreatedTypeId = @"D:cm:content,P:cm:titled";
+
+@interface AlfrescoContentFingerprintTest : XCTestCase
+@property (nonatomic, strong) NSString *filePath;
+@property (nonatomic, strong) NSString *snapshotPath;
+@property (nonatomic, strong) AlfrescoFolder *folder;
+@end
+
+@implementation AlfrescoContentFingerprintTest
+
+- (void)setUp
+{
+    [super setUp];
+    
+    self.filePath = [NSTemporaryDirectory() stringByAppendingPathComponent:[[NSUUID UUID] UUIDString]];
+    self.snapshotPath = [NSTemporaryDirectory() stringByAppendingPathComponent:[[NSUUID UUID] UUIDString]];
+    self.folder = [[AlfrescoFolder alloc] initWithProperties:@{kCMISPropertyObjectId: @"workspace://SpacesStore/folder",
+                                                               kCMISPropertyObjectTypeId: @"cmis:folder"}];
+}
+
+- (void)tearDown
+{
+    [[NSFileManager defaultManager] removeItemAtPath:self.filePath error:nil];
+    [[NSFileManager defaultManager] removeItemAtPath:self.snapshotPath error:nil];
+    [super tearDown];
+}
+
+- (void)testFingerprintOfKnownContent
+{
+    AlfrescoContentFingerprint *fingerprint = [[AlfrescoContentFingerprint alloc] init];
+    [fingerprint updateWithBytes:"a" length:1];
+    [fingerprint updateWithBytes:"bc" length:2];
+    XCTAssertEqualObjects([fingerprint finish], kAbcFingerprint, @"Expected the SHA-256 digest of the bytes added");
+    XCTAssertTrue(fingerprint.length == 3, @"Expected every byte to be counted");
+    
+    [@"abc" writeToFile:self.filePath atomically:YES encoding:NSUTF8StringEncoding error:nil];
+    XCTAssertEqualObjects([AlfrescoContentFingerprint fingerprintOfFileAtPath:self.filePath error:nil], kAbcFingerprint, @"Expected the SHA-256 digest of the file");
+}
+
+- (void)testFingerprintOfFileLargerThanAChunk
+{
+    NSMutableData *content = [NSMutableData dataWithLength:3 * 1024 * 1024 + 17];
+    for (NSUInteger index = 0; index < content.length; index++)
+    {
+        ((uint8_t *)content.mutableBytes)[index] = (uint8_t)(index % 251);
+    }
+    [content writeToFile:self.filePath atomically:YES];
+    
+    AlfrescoContentFingerprint *fingerprint = [[AlfrescoContentFingerprint alloc] init];
+    [fingerprint updateWithBytes:content.bytes length:content.length];
+    XCTAssertEqualObjects([AlfrescoContentFingerprint fingerprintOfFileAtPath:self.filePath error:nil], [fingerprint finish], @"Expected the file to be fingerprinted as a whole");
+}
+
+- (void)testFingerprintOfMissingFileFails
+{
+    NSError *error = nil;
+    XCTAssertNil([AlfrescoContentFingerprint fingerprintOfFileAtPath:self.filePath error:&error], @"Expected no fingerprint of a missing file");
+    XCTAssertNotNil(error, @"Expected an error");
+}
+
+- (void)testFingerprintIsOnlyReturnedForItsVersion
+{
+    AlfrescoContentFingerprintStore *fingerprintStore = [[AlfrescoContentFingerprintStore alloc] init];
+    AlfrescoDocument *document = [self documentWithIdentifier:@"workspace://SpacesStore/document;1.0" modifiedAt:[NSDate dateWithTimeIntervalSince1970:1000] contentLength:3];
+    [fingerprintStore recordFingerprint:kAbcFingerprint ofDocument:document name:@"abc.txt" inFolder:self.folder properties:[self createdProperties]];
+    
+    XCTAssertEqualObjects([fingerprintStore fingerprintOfDocument:document], kAbcFingerprint, @"Expected the recorded fingerprint");
+    XCTAssertEqualObjects([fingerprintStore identifierOfDocumentWithName:@"abc.txt" inFolder:self.folder properties:[self createdProperties]], @"workspace://SpacesStore/document", @"Expected the identifier without the version label");
+    
+    AlfrescoDocument *modifiedDocument = [self documentWithIdentifier:@"workspace://SpacesStore/document;1.1" modifiedAt:[NSDate dateWithTimeIntervalSince1970:2000] contentLength:3];
+    XCTAssertNil([fingerprintStore fingerprintOfDocument:modifiedDocument], @"Expected no fingerprint for a later version");
+    
+    AlfrescoDocument *resizedDocument = [self documentWithIdentifier:@"workspace://SpacesStore/document;1.0" modifiedAt:[NSDate dateWithTimeIntervalSince1970:1000] contentLength:4];
+    XCTAssertNil([fingerprintStore fingerprintOfDocument:resizedDocument], @"Expected no fingerprint for other content");
+}
+
+- (void)testDocumentIsOnlyFoundForTheSameProperties
+{
+    AlfrescoContentFingerprintStore *fingerprintStore = [[AlfrescoContentFingerprintStore alloc] init];
+    AlfrescoDocument *document = [self documentWithIdentifier:@"workspace://SpacesStore/document;1.0" modifiedAt:[NSDate dateWithTimeIntervalSince1970:1000] contentLength:3];
+    [fingerprintStore recordFingerprint:kAbcFingerprint ofDocument:document name:@"abc.txt" inFolder:self.folder properties:[self createdProperties]];
+    
+    NSMutableDictionary *otherDescription = [[self createdProperties] mutableCopy];
+    otherDescription[kCMISPropertyDescription] = @"Another description";
+    XCTAssertNil([fingerprintStore identifierOfDocumentWithName:@"abc.txt" inFolder:self.folder properties:otherDescription], @"Expected no document created with another description");
+    
+    NSMutableDictionary *otherAspects = [[self createdProperties] mutableCopy];
+    otherAspects[kCMISPropertyObjectTypeId] = @"D:cm:content,P:cm:titled,P:cm:author";
+    XCTAssertNil([fingerprintStore identifierOfDocumentWithName:@"abc.txt" inFolder:self.folder properties:otherAspects], @"Expected no document created with other aspects");
+}
+
+- (void)testSnapshotIsReadByNextStore
+{
+    AlfrescoDocument *document = [self documentWithIdentifier:@"workspace://SpacesStore/document" modifiedAt:[NSDate dateWithTimeIntervalSince1970:1000] contentLength:3];
+    AlfrescoContentFingerprintStore *fingerprintStore = [[AlfrescoContentFingerprintStore alloc] initWithSnapshotPath:self.snapshotPath];
+    [fingerprintStore recordFingerprint:kAbcFingerprint ofDocument:document name:@"abc.txt" inFolder:self.folder properties:[self createdProperties]];
+    XCTAssertTrue([fingerprintStore writeSnapshot], @"Expected the snapshot to be written");
+    
+    AlfrescoContentFingerprintStore *nextStore = [[AlfrescoContentFingerprintStore alloc] initWithSnapshotPath:self.snapshotPath];
+    XCTAssertEqualObjects([nextStore fingerprintOfDocument:document], kAbcFingerprint, @"Expected the fingerprint to be read from the snapshot");
+    XCTAssertNotNil([nextStore identifierOfDocumentWithName:@"abc.txt" inFolder:self.folder properties:[self createdProperties]], @"Expected the created document to be read from the snapshot");
+    
+    [nextStore clear];
+    XCTAssertNil([nextStore fingerprintOfDocument:document], @"Expected the fingerprints to be forgotten");
+}
+
+#pragma mark - Private methods
+
+- (NSDictionary *)createdProperties
+{
+    return @{kCMISPropertyName: @"abc.txt",
+             kCMISPropertyObjectTypeId: kCreatedTypeId,
+             kCMISPropertyDescription: @"A description"};
+}
+
+- (AlfrescoDocument *)documentWithIdentifier:(NSString *)identifier modifiedAt:(NSDate *)modifiedAt contentLength:(unsigned long long)contentLength
+{
+    return [[AlfrescoDocument alloc] initWithProperties:@{kCMISPropertyObjectId: identifier,
+                                                          kCMISPropertyObjectTypeId: @"cmis:document",
+                                                          kCMISPropertyModificationDate: modifiedAt,
+                                                          kCMISPropertyContentStreamLength: @(contentLength)}];
+}
+
+@end
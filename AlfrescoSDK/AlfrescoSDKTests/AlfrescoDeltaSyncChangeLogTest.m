@@ -0,0 +1,291 @@
+/*******************************************************************************
+ * Copyright (C) 2005-2020 Alfresco Software Limited.
+ *
+ * This file is part of the Alfresco Mobile SDK.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ******************************************************************************/
+
+#import <XCTest/XCTest.h>
+#import "AlfrescoStubServer.h"
+#import "AlfrescoDeltaSyncService.h"
+#import "AlfrescoCMISObjectConverter.h"
+#import "AlfrescoInternalConstants.h"
+#import "CMISSession.h"
+#import "CMISSessionParameters.h"
+#import "CMISConstants.h"
+
+static NSString * const kRepositoryId = @"repository";
+static NSString * const kFolderIdentifier = @"workspace://SpacesStore/folder";
+static NSString * const kDocumentIdentifier = @"workspace://SpacesStore/document";
+
+// the minimum of a session the delta sync service needs to talk to the stub server
+@interface AlfrescoDeltaSyncTestSession : NSObject <AlfrescoSession>
+@property (nonatomic, strong) NSString *personIdentifier;
+@property (nonatomic, strong) AlfrescoRepositoryInfo *repositoryInfo;
+@property (nonatomic, strong) NSURL *baseUrl;
+@property (nonatomic, strong) AlfrescoFolder *rootFolder;
+@property (nonatomic, strong) AlfrescoListingContext *defaultListingContext;
+@property (nonatomic, strong) id<AlfrescoNetworkProvider> networkProvider;
+@property (nonatomic, strong) NSMutableDictionary *parameters;
+@end
+
+@implementation AlfrescoDeltaSyncTestSession
+
+- (NSArray *)allParameterKeys
+{
+    return [self.parameters allKeys];
+}
+
+- (id)objectForParameter:(id)key
+{
+    return self.parameters[key];
+}
+
+- (void)setObject:(id)object forParameter:(id)key
+{
+    self.parameters[key] = object;
+}
+
+- (void)addParametersFromDictionary:(NSDictionary *)dictionary
+{
+    [self.parameters addEntriesFromDictionary:dictionary];
+}
+
+- (void)removeParameter:(id)key
+{
+    [self.parameters removeObjectForKey:key];
+}
+
+- (void)clear
+{
+}
+
+@end
+
+@interface AlfrescoDeltaSyncChangeLogTest : XCTestCase
+@property (nonatomic, strong) AlfrescoStubServer *server;
+@property (nonatomic, strong) AlfrescoDeltaSyncService *deltaSyncService;
+@property (atomic, strong) NSString *latestChangeLogToken;
+/// change log token -> @[identifiers of the changed objects, token of the next page or NSNull]
+@property (atomic, strong) NSDictionary *changePages;
+@property (atomic, strong) NSMutableArray *requestedChangeLogTokens;
+@property (atomic, assign) NSUInteger childrenRequestCount;
+@property (atomic, assign) NSUInteger serviceDocumentRequestCount;
+@end
+
+@implementation AlfrescoDeltaSyncChangeLogTest
+
+- (void)setUp
+{
+    [super setUp];
+    
+    self.latestChangeLogToken = @"10";
+    self.changePages = @{};
+    self.requestedChangeLogTokens = [NSMutableArray array];
+    self.server = [[AlfrescoStubServer alloc] init];
+    NSError *error = nil;
+    XCTAssertTrue([self.server startAndReturnError:&error], @"Failed to start the stub server: %@", error);
+    [self installRoutes];
+    
+    CMISSessionParameters *parameters = [[CMISSessionParameters alloc] initWithBindingType:CMISBindingTypeAtomPub];
+    parameters.atomPubUrl = [self.server.baseURL URLByAppendingPathComponent:@"cmisatom"];
+    parameters.repositoryId = kRepositoryId;
+    parameters.username = @"admin";
+    parameters.password = @"admin";
+    [parameters setObject:@(NO) forKey:kCMISSessionParameterCheckNetworkReachability];
+    [parameters setObject:NSStringFromClass([AlfrescoCMISObjectConverter class]) forKey:kCMISSessionParameterObjectConverterClassName];
+    
+    XCTestExpectation *expectation = [self expectationWithDescription:@"Connect"];
+    __block CMISSession *cmisSession = nil;
+    [CMISSession connectWithSessionParameters:parameters completionBlock:^(CMISSession *session, NSError *connectError) {
+        XCTAssertNotNil(session, @"Failed to connect to the stub server: %@", connectError);
+        cmisSession = session;
+        [expectation fulfill];
+    }];
+    [self waitForExpectationsWithTimeout:10 handler:nil];
+    
+    AlfrescoDeltaSyncTestSession *session = [[AlfrescoDeltaSyncTestSession alloc] init];
+    session.baseUrl = self.server.baseURL;
+    session.defaultListingContext = [[AlfrescoListingContext alloc] init];
+    session.parameters = [NSMutableDictionary dictionary];
+    [session setObject:cmisSession forParameter:kAlfrescoSessionKeyCmisSession];
+    self.deltaSyncService = [[AlfrescoDeltaSyncService alloc] initWithSession:session];
+}
+
+- (void)tearDown
+{
+    [self.server stop];
+    [super tearDown];
+}
+
+- (void)testChangeLogContinuesFromLatestToken
+{
+    AlfrescoDeltaSyncResult *initialResult = [self syncWithToken:nil];
+    XCTAssertTrue(initialResult.createdNodes.count == 1, @"Expected the first sync to report the document as created");
+    XCTAssertEqualObjects(initialResult.syncToken.changeLogToken, @"10", @"Expected the first sync to start at the latest change");
+    XCTAssertTrue(self.childrenRequestCount == 1, @"Expected the folder to be listed");
+    
+    // the document changed twice, the log spans two pages and the repository has moved on to the next token
+    self.changePages = @{@"10": @[@[kDocumentIdentifier], @"11"],
+                         @"11": @[@[kDocumentIdentifier], [NSNull null]],
+                         @"12": @[@[], [NSNull null]]};
+    self.latestChangeLogToken = @"12";
+    
+    AlfrescoDeltaSyncResult *changedResult = [self syncWithToken:initialResult.syncToken];
+    XCTAssertTrue(changedResult.usedChangeLog, @"Expected the change log to be read");
+    XCTAssertEqualObjects(changedResult.syncToken.changeLogToken, @"12", @"Expected the next sync to start after the last change read");
+    XCTAssertTrue(self.childrenRequestCount == 2, @"Expected the folder of the changed document to be listed again");
+    
+    AlfrescoDeltaSyncResult *unchangedResult = [self syncWithToken:changedResult.syncToken];
+    XCTAssertTrue(unchangedResult.usedChangeLog, @"Expected the change log to be read");
+    XCTAssertEqualObjects(unchangedResult.syncToken.changeLogToken, @"12", @"Expected the token to stay at the latest change");
+    XCTAssertTrue(unchangedResult.createdNodes.count == 0 && unchangedResult.updatedNodes.count == 0, @"Expected no changes to be reported");
+    XCTAssertTrue(self.childrenRequestCount == 2, @"Expected the folder not to be listed again but it was listed %lu times", (unsigned long)self.childrenRequestCount);
+    XCTAssertEqualObjects(self.requestedChangeLogTokens, (@[@"10", @"11", @"12"]), @"Expected every page of the change log to be read once");
+}
+
+- (void)testChangeLogPagesAreAllRead
+{
+    AlfrescoDeltaSyncResult *initialResult = [self syncWithToken:nil];
+    
+    NSMutableDictionary *changePages = [NSMutableDictionary dictionary];
+    for (NSUInteger page = 10; page < 15; page++)
+    {
+        NSString *identifier = (page == 14) ? kDocumentIdentifier : [NSString stringWithFormat:@"workspace://SpacesStore/unwatched-%lu", (unsigned long)page];
+        id nextToken = (page == 14) ? [NSNull null] : [NSString stringWithFormat:@"%lu", (unsigned long)page + 1];
+        changePages[[NSString stringWithFormat:@"%lu", (unsigned long)page]] = @[@[identifier], nextToken];
+    }
+    self.changePages = changePages;
+    self.latestChangeLogToken = @"15";
+    
+    NSUInteger serviceDocumentRequestCount = self.serviceDocumentRequestCount;
+    AlfrescoDeltaSyncResult *changedResult = [self syncWithToken:initialResult.syncToken];
+    XCTAssertTrue(self.requestedChangeLogTokens.count == 5, @"Expected all five pages to be read but got %lu", (unsigned long)self.requestedChangeLogTokens.count);
+    XCTAssertTrue(self.serviceDocumentRequestCount - serviceDocumentRequestCount == 1, @"Expected the latest token to be read once per sync but it was read %lu times", (unsigned long)(self.serviceDocumentRequestCount - serviceDocumentRequestCount));
+    XCTAssertEqualObjects(changedResult.syncToken.changeLogToken, @"15", @"Expected the next sync to start after the last change read");
+    XCTAssertTrue(self.childrenRequestCount == 2, @"Expected the folder to be listed again for the change on the last page");
+}
+
+#pragma mark - Private methods
+
+- (AlfrescoDeltaSyncResult *)syncWithToken:(AlfrescoDeltaSyncToken *)syncToken
+{
+    XCTestExpectation *expectation = [self expectationWithDescription:@"Sync"];
+    __block AlfrescoDeltaSyncResult *syncResult = nil;
+    [self.deltaSyncService syncFolderIdentifiers:@[kFolderIdentifier] nodeIdentifiers:nil syncToken:syncToken completionBlock:^(AlfrescoDeltaSyncResult *result, NSError *error) {
+        XCTAssertNotNil(result, @"Failed to sync: %@", error);
+        syncResult = result;
+        [expectation fulfill];
+    }];
+    [self waitForExpectationsWithTimeout:10 handler:nil];
+    return syncResult;
+}
+
+- (void)installRoutes
+{
+    __weak typeof(self) weakSelf = self;
+    NSString *baseURL = self.server.baseURL.absoluteString;
+    NSString *repositoryPath = [NSString stringWithFormat:@"/cmisatom/%@/", kRepositoryId];
+    NSString *atomEntry = @"application/atom+xml;type=entry;charset=UTF-8";
+    NSString *atomFeed = @"application/atom+xml;type=feed;charset=UTF-8";
+    
+    [self.server addRouteWithMethod:@"GET" pathPrefix:[repositoryPath stringByAppendingString:@"changes"] handler:^AlfrescoStubResponse *(AlfrescoStubRequest *request) {
+        NSString *changeLogToken = request.queryParameters[kCMISParameterChangeLogToken];
+        [weakSelf.requestedChangeLogTokens addObject:changeLogToken ?: @""];
+        NSArray *page = weakSelf.changePages[changeLogToken];
+        NSMutableString *entries = [NSMutableString string];
+        for (NSString *identifier in page.firstObject)
+        {
+            [entries appendString:[weakSelf entryWithIdentifier:identifier baseType:kCMISPropertyObjectTypeIdValueDocument links:@""]];
+        }
+        NSString *links = @"";
+        if ([page.lastObject isKindOfClass:[NSString class]])
+        {
+            links = [NSString stringWithFormat:@"<atom:link rel=\"next\" type=\"application/atom+xml;type=feed\" href=\"%@%@changes?changeLogToken=%@\"/>", baseURL, repositoryPath, page.lastObject];
+        }
+        return [AlfrescoStubResponse responseWithStatusCode:200 contentType:atomFeed body:[weakSelf feedWithLinks:links entries:entries]];
+    }];
+    
+    [self.server addRouteWithMethod:@"GET" pathPrefix:[repositoryPath stringByAppendingString:@"children"] handler:^AlfrescoStubResponse *(AlfrescoStubRequest *request) {
+        weakSelf.childrenRequestCount++;
+        NSString *entry = [weakSelf entryWithIdentifier:kDocumentIdentifier baseType:kCMISPropertyObjectTypeIdValueDocument links:@""];
+        return [AlfrescoStubResponse responseWithStatusCode:200 contentType:atomFeed body:[weakSelf feedWithLinks:@"" entries:entry]];
+    }];
+    
+    [self.server addRouteWithMethod:@"GET" pathPrefix:[repositoryPath stringByAppendingString:@"id"] handler:^AlfrescoStubResponse *(AlfrescoStubRequest *request) {
+        NSString *identifier = request.queryParameters[@"id"];
+        NSString *entry = nil;
+        if ([identifier isEqualToString:kFolderIdentifier])
+        {
+            NSString *downLink = [NSString stringWithFormat:@"<atom:link rel=\"down\" type=\"application/atom+xml;type=feed\" href=\"%@%@children?id=%@\"/>", baseURL, repositoryPath, kFolderIdentifier];
+            entry = [weakSelf entryWithIdentifier:kFolderIdentifier baseType:kCMISPropertyObjectTypeIdValueFolder links:downLink];
+        }
+        else
+        {
+            entry = [weakSelf entryWithIdentifier:identifier baseType:kCMISPropertyObjectTypeIdValueDocument links:@""];
+        }
+        return [AlfrescoStubResponse responseWithStatusCode:200 contentType:atomEntry body:[entry dataUsingEncoding:NSUTF8StringEncoding]];
+    }];
+    
+    [self.server addRouteWithMethod:@"GET" pathPrefix:@"/cmisatom" handler:^AlfrescoStubResponse *(AlfrescoStubRequest *request) {
+        if (![request.path isEqualToString:@"/cmisatom"])
+        {
+            return nil;
+        }
+        weakSelf.serviceDocumentRequestCount++;
+        NSString *serviceDocument = [NSString stringWithFormat:
+            @"<?xml version=\"1.0\" encoding=\"UTF-8\"?>"
+            @"<app:service xmlns:cmis=\"http://docs.oasis-open.org/ns/cmis/core/200908/\" xmlns:cmisra=\"http://docs.oasis-open.org/ns/cmis/restatom/200908/\" xmlns:atom=\"http://www.w3.org/2005/Atom\" xmlns:app=\"http://www.w3.org/2007/app\">"
+            @"<app:workspace><atom:title>Main Repository</atom:title>"
+            @"<app:collection href=\"%1$@%2$@children?id=%3$@\"><cmisra:collectionType>root</cmisra:collectionType><atom:title type=\"text\">Root Collection</atom:title></app:collection>"
+            @"<app:collection href=\"%1$@%2$@query\"><cmisra:collectionType>query</cmisra:collectionType><atom:title type=\"text\">Query Collection</atom:title></app:collection>"
+            @"<cmisra:repositoryInfo><cmis:repositoryId>%4$@</cmis:repositoryId><cmis:rootFolderId>%3$@</cmis:rootFolderId>"
+            @"<cmis:latestChangeLogToken>%5$@</cmis:latestChangeLogToken>"
+            @"<cmis:capabilities><cmis:capabilityChanges>objectidsonly</cmis:capabilityChanges></cmis:capabilities>"
+            @"<cmis:cmisVersionSupported>1.0</cmis:cmisVersionSupported></cmisra:repositoryInfo>"
+            @"<atom:link rel=\"http://docs.oasis-open.org/ns/cmis/link/200908/changes\" type=\"application/atom+xml;type=feed\" href=\"%1$@%2$@changes\"/>"
+            @"<cmisra:uritemplate><cmisra:template>%1$@%2$@id?id={id}&amp;filter={filter}&amp;includeAllowableActions={includeAllowableActions}&amp;includeACL={includeACL}&amp;includePolicyIds={includePolicyIds}&amp;includeRelationships={includeRelationships}&amp;renditionFilter={renditionFilter}</cmisra:template>"
+            @"<cmisra:type>objectbyid</cmisra:type><cmisra:mediatype>application/atom+xml;type=entry</cmisra:mediatype></cmisra:uritemplate>"
+            @"</app:workspace></app:service>",
+            baseURL, repositoryPath, kFolderIdentifier, kRepositoryId, weakSelf.latestChangeLogToken];
+        return [AlfrescoStubResponse responseWithStatusCode:200 contentType:@"application/atomsvc+xml;charset=UTF-8" body:[serviceDocument dataUsingEncoding:NSUTF8StringEncoding]];
+    }];
+}
+
+- (NSData *)feedWithLinks:(NSString *)links entries:(NSString *)entries
+{
+    NSString *feed = [NSString stringWithFormat:
+        @"<?xml version=\"1.0\" encoding=\"UTF-8\"?>"
+        @"<atom:feed xmlns:cmis=\"http://docs.oasis-open.org/ns/cmis/core/200908/\" xmlns:cmisra=\"http://docs.oasis-open.org/ns/cmis/restatom/200908/\" xmlns:atom=\"http://www.w3.org/2005/Atom\" xmlns:app=\"http://www.w3.org/2007/app\">"
+        @"<atom:id>urn:uuid:feed</atom:id><atom:title>feed</atom:title>%@%@</atom:feed>", links, entries];
+    return [feed dataUsingEncoding:NSUTF8StringEncoding];
+}
+
+- (NSString *)entryWithIdentifier:(NSString *)identifier baseType:(NSString *)baseType links:(NSString *)links
+{
+    return [NSString stringWithFormat:
+        @"<atom:entry xmlns:cmis=\"http://docs.oasis-open.org/ns/cmis/core/200908/\" xmlns:cmisra=\"http://docs.oasis-open.org/ns/cmis/restatom/200908/\" xmlns:atom=\"http://www.w3.org/2005/Atom\">"
+        @"<atom:id>urn:uuid:%1$@</atom:id><atom:title>%1$@</atom:title>"
+        @"<cmisra:object><cmis:properties>"
+        @"<cmis:propertyId propertyDefinitionId=\"cmis:objectId\"><cmis:value>%1$@</cmis:value></cmis:propertyId>"
+        @"<cmis:propertyId propertyDefinitionId=\"cmis:baseTypeId\"><cmis:value>%2$@</cmis:value></cmis:propertyId>"
+        @"<cmis:propertyId propertyDefinitionId=\"cmis:objectTypeId\"><cmis:value>%2$@</cmis:value></cmis:propertyId>"
+        @"<cmis:propertyString propertyDefinitionId=\"cmis:name\"><cmis:value>%3$@</cmis:value></cmis:propertyString>"
+        @"<cmis:propertyString propertyDefinitionId=\"cmis:changeToken\"><cmis:value>1</cmis:value></cmis:propertyString>"
+        @"<cmis:propertyDateTime propertyDefinitionId=\"cmis:lastModificationDate\"><cmis:value>2012-01-01T12:00:00.000Z</cmis:value></cmis:propertyDateTime>"
+        @"</cmis:properties></cmisra:object>%4$@</atom:entry>",
+        identifier, baseType, identifier.lastPathComponent, links];
+}
+
+@end
@@ -0,0 +1,101 @@
+/*******************************************************************************
+ * Copyright (C) 2005-2020 Alfresco Software Limited.
+ * 
+ * This file is part of the Alfresco Mobile SDK.
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *  
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ******************************************************************************/
+
+#import "AlfrescoDeltaSyncServiceTest.h"
+#import "AlfrescoObjectConverter.h"
+
+@implementation AlfrescoDeltaSyncServiceTest
+
+- (void)testDeltaSyncReportsOnlyChanges
+{
+    if (self.setUpSuccess)
+    {
+        self.deltaSyncService = [[AlfrescoDeltaSyncService alloc] initWithSession:self.currentSession];
+        AlfrescoDocumentFolderService *documentService = [[AlfrescoDocumentFolderService alloc] initWithSession:self.currentSession];
+        NSArray *folders = @[self.testDocFolder.identifier];
+        NSArray *nodes = @[self.testAlfrescoDocument.identifier];
+        NSString *documentIdentifier = [AlfrescoObjectConverter nodeRefWithoutVersionID:self.testAlfrescoDocument.identifier];
+        
+        // first sync reports everything as created
+        [self.deltaSyncService syncFolderIdentifiers:folders nodeIdentifiers:nodes syncToken:nil completionBlock:^(AlfrescoDeltaSyncResult *initialResult, NSError *initialError) {
+            if (nil == initialResult)
+            {
+                self.lastTestSuccessful = NO;
+                self.lastTestFailureMessage = [self failureMessageFromError:initialError];
+                self.callbackCompleted = YES;
+                return;
+            }
+            
+            XCTAssertTrue(initialResult.createdNodes.count > 0, @"Expected the first sync to report the folder children as created");
+            XCTAssertTrue(initialResult.updatedNodes.count == 0, @"Expected no updated nodes on the first sync");
+            XCTAssertNotNil(initialResult.syncToken.nodeStates[documentIdentifier], @"Expected the test document state to be recorded");
+            
+            // nothing changed since, nothing should be reported
+            [self.deltaSyncService syncFolderIdentifiers:folders nodeIdentifiers:nodes syncToken:initialResult.syncToken completionBlock:^(AlfrescoDeltaSyncResult *unchangedResult, NSError *unchangedError) {
+                if (nil == unchangedResult)
+                {
+                    self.lastTestSuccessful = NO;
+                    self.lastTestFailureMessage = [self failureMessageFromError:unchangedError];
+                    self.callbackCompleted = YES;
+                    return;
+                }
+                
+                XCTAssertTrue(unchangedResult.createdNodes.count == 0, @"Expected no created nodes but got %lu", (unsigned long)unchangedResult.createdNodes.count);
+                XCTAssertTrue(unchangedResult.updatedNodes.count == 0, @"Expected no updated nodes but got %lu", (unsigned long)unchangedResult.updatedNodes.count);
+                XCTAssertTrue(unchangedResult.deletedNodeIdentifiers.count == 0, @"Expected no deleted nodes");
+                
+                NSDictionary *properties = @{@"cm:description": @"delta sync"};
+                [documentService updatePropertiesOfNode:self.testAlfrescoDocument properties:properties completionBlock:^(AlfrescoNode *updatedNode, NSError *updateError) {
+                    if (nil == updatedNode)
+                    {
+                        self.lastTestSuccessful = NO;
+                        self.lastTestFailureMessage = [self failureMessageFromError:updateError];
+                        self.callbackCompleted = YES;
+                        return;
+                    }
+                    
+                    [self.deltaSyncService syncFolderIdentifiers:folders nodeIdentifiers:nodes syncToken:unchangedResult.syncToken completionBlock:^(AlfrescoDeltaSyncResult *updatedResult, NSError *updatedError) {
+                        if (nil == updatedResult)
+                        {
+                            self.lastTestSuccessful = NO;
+                            self.lastTestFailureMessage = [self failureMessageFromError:updatedError];
+                        }
+                        else
+                        {
+                            XCTAssertTrue(updatedResult.updatedNodes.count == 1, @"Expected only the test document to be updated but got %lu", (unsigned long)updatedResult.updatedNodes.count);
+                            AlfrescoNode *node = updatedResult.updatedNodes.firstObject;
+                            XCTAssertEqualObjects([AlfrescoObjectConverter nodeRefWithoutVersionID:node.identifier], documentIdentifier, @"Expected the test document to be updated");
+                            XCTAssertTrue(updatedResult.createdNodes.count == 0, @"Expected no created nodes");
+                            self.lastTestSuccessful = YES;
+                        }
+                        self.callbackCompleted = YES;
+                    }];
+                }];
+            }];
+        }];
+        
+        [self waitUntilCompleteWithFixedTimeInterval];
+        XCTAssertTrue(self.lastTestSuccessful, @"%@", self.lastTestFailureMessage);
+    }
+    else
+    {
+        XCTFail(@"Could not run test case: %@", NSStringFromSelector(_cmd));
+    }
+}
+
+@end
@@ -24,6 +24,63 @@
 #import "AlfrescoInternalConstants.h"
 #import "AlfrescoTaggingService.h"
 #import "AlfrescoVersionService.h"
+#import "CMISDefaultNetworkProvider.h"
+
+// CMIS network provider that counts the HTTP requests issued through it
+
+@interface AlfrescoCountingCMISNetworkProvider : CMISDefaultNetworkProvider
+@property (atomic, assign) NSUInteger requestCount;
+@end
+
+@implementation AlfrescoCountingCMISNetworkProvider
+
+- (void)invoke:(NSURL *)url
+    httpMethod:(CMISHttpRequestMethod)httpRequestMethod
+       session:(CMISBindingSession *)session
+          body:(NSData *)body
+       headers:(NSDictionary *)additionalHeaders
+   cmisRequest:(CMISRequest *)cmisRequest
+completionBlock:(void (^)(CMISHttpResponse *httpResponse, NSError *error))completionBlock
+{
+    self.requestCount++;
+    [super invoke:url httpMethod:httpRequestMethod session:session body:body headers:additionalHeaders cmisRequest:cmisRequest completionBlock:completionBlock];
+}
+
+- (void)invoke:(NSURL *)url
+    httpMethod:(CMISHttpRequestMethod)httpRequestMethod
+       session:(CMISBindingSession *)session
+   inputStream:(NSInputStream *)inputStream
+       headers:(NSDictionary *)additionalHeaders
+ bytesExpected:(unsigned long long)bytesExpected
+   cmisRequest:(CMISRequest *)cmisRequest
+completionBlock:(void (^)(CMISHttpResponse *httpResponse, NSError *error))completionBlock
+ progressBlock:(void (^)(unsigned long long bytesDownloaded, unsigned long long bytesTotal))progressBlock
+{
+    self.requestCount++;
+    [super invoke:url httpMethod:httpRequestMethod session:session inputStream:inputStream headers:additionalHeaders bytesExpected:bytesExpected
+      cmisRequest:cmisRequest completionBlock:completionBlock progressBlock:progressBlock];
+}
+
+- (void)invoke:(NSURL *)url
+    httpMethod:(CMISHttpRequestMethod)httpRequestMethod
+       session:(CMISBindingSession *)session
+   inputStream:(NSInputStream *)inputStream
+       headers:(NSDictionary *)additionalHeaders
+ bytesExpected:(unsigned long long)bytesExpected
+   cmisRequest:(CMISRequest *)cmisRequest
+     startData:(NSData *)startData
+       endData:(NSData *)endData
+useBase64Encoding:(BOOL)useBase64Encoding
+completionBlock:(void (^)(CMISHttpResponse *httpResponse, NSError *error))completionBlock
+ progressBlock:(void (^)(unsigned long long bytesDownloaded, unsigned long long bytesTotal))progressBlock
+{
+    self.requestCount++;
+    [super invoke:url httpMethod:httpRequestMethod session:session inputStream:inputStream headers:additionalHeaders bytesExpected:bytesExpected
+      cmisRequest:cmisRequest startData:startData endData:endData useBase64Encoding:useBase64Encoding completionBlock:completionBlock progressBlock:progressBlock];
+}
+
+@end
+
 
 @implementation AlfrescoDocumentFolderServiceTest
 /*
@@ -2629,6 +2686,82 @@
     }
 }
 
+/**
+ Content updates should go straight to the binding without pre-fetching the document.
+ Browser binding: a single POST. AtomPub: the PUT plus one retrieval of the new version.
+ */
+- (void)testUpdateContentForDocumentRoundTrips
+{
+    AlfrescoRepositoryInfo *repositoryInfo = [self.currentSession repositoryInfo];
+    if (self.isCloud || [repositoryInfo.majorVersion integerValue] == 4)
+    {
+        return;
+    }
+    
+    if (self.setUpSuccess)
+    {
+        // open a second session whose CMIS requests are counted
+        AlfrescoCountingCMISNetworkProvider *countingProvider = [[AlfrescoCountingCMISNetworkProvider alloc] init];
+        AlfrescoDocument *testDocument = self.testAlfrescoDocument;
+        if (![self authenticateOnPremiseServer:[NSMutableDictionary dictionaryWithObject:countingProvider forKey:kAlfrescoCMISNetworkProvider]])
+        {
+            XCTFail(@"Could not create session with counting network provider");
+            return;
+        }
+        [self resetTestVariables];
+        
+        CMISSession *cmisSession = [self.currentSession objectForParameter:kAlfrescoSessionKeyCmisSession];
+        BOOL isBrowserBinding = (cmisSession.sessionParameters.bindingType == CMISBindingTypeBrowser);
+        self.dfService = [[AlfrescoDocumentFolderService alloc] initWithSession:self.currentSession];
+        __weak AlfrescoDocumentFolderService *weakDfService = self.dfService;
+        
+        // retrieve the node first, as a browsing client would have done, so the AtomPub link cache is warm
+        [self.dfService retrieveNodeWithIdentifier:testDocument.identifier completionBlock:^(AlfrescoNode *node, NSError *retrieveError) {
+            if (nil == node)
+            {
+                self.lastTestSuccessful = NO;
+                self.lastTestFailureMessage = [self failureMessageFromError:retrieveError];
+                self.callbackCompleted = YES;
+            }
+            else
+            {
+                NSData *data = [@"updated content for the round trip test" dataUsingEncoding:NSUTF8StringEncoding];
+                AlfrescoContentFile *updatedContentFile = [[AlfrescoContentFile alloc] initWithData:data mimeType:@"text/plain"];
+                
+                countingProvider.requestCount = 0;
+                NSDate *start = [NSDate date];
+                [weakDfService updateContentOfDocument:(AlfrescoDocument *)node contentFile:updatedContentFile completionBlock:^(AlfrescoDocument *updatedDocument, NSError *updateError) {
+                    NSTimeInterval elapsed = [[NSDate date] timeIntervalSinceDate:start];
+                    AlfrescoLogInfo(@"Content update took %.3fs and %lu requests", elapsed, (unsigned long)countingProvider.requestCount);
+                    
+                    if (nil == updatedDocument)
+                    {
+                        self.lastTestSuccessful = NO;
+                        self.lastTestFailureMessage = [self failureMessageFromError:updateError];
+                    }
+                    else
+                    {
+                        XCTAssertTrue(updatedDocument.contentLength == data.length, @"expected the returned document to reflect the new content length");
+                        NSUInteger expectedRequests = isBrowserBinding ? 1 : 2;
+                        XCTAssertTrue(countingProvider.requestCount <= expectedRequests, @"expected at most %lu requests but %lu were made",
+                                      (unsigned long)expectedRequests, (unsigned long)countingProvider.requestCount);
+                        self.testAlfrescoDocument = updatedDocument;
+                        self.lastTestSuccessful = YES;
+                    }
+                    self.callbackCompleted = YES;
+                } progressBlock:nil];
+            }
+        }];
+        
+        [self waitUntilCompleteWithFixedTimeInterval];
+        XCTAssertTrue(self.lastTestSuccessful, @"%@", self.lastTestFailureMessage);
+    }
+    else
+    {
+        XCTFail(@"Could not run test case: %@", NSStringFromSelector(_cmd));
+    }
+}
+
 /**
  @Unique_TCRef 33S0
  @Unique_TCRef 30F1
@@ -4310,6 +4443,43 @@
     }
 }
 
+- (void)testRetrieveRenditionsOfNodesReportsFailedNodes
+{
+    if (self.setUpSuccess)
+    {
+        self.dfService = [[AlfrescoDocumentFolderService alloc] initWithSession:self.currentSession];
+        
+        // the folder is listed twice but must only be requested, and reported, once
+        NSArray *nodes = @[self.testDocFolder, self.testDocFolder];
+        [self.dfService retrieveRenditionsOfNodes:nodes renditionName:kAlfrescoThumbnailRendition completionBlock:^(NSDictionary *contentFiles, NSError *error) {
+            
+            NSDictionary *itemErrors = error.userInfo[kAlfrescoErrorKeyItemErrors];
+            if (nil == error || contentFiles.count > 0)
+            {
+                self.lastTestSuccessful = NO;
+                self.lastTestFailureMessage = @"Retrieving the rendition of a folder should fail";
+            }
+            else
+            {
+                XCTAssertEqual(error.code, kAlfrescoErrorCodeDocumentFolder, @"Expected a document folder error");
+                XCTAssertEqual(itemErrors.count, 1, @"Expected one item error");
+                XCTAssertNotNil(itemErrors[self.testDocFolder.identifier], @"Expected the error to be reported against the folder");
+                
+                self.lastTestSuccessful = YES;
+            }
+            
+            self.callbackCompleted = YES;
+        }];
+        
+        [self waitUntilCompleteWithFixedTimeInterval];
+        XCTAssertTrue(self.lastTestSuccessful, @"%@", self.lastTestFailureMessage);
+    }
+    else
+    {
+        XCTFail(@"Could not run test case: %@", NSStringFromSelector(_cmd));
+    }
+}
+
 // REMOVED DUE TO ERROR SEEN ONLY WHEN RUNNING ON SERVER 4.1
 ///*
 // @Unique_TCRef 31F4
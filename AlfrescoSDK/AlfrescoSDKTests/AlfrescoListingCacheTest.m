@@ -0,0 +1,194 @@
+/*******************************************************************************
+ * Copyright (C) 2005-2020 Alfresco Software Limited.
+ *
+ * This file is part of the Alfresco Mobile SDK.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ******************************************************************************/
+
+#import <XCTest/XCTest.h>
+#import "AlfrescoStubServer.h"
+#import "AlfrescoListingCache.h"
+#import "AlfrescoLegacyAPITaggingService.h"
+#import "AlfrescoDefaultNetworkProvider.h"
+#import "AlfrescoInternalConstants.h"
+
+static NSUInteger const kTagCount = 50;
+static int const kPageSize = 10;
+
+// the minimum of a session the services need to talk to the stub server
+@interface AlfrescoListingCacheTestSession : NSObject <AlfrescoSession>
+@property (nonatomic, strong) NSString *personIdentifier;
+@property (nonatomic, strong) AlfrescoRepositoryInfo *repositoryInfo;
+@property (nonatomic, strong) NSURL *baseUrl;
+@property (nonatomic, strong) AlfrescoFolder *rootFolder;
+@property (nonatomic, strong) AlfrescoListingContext *defaultListingContext;
+@property (nonatomic, strong) id<AlfrescoNetworkProvider> networkProvider;
+@property (nonatomic, strong) NSMutableDictionary *parameters;
+@end
+
+@implementation AlfrescoListingCacheTestSession
+
+- (NSArray *)allParameterKeys
+{
+    return [self.parameters allKeys];
+}
+
+- (id)objectForParameter:(id)key
+{
+    return self.parameters[key];
+}
+
+- (void)setObject:(id)object forParameter:(id)key
+{
+    self.parameters[key] = object;
+}
+
+- (void)addParametersFromDictionary:(NSDictionary *)dictionary
+{
+    [self.parameters addEntriesFromDictionary:dictionary];
+}
+
+- (void)removeParameter:(id)key
+{
+    [self.parameters removeObjectForKey:key];
+}
+
+- (void)clear
+{
+    for (id cacheObj in [self.parameters allValues])
+    {
+        if ([cacheObj respondsToSelector:@selector(clear)])
+        {
+            [cacheObj clear];
+        }
+    }
+}
+
+@end
+
+@interface AlfrescoListingCacheTest : XCTestCase
+@property (nonatomic, strong) AlfrescoStubServer *server;
+@property (nonatomic, strong) AlfrescoListingCacheTestSession *session;
+@property (nonatomic, strong) AlfrescoLegacyAPITaggingService *taggingService;
+@end
+
+@implementation AlfrescoListingCacheTest
+
+- (void)setUp
+{
+    [super setUp];
+    
+    // the legacy tags API always returns every tag, whatever page is asked for
+    NSMutableArray *tags = [NSMutableArray array];
+    for (NSUInteger index = 0; index < kTagCount; index++)
+    {
+        [tags addObject:[NSString stringWithFormat:@"tag%02lu", (unsigned long)index]];
+    }
+    NSData *body = [NSJSONSerialization dataWithJSONObject:tags options:0 error:nil];
+    self.server = [[AlfrescoStubServer alloc] init];
+    [self.server addRouteWithMethod:@"GET" pathPrefix:@"/service/api/tags" handler:^AlfrescoStubResponse *(AlfrescoStubRequest *request) {
+        return [AlfrescoStubResponse responseWithStatusCode:200 contentType:@"application/json" body:body];
+    }];
+    NSError *error = nil;
+    XCTAssertTrue([self.server startAndReturnError:&error], @"Failed to start the stub server: %@", error);
+    
+    self.session = [[AlfrescoListingCacheTestSession alloc] init];
+    self.session.baseUrl = self.server.baseURL;
+    self.session.defaultListingContext = [[AlfrescoListingContext alloc] init];
+    self.session.networkProvider = [[AlfrescoDefaultNetworkProvider alloc] init];
+    self.session.parameters = [NSMutableDictionary dictionary];
+    self.taggingService = [[AlfrescoLegacyAPITaggingService alloc] initWithSession:self.session];
+}
+
+- (void)tearDown
+{
+    [self.server stop];
+    [super tearDown];
+}
+
+- (void)testFollowingPagesAreTakenFromCache
+{
+    AlfrescoPagingResult *firstPage = [self retrieveTagsWithSkipCount:0];
+    XCTAssertTrue(firstPage.objects.count == kPageSize, @"Expected a full first page");
+    XCTAssertTrue(firstPage.hasMoreItems, @"Expected more pages to follow");
+    XCTAssertTrue(self.server.requestCount == 1, @"Expected the first page to be fetched");
+    unsigned long long bytesForFirstPage = self.server.bodyBytesSent;
+    
+    for (int skipCount = kPageSize; skipCount < (int)kTagCount; skipCount += kPageSize)
+    {
+        AlfrescoPagingResult *page = [self retrieveTagsWithSkipCount:skipCount];
+        XCTAssertTrue(page.objects.count == kPageSize, @"Expected a full page at %d", skipCount);
+        XCTAssertEqualObjects([page.objects.firstObject value], ([NSString stringWithFormat:@"tag%02d", skipCount]), @"Expected the page to start at %d", skipCount);
+    }
+    XCTAssertTrue(self.server.requestCount == 1, @"Expected the following pages to be taken from the cache but %lu requests were sent", (unsigned long)self.server.requestCount);
+    XCTAssertTrue(self.server.bodyBytesSent == bytesForFirstPage, @"Expected no transfer for the following pages");
+    
+    // reloading the listing fetches it again so changes show up
+    [self retrieveTagsWithSkipCount:0];
+    XCTAssertTrue(self.server.requestCount == 2, @"Expected the first page to be fetched again");
+}
+
+- (void)testExpiredListingIsFetchedAgain
+{
+    [AlfrescoListingCache listingCacheForSession:self.session].timeToLive = 0;
+    
+    [self retrieveTagsWithSkipCount:0];
+    AlfrescoPagingResult *secondPage = [self retrieveTagsWithSkipCount:kPageSize];
+    XCTAssertTrue(secondPage.objects.count == kPageSize, @"Expected a full second page");
+    XCTAssertTrue(self.server.requestCount == 2, @"Expected the expired listing to be fetched again");
+}
+
+- (void)testClearingSessionClearsCache
+{
+    [self retrieveTagsWithSkipCount:0];
+    [self.session clear];
+    [self retrieveTagsWithSkipCount:kPageSize];
+    XCTAssertTrue(self.server.requestCount == 2, @"Expected the cleared listing to be fetched again");
+}
+
+- (void)testCacheKeyIncludesSortOrderAndFilter
+{
+    AlfrescoListingCache *listingCache = [[AlfrescoListingCache alloc] init];
+    AlfrescoListingContext *ascending = [[AlfrescoListingContext alloc] initWithMaxItems:kPageSize skipCount:0 sortProperty:@"name" sortAscending:YES];
+    [listingCache cacheObjects:@[@"a", @"b"] forListing:@"listing" listingContext:ascending];
+    
+    AlfrescoListingContext *nextPage = [[AlfrescoListingContext alloc] initWithMaxItems:kPageSize skipCount:kPageSize sortProperty:@"name" sortAscending:YES];
+    XCTAssertEqualObjects([listingCache objectsForListing:@"listing" listingContext:nextPage], (@[@"a", @"b"]), @"Expected the paging settings not to be part of the key");
+    
+    AlfrescoListingContext *descending = [[AlfrescoListingContext alloc] initWithMaxItems:kPageSize skipCount:kPageSize sortProperty:@"name" sortAscending:NO];
+    XCTAssertNil([listingCache objectsForListing:@"listing" listingContext:descending], @"Expected the sort order to be part of the key");
+    
+    AlfrescoListingFilter *filter = [[AlfrescoListingFilter alloc] initWithFilter:kAlfrescoFilterByWorkflowStatus value:kAlfrescoFilterValueWorkflowStatusActive];
+    AlfrescoListingContext *filtered = [[AlfrescoListingContext alloc] initWithMaxItems:kPageSize skipCount:kPageSize sortProperty:@"name" sortAscending:YES listingFilter:filter];
+    XCTAssertNil([listingCache objectsForListing:@"listing" listingContext:filtered], @"Expected the filter to be part of the key");
+    XCTAssertNil([listingCache objectsForListing:@"other" listingContext:nextPage], @"Expected the listing to be part of the key");
+}
+
+#pragma mark - Private methods
+
+- (AlfrescoPagingResult *)retrieveTagsWithSkipCount:(int)skipCount
+{
+    AlfrescoListingContext *listingContext = [[AlfrescoListingContext alloc] initWithMaxItems:kPageSize skipCount:skipCount];
+    XCTestExpectation *expectation = [self expectationWithDescription:[NSString stringWithFormat:@"Tags from %d", skipCount]];
+    __block AlfrescoPagingResult *result = nil;
+    [self.taggingService retrieveAllTagsWithListingContext:listingContext completionBlock:^(AlfrescoPagingResult *pagingResult, NSError *error) {
+        XCTAssertNil(error, @"Failed to retrieve the tags: %@", error);
+        result = pagingResult;
+        [expectation fulfill];
+    }];
+    [self waitForExpectationsWithTimeout:10 handler:nil];
+    return result;
+}
+
+@end
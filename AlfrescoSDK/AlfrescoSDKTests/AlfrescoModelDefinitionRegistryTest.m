@@ -0,0 +1,349 @@
+/*******************************************************************************
+ * Copyright (C) 2005-2020 Alfresco Software Limited.
+ *
+ * This file is part of the Alfresco Mobile SDK.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ******************************************************************************/
+
+#import <XCTest/XCTest.h>
+#import "AlfrescoModelDefinitionRegistry.h"
+#import "AlfrescoModelDefinitionService.h"
+#import "AlfrescoDocument.h"
+#import "AlfrescoDocumentTypeDefinition.h"
+#import "AlfrescoInternalConstants.h"
+#import "AlfrescoErrors.h"
+#import "CMISSession.h"
+#import "CMISRequest.h"
+#import "CMISErrors.h"
+#import "CMISTypeDefinition.h"
+#import "CMISPropertyDefinition.h"
+
+static NSUInteger const kAspectCount = 30;
+
+// answers type definition requests after a short delay and counts how often each type was asked for
+@interface AlfrescoModelDefinitionTestCMISSession : CMISSession
+@property (nonatomic, strong) NSCountedSet *requestedTypes;
+@property (nonatomic, assign) NSUInteger cancelledCount;
+@end
+
+@implementation AlfrescoModelDefinitionTestCMISSession
+
+- (CMISRequest *)retrieveTypeDefinition:(NSString *)typeId completionBlock:(void (^)(CMISTypeDefinition *typeDefinition, NSError *error))completionBlock
+{
+    @synchronized(self)
+    {
+        [self.requestedTypes addObject:typeId];
+    }
+    
+    CMISRequest *request = [[CMISRequest alloc] init];
+    dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(0.05 * NSEC_PER_SEC)), dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
+        if (request.isCancelled)
+        {
+            @synchronized(self)
+            {
+                self.cancelledCount++;
+            }
+            completionBlock(nil, [CMISErrors createCMISErrorWithCode:kCMISErrorCodeCancelled detailedDescription:@"Request was cancelled"]);
+            return;
+        }
+        
+        CMISTypeDefinition *typeDefinition = [[CMISTypeDefinition alloc] init];
+        typeDefinition.identifier = typeId;
+        typeDefinition.baseTypeId = [typeId isEqualToString:kCMISPropertyObjectTypeIdValueDocument] ? CMISBaseTypeDocument : CMISBaseTypeSecondary;
+        CMISPropertyDefinition *propertyDefinition = [[CMISPropertyDefinition alloc] init];
+        propertyDefinition.identifier = [typeId stringByAppendingString:@".property"];
+        propertyDefinition.propertyType = CMISPropertyTypeString;
+        [typeDefinition addPropertyDefinition:propertyDefinition];
+        completionBlock(typeDefinition, nil);
+    });
+    return request;
+}
+
+@end
+
+// the minimum of a session the model definition service needs
+@interface AlfrescoModelDefinitionTestSession : NSObject <AlfrescoSession>
+@property (nonatomic, strong) NSString *personIdentifier;
+@property (nonatomic, strong) AlfrescoRepositoryInfo *repositoryInfo;
+@property (nonatomic, strong) NSURL *baseUrl;
+@property (nonatomic, strong) AlfrescoFolder *rootFolder;
+@property (nonatomic, strong) AlfrescoListingContext *defaultListingContext;
+@property (nonatomic, strong) id<AlfrescoNetworkProvider> networkProvider;
+@property (nonatomic, strong) NSMutableDictionary *parameters;
+@end
+
+@implementation AlfrescoModelDefinitionTestSession
+
+- (NSArray *)allParameterKeys
+{
+    return [self.parameters allKeys];
+}
+
+- (id)objectForParameter:(id)key
+{
+    return self.parameters[key];
+}
+
+- (void)setObject:(id)object forParameter:(id)key
+{
+    self.parameters[key] = object;
+}
+
+- (void)addParametersFromDictionary:(NSDictionary *)dictionary
+{
+    [self.parameters addEntriesFromDictionary:dictionary];
+}
+
+- (void)removeParameter:(id)key
+{
+    [self.parameters removeObjectForKey:key];
+}
+
+- (void)clear
+{
+    for (id cacheObj in [self.parameters allValues])
+    {
+        if ([cacheObj respondsToSelector:@selector(clear)])
+        {
+            [cacheObj clear];
+        }
+    }
+}
+
+@end
+
+@interface AlfrescoModelDefinitionRegistryTest : XCTestCase
+@property (nonatomic, strong) AlfrescoModelDefinitionTestCMISSession *cmisSession;
+@property (nonatomic, strong) AlfrescoModelDefinitionTestSession *session;
+@property (nonatomic, strong) AlfrescoDocument *document;
+@property (nonatomic, strong) NSString *snapshotPath;
+@end
+
+@implementation AlfrescoModelDefinitionRegistryTest
+
+- (void)setUp
+{
+    [super setUp];
+    
+    self.snapshotPath = [NSTemporaryDirectory() stringByAppendingPathComponent:@"AlfrescoModelDefinitionRegistryTest.snapshot"];
+    [[NSFileManager defaultManager] removeItemAtPath:self.snapshotPath error:nil];
+    self.session = [self sessionWithParameters:nil];
+    self.cmisSession = [self.session objectForParameter:kAlfrescoSessionKeyCmisSession];
+    
+    NSMutableArray *aspects = [NSMutableArray arrayWithCapacity:kAspectCount];
+    for (NSUInteger index = 0; index < kAspectCount; index++)
+    {
+        [aspects addObject:[NSString stringWithFormat:@"test:aspect%02lu", (unsigned long)index]];
+    }
+    self.document = [[AlfrescoDocument alloc] initWithProperties:@{kCMISPropertyObjectId: @"workspace://SpacesStore/document",
+                                                                   kCMISPropertyObjectTypeId: kAlfrescoModelTypeContent,
+                                                                   kAlfrescoNodeAspects: aspects}];
+}
+
+- (void)tearDown
+{
+    [[NSFileManager defaultManager] removeItemAtPath:self.snapshotPath error:nil];
+    [super tearDown];
+}
+
+- (void)testConcurrentRetrievalLoadsEveryDefinitionOnce
+{
+    // two services of the same session ask for the same node at the same time
+    AlfrescoModelDefinitionService *firstService = [[AlfrescoModelDefinitionService alloc] initWithSession:self.session];
+    AlfrescoModelDefinitionService *secondService = [[AlfrescoModelDefinitionService alloc] initWithSession:self.session];
+    
+    NSMutableArray *typeDefinitions = [NSMutableArray array];
+    XCTestExpectation *firstExpectation = [self expectationWithDescription:@"first retrieval"];
+    XCTestExpectation *secondExpectation = [self expectationWithDescription:@"second retrieval"];
+    [firstService retrieveDefinitionForDocument:self.document completionBlock:^(AlfrescoDocumentTypeDefinition *typeDefinition, NSError *error) {
+        XCTAssertNotNil(typeDefinition, @"Expected a type definition but got error %@", error);
+        @synchronized(typeDefinitions)
+        {
+            [typeDefinitions addObject:typeDefinition ?: [NSNull null]];
+        }
+        [firstExpectation fulfill];
+    }];
+    [secondService retrieveDefinitionForDocument:self.document completionBlock:^(AlfrescoDocumentTypeDefinition *typeDefinition, NSError *error) {
+        XCTAssertNotNil(typeDefinition, @"Expected a type definition but got error %@", error);
+        @synchronized(typeDefinitions)
+        {
+            [typeDefinitions addObject:typeDefinition ?: [NSNull null]];
+        }
+        [secondExpectation fulfill];
+    }];
+    [self waitForExpectationsWithTimeout:10 handler:nil];
+    
+    AlfrescoModelDefinitionRegistry *registry = [AlfrescoModelDefinitionRegistry registryForSession:self.session];
+    XCTAssertTrue(registry.loadCount == kAspectCount + 1, @"Expected %lu loads but there were %lu", (unsigned long)(kAspectCount + 1), (unsigned long)registry.loadCount);
+    for (NSString *typeId in self.cmisSession.requestedTypes)
+    {
+        XCTAssertTrue([self.cmisSession.requestedTypes countForObject:typeId] == 1, @"Expected %@ to be requested once", typeId);
+    }
+    
+    // every node gets its own copy of the type definition with the aspect properties added
+    XCTAssertTrue(typeDefinitions.count == 2, @"Expected each completion block to be called once");
+    for (AlfrescoDocumentTypeDefinition *typeDefinition in typeDefinitions)
+    {
+        XCTAssertTrue(typeDefinition.propertyNames.count == kAspectCount + 1, @"Expected %lu properties but there were %lu", (unsigned long)(kAspectCount + 1), (unsigned long)typeDefinition.propertyNames.count);
+    }
+    XCTAssertTrue(typeDefinitions[0] != typeDefinitions[1], @"Expected separate type definitions");
+    AlfrescoModelDefinition *registeredType = [registry definitionForIdentifier:kCMISPropertyObjectTypeIdValueDocument];
+    XCTAssertTrue(registeredType.propertyNames.count == 1, @"Expected the registered type definition to be left alone");
+    
+    // all definitions are known now, so nothing more is loaded
+    XCTestExpectation *cachedExpectation = [self expectationWithDescription:@"cached retrieval"];
+    [firstService retrieveDefinitionForDocument:self.document completionBlock:^(AlfrescoDocumentTypeDefinition *typeDefinition, NSError *error) {
+        XCTAssertNotNil(typeDefinition, @"Expected a type definition but got error %@", error);
+        [cachedExpectation fulfill];
+    }];
+    [self waitForExpectationsWithTimeout:10 handler:nil];
+    XCTAssertTrue(self.cmisSession.requestedTypes.count == kAspectCount + 1, @"Expected no further requests");
+}
+
+- (void)testCancellationReachesEverySubRequest
+{
+    AlfrescoModelDefinitionService *service = [[AlfrescoModelDefinitionService alloc] initWithSession:self.session];
+    __block NSUInteger completionCount = 0;
+    XCTestExpectation *expectation = [self expectationWithDescription:@"cancelled retrieval"];
+    
+    // the type definition is loaded first, the aspects are cancelled while they are in flight
+    __block AlfrescoRequest *request = nil;
+    request = [service retrieveDefinitionForDocument:self.document completionBlock:^(AlfrescoDocumentTypeDefinition *typeDefinition, NSError *error) {
+        completionCount++;
+        XCTAssertNil(typeDefinition, @"Expected no type definition");
+        XCTAssertTrue(error.code == kAlfrescoErrorCodeNetworkRequestCancelled, @"Expected a cancelled error but got %@", error);
+        [expectation fulfill];
+    }];
+    dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(0.08 * NSEC_PER_SEC)), dispatch_get_main_queue(), ^{
+        [request cancel];
+    });
+    [self waitForExpectationsWithTimeout:10 handler:nil];
+    
+    // give the cancelled requests time to come back
+    [[NSRunLoop currentRunLoop] runUntilDate:[NSDate dateWithTimeIntervalSinceNow:0.2]];
+    XCTAssertTrue(completionCount == 1, @"Expected the completion block to be called once but it was called %lu times", (unsigned long)completionCount);
+    XCTAssertTrue(self.cmisSession.cancelledCount == kAspectCount, @"Expected %lu cancelled requests but there were %lu", (unsigned long)kAspectCount, (unsigned long)self.cmisSession.cancelledCount);
+    
+    // the cancelled loads are started again by the next caller
+    XCTestExpectation *retryExpectation = [self expectationWithDescription:@"retrieval after cancellation"];
+    [service retrieveDefinitionForDocument:self.document completionBlock:^(AlfrescoDocumentTypeDefinition *typeDefinition, NSError *error) {
+        XCTAssertNotNil(typeDefinition, @"Expected a type definition but got error %@", error);
+        [retryExpectation fulfill];
+    }];
+    [self waitForExpectationsWithTimeout:10 handler:nil];
+}
+
+- (void)testSnapshotIsUsedByTheNextSessionOfTheSameServerVersion
+{
+    AlfrescoModelDefinitionTestSession *session = [self sessionWithParameters:@{kAlfrescoModelDefinitionSnapshotPath: self.snapshotPath}];
+    AlfrescoModelDefinitionService *service = [[AlfrescoModelDefinitionService alloc] initWithSession:session];
+    XCTestExpectation *expectation = [self expectationWithDescription:@"retrieval"];
+    [service retrieveDefinitionForDocument:self.document completionBlock:^(AlfrescoDocumentTypeDefinition *typeDefinition, NSError *error) {
+        XCTAssertNotNil(typeDefinition, @"Expected a type definition but got error %@", error);
+        [expectation fulfill];
+    }];
+    [self waitForExpectationsWithTimeout:10 handler:nil];
+    XCTAssertTrue([[AlfrescoModelDefinitionRegistry registryForSession:session] writeSnapshot], @"Expected the snapshot to be written");
+    
+    // a warm start needs no requests at all
+    AlfrescoModelDefinitionTestSession *warmSession = [self sessionWithParameters:@{kAlfrescoModelDefinitionSnapshotPath: self.snapshotPath}];
+    AlfrescoModelDefinitionTestCMISSession *warmCMISSession = [warmSession objectForParameter:kAlfrescoSessionKeyCmisSession];
+    AlfrescoModelDefinitionService *warmService = [[AlfrescoModelDefinitionService alloc] initWithSession:warmSession];
+    __block BOOL calledBack = NO;
+    [warmService retrieveDefinitionForDocument:self.document completionBlock:^(AlfrescoDocumentTypeDefinition *typeDefinition, NSError *error) {
+        XCTAssertTrue(typeDefinition.propertyNames.count == kAspectCount + 1, @"Expected the definitions from the snapshot");
+        calledBack = YES;
+    }];
+    XCTAssertTrue(calledBack, @"Expected the definitions to be known straight away");
+    XCTAssertTrue(warmCMISSession.requestedTypes.count == 0, @"Expected no requests with the snapshot");
+    
+    // a snapshot of another server version is ignored
+    AlfrescoModelDefinitionTestSession *otherVersionSession = [self sessionWithParameters:@{kAlfrescoModelDefinitionSnapshotPath: self.snapshotPath}];
+    otherVersionSession.repositoryInfo = [self repositoryInfoWithIdentifier:@"repository" version:@"5.0.0"];
+    XCTAssertNil([[AlfrescoModelDefinitionRegistry registryForSession:otherVersionSession] definitionForIdentifier:kCMISPropertyObjectTypeIdValueDocument],
+                 @"Expected the snapshot to be ignored");
+}
+
+- (void)testSnapshotOfAnotherRepositoryIsIgnored
+{
+    AlfrescoModelDefinitionTestSession *session = [self sessionWithParameters:@{kAlfrescoModelDefinitionSnapshotPath: self.snapshotPath}];
+    [self retrieveDefinitionsAndWriteSnapshotForSession:session];
+    
+    // the same version of another repository may have other models deployed
+    AlfrescoModelDefinitionTestSession *otherRepositorySession = [self sessionWithParameters:@{kAlfrescoModelDefinitionSnapshotPath: self.snapshotPath}];
+    otherRepositorySession.repositoryInfo = [self repositoryInfoWithIdentifier:@"otherRepository" version:session.repositoryInfo.version];
+    XCTAssertNil([[AlfrescoModelDefinitionRegistry registryForSession:otherRepositorySession] definitionForIdentifier:kCMISPropertyObjectTypeIdValueDocument],
+                 @"Expected the snapshot of another repository to be ignored");
+    
+    AlfrescoModelDefinitionTestSession *otherURLSession = [self sessionWithParameters:@{kAlfrescoModelDefinitionSnapshotPath: self.snapshotPath}];
+    otherURLSession.baseUrl = [NSURL URLWithString:@"https://other.example.com/alfresco"];
+    XCTAssertNil([[AlfrescoModelDefinitionRegistry registryForSession:otherURLSession] definitionForIdentifier:kCMISPropertyObjectTypeIdValueDocument],
+                 @"Expected the snapshot of another URL to be ignored");
+    
+    AlfrescoModelDefinitionTestSession *sameRepositorySession = [self sessionWithParameters:@{kAlfrescoModelDefinitionSnapshotPath: self.snapshotPath}];
+    XCTAssertNotNil([[AlfrescoModelDefinitionRegistry registryForSession:sameRepositorySession] definitionForIdentifier:kCMISPropertyObjectTypeIdValueDocument],
+                    @"Expected the snapshot of the same repository to be used");
+}
+
+- (void)testExpiredSnapshotIsIgnored
+{
+    AlfrescoModelDefinitionTestSession *session = [self sessionWithParameters:@{kAlfrescoModelDefinitionSnapshotPath: self.snapshotPath}];
+    [self retrieveDefinitionsAndWriteSnapshotForSession:session];
+    [NSThread sleepForTimeInterval:0.2];
+    
+    AlfrescoModelDefinitionTestSession *expiredSession = [self sessionWithParameters:@{kAlfrescoModelDefinitionSnapshotPath: self.snapshotPath,
+                                                                                      kAlfrescoModelDefinitionSnapshotMaxAge: @(0.1)}];
+    XCTAssertNil([[AlfrescoModelDefinitionRegistry registryForSession:expiredSession] definitionForIdentifier:kCMISPropertyObjectTypeIdValueDocument],
+                 @"Expected the expired snapshot to be ignored");
+    
+    AlfrescoModelDefinitionTestSession *recentSession = [self sessionWithParameters:@{kAlfrescoModelDefinitionSnapshotPath: self.snapshotPath,
+                                                                                     kAlfrescoModelDefinitionSnapshotMaxAge: @(60)}];
+    XCTAssertNotNil([[AlfrescoModelDefinitionRegistry registryForSession:recentSession] definitionForIdentifier:kCMISPropertyObjectTypeIdValueDocument],
+                    @"Expected the recent snapshot to be used");
+}
+
+#pragma mark - Helper methods
+
+- (AlfrescoModelDefinitionTestSession *)sessionWithParameters:(NSDictionary *)parameters
+{
+    AlfrescoModelDefinitionTestCMISSession *cmisSession = [[AlfrescoModelDefinitionTestCMISSession alloc] init];
+    cmisSession.requestedTypes = [NSCountedSet set];
+    
+    AlfrescoModelDefinitionTestSession *session = [[AlfrescoModelDefinitionTestSession alloc] init];
+    session.parameters = [NSMutableDictionary dictionaryWithDictionary:parameters ?: @{}];
+    session.parameters[kAlfrescoSessionKeyCmisSession] = cmisSession;
+    session.repositoryInfo = [self repositoryInfoWithIdentifier:@"repository" version:@"4.2.0"];
+    session.baseUrl = [NSURL URLWithString:@"https://example.com/alfresco"];
+    return session;
+}
+
+- (AlfrescoRepositoryInfo *)repositoryInfoWithIdentifier:(NSString *)identifier version:(NSString *)version
+{
+    return [[AlfrescoRepositoryInfo alloc] initWithProperties:@{kAlfrescoRepositoryIdentifier: identifier,
+                                                                kAlfrescoRepositoryVersion: version}];
+}
+
+- (void)retrieveDefinitionsAndWriteSnapshotForSession:(AlfrescoModelDefinitionTestSession *)session
+{
+    AlfrescoModelDefinitionService *service = [[AlfrescoModelDefinitionService alloc] initWithSession:session];
+    XCTestExpectation *expectation = [self expectationWithDescription:@"retrieval"];
+    [service retrieveDefinitionForDocument:self.document completionBlock:^(AlfrescoDocumentTypeDefinition *typeDefinition, NSError *error) {
+        XCTAssertNotNil(typeDefinition, @"Expected a type definition but got error %@", error);
+        [expectation fulfill];
+    }];
+    [self waitForExpectationsWithTimeout:10 handler:nil];
+    XCTAssertTrue([[AlfrescoModelDefinitionRegistry registryForSession:session] writeSnapshot], @"Expected the snapshot to be written");
+}
+
+@end
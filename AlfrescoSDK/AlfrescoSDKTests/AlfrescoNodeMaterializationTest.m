@@ -0,0 +1,169 @@
+/*******************************************************************************
+ * Copyright (C) 2005-2020 Alfresco Software Limited.
+ *
+ * This file is part of the Alfresco Mobile SDK.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ******************************************************************************/
+
+#import <XCTest/XCTest.h>
+#import <malloc/malloc.h>
+#import "AlfrescoCMISToAlfrescoObjectConverter.h"
+#import "AlfrescoCMISDocument.h"
+#import "CMISDocument.h"
+#import "AlfrescoInternalConstants.h"
+#import "AlfrescoProperty.h"
+#import "CMISObjectData.h"
+#import "CMISProperties.h"
+#import "CMISPropertyData.h"
+#import "CMISExtensionElement.h"
+#import "CMISAtomPubConstants.h"
+#import "CMISConstants.h"
+
+static NSUInteger const kFixtureEntryCount = 10000;
+static NSUInteger const kFixturePropertyCount = 20;
+
+@interface AlfrescoNodeMaterializationTest : XCTestCase
+@property (nonatomic, strong) AlfrescoCMISToAlfrescoObjectConverter *objectConverter;
+@property (nonatomic, strong) NSArray *cmisObjects;
+@end
+
+@implementation AlfrescoNodeMaterializationTest
+
+- (void)setUp
+{
+    [super setUp];
+    
+    self.objectConverter = [[AlfrescoCMISToAlfrescoObjectConverter alloc] initWithSession:nil];
+    NSMutableArray *cmisObjects = [NSMutableArray arrayWithCapacity:kFixtureEntryCount];
+    for (NSUInteger index = 0; index < kFixtureEntryCount; index++)
+    {
+        [cmisObjects addObject:[[AlfrescoCMISDocument alloc] initWithObjectData:[self objectDataWithIndex:index] session:nil]];
+    }
+    self.cmisObjects = cmisObjects;
+}
+
+- (void)testEagerFieldsAreSetWithoutConvertingProperties
+{
+    AlfrescoNode *node = [self.objectConverter nodeFromCMISObject:self.cmisObjects.firstObject];
+    XCTAssertEqualObjects(node.identifier, @"workspace://SpacesStore/node-0;1.0", @"Expected the identifier to be set");
+    XCTAssertEqualObjects(node.name, @"document-0.txt", @"Expected the name to be set");
+    XCTAssertEqualObjects(node.title, @"Title 0", @"Expected the title from the aspect extension to be set");
+    XCTAssertEqualObjects(node.type, kAlfrescoModelTypeContent, @"Expected the type to be set");
+    
+    // single values are read from the record, the conversion only happens when all properties are asked for
+    XCTAssertEqualObjects([node propertyValueWithName:@"custom:property3"], @"value 3 of 0", @"Expected the property value");
+    XCTAssertEqualObjects([node propertyValueWithName:@"custom:multiValued"], (@[@"a", @"b"]), @"Expected all values of a multi valued property");
+    XCTAssertNil([node propertyValueWithName:@"custom:missing"], @"Expected no value for a missing property");
+    
+    AlfrescoProperty *property = node.properties[@"custom:property3"];
+    XCTAssertEqualObjects(property.value, @"value 3 of 0", @"Expected the converted property to have the value");
+    XCTAssertFalse(property.isMultiValued, @"Expected a single valued property");
+    XCTAssertTrue([node.properties[@"custom:multiValued"] isMultiValued], @"Expected a multi valued property");
+    XCTAssertEqualObjects([node propertyValueWithName:@"custom:property3"], @"value 3 of 0", @"Expected the same value once converted");
+    
+    XCTAssertTrue([node hasAspectWithName:@"cm:titled"], @"Expected the aspect without its CMIS prefix");
+}
+
+- (void)testConvertedNodeCanBeArchived
+{
+    AlfrescoNode *node = [self.objectConverter nodeFromCMISObject:self.cmisObjects.firstObject];
+    AlfrescoNode *unarchivedNode = [NSKeyedUnarchiver unarchiveObjectWithData:[NSKeyedArchiver archivedDataWithRootObject:node]];
+    XCTAssertEqualObjects([unarchivedNode propertyValueWithName:@"custom:property3"], @"value 3 of 0", @"Expected the properties to be archived");
+    XCTAssertEqualObjects(unarchivedNode.aspects, node.aspects, @"Expected the aspects to be archived");
+}
+
+- (void)testRecordIsReleasedForNodeWithoutAspects
+{
+    // a plain CMIS document has no aspect types at all
+    CMISDocument *cmisDocument = [[CMISDocument alloc] initWithObjectData:[self objectDataWithIndex:0] session:nil];
+    AlfrescoNode *node = [self.objectConverter nodeFromCMISObject:cmisDocument];
+    
+    XCTAssertEqualObjects(node.aspects, @[], @"Expected an empty array for a node without aspects");
+    XCTAssertNotNil(node.properties, @"Expected the properties to be converted");
+    XCTAssertNil([node valueForKey:@"record"], @"Expected the record to be released once properties and aspects are converted");
+}
+
+- (void)testMemoryAndConversionTimeOfListing
+{
+    size_t memoryBefore = [self memoryInUse];
+    CFAbsoluteTime start = CFAbsoluteTimeGetCurrent();
+    NSMutableArray *nodes = [NSMutableArray arrayWithCapacity:kFixtureEntryCount];
+    for (CMISObject *cmisObject in self.cmisObjects)
+    {
+        [nodes addObject:[self.objectConverter nodeFromCMISObject:cmisObject]];
+    }
+    CFAbsoluteTime conversionTime = CFAbsoluteTimeGetCurrent() - start;
+    size_t listingMemory = [self memoryInUse] - memoryBefore;
+    
+    start = CFAbsoluteTimeGetCurrent();
+    for (AlfrescoNode *node in nodes)
+    {
+        [node properties];
+        [node aspects];
+    }
+    CFAbsoluteTime materializationTime = CFAbsoluteTimeGetCurrent() - start;
+    size_t materializedMemory = [self memoryInUse] - memoryBefore;
+    
+    NSLog(@"Converted %lu entries in %.3fs using %lu bytes per node, converting all properties took %.3fs and %lu bytes per node",
+          (unsigned long)kFixtureEntryCount, conversionTime, (unsigned long)(listingMemory / kFixtureEntryCount),
+          materializationTime, (unsigned long)(materializedMemory / kFixtureEntryCount));
+    XCTAssertTrue(listingMemory < materializedMemory, @"Expected nodes to use less memory until their properties are asked for");
+}
+
+#pragma mark - Private methods
+
+- (CMISObjectData *)objectDataWithIndex:(NSUInteger)index
+{
+    CMISProperties *properties = [[CMISProperties alloc] init];
+    [properties addProperty:[CMISPropertyData createPropertyForId:kCMISPropertyObjectId idValue:[NSString stringWithFormat:@"workspace://SpacesStore/node-%lu;1.0", (unsigned long)index]]];
+    [properties addProperty:[CMISPropertyData createPropertyForId:kCMISPropertyName stringValue:[NSString stringWithFormat:@"document-%lu.txt", (unsigned long)index]]];
+    [properties addProperty:[CMISPropertyData createPropertyForId:kCMISPropertyObjectTypeId idValue:kCMISPropertyObjectTypeIdValueDocument]];
+    [properties addProperty:[CMISPropertyData createPropertyForId:kCMISPropertyBaseTypeId idValue:kCMISPropertyObjectTypeIdValueDocument]];
+    [properties addProperty:[CMISPropertyData createPropertyForId:kCMISPropertyCreatedBy stringValue:@"admin"]];
+    [properties addProperty:[CMISPropertyData createPropertyForId:kCMISPropertyCreationDate dateTimeValue:[NSDate date]]];
+    [properties addProperty:[CMISPropertyData createPropertyForId:kCMISPropertyContentStreamLength integerValue:1024]];
+    [properties addProperty:[CMISPropertyData createPropertyForId:@"custom:multiValued" arrayValue:@[@"a", @"b"] type:CMISPropertyTypeString]];
+    for (NSUInteger propertyIndex = 0; propertyIndex < kFixturePropertyCount; propertyIndex++)
+    {
+        NSString *identifier = [NSString stringWithFormat:@"custom:property%lu", (unsigned long)propertyIndex];
+        NSString *value = [NSString stringWithFormat:@"value %lu of %lu", (unsigned long)propertyIndex, (unsigned long)index];
+        [properties addProperty:[CMISPropertyData createPropertyForId:identifier stringValue:value]];
+    }
+    
+    // the titled aspect and its title arrive as an Alfresco extension, as they do from the repository
+    CMISExtensionElement *titleValue = [[CMISExtensionElement alloc] initLeafWithName:kCMISAtomEntryValue namespaceUri:kCMISNamespaceCmis attributes:nil
+                                                                                value:[NSString stringWithFormat:@"Title %lu", (unsigned long)index]];
+    CMISExtensionElement *title = [[CMISExtensionElement alloc] initNodeWithName:kCMISAtomEntryPropertyString namespaceUri:kCMISNamespaceCmis
+                                                                      attributes:@{kCMISAtomEntryPropertyDefId: kAlfrescoModelPropertyTitle} children:@[titleValue]];
+    CMISExtensionElement *aspectProperties = [[CMISExtensionElement alloc] initNodeWithName:@"properties" namespaceUri:kAlfrescoCMISNamespace attributes:nil children:@[title]];
+    CMISExtensionElement *appliedAspect = [[CMISExtensionElement alloc] initLeafWithName:@"appliedAspects" namespaceUri:kAlfrescoCMISNamespace attributes:nil value:@"P:cm:titled"];
+    CMISExtensionElement *aspects = [[CMISExtensionElement alloc] initNodeWithName:@"aspects" namespaceUri:kAlfrescoCMISNamespace attributes:nil
+                                                                          children:@[appliedAspect, aspectProperties]];
+    properties.extensions = @[aspects];
+    
+    CMISObjectData *objectData = [[CMISObjectData alloc] init];
+    objectData.identifier = [properties propertyValueForId:kCMISPropertyObjectId];
+    objectData.baseType = CMISBaseTypeDocument;
+    objectData.properties = properties;
+    return objectData;
+}
+
+- (size_t)memoryInUse
+{
+    malloc_statistics_t statistics;
+    malloc_zone_statistics(NULL, &statistics);
+    return statistics.size_in_use;
+}
+
+@end
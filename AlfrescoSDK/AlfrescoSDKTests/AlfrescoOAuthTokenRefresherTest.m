@@ -0,0 +1,290 @@
+/*******************************************************************************
+ * Copyright (C) 2005-2020 Alfresco Software Limited.
+ *
+ * This file is part of the Alfresco Mobile SDK.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ******************************************************************************/
+
+#import <XCTest/XCTest.h>
+#import "AlfrescoStubServer.h"
+#import "AlfrescoOAuthTokenRefresher.h"
+#import "AlfrescoOAuthAuthenticationProvider.h"
+#import "AlfrescoCMISPassThroughAuthenticationProvider.h"
+#import "AlfrescoInternalConstants.h"
+#import "CMISBindingSession.h"
+#import "CMISSessionParameters.h"
+#import "CMISHttpRequest.h"
+#import "CMISHttpResponse.h"
+#import "AlfrescoDefaultNetworkProvider.h"
+#import "AlfrescoErrors.h"
+
+static NSUInteger const kConcurrentRequestCount = 10;
+
+// counts the requests sent with headers of their own, which the token requests are
+@interface AlfrescoOAuthTokenRefresherTestNetworkProvider : AlfrescoDefaultNetworkProvider
+@property (atomic, assign) NSUInteger headerRequestCount;
+@end
+
+@implementation AlfrescoOAuthTokenRefresherTestNetworkProvider
+
+- (void)executeRequestWithURL:(NSURL *)url
+                      session:(id<AlfrescoSession>)session
+                  requestBody:(NSData *)requestBody
+                       method:(NSString *)method
+                      headers:(NSDictionary *)headers
+              alfrescoRequest:(AlfrescoRequest *)alfrescoRequest
+              completionBlock:(AlfrescoDataCompletionBlock)completionBlock
+{
+    self.headerRequestCount++;
+    [super executeRequestWithURL:url session:session requestBody:requestBody method:method headers:headers alfrescoRequest:alfrescoRequest completionBlock:completionBlock];
+}
+
+@end
+
+// the minimum of a session the refresher needs to send its requests through the network provider
+@interface AlfrescoOAuthTokenRefresherTestSession : NSObject <AlfrescoSession>
+@property (nonatomic, strong) NSString *personIdentifier;
+@property (nonatomic, strong) AlfrescoRepositoryInfo *repositoryInfo;
+@property (nonatomic, strong) NSURL *baseUrl;
+@property (nonatomic, strong) AlfrescoFolder *rootFolder;
+@property (nonatomic, strong) AlfrescoListingContext *defaultListingContext;
+@property (nonatomic, strong) id<AlfrescoNetworkProvider> networkProvider;
+@property (nonatomic, strong) NSMutableDictionary *parameters;
+@end
+
+@implementation AlfrescoOAuthTokenRefresherTestSession
+
+- (NSArray *)allParameterKeys
+{
+    return [self.parameters allKeys];
+}
+
+- (id)objectForParameter:(id)key
+{
+    return self.parameters[key];
+}
+
+- (void)setObject:(id)object forParameter:(id)key
+{
+    self.parameters[key] = object;
+}
+
+- (void)addParametersFromDictionary:(NSDictionary *)dictionary
+{
+    [self.parameters addEntriesFromDictionary:dictionary];
+}
+
+- (void)removeParameter:(id)key
+{
+    [self.parameters removeObjectForKey:key];
+}
+
+- (void)clear
+{
+}
+
+@end
+
+@interface AlfrescoOAuthTokenRefresherTest : XCTestCase
+@property (nonatomic, strong) AlfrescoStubServer *server;
+@property (nonatomic, strong) AlfrescoOAuthTokenRefresher *tokenRefresher;
+@property (nonatomic, strong) CMISBindingSession *bindingSession;
+@property (atomic, assign) NSUInteger tokenRequestCount;
+@property (atomic, assign) BOOL rejectsRefreshToken;
+@property (atomic, strong) NSString *tokenRequestContentType;
+@end
+
+@implementation AlfrescoOAuthTokenRefresherTest
+
+- (void)setUp
+{
+    [super setUp];
+    
+    // the stub OAuth server hands out a new access token for every refresh and only accepts the latest one
+    __weak AlfrescoOAuthTokenRefresherTest *weakSelf = self;
+    self.server = [[AlfrescoStubServer alloc] init];
+    [self.server addRouteWithMethod:@"POST" pathPrefix:kAlfrescoOAuthToken handler:^AlfrescoStubResponse *(AlfrescoStubRequest *request) {
+        if (weakSelf.rejectsRefreshToken)
+        {
+            NSData *body = [NSJSONSerialization dataWithJSONObject:@{@"error": @"invalid_grant", @"error_description": @"Invalid refresh token"} options:0 error:nil];
+            return [AlfrescoStubResponse responseWithStatusCode:400 contentType:@"application/json" body:body];
+        }
+        weakSelf.tokenRequestCount++;
+        weakSelf.tokenRequestContentType = request.headers[@"content-type"];
+        NSDictionary *json = [weakSelf oauthJSONWithAccessToken:[weakSelf accessTokenForRefresh:weakSelf.tokenRequestCount] expiresIn:3600];
+        NSData *body = [NSJSONSerialization dataWithJSONObject:json options:0 error:nil];
+        return [AlfrescoStubResponse responseWithStatusCode:200 contentType:@"application/json" body:body];
+    }];
+    [self.server addRouteWithMethod:@"GET" pathPrefix:@"/documents" handler:^AlfrescoStubResponse *(AlfrescoStubRequest *request) {
+        NSString *expectedAuthorization = [@"Bearer " stringByAppendingString:[weakSelf accessTokenForRefresh:weakSelf.tokenRequestCount]];
+        if (![request.headers[@"authorization"] isEqualToString:expectedAuthorization])
+        {
+            return [AlfrescoStubResponse responseWithStatusCode:401 contentType:@"text/plain" body:[@"Unauthorized" dataUsingEncoding:NSUTF8StringEncoding]];
+        }
+        return [AlfrescoStubResponse responseWithStatusCode:200 contentType:@"text/plain" body:[@"Document" dataUsingEncoding:NSUTF8StringEncoding]];
+    }];
+    // the refresh is slowed down so the requests are rejected while it is in progress
+    self.server.latency = 0.2;
+    NSError *error = nil;
+    XCTAssertTrue([self.server startAndReturnError:&error], @"Failed to start the stub server: %@", error);
+    
+    // the token the session starts with has expired already as far as the server is concerned
+    AlfrescoOAuthData *oauthData = [[AlfrescoOAuthData alloc] initWithAPIKey:@"apiKey"
+                                                                    secretKey:@"secretKey"
+                                                               jsonDictionary:[self oauthJSONWithAccessToken:@"expired" expiresIn:3600]];
+    self.tokenRefresher = [[AlfrescoOAuthTokenRefresher alloc] initWithOAuthData:oauthData parameters:@{kAlfrescoSessionCloudURL: self.server.baseURL.absoluteString}];
+    
+    AlfrescoOAuthAuthenticationProvider *authProvider = [[AlfrescoOAuthAuthenticationProvider alloc] initWithTokenRefresher:self.tokenRefresher];
+    CMISSessionParameters *parameters = [[CMISSessionParameters alloc] initWithBindingType:CMISBindingTypeAtomPub];
+    parameters.atomPubUrl = self.server.baseURL;
+    parameters.authenticationProvider = [[AlfrescoCMISPassThroughAuthenticationProvider alloc] initWithAlfrescoAuthenticationProvider:authProvider];
+    [parameters setObject:@(NO) forKey:kCMISSessionParameterCheckNetworkReachability];
+    self.bindingSession = [[CMISBindingSession alloc] initWithSessionParameters:parameters];
+}
+
+- (void)tearDown
+{
+    [self.tokenRefresher invalidate];
+    [self.server stop];
+    [super tearDown];
+}
+
+- (void)testConcurrentRejectedRequestsRefreshTokenOnce
+{
+    NSMutableArray *errors = [NSMutableArray array];
+    NSMutableArray *responses = [NSMutableArray array];
+    for (NSUInteger index = 0; index < kConcurrentRequestCount; index++)
+    {
+        XCTestExpectation *expectation = [self expectationWithDescription:[NSString stringWithFormat:@"Request %lu", (unsigned long)index]];
+        [self startDocumentRequestWithCompletionBlock:^(CMISHttpResponse *httpResponse, NSError *error) {
+            if (httpResponse)
+            {
+                [responses addObject:httpResponse];
+            }
+            if (error)
+            {
+                [errors addObject:error];
+            }
+            [expectation fulfill];
+        }];
+    }
+    [self waitForExpectationsWithTimeout:30 handler:nil];
+    
+    XCTAssertTrue(errors.count == 0, @"Expected every request to be replayed with the new token but got errors: %@", errors);
+    XCTAssertTrue(responses.count == kConcurrentRequestCount, @"Expected every request to succeed");
+    XCTAssertTrue(self.tokenRequestCount == 1, @"Expected exactly one refresh but the token was refreshed %lu times", (unsigned long)self.tokenRequestCount);
+    XCTAssertTrue(self.tokenRefresher.refreshCount == 1, @"Expected the refresher to send exactly one refresh request");
+    XCTAssertEqualObjects(self.tokenRefresher.oauthData.accessToken, [self accessTokenForRefresh:1], @"Expected the refresher to hold the new access token");
+}
+
+- (void)testRequestFailsIfTokenCannotBeRefreshed
+{
+    self.rejectsRefreshToken = YES;
+    
+    XCTestExpectation *expectation = [self expectationWithDescription:@"Request"];
+    [self startDocumentRequestWithCompletionBlock:^(CMISHttpResponse *httpResponse, NSError *error) {
+        XCTAssertNil(httpResponse, @"Expected no response");
+        XCTAssertNotNil(error, @"Expected the request to fail with the original 401 response");
+        [expectation fulfill];
+    }];
+    [self waitForExpectationsWithTimeout:30 handler:nil];
+    
+    XCTAssertTrue(self.tokenRefresher.refreshCount == 1, @"Expected a single refresh attempt");
+    XCTAssertEqualObjects(self.tokenRefresher.oauthData.accessToken, @"expired", @"Expected the access token to be kept");
+}
+
+- (void)testAccessTokenIsRenewedBeforeItExpires
+{
+    AlfrescoOAuthData *oauthData = [[AlfrescoOAuthData alloc] initWithAPIKey:@"apiKey"
+                                                                    secretKey:@"secretKey"
+                                                               jsonDictionary:[self oauthJSONWithAccessToken:@"expiring" expiresIn:2]];
+    self.tokenRefresher.renewalMargin = 1;
+    
+    XCTestExpectation *expectation = [self expectationWithDescription:@"Renewal"];
+    self.tokenRefresher.tokenRefreshHandler = ^(AlfrescoOAuthData *refreshedOAuthData) {
+        [expectation fulfill];
+    };
+    [self.tokenRefresher updateOAuthData:oauthData];
+    [self waitForExpectationsWithTimeout:30 handler:nil];
+    
+    XCTAssertTrue(self.tokenRequestCount == 1, @"Expected the token to be refreshed once before it expired");
+    XCTAssertEqualObjects(self.tokenRefresher.oauthData.accessToken, [self accessTokenForRefresh:1], @"Expected the refresher to hold the new access token");
+}
+
+- (void)testRefreshIsSentThroughSessionNetworkProvider
+{
+    AlfrescoOAuthTokenRefresherTestNetworkProvider *networkProvider = [[AlfrescoOAuthTokenRefresherTestNetworkProvider alloc] init];
+    AlfrescoOAuthTokenRefresherTestSession *session = [[AlfrescoOAuthTokenRefresherTestSession alloc] init];
+    session.networkProvider = networkProvider;
+    session.parameters = [NSMutableDictionary dictionaryWithDictionary:@{kAlfrescoCheckNetworkReachability: @NO}];
+    self.tokenRefresher.session = session;
+    
+    XCTestExpectation *expectation = [self expectationWithDescription:@"Refresh"];
+    [self.tokenRefresher refreshAccessTokenWithCompletionBlock:^(AlfrescoOAuthData *oauthData, NSError *error) {
+        XCTAssertNil(error, @"Expected the refresh to succeed but got %@", error);
+        XCTAssertEqualObjects(oauthData.accessToken, [self accessTokenForRefresh:1], @"Expected the new access token");
+        [expectation fulfill];
+    }];
+    [self waitForExpectationsWithTimeout:30 handler:nil];
+    
+    XCTAssertTrue(networkProvider.headerRequestCount == 1, @"Expected the refresh to be sent through the session's network provider");
+    XCTAssertEqualObjects(self.tokenRequestContentType, kAlfrescoOAuthFormContentType, @"Expected the refresh to be sent as a form");
+}
+
+- (void)testRejectedRefreshThroughNetworkProviderReportsServerError
+{
+    self.rejectsRefreshToken = YES;
+    AlfrescoOAuthTokenRefresherTestSession *session = [[AlfrescoOAuthTokenRefresherTestSession alloc] init];
+    session.networkProvider = [[AlfrescoOAuthTokenRefresherTestNetworkProvider alloc] init];
+    session.parameters = [NSMutableDictionary dictionaryWithDictionary:@{kAlfrescoCheckNetworkReachability: @NO}];
+    self.tokenRefresher.session = session;
+    
+    XCTestExpectation *expectation = [self expectationWithDescription:@"Refresh"];
+    [self.tokenRefresher refreshAccessTokenWithCompletionBlock:^(AlfrescoOAuthData *oauthData, NSError *error) {
+        XCTAssertNil(oauthData, @"Expected no OAuth data");
+        XCTAssertNotNil(error, @"Expected the refresh to fail");
+        XCTAssertTrue(error.code == kAlfrescoErrorCodeInvalidGrant, @"Expected the error the server reported but got %@", error);
+        [expectation fulfill];
+    }];
+    [self waitForExpectationsWithTimeout:30 handler:nil];
+}
+
+#pragma mark - Private methods
+
+- (NSString *)accessTokenForRefresh:(NSUInteger)refresh
+{
+    return [NSString stringWithFormat:@"token%lu", (unsigned long)refresh];
+}
+
+- (NSDictionary *)oauthJSONWithAccessToken:(NSString *)accessToken expiresIn:(NSUInteger)expiresIn
+{
+    return @{@"access_token": accessToken,
+             @"refresh_token": [@"refresh-" stringByAppendingString:accessToken],
+             @"token_type": @"Bearer",
+             @"expires_in": @(expiresIn),
+             @"scope": @"pub_api"};
+}
+
+- (void)startDocumentRequestWithCompletionBlock:(void (^)(CMISHttpResponse *httpResponse, NSError *error))completionBlock
+{
+    NSMutableURLRequest *urlRequest = [NSMutableURLRequest requestWithURL:[self.server.baseURL URLByAppendingPathComponent:@"documents"]];
+    [CMISHttpRequest startRequest:urlRequest
+                       httpMethod:HTTP_GET
+                      requestBody:nil
+                          headers:nil
+                          session:self.bindingSession
+                  completionBlock:completionBlock];
+}
+
+@end
@@ -0,0 +1,91 @@
+/*******************************************************************************
+ * Copyright (C) 2005-2020 Alfresco Software Limited.
+ *
+ * This file is part of the Alfresco Mobile SDK.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ******************************************************************************/
+
+// A minimal HTTP/1.1 server bound to the loopback interface, used to replay recorded
+// Alfresco and CMIS responses so tests and benchmarks can run without a live repository.
+
+#import <Foundation/Foundation.h>
+
+@interface AlfrescoStubRequest : NSObject
+
+@property (nonatomic, strong, readonly) NSString *method;
+@property (nonatomic, strong, readonly) NSString *path;
+@property (nonatomic, strong, readonly) NSDictionary *queryParameters;
+@property (nonatomic, strong, readonly) NSDictionary *headers;
+/// The first part of the request body, large bodies are counted but not retained
+@property (nonatomic, strong, readonly) NSData *body;
+@property (nonatomic, assign, readonly) unsigned long long bodyLength;
+
+@end
+
+
+@interface AlfrescoStubResponse : NSObject
+
+@property (nonatomic, assign) NSInteger statusCode;
+@property (nonatomic, strong) NSMutableDictionary *headers;
+@property (nonatomic, strong) NSData *body;
+/// when set the body is generated on the fly instead of being sent from memory
+@property (nonatomic, assign) unsigned long long generatedBodyLength;
+
++ (AlfrescoStubResponse *)responseWithStatusCode:(NSInteger)statusCode contentType:(NSString *)contentType body:(NSData *)body;
++ (AlfrescoStubResponse *)responseWithStatusCode:(NSInteger)statusCode contentType:(NSString *)contentType generatedBodyLength:(unsigned long long)length;
+
+@end
+
+
+typedef AlfrescoStubResponse * (^AlfrescoStubRouteHandler)(AlfrescoStubRequest *request);
+
+@interface AlfrescoStubServer : NSObject
+
+@property (nonatomic, assign, readonly) in_port_t port;
+@property (nonatomic, strong, readonly) NSURL *baseURL;
+@property (nonatomic, assign, readonly) NSUInteger requestCount;
+/// total number of response body bytes written, as sent i.e. after compression
+@property (nonatomic, assign, readonly) unsigned long long bodyBytesSent;
+/// total number of request body bytes received
+@property (nonatomic, assign, readonly) unsigned long long bodyBytesReceived;
+/// number of conditional requests answered with 304 Not Modified
+@property (nonatomic, assign, readonly) NSUInteger notModifiedCount;
+
+/// delay added before every response is sent, defaults to 0
+@property (atomic, assign) NSTimeInterval latency;
+/// maximum rate at which response bodies are written, 0 means unlimited
+@property (atomic, assign) unsigned long long bytesPerSecond;
+/// maximum rate at which each connection reads request bodies, 0 means unlimited
+@property (atomic, assign) unsigned long long uploadBytesPerSecond;
+/// fraction of requests (0.0 - 1.0) answered with failureStatusCode instead of the route's response
+@property (atomic, assign) double failureRate;
+/// status code returned for injected failures, defaults to 503, 0 closes the connection without a response
+@property (atomic, assign) NSInteger failureStatusCode;
+/// number of upcoming requests answered as injected failures regardless of the failureRate
+@property (atomic, assign) NSUInteger failureCount;
+/// value of the Retry-After header sent with injected failures in seconds, 0 sends none
+@property (atomic, assign) NSUInteger failureRetryAfter;
+/// gzip response bodies of requests that accept it, defaults to NO
+@property (atomic, assign) BOOL compressesResponses;
+/// add ETag and Last-Modified headers to successful GET responses and answer matching conditional requests with 304, defaults to NO
+@property (atomic, assign) BOOL supportsConditionalRequests;
+
+/// Registers a handler for requests whose method matches and whose path, or path relative to the base URL, starts with the given prefix, routes are matched in the order they were added
+- (void)addRouteWithMethod:(NSString *)method pathPrefix:(NSString *)pathPrefix handler:(AlfrescoStubRouteHandler)handler;
+
+- (BOOL)startAndReturnError:(NSError **)error;
+
+- (void)stop;
+
+@end
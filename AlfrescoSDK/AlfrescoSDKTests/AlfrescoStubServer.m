@@ -0,0 +1,678 @@
+/*******************************************************************************
+ * Copyright (C) 2005-2020 Alfresco Software Limited.
+ *
+ * This file is part of the Alfresco Mobile SDK.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ******************************************************************************/
+
+#import "AlfrescoStubServer.h"
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <zlib.h>
+
+static NSUInteger const kAlfrescoStubServerMaxRetainedBodyLength = 1024 * 1024;
+static NSUInteger const kAlfrescoStubServerMaxHeaderLength = 64 * 1024;
+static NSUInteger const kAlfrescoStubServerChunkLength = 64 * 1024;
+
+#pragma mark - Request
+
+@interface AlfrescoStubRequest ()
+@property (nonatomic, strong, readwrite) NSString *method;
+@property (nonatomic, strong, readwrite) NSString *path;
+@property (nonatomic, strong, readwrite) NSDictionary *queryParameters;
+@property (nonatomic, strong, readwrite) NSDictionary *headers;
+@property (nonatomic, assign, readwrite) unsigned long long bodyLength;
+@property (nonatomic, strong) NSMutableData *retainedBody;
+@end
+
+@implementation AlfrescoStubRequest
+
+- (NSData *)body
+{
+    return self.retainedBody;
+}
+
+- (void)appendBodyBytes:(const void *)bytes length:(NSUInteger)length
+{
+    if (self.retainedBody.length < kAlfrescoStubServerMaxRetainedBodyLength)
+    {
+        NSUInteger retainedLength = MIN(length, kAlfrescoStubServerMaxRetainedBodyLength - self.retainedBody.length);
+        [self.retainedBody appendBytes:bytes length:retainedLength];
+    }
+    self.bodyLength += length;
+}
+
+@end
+
+#pragma mark - Response
+
+@implementation AlfrescoStubResponse
+
++ (AlfrescoStubResponse *)responseWithStatusCode:(NSInteger)statusCode contentType:(NSString *)contentType body:(NSData *)body
+{
+    AlfrescoStubResponse *response = [[AlfrescoStubResponse alloc] init];
+    response.statusCode = statusCode;
+    response.headers = [NSMutableDictionary dictionary];
+    if (nil != contentType)
+    {
+        response.headers[@"Content-Type"] = contentType;
+    }
+    response.body = body;
+    return response;
+}
+
++ (AlfrescoStubResponse *)responseWithStatusCode:(NSInteger)statusCode contentType:(NSString *)contentType generatedBodyLength:(unsigned long long)length
+{
+    AlfrescoStubResponse *response = [self responseWithStatusCode:statusCode contentType:contentType body:nil];
+    response.generatedBodyLength = length;
+    return response;
+}
+
+- (unsigned long long)contentLength
+{
+    return (nil != self.body) ? self.body.length : self.generatedBodyLength;
+}
+
+@end
+
+#pragma mark - Connection
+
+@interface AlfrescoStubConnection : NSObject
+@property (nonatomic, assign, readonly) int socket;
+@property (nonatomic, strong) NSMutableData *buffer;
+@property (nonatomic, strong) NSMutableData *readBuffer;
+@property (nonatomic, assign) unsigned long long bytesPerSecond;
+- (id)initWithSocket:(int)socket;
+@end
+
+@implementation AlfrescoStubConnection
+
+- (id)initWithSocket:(int)socket
+{
+    self = [super init];
+    if (nil != self)
+    {
+        _socket = socket;
+        _buffer = [NSMutableData data];
+        _readBuffer = [NSMutableData dataWithLength:kAlfrescoStubServerChunkLength];
+    }
+    return self;
+}
+
+- (BOOL)fillBuffer
+{
+    ssize_t bytesRead;
+    do {
+        bytesRead = recv(self.socket, self.readBuffer.mutableBytes, self.readBuffer.length, 0);
+    } while (bytesRead < 0 && errno == EINTR);
+
+    if (bytesRead <= 0)
+    {
+        return NO;
+    }
+    [self.buffer appendBytes:self.readBuffer.bytes length:(NSUInteger)bytesRead];
+    return YES;
+}
+
+- (NSData *)readUntilDelimiter:(NSData *)delimiter
+{
+    NSRange searchRange = NSMakeRange(0, self.buffer.length);
+    NSRange delimiterRange = [self.buffer rangeOfData:delimiter options:0 range:searchRange];
+    while (delimiterRange.location == NSNotFound)
+    {
+        if (self.buffer.length > kAlfrescoStubServerMaxHeaderLength || ![self fillBuffer])
+        {
+            return nil;
+        }
+        delimiterRange = [self.buffer rangeOfData:delimiter options:0 range:NSMakeRange(0, self.buffer.length)];
+    }
+
+    NSData *data = [self.buffer subdataWithRange:NSMakeRange(0, delimiterRange.location)];
+    [self.buffer replaceBytesInRange:NSMakeRange(0, NSMaxRange(delimiterRange)) withBytes:NULL length:0];
+    return data;
+}
+
+- (BOOL)readLength:(unsigned long long)length intoRequest:(AlfrescoStubRequest *)request
+{
+    // pace the reads when a bandwidth limit is set, the client is held back by the full socket buffers
+    unsigned long long bytesPerSecond = self.bytesPerSecond;
+    NSDate *startDate = [NSDate date];
+    unsigned long long remaining = length;
+    while (remaining > 0)
+    {
+        if (self.buffer.length == 0 && ![self fillBuffer])
+        {
+            return NO;
+        }
+        NSUInteger available = (NSUInteger)MIN((unsigned long long)self.buffer.length, remaining);
+        [request appendBodyBytes:self.buffer.bytes length:available];
+        [self.buffer replaceBytesInRange:NSMakeRange(0, available) withBytes:NULL length:0];
+        remaining -= available;
+
+        if (bytesPerSecond > 0)
+        {
+            NSTimeInterval expectedDuration = (double)(length - remaining) / (double)bytesPerSecond;
+            NSTimeInterval elapsed = -[startDate timeIntervalSinceNow];
+            if (expectedDuration > elapsed)
+            {
+                [NSThread sleepForTimeInterval:expectedDuration - elapsed];
+            }
+        }
+    }
+    return YES;
+}
+
+- (BOOL)writeBytes:(const void *)bytes length:(NSUInteger)length
+{
+    const uint8_t *position = bytes;
+    while (length > 0)
+    {
+        ssize_t written = send(self.socket, position, length, 0);
+        if (written < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (written <= 0)
+        {
+            return NO;
+        }
+        position += written;
+        length -= (NSUInteger)written;
+    }
+    return YES;
+}
+
+@end
+
+#pragma mark - Route
+
+@interface AlfrescoStubRoute : NSObject
+@property (nonatomic, strong) NSString *method;
+@property (nonatomic, strong) NSString *pathPrefix;
+@property (nonatomic, copy) AlfrescoStubRouteHandler handler;
+@end
+
+@implementation AlfrescoStubRoute
+@end
+
+#pragma mark - Server
+
+@interface AlfrescoStubServer ()
+@property (nonatomic, assign, readwrite) in_port_t port;
+@property (nonatomic, strong, readwrite) NSURL *baseURL;
+@property (nonatomic, assign, readwrite) NSUInteger requestCount;
+@property (nonatomic, assign, readwrite) unsigned long long bodyBytesSent;
+@property (nonatomic, assign, readwrite) unsigned long long bodyBytesReceived;
+@property (nonatomic, assign, readwrite) NSUInteger notModifiedCount;
+@property (nonatomic, strong) NSMutableArray *routes;
+@property (nonatomic, strong) NSMutableSet *openSockets;
+@property (nonatomic, strong) dispatch_source_t acceptSource;
+@property (nonatomic, strong) dispatch_queue_t connectionQueue;
+@property (nonatomic, strong) NSData *generatedChunk;
+@end
+
+@implementation AlfrescoStubServer
+
+- (id)init
+{
+    self = [super init];
+    if (nil != self)
+    {
+        self.routes = [NSMutableArray array];
+        self.openSockets = [NSMutableSet set];
+        self.failureStatusCode = 503;
+        self.connectionQueue = dispatch_queue_create("org.alfresco.mobile.stubserver.connections", DISPATCH_QUEUE_CONCURRENT);
+
+        // generated bodies repeat a printable pattern so they can also stand in for text content
+        NSMutableData *chunk = [NSMutableData dataWithLength:kAlfrescoStubServerChunkLength];
+        uint8_t *bytes = chunk.mutableBytes;
+        for (NSUInteger i = 0; i < kAlfrescoStubServerChunkLength; i++)
+        {
+            bytes[i] = (uint8_t)('a' + (i % 26));
+        }
+        self.generatedChunk = chunk;
+    }
+    return self;
+}
+
+- (void)dealloc
+{
+    [self stop];
+}
+
+- (void)addRouteWithMethod:(NSString *)method pathPrefix:(NSString *)pathPrefix handler:(AlfrescoStubRouteHandler)handler
+{
+    AlfrescoStubRoute *route = [AlfrescoStubRoute new];
+    route.method = method.uppercaseString;
+    route.pathPrefix = pathPrefix;
+    route.handler = handler;
+    @synchronized(self.routes)
+    {
+        [self.routes addObject:route];
+    }
+}
+
+- (BOOL)startAndReturnError:(NSError **)error
+{
+    int listenSocket = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+    if (listenSocket < 0)
+    {
+        [self populateError:error];
+        return NO;
+    }
+
+    int on = 1;
+    setsockopt(listenSocket, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+
+    struct sockaddr_in address;
+    memset(&address, 0, sizeof(address));
+    address.sin_len = sizeof(address);
+    address.sin_family = AF_INET;
+    address.sin_port = 0;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+    socklen_t addressLength = sizeof(address);
+    if (bind(listenSocket, (struct sockaddr *)&address, sizeof(address)) != 0 ||
+        listen(listenSocket, SOMAXCONN) != 0 ||
+        getsockname(listenSocket, (struct sockaddr *)&address, &addressLength) != 0)
+    {
+        [self populateError:error];
+        close(listenSocket);
+        return NO;
+    }
+    fcntl(listenSocket, F_SETFL, fcntl(listenSocket, F_GETFL) | O_NONBLOCK);
+
+    self.port = ntohs(address.sin_port);
+    self.baseURL = [NSURL URLWithString:[NSString stringWithFormat:@"http://127.0.0.1:%d/alfresco", self.port]];
+
+    dispatch_queue_t acceptQueue = dispatch_queue_create("org.alfresco.mobile.stubserver.accept", DISPATCH_QUEUE_SERIAL);
+    self.acceptSource = dispatch_source_create(DISPATCH_SOURCE_TYPE_READ, listenSocket, 0, acceptQueue);
+    __weak typeof(self) weakSelf = self;
+    dispatch_source_set_event_handler(self.acceptSource, ^{
+        [weakSelf acceptConnectionOnSocket:listenSocket];
+    });
+    dispatch_source_set_cancel_handler(self.acceptSource, ^{
+        close(listenSocket);
+    });
+    dispatch_resume(self.acceptSource);
+
+    return YES;
+}
+
+- (void)stop
+{
+    if (nil != self.acceptSource)
+    {
+        dispatch_source_cancel(self.acceptSource);
+        self.acceptSource = nil;
+    }
+
+    // unblock any connection still waiting for a request, the connection closes its own socket
+    @synchronized(self.openSockets)
+    {
+        for (NSNumber *socketNumber in self.openSockets)
+        {
+            shutdown(socketNumber.intValue, SHUT_RDWR);
+        }
+    }
+}
+
+#pragma mark - Private methods
+
+- (void)populateError:(NSError **)error
+{
+    if (NULL != error)
+    {
+        *error = [NSError errorWithDomain:NSPOSIXErrorDomain code:errno userInfo:nil];
+    }
+}
+
+- (void)acceptConnectionOnSocket:(int)listenSocket
+{
+    int clientSocket = accept(listenSocket, NULL, NULL);
+    if (clientSocket < 0)
+    {
+        return;
+    }
+
+    int on = 1;
+    setsockopt(clientSocket, SOL_SOCKET, SO_NOSIGPIPE, &on, sizeof(on));
+    setsockopt(clientSocket, IPPROTO_TCP, TCP_NODELAY, &on, sizeof(on));
+    fcntl(clientSocket, F_SETFL, fcntl(clientSocket, F_GETFL) & ~O_NONBLOCK);
+
+    @synchronized(self.openSockets)
+    {
+        [self.openSockets addObject:@(clientSocket)];
+    }
+
+    dispatch_async(self.connectionQueue, ^{
+        [self serveConnection:[[AlfrescoStubConnection alloc] initWithSocket:clientSocket]];
+
+        @synchronized(self.openSockets)
+        {
+            [self.openSockets removeObject:@(clientSocket)];
+        }
+        close(clientSocket);
+    });
+}
+
+- (void)serveConnection:(AlfrescoStubConnection *)connection
+{
+    BOOL keepAlive = YES;
+    while (keepAlive)
+    {
+        AlfrescoStubRequest *request = [self readRequestFromConnection:connection];
+        if (nil == request)
+        {
+            return;
+        }
+
+        keepAlive = ![[request.headers[@"connection"] lowercaseString] isEqualToString:@"close"];
+        AlfrescoStubResponse *response = [self responseForRequest:request];
+        if (nil == response)
+        {
+            // injected connection failure
+            return;
+        }
+
+        NSTimeInterval latency = self.latency;
+        if (latency > 0)
+        {
+            [NSThread sleepForTimeInterval:latency];
+        }
+
+        if (![self writeResponse:response keepAlive:keepAlive toConnection:connection])
+        {
+            return;
+        }
+    }
+}
+
+- (AlfrescoStubRequest *)readRequestFromConnection:(AlfrescoStubConnection *)connection
+{
+    NSData *crlf = [@"\r\n" dataUsingEncoding:NSASCIIStringEncoding];
+    NSData *headerData = [connection readUntilDelimiter:[@"\r\n\r\n" dataUsingEncoding:NSASCIIStringEncoding]];
+    if (nil == headerData)
+    {
+        return nil;
+    }
+
+    NSString *headerString = [[NSString alloc] initWithData:headerData encoding:NSISOLatin1StringEncoding];
+    NSArray *lines = [headerString componentsSeparatedByString:@"\r\n"];
+    NSArray *requestLine = [lines.firstObject componentsSeparatedByString:@" "];
+    if (requestLine.count < 2)
+    {
+        return nil;
+    }
+
+    AlfrescoStubRequest *request = [AlfrescoStubRequest new];
+    request.method = [requestLine[0] uppercaseString];
+    request.retainedBody = [NSMutableData data];
+
+    NSString *target = requestLine[1];
+    NSRange queryRange = [target rangeOfString:@"?"];
+    NSMutableDictionary *queryParameters = [NSMutableDictionary dictionary];
+    if (queryRange.location != NSNotFound)
+    {
+        NSString *query = [target substringFromIndex:NSMaxRange(queryRange)];
+        target = [target substringToIndex:queryRange.location];
+        for (NSString *pair in [query componentsSeparatedByString:@"&"])
+        {
+            NSRange equalsRange = [pair rangeOfString:@"="];
+            NSString *name = (equalsRange.location == NSNotFound) ? pair : [pair substringToIndex:equalsRange.location];
+            NSString *value = (equalsRange.location == NSNotFound) ? @"" : [pair substringFromIndex:NSMaxRange(equalsRange)];
+            value = [[value stringByReplacingOccurrencesOfString:@"+" withString:@" "] stringByRemovingPercentEncoding];
+            if (name.length > 0 && nil != value)
+            {
+                queryParameters[name] = value;
+            }
+        }
+    }
+    request.path = [target stringByRemovingPercentEncoding] ?: target;
+    request.queryParameters = queryParameters;
+
+    NSMutableDictionary *headers = [NSMutableDictionary dictionary];
+    for (NSUInteger index = 1; index < lines.count; index++)
+    {
+        NSString *line = lines[index];
+        NSRange colonRange = [line rangeOfString:@":"];
+        if (colonRange.location != NSNotFound)
+        {
+            NSString *name = [[line substringToIndex:colonRange.location] lowercaseString];
+            NSString *value = [[line substringFromIndex:NSMaxRange(colonRange)] stringByTrimmingCharactersInSet:[NSCharacterSet whitespaceCharacterSet]];
+            headers[name] = value;
+        }
+    }
+    request.headers = headers;
+
+    if ([[headers[@"expect"] lowercaseString] isEqualToString:@"100-continue"])
+    {
+        NSData *continueData = [@"HTTP/1.1 100 Continue\r\n\r\n" dataUsingEncoding:NSASCIIStringEncoding];
+        [connection writeBytes:continueData.bytes length:continueData.length];
+    }
+
+    connection.bytesPerSecond = self.uploadBytesPerSecond;
+    if ([[headers[@"transfer-encoding"] lowercaseString] isEqualToString:@"chunked"])
+    {
+        while (YES)
+        {
+            NSData *sizeData = [connection readUntilDelimiter:crlf];
+            if (nil == sizeData)
+            {
+                return nil;
+            }
+            NSString *sizeString = [[NSString alloc] initWithData:sizeData encoding:NSASCIIStringEncoding];
+            unsigned long long chunkSize = strtoull(sizeString.UTF8String, NULL, 16);
+            if (chunkSize == 0)
+            {
+                // skip any trailers up to the terminating empty line
+                NSData *trailer = nil;
+                do {
+                    trailer = [connection readUntilDelimiter:crlf];
+                } while (trailer.length > 0);
+                break;
+            }
+            if (![connection readLength:chunkSize intoRequest:request] || nil == [connection readUntilDelimiter:crlf])
+            {
+                return nil;
+            }
+        }
+    }
+    else if (nil != headers[@"content-length"])
+    {
+        unsigned long long contentLength = strtoull([headers[@"content-length"] UTF8String], NULL, 10);
+        if (![connection readLength:contentLength intoRequest:request])
+        {
+            return nil;
+        }
+    }
+
+    return request;
+}
+
+- (AlfrescoStubResponse *)responseForRequest:(AlfrescoStubRequest *)request
+{
+    @synchronized(self)
+    {
+        self.requestCount++;
+        self.bodyBytesReceived += request.bodyLength;
+    }
+
+    BOOL injectFailure = NO;
+    @synchronized(self)
+    {
+        if (self.failureCount > 0)
+        {
+            self.failureCount--;
+            injectFailure = YES;
+        }
+    }
+    double failureRate = self.failureRate;
+    if (injectFailure || (failureRate > 0 && arc4random_uniform(10000) < (uint32_t)(failureRate * 10000)))
+    {
+        NSInteger failureStatusCode = self.failureStatusCode;
+        if (failureStatusCode == 0)
+        {
+            return nil;
+        }
+        AlfrescoStubResponse *response = [AlfrescoStubResponse responseWithStatusCode:failureStatusCode contentType:@"text/plain" body:[NSData data]];
+        NSUInteger retryAfter = self.failureRetryAfter;
+        if (retryAfter > 0)
+        {
+            response.headers[@"Retry-After"] = [NSString stringWithFormat:@"%lu", (unsigned long)retryAfter];
+        }
+        return response;
+    }
+
+    NSArray *routes = nil;
+    @synchronized(self.routes)
+    {
+        routes = [self.routes copy];
+    }
+
+    // routes may be given relative to the path of the base URL as well
+    NSString *basePath = self.baseURL.path;
+    NSString *relativePath = [request.path hasPrefix:basePath] ? [request.path substringFromIndex:basePath.length] : nil;
+    for (AlfrescoStubRoute *route in routes)
+    {
+        if ([route.method isEqualToString:request.method] &&
+            ([request.path hasPrefix:route.pathPrefix] || [relativePath hasPrefix:route.pathPrefix]))
+        {
+            AlfrescoStubResponse *response = route.handler(request);
+            if (nil != response)
+            {
+                return [self negotiatedResponse:response forRequest:request];
+            }
+        }
+    }
+
+    return [AlfrescoStubResponse responseWithStatusCode:404 contentType:@"text/plain" body:[NSData data]];
+}
+
+- (AlfrescoStubResponse *)negotiatedResponse:(AlfrescoStubResponse *)response forRequest:(AlfrescoStubRequest *)request
+{
+    if (nil == response.body)
+    {
+        return response;
+    }
+
+    if (self.supportsConditionalRequests && [request.method isEqualToString:@"GET"] && response.statusCode == 200)
+    {
+        NSString *entityTag = [NSString stringWithFormat:@"\"%08lx-%lu\"", crc32(0, response.body.bytes, (uInt)response.body.length), (unsigned long)response.body.length];
+        response.headers[@"ETag"] = entityTag;
+        response.headers[@"Last-Modified"] = @"Thu, 01 Jan 2015 00:00:00 GMT";
+        if ([request.headers[@"if-none-match"] isEqualToString:entityTag])
+        {
+            @synchronized(self)
+            {
+                self.notModifiedCount++;
+            }
+            response.statusCode = 304;
+            response.body = [NSData data];
+            return response;
+        }
+    }
+
+    NSString *acceptEncoding = [request.headers[@"accept-encoding"] lowercaseString];
+    if (self.compressesResponses && response.body.length > 0 && [acceptEncoding rangeOfString:@"gzip"].location != NSNotFound)
+    {
+        response.body = [self gzipData:response.body];
+        response.headers[@"Content-Encoding"] = @"gzip";
+    }
+    return response;
+}
+
+- (NSData *)gzipData:(NSData *)data
+{
+    z_stream stream;
+    memset(&stream, 0, sizeof(stream));
+    // 16 added to the window bits asks for a gzip header and trailer rather than a zlib one
+    if (deflateInit2(&stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, MAX_WBITS + 16, 8, Z_DEFAULT_STRATEGY) != Z_OK)
+    {
+        return data;
+    }
+
+    NSMutableData *compressed = [NSMutableData dataWithLength:deflateBound(&stream, (uLong)data.length)];
+    stream.next_in = (Bytef *)data.bytes;
+    stream.avail_in = (uInt)data.length;
+    stream.next_out = compressed.mutableBytes;
+    stream.avail_out = (uInt)compressed.length;
+    int status = deflate(&stream, Z_FINISH);
+    compressed.length = stream.total_out;
+    deflateEnd(&stream);
+
+    return (status == Z_STREAM_END) ? compressed : data;
+}
+
+- (BOOL)writeResponse:(AlfrescoStubResponse *)response keepAlive:(BOOL)keepAlive toConnection:(AlfrescoStubConnection *)connection
+{
+    unsigned long long contentLength = [response contentLength];
+    NSMutableString *head = [NSMutableString stringWithFormat:@"HTTP/1.1 %ld %@\r\n", (long)response.statusCode,
+                             [NSHTTPURLResponse localizedStringForStatusCode:response.statusCode]];
+    for (NSString *name in response.headers)
+    {
+        [head appendFormat:@"%@: %@\r\n", name, response.headers[name]];
+    }
+    [head appendFormat:@"Content-Length: %llu\r\n", contentLength];
+    [head appendFormat:@"Connection: %@\r\n\r\n", keepAlive ? @"keep-alive" : @"close"];
+
+    NSData *headData = [head dataUsingEncoding:NSISOLatin1StringEncoding];
+    if (![connection writeBytes:headData.bytes length:headData.length])
+    {
+        return NO;
+    }
+
+    // write the body in chunks, pacing each one when a bandwidth limit is set
+    unsigned long long bytesPerSecond = self.bytesPerSecond;
+    NSUInteger chunkLength = kAlfrescoStubServerChunkLength;
+    if (bytesPerSecond > 0)
+    {
+        chunkLength = (NSUInteger)MAX(1024ULL, MIN((unsigned long long)kAlfrescoStubServerChunkLength, bytesPerSecond / 20));
+    }
+
+    NSDate *startDate = [NSDate date];
+    unsigned long long bytesSent = 0;
+    while (bytesSent < contentLength)
+    {
+        NSUInteger length = (NSUInteger)MIN((unsigned long long)chunkLength, contentLength - bytesSent);
+        const uint8_t *bytes = (nil != response.body) ? (const uint8_t *)response.body.bytes + bytesSent : self.generatedChunk.bytes;
+        if (![connection writeBytes:bytes length:length])
+        {
+            return NO;
+        }
+        bytesSent += length;
+        @synchronized(self)
+        {
+            self.bodyBytesSent += length;
+        }
+
+        if (bytesPerSecond > 0)
+        {
+            NSTimeInterval expectedDuration = (double)bytesSent / (double)bytesPerSecond;
+            NSTimeInterval elapsed = -[startDate timeIntervalSinceNow];
+            if (expectedDuration > elapsed)
+            {
+                [NSThread sleepForTimeInterval:expectedDuration - elapsed];
+            }
+        }
+    }
+
+    return YES;
+}
+
+@end
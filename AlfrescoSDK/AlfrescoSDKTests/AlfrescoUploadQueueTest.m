@@ -0,0 +1,547 @@
+/*******************************************************************************
+ * Copyright (C) 2005-2020 Alfresco Software Limited.
+ *
+ * This file is part of the Alfresco Mobile SDK.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ******************************************************************************/
+
+#import <XCTest/XCTest.h>
+#import "AlfrescoUploadQueue.h"
+#import "AlfrescoDocumentFolderService.h"
+#import "AlfrescoErrors.h"
+#import "CMISConstants.h"
+#import "CMISErrors.h"
+
+static NSTimeInterval const kUploadQueueTestTimeout = 5.0;
+static NSTimeInterval const kUploadQueueTestRetryDelay = 0.1;
+
+// exposes the service the queue uploads with so the tests can replace it
+@interface AlfrescoUploadQueue (Testing)
+@property (nonatomic, strong) AlfrescoDocumentFolderService *documentFolderService;
+@end
+
+// the minimum of a session the upload queue needs
+@interface AlfrescoUploadQueueTestSession : NSObject <AlfrescoSession>
+@property (nonatomic, strong) NSString *personIdentifier;
+@property (nonatomic, strong) AlfrescoRepositoryInfo *repositoryInfo;
+@property (nonatomic, strong) NSURL *baseUrl;
+@property (nonatomic, strong) AlfrescoFolder *rootFolder;
+@property (nonatomic, strong) AlfrescoListingContext *defaultListingContext;
+@property (nonatomic, strong) id<AlfrescoNetworkProvider> networkProvider;
+@property (nonatomic, strong) NSMutableDictionary *parameters;
+@end
+
+@implementation AlfrescoUploadQueueTestSession
+
+- (NSArray *)allParameterKeys
+{
+    return [self.parameters allKeys];
+}
+
+- (id)objectForParameter:(id)key
+{
+    return self.parameters[key];
+}
+
+- (void)setObject:(id)object forParameter:(id)key
+{
+    self.parameters[key] = object;
+}
+
+- (void)addParametersFromDictionary:(NSDictionary *)dictionary
+{
+    [self.parameters addEntriesFromDictionary:dictionary];
+}
+
+- (void)removeParameter:(id)key
+{
+    [self.parameters removeObjectForKey:key];
+}
+
+- (void)clear
+{
+    for (id cacheObj in [self.parameters allValues])
+    {
+        if ([cacheObj respondsToSelector:@selector(clear)])
+        {
+            [cacheObj clear];
+        }
+    }
+}
+
+@end
+
+// an upload the test decides the outcome of, cancelling it completes it straight away as the HTTP requests do
+@interface AlfrescoUploadQueueTestUpload : NSObject
+@property (nonatomic, strong) NSString *documentName;
+@property (nonatomic, strong) NSDate *startDate;
+@property (nonatomic, copy) AlfrescoDocumentCompletionBlock completionBlock;
+@property (nonatomic, assign, getter = isFinished) BOOL finished;
+@end
+
+@implementation AlfrescoUploadQueueTestUpload
+
+- (void)succeed
+{
+    NSString *identifier = [@"workspace://SpacesStore/" stringByAppendingString:self.documentName];
+    AlfrescoDocument *document = [[AlfrescoDocument alloc] initWithProperties:@{kCMISPropertyObjectId: identifier,
+                                                                                kCMISPropertyObjectTypeId: kCMISPropertyObjectTypeIdValueDocument,
+                                                                                kCMISPropertyName: self.documentName}];
+    [self finishWithDocument:document error:nil];
+}
+
+- (void)failWithError:(NSError *)error
+{
+    [self finishWithDocument:nil error:error];
+}
+
+- (void)cancel
+{
+    [self failWithError:[AlfrescoErrors alfrescoErrorWithAlfrescoErrorCode:kAlfrescoErrorCodeNetworkRequestCancelled]];
+}
+
+- (void)finishWithDocument:(AlfrescoDocument *)document error:(NSError *)error
+{
+    if (self.isFinished)
+    {
+        return;
+    }
+    self.finished = YES;
+    self.completionBlock(document, error);
+}
+
+@end
+
+// records the uploads the queue starts instead of sending them
+@interface AlfrescoUploadQueueTestService : AlfrescoDocumentFolderService
+@property (nonatomic, strong) NSMutableArray *uploads;
+@end
+
+@implementation AlfrescoUploadQueueTestService
+
+- (AlfrescoRequest *)createDocumentWithName:(NSString *)documentName
+                             inParentFolder:(AlfrescoFolder *)folder
+                                contentFile:(AlfrescoContentFile *)file
+                                 properties:(NSDictionary *)properties
+                            completionBlock:(AlfrescoDocumentCompletionBlock)completionBlock
+                              progressBlock:(AlfrescoProgressBlock)progressBlock
+{
+    AlfrescoUploadQueueTestUpload *upload = [[AlfrescoUploadQueueTestUpload alloc] init];
+    upload.documentName = documentName;
+    upload.startDate = [NSDate date];
+    upload.completionBlock = completionBlock;
+    @synchronized(self.uploads)
+    {
+        [self.uploads addObject:upload];
+    }
+    
+    AlfrescoRequest *request = [[AlfrescoRequest alloc] init];
+    request.httpRequest = upload;
+    return request;
+}
+
+- (NSArray *)runningUploads
+{
+    @synchronized(self.uploads)
+    {
+        return [self.uploads filteredArrayUsingPredicate:[NSPredicate predicateWithFormat:@"finished == NO"]];
+    }
+}
+
+- (NSArray *)startedDocumentNames
+{
+    @synchronized(self.uploads)
+    {
+        return [self.uploads valueForKey:@"documentName"];
+    }
+}
+
+@end
+
+@interface AlfrescoUploadQueueTest : XCTestCase <AlfrescoUploadQueueDelegate>
+@property (nonatomic, strong) AlfrescoUploadQueueTestSession *session;
+@property (nonatomic, strong) AlfrescoFolder *folder;
+@property (nonatomic, strong) AlfrescoContentFile *contentFile;
+@property (nonatomic, strong) NSString *persistencePath;
+@property (nonatomic, assign) NSUInteger finishCount;
+@property (atomic, assign) NSUInteger offMainThreadCallbackCount;
+@end
+
+@implementation AlfrescoUploadQueueTest
+
+- (void)setUp
+{
+    [super setUp];
+    
+    self.session = [[AlfrescoUploadQueueTestSession alloc] init];
+    self.session.parameters = [NSMutableDictionary dictionary];
+    self.folder = [[AlfrescoFolder alloc] initWithProperties:@{kCMISPropertyObjectId: @"workspace://SpacesStore/folder",
+                                                               kCMISPropertyObjectTypeId: kCMISPropertyObjectTypeIdValueFolder,
+                                                               kCMISPropertyName: @"folder"}];
+    self.contentFile = [[AlfrescoContentFile alloc] initWithData:[@"upload queue test" dataUsingEncoding:NSUTF8StringEncoding] mimeType:@"text/plain"];
+    self.persistencePath = [NSTemporaryDirectory() stringByAppendingPathComponent:@"AlfrescoUploadQueueTest.queue"];
+    [[NSFileManager defaultManager] removeItemAtPath:self.persistencePath error:nil];
+}
+
+- (void)tearDown
+{
+    [[NSFileManager defaultManager] removeItemAtPath:self.persistencePath error:nil];
+    [[NSFileManager defaultManager] removeItemAtURL:self.contentFile.fileUrl error:nil];
+    [super tearDown];
+}
+
+- (void)testItemsStartByPriority
+{
+    AlfrescoUploadQueueTestService *service = nil;
+    AlfrescoUploadQueue *queue = [self uploadQueueWithPersistencePath:nil service:&service];
+    queue.maxConcurrentUploads = 1;
+    
+    // queued while paused so the order isn't decided by the first item starting straight away
+    [queue pause];
+    [self addUploadsWithNames:@[@"low", @"high1", @"medium", @"high2"] priorities:@[@0, @5, @1, @5] toQueue:queue];
+    [queue resume];
+    
+    for (NSUInteger index = 0; index < 4; index++)
+    {
+        XCTAssertTrue([self waitForCondition:^BOOL{
+            return service.runningUploads.count == 1 && service.uploads.count == index + 1;
+        }], @"Expected upload %lu to be started on its own", (unsigned long)index);
+        [service.runningUploads.firstObject succeed];
+    }
+    
+    XCTAssertTrue([self waitForCondition:^BOOL{
+        return self.finishCount == 1;
+    }], @"Expected the queue to finish");
+    NSArray *expectedNames = @[@"high1", @"high2", @"medium", @"low"];
+    XCTAssertEqualObjects(service.startedDocumentNames, expectedNames, @"Expected the uploads to start by priority, then in the order they were added");
+    for (AlfrescoUploadItem *item in queue.items)
+    {
+        XCTAssertTrue(item.state == AlfrescoUploadItemStateCompleted, @"Expected %@ to be completed", item.documentName);
+        XCTAssertEqualObjects(item.document.name, item.documentName, @"Expected the created document to be set");
+    }
+}
+
+- (void)testPauseRequeuesRunningUploads
+{
+    AlfrescoUploadQueueTestService *service = nil;
+    AlfrescoUploadQueue *queue = [self uploadQueueWithPersistencePath:nil service:&service];
+    queue.maxConcurrentUploads = 2;
+    [self addUploadsWithNames:@[@"first", @"second", @"third"] priorities:@[@0, @0, @0] toQueue:queue];
+    XCTAssertTrue([self waitForCondition:^BOOL{
+        return service.runningUploads.count == 2;
+    }], @"Expected two uploads to be running");
+    
+    [queue pause];
+    XCTAssertTrue(queue.isPaused, @"Expected the queue to be paused");
+    XCTAssertTrue([self waitForCondition:^BOOL{
+        return [self itemsOfQueue:queue inState:AlfrescoUploadItemStateQueued].count == 3;
+    }], @"Expected the cancelled uploads to be queued again");
+    for (AlfrescoUploadItem *item in queue.items)
+    {
+        XCTAssertTrue(item.attemptCount == 0, @"Expected the attempt cancelled by the pause not to count for %@", item.documentName);
+    }
+    
+    // nothing starts while paused
+    [[NSRunLoop currentRunLoop] runUntilDate:[NSDate dateWithTimeIntervalSinceNow:0.2]];
+    XCTAssertTrue(service.uploads.count == 2 && service.runningUploads.count == 0, @"Expected no uploads to start while paused");
+    XCTAssertTrue(self.finishCount == 0, @"Expected the paused queue not to finish");
+    
+    [queue resume];
+    XCTAssertTrue([self waitForCondition:^BOOL{
+        return service.runningUploads.count == 2;
+    }], @"Expected two uploads to be running again");
+    NSArray *restartedNames = [[service.startedDocumentNames subarrayWithRange:NSMakeRange(2, 2)] copy];
+    XCTAssertEqualObjects(restartedNames, (@[@"first", @"second"]), @"Expected the paused uploads to start again in their original order");
+    
+    for (AlfrescoUploadQueueTestUpload *upload in service.runningUploads)
+    {
+        [upload succeed];
+    }
+    XCTAssertTrue([self waitForCondition:^BOOL{
+        return service.runningUploads.count == 1;
+    }], @"Expected the third upload to start");
+    [service.runningUploads.firstObject succeed];
+    XCTAssertTrue([self waitForCondition:^BOOL{
+        return self.finishCount == 1;
+    }], @"Expected the queue to finish");
+    XCTAssertTrue([self itemsOfQueue:queue inState:AlfrescoUploadItemStateCompleted].count == 3, @"Expected every item to be completed");
+    XCTAssertTrue(queue.bytesUploaded == queue.bytesTotal, @"Expected the uploaded bytes to be counted once");
+}
+
+- (void)testTransientFailuresAreRetriedWithBackoff
+{
+    AlfrescoUploadQueueTestService *service = nil;
+    AlfrescoUploadQueue *queue = [self uploadQueueWithPersistencePath:nil service:&service];
+    queue.retryDelay = kUploadQueueTestRetryDelay;
+    queue.maxRetryCount = 2;
+    AlfrescoUploadItem *item = [self addUploadsWithNames:@[@"flaky"] priorities:@[@0] toQueue:queue].firstObject;
+    
+    NSArray *errors = @[[NSError errorWithDomain:NSURLErrorDomain code:NSURLErrorTimedOut userInfo:nil],
+                        [self cmisErrorWithCode:kCMISErrorCodeRuntime statusCode:503],
+                        [NSError errorWithDomain:NSURLErrorDomain code:NSURLErrorNetworkConnectionLost userInfo:nil]];
+    NSMutableArray *failureDates = [NSMutableArray array];
+    for (NSUInteger attempt = 0; attempt < errors.count; attempt++)
+    {
+        XCTAssertTrue([self waitForCondition:^BOOL{
+            return service.runningUploads.count == 1 && service.uploads.count == attempt + 1;
+        }], @"Expected attempt %lu to be started", (unsigned long)(attempt + 1));
+        
+        if (attempt > 0)
+        {
+            // the delay doubles with every attempt
+            NSTimeInterval expectedDelay = kUploadQueueTestRetryDelay * pow(2, attempt - 1);
+            NSTimeInterval delay = [[service.uploads[attempt] startDate] timeIntervalSinceDate:failureDates[attempt - 1]];
+            XCTAssertTrue(delay >= expectedDelay * 0.9, @"Expected attempt %lu to wait at least %.2f seconds but it waited %.2f", (unsigned long)(attempt + 1), expectedDelay, delay);
+        }
+        
+        [failureDates addObject:[NSDate date]];
+        [service.runningUploads.firstObject failWithError:errors[attempt]];
+        if (attempt < errors.count - 1)
+        {
+            XCTAssertTrue([self waitForCondition:^BOOL{
+                return item.state == AlfrescoUploadItemStateWaitingToRetry;
+            }], @"Expected the item to wait for a retry after a transient error");
+        }
+    }
+    
+    XCTAssertTrue([self waitForCondition:^BOOL{
+        return item.state == AlfrescoUploadItemStateFailed;
+    }], @"Expected the item to fail once the retries are used up");
+    XCTAssertTrue(item.attemptCount == 3, @"Expected 3 attempts but there were %lu", (unsigned long)item.attemptCount);
+    XCTAssertEqualObjects(item.error, errors.lastObject, @"Expected the error of the last attempt");
+    XCTAssertTrue(self.finishCount == 1, @"Expected the queue to finish");
+    
+    // a failed item can be queued again by hand, starting with a fresh set of retries
+    [queue retryItem:item];
+    XCTAssertTrue([self waitForCondition:^BOOL{
+        return service.runningUploads.count == 1;
+    }], @"Expected the retried item to start");
+    XCTAssertTrue(item.attemptCount == 1, @"Expected the attempts to be counted from the start again");
+    [service.runningUploads.firstObject succeed];
+    XCTAssertTrue([self waitForCondition:^BOOL{
+        return item.state == AlfrescoUploadItemStateCompleted;
+    }], @"Expected the retried item to complete");
+}
+
+- (void)testPermanentFailuresAreNotRetried
+{
+    NSArray *errors = @[[self cmisErrorWithCode:kCMISErrorCodeRuntime statusCode:0],
+                        [self cmisErrorWithCode:kCMISErrorCodeNameConstraintViolation statusCode:409],
+                        [self cmisErrorWithCode:kCMISErrorCodePermissionDenied statusCode:403],
+                        [AlfrescoErrors alfrescoErrorWithUnderlyingError:[self cmisErrorWithCode:kCMISErrorCodeRuntime statusCode:0]
+                                                    andAlfrescoErrorCode:kAlfrescoErrorCodeUnknown],
+                        [NSError errorWithDomain:NSURLErrorDomain code:NSURLErrorBadServerResponse userInfo:nil]];
+    
+    AlfrescoUploadQueueTestService *service = nil;
+    AlfrescoUploadQueue *queue = [self uploadQueueWithPersistencePath:nil service:&service];
+    queue.maxConcurrentUploads = errors.count;
+    queue.retryDelay = kUploadQueueTestRetryDelay;
+    NSMutableArray *names = [NSMutableArray array];
+    NSMutableArray *priorities = [NSMutableArray array];
+    for (NSUInteger index = 0; index < errors.count; index++)
+    {
+        [names addObject:[NSString stringWithFormat:@"rejected%lu", (unsigned long)index]];
+        [priorities addObject:@0];
+    }
+    NSArray *items = [self addUploadsWithNames:names priorities:priorities toQueue:queue];
+    XCTAssertTrue([self waitForCondition:^BOOL{
+        return service.runningUploads.count == errors.count;
+    }], @"Expected every upload to be running");
+    
+    [service.uploads enumerateObjectsUsingBlock:^(AlfrescoUploadQueueTestUpload *upload, NSUInteger index, BOOL *stop) {
+        [upload failWithError:errors[index]];
+    }];
+    XCTAssertTrue([self waitForCondition:^BOOL{
+        return self.finishCount == 1;
+    }], @"Expected the queue to finish");
+    for (AlfrescoUploadItem *item in items)
+    {
+        XCTAssertTrue(item.state == AlfrescoUploadItemStateFailed, @"Expected %@ to fail straight away after %@", item.documentName, item.error);
+        XCTAssertTrue(item.attemptCount == 1, @"Expected %@ not to be retried", item.documentName);
+    }
+    XCTAssertTrue(service.uploads.count == errors.count, @"Expected no further uploads to be started");
+}
+
+- (void)testUnfinishedItemsAreRestored
+{
+    AlfrescoUploadQueueTestService *service = nil;
+    AlfrescoUploadQueue *queue = [self uploadQueueWithPersistencePath:self.persistencePath service:&service];
+    queue.maxConcurrentUploads = 1;
+    [self addUploadsWithNames:@[@"completed", @"failed", @"uploading", @"queued"] priorities:@[@3, @2, @1, @0] toQueue:queue];
+    
+    XCTAssertTrue([self waitForCondition:^BOOL{
+        return service.runningUploads.count == 1;
+    }], @"Expected the first upload to start");
+    [service.runningUploads.firstObject succeed];
+    XCTAssertTrue([self waitForCondition:^BOOL{
+        return service.uploads.count == 2 && service.runningUploads.count == 1;
+    }], @"Expected the second upload to start");
+    // the user info of the error holds an object that can't be archived
+    NSError *permissionError = [self cmisErrorWithCode:kCMISErrorCodePermissionDenied statusCode:403];
+    NSMutableDictionary *userInfo = [NSMutableDictionary dictionaryWithDictionary:permissionError.userInfo];
+    userInfo[@"unarchivable"] = [[NSObject alloc] init];
+    permissionError = [NSError errorWithDomain:permissionError.domain code:permissionError.code userInfo:userInfo];
+    [service.runningUploads.firstObject failWithError:permissionError];
+    XCTAssertTrue([self waitForCondition:^BOOL{
+        return service.uploads.count == 3 && service.runningUploads.count == 1;
+    }], @"Expected the third upload to start");
+    
+    // the app stops while the third item is uploading
+    XCTAssertTrue([self waitForCondition:^BOOL{
+        return [[NSFileManager defaultManager] fileExistsAtPath:self.persistencePath];
+    }], @"Expected the queue to be saved");
+    [[NSRunLoop currentRunLoop] runUntilDate:[NSDate dateWithTimeIntervalSinceNow:0.1]];
+    queue.delegate = nil;
+    queue = nil;
+    
+    AlfrescoUploadQueueTestService *restoredService = nil;
+    AlfrescoUploadQueue *restoredQueue = [self uploadQueueWithPersistencePath:self.persistencePath service:&restoredService];
+    restoredQueue.maxConcurrentUploads = 1;
+    NSArray *restoredNames = [restoredQueue.items valueForKey:@"documentName"];
+    XCTAssertEqualObjects(restoredNames, (@[@"failed", @"uploading", @"queued"]), @"Expected the unfinished items to be restored");
+    
+    AlfrescoUploadItem *failedItem = restoredQueue.items.firstObject;
+    XCTAssertTrue(failedItem.state == AlfrescoUploadItemStateFailed, @"Expected the failed item to stay failed");
+    XCTAssertEqualObjects(failedItem.error.domain, permissionError.domain, @"Expected the domain of the error to be restored");
+    XCTAssertTrue(failedItem.error.code == permissionError.code, @"Expected the code of the error to be restored");
+    XCTAssertEqualObjects(failedItem.error.localizedDescription, permissionError.localizedDescription, @"Expected the description of the error to be restored");
+    XCTAssertEqualObjects(failedItem.folder.identifier, self.folder.identifier, @"Expected the folder to be restored");
+    XCTAssertEqualObjects(failedItem.contentFile.fileUrl, self.contentFile.fileUrl, @"Expected the content file to be restored");
+    
+    // the interrupted upload starts from the beginning, ahead of the one that was queued behind it
+    XCTAssertTrue([self waitForCondition:^BOOL{
+        return restoredService.runningUploads.count == 1;
+    }], @"Expected the restored items to start without being added again");
+    XCTAssertEqualObjects([restoredService.runningUploads.firstObject documentName], @"uploading", @"Expected the interrupted upload to start first");
+    [restoredService.runningUploads.firstObject succeed];
+    XCTAssertTrue([self waitForCondition:^BOOL{
+        return restoredService.uploads.count == 2 && restoredService.runningUploads.count == 1;
+    }], @"Expected the queued upload to start");
+    [restoredService.runningUploads.firstObject succeed];
+    XCTAssertTrue([self waitForCondition:^BOOL{
+        return self.finishCount == 1;
+    }], @"Expected the restored queue to finish");
+    
+    // only the failed item is left to be saved
+    [restoredQueue removeFinishedItems];
+    XCTAssertTrue([self waitForCondition:^BOOL{
+        NSArray *savedItems = [NSKeyedUnarchiver unarchiveObjectWithFile:self.persistencePath];
+        return savedItems.count == 0;
+    }], @"Expected the finished items to be removed from the saved queue");
+}
+
+- (void)testCompletionsOnAConcurrentQueueAreHandledOnTheMainQueue
+{
+    NSUInteger uploadCount = 20;
+    AlfrescoUploadQueueTestService *service = nil;
+    AlfrescoUploadQueue *queue = [self uploadQueueWithPersistencePath:nil service:&service];
+    queue.maxConcurrentUploads = uploadCount;
+    NSMutableArray *names = [NSMutableArray array];
+    NSMutableArray *priorities = [NSMutableArray array];
+    for (NSUInteger index = 0; index < uploadCount; index++)
+    {
+        [names addObject:[NSString stringWithFormat:@"concurrent%lu", (unsigned long)index]];
+        [priorities addObject:@0];
+    }
+    NSArray *items = [self addUploadsWithNames:names priorities:priorities toQueue:queue];
+    XCTAssertTrue([self waitForCondition:^BOOL{
+        return service.runningUploads.count == uploadCount;
+    }], @"Expected every upload to be running");
+    
+    // a kAlfrescoCompletionQueue may be concurrent, the uploads complete on several threads at once
+    NSArray *uploads = [service.uploads copy];
+    dispatch_apply(uploads.count, dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^(size_t index) {
+        [uploads[index] succeed];
+    });
+    XCTAssertTrue([self waitForCondition:^BOOL{
+        return self.finishCount == 1;
+    }], @"Expected the queue to finish");
+    XCTAssertTrue(self.offMainThreadCallbackCount == 0, @"Expected the delegate to be called on the main thread only");
+    for (AlfrescoUploadItem *item in items)
+    {
+        XCTAssertTrue(item.state == AlfrescoUploadItemStateCompleted, @"Expected %@ to be completed", item.documentName);
+    }
+    XCTAssertTrue(queue.bytesUploaded == queue.bytesTotal, @"Expected every byte to be counted once");
+}
+
+#pragma mark - AlfrescoUploadQueueDelegate
+
+- (void)uploadQueue:(AlfrescoUploadQueue *)uploadQueue didChangeStateOfItem:(AlfrescoUploadItem *)item
+{
+    if (![NSThread isMainThread])
+    {
+        self.offMainThreadCallbackCount++;
+    }
+}
+
+- (void)uploadQueueDidFinish:(AlfrescoUploadQueue *)uploadQueue
+{
+    if (![NSThread isMainThread])
+    {
+        self.offMainThreadCallbackCount++;
+    }
+    self.finishCount++;
+}
+
+#pragma mark - Private methods
+
+- (AlfrescoUploadQueue *)uploadQueueWithPersistencePath:(NSString *)persistencePath service:(AlfrescoUploadQueueTestService **)service
+{
+    AlfrescoUploadQueue *queue = [[AlfrescoUploadQueue alloc] initWithSession:self.session persistencePath:persistencePath];
+    AlfrescoUploadQueueTestService *testService = [[AlfrescoUploadQueueTestService alloc] initWithSession:self.session];
+    testService.uploads = [NSMutableArray array];
+    queue.documentFolderService = testService;
+    queue.delegate = self;
+    *service = testService;
+    return queue;
+}
+
+- (NSArray *)addUploadsWithNames:(NSArray *)names priorities:(NSArray *)priorities toQueue:(AlfrescoUploadQueue *)queue
+{
+    NSMutableArray *items = [NSMutableArray arrayWithCapacity:names.count];
+    [names enumerateObjectsUsingBlock:^(NSString *name, NSUInteger index, BOOL *stop) {
+        [items addObject:[queue addUploadWithName:name inParentFolder:self.folder contentFile:self.contentFile properties:nil priority:[priorities[index] integerValue]]];
+    }];
+    return items;
+}
+
+- (NSArray *)itemsOfQueue:(AlfrescoUploadQueue *)queue inState:(AlfrescoUploadItemState)state
+{
+    return [queue.items filteredArrayUsingPredicate:[NSPredicate predicateWithFormat:@"state == %ld", (long)state]];
+}
+
+- (NSError *)cmisErrorWithCode:(CMISErrorCodes)code statusCode:(NSInteger)statusCode
+{
+    NSError *error = [CMISErrors createCMISErrorWithCode:code detailedDescription:nil];
+    if (statusCode > 0)
+    {
+        NSMutableDictionary *userInfo = [NSMutableDictionary dictionaryWithDictionary:error.userInfo];
+        userInfo[kCMISErrorKeyHTTPStatusCode] = @(statusCode);
+        error = [NSError errorWithDomain:error.domain code:error.code userInfo:userInfo];
+    }
+    return error;
+}
+
+// the queue changes state on the main queue, the run loop is turned until it's done or the time runs out
+- (BOOL)waitForCondition:(BOOL (^)(void))condition
+{
+    NSDate *timeoutDate = [NSDate dateWithTimeIntervalSinceNow:kUploadQueueTestTimeout];
+    while (!condition() && [timeoutDate timeIntervalSinceNow] > 0)
+    {
+        [[NSRunLoop currentRunLoop] runUntilDate:[NSDate dateWithTimeIntervalSinceNow:0.01]];
+    }
+    return condition();
+}
+
+@end
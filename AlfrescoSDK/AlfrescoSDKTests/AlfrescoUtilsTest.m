@@ -35,6 +35,36 @@
 #import "AlfrescoVersionInfo.h"
 #import "AlfrescoFileManager.h"
 #import "AlfrescoWorkflowObjectConverter.h"
+#import "CMISBindingSession.h"
+#import "CMISSessionParameters.h"
+#import "CMISLinkCache.h"
+#import "CMISLinkRelations.h"
+#import "CMISAtomLink.h"
+#import "CMISAtomPubConstants.h"
+#import "CMISURLUtil.h"
+#import "CMISURLBuilder.h"
+#import "CMISQueryStatement.h"
+#import "CMISRequestMetrics.h"
+#import "CMISRequest.h"
+#import "CMISConstants.h"
+#import "AlfrescoRequestMetricsHistogram.h"
+#import "AlfrescoFavoritesCache.h"
+
+// returns the favorites it is given, along with the error of those that could not be resolved
+@interface AlfrescoUtilsTestFavoritesDelegate : NSObject <AlfrescoFavoritesCacheDataDelegate>
+@property (nonatomic, strong) NSArray *favoriteNodes;
+@property (nonatomic, strong) NSError *error;
+@end
+
+@implementation AlfrescoUtilsTestFavoritesDelegate
+
+- (AlfrescoRequest *)retrieveFavoriteNodeDataWithCompletionBlock:(AlfrescoArrayCompletionBlock)completionBlock
+{
+    completionBlock(self.favoriteNodes, self.error);
+    return [AlfrescoRequest new];
+}
+
+@end
 
 @implementation AlfrescoUtilsTest
 
@@ -321,4 +351,196 @@
                   @"Expected decoded variable name to be 'custom:name_with_more_underscores' but it was: %@", decodedVariableName);
 }
 
+- (CMISLinkRelations *)linkRelationsForObjectId:(NSString *)objectId
+{
+    NSString *encodedObjectId = [CMISURLUtil encodeUrlParameterValue:objectId];
+    NSString *selfLink = [NSString stringWithFormat:@"http://localhost/atom/entry?id=%@", encodedObjectId];
+    NSString *childrenLink = [NSString stringWithFormat:@"http://localhost/atom/children?id=%@&filter=*", encodedObjectId];
+    NSString *contentLink = [NSString stringWithFormat:@"http://localhost/atom/content/%@.txt?id=%@", [objectId lastPathComponent], encodedObjectId];
+    NSSet *links = [NSSet setWithObjects:[[CMISAtomLink alloc] initWithRelation:kCMISLinkRelationSelf type:kCMISMediaTypeEntry href:selfLink],
+                    [[CMISAtomLink alloc] initWithRelation:kCMISLinkRelationDown type:kCMISMediaTypeChildren href:childrenLink],
+                    [[CMISAtomLink alloc] initWithRelation:kCMISLinkEditMedia type:nil href:contentLink], nil];
+    return [[CMISLinkRelations alloc] initWithLinkRelationSet:links];
+}
+
+- (void)testLinkCache
+{
+    NSString *persistencePath = [NSTemporaryDirectory() stringByAppendingPathComponent:@"AlfrescoUtilsTestLinkCache.plist"];
+    [[NSFileManager defaultManager] removeItemAtPath:persistencePath error:nil];
+    
+    CMISSessionParameters *parameters = [[CMISSessionParameters alloc] initWithBindingType:CMISBindingTypeAtomPub];
+    [parameters setObject:@YES forKey:kCMISSessionParameterLinkCacheDeriveLinks];
+    [parameters setObject:persistencePath forKey:kCMISSessionParameterLinkCachePersistencePath];
+    CMISBindingSession *bindingSession = [[CMISBindingSession alloc] initWithSessionParameters:parameters];
+    
+    // nothing can be derived until a URL pattern has been seen for more than one object
+    CMISLinkCache *linkCache = [[CMISLinkCache alloc] initWithBindingSession:bindingSession];
+    [linkCache addLinks:[self linkRelationsForObjectId:@"workspace://SpacesStore/folder-1"] objectId:@"workspace://SpacesStore/folder-1"];
+    XCTAssertNil([linkCache linkForObjectId:@"workspace://SpacesStore/folder-3" relation:kCMISLinkRelationSelf], @"Expected no link to be derived from a single object");
+    
+    [linkCache addLinks:[self linkRelationsForObjectId:@"workspace://SpacesStore/folder-2"] objectId:@"workspace://SpacesStore/folder-2"];
+    XCTAssertNotNil([linkCache linkForObjectId:@"workspace://SpacesStore/folder-1" relation:kCMISLinkRelationDown type:kCMISMediaTypeChildren], @"Expected the cached children link");
+    
+    NSString *expectedChildrenLink = [[self linkRelationsForObjectId:@"workspace://SpacesStore/folder-3"] linkHrefForRel:kCMISLinkRelationDown type:kCMISMediaTypeChildren];
+    NSString *derivedChildrenLink = [linkCache linkForObjectId:@"workspace://SpacesStore/folder-3" relation:kCMISLinkRelationDown type:kCMISMediaTypeChildren];
+    XCTAssertTrue([derivedChildrenLink isEqualToString:expectedChildrenLink], @"Expected derived link to be %@ but it was %@", expectedChildrenLink, derivedChildrenLink);
+    
+    // the content links contain the object name, so their pattern differs between objects and must not be used
+    XCTAssertNil([linkCache linkForObjectId:@"workspace://SpacesStore/folder-3" relation:kCMISLinkEditMedia], @"Expected no content link to be derived");
+    
+    XCTAssertTrue(linkCache.hitCount == 1, @"Expected 1 hit but there were %lu", (unsigned long)linkCache.hitCount);
+    XCTAssertTrue(linkCache.derivedCount == 1, @"Expected 1 derived link but there were %lu", (unsigned long)linkCache.derivedCount);
+    XCTAssertTrue(linkCache.missCount == 2, @"Expected 2 misses but there were %lu", (unsigned long)linkCache.missCount);
+    
+    // links should survive into a new cache through the persisted file
+    XCTAssertTrue([linkCache persistLinks], @"Expected the links to be persisted");
+    CMISLinkCache *restoredLinkCache = [[CMISLinkCache alloc] initWithBindingSession:bindingSession];
+    NSString *restoredSelfLink = [restoredLinkCache linkForObjectId:@"workspace://SpacesStore/folder-2" relation:kCMISLinkRelationSelf];
+    XCTAssertNotNil(restoredSelfLink, @"Expected the self link to be restored");
+    XCTAssertTrue(restoredLinkCache.hitCount == 1, @"Expected the restored link to be a cache hit");
+    
+    [[NSFileManager defaultManager] removeItemAtPath:persistencePath error:nil];
+}
+
+- (void)testRequestMetricsHistogram
+{
+    AlfrescoRequest *request = [[AlfrescoRequest alloc] initWithService:self operation:_cmd];
+    NSString *expectedOperationName = @"AlfrescoUtilsTest testRequestMetricsHistogram";
+    XCTAssertTrue([request.operationName isEqualToString:expectedOperationName], @"Expected operation name %@ but it was %@", expectedOperationName, request.operationName);
+    XCTAssertNil([[AlfrescoRequest alloc] init].operationName, @"Expected no operation name for a plain request");
+    
+    AlfrescoRequestMetricsHistogram *histogram = [AlfrescoRequestMetricsHistogram new];
+    NSDate *enqueueDate = [NSDate date];
+    NSArray *durations = @[@0.003, @0.02, @0.04, @0.08, @0.3, @0.4, @0.45, @0.6, @0.7, @3];
+    for (NSNumber *duration in durations)
+    {
+        CMISRequestMetrics *cmisMetrics = [[CMISRequestMetrics alloc] initWithURL:[NSURL URLWithString:@"http://localhost/alfresco"] httpMethod:@"GET"];
+        cmisMetrics.operationName = request.operationName;
+        cmisMetrics.enqueueDate = enqueueDate;
+        cmisMetrics.endDate = [enqueueDate dateByAddingTimeInterval:duration.doubleValue];
+        cmisMetrics.bytesReceived = 100;
+        [histogram requestDidFinishWithMetrics:[[AlfrescoRequestMetrics alloc] initWithCMISRequestMetrics:cmisMetrics]];
+    }
+    
+    // requests without an operation are recorded against the unknown operation
+    CMISRequestMetrics *failedMetrics = [[CMISRequestMetrics alloc] initWithURL:[NSURL URLWithString:@"http://localhost/alfresco"] httpMethod:@"POST"];
+    failedMetrics.error = [NSError errorWithDomain:@"test" code:1 userInfo:nil];
+    [histogram requestDidFinishWithMetrics:[[AlfrescoRequestMetrics alloc] initWithCMISRequestMetrics:failedMetrics]];
+    
+    NSArray *expectedNames = @[expectedOperationName, @"unknown"];
+    XCTAssertEqualObjects([histogram operationNames], expectedNames, @"Unexpected operation names");
+    XCTAssertTrue([histogram requestCountForOperation:expectedOperationName] == 10, @"Expected 10 requests");
+    XCTAssertTrue([histogram requestCountForOperation:nil] == 11, @"Expected 11 requests in total");
+    XCTAssertTrue([histogram errorCountForOperation:nil] == 1, @"Expected 1 failed request");
+    XCTAssertTrue([histogram bytesReceivedForOperation:expectedOperationName] == 1000, @"Expected 1000 bytes received");
+    XCTAssertEqualWithAccuracy([histogram durationAtPercentile:50 forOperation:expectedOperationName], 0.5, 0.0001, @"Expected the median in the 0.5s bucket");
+    XCTAssertEqualWithAccuracy([histogram durationAtPercentile:90 forOperation:expectedOperationName], 1, 0.0001, @"Expected the 90th percentile in the 1s bucket");
+    XCTAssertEqualWithAccuracy([histogram durationAtPercentile:100 forOperation:expectedOperationName], 5, 0.0001, @"Expected the slowest request in the 5s bucket");
+    
+    [histogram reset];
+    XCTAssertTrue([histogram requestCountForOperation:nil] == 0, @"Expected no requests after a reset");
+    XCTAssertTrue([histogram durationAtPercentile:50 forOperation:nil] == 0, @"Expected no duration after a reset");
+}
+
+- (void)testOperationNameOfChainedCMISRequest
+{
+    // the CMIS request is handed over before it has made any HTTP request, e.g. while it looks up a link
+    AlfrescoRequest *request = [[AlfrescoRequest alloc] initWithService:self operation:_cmd];
+    CMISRequest *cmisRequest = [[CMISRequest alloc] init];
+    request.httpRequest = cmisRequest;
+    XCTAssertEqualObjects(cmisRequest.operationName, request.operationName, @"Expected the CMIS request to be named");
+    
+    CMISRequest *chainedRequest = [[CMISRequest alloc] init];
+    cmisRequest.httpRequest = chainedRequest;
+    CMISRequest *subRequest = [[CMISRequest alloc] init];
+    [cmisRequest addSubRequest:subRequest];
+    XCTAssertEqualObjects(chainedRequest.operationName, request.operationName, @"Expected the chained request to be named");
+    XCTAssertEqualObjects(subRequest.operationName, request.operationName, @"Expected the sub request to be named");
+    
+    // the name travels with the URL request so the metrics are named before the request starts
+    NSMutableURLRequest *urlRequest = [NSMutableURLRequest requestWithURL:[NSURL URLWithString:@"http://localhost/alfresco"]];
+    [CMISRequestMetrics setOperationName:chainedRequest.operationName forRequest:urlRequest];
+    XCTAssertEqualObjects([CMISRequestMetrics operationNameForRequest:urlRequest], request.operationName, @"Expected the URL request to carry the name");
+    XCTAssertNil([CMISRequestMetrics operationNameForRequest:[NSURLRequest requestWithURL:urlRequest.URL]], @"Expected no name on a plain URL request");
+}
+
+- (void)testFavoritesCacheReportsUnresolvedFavorites
+{
+    AlfrescoUtilsTestFavoritesDelegate *delegate = [AlfrescoUtilsTestFavoritesDelegate new];
+    delegate.favoriteNodes = @[[[AlfrescoDocument alloc] initWithProperties:@{kCMISPropertyObjectId: @"workspace://SpacesStore/resolved",
+                                                                              kCMISPropertyObjectTypeId: @"cmis:document"}]];
+    NSDictionary *itemErrors = @{@"workspace://SpacesStore/deleted": [AlfrescoErrors alfrescoErrorWithAlfrescoErrorCode:kAlfrescoErrorCodeRequestedNodeNotFound]};
+    delegate.error = [AlfrescoErrors alfrescoErrorWithAlfrescoErrorCode:kAlfrescoErrorCodeDocumentFolder userInfo:@{kAlfrescoErrorKeyItemErrors: itemErrors}];
+    
+    AlfrescoFavoritesCache *favoritesCache = [AlfrescoFavoritesCache new];
+    __block BOOL completed = NO;
+    [favoritesCache buildCacheWithDelegate:delegate completionBlock:^(BOOL succeeded, NSError *error) {
+        XCTAssertTrue(succeeded, @"Expected the cache to be built from the resolved favorites");
+        XCTAssertNil(error, @"Expected a successful build to pass no error");
+        completed = YES;
+    }];
+    XCTAssertTrue(completed, @"Expected the cache to be built");
+    XCTAssertTrue(favoritesCache.isCacheBuilt, @"Expected the cache to be built");
+    XCTAssertTrue(favoritesCache.favoriteDocuments.count == 1, @"Expected the resolved favorite to be cached");
+    XCTAssertEqualObjects(favoritesCache.unresolvedFavoriteErrors, itemErrors, @"Expected the unresolved favorites to be reported");
+}
+
+- (void)testFavoritesCacheCanBeUsedConcurrently
+{
+    AlfrescoFavoritesCache *favoritesCache = [AlfrescoFavoritesCache new];
+    dispatch_apply(1000, dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^(size_t index) {
+        NSString *identifier = [NSString stringWithFormat:@"workspace://SpacesStore/node%zu", index % 100];
+        AlfrescoDocument *document = [[AlfrescoDocument alloc] initWithProperties:@{kCMISPropertyObjectId: identifier,
+                                                                                    kCMISPropertyObjectTypeId: @"cmis:document"}];
+        [favoritesCache cacheNode:document favorite:YES];
+        [favoritesCache isNodeFavorited:document];
+        [favoritesCache favoriteDocuments];
+    });
+    XCTAssertTrue(favoritesCache.favoriteNodes.count == 100, @"Expected every node to be cached once");
+}
+
+- (void)testURLBuilder
+{
+    CMISURLBuilder *urlBuilder = [CMISURLBuilder builderWithUrlString:@"http://localhost/alfresco/cmis"];
+    [urlBuilder addParameter:@"filter" value:@"cmis:name,cmis:objectId"];
+    [urlBuilder addParameter:@"orderBy" value:nil];
+    [urlBuilder addParameter:@"includeAllowableActions" boolValue:YES];
+    [urlBuilder addParameter:@"maxItems" numberValue:@(10)];
+    NSString *expectedUrl = @"http://localhost/alfresco/cmis?filter=cmis%3Aname%2Ccmis%3AobjectId&includeAllowableActions=true&maxItems=10";
+    XCTAssertTrue([urlBuilder.urlString isEqualToString:expectedUrl], @"Expected %@ but it was %@", expectedUrl, urlBuilder.urlString);
+    
+    // the builder has to agree with appending the parameters one by one
+    NSString *appendedUrl = [CMISURLUtil urlStringByAppendingParameter:@"filter" value:@"cmis:name,cmis:objectId" urlString:@"http://localhost/alfresco/cmis"];
+    appendedUrl = [CMISURLUtil urlStringByAppendingParameter:@"includeAllowableActions" boolValue:YES urlString:appendedUrl];
+    appendedUrl = [CMISURLUtil urlStringByAppendingParameter:@"maxItems" numberValue:@(10) urlString:appendedUrl];
+    XCTAssertTrue([appendedUrl isEqualToString:expectedUrl], @"Expected %@ but it was %@", expectedUrl, appendedUrl);
+    
+    CMISURLBuilder *queryUrlBuilder = [CMISURLBuilder builderWithUrlString:@"http://localhost/alfresco/cmis?"];
+    [queryUrlBuilder addParameter:@"objectId" value:@"abc"];
+    [queryUrlBuilder addParameter:@"cmisselector" value:@"children"];
+    XCTAssertTrue([queryUrlBuilder.urlString isEqualToString:@"http://localhost/alfresco/cmis?objectId=abc&cmisselector=children"], @"Unexpected URL %@", queryUrlBuilder.urlString);
+    
+    XCTAssertNil([CMISURLBuilder builderWithUrlString:nil].urlString, @"Expected no URL without a base URL");
+}
+
+- (void)testQueryStatement
+{
+    CMISQueryStatement *statement = [[CMISQueryStatement alloc] initWithStatement:@"SELECT ? FROM ? WHERE cmis:name = 'what\\'s up?' AND cmis:createdBy IN (?) AND cmis:name LIKE ?"];
+    [statement setPropertyAtIndex:1 property:@"cmis:name"];
+    [statement setTypeAtIndex:2 type:@"cmis:document"];
+    [statement setStringArrayAtIndex:3 stringArray:@[@"bob", @"o'neil"]];
+    [statement setStringLikeAtIndex:4 string:@"report\\_%"];
+    NSString *expectedQuery = @"SELECT cmis:name FROM cmis:document WHERE cmis:name = 'what\\'s up?' AND cmis:createdBy IN ('bob', 'o\\'neil') AND cmis:name LIKE 'report\\_%'";
+    XCTAssertTrue([[statement queryString] isEqualToString:expectedQuery], @"Expected %@ but it was %@", expectedQuery, [statement queryString]);
+    
+    // the statement can be rendered again with other parameters
+    [statement clearParameters];
+    [statement setPropertyAtIndex:1 property:@"cmis:objectId"];
+    [statement setTypeAtIndex:2 type:@"cmis:folder"];
+    [statement setNumberAtIndex:3 number:@(42)];
+    [statement setStringContainsAtIndex:4 string:@"say \"hi\""];
+    expectedQuery = @"SELECT cmis:objectId FROM cmis:folder WHERE cmis:name = 'what\\'s up?' AND cmis:createdBy IN (42) AND cmis:name LIKE 'say \\\\\\\"hi\\\\\\\"'";
+    XCTAssertTrue([[statement queryString] isEqualToString:expectedQuery], @"Expected %@ but it was %@", expectedQuery, [statement queryString]);
+}
+
 @end
@@ -0,0 +1,299 @@
+/*******************************************************************************
+ * Copyright (C) 2005-2020 Alfresco Software Limited.
+ *
+ * This file is part of the Alfresco Mobile SDK.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ******************************************************************************/
+
+#import <XCTest/XCTest.h>
+#import "AlfrescoStubServer.h"
+#import "CMISBackgroundTransferManager.h"
+#import "CMISBindingSession.h"
+#import "CMISSessionParameters.h"
+#import "CMISHttpDownloadRequest.h"
+#import "CMISHttpUploadRequest.h"
+#import "CMISHttpResponse.h"
+#import "CMISBase64Encoder.h"
+#import "CMISErrors.h"
+
+// The transfer manager is driven by a default session configuration against the loopback stub server,
+// background configurations only deliver events to a host app and can't be used from a test bundle.
+
+@interface CMISBackgroundTransferManagerTest : XCTestCase
+@property (nonatomic, strong) AlfrescoStubServer *server;
+@property (nonatomic, strong) NSMutableArray *requestedPaths;
+@property (nonatomic, strong) AlfrescoStubRequest *lastUploadRequest;
+@property (atomic, strong) CMISHttpUploadRequest *uploadRequest;
+@property (atomic, strong) NSString *uploadedBodyFilePath;
+@property (nonatomic, strong) NSString *identifier;
+@property (nonatomic, strong) NSString *storePath;
+@property (nonatomic, strong) CMISBackgroundTransferManager *transferManager;
+@end
+
+@implementation CMISBackgroundTransferManagerTest
+
+- (void)setUp
+{
+    [super setUp];
+    
+    self.requestedPaths = [NSMutableArray array];
+    self.server = [[AlfrescoStubServer alloc] init];
+    self.server.latency = 0.1;
+    
+    __weak CMISBackgroundTransferManagerTest *weakSelf = self;
+    [self.server addRouteWithMethod:@"GET" pathPrefix:@"/content/" handler:^AlfrescoStubResponse *(AlfrescoStubRequest *request) {
+        @synchronized(weakSelf.requestedPaths)
+        {
+            [weakSelf.requestedPaths addObject:request.path];
+        }
+        NSData *body = [[request.path lastPathComponent] dataUsingEncoding:NSUTF8StringEncoding];
+        return [AlfrescoStubResponse responseWithStatusCode:200 contentType:@"text/plain" body:body];
+    }];
+    [self.server addRouteWithMethod:@"POST" pathPrefix:@"/upload" handler:^AlfrescoStubResponse *(AlfrescoStubRequest *request) {
+        weakSelf.lastUploadRequest = request;
+        weakSelf.uploadedBodyFilePath = weakSelf.uploadRequest.bodyFilePath;
+        return [AlfrescoStubResponse responseWithStatusCode:201 contentType:@"text/plain" body:[NSData data]];
+    }];
+    
+    NSError *error = nil;
+    XCTAssertTrue([self.server startAndReturnError:&error], @"Failed to start the stub server: %@", error);
+    
+    self.identifier = [NSString stringWithFormat:@"CMISBackgroundTransferManagerTest.%@", [[NSUUID UUID] UUIDString]];
+    self.storePath = [NSTemporaryDirectory() stringByAppendingPathComponent:[self.identifier stringByAppendingPathExtension:@"plist"]];
+    self.transferManager = [[CMISBackgroundTransferManager alloc] initWithIdentifier:self.identifier
+                                                                       configuration:[NSURLSessionConfiguration defaultSessionConfiguration]
+                                                                           storePath:self.storePath];
+    [CMISBackgroundTransferManager registerTransferManager:self.transferManager];
+}
+
+- (void)tearDown
+{
+    [self.transferManager invalidateAndCancel];
+    [self.server stop];
+    [[NSFileManager defaultManager] removeItemAtPath:self.storePath error:nil];
+    
+    [super tearDown];
+}
+
+- (void)testTransfersShareOneSessionWithBoundedConcurrency
+{
+    CMISBindingSession *bindingSession = [self bindingSessionWithMaxConcurrentTransfers:2];
+    NSUInteger transferCount = 6;
+    
+    NSMutableArray *requests = [NSMutableArray array];
+    NSMutableArray *outputFilePaths = [NSMutableArray array];
+    for (NSUInteger index = 0; index < transferCount; index++)
+    {
+        XCTestExpectation *expectation = [self expectationWithDescription:[NSString stringWithFormat:@"Transfer %lu", (unsigned long)index]];
+        NSString *outputFilePath = [self temporaryFilePath];
+        [outputFilePaths addObject:outputFilePath];
+        
+        CMISHttpDownloadRequest *request = [CMISHttpDownloadRequest startRequest:[self urlRequestForContent:[NSString stringWithFormat:@"file-%lu", (unsigned long)index]]
+                                                                      httpMethod:HTTP_GET
+                                                                  outputFilePath:outputFilePath
+                                                                   bytesExpected:0
+                                                                         session:bindingSession
+                                                                 completionBlock:^(CMISHttpResponse *httpResponse, NSError *error) {
+            XCTAssertNotNil(httpResponse, @"Expected a response but got error: %@", error);
+            [expectation fulfill];
+        } progressBlock:nil];
+        XCTAssertNotNil(request, @"Expected the request to be queued");
+        [requests addObject:request];
+    }
+    
+    XCTAssertTrue(self.transferManager.runningTransferCount == 2, @"Expected only 2 transfers to be running");
+    XCTAssertTrue(self.transferManager.queuedTransferCount == transferCount - 2, @"Expected the other transfers to be queued");
+    for (CMISHttpDownloadRequest *request in requests)
+    {
+        XCTAssertEqualObjects(request.urlSession, self.transferManager.urlSession, @"Expected all requests to use the same URL session");
+        XCTAssertNotNil(request.transferIdentifier, @"Expected the request to have a transfer identifier");
+    }
+    
+    [self waitForExpectationsWithTimeout:30 handler:nil];
+    
+    for (NSUInteger index = 0; index < transferCount; index++)
+    {
+        NSString *content = [NSString stringWithContentsOfFile:outputFilePaths[index] encoding:NSUTF8StringEncoding error:nil];
+        XCTAssertEqualObjects(content, ([NSString stringWithFormat:@"file-%lu", (unsigned long)index]), @"Expected the downloaded file to have the content");
+        [[NSFileManager defaultManager] removeItemAtPath:outputFilePaths[index] error:nil];
+    }
+    XCTAssertTrue(self.transferManager.transferIdentifiers.count == 0, @"Expected delivered transfers to be forgotten");
+}
+
+- (void)testQueuedTransfersStartInPriorityOrder
+{
+    CMISBindingSession *bindingSession = [self bindingSessionWithMaxConcurrentTransfers:1];
+    NSArray *names = @[@"first", @"low", @"high"];
+    NSArray *priorities = @[@0, @0, @10];
+    
+    for (NSUInteger index = 0; index < names.count; index++)
+    {
+        XCTestExpectation *expectation = [self expectationWithDescription:names[index]];
+        CMISHttpDownloadRequest *request = [[CMISHttpDownloadRequest alloc] initWithHttpMethod:HTTP_GET completionBlock:^(CMISHttpResponse *httpResponse, NSError *error) {
+            XCTAssertNotNil(httpResponse, @"Expected a response but got error: %@", error);
+            [expectation fulfill];
+        } progressBlock:nil];
+        request.session = bindingSession;
+        request.priority = [priorities[index] integerValue];
+        [request startRequest:[self urlRequestForContent:names[index]]];
+    }
+    
+    [self waitForExpectationsWithTimeout:30 handler:nil];
+    
+    NSArray *expectedPaths = @[@"/content/first", @"/content/high", @"/content/low"];
+    XCTAssertEqualObjects(self.requestedPaths, expectedPaths, @"Expected queued transfers to start by descending priority");
+}
+
+- (void)testCancellingQueuedTransfer
+{
+    CMISBindingSession *bindingSession = [self bindingSessionWithMaxConcurrentTransfers:1];
+    
+    XCTestExpectation *runningExpectation = [self expectationWithDescription:@"Running transfer"];
+    [CMISHttpDownloadRequest startRequest:[self urlRequestForContent:@"running"] httpMethod:HTTP_GET outputStream:nil bytesExpected:0 session:bindingSession completionBlock:^(CMISHttpResponse *httpResponse, NSError *error) {
+        XCTAssertNotNil(httpResponse, @"Expected a response but got error: %@", error);
+        [runningExpectation fulfill];
+    } progressBlock:nil];
+    
+    XCTestExpectation *queuedExpectation = [self expectationWithDescription:@"Queued transfer"];
+    CMISHttpDownloadRequest *queuedRequest = [CMISHttpDownloadRequest startRequest:[self urlRequestForContent:@"queued"] httpMethod:HTTP_GET outputStream:nil bytesExpected:0 session:bindingSession completionBlock:^(CMISHttpResponse *httpResponse, NSError *error) {
+        XCTAssertNil(httpResponse, @"Expected no response for a cancelled transfer");
+        XCTAssertTrue(error.code == kCMISErrorCodeCancelled, @"Expected the cancelled error code");
+        [queuedExpectation fulfill];
+    } progressBlock:nil];
+    XCTAssertTrue(self.transferManager.queuedTransferCount == 1, @"Expected the second transfer to be queued");
+    
+    [queuedRequest cancel];
+    XCTAssertTrue(self.transferManager.queuedTransferCount == 0, @"Expected the cancelled transfer to be removed from the queue");
+    
+    [self waitForExpectationsWithTimeout:30 handler:nil];
+    XCTAssertEqualObjects(self.requestedPaths, @[@"/content/running"], @"Expected the cancelled transfer never to be sent");
+}
+
+- (void)testTransferRecordsAreReattachedAfterRelaunch
+{
+    CMISBindingSession *bindingSession = [self bindingSessionWithMaxConcurrentTransfers:1];
+    self.server.latency = 1.0;
+    
+    XCTestExpectation *transferExpectation = [self expectationWithDescription:@"Transfer"];
+    NSString *outputFilePath = [self temporaryFilePath];
+    CMISHttpDownloadRequest *request = [CMISHttpDownloadRequest startRequest:[self urlRequestForContent:@"relaunch"] httpMethod:HTTP_GET outputFilePath:outputFilePath bytesExpected:0 session:bindingSession completionBlock:^(CMISHttpResponse *httpResponse, NSError *error) {
+        [transferExpectation fulfill];
+    } progressBlock:nil];
+    
+    NSDictionary *records = [NSDictionary dictionaryWithContentsOfFile:self.storePath];
+    XCTAssertNotNil(records[request.transferIdentifier], @"Expected the running transfer to be recorded");
+    
+    // a manager created from the same records has no task for the transfer, as if the process had been killed with the system discarding it
+    CMISBackgroundTransferManager *relaunchedManager = [[CMISBackgroundTransferManager alloc] initWithIdentifier:[self.identifier stringByAppendingString:@".relaunched"]
+                                                                                                  configuration:[NSURLSessionConfiguration defaultSessionConfiguration]
+                                                                                                      storePath:self.storePath];
+    XCTAssertTrue([relaunchedManager.transferIdentifiers containsObject:request.transferIdentifier], @"Expected the recorded transfer to be restored");
+    XCTAssertFalse([relaunchedManager reattachTransferWithIdentifier:@"unknown" completionBlock:nil progressBlock:nil], @"Expected unknown transfers not to be reattached");
+    
+    XCTestExpectation *reattachExpectation = [self expectationWithDescription:@"Reattached transfer"];
+    BOOL reattached = [relaunchedManager reattachTransferWithIdentifier:request.transferIdentifier completionBlock:^(CMISHttpResponse *httpResponse, NSError *error) {
+        XCTAssertNil(httpResponse, @"Expected no response for an interrupted transfer");
+        XCTAssertTrue(error.code == kCMISErrorCodeConnection, @"Expected the connection error code");
+        [reattachExpectation fulfill];
+    } progressBlock:nil];
+    XCTAssertTrue(reattached, @"Expected the recorded transfer to be reattached");
+    
+    [self waitForExpectationsWithTimeout:30 handler:nil];
+    
+    XCTAssertTrue(relaunchedManager.transferIdentifiers.count == 0, @"Expected the reattached transfer to be forgotten");
+    [relaunchedManager invalidateAndCancel];
+    [[NSFileManager defaultManager] removeItemAtPath:outputFilePath error:nil];
+}
+
+- (void)testUploadBodyIsWrittenToFile
+{
+    CMISBindingSession *bindingSession = [self bindingSessionWithMaxConcurrentTransfers:1];
+    
+    NSMutableData *content = [NSMutableData dataWithLength:1000];
+    for (NSUInteger index = 0; index < content.length; index++)
+    {
+        ((uint8_t *)content.mutableBytes)[index] = (uint8_t)index;
+    }
+    NSData *startData = [@"<start>" dataUsingEncoding:NSUTF8StringEncoding];
+    NSData *endData = [@"<end>" dataUsingEncoding:NSUTF8StringEncoding];
+    
+    NSMutableURLRequest *urlRequest = [NSMutableURLRequest requestWithURL:[self.server.baseURL URLByAppendingPathComponent:@"upload"]];
+    urlRequest.HTTPMethod = @"POST";
+    
+    XCTestExpectation *expectation = [self expectationWithDescription:@"Upload"];
+    self.uploadRequest = [CMISHttpUploadRequest startRequest:urlRequest
+                                                  httpMethod:HTTP_POST
+                                                 inputStream:[NSInputStream inputStreamWithData:content]
+                                                     headers:nil
+                                               bytesExpected:content.length
+                                                     session:bindingSession
+                                                   startData:startData
+                                                     endData:endData
+                                           useBase64Encoding:YES
+                                             completionBlock:^(CMISHttpResponse *httpResponse, NSError *error) {
+        XCTAssertNotNil(httpResponse, @"Expected a response but got error: %@", error);
+        [expectation fulfill];
+    } progressBlock:nil];
+    
+    XCTAssertNotNil(self.uploadRequest, @"Expected the upload to be started");
+    
+    [self waitForExpectationsWithTimeout:30 handler:nil];
+    
+    NSString *bodyFilePath = self.uploadedBodyFilePath;
+    XCTAssertNotNil(bodyFilePath, @"Expected the body to be written to a file for a background upload");
+    
+    NSMutableData *expectedBody = [NSMutableData dataWithData:startData];
+    [expectedBody appendData:[CMISBase64Encoder dataByEncodingText:content]];
+    [expectedBody appendData:endData];
+    XCTAssertTrue(self.lastUploadRequest.bodyLength == expectedBody.length, @"Expected the whole body to be uploaded");
+    XCTAssertEqualObjects(self.lastUploadRequest.body, expectedBody, @"Expected the start data, encoded content and end data to be uploaded");
+    XCTAssertFalse([[NSFileManager defaultManager] fileExistsAtPath:bodyFilePath], @"Expected the body file to be removed once uploaded");
+}
+
+- (void)testLaterSessionsKeepTheConcurrencyLimit
+{
+    CMISBindingSession *firstSession = [self bindingSessionWithMaxConcurrentTransfers:2];
+    XCTAssertEqual([CMISBackgroundTransferManager transferManagerForSession:firstSession], self.transferManager, @"Expected the registered manager");
+    XCTAssertTrue(self.transferManager.maxConcurrentTransfers == 2, @"Expected the first session to set the limit");
+    
+    CMISBindingSession *laterSession = [self bindingSessionWithMaxConcurrentTransfers:8];
+    [CMISBackgroundTransferManager transferManagerForSession:laterSession];
+    XCTAssertTrue(self.transferManager.maxConcurrentTransfers == 2, @"Expected a later session not to change the limit but it is %lu", (unsigned long)self.transferManager.maxConcurrentTransfers);
+}
+
+#pragma mark - Private methods
+
+- (CMISBindingSession *)bindingSessionWithMaxConcurrentTransfers:(NSUInteger)maxConcurrentTransfers
+{
+    CMISSessionParameters *parameters = [[CMISSessionParameters alloc] initWithBindingType:CMISBindingTypeAtomPub];
+    parameters.atomPubUrl = self.server.baseURL;
+    [parameters setObject:@(NO) forKey:kCMISSessionParameterCheckNetworkReachability];
+    [parameters setObject:@(YES) forKey:kCMISSessionParameterUseBackgroundNetworkSession];
+    [parameters setObject:self.identifier forKey:kCMISSessionParameterBackgroundNetworkSessionId];
+    [parameters setObject:@(maxConcurrentTransfers) forKey:kCMISSessionParameterBackgroundNetworkSessionMaxConcurrentTransfers];
+    return [[CMISBindingSession alloc] initWithSessionParameters:parameters];
+}
+
+- (NSMutableURLRequest *)urlRequestForContent:(NSString *)name
+{
+    NSURL *url = [[self.server.baseURL URLByAppendingPathComponent:@"content"] URLByAppendingPathComponent:name];
+    return [NSMutableURLRequest requestWithURL:url];
+}
+
+- (NSString *)temporaryFilePath
+{
+    return [NSTemporaryDirectory() stringByAppendingPathComponent:[[NSUUID UUID] UUIDString]];
+}
+
+@end
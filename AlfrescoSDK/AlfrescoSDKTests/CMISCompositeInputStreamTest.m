@@ -0,0 +1,306 @@
+/*******************************************************************************
+ * Copyright (C) 2005-2020 Alfresco Software Limited.
+ *
+ * This file is part of the Alfresco Mobile SDK.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ******************************************************************************/
+
+
+#import <XCTest/XCTest.h>
+#import "AlfrescoStubServer.h"
+#import "CMISCompositeInputStream.h"
+#import "CMISBroswerFormDataWriter.h"
+#import "CMISBrowserConstants.h"
+#import "CMISBindingSession.h"
+#import "CMISSessionParameters.h"
+#import "CMISHttpUploadRequest.h"
+#import "CMISHttpResponse.h"
+#import "CMISContentSource.h"
+#import "CMISRetryPolicy.h"
+#import "CMISErrors.h"
+
+@interface CMISCompositeInputStreamTest : XCTestCase
+@property (nonatomic, strong) NSData *prologue;
+@property (nonatomic, strong) NSData *content;
+@property (nonatomic, strong) NSData *epilogue;
+@end
+
+@implementation CMISCompositeInputStreamTest
+
+- (void)setUp
+{
+    [super setUp];
+    
+    self.prologue = [@"--boundary\r\nContent-Type: application/octet-stream\r\n\r\n" dataUsingEncoding:NSUTF8StringEncoding];
+    NSMutableData *content = [NSMutableData dataWithLength:100000];
+    for (NSUInteger index = 0; index < content.length; index++)
+    {
+        ((uint8_t *)content.mutableBytes)[index] = (uint8_t)(index % 251);
+    }
+    self.content = content;
+    self.epilogue = [@"\r\n--boundary--\r\n" dataUsingEncoding:NSUTF8StringEncoding];
+}
+
+- (void)testReadsAllPartsInOrder
+{
+    CMISCompositeInputStream *stream = [[CMISCompositeInputStream alloc] initWithPrologue:self.prologue
+                                                                            contentStream:[NSInputStream inputStreamWithData:self.content]
+                                                                            contentLength:self.content.length
+                                                                                 epilogue:self.epilogue];
+    XCTAssertTrue(stream.length == self.prologue.length + self.content.length + self.epilogue.length, @"Expected the length to be known up front");
+    
+    NSData *data = [self readStream:stream bufferSize:1000];
+    XCTAssertEqualObjects(data, [self expectedBody], @"Expected the prologue, content and epilogue");
+    XCTAssertTrue(stream.bytesRead == stream.length, @"Expected all bytes to be counted");
+    XCTAssertTrue(stream.streamStatus == NSStreamStatusAtEnd, @"Expected the stream to be at its end");
+}
+
+- (void)testUnknownContentLength
+{
+    CMISCompositeInputStream *stream = [[CMISCompositeInputStream alloc] initWithPrologue:self.prologue
+                                                                            contentStream:[NSInputStream inputStreamWithData:self.content]
+                                                                            contentLength:0
+                                                                                 epilogue:self.epilogue];
+    XCTAssertTrue(stream.length == 0, @"Expected the length to be unknown");
+    
+    NSData *data = [self readStream:stream bufferSize:777];
+    XCTAssertEqualObjects(data, [self expectedBody], @"Expected the content to be read until its end");
+    XCTAssertNil([stream reopenedStream], @"Expected a stream of unknown length not to be reopened");
+}
+
+- (void)testShortContentFails
+{
+    CMISCompositeInputStream *stream = [[CMISCompositeInputStream alloc] initWithPrologue:self.prologue
+                                                                            contentStream:[NSInputStream inputStreamWithData:self.content]
+                                                                            contentLength:self.content.length + 1
+                                                                                 epilogue:self.epilogue];
+    [stream open];
+    uint8_t buffer[4096];
+    NSInteger bytesRead;
+    do {
+        bytesRead = [stream read:buffer maxLength:sizeof(buffer)];
+    } while (bytesRead > 0);
+    
+    XCTAssertTrue(bytesRead == -1, @"Expected content shorter than announced to fail the stream");
+    XCTAssertNotNil(stream.streamError, @"Expected a stream error");
+}
+
+- (void)testReopenedStreamRewindsFileContent
+{
+    NSString *filePath = [NSTemporaryDirectory() stringByAppendingPathComponent:[[NSUUID UUID] UUIDString]];
+    [self.content writeToFile:filePath atomically:YES];
+    NSInputStream *contentStream = [NSInputStream inputStreamWithFileAtPath:filePath];
+    
+    CMISCompositeInputStream *stream = [[CMISCompositeInputStream alloc] initWithPrologue:self.prologue
+                                                                            contentStream:contentStream
+                                                                            contentLength:self.content.length
+                                                                                 epilogue:self.epilogue];
+    XCTAssertEqualObjects([self readStream:stream bufferSize:4096], [self expectedBody], @"Expected the whole body");
+    
+    CMISCompositeInputStream *reopenedStream = [stream reopenedStream];
+    XCTAssertNotNil(reopenedStream, @"Expected a file backed stream of known length to be reopened");
+    XCTAssertEqualObjects([self readStream:reopenedStream bufferSize:3000], [self expectedBody], @"Expected the whole body again");
+    
+    [contentStream close];
+    [[NSFileManager defaultManager] removeItemAtPath:filePath error:nil];
+}
+
+- (void)testMultipartUploadSendsContentLength
+{
+    AlfrescoStubServer *server = [[AlfrescoStubServer alloc] init];
+    __block AlfrescoStubRequest *uploadRequest = nil;
+    [server addRouteWithMethod:@"POST" pathPrefix:@"/upload" handler:^AlfrescoStubResponse *(AlfrescoStubRequest *request) {
+        uploadRequest = request;
+        return [AlfrescoStubResponse responseWithStatusCode:201 contentType:@"text/plain" body:[NSData data]];
+    }];
+    NSError *error = nil;
+    XCTAssertTrue([server startAndReturnError:&error], @"Failed to start the stub server: %@", error);
+    
+    CMISSessionParameters *parameters = [[CMISSessionParameters alloc] initWithBindingType:CMISBindingTypeBrowser];
+    parameters.browserUrl = server.baseURL;
+    [parameters setObject:@(NO) forKey:kCMISSessionParameterCheckNetworkReachability];
+    CMISBindingSession *bindingSession = [[CMISBindingSession alloc] initWithSessionParameters:parameters];
+    
+    NSInputStream *inputStream = [NSInputStream inputStreamWithData:self.content];
+    CMISBroswerFormDataWriter *formData = [[CMISBroswerFormDataWriter alloc] initWithAction:kCMISBrowserJSONActionCreateDocument contentStream:inputStream mediaType:@"application/octet-stream"];
+    [formData setFileName:@"content.bin"];
+    NSData *startData = formData.startData;
+    NSData *endData = formData.endData;
+    
+    NSMutableURLRequest *urlRequest = [NSMutableURLRequest requestWithURL:[server.baseURL URLByAppendingPathComponent:@"upload"]];
+    urlRequest.HTTPMethod = @"POST";
+    
+    __block unsigned long long lastBytesUploaded = 0;
+    __block unsigned long long lastBytesTotal = 0;
+    XCTestExpectation *expectation = [self expectationWithDescription:@"Upload"];
+    [CMISHttpUploadRequest startRequest:urlRequest
+                             httpMethod:HTTP_POST
+                            inputStream:inputStream
+                                headers:formData.headers
+                          bytesExpected:self.content.length
+                                session:bindingSession
+                              startData:startData
+                                endData:endData
+                      useBase64Encoding:NO
+                        completionBlock:^(CMISHttpResponse *httpResponse, NSError *error) {
+        XCTAssertNotNil(httpResponse, @"Expected a response but got error: %@", error);
+        [expectation fulfill];
+    } progressBlock:^(unsigned long long bytesUploaded, unsigned long long bytesTotal) {
+        lastBytesUploaded = bytesUploaded;
+        lastBytesTotal = bytesTotal;
+    }];
+    
+    [self waitForExpectationsWithTimeout:30 handler:nil];
+    [server stop];
+    
+    unsigned long long bodyLength = startData.length + self.content.length + endData.length;
+    XCTAssertEqualObjects(uploadRequest.headers[@"content-length"], ([NSString stringWithFormat:@"%llu", bodyLength]), @"Expected the exact body length to be sent");
+    XCTAssertNil(uploadRequest.headers[@"transfer-encoding"], @"Expected the body not to be sent chunked");
+    XCTAssertTrue(uploadRequest.bodyLength == bodyLength, @"Expected the whole body to be uploaded");
+    XCTAssertTrue(lastBytesTotal == bodyLength, @"Expected progress to be reported against the body length");
+    XCTAssertTrue(lastBytesUploaded <= lastBytesTotal, @"Expected progress not to run past the body length");
+}
+
+- (void)testContentSourceReadsMappedFile
+{
+    NSString *filePath = [NSTemporaryDirectory() stringByAppendingPathComponent:[[NSUUID UUID] UUIDString]];
+    [self.content writeToFile:filePath atomically:YES];
+    
+    NSError *error = nil;
+    CMISContentSource *contentSource = [CMISContentSource contentSourceWithFileAtPath:filePath error:&error];
+    XCTAssertNotNil(contentSource, @"Expected a content source but got error: %@", error);
+    XCTAssertTrue(contentSource.isRewindable, @"Expected file content to be rewindable");
+    XCTAssertTrue(contentSource.length == self.content.length, @"Expected the length of the file");
+    
+    CMISCompositeInputStream *stream = [[CMISCompositeInputStream alloc] initWithPrologue:self.prologue
+                                                                            contentSource:contentSource
+                                                                                 epilogue:self.epilogue];
+    XCTAssertEqualObjects([self readStream:stream bufferSize:1000], [self expectedBody], @"Expected the whole body");
+    
+    CMISCompositeInputStream *reopenedStream = [stream reopenedStream];
+    XCTAssertNotNil(reopenedStream, @"Expected a stream over a rewindable source to be reopened");
+    XCTAssertEqualObjects([self readStream:reopenedStream bufferSize:65536], [self expectedBody], @"Expected the whole body again");
+    
+    [[NSFileManager defaultManager] removeItemAtPath:filePath error:nil];
+}
+
+- (void)testContentSourceStreamsFileAboveMappingLimit
+{
+    NSString *filePath = [NSTemporaryDirectory() stringByAppendingPathComponent:[[NSUUID UUID] UUIDString]];
+    [self.content writeToFile:filePath atomically:YES];
+    
+    NSError *error = nil;
+    CMISContentSource *mappedSource = [CMISContentSource contentSourceWithFileAtPath:filePath mappingLimit:self.content.length error:&error];
+    XCTAssertEqualObjects(mappedSource.data, self.content, @"Expected a file within the limit to be mapped");
+    
+    CMISContentSource *streamedSource = [CMISContentSource contentSourceWithFileAtPath:filePath mappingLimit:self.content.length - 1 error:&error];
+    XCTAssertNotNil(streamedSource, @"Expected a content source but got error: %@", error);
+    XCTAssertNil(streamedSource.data, @"Expected a file above the limit not to be held in memory");
+    XCTAssertTrue(streamedSource.isRewindable, @"Expected file content to be rewindable");
+    XCTAssertTrue(streamedSource.length == self.content.length, @"Expected the length of the file");
+    
+    CMISCompositeInputStream *stream = [[CMISCompositeInputStream alloc] initWithPrologue:self.prologue
+                                                                            contentSource:streamedSource
+                                                                                 epilogue:self.epilogue];
+    XCTAssertEqualObjects([self readStream:stream bufferSize:1000], [self expectedBody], @"Expected the whole body");
+    
+    [[NSFileManager defaultManager] removeItemAtPath:filePath error:nil];
+}
+
+- (void)testContentSourceForMissingFileFails
+{
+    NSError *error = nil;
+    NSString *filePath = [NSTemporaryDirectory() stringByAppendingPathComponent:[[NSUUID UUID] UUIDString]];
+    XCTAssertNil([CMISContentSource contentSourceWithFileAtPath:filePath error:&error], @"Expected no content source for a missing file");
+    XCTAssertTrue(error.code == kCMISErrorCodeInvalidArgument, @"Expected an invalid argument error");
+}
+
+- (void)testMultipartUploadOfContentSourceIsRetried
+{
+    AlfrescoStubServer *server = [[AlfrescoStubServer alloc] init];
+    __block AlfrescoStubRequest *uploadRequest = nil;
+    [server addRouteWithMethod:@"POST" pathPrefix:@"/upload" handler:^AlfrescoStubResponse *(AlfrescoStubRequest *request) {
+        uploadRequest = request;
+        return [AlfrescoStubResponse responseWithStatusCode:201 contentType:@"text/plain" body:[NSData data]];
+    }];
+    server.failureStatusCode = 429;
+    server.failureCount = 1;
+    NSError *error = nil;
+    XCTAssertTrue([server startAndReturnError:&error], @"Failed to start the stub server: %@", error);
+    
+    CMISDefaultRetryPolicy *retryPolicy = [CMISDefaultRetryPolicy new];
+    retryPolicy.initialRetryDelay = 0.01;
+    CMISSessionParameters *parameters = [[CMISSessionParameters alloc] initWithBindingType:CMISBindingTypeBrowser];
+    parameters.browserUrl = server.baseURL;
+    [parameters setObject:@(NO) forKey:kCMISSessionParameterCheckNetworkReachability];
+    [parameters setObject:retryPolicy forKey:kCMISSessionParameterRetryPolicy];
+    CMISBindingSession *bindingSession = [[CMISBindingSession alloc] initWithSessionParameters:parameters];
+    
+    CMISContentSource *contentSource = [CMISContentSource contentSourceWithData:self.content];
+    CMISBroswerFormDataWriter *formData = [[CMISBroswerFormDataWriter alloc] initWithAction:kCMISBrowserJSONActionCreateDocument contentSource:contentSource mediaType:@"application/octet-stream"];
+    [formData setFileName:@"content.bin"];
+    NSData *startData = formData.startData;
+    NSData *endData = formData.endData;
+    
+    NSMutableURLRequest *urlRequest = [NSMutableURLRequest requestWithURL:[server.baseURL URLByAppendingPathComponent:@"upload"]];
+    urlRequest.HTTPMethod = @"POST";
+    
+    XCTestExpectation *expectation = [self expectationWithDescription:@"Upload"];
+    [CMISHttpUploadRequest startRequest:urlRequest
+                             httpMethod:HTTP_POST
+                          contentSource:contentSource
+                                headers:formData.headers
+                                session:bindingSession
+                              startData:startData
+                                endData:endData
+                      useBase64Encoding:NO
+                        completionBlock:^(CMISHttpResponse *httpResponse, NSError *error) {
+        XCTAssertNotNil(httpResponse, @"Expected the upload to succeed once retried but got error: %@", error);
+        [expectation fulfill];
+    } progressBlock:nil];
+    
+    [self waitForExpectationsWithTimeout:30 handler:nil];
+    [server stop];
+    
+    unsigned long long bodyLength = startData.length + self.content.length + endData.length;
+    XCTAssertTrue(server.requestCount == 2, @"Expected one retry but the server saw %lu requests", (unsigned long)server.requestCount);
+    XCTAssertTrue(uploadRequest.bodyLength == bodyLength, @"Expected the whole body to be sent again");
+}
+
+#pragma mark - Private methods
+
+- (NSData *)expectedBody
+{
+    NSMutableData *body = [NSMutableData dataWithData:self.prologue];
+    [body appendData:self.content];
+    [body appendData:self.epilogue];
+    return body;
+}
+
+- (NSData *)readStream:(NSInputStream *)stream bufferSize:(NSUInteger)bufferSize
+{
+    NSMutableData *data = [NSMutableData data];
+    uint8_t buffer[bufferSize];
+    
+    [stream open];
+    NSInteger bytesRead;
+    while ((bytesRead = [stream read:buffer maxLength:bufferSize]) > 0)
+    {
+        [data appendBytes:buffer length:bytesRead];
+    }
+    [stream close];
+    return data;
+}
+
+@end
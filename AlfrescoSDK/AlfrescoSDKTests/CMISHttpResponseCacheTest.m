@@ -0,0 +1,175 @@
+/*******************************************************************************
+ * Copyright (C) 2005-2020 Alfresco Software Limited.
+ *
+ * This file is part of the Alfresco Mobile SDK.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ******************************************************************************/
+
+
+#import <XCTest/XCTest.h>
+#import "AlfrescoStubServer.h"
+#import "CMISHttpResponseCache.h"
+#import "CMISRequestMetrics.h"
+#import "CMISBindingSession.h"
+#import "CMISSessionParameters.h"
+#import "CMISHttpRequest.h"
+#import "CMISHttpResponse.h"
+
+@interface CMISHttpResponseCacheTest : XCTestCase <CMISRequestMetricsObserver>
+@property (nonatomic, strong) AlfrescoStubServer *server;
+@property (nonatomic, strong) CMISHttpResponseCache *responseCache;
+@property (nonatomic, strong) CMISBindingSession *bindingSession;
+@property (nonatomic, strong) NSData *feed;
+@property (nonatomic, strong) CMISRequestMetrics *lastMetrics;
+@end
+
+@implementation CMISHttpResponseCacheTest
+
+- (void)setUp
+{
+    [super setUp];
+    
+    // AtomPub feeds are highly repetitive, which is what makes compressing them worthwhile
+    NSMutableString *feed = [NSMutableString stringWithString:@"<?xml version=\"1.0\" encoding=\"UTF-8\"?><feed xmlns=\"http://www.w3.org/2005/Atom\">"];
+    for (NSUInteger index = 0; index < 200; index++)
+    {
+        [feed appendFormat:@"<entry><id>urn:uuid:%lu</id><title>Document %lu</title><updated>2015-01-01T00:00:00Z</updated></entry>", (unsigned long)index, (unsigned long)index];
+    }
+    [feed appendString:@"</feed>"];
+    self.feed = [feed dataUsingEncoding:NSUTF8StringEncoding];
+    
+    __weak CMISHttpResponseCacheTest *weakSelf = self;
+    self.server = [[AlfrescoStubServer alloc] init];
+    self.server.supportsConditionalRequests = YES;
+    [self.server addRouteWithMethod:@"GET" pathPrefix:@"/feed" handler:^AlfrescoStubResponse *(AlfrescoStubRequest *request) {
+        return [AlfrescoStubResponse responseWithStatusCode:200 contentType:@"application/atom+xml;type=feed" body:weakSelf.feed];
+    }];
+    NSError *error = nil;
+    XCTAssertTrue([self.server startAndReturnError:&error], @"Failed to start the stub server: %@", error);
+    
+    self.responseCache = [CMISHttpResponseCache new];
+    
+    CMISSessionParameters *parameters = [[CMISSessionParameters alloc] initWithBindingType:CMISBindingTypeAtomPub];
+    parameters.atomPubUrl = self.server.baseURL;
+    parameters.username = @"user1";
+    [parameters setObject:@(NO) forKey:kCMISSessionParameterCheckNetworkReachability];
+    [parameters setObject:self.responseCache forKey:kCMISSessionParameterResponseCache];
+    [parameters setObject:self forKey:kCMISSessionParameterRequestMetricsObserver];
+    self.bindingSession = [[CMISBindingSession alloc] initWithSessionParameters:parameters];
+}
+
+- (void)tearDown
+{
+    [self.server stop];
+    [super tearDown];
+}
+
+- (void)testUnmodifiedResponseIsServedFromCache
+{
+    NSError *error = nil;
+    CMISHttpResponse *response = [self sendRequestForPath:@"feed" error:&error];
+    XCTAssertEqualObjects(response.data, self.feed, @"Expected the feed but got error: %@", error);
+    XCTAssertTrue(self.responseCache.storeCount == 1, @"Expected the response to be cached");
+    unsigned long long bytesSentForFirstRequest = self.server.bodyBytesSent;
+    
+    response = [self sendRequestForPath:@"feed" error:&error];
+    
+    XCTAssertEqualObjects(response.data, self.feed, @"Expected the cached feed but got error: %@", error);
+    XCTAssertTrue(response.statusCode == 200, @"Expected the cached response's status code");
+    XCTAssertTrue(self.server.notModifiedCount == 1, @"Expected the second request to be conditional");
+    XCTAssertTrue(self.server.bodyBytesSent == bytesSentForFirstRequest, @"Expected the body not to be sent again");
+    XCTAssertTrue(self.responseCache.notModifiedCount == 1, @"Expected the cache to count the revalidation");
+    XCTAssertTrue(self.lastMetrics.notModified, @"Expected the metrics to record the revalidation");
+}
+
+- (void)testCompressedResponseIsDecompressed
+{
+    self.server.compressesResponses = YES;
+    
+    NSError *error = nil;
+    CMISHttpResponse *response = [self sendRequestForPath:@"feed" error:&error];
+    
+    XCTAssertEqualObjects(response.data, self.feed, @"Expected the decompressed feed but got error: %@", error);
+    XCTAssertTrue(self.server.bodyBytesSent * 4 < self.feed.length, @"Expected the feed to be sent compressed but %llu of %lu bytes were sent",
+                  self.server.bodyBytesSent, (unsigned long)self.feed.length);
+}
+
+- (void)testResponsesAreKeptPerUser
+{
+    NSURL *url = [self.server.baseURL URLByAppendingPathComponent:@"feed"];
+    [self.responseCache storeResponse:[self responseForURL:url headers:@{@"ETag": @"\"1\""}] data:self.feed forRequest:[NSURLRequest requestWithURL:url] user:@"user1"];
+    
+    NSMutableURLRequest *otherUserRequest = [NSMutableURLRequest requestWithURL:url];
+    XCTAssertNil([self.responseCache prepareConditionalRequest:otherUserRequest user:@"user2"], @"Expected no response to be cached for another user");
+    XCTAssertNil([otherUserRequest valueForHTTPHeaderField:@"If-None-Match"], @"Expected the other user's request not to be conditional");
+    
+    NSMutableURLRequest *request = [NSMutableURLRequest requestWithURL:url];
+    XCTAssertNotNil([self.responseCache prepareConditionalRequest:request user:@"user1"], @"Expected the response to be cached for the user");
+    XCTAssertEqualObjects([request valueForHTTPHeaderField:@"If-None-Match"], @"\"1\"", @"Expected the request to be conditional");
+}
+
+- (void)testResponsesThatMustNotBeStoredAreNotCached
+{
+    NSURL *url = [self.server.baseURL URLByAppendingPathComponent:@"feed"];
+    NSURLRequest *request = [NSURLRequest requestWithURL:url];
+    [self.responseCache storeResponse:[self responseForURL:url headers:@{}] data:self.feed forRequest:request user:nil];
+    [self.responseCache storeResponse:[self responseForURL:url headers:@{@"ETag": @"\"1\"", @"Cache-Control": @"private, no-store"}] data:self.feed forRequest:request user:nil];
+    
+    self.responseCache.maxEntryLength = self.feed.length - 1;
+    [self.responseCache storeResponse:[self responseForURL:url headers:@{@"ETag": @"\"1\""}] data:self.feed forRequest:request user:nil];
+    
+    XCTAssertTrue(self.responseCache.storeCount == 0, @"Expected no response to be cached");
+}
+
+#pragma mark - CMISRequestMetricsObserver
+
+- (void)requestDidFinishWithMetrics:(CMISRequestMetrics *)metrics
+{
+    self.lastMetrics = metrics;
+}
+
+#pragma mark - Private methods
+
+- (NSHTTPURLResponse *)responseForURL:(NSURL *)url headers:(NSDictionary *)headers
+{
+    return [[NSHTTPURLResponse alloc] initWithURL:url statusCode:200 HTTPVersion:@"HTTP/1.1" headerFields:headers];
+}
+
+- (CMISHttpResponse *)sendRequestForPath:(NSString *)path error:(NSError **)outError
+{
+    NSMutableURLRequest *urlRequest = [NSMutableURLRequest requestWithURL:[self.server.baseURL URLByAppendingPathComponent:path]];
+    
+    __block CMISHttpResponse *response = nil;
+    __block NSError *error = nil;
+    XCTestExpectation *expectation = [self expectationWithDescription:@"Request"];
+    [CMISHttpRequest startRequest:urlRequest
+                       httpMethod:HTTP_GET
+                      requestBody:nil
+                          headers:nil
+                          session:self.bindingSession
+                  completionBlock:^(CMISHttpResponse *httpResponse, NSError *requestError) {
+        response = httpResponse;
+        error = requestError;
+        [expectation fulfill];
+    }];
+    [self waitForExpectationsWithTimeout:30 handler:nil];
+    
+    if (outError)
+    {
+        *outError = error;
+    }
+    return response;
+}
+
+@end
@@ -0,0 +1,127 @@
+/*******************************************************************************
+ * Copyright (C) 2005-2020 Alfresco Software Limited.
+ *
+ * This file is part of the Alfresco Mobile SDK.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ******************************************************************************/
+
+#import <XCTest/XCTest.h>
+#import "CMISParameterStore.h"
+
+static NSUInteger const kCMISParameterStoreTestThreadCount = 32;
+static NSUInteger const kCMISParameterStoreTestIterationCount = 2000;
+static NSUInteger const kCMISParameterStoreTestKeyCount = 64;
+
+@interface CMISParameterStoreTest : XCTestCase
+@end
+
+@implementation CMISParameterStoreTest
+
+- (void)testBasicOperations
+{
+    CMISParameterStore *store = [[CMISParameterStore alloc] initWithDictionary:@{@"a" : @1, @"b" : @2}];
+    XCTAssertEqualObjects([store objectForKey:@"a"], @1, @"Expected the initial entries to be stored");
+    XCTAssertEqualObjects(store[@"b"], @2, @"Expected subscripting to read entries");
+    XCTAssertNil([store objectForKey:@"c"], @"Expected no entry for an unknown key");
+    
+    store[@"c"] = @3;
+    [store addEntriesFromDictionary:@{@"a" : @10, @"d" : @4}];
+    [store removeObjectForKey:@"b"];
+    [store setObject:nil forKey:@"d"];
+    NSDictionary *expected = @{@"a" : @10, @"c" : @3};
+    XCTAssertEqualObjects([store dictionaryRepresentation], expected, @"Unexpected entries");
+    XCTAssertEqualObjects([NSSet setWithArray:[store allKeys]], [NSSet setWithArray:expected.allKeys], @"Unexpected keys");
+    
+    __block NSUInteger createCount = 0;
+    id (^createBlock)(void) = ^id{
+        createCount++;
+        return @"created";
+    };
+    XCTAssertEqualObjects([store objectForKey:@"e" createIfAbsentWithBlock:createBlock], @"created", @"Expected the object to be created");
+    XCTAssertEqualObjects([store objectForKey:@"e" createIfAbsentWithBlock:createBlock], @"created", @"Expected the stored object");
+    XCTAssertEqualObjects([store objectForKey:@"a" createIfAbsentWithBlock:createBlock], @10, @"Expected an existing entry not to be replaced");
+    XCTAssertEqual(createCount, 1, @"Expected the object to be created once");
+    XCTAssertNil([store objectForKey:@"f" createIfAbsentWithBlock:^id{ return nil; }], @"Expected nil if nothing was created");
+    XCTAssertNil([store objectForKey:@"f"], @"Expected nothing to be stored if nothing was created");
+}
+
+- (void)testConcurrentAccess
+{
+    CMISParameterStore *store = [[CMISParameterStore alloc] initWithDictionary:@{@"fixed" : @"value"}];
+    NSCountedSet *createdKeys = [NSCountedSet set];
+    NSMutableArray *failures = [NSMutableArray array];
+    dispatch_group_t group = dispatch_group_create();
+    
+    // dedicated threads rather than a dispatch queue, which would only run as many blocks at once as there are cores
+    for (NSUInteger thread = 0; thread < kCMISParameterStoreTestThreadCount; thread++)
+    {
+        dispatch_group_enter(group);
+        void (^threadBlock)(void) = ^{
+            // every thread mixes reads, writes of its own keys and lazy creation of keys shared by all threads
+            for (NSUInteger i = 0; i < kCMISParameterStoreTestIterationCount; i++)
+            {
+                NSString *sharedKey = [NSString stringWithFormat:@"shared-%lu", (unsigned long)((thread + i) % kCMISParameterStoreTestKeyCount)];
+                id created = [store objectForKey:sharedKey createIfAbsentWithBlock:^id{
+                    @synchronized(createdKeys)
+                    {
+                        [createdKeys addObject:sharedKey];
+                    }
+                    return [NSObject new];
+                }];
+                
+                NSString *ownKey = [NSString stringWithFormat:@"thread-%lu-%lu", (unsigned long)thread, (unsigned long)(i % 8)];
+                [store setObject:@(i) forKey:ownKey];
+                BOOL consistent = created == [store objectForKey:sharedKey] &&
+                                  [[store objectForKey:ownKey] isEqual:@(i)] &&
+                                  [[store objectForKey:@"fixed"] isEqual:@"value"];
+                if (i % 3 == 0)
+                {
+                    [store removeObjectForKey:ownKey];
+                    consistent = consistent && nil == [store objectForKey:ownKey];
+                }
+                if (i % 100 == 0)
+                {
+                    consistent = consistent && nil != [store dictionaryRepresentation][@"fixed"];
+                }
+                if (!consistent)
+                {
+                    @synchronized(failures)
+                    {
+                        [failures addObject:ownKey];
+                    }
+                }
+            }
+            dispatch_group_leave(group);
+        };
+        [NSThread detachNewThreadSelector:@selector(runBlock:) toTarget:self withObject:[threadBlock copy]];
+    }
+    
+    long timedOut = dispatch_group_wait(group, dispatch_time(DISPATCH_TIME_NOW, (int64_t)(60 * NSEC_PER_SEC)));
+    XCTAssertEqual(timedOut, 0, @"Expected all threads to finish");
+    XCTAssertEqual(failures.count, 0, @"Expected every thread to see its own writes and the shared objects, failed for %@", failures);
+    XCTAssertEqual(createdKeys.count, kCMISParameterStoreTestKeyCount, @"Expected every shared object to be created");
+    for (NSString *key in createdKeys)
+    {
+        XCTAssertEqual([createdKeys countForObject:key], 1, @"Expected %@ to be created once", key);
+    }
+}
+
+#pragma mark - Private methods
+
+- (void)runBlock:(void (^)(void))block
+{
+    block();
+}
+
+@end
@@ -0,0 +1,230 @@
+/*******************************************************************************
+ * Copyright (C) 2005-2020 Alfresco Software Limited.
+ *
+ * This file is part of the Alfresco Mobile SDK.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ******************************************************************************/
+
+
+#import <XCTest/XCTest.h>
+#import "AlfrescoStubServer.h"
+#import "AlfrescoRequest.h"
+#import "AlfrescoRequestGroup.h"
+#import "CMISRequest.h"
+#import "CMISHttpRequest.h"
+#import "CMISBindingSession.h"
+#import "CMISSessionParameters.h"
+#import "CMISDefaultNetworkProvider.h"
+#import "CMISErrors.h"
+#import "CMISSession.h"
+#import "CMISObject.h"
+#import "CMISObjectData.h"
+#import "CMISProperties.h"
+#import "CMISPropertyData.h"
+#import "CMISTypeDefinition.h"
+#import "CMISConstants.h"
+
+// answers type definition requests after a short delay with a request nothing but the caller can hold on to
+@interface CMISRequestTestCMISSession : CMISSession
+@property (nonatomic, weak) CMISRequest *lastTypeDefinitionRequest;
+@end
+
+@implementation CMISRequestTestCMISSession
+
+- (CMISRequest *)retrieveTypeDefinition:(NSString *)typeId completionBlock:(void (^)(CMISTypeDefinition *typeDefinition, NSError *error))completionBlock
+{
+    CMISRequest *request = [[CMISRequest alloc] init];
+    self.lastTypeDefinitionRequest = request;
+    __weak CMISRequest *weakRequest = request;
+    dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(0.2 * NSEC_PER_SEC)), dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
+        if (weakRequest.isCancelled)
+        {
+            completionBlock(nil, [CMISErrors createCMISErrorWithCode:kCMISErrorCodeCancelled detailedDescription:@"Request was cancelled"]);
+        }
+        else
+        {
+            completionBlock([[CMISTypeDefinition alloc] init], nil);
+        }
+    });
+    return request;
+}
+
+@end
+
+@interface CMISRequestTest : XCTestCase
+@end
+
+@implementation CMISRequestTest
+
+- (void)testCancellingCascadesToSubRequests
+{
+    CMISRequest *request = [[CMISRequest alloc] init];
+    CMISRequest *subRequest = [[CMISRequest alloc] init];
+    CMISRequest *nestedSubRequest = [[CMISRequest alloc] init];
+    [request addSubRequest:subRequest];
+    [subRequest addSubRequest:nestedSubRequest];
+    
+    [request cancel];
+    
+    XCTAssertTrue(subRequest.isCancelled, @"Expected the sub request to be cancelled");
+    XCTAssertTrue(nestedSubRequest.isCancelled, @"Expected the sub request of the sub request to be cancelled");
+}
+
+- (void)testSubRequestIsHeldUntilRemoved
+{
+    CMISRequest *request = [[CMISRequest alloc] init];
+    __weak CMISRequest *weakSubRequest = nil;
+    @autoreleasepool {
+        CMISRequest *subRequest = [[CMISRequest alloc] init];
+        weakSubRequest = subRequest;
+        [request addSubRequest:subRequest];
+    }
+    XCTAssertNotNil(weakSubRequest, @"Expected the request to hold a sub request nothing else retains");
+    
+    @autoreleasepool {
+        [request removeSubRequest:weakSubRequest];
+    }
+    XCTAssertNil(weakSubRequest, @"Expected the sub request to be released once removed");
+}
+
+- (void)testTypeDefinitionRequestIsCancelledWithTheObjectRequest
+{
+    CMISRequestTestCMISSession *session = [[CMISRequestTestCMISSession alloc] init];
+    CMISObjectData *objectData = [[CMISObjectData alloc] init];
+    objectData.identifier = @"workspace://SpacesStore/document";
+    objectData.properties = [[CMISProperties alloc] init];
+    [objectData.properties addProperty:[CMISPropertyData createPropertyForId:kCMISPropertyObjectTypeId idValue:kCMISPropertyObjectTypeIdValueDocument]];
+    
+    // the type definition request is only referenced by the request it was made for
+    CMISRequest *request = [[CMISRequest alloc] init];
+    CMISObject *object = [[CMISObject alloc] initWithObjectData:objectData session:session];
+    __block NSError *cancelledError = nil;
+    XCTestExpectation *cancelledExpectation = [self expectationWithDescription:@"Cancelled type definition request"];
+    [object fetchTypeDefinitionWithCMISRequest:request completionBlock:^(NSError *error) {
+        cancelledError = error;
+        [cancelledExpectation fulfill];
+    }];
+    XCTAssertNotNil(session.lastTypeDefinitionRequest, @"Expected the type definition request to be held while it is running");
+    [request cancel];
+    [self waitForExpectationsWithTimeout:10 handler:nil];
+    XCTAssertTrue(cancelledError.code == kCMISErrorCodeCancelled, @"Expected the type definition request to be cancelled but got error: %@", cancelledError);
+    
+    // a completed type definition request is let go of
+    request = [[CMISRequest alloc] init];
+    object = [[CMISObject alloc] initWithObjectData:objectData session:session];
+    XCTestExpectation *completedExpectation = [self expectationWithDescription:@"Completed type definition request"];
+    [object fetchTypeDefinitionWithCMISRequest:request completionBlock:^(NSError *error) {
+        XCTAssertNil(error, @"Expected the type definition to be retrieved");
+        [completedExpectation fulfill];
+    }];
+    [self waitForExpectationsWithTimeout:10 handler:nil];
+    NSDate *timeoutDate = [NSDate dateWithTimeIntervalSinceNow:2];
+    while (session.lastTypeDefinitionRequest && [timeoutDate timeIntervalSinceNow] > 0)
+    {
+        [[NSRunLoop currentRunLoop] runUntilDate:[NSDate dateWithTimeIntervalSinceNow:0.01]];
+    }
+    XCTAssertNil(session.lastTypeDefinitionRequest, @"Expected the completed type definition request to be removed");
+}
+
+- (void)testSubRequestAddedAfterCancellingIsCancelled
+{
+    CMISRequest *request = [[CMISRequest alloc] init];
+    [request cancel];
+    
+    CMISRequest *subRequest = [[CMISRequest alloc] init];
+    [request addSubRequest:subRequest];
+    
+    XCTAssertTrue(subRequest.isCancelled, @"Expected a sub request added to a cancelled request to be cancelled straight away");
+}
+
+- (void)testPriorityIsPassedOnToHttpAndSubRequests
+{
+    CMISRequest *request = [[CMISRequest alloc] init];
+    request.priority = CMISRequestPriorityPrefetch;
+    
+    CMISHttpRequest *httpRequest = [[CMISHttpRequest alloc] initWithHttpMethod:HTTP_GET completionBlock:nil];
+    request.httpRequest = httpRequest;
+    CMISRequest *subRequest = [[CMISRequest alloc] init];
+    [request addSubRequest:subRequest];
+    
+    XCTAssertTrue(httpRequest.priority == CMISRequestPriorityPrefetch, @"Expected the http request to take on the priority");
+    XCTAssertTrue(subRequest.priority == CMISRequestPriorityPrefetch, @"Expected the sub request to take on the priority");
+    
+    // e.g. the item being prefetched has scrolled on screen
+    request.priority = CMISRequestPriorityUserInteractive;
+    XCTAssertTrue(httpRequest.priority == CMISRequestPriorityUserInteractive, @"Expected the http request to be reprioritised");
+    XCTAssertTrue(subRequest.priority == CMISRequestPriorityUserInteractive, @"Expected the sub request to be reprioritised");
+}
+
+- (void)testAlfrescoRequestPriorityIsPassedOnToGroupedRequests
+{
+    AlfrescoRequest *request = [[AlfrescoRequest alloc] init];
+    AlfrescoRequestGroup *group = [[AlfrescoRequestGroup alloc] init];
+    request.httpRequest = group;
+    
+    AlfrescoRequest *groupedRequest = [[AlfrescoRequest alloc] init];
+    CMISRequest *cmisRequest = [[CMISRequest alloc] init];
+    groupedRequest.httpRequest = cmisRequest;
+    [group addRequest:groupedRequest];
+    
+    request.priority = AlfrescoRequestPriorityBackgroundSync;
+    
+    XCTAssertTrue(group.priority == AlfrescoRequestPriorityBackgroundSync, @"Expected the group to take on the priority");
+    XCTAssertTrue(groupedRequest.priority == AlfrescoRequestPriorityBackgroundSync, @"Expected the grouped request to take on the priority");
+    XCTAssertTrue(cmisRequest.priority == CMISRequestPriorityBackgroundSync, @"Expected the CMIS request to take on the priority");
+}
+
+- (void)testTaskPriorities
+{
+    XCTAssertEqual([CMISHttpRequest taskPriorityForPriority:CMISRequestPriorityDefault], NSURLSessionTaskPriorityDefault, @"Expected the default priority to map to the default task priority");
+    XCTAssertEqual([CMISHttpRequest taskPriorityForPriority:CMISRequestPriorityUserInteractive], NSURLSessionTaskPriorityHigh, @"Expected user interactive requests to be high priority tasks");
+    XCTAssertEqual([CMISHttpRequest taskPriorityForPriority:CMISRequestPriorityBackgroundSync], NSURLSessionTaskPriorityLow, @"Expected background sync requests to be low priority tasks");
+    XCTAssertTrue([CMISHttpRequest taskPriorityForPriority:100] <= 1.0f, @"Expected the task priority to be clamped");
+    XCTAssertTrue([CMISHttpRequest taskPriorityForPriority:-100] >= 0.0f, @"Expected the task priority to be clamped");
+}
+
+- (void)testCancelledRequestIsNotSent
+{
+    AlfrescoStubServer *server = [[AlfrescoStubServer alloc] init];
+    [server addRouteWithMethod:@"GET" pathPrefix:@"/" handler:^AlfrescoStubResponse *(AlfrescoStubRequest *request) {
+        return [AlfrescoStubResponse responseWithStatusCode:200 contentType:@"text/plain" body:[NSData data]];
+    }];
+    NSError *startError = nil;
+    XCTAssertTrue([server startAndReturnError:&startError], @"Failed to start the stub server: %@", startError);
+    
+    CMISSessionParameters *parameters = [[CMISSessionParameters alloc] initWithBindingType:CMISBindingTypeBrowser];
+    parameters.browserUrl = server.baseURL;
+    [parameters setObject:@(NO) forKey:kCMISSessionParameterCheckNetworkReachability];
+    CMISBindingSession *bindingSession = [[CMISBindingSession alloc] initWithSessionParameters:parameters];
+    
+    CMISRequest *request = [[CMISRequest alloc] init];
+    [request cancel];
+    
+    __block NSError *error = nil;
+    [[[CMISDefaultNetworkProvider alloc] init] invoke:[server.baseURL URLByAppendingPathComponent:@"test"]
+                                           httpMethod:HTTP_GET
+                                              session:bindingSession
+                                                 body:nil
+                                              headers:nil
+                                          cmisRequest:request
+                                      completionBlock:^(CMISHttpResponse *httpResponse, NSError *requestError) {
+        error = requestError;
+    }];
+    
+    XCTAssertTrue(error.code == kCMISErrorCodeCancelled, @"Expected the request to complete straight away as cancelled");
+    XCTAssertTrue(server.requestCount == 0, @"Expected no request to reach the server");
+    [server stop];
+}
+
+@end
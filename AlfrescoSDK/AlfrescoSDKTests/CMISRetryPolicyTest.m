@@ -0,0 +1,315 @@
+/*******************************************************************************
+ * Copyright (C) 2005-2020 Alfresco Software Limited.
+ *
+ * This file is part of the Alfresco Mobile SDK.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ******************************************************************************/
+
+#import <XCTest/XCTest.h>
+#import "AlfrescoStubServer.h"
+#import "CMISRetryPolicy.h"
+#import "CMISRequestMetrics.h"
+#import "CMISBindingSession.h"
+#import "CMISSessionParameters.h"
+#import "CMISHttpRequest.h"
+#import "CMISHttpResponse.h"
+#import "CMISErrors.h"
+
+@interface CMISRetryPolicyTest : XCTestCase <CMISRequestMetricsObserver>
+@property (nonatomic, strong) AlfrescoStubServer *server;
+@property (nonatomic, strong) CMISDefaultRetryPolicy *retryPolicy;
+@property (nonatomic, strong) CMISBindingSession *bindingSession;
+@property (nonatomic, strong) CMISRequestMetrics *lastMetrics;
+@end
+
+@implementation CMISRetryPolicyTest
+
+- (void)setUp
+{
+    [super setUp];
+    
+    self.server = [[AlfrescoStubServer alloc] init];
+    AlfrescoStubRouteHandler handler = ^AlfrescoStubResponse *(AlfrescoStubRequest *request) {
+        return [AlfrescoStubResponse responseWithStatusCode:[request.method isEqualToString:@"POST"] ? 201 : 200
+                                                contentType:@"text/plain"
+                                                       body:[@"ok" dataUsingEncoding:NSUTF8StringEncoding]];
+    };
+    [self.server addRouteWithMethod:@"GET" pathPrefix:@"/" handler:handler];
+    [self.server addRouteWithMethod:@"POST" pathPrefix:@"/" handler:handler];
+    NSError *error = nil;
+    XCTAssertTrue([self.server startAndReturnError:&error], @"Failed to start the stub server: %@", error);
+    
+    // keep the delays short, the backoff itself is covered by the policy's own tests
+    self.retryPolicy = [CMISDefaultRetryPolicy new];
+    self.retryPolicy.initialRetryDelay = 0.01;
+    
+    CMISSessionParameters *parameters = [[CMISSessionParameters alloc] initWithBindingType:CMISBindingTypeBrowser];
+    parameters.browserUrl = self.server.baseURL;
+    [parameters setObject:@(NO) forKey:kCMISSessionParameterCheckNetworkReachability];
+    [parameters setObject:self.retryPolicy forKey:kCMISSessionParameterRetryPolicy];
+    [parameters setObject:self forKey:kCMISSessionParameterRequestMetricsObserver];
+    self.bindingSession = [[CMISBindingSession alloc] initWithSessionParameters:parameters];
+}
+
+- (void)tearDown
+{
+    [self.server stop];
+    [super tearDown];
+}
+
+- (void)testRetryAfterHeaderValues
+{
+    XCTAssertEqual([CMISDefaultRetryPolicy retryAfterIntervalFromHeaderValue:@"120"], 120, @"Expected a number of seconds");
+    XCTAssertEqual([CMISDefaultRetryPolicy retryAfterIntervalFromHeaderValue:@"Thu, 01 Jan 2015 00:00:00 GMT"], 0, @"Expected a date in the past not to delay");
+    XCTAssertTrue([CMISDefaultRetryPolicy retryAfterIntervalFromHeaderValue:@"soon"] < 0, @"Expected an invalid value to be rejected");
+    
+    NSDateFormatter *formatter = [[NSDateFormatter alloc] init];
+    formatter.locale = [[NSLocale alloc] initWithLocaleIdentifier:@"en_US_POSIX"];
+    formatter.timeZone = [NSTimeZone timeZoneWithAbbreviation:@"GMT"];
+    formatter.dateFormat = @"EEE, dd MMM yyyy HH:mm:ss 'GMT'";
+    NSString *inTenSeconds = [formatter stringFromDate:[NSDate dateWithTimeIntervalSinceNow:10]];
+    NSTimeInterval interval = [CMISDefaultRetryPolicy retryAfterIntervalFromHeaderValue:inTenSeconds];
+    XCTAssertTrue(interval > 8 && interval <= 10, @"Expected an HTTP date to be converted to an interval but got %f", interval);
+}
+
+- (void)testBackoffIsBoundedAndJittered
+{
+    NSURLRequest *request = [NSURLRequest requestWithURL:[self.server.baseURL URLByAppendingPathComponent:@"test"]];
+    NSHTTPURLResponse *response = [[NSHTTPURLResponse alloc] initWithURL:request.URL statusCode:503 HTTPVersion:@"HTTP/1.1" headerFields:nil];
+    self.retryPolicy.initialRetryDelay = 1;
+    self.retryPolicy.maxRetryDelay = 3;
+    self.retryPolicy.maxRetryCount = 10;
+    self.retryPolicy.circuitBreakerFailureThreshold = 0;
+    
+    NSMutableSet *delays = [NSMutableSet set];
+    for (NSUInteger attempt = 1; attempt <= 8; attempt++)
+    {
+        NSTimeInterval delay = [self.retryPolicy retryDelayAfterAttempt:attempt ofRequest:request response:response error:nil rateLimited:NO];
+        XCTAssertTrue(delay >= 0 && delay <= MIN(3, pow(2, attempt - 1)), @"Expected attempt %lu to be delayed within its backoff but got %f", (unsigned long)attempt, delay);
+        [delays addObject:@(delay)];
+    }
+    XCTAssertTrue(delays.count > 1, @"Expected the delays to be randomised");
+}
+
+- (void)testGetIsRetriedUntilItSucceeds
+{
+    self.server.failureCount = 2;
+    
+    NSError *error = nil;
+    CMISHttpResponse *response = [self sendRequestWithMethod:HTTP_GET error:&error];
+    
+    XCTAssertNotNil(response, @"Expected the request to succeed once retried but got error: %@", error);
+    XCTAssertTrue(self.server.requestCount == 3, @"Expected two retries but the server saw %lu requests", (unsigned long)self.server.requestCount);
+    XCTAssertTrue(self.retryPolicy.retryCount == 2, @"Expected the policy to count two retries");
+    XCTAssertTrue(self.lastMetrics.retryCount == 2, @"Expected the metrics to record two retries");
+    XCTAssertTrue(self.lastMetrics.statusCode == 200, @"Expected the metrics to record the final status code");
+}
+
+- (void)testGetIsRetriedWhenTheConnectionIsLost
+{
+    self.server.failureStatusCode = 0;
+    self.server.failureCount = 1;
+    
+    NSError *error = nil;
+    CMISHttpResponse *response = [self sendRequestWithMethod:HTTP_GET error:&error];
+    
+    XCTAssertNotNil(response, @"Expected the request to succeed once retried but got error: %@", error);
+    XCTAssertTrue(self.server.requestCount == 2, @"Expected one retry");
+}
+
+- (void)testPostIsNotRetriedOnBadGateway
+{
+    self.server.failureStatusCode = 502;
+    self.server.failureCount = 1;
+    
+    NSError *error = nil;
+    CMISHttpResponse *response = [self sendRequestWithMethod:HTTP_POST error:&error];
+    
+    XCTAssertNil(response, @"Expected the request to fail");
+    XCTAssertNotNil(error, @"Expected an error");
+    XCTAssertTrue(self.server.requestCount == 1, @"Expected a request that isn't idempotent not to be sent again");
+    XCTAssertTrue(self.lastMetrics.retryCount == 0, @"Expected no retries to be recorded");
+}
+
+- (void)testPostIsRetriedWhenThrottled
+{
+    self.server.failureStatusCode = 429;
+    self.server.failureCount = 1;
+    
+    NSError *error = nil;
+    CMISHttpResponse *response = [self sendRequestWithMethod:HTTP_POST error:&error];
+    
+    XCTAssertNotNil(response, @"Expected a throttled request to be retried but got error: %@", error);
+    XCTAssertTrue(self.server.requestCount == 2, @"Expected one retry");
+}
+
+- (void)testRetryAfterIsHonoured
+{
+    self.server.failureCount = 1;
+    self.server.failureRetryAfter = 1;
+    
+    NSDate *startDate = [NSDate date];
+    NSError *error = nil;
+    CMISHttpResponse *response = [self sendRequestWithMethod:HTTP_GET error:&error];
+    NSTimeInterval elapsed = -[startDate timeIntervalSinceNow];
+    
+    XCTAssertNotNil(response, @"Expected the request to succeed once retried but got error: %@", error);
+    XCTAssertTrue(elapsed >= 1, @"Expected the retry to wait for the Retry-After interval but it took %f seconds", elapsed);
+    XCTAssertTrue(self.lastMetrics.retryWaitDuration >= 1, @"Expected the metrics to record the time waited");
+}
+
+- (void)testRetryAfterBeyondLimitIsNotWaitedFor
+{
+    self.retryPolicy.maxRetryAfter = 5;
+    self.server.failureCount = 1;
+    self.server.failureRetryAfter = 3600;
+    
+    NSError *error = nil;
+    CMISHttpResponse *response = [self sendRequestWithMethod:HTTP_GET error:&error];
+    
+    XCTAssertNil(response, @"Expected the request to fail straight away");
+    XCTAssertTrue(self.server.requestCount == 1, @"Expected no retry");
+}
+
+- (void)testCircuitOpensAfterConsecutiveFailures
+{
+    self.retryPolicy.maxRetryCount = 0;
+    self.retryPolicy.circuitBreakerFailureThreshold = 2;
+    self.retryPolicy.circuitBreakerOpenDuration = 0.5;
+    self.server.failureCount = 2;
+    
+    NSError *error = nil;
+    XCTAssertNil([self sendRequestWithMethod:HTTP_GET error:&error], @"Expected the first request to fail");
+    XCTAssertNil([self sendRequestWithMethod:HTTP_GET error:&error], @"Expected the second request to fail");
+    XCTAssertTrue([self.retryPolicy isCircuitOpenForHost:self.server.baseURL.host], @"Expected the circuit to open");
+    
+    XCTAssertNil([self sendRequestWithMethod:HTTP_GET error:&error], @"Expected a request to fail while the circuit is open");
+    XCTAssertTrue(error.code == kCMISErrorCodeConnection, @"Expected a connection error");
+    XCTAssertTrue(self.server.requestCount == 2, @"Expected no request to be sent while the circuit is open");
+    XCTAssertTrue(self.retryPolicy.circuitOpenCount == 1, @"Expected the short circuited request to be counted");
+    
+    // once the open duration has passed a trial request is let through and closes the circuit
+    [NSThread sleepForTimeInterval:0.6];
+    XCTAssertNotNil([self sendRequestWithMethod:HTTP_GET error:&error], @"Expected the trial request to succeed but got error: %@", error);
+    XCTAssertFalse([self.retryPolicy isCircuitOpenForHost:self.server.baseURL.host], @"Expected the circuit to close");
+}
+
+- (void)testApplicationErrorsDoNotOpenTheCircuit
+{
+    self.retryPolicy.maxRetryCount = 0;
+    self.retryPolicy.circuitBreakerFailureThreshold = 2;
+    self.server.failureStatusCode = 500;
+    self.server.failureCount = 3;
+    
+    NSError *error = nil;
+    for (NSUInteger index = 0; index < 3; index++)
+    {
+        XCTAssertNil([self sendRequestWithMethod:HTTP_GET error:&error], @"Expected request %lu to fail", (unsigned long)index);
+    }
+    XCTAssertTrue(self.server.requestCount == 3, @"Expected every request to be sent, a 500 is not retried");
+    XCTAssertFalse([self.retryPolicy isCircuitOpenForHost:self.server.baseURL.host], @"Expected internal server errors not to open the circuit");
+}
+
+- (void)testCancelledTrialRequestReleasesTheCircuit
+{
+    self.retryPolicy.maxRetryCount = 0;
+    self.retryPolicy.circuitBreakerFailureThreshold = 1;
+    self.retryPolicy.circuitBreakerOpenDuration = 0.3;
+    self.server.failureCount = 1;
+    
+    NSError *error = nil;
+    XCTAssertNil([self sendRequestWithMethod:HTTP_GET error:&error], @"Expected the first request to fail");
+    XCTAssertTrue([self.retryPolicy isCircuitOpenForHost:self.server.baseURL.host], @"Expected the circuit to open");
+    
+    // the trial request is cancelled while the server is still working on it
+    [NSThread sleepForTimeInterval:0.4];
+    self.server.latency = 2.0;
+    NSMutableURLRequest *urlRequest = [NSMutableURLRequest requestWithURL:[self.server.baseURL URLByAppendingPathComponent:@"test"]];
+    __block NSError *trialError = nil;
+    XCTestExpectation *expectation = [self expectationWithDescription:@"Cancelled trial request"];
+    CMISHttpRequest *trialRequest = [CMISHttpRequest startRequest:urlRequest
+                                                       httpMethod:HTTP_GET
+                                                      requestBody:nil
+                                                          headers:nil
+                                                          session:self.bindingSession
+                                                  completionBlock:^(CMISHttpResponse *httpResponse, NSError *requestError) {
+        trialError = requestError;
+        [expectation fulfill];
+    }];
+    XCTAssertNotNil(trialRequest, @"Expected the trial request to be sent");
+    dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(0.2 * NSEC_PER_SEC)), dispatch_get_main_queue(), ^{
+        [trialRequest cancel];
+    });
+    [self waitForExpectationsWithTimeout:30 handler:nil];
+    XCTAssertTrue(trialError.code == kCMISErrorCodeCancelled, @"Expected the trial request to be cancelled but got error: %@", trialError);
+    
+    // the next request becomes the trial and closes the circuit
+    self.server.latency = 0;
+    XCTAssertNotNil([self sendRequestWithMethod:HTTP_GET error:&error], @"Expected the next trial request to be sent and succeed but got error: %@", error);
+    XCTAssertFalse([self.retryPolicy isCircuitOpenForHost:self.server.baseURL.host], @"Expected the circuit to close");
+}
+
+- (void)testRetryBudgetLimitsRetries
+{
+    self.retryPolicy.retryBudgetCapacity = 1;
+    self.retryPolicy.retryBudgetRatio = 0;
+    self.retryPolicy.circuitBreakerFailureThreshold = 0;
+    self.server.failureCount = 10;
+    
+    NSError *error = nil;
+    XCTAssertNil([self sendRequestWithMethod:HTTP_GET error:&error], @"Expected the request to fail");
+    XCTAssertTrue(self.server.requestCount == 2, @"Expected a single retry before the budget ran out");
+    XCTAssertTrue(self.retryPolicy.budgetExhaustedCount == 1, @"Expected the denied retry to be counted");
+    
+    XCTAssertNil([self sendRequestWithMethod:HTTP_GET error:&error], @"Expected the request to fail");
+    XCTAssertTrue(self.server.requestCount == 3, @"Expected no retries once the budget ran out");
+}
+
+#pragma mark - CMISRequestMetricsObserver
+
+- (void)requestDidFinishWithMetrics:(CMISRequestMetrics *)metrics
+{
+    self.lastMetrics = metrics;
+}
+
+#pragma mark - Private methods
+
+- (CMISHttpResponse *)sendRequestWithMethod:(CMISHttpRequestMethod)method error:(NSError **)outError
+{
+    NSMutableURLRequest *urlRequest = [NSMutableURLRequest requestWithURL:[self.server.baseURL URLByAppendingPathComponent:@"test"]];
+    urlRequest.HTTPMethod = (method == HTTP_POST) ? @"POST" : @"GET";
+    
+    __block CMISHttpResponse *response = nil;
+    __block NSError *error = nil;
+    XCTestExpectation *expectation = [self expectationWithDescription:@"Request"];
+    [CMISHttpRequest startRequest:urlRequest
+                       httpMethod:method
+                      requestBody:(method == HTTP_POST) ? [@"body" dataUsingEncoding:NSUTF8StringEncoding] : nil
+                          headers:nil
+                          session:self.bindingSession
+                  completionBlock:^(CMISHttpResponse *httpResponse, NSError *requestError) {
+        response = httpResponse;
+        error = requestError;
+        [expectation fulfill];
+    }];
+    [self waitForExpectationsWithTimeout:30 handler:nil];
+    
+    if (outError)
+    {
+        *outError = error;
+    }
+    return response;
+}
+
+@end
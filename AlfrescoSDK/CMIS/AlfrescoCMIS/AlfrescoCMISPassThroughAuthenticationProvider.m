@@ -23,7 +23,6 @@
 
 @interface AlfrescoCMISPassThroughAuthenticationProvider ()
 @property (nonatomic, strong, readwrite) id<AlfrescoAuthenticationProvider> authProvider;
-@property (nonatomic, strong, readwrite) NSDictionary *httpHeadersToApply;
 @end
 
 @implementation AlfrescoCMISPassThroughAuthenticationProvider
@@ -34,11 +33,30 @@
     if (nil != self)
     {
         self.authProvider = authProvider;
-        self.httpHeadersToApply = [authProvider willApplyHTTPHeadersForSession:nil];
     }
     return self;
 }
 
+- (NSDictionary *)httpHeadersToApply
+{
+    // not cached as the headers change when the provider renews its credentials
+    return [self.authProvider willApplyHTTPHeadersForSession:nil];
+}
+
+- (void)renewCredentialsRejectedByResponse:(NSHTTPURLResponse *)response
+                            requestHeaders:(NSDictionary *)requestHeaders
+                           completionBlock:(void (^)(BOOL renewed))completionBlock
+{
+    if ([self.authProvider respondsToSelector:@selector(renewCredentialsRejectedWithHTTPHeaders:completionBlock:)])
+    {
+        [self.authProvider renewCredentialsRejectedWithHTTPHeaders:requestHeaders completionBlock:completionBlock];
+    }
+    else
+    {
+        completionBlock(NO);
+    }
+}
+
 
 - (void)updateWithHttpURLResponse:(NSHTTPURLResponse *)httpUrlResponse
 {
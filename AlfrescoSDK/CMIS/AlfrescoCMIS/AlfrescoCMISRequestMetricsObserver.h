@@ -0,0 +1,41 @@
+/*
+ ******************************************************************************
+ * Copyright (C) 2005-2020 Alfresco Software Limited.
+ *
+ * This file is part of the Alfresco Mobile SDK.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *****************************************************************************
+ */
+
+#import <Foundation/Foundation.h>
+#import "AlfrescoSession.h"
+#import "AlfrescoRequestMetrics.h"
+#import "CMISRequestMetrics.h"
+#import "CMISSessionParameters.h"
+
+/**
+ Passes the metrics of requests made by the CMIS library and AlfrescoDefaultHTTPRequest on to the AlfrescoRequestMetricsObserver
+ set for the session.
+ */
+@interface AlfrescoCMISRequestMetricsObserver : NSObject <CMISRequestMetricsObserver>
+@property (nonatomic, strong, readonly) id<AlfrescoRequestMetricsObserver> observer;
+
+- (id)initWithAlfrescoRequestMetricsObserver:(id<AlfrescoRequestMetricsObserver>)observer;
+
+/// Wraps the observer set with the kAlfrescoRequestMetricsObserver parameter, if any, so network requests made for the session report to it.
++ (void)setupObserverForSession:(id<AlfrescoSession>)session;
+
+/// Hands the session's observer to the CMIS library.
++ (void)setupCMISSessionParameters:(CMISSessionParameters *)parameters forSession:(id<AlfrescoSession>)session;
+@end
@@ -0,0 +1,72 @@
+/*
+ ******************************************************************************
+ * Copyright (C) 2005-2020 Alfresco Software Limited.
+ *
+ * This file is part of the Alfresco Mobile SDK.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *****************************************************************************
+ */
+
+#import "AlfrescoCMISRequestMetricsObserver.h"
+#import "AlfrescoInternalConstants.h"
+
+@interface AlfrescoCMISRequestMetricsObserver ()
+@property (nonatomic, strong, readwrite) id<AlfrescoRequestMetricsObserver> observer;
+@end
+
+@implementation AlfrescoCMISRequestMetricsObserver
+
++ (void)setupObserverForSession:(id<AlfrescoSession>)session
+{
+    id observer = [session objectForParameter:kAlfrescoRequestMetricsObserver];
+    if ([observer conformsToProtocol:@protocol(AlfrescoRequestMetricsObserver)])
+    {
+        AlfrescoCMISRequestMetricsObserver *cmisObserver = [[self alloc] initWithAlfrescoRequestMetricsObserver:observer];
+        [session setObject:cmisObserver forParameter:kAlfrescoRequestMetricsObserverObjectKey];
+    }
+}
+
++ (void)setupCMISSessionParameters:(CMISSessionParameters *)parameters forSession:(id<AlfrescoSession>)session
+{
+    id cmisObserver = [session objectForParameter:kAlfrescoRequestMetricsObserverObjectKey];
+    if (nil != cmisObserver)
+    {
+        [parameters setObject:cmisObserver forKey:kCMISSessionParameterRequestMetricsObserver];
+    }
+}
+
+- (id)initWithAlfrescoRequestMetricsObserver:(id<AlfrescoRequestMetricsObserver>)observer
+{
+    self = [super init];
+    if (nil != self)
+    {
+        self.observer = observer;
+    }
+    return self;
+}
+
+- (void)requestWillStartWithMetrics:(CMISRequestMetrics *)metrics
+{
+    if ([self.observer respondsToSelector:@selector(requestWillStartWithMetrics:)])
+    {
+        [self.observer requestWillStartWithMetrics:[[AlfrescoRequestMetrics alloc] initWithCMISRequestMetrics:metrics]];
+    }
+}
+
+- (void)requestDidFinishWithMetrics:(CMISRequestMetrics *)metrics
+{
+    [self.observer requestDidFinishWithMetrics:[[AlfrescoRequestMetrics alloc] initWithCMISRequestMetrics:metrics]];
+}
+
+@end
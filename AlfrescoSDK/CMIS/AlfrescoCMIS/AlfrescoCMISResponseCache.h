@@ -0,0 +1,42 @@
+/*
+ ******************************************************************************
+ * Copyright (C) 2005-2020 Alfresco Software Limited.
+ *
+ * This file is part of the Alfresco Mobile SDK.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *****************************************************************************
+ */
+
+#import <Foundation/Foundation.h>
+#import "AlfrescoSession.h"
+#import "CMISHttpResponseCache.h"
+#import "CMISSessionParameters.h"
+
+/**
+ Sets up the response cache shared by the CMIS library and AlfrescoDefaultHTTPRequest for a session, so read-mostly
+ resources such as the service document, type definitions and site lists are revalidated rather than downloaded again.
+ The cache set with the kAlfrescoResponseCache parameter is used if it is a CMISHttpResponseCache,
+ [NSNumber numberWithBool:NO] switches caching off, otherwise the session gets a cache of its own.
+ */
+@interface AlfrescoCMISResponseCache : NSObject
+
+/// Stores the response cache for the session.
++ (void)setupResponseCacheForSession:(id<AlfrescoSession>)session;
+
+/// Hands the session's response cache to the CMIS library.
++ (void)setupCMISSessionParameters:(CMISSessionParameters *)parameters forSession:(id<AlfrescoSession>)session;
+
+/// Returns the session's response cache, nil if responses are not cached.
++ (CMISHttpResponseCache *)responseCacheForSession:(id<AlfrescoSession>)session;
+@end
@@ -0,0 +1,60 @@
+/*
+ ******************************************************************************
+ * Copyright (C) 2005-2020 Alfresco Software Limited.
+ *
+ * This file is part of the Alfresco Mobile SDK.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *****************************************************************************
+ */
+
+#import "AlfrescoCMISResponseCache.h"
+#import "AlfrescoInternalConstants.h"
+
+@implementation AlfrescoCMISResponseCache
+
++ (void)setupResponseCacheForSession:(id<AlfrescoSession>)session
+{
+    if (nil != [session objectForParameter:kAlfrescoResponseCacheObjectKey])
+    {
+        return; // already set up, i.e. when the session is refreshed
+    }
+    
+    id parameter = [session objectForParameter:kAlfrescoResponseCache];
+    CMISHttpResponseCache *responseCache = [CMISHttpResponseCache responseCacheFromParameter:parameter];
+    if (nil == responseCache && !([parameter isKindOfClass:[NSNumber class]] && ![parameter boolValue]))
+    {
+        responseCache = [CMISHttpResponseCache new];
+    }
+    
+    if (nil != responseCache)
+    {
+        [session setObject:responseCache forParameter:kAlfrescoResponseCacheObjectKey];
+    }
+}
+
++ (void)setupCMISSessionParameters:(CMISSessionParameters *)parameters forSession:(id<AlfrescoSession>)session
+{
+    CMISHttpResponseCache *responseCache = [self responseCacheForSession:session];
+    if (nil != responseCache)
+    {
+        [parameters setObject:responseCache forKey:kCMISSessionParameterResponseCache];
+    }
+}
+
++ (CMISHttpResponseCache *)responseCacheForSession:(id<AlfrescoSession>)session
+{
+    return [CMISHttpResponseCache responseCacheFromParameter:[session objectForParameter:kAlfrescoResponseCacheObjectKey]];
+}
+
+@end
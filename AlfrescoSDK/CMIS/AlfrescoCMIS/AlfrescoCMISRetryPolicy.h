@@ -0,0 +1,41 @@
+/*
+ ******************************************************************************
+ * Copyright (C) 2005-2020 Alfresco Software Limited.
+ *
+ * This file is part of the Alfresco Mobile SDK.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *****************************************************************************
+ */
+
+#import <Foundation/Foundation.h>
+#import "AlfrescoSession.h"
+#import "CMISRetryPolicy.h"
+#import "CMISSessionParameters.h"
+
+/**
+ Sets up the retry policy shared by the CMIS library and AlfrescoDefaultHTTPRequest for a session. The policy set with the
+ kAlfrescoRetryPolicy parameter is used if it conforms to CMISRetryPolicy, [NSNumber numberWithBool:NO] switches retries off,
+ otherwise a CMISDefaultRetryPolicy is used.
+ */
+@interface AlfrescoCMISRetryPolicy : NSObject
+
+/// Stores the retry policy for the session so all of its network requests share one retry budget and circuit breaker.
++ (void)setupRetryPolicyForSession:(id<AlfrescoSession>)session;
+
+/// Hands the session's retry policy to the CMIS library.
++ (void)setupCMISSessionParameters:(CMISSessionParameters *)parameters forSession:(id<AlfrescoSession>)session;
+
+/// Returns the session's retry policy, nil if requests are not retried.
++ (id<CMISRetryPolicy>)retryPolicyForSession:(id<AlfrescoSession>)session;
+@end
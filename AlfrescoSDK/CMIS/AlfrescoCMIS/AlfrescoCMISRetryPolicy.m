@@ -0,0 +1,60 @@
+/*
+ ******************************************************************************
+ * Copyright (C) 2005-2020 Alfresco Software Limited.
+ *
+ * This file is part of the Alfresco Mobile SDK.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *****************************************************************************
+ */
+
+#import "AlfrescoCMISRetryPolicy.h"
+#import "AlfrescoInternalConstants.h"
+
+@implementation AlfrescoCMISRetryPolicy
+
++ (void)setupRetryPolicyForSession:(id<AlfrescoSession>)session
+{
+    if (nil != [session objectForParameter:kAlfrescoRetryPolicyObjectKey])
+    {
+        return; // already set up, i.e. when the session is refreshed
+    }
+    
+    id parameter = [session objectForParameter:kAlfrescoRetryPolicy];
+    id<CMISRetryPolicy> retryPolicy = [CMISDefaultRetryPolicy retryPolicyFromParameter:parameter];
+    if (nil == retryPolicy && !([parameter isKindOfClass:[NSNumber class]] && ![parameter boolValue]))
+    {
+        retryPolicy = [CMISDefaultRetryPolicy new];
+    }
+    
+    if (nil != retryPolicy)
+    {
+        [session setObject:retryPolicy forParameter:kAlfrescoRetryPolicyObjectKey];
+    }
+}
+
++ (void)setupCMISSessionParameters:(CMISSessionParameters *)parameters forSession:(id<AlfrescoSession>)session
+{
+    id<CMISRetryPolicy> retryPolicy = [self retryPolicyForSession:session];
+    if (nil != retryPolicy)
+    {
+        [parameters setObject:retryPolicy forKey:kCMISSessionParameterRetryPolicy];
+    }
+}
+
++ (id<CMISRetryPolicy>)retryPolicyForSession:(id<AlfrescoSession>)session
+{
+    return [CMISDefaultRetryPolicy retryPolicyFromParameter:[session objectForParameter:kAlfrescoRetryPolicyObjectKey]];
+}
+
+@end
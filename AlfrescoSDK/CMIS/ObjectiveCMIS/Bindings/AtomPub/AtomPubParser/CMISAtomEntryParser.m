@@ -21,20 +21,23 @@
 #import "CMISAtomLink.h"
 #import "CMISRenditionData.h"
 #import "CMISAtomPubParserUtil.h"
+#import "CMISChangeEventInfo.h"
+#import "CMISDateUtil.h"
 
 @interface CMISAtomEntryParser ()
 
 @property (nonatomic, strong, readwrite) CMISObjectData *objectData;
 
 @property (nonatomic, strong) NSData *atomData;
-@property (nonatomic, strong) NSString *currentPropertyType;
 @property (nonatomic, strong) CMISPropertyData *currentPropertyData;
 @property (nonatomic, strong) NSMutableArray *propertyValues;
 @property (nonatomic, strong) CMISProperties *currentObjectProperties;
 @property (nonatomic, strong) NSMutableSet *currentLinkRelations;
 @property (nonatomic, strong) CMISRenditionData *currentRendition;
 @property (nonatomic, strong) NSMutableArray *currentRenditions;
+@property (nonatomic, strong) CMISChangeEventInfo *currentChangeEventInfo;
 @property (nonatomic, strong) NSMutableString *string;
+@property (nonatomic, assign) BOOL capturingCharacters;
 @property (nonatomic, assign) BOOL isExcatAcl;
 @property (nonatomic, assign) BOOL parsingRelationship;
 
@@ -59,6 +62,8 @@
     if (self) {
         self.currentLinkRelations = [NSMutableSet set];
         self.parsingRelationship = NO;
+        // one buffer is reused for the text of every element that has a value
+        self.string = [NSMutableString string];
     }
     return self;
 }
@@ -124,189 +129,282 @@
 - (void)parser:(NSXMLParser *)parser didStartElement:(NSString *)elementName namespaceURI:(NSString *)namespaceURI
                                             qualifiedName:(NSString *)qName attributes:(NSDictionary *)attributeDict
 {
-    if ([namespaceURI isEqualToString:kCMISNamespaceCmis] && !self.parsingRelationship) {
-        if ([elementName isEqualToString:kCMISAtomEntryPropertyId] ||
-            [elementName isEqualToString:kCMISAtomEntryPropertyString] ||
-            [elementName isEqualToString:kCMISAtomEntryPropertyInteger] ||
-            [elementName isEqualToString:kCMISAtomEntryPropertyDateTime] ||
-            [elementName isEqualToString:kCMISAtomEntryPropertyBoolean] ||
-            [elementName isEqualToString:kCMISAtomEntryPropertyUri] ||
-            [elementName isEqualToString:kCMISAtomEntryPropertyHtml] ||
-            [elementName isEqualToString:kCMISAtomEntryPropertyDecimal]) {
+    CMISAtomPubElement element = [CMISAtomPubParserUtil elementForName:elementName];
+    switch ([CMISAtomPubParserUtil namespaceForUri:namespaceURI]) {
+        case CMISAtomPubNamespaceCmis:
+            if (!self.parsingRelationship) {
+                [self didStartCmisElement:element attributes:attributeDict parser:parser];
+            }
+            break;
+        case CMISAtomPubNamespaceCmisRestAtom:
+            if (element == CMISAtomPubElementObject) {
+                // Set object data as the current extensionData object
+                [self pushNewCurrentExtensionData:self.objectData];
+            }
+            break;
+        case CMISAtomPubNamespaceAtom:
+            if (element == CMISAtomPubElementLink) {
+                NSString *linkType = [attributeDict objectForKey:kCMISAtomEntryType];
+                NSString *rel = [attributeDict objectForKey:kCMISAtomEntryRel];
+                NSString *href = [attributeDict objectForKey:kCMISAtomEntryHref];
+                
+                CMISAtomLink *link = [[CMISAtomLink alloc] initWithRelation:rel type:linkType href:href];
+                [self.currentLinkRelations addObject:link];
+            } else if (element == CMISAtomPubElementContent) {
+                self.objectData.contentUrl = [NSURL URLWithString:[attributeDict objectForKey:kCMISAtomEntrySrc]];
+            }
+            break;
+        case CMISAtomPubNamespaceApp:
+            // Nothing to do in this namespace
+            break;
+        default:
+            if (self.currentExtensionData != nil) {
+                self.childParserDelegate = [CMISAtomPubExtensionElementParser extensionElementParserWithElementName:elementName namespaceUri:namespaceURI
+                                                                                                         attributes:attributeDict parentDelegate:self parser:parser];
+            }
+            break;
+    }
+    
+    // only the text of elements with a value is collected
+    [self.string setString:@""];
+    self.capturingCharacters = [self elementHasValue:element];
+}
+
+- (void)didStartCmisElement:(CMISAtomPubElement)element attributes:(NSDictionary *)attributeDict parser:(NSXMLParser *)parser
+{
+    switch (element) {
+        case CMISAtomPubElementPropertyBoolean:
+        case CMISAtomPubElementPropertyId:
+        case CMISAtomPubElementPropertyInteger:
+        case CMISAtomPubElementPropertyDateTime:
+        case CMISAtomPubElementPropertyDecimal:
+        case CMISAtomPubElementPropertyHtml:
+        case CMISAtomPubElementPropertyString:
+        case CMISAtomPubElementPropertyUri:
             self.propertyValues = [NSMutableArray array];
             // store attribute values in CMISPropertyData object
-            self.currentPropertyType = elementName;
             self.currentPropertyData = [[CMISPropertyData alloc] init];
             self.currentPropertyData.identifier = [attributeDict objectForKey:kCMISAtomEntryPropertyDefId];
             self.currentPropertyData.queryName = [attributeDict objectForKey:kCMISAtomEntryQueryName];
             self.currentPropertyData.displayName = [attributeDict objectForKey:kCMISAtomEntryDisplayName];
-            self.currentPropertyData.type = [CMISAtomPubParserUtil atomPubTypeToInternalType:self.currentPropertyType];
-        } else if ([elementName isEqualToString:kCMISCoreProperties]) {
+            self.currentPropertyData.type = (CMISPropertyType)(element - CMISAtomPubElementPropertyBoolean);
+            break;
+        case CMISAtomPubElementProperties:
             // create the CMISProperties object to hold all property data
             self.currentObjectProperties = [[CMISProperties alloc] init];
             
             // Set ObjectProperties as the current extensionData object
             [self pushNewCurrentExtensionData:self.currentObjectProperties];
-        } else if ([elementName isEqualToString:kCMISCoreRendition]) {
+            break;
+        case CMISAtomPubElementRendition:
             self.currentRendition = [[CMISRenditionData alloc] init];
-        } else if ([elementName isEqualToString:kCMISAtomEntryAllowableActions]) {
+            break;
+        case CMISAtomPubElementChangeEventInfo:
+            self.currentChangeEventInfo = [[CMISChangeEventInfo alloc] init];
+            break;
+        case CMISAtomPubElementAllowableActions:
             // Delegate parsing to child parser for allowableActions element
             self.childParserDelegate = [CMISAtomPubAllowableActionsParser allowableActionsParserWithParentDelegate:self parser:parser];
-        } else if ([elementName isEqualToString:kCMISAtomEntryAcl]) {
+            break;
+        case CMISAtomPubElementAcl:
             // Delegate parsing to child parser for acl element
             self.childParserDelegate = [CMISAtomPubAclParser aclParserWithParentDelegate:self parser:parser];
-        } else if ([elementName isEqualToString:kCMISCoreRelationship]) {
+            break;
+        case CMISAtomPubElementRelationship:
             // NOTE: we're currently ignoring the relationship element so set a flag to check
             self.parsingRelationship = YES;
-        }
-    } else if ([namespaceURI isEqualToString:kCMISNamespaceCmisRestAtom]) {
-        if ([elementName isEqualToString:kCMISAtomEntryObject]) {
-            // Set object data as the current extensionData object
-            [self pushNewCurrentExtensionData:self.objectData];
-        }
-    } else if ([namespaceURI isEqualToString:kCMISNamespaceAtom]) {
-        if ([elementName isEqualToString:kCMISAtomEntryLink]) {
-            NSString *linkType = [attributeDict objectForKey:kCMISAtomEntryType];
-            NSString *rel = [attributeDict objectForKey:kCMISAtomEntryRel];
-            NSString *href = [attributeDict objectForKey:kCMISAtomEntryHref]; 
-            
-            CMISAtomLink *link = [[CMISAtomLink alloc] initWithRelation:rel type:linkType href:href];
-            [self.currentLinkRelations addObject:link];
-        } else if ([elementName isEqualToString:kCMISAtomEntryContent]) {
-            self.objectData.contentUrl = [NSURL URLWithString:[attributeDict objectForKey:kCMISAtomEntrySrc]];
-        }
-    } else if ([namespaceURI isEqualToString:kCMISNamespaceApp]) {
-        // Nothing to do in this namespace
-    } else {
-        if (self.currentExtensionData != nil) {
-            self.childParserDelegate = [CMISAtomPubExtensionElementParser extensionElementParserWithElementName:elementName namespaceUri:namespaceURI 
-                                                                                                     attributes:attributeDict parentDelegate:self parser:parser];
-        }
+            break;
+        default:
+            break;
     }
-    
-    self.string = [NSMutableString string];
 }
 
 - (void)parser:(NSXMLParser *)parser foundCharacters:(NSString *)string
 {
-    [self.string appendString:string];
+    if (self.capturingCharacters) {
+        [self.string appendString:string];
+    }
 }
 
 
 - (void)parser:(NSXMLParser *)parser didEndElement:(NSString *)elementName namespaceURI:(NSString *)namespaceURI qualifiedName:(NSString *)qName 
 {
-   
-    if ([elementName isEqualToString:kCMISAtomEntryValue]) {
-        [CMISAtomPubParserUtil parsePropertyValue:self.string propertyType:self.currentPropertyType addToArray:self.propertyValues];
+    CMISAtomPubElement element = [CMISAtomPubParserUtil elementForName:elementName];
+    if (element == CMISAtomPubElementValue) {
+        [CMISAtomPubParserUtil parsePropertyValue:[self.string copy] type:self.currentPropertyData.type addToArray:self.propertyValues];
     } else if (self.currentRendition != nil) {
-        if ([elementName isEqualToString:kCMISCoreStreamId]) {
-            self.currentRendition.streamId = self.string;
-        } else if ([elementName isEqualToString:kCMISCoreMimetype]) {
-            self.currentRendition.mimeType = self.string;
-        } else if ([elementName isEqualToString:kCMISCoreLength]) {
-            self.currentRendition.length = [NSNumber numberWithInteger:[self.string integerValue]];
-        } else if ([elementName isEqualToString:kCMISCoreTitle]) {
-            self.currentRendition.title = self.string;
-        } else if ([elementName isEqualToString:kCMISCoreKind]) {
-            self.currentRendition.kind = self.string;
-        } else if ([elementName isEqualToString:kCMISCoreHeight]) {
-            self.currentRendition.height = [NSNumber numberWithInteger:[self.string integerValue]];
-        } else if ([elementName isEqualToString:kCMISCoreWidth]) {
-            self.currentRendition.width = [NSNumber numberWithInteger:[self.string integerValue]];
-        } else if ([elementName isEqualToString:kCMISCoreRenditionDocumentId]) {
-            self.currentRendition.renditionDocumentId = self.string;
+        switch (element) {
+            case CMISAtomPubElementStreamId:
+                self.currentRendition.streamId = [self.string copy];
+                break;
+            case CMISAtomPubElementMimetype:
+                self.currentRendition.mimeType = [self.string copy];
+                break;
+            case CMISAtomPubElementLength:
+                self.currentRendition.length = [NSNumber numberWithInteger:[self.string integerValue]];
+                break;
+            case CMISAtomPubElementTitle:
+                self.currentRendition.title = [self.string copy];
+                break;
+            case CMISAtomPubElementKind:
+                self.currentRendition.kind = [self.string copy];
+                break;
+            case CMISAtomPubElementHeight:
+                self.currentRendition.height = [NSNumber numberWithInteger:[self.string integerValue]];
+                break;
+            case CMISAtomPubElementWidth:
+                self.currentRendition.width = [NSNumber numberWithInteger:[self.string integerValue]];
+                break;
+            case CMISAtomPubElementRenditionDocumentId:
+                self.currentRendition.renditionDocumentId = [self.string copy];
+                break;
+            default:
+                break;
         }
     }
     
-    if ([namespaceURI isEqualToString:kCMISNamespaceCmis]) {
-        if (!self.parsingRelationship)
-        {
+    switch ([CMISAtomPubParserUtil namespaceForUri:namespaceURI]) {
+        case CMISAtomPubNamespaceCmis:
             // ignore the properties within the relationship element
-            if ([elementName isEqualToString:kCMISAtomEntryPropertyId] ||
-                [elementName isEqualToString:kCMISAtomEntryPropertyString] ||
-                [elementName isEqualToString:kCMISAtomEntryPropertyInteger] ||
-                [elementName isEqualToString:kCMISAtomEntryPropertyDateTime] ||
-                [elementName isEqualToString:kCMISAtomEntryPropertyBoolean] ||
-                [elementName isEqualToString:kCMISAtomEntryPropertyUri] ||
-                [elementName isEqualToString:kCMISAtomEntryPropertyHtml] ||
-                [elementName isEqualToString:kCMISAtomEntryPropertyDecimal]) {            
-                // add the property to the properties dictionary
-                self.currentPropertyData.values = self.propertyValues;
-                self.propertyValues = nil;
-                [self.currentObjectProperties addProperty:self.currentPropertyData];
-                self.currentPropertyData = nil;
-            } else if ([elementName isEqualToString:kCMISCoreProperties]) {
-                // Finished parsing Properties & its ExtensionData
-                [self saveCurrentExtensionsAndPushPreviousExtensionData];
-            } else if ([elementName isEqualToString:kCMISCoreRendition]) {
-                if (self.currentRenditions == nil) {
-                    self.currentRenditions = [[NSMutableArray alloc] init];
-                }
-                if (self.currentRendition != nil) {
-                    [self.currentRenditions addObject:self.currentRendition];
-                }
-                self.currentRendition = nil;
-        	} else if ([elementName isEqualToString:kCMISAtomEntryExactACL]) {
-            	self.isExcatAcl = [self.string isEqualToString:@"true"] ? YES : NO;
-            	if(self.objectData.acl){
-                	[self.objectData.acl setIsExact:self.isExcatAcl];
-            	}
-			}
-        }
-        
-        // the relationship element has ended
-        if ([elementName isEqualToString:kCMISCoreRelationship]) {
-            self.parsingRelationship = NO;
-        }
-        
-    } else if ([namespaceURI isEqualToString:kCMISNamespaceAtom]) {
-        if ( [elementName isEqualToString:kCMISAtomEntry]) {
-            // set the properties on the objectData object
-            self.objectData.properties = self.currentObjectProperties;
-
-            // set the link relations on the objectData object
-            self.objectData.linkRelations = [[CMISLinkRelations alloc] initWithLinkRelationSet:[self.currentLinkRelations copy]];
-
-            // set the renditions on the objectData object
-            self.objectData.renditions = self.currentRenditions;
-
-            // set the objectData identifier
-            CMISPropertyData *objectId = [self.currentObjectProperties.propertiesDictionary objectForKey:kCMISPropertyObjectId];
-            self.objectData.identifier = [objectId firstValue];
-
-            // set the objectData baseType
-            CMISPropertyData *baseTypeProperty = [self.currentObjectProperties.propertiesDictionary objectForKey:kCMISPropertyBaseTypeId];
-            NSString *baseType = [baseTypeProperty firstValue];
-            if ([baseType isEqualToString:kCMISPropertyObjectTypeIdValueDocument]) {
-                self.objectData.baseType = CMISBaseTypeDocument;
-            } else if ([baseType isEqualToString:kCMISPropertyObjectTypeIdValueFolder]) {
-                self.objectData.baseType = CMISBaseTypeFolder;
+            if (!self.parsingRelationship) {
+                [self didEndCmisElement:element];
+            }
+            
+            // the relationship element has ended
+            if (element == CMISAtomPubElementRelationship) {
+                self.parsingRelationship = NO;
+            }
+            break;
+        case CMISAtomPubNamespaceAtom:
+            if (element == CMISAtomPubElementEntry) {
+                [self didEndEntryWithParser:parser];
             }
+            break;
+        default:
+            // Nothing to do in the other namespaces
+            break;
+    }
 
-            // set the extensionData
+    self.capturingCharacters = NO;
+}
+
+- (void)didEndCmisElement:(CMISAtomPubElement)element
+{
+    switch (element) {
+        case CMISAtomPubElementPropertyBoolean:
+        case CMISAtomPubElementPropertyId:
+        case CMISAtomPubElementPropertyInteger:
+        case CMISAtomPubElementPropertyDateTime:
+        case CMISAtomPubElementPropertyDecimal:
+        case CMISAtomPubElementPropertyHtml:
+        case CMISAtomPubElementPropertyString:
+        case CMISAtomPubElementPropertyUri:
+            // add the property to the properties dictionary
+            self.currentPropertyData.values = self.propertyValues;
+            self.propertyValues = nil;
+            [self.currentObjectProperties addProperty:self.currentPropertyData];
+            self.currentPropertyData = nil;
+            break;
+        case CMISAtomPubElementProperties:
+            // Finished parsing Properties & its ExtensionData
             [self saveCurrentExtensionsAndPushPreviousExtensionData];
+            break;
+        case CMISAtomPubElementRendition:
+            if (self.currentRenditions == nil) {
+                self.currentRenditions = [[NSMutableArray alloc] init];
+            }
+            if (self.currentRendition != nil) {
+                [self.currentRenditions addObject:self.currentRendition];
+            }
+            self.currentRendition = nil;
+            break;
+        case CMISAtomPubElementChangeType:
+            if (self.currentChangeEventInfo != nil) {
+                self.currentChangeEventInfo.changeType = [CMISEnums enumForChangeType:self.string];
+            }
+            break;
+        case CMISAtomPubElementChangeTime:
+            if (self.currentChangeEventInfo != nil) {
+                self.currentChangeEventInfo.changeTime = [CMISDateUtil dateFromString:self.string];
+            }
+            break;
+        case CMISAtomPubElementChangeEventInfo:
+            self.objectData.changeEventInfo = self.currentChangeEventInfo;
+            self.currentChangeEventInfo = nil;
+            break;
+        case CMISAtomPubElementExactAcl:
+            self.isExcatAcl = [self.string isEqualToString:@"true"] ? YES : NO;
+            if (self.objectData.acl) {
+                [self.objectData.acl setIsExact:self.isExcatAcl];
+            }
+            break;
+        default:
+            break;
+    }
+}
 
-            self.currentObjectProperties = nil;
+- (void)didEndEntryWithParser:(NSXMLParser *)parser
+{
+    // set the properties on the objectData object
+    self.objectData.properties = self.currentObjectProperties;
+
+    // set the link relations on the objectData object
+    self.objectData.linkRelations = [[CMISLinkRelations alloc] initWithLinkRelationSet:[self.currentLinkRelations copy]];
+
+    // set the renditions on the objectData object
+    self.objectData.renditions = self.currentRenditions;
+
+    // set the objectData identifier
+    CMISPropertyData *objectId = [self.currentObjectProperties propertyForId:kCMISPropertyObjectId];
+    self.objectData.identifier = [objectId firstValue];
+
+    // set the objectData baseType
+    CMISPropertyData *baseTypeProperty = [self.currentObjectProperties propertyForId:kCMISPropertyBaseTypeId];
+    NSString *baseType = [baseTypeProperty firstValue];
+    if ([baseType isEqualToString:kCMISPropertyObjectTypeIdValueDocument]) {
+        self.objectData.baseType = CMISBaseTypeDocument;
+    } else if ([baseType isEqualToString:kCMISPropertyObjectTypeIdValueFolder]) {
+        self.objectData.baseType = CMISBaseTypeFolder;
+    }
 
-            if (self.parentDelegate) {
-                if ([self.parentDelegate respondsToSelector:@selector(cmisAtomEntryParser:didFinishParsingCMISObjectData:)]) {
-                    // Message the parent delegate the parsed ObjectData
-                    [self.parentDelegate performSelector:@selector(cmisAtomEntryParser:didFinishParsingCMISObjectData:)
-                                              withObject:self withObject:self.objectData];
-                }
+    // set the extensionData
+    [self saveCurrentExtensionsAndPushPreviousExtensionData];
 
-                // Resetting our parent as the delegate since we're done
-                parser.delegate = self.parentDelegate;
-                self.parentDelegate = nil;
-            }
+    self.currentObjectProperties = nil;
+
+    if (self.parentDelegate) {
+        if ([self.parentDelegate respondsToSelector:@selector(cmisAtomEntryParser:didFinishParsingCMISObjectData:)]) {
+            // Message the parent delegate the parsed ObjectData
+            [self.parentDelegate performSelector:@selector(cmisAtomEntryParser:didFinishParsingCMISObjectData:)
+                                      withObject:self withObject:self.objectData];
         }
-    } else if ([namespaceURI isEqualToString:kCMISNamespaceApp]) {
-        // Nothing to do in this namespace
-    } else {
-        // TODO other namespaces?
+
+        // Resetting our parent as the delegate since we're done
+        parser.delegate = self.parentDelegate;
+        self.parentDelegate = nil;
     }
+}
 
-    self.string = nil;
+- (BOOL)elementHasValue:(CMISAtomPubElement)element
+{
+    switch (element) {
+        case CMISAtomPubElementValue:
+        case CMISAtomPubElementExactAcl:
+        case CMISAtomPubElementChangeType:
+        case CMISAtomPubElementChangeTime:
+            return YES;
+        case CMISAtomPubElementStreamId:
+        case CMISAtomPubElementMimetype:
+        case CMISAtomPubElementLength:
+        case CMISAtomPubElementTitle:
+        case CMISAtomPubElementKind:
+        case CMISAtomPubElementHeight:
+        case CMISAtomPubElementWidth:
+        case CMISAtomPubElementRenditionDocumentId:
+            return self.currentRendition != nil;
+        default:
+            return NO;
+    }
 }
 
 #pragma mark -
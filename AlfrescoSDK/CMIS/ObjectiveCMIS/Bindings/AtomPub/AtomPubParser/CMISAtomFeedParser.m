@@ -19,6 +19,7 @@
 
 #import "CMISAtomFeedParser.h"
 #import "CMISAtomLink.h"
+#import "CMISAtomPubParserUtil.h"
 
 @interface CMISAtomFeedParser ()
 @property (nonatomic, strong, readwrite) NSData *feedData;
@@ -27,6 +28,7 @@
 @property (nonatomic, strong, readwrite) NSMutableSet *feedLinkRelations;
 @property (nonatomic, strong, readwrite) id childParserDelegate;
 @property (nonatomic, strong) NSMutableString *string;
+@property (nonatomic, assign) BOOL capturingCharacters;
 @end
 
 @implementation CMISAtomFeedParser
@@ -38,6 +40,7 @@
     if (self) {
         self.feedData = feedData;
         self.feedLinkRelations = [NSMutableSet set];
+        self.string = [NSMutableString string];
     }
     
     return self;
@@ -84,31 +87,36 @@
 
 - (void)parser:(NSXMLParser *)parser didStartElement:(NSString *)elementName namespaceURI:(NSString *)namespaceURI qualifiedName:(NSString *)qName attributes:(NSDictionary *)attributeDict 
 {
-    if ([elementName isEqualToString:kCMISAtomEntry]) {
+    CMISAtomPubElement element = [CMISAtomPubParserUtil elementForName:elementName];
+    if (element == CMISAtomPubElementEntry) {
         // Delegate parsing of AtomEntry element to the entry child parser
         self.childParserDelegate = [CMISAtomEntryParser atomEntryParserWithAtomEntryAttributes:attributeDict parentDelegate:self parser:parser];
-    } else if ([elementName isEqualToString:kCMISAtomEntryLink]) {
+    } else if (element == CMISAtomPubElementLink) {
         CMISAtomLink *link = [[CMISAtomLink alloc] init];
         [link setValuesForKeysWithDictionary:attributeDict];
         [self.feedLinkRelations addObject:link];
     }
     
-    self.string = [NSMutableString string];
+    // numItems is the only feed level element whose text is needed
+    [self.string setString:@""];
+    self.capturingCharacters = (element == CMISAtomPubElementNumItems);
 }
 
 - (void)parser:(NSXMLParser *)parser foundCharacters:(NSString *)string
 {
-    [self.string appendString:string];
+    if (self.capturingCharacters) {
+        [self.string appendString:string];
+    }
 }
 
 
 - (void)parser:(NSXMLParser *)parser didEndElement:(NSString *)elementName namespaceURI:(NSString *)namespaceURI qualifiedName:(NSString *)qName 
 {
-    if ([elementName isEqualToString:kCMISAtomFeedNumItems]) {
+    if (self.capturingCharacters && [CMISAtomPubParserUtil elementForName:elementName] == CMISAtomPubElementNumItems) {
         self.numItems = [self.string intValue];
     }
 
-    self.string = nil;
+    self.capturingCharacters = NO;
 }
 
 
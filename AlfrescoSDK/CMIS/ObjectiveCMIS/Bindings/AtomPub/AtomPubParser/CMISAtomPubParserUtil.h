@@ -23,8 +23,70 @@
 #import <Foundation/Foundation.h>
 #import "CMISEnums.h"
 
+/**
+ * The AtomPub elements the parsers act on, so they can switch on a token rather than comparing names one after the other
+ */
+typedef NS_ENUM(NSInteger, CMISAtomPubElement) {
+    CMISAtomPubElementUnknown = 0,
+    // property elements, in the same order as CMISPropertyType
+    CMISAtomPubElementPropertyBoolean,
+    CMISAtomPubElementPropertyId,
+    CMISAtomPubElementPropertyInteger,
+    CMISAtomPubElementPropertyDateTime,
+    CMISAtomPubElementPropertyDecimal,
+    CMISAtomPubElementPropertyHtml,
+    CMISAtomPubElementPropertyString,
+    CMISAtomPubElementPropertyUri,
+    CMISAtomPubElementValue,
+    CMISAtomPubElementProperties,
+    CMISAtomPubElementObject,
+    CMISAtomPubElementEntry,
+    CMISAtomPubElementLink,
+    CMISAtomPubElementContent,
+    CMISAtomPubElementNumItems,
+    CMISAtomPubElementAllowableActions,
+    CMISAtomPubElementAcl,
+    CMISAtomPubElementExactAcl,
+    CMISAtomPubElementRelationship,
+    CMISAtomPubElementRendition,
+    CMISAtomPubElementStreamId,
+    CMISAtomPubElementMimetype,
+    CMISAtomPubElementLength,
+    CMISAtomPubElementTitle,
+    CMISAtomPubElementKind,
+    CMISAtomPubElementHeight,
+    CMISAtomPubElementWidth,
+    CMISAtomPubElementRenditionDocumentId,
+    CMISAtomPubElementChangeEventInfo,
+    CMISAtomPubElementChangeType,
+    CMISAtomPubElementChangeTime
+};
+
+typedef NS_ENUM(NSInteger, CMISAtomPubNamespace) {
+    CMISAtomPubNamespaceUnknown = 0,
+    CMISAtomPubNamespaceCmis,
+    CMISAtomPubNamespaceCmisRestAtom,
+    CMISAtomPubNamespaceAtom,
+    CMISAtomPubNamespaceApp
+};
+
 @interface CMISAtomPubParserUtil : NSObject
 
+/**
+ * returns the token for an element name, CMISAtomPubElementUnknown for elements the parsers don't act on
+ */
++ (CMISAtomPubElement)elementForName:(NSString *)elementName;
+
+/**
+ * returns the token for a namespace uri
+ */
++ (CMISAtomPubNamespace)namespaceForUri:(NSString *)namespaceUri;
+
+/**
+ * returns YES for the propertyString, propertyId, ... elements
+ */
++ (BOOL)isPropertyElement:(CMISAtomPubElement)element;
+
 /**
  * converts an atomPubType to a CMISPropertyType object
  */
@@ -35,4 +97,9 @@
  */
 + (void)parsePropertyValue:(NSString *)stringValue propertyType:(NSString *)propertyType addToArray:(NSMutableArray*)array;
 
+/**
+ * parses the property value of the given internal type and adds it to an array
+ */
++ (void)parsePropertyValue:(NSString *)stringValue type:(CMISPropertyType)type addToArray:(NSMutableArray*)array;
+
 @end
\ No newline at end of file
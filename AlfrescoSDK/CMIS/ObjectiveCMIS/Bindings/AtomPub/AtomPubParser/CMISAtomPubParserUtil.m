@@ -27,24 +27,74 @@
 
 @implementation CMISAtomPubParserUtil
 
+static NSDictionary *elementsByName;
+static NSDictionary *namespacesByUri;
+
++ (void)initialize
+{
+    if (self == [CMISAtomPubParserUtil class]) {
+        elementsByName = @{kCMISAtomEntryPropertyBoolean: @(CMISAtomPubElementPropertyBoolean),
+                           kCMISAtomEntryPropertyId: @(CMISAtomPubElementPropertyId),
+                           kCMISAtomEntryPropertyInteger: @(CMISAtomPubElementPropertyInteger),
+                           kCMISAtomEntryPropertyDateTime: @(CMISAtomPubElementPropertyDateTime),
+                           kCMISAtomEntryPropertyDecimal: @(CMISAtomPubElementPropertyDecimal),
+                           kCMISAtomEntryPropertyHtml: @(CMISAtomPubElementPropertyHtml),
+                           kCMISAtomEntryPropertyString: @(CMISAtomPubElementPropertyString),
+                           kCMISAtomEntryPropertyUri: @(CMISAtomPubElementPropertyUri),
+                           kCMISAtomEntryValue: @(CMISAtomPubElementValue),
+                           kCMISCoreProperties: @(CMISAtomPubElementProperties),
+                           kCMISAtomEntryObject: @(CMISAtomPubElementObject),
+                           kCMISAtomEntry: @(CMISAtomPubElementEntry),
+                           kCMISAtomEntryLink: @(CMISAtomPubElementLink),
+                           kCMISAtomEntryContent: @(CMISAtomPubElementContent),
+                           kCMISAtomFeedNumItems: @(CMISAtomPubElementNumItems),
+                           kCMISAtomEntryAllowableActions: @(CMISAtomPubElementAllowableActions),
+                           kCMISAtomEntryAcl: @(CMISAtomPubElementAcl),
+                           kCMISAtomEntryExactACL: @(CMISAtomPubElementExactAcl),
+                           kCMISCoreRelationship: @(CMISAtomPubElementRelationship),
+                           kCMISCoreRendition: @(CMISAtomPubElementRendition),
+                           kCMISCoreStreamId: @(CMISAtomPubElementStreamId),
+                           kCMISCoreMimetype: @(CMISAtomPubElementMimetype),
+                           kCMISCoreLength: @(CMISAtomPubElementLength),
+                           kCMISCoreTitle: @(CMISAtomPubElementTitle),
+                           kCMISCoreKind: @(CMISAtomPubElementKind),
+                           kCMISCoreHeight: @(CMISAtomPubElementHeight),
+                           kCMISCoreWidth: @(CMISAtomPubElementWidth),
+                           kCMISCoreRenditionDocumentId: @(CMISAtomPubElementRenditionDocumentId),
+                           kCMISCoreChangeEventInfo: @(CMISAtomPubElementChangeEventInfo),
+                           kCMISCoreChangeType: @(CMISAtomPubElementChangeType),
+                           kCMISCoreChangeTime: @(CMISAtomPubElementChangeTime)};
+        
+        namespacesByUri = @{kCMISNamespaceCmis: @(CMISAtomPubNamespaceCmis),
+                            kCMISNamespaceCmisRestAtom: @(CMISAtomPubNamespaceCmisRestAtom),
+                            kCMISNamespaceAtom: @(CMISAtomPubNamespaceAtom),
+                            kCMISNamespaceApp: @(CMISAtomPubNamespaceApp)};
+    }
+}
+
++ (CMISAtomPubElement)elementForName:(NSString *)elementName
+{
+    return [[elementsByName objectForKey:elementName] integerValue];
+}
+
++ (CMISAtomPubNamespace)namespaceForUri:(NSString *)namespaceUri
+{
+    if (namespaceUri == nil) {
+        return CMISAtomPubNamespaceUnknown;
+    }
+    return [[namespacesByUri objectForKey:namespaceUri] integerValue];
+}
+
++ (BOOL)isPropertyElement:(CMISAtomPubElement)element
+{
+    return element >= CMISAtomPubElementPropertyBoolean && element <= CMISAtomPubElementPropertyUri;
+}
+
 + (CMISPropertyType)atomPubTypeToInternalType:(NSString *)atomPubType
 {
-    if([atomPubType isEqualToString:kCMISAtomEntryPropertyId]) {
-        return CMISPropertyTypeId;
-    } else if ([atomPubType isEqualToString:kCMISAtomEntryPropertyString]) {
-           return CMISPropertyTypeString;
-    } else if ([atomPubType isEqualToString:kCMISAtomEntryPropertyInteger]) {
-        return CMISPropertyTypeInteger;
-    } else if ([atomPubType isEqualToString:kCMISAtomEntryPropertyBoolean]) {
-        return CMISPropertyTypeBoolean;
-    } else if ([atomPubType isEqualToString:kCMISAtomEntryPropertyDateTime]) {
-        return CMISPropertyTypeDateTime;
-    } else if ([atomPubType isEqualToString:kCMISAtomEntryPropertyDecimal]) {
-        return CMISPropertyTypeDecimal;
-    } else if ([atomPubType isEqualToString:kCMISAtomEntryPropertyHtml]) {
-        return CMISPropertyTypeHtml;
-    } else if ([atomPubType isEqualToString:kCMISAtomEntryPropertyUri]) {
-        return CMISPropertyTypeUri;
+    CMISAtomPubElement element = [self elementForName:atomPubType];
+    if ([self isPropertyElement:element]) {
+        return (CMISPropertyType)(element - CMISAtomPubElementPropertyBoolean);
     } else {
         CMISLogDebug(@"Unknown property type %@. Go tell a developer to fix this.", atomPubType);
         return CMISPropertyTypeString;
@@ -53,24 +103,41 @@
 
 + (void)parsePropertyValue:(NSString *)stringValue propertyType:(NSString *)propertyType addToArray:(NSMutableArray*)array
 {
-    if ([propertyType isEqualToString:kCMISAtomEntryPropertyString] ||
-        [propertyType isEqualToString:kCMISAtomEntryPropertyId] ||
-        [propertyType isEqualToString:kCMISAtomEntryPropertyHtml]) {
-        [array addObject:stringValue];
-    } else if ([propertyType isEqualToString:kCMISAtomEntryPropertyInteger]) {
-        [array addObject:[NSNumber numberWithInt:[stringValue intValue]]];
-    } else if ([propertyType isEqualToString:kCMISAtomEntryPropertyBoolean]) {
-        [array addObject:[NSNumber numberWithBool:[stringValue isEqualToString:kCMISAtomEntryValueTrue]]];
-    } else if ([propertyType isEqualToString:kCMISAtomEntryPropertyDateTime]) {
-        [array addObject:[CMISDateUtil dateFromString:stringValue]];
-    } else if ([propertyType isEqualToString:kCMISAtomEntryPropertyDecimal]) {
-        [array addObject:[NSDecimalNumber decimalNumberWithString:stringValue]];
-    } else if ([propertyType isEqualToString:kCMISAtomEntryPropertyUri]) {
-        [array addObject:[NSURL URLWithString:stringValue]];
+    CMISAtomPubElement element = [self elementForName:propertyType];
+    if ([self isPropertyElement:element]) {
+        [self parsePropertyValue:stringValue type:(CMISPropertyType)(element - CMISAtomPubElementPropertyBoolean) addToArray:array];
     } else {
         CMISLogDebug(@"Unknown property type %@. Go tell a developer to fix this.", propertyType);
     }
 }
 
++ (void)parsePropertyValue:(NSString *)stringValue type:(CMISPropertyType)type addToArray:(NSMutableArray*)array
+{
+    switch (type) {
+        case CMISPropertyTypeString:
+        case CMISPropertyTypeId:
+        case CMISPropertyTypeHtml:
+            [array addObject:stringValue];
+            break;
+        case CMISPropertyTypeInteger:
+            [array addObject:[NSNumber numberWithInt:[stringValue intValue]]];
+            break;
+        case CMISPropertyTypeBoolean:
+            [array addObject:[NSNumber numberWithBool:[stringValue isEqualToString:kCMISAtomEntryValueTrue]]];
+            break;
+        case CMISPropertyTypeDateTime:
+            [array addObject:[CMISDateUtil dateFromString:stringValue]];
+            break;
+        case CMISPropertyTypeDecimal:
+            [array addObject:[NSDecimalNumber decimalNumberWithString:stringValue]];
+            break;
+        case CMISPropertyTypeUri:
+            [array addObject:[NSURL URLWithString:stringValue]];
+            break;
+        default:
+            CMISLogDebug(@"Unknown property type %ld. Go tell a developer to fix this.", (long)type);
+            break;
+    }
+}
 
 @end
\ No newline at end of file
@@ -110,6 +110,8 @@
             self.currentRepositoryInfo.rootFolderId = self.currentString;
         } else if ([elementName isEqualToString:kCMISCoreCmisVersionSupported]) {
             self.currentRepositoryInfo.cmisVersionSupported = self.currentString;
+        } else if ([elementName isEqualToString:kCMISCoreLatestChangeLogToken]) {
+            self.currentRepositoryInfo.latestChangeLogToken = self.currentString;
         } else if ([elementName hasPrefix:_kCMISCoreCapabilityPrefix] && self.currentCapabilities) {
             [self.currentCapabilities setCapability:elementName value:self.currentString];
         } else if ([elementName isEqualToString:kCMISCoreCapabilities]) {
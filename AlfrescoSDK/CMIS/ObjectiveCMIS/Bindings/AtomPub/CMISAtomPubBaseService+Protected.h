@@ -22,6 +22,8 @@
 #import "CMISAtomPubObjectByIdUriBuilder.h"
 
 @class CMISObjectData;
+@class CMISLinkCache;
+@class CMISContentSource;
 
 @interface CMISAtomPubBaseService (Protected)
 
@@ -78,6 +80,9 @@
                      completionBlock:(void (^)(CMISObjectData *objectData, NSError *error))completionBlock;
 
 
+///returns the link cache of the binding session, creating it on first use
+- (CMISLinkCache *)linkCache;
+
 ///load the link for a given object Id
 ///completionBlock returns the link as NSString or nil if unsuccessful
 - (void)loadLinkForObjectId:(NSString *)objectId
@@ -108,11 +113,25 @@
 - (void)sendAtomEntryXmlToLink:(NSString *)link
              httpRequestMethod:(CMISHttpRequestMethod)httpRequestMethod
                     properties:(CMISProperties *)properties
-            contentInputStream:(NSInputStream *)contentInputStream
+                 contentSource:(CMISContentSource *)contentSource
                contentMimeType:(NSString *)contentMimeType
-                 bytesExpected:(unsigned long long)bytesExpected
                    cmisRequest:(CMISRequest*)request
                completionBlock:(void (^)(CMISObjectData *objectData, NSError *error))completionBlock
                  progressBlock:(void (^)(unsigned long long bytesUploaded, unsigned long long))progressBlock;
 
+/**
+ Uploads the content of a content source between the start and end data, providers that don't support content
+ sources are passed its stream and length
+ */
+- (void)uploadContentSource:(CMISContentSource *)contentSource
+                      toUrl:(NSURL *)url
+                 httpMethod:(CMISHttpRequestMethod)httpRequestMethod
+                    headers:(NSDictionary *)headers
+                  startData:(NSData *)startData
+                    endData:(NSData *)endData
+          useBase64Encoding:(BOOL)useBase64Encoding
+                cmisRequest:(CMISRequest *)cmisRequest
+            completionBlock:(void (^)(CMISHttpResponse *httpResponse, NSError *error))completionBlock
+              progressBlock:(void (^)(unsigned long long bytesUploaded, unsigned long long bytesTotal))progressBlock;
+
 @end
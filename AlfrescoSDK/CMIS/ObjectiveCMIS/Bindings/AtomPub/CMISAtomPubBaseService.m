@@ -30,6 +30,7 @@
 #import "CMISLinkCache.h"
 #import "CMISLog.h"
 #import "CMISAtomEntryWriter.h"
+#import "CMISContentSource.h"
 
 @interface CMISAtomPubBaseService ()
 
@@ -106,6 +107,11 @@
                     
                     [self.bindingSession setObject:workspace.queryUriTemplate forKey:kCMISAtomBindingSessionKeyQueryUri];
                     
+                    NSString *changesUrl = [workspace.linkRelations linkHrefForRel:kCMISLinkRelationChanges];
+                    if (changesUrl) {
+                        [self.bindingSession setObject:changesUrl forKey:kCMISAtomBindingSessionKeyChangesUri];
+                    }
+                    
                     break;
                 }
             }
@@ -273,12 +279,10 @@
 
 - (CMISLinkCache *)linkCache
 {
-    CMISLinkCache *linkCache = [self.bindingSession objectForKey:kCMISAtomBindingSessionKeyLinkCache];
-    if (linkCache == nil) {
-        linkCache = [[CMISLinkCache alloc] initWithBindingSession:self.bindingSession];
-        [self.bindingSession setObject:linkCache forKey:kCMISAtomBindingSessionKeyLinkCache];
-    }
-    return linkCache;
+    CMISBindingSession *bindingSession = self.bindingSession;
+    return [bindingSession objectForKey:kCMISAtomBindingSessionKeyLinkCache createIfAbsentWithBlock:^id{
+        return [[CMISLinkCache alloc] initWithBindingSession:bindingSession];
+    }];
 }
 
 - (void)clearCacheFromService
@@ -320,7 +324,8 @@
                 CMISLogDebug(@"Could not retrieve object with id %@", objectId);
                 completionBlock(nil, [CMISErrors cmisError:error cmisErrorCode:kCMISErrorCodeObjectNotFound]);
             } else {
-                NSString *link = [linkCache linkForObjectId:objectId relation:rel type:type];
+                // Read the link from the fetched object rather than the cache, which may already have evicted it
+                NSString *link = [objectData.linkRelations linkHrefForRel:rel type:type];
                 if (link == nil) {
                     completionBlock(nil, [CMISErrors createCMISErrorWithCode:kCMISErrorCodeObjectNotFound
                                                          detailedDescription:[NSString stringWithFormat:@"Could not find link '%@' for object with id %@", rel, objectId]]);
@@ -392,9 +397,8 @@
 - (void)sendAtomEntryXmlToLink:(NSString *)link
              httpRequestMethod:(CMISHttpRequestMethod)httpRequestMethod
                     properties:(CMISProperties *)properties
-            contentInputStream:(NSInputStream *)contentInputStream
+                 contentSource:(CMISContentSource *)contentSource
                contentMimeType:(NSString *)contentMimeType
-                 bytesExpected:(unsigned long long)bytesExpected
                    cmisRequest:(CMISRequest*)request
                completionBlock:(void (^)(CMISObjectData *objectData, NSError *error))completionBlock
                  progressBlock:(void (^)(unsigned long long bytesUploaded, unsigned long long bytesTotal))progressBlock
@@ -425,44 +429,82 @@
     
     // The underlying CMISHttpUploadRequest object generates the atom entry. The base64 encoded content is generated on
     // the fly to support very large files.
-    [self.bindingSession.networkProvider invoke:[NSURL URLWithString:link]
-                                     httpMethod:httpRequestMethod
-                                        session:self.bindingSession
-                                    inputStream:contentInputStream
-                                        headers:[NSDictionary dictionaryWithObject:kCMISMediaTypeEntry forKey:@"Content-type"]
-                                  bytesExpected:bytesExpected
-                                    cmisRequest:request
-                                      startData:startData
-                                        endData:endData
-                              useBase64Encoding:YES
-                                completionBlock:^(CMISHttpResponse *response, NSError *error) {
-                                    if (error) {
-                                        CMISLogError(@"HTTP error when sending atom entry: %@", error);
-                                        if (completionBlock) {
-                                            completionBlock(nil, error);
-                                        }
-                                    } else if (response.statusCode == 200 || response.statusCode == 201 || response.statusCode == 204) {
-                                        if (completionBlock) {
-                                            NSError *parseError = nil;
-                                            CMISAtomEntryParser *atomEntryParser = [[CMISAtomEntryParser alloc] initWithData:response.data];
-                                            [atomEntryParser parseAndReturnError:&parseError];
-                                            if (parseError == nil) {
-                                                completionBlock(atomEntryParser.objectData, nil);
-                                            } else {
-                                                CMISLogError(@"Error while parsing response: %@", [parseError description]);
-                                                completionBlock(nil, [CMISErrors cmisError:parseError cmisErrorCode:kCMISErrorCodeRuntime]);
-                                            }
-                                        }
-                                    } else {
-                                        CMISLogError(@"Invalid http response status code when sending atom entry: %d", (int)response.statusCode);
-                                        CMISLogError(@"Error content: %@", [[NSString alloc] initWithData:response.data encoding:NSUTF8StringEncoding]);
-                                        if (completionBlock) {
-                                            completionBlock(nil, [CMISErrors createCMISErrorWithCode:kCMISErrorCodeRuntime
-                                                                                 detailedDescription:[NSString stringWithFormat:@"Failed to send atom entry: http status code %li", (long)response.statusCode]]);
-                                        }
-                                    }
-                                }
-                                  progressBlock:progressBlock];
+    [self uploadContentSource:contentSource
+                        toUrl:[NSURL URLWithString:link]
+                   httpMethod:httpRequestMethod
+                      headers:[NSDictionary dictionaryWithObject:kCMISMediaTypeEntry forKey:@"Content-type"]
+                    startData:startData
+                      endData:endData
+            useBase64Encoding:YES
+                  cmisRequest:request
+              completionBlock:^(CMISHttpResponse *response, NSError *error) {
+                  if (error) {
+                      CMISLogError(@"HTTP error when sending atom entry: %@", error);
+                      if (completionBlock) {
+                          completionBlock(nil, error);
+                      }
+                  } else if (response.statusCode == 200 || response.statusCode == 201 || response.statusCode == 204) {
+                      if (completionBlock) {
+                          NSError *parseError = nil;
+                          CMISAtomEntryParser *atomEntryParser = [[CMISAtomEntryParser alloc] initWithData:response.data];
+                          [atomEntryParser parseAndReturnError:&parseError];
+                          if (parseError == nil) {
+                              completionBlock(atomEntryParser.objectData, nil);
+                          } else {
+                              CMISLogError(@"Error while parsing response: %@", [parseError description]);
+                              completionBlock(nil, [CMISErrors cmisError:parseError cmisErrorCode:kCMISErrorCodeRuntime]);
+                          }
+                      }
+                  } else {
+                      CMISLogError(@"Invalid http response status code when sending atom entry: %d", (int)response.statusCode);
+                      CMISLogError(@"Error content: %@", [[NSString alloc] initWithData:response.data encoding:NSUTF8StringEncoding]);
+                      if (completionBlock) {
+                          completionBlock(nil, [CMISErrors createCMISErrorWithCode:kCMISErrorCodeRuntime
+                                                               detailedDescription:[NSString stringWithFormat:@"Failed to send atom entry: http status code %li", (long)response.statusCode]]);
+                      }
+                  }
+              }
+                progressBlock:progressBlock];
+}
+
+- (void)uploadContentSource:(CMISContentSource *)contentSource
+                      toUrl:(NSURL *)url
+                 httpMethod:(CMISHttpRequestMethod)httpRequestMethod
+                    headers:(NSDictionary *)headers
+                  startData:(NSData *)startData
+                    endData:(NSData *)endData
+          useBase64Encoding:(BOOL)useBase64Encoding
+                cmisRequest:(CMISRequest *)cmisRequest
+            completionBlock:(void (^)(CMISHttpResponse *httpResponse, NSError *error))completionBlock
+              progressBlock:(void (^)(unsigned long long bytesUploaded, unsigned long long bytesTotal))progressBlock
+{
+    id<CMISNetworkProvider> networkProvider = self.bindingSession.networkProvider;
+    if ([networkProvider respondsToSelector:@selector(invoke:httpMethod:session:contentSource:headers:cmisRequest:startData:endData:useBase64Encoding:completionBlock:progressBlock:)]) {
+        [networkProvider invoke:url
+                     httpMethod:httpRequestMethod
+                        session:self.bindingSession
+                  contentSource:contentSource
+                        headers:headers
+                    cmisRequest:cmisRequest
+                      startData:startData
+                        endData:endData
+              useBase64Encoding:useBase64Encoding
+                completionBlock:completionBlock
+                  progressBlock:progressBlock];
+    } else {
+        [networkProvider invoke:url
+                     httpMethod:httpRequestMethod
+                        session:self.bindingSession
+                    inputStream:[contentSource inputStream]
+                        headers:headers
+                  bytesExpected:contentSource.length
+                    cmisRequest:cmisRequest
+                      startData:startData
+                        endData:endData
+              useBase64Encoding:useBase64Encoding
+                completionBlock:completionBlock
+                  progressBlock:progressBlock];
+    }
 }
 
 @end
@@ -24,6 +24,8 @@
 #import "CMISAtomPubNavigationService.h"
 #import "CMISAtomPubVersioningService.h"
 #import "CMISAtomPubDiscoveryService.h"
+#import "CMISAtomPubConstants.h"
+#import "CMISLinkCache.h"
 
 @interface CMISAtomPubBinding ()
 
@@ -73,6 +75,10 @@
 
 - (void)close
 {
+    // keep the links for the next session before they are cleared, if persistence has been configured
+    CMISLinkCache *linkCache = [self.session objectForKey:kCMISAtomBindingSessionKeyLinkCache];
+    [linkCache persistLinks];
+    
     [self clearAllCaches];
 }
 
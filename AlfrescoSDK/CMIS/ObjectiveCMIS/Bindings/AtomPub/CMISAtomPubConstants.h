@@ -28,6 +28,7 @@ extern NSString * const kCMISAtomBindingSessionKeyQueryUri;
 extern NSString * const kCMISAtomBindingSessionKeyQueryCollection;
 extern NSString * const kCMISAtomBindingSessionKeyCheckedoutCollection;
 extern NSString * const kCMISAtomBindingSessionKeyLinkCache;
+extern NSString * const kCMISAtomBindingSessionKeyChangesUri;
 
 // Feed
 extern NSString * const kCMISAtomFeedNumItems;
@@ -83,6 +84,7 @@ extern NSString * const kCMISLinkVersionHistory;
 extern NSString * const kCMISLinkEditMedia;
 extern NSString * const kCMISLinkRelationNext;
 extern NSString * const kCMISLinkRelationWorkingCopy;
+extern NSString * const kCMISLinkRelationChanges;
 
 // Namespaces
 extern NSString * const kCMISNamespaceCmis;
@@ -126,7 +128,11 @@ extern NSString * const kCMISCoreSupportedPermissions;
 extern NSString * const kCMISCorePropagation;
 extern NSString * const kCMISCoreCmisVersionSupported;
 extern NSString * const kCMISCoreChangesIncomplete;
+extern NSString * const kCMISCoreLatestChangeLogToken;
 extern NSString * const kCMISCoreChangesOnType;
+extern NSString * const kCMISCoreChangeEventInfo;
+extern NSString * const kCMISCoreChangeType;
+extern NSString * const kCMISCoreChangeTime;
 extern NSString * const kCMISCorePrincipalAnonymous;
 extern NSString * const kCMISCorePrincipalAnyone;
 extern NSString * const kCMISCoreId;
@@ -28,6 +28,7 @@ NSString * const kCMISAtomBindingSessionKeyQueryUri = @"cmis_session_key_atom_qu
 NSString * const kCMISAtomBindingSessionKeyQueryCollection = @"cmis_session_key_atom_query_collection";
 NSString * const kCMISAtomBindingSessionKeyCheckedoutCollection = @"cmis_session_key_atom_checkedout_collection";
 NSString * const kCMISAtomBindingSessionKeyLinkCache = @"cmis_session_key_atom_link_cache";
+NSString * const kCMISAtomBindingSessionKeyChangesUri = @"cmis_session_key_atom_changes_uri";
 
 // Feed
 NSString * const kCMISAtomFeedNumItems = @"numItems";
@@ -83,6 +84,7 @@ NSString * const kCMISLinkVersionHistory = @"version-history";
 NSString * const kCMISLinkEditMedia = @"edit-media";
 NSString * const kCMISLinkRelationNext = @"next";
 NSString * const kCMISLinkRelationWorkingCopy = @"working-copy";
+NSString * const kCMISLinkRelationChanges = @"http://docs.oasis-open.org/ns/cmis/link/200908/changes";
 
 // Namespaces
 NSString * const kCMISNamespaceCmis = @"http://docs.oasis-open.org/ns/cmis/core/200908/";
@@ -126,7 +128,11 @@ NSString * const kCMISCoreSupportedPermissions = @"supportedPermissions";
 NSString * const kCMISCorePropagation = @"propagation";
 NSString * const kCMISCoreCmisVersionSupported = @"cmisVersionSupported";
 NSString * const kCMISCoreChangesIncomplete = @"changesIncomplete";
+NSString * const kCMISCoreLatestChangeLogToken = @"latestChangeLogToken";
 NSString * const kCMISCoreChangesOnType = @"changesOnType";
+NSString * const kCMISCoreChangeEventInfo = @"changeEventInfo";
+NSString * const kCMISCoreChangeType = @"changeType";
+NSString * const kCMISCoreChangeTime = @"changeTime";
 NSString * const kCMISCorePrincipalAnonymous = @"principalAnonymous";
 NSString * const kCMISCorePrincipalAnyone = @"principalAnyone";
 NSString * const kCMISCoreId = @"id";
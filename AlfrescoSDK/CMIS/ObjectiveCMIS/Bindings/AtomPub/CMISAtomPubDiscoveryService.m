@@ -18,6 +18,7 @@
  */
 
 #import "CMISAtomPubDiscoveryService.h"
+#import "CMISAtomPubBaseService+Protected.h"
 #import "CMISQueryAtomEntryWriter.h"
 #import "CMISHttpResponse.h"
 #import "CMISAtomPubConstants.h"
@@ -25,6 +26,17 @@
 #import "CMISObjectList.h"
 #import "CMISErrors.h"
 #import "CMISLog.h"
+#import "CMISLinkCache.h"
+#import "CMISURLUtil.h"
+#import "CMISURLBuilder.h"
+#import "CMISStringInOutParameter.h"
+#import "CMISAtomPubServiceDocumentParser.h"
+#import "CMISAtomWorkspace.h"
+
+@interface CMISAtomPubDiscoveryService ()
+/// the latest change log token read before the first page of a change log, keyed by the token of the page that follows
+@property (nonatomic, strong) NSMutableDictionary *latestChangeLogTokensByPageToken;
+@end
 
 @implementation CMISAtomPubDiscoveryService
 
@@ -75,6 +87,7 @@ includeAllowableActions:(BOOL)includeAllowableActions
                  CMISAtomFeedParser *feedParser = [[CMISAtomFeedParser alloc] initWithData:httpResponse.data];
                  NSError *error = nil;
                  if ([feedParser parseAndReturnError:&error]) {
+                     [[self linkCache] addLinksForObjects:feedParser.entries];
                      NSString *nextLink = [feedParser.linkRelations linkHrefForRel:kCMISLinkRelationNext];
                      
                      CMISObjectList *objectList = [[CMISObjectList alloc] init];
@@ -92,4 +105,160 @@ includeAllowableActions:(BOOL)includeAllowableActions
     return request;
 }
 
+- (CMISRequest*)retrieveContentChanges:(CMISStringInOutParameter *)changeLogToken
+                     includeProperties:(BOOL)includeProperties
+                                filter:(NSString *)filter
+                              maxItems:(NSNumber *)maxItems
+                       completionBlock:(void (^)(CMISObjectList *objectList, NSError *error))completionBlock
+{
+    CMISRequest *request = [[CMISRequest alloc] init];
+    [self retrieveFromCache:kCMISAtomBindingSessionKeyChangesUri cmisRequest:request completionBlock:^(id changesUrlString, NSError *error) {
+        if (changesUrlString == nil) {
+            CMISLogDebug(@"Unknown repository or change log not supported!");
+            completionBlock(nil, [CMISErrors createCMISErrorWithCode:kCMISErrorCodeNotSupported detailedDescription:@"The repository does not provide a change log"]);
+            return;
+        }
+        
+        // the latest token is read once before the first page and handed on to the pages that follow it,
+        // changes made while reading the log are read again next time rather than missed
+        NSString *latestChangeLogToken = [self takeLatestChangeLogTokenForPageToken:changeLogToken.inParameter];
+        if (latestChangeLogToken) {
+            [self retrieveContentChangesPage:changesUrlString
+                              changeLogToken:changeLogToken
+                        latestChangeLogToken:latestChangeLogToken
+                           includeProperties:includeProperties
+                                      filter:filter
+                                    maxItems:maxItems
+                                 cmisRequest:request
+                             completionBlock:completionBlock];
+        } else {
+            [self retrieveLatestChangeLogTokenWithCMISRequest:request completionBlock:^(NSString *latestChangeLogToken) {
+                [self retrieveContentChangesPage:changesUrlString
+                                  changeLogToken:changeLogToken
+                            latestChangeLogToken:latestChangeLogToken
+                               includeProperties:includeProperties
+                                          filter:filter
+                                        maxItems:maxItems
+                                     cmisRequest:request
+                                 completionBlock:completionBlock];
+            }];
+        }
+    }];
+    return request;
+}
+
+- (void)retrieveContentChangesPage:(NSString *)changesUrlString
+                    changeLogToken:(CMISStringInOutParameter *)changeLogToken
+              latestChangeLogToken:(NSString *)latestChangeLogToken
+                 includeProperties:(BOOL)includeProperties
+                            filter:(NSString *)filter
+                          maxItems:(NSNumber *)maxItems
+                       cmisRequest:(CMISRequest *)request
+                   completionBlock:(void (^)(CMISObjectList *objectList, NSError *error))completionBlock
+{
+    CMISURLBuilder *changesUrlBuilder = [CMISURLBuilder builderWithUrlString:changesUrlString];
+    [changesUrlBuilder addParameter:kCMISParameterChangeLogToken value:changeLogToken.inParameter];
+    [changesUrlBuilder addParameter:kCMISParameterIncludeProperties boolValue:includeProperties];
+    [changesUrlBuilder addParameter:kCMISParameterFilter value:filter];
+    [changesUrlBuilder addParameter:kCMISParameterMaxItems numberValue:maxItems];
+    NSString *changesUrl = changesUrlBuilder.urlString;
+    
+    [self.bindingSession.networkProvider invokeGET:[NSURL URLWithString:changesUrl]
+                                           session:self.bindingSession
+                                       cmisRequest:request
+                                   completionBlock:^(CMISHttpResponse *httpResponse, NSError *error) {
+        if (httpResponse) {
+            CMISAtomFeedParser *feedParser = [[CMISAtomFeedParser alloc] initWithData:httpResponse.data];
+            NSError *error = nil;
+            if ([feedParser parseAndReturnError:&error]) {
+                NSString *nextLink = [feedParser.linkRelations linkHrefForRel:kCMISLinkRelationNext];
+                
+                // the next page starts at the token of the next link, at the end of the log the next read starts at the latest change
+                NSString *nextChangeLogToken = [self changeLogTokenFromLink:nextLink];
+                if (nextLink == nil) {
+                    nextChangeLogToken = latestChangeLogToken;
+                } else if (nextChangeLogToken && latestChangeLogToken) {
+                    [self setLatestChangeLogToken:latestChangeLogToken forPageToken:nextChangeLogToken];
+                }
+                changeLogToken.outParameter = nextChangeLogToken ?: changeLogToken.inParameter;
+                
+                CMISObjectList *objectList = [[CMISObjectList alloc] init];
+                objectList.hasMoreItems = (nextLink != nil);
+                objectList.numItems = feedParser.numItems;
+                objectList.objects = feedParser.entries;
+                completionBlock(objectList, nil);
+            } else {
+                completionBlock(nil, [CMISErrors cmisError:error cmisErrorCode:kCMISErrorCodeRuntime]);
+            }
+        } else {
+            completionBlock(nil, [CMISErrors cmisError:error cmisErrorCode:kCMISErrorCodeConnection]);
+        }
+    }];
+}
+
+- (NSString *)takeLatestChangeLogTokenForPageToken:(NSString *)pageToken
+{
+    if (pageToken == nil) {
+        return nil;
+    }
+    
+    @synchronized(self) {
+        NSString *latestChangeLogToken = self.latestChangeLogTokensByPageToken[pageToken];
+        [self.latestChangeLogTokensByPageToken removeObjectForKey:pageToken];
+        return latestChangeLogToken;
+    }
+}
+
+- (void)setLatestChangeLogToken:(NSString *)latestChangeLogToken forPageToken:(NSString *)pageToken
+{
+    @synchronized(self) {
+        if (self.latestChangeLogTokensByPageToken == nil) {
+            self.latestChangeLogTokensByPageToken = [NSMutableDictionary dictionary];
+        }
+        self.latestChangeLogTokensByPageToken[pageToken] = latestChangeLogToken;
+    }
+}
+
+- (void)retrieveLatestChangeLogTokenWithCMISRequest:(CMISRequest *)request completionBlock:(void (^)(NSString *latestChangeLogToken))completionBlock
+{
+    // the cached service document is as old as the session, the latest token comes from a fresh copy
+    [self.bindingSession.networkProvider invokeGET:self.atomPubUrl
+                                           session:self.bindingSession
+                                       cmisRequest:request
+                                   completionBlock:^(CMISHttpResponse *httpResponse, NSError *error) {
+        NSString *latestChangeLogToken = nil;
+        if (httpResponse.data) {
+            CMISAtomPubServiceDocumentParser *parser = [[CMISAtomPubServiceDocumentParser alloc] initWithData:httpResponse.data];
+            if ([parser parseAndReturnError:&error]) {
+                for (CMISAtomWorkspace *workspace in parser.workspaces) {
+                    if ([workspace.repositoryInfo.identifier isEqualToString:self.bindingSession.repositoryId]) {
+                        latestChangeLogToken = workspace.repositoryInfo.latestChangeLogToken;
+                        break;
+                    }
+                }
+            }
+        }
+        
+        if (latestChangeLogToken == nil) {
+            CMISLogDebug(@"Could not read the latest change log token: %@", error);
+        }
+        completionBlock(latestChangeLogToken);
+    }];
+}
+
+- (NSString *)changeLogTokenFromLink:(NSString *)link
+{
+    if (link == nil) {
+        return nil;
+    }
+    
+    NSURLComponents *components = [NSURLComponents componentsWithString:link];
+    for (NSURLQueryItem *queryItem in components.queryItems) {
+        if ([queryItem.name isEqualToString:kCMISParameterChangeLogToken]) {
+            return queryItem.value;
+        }
+    }
+    return nil;
+}
+
 @end
\ No newline at end of file
@@ -23,8 +23,10 @@
 #import "CMISHttpResponse.h"
 #import "CMISErrors.h"
 #import "CMISURLUtil.h"
+#import "CMISURLBuilder.h"
 #import "CMISObjectList.h"
 #import "CMISLog.h"
+#import "CMISLinkCache.h"
 
 @implementation CMISAtomPubNavigationService
 
@@ -54,14 +56,16 @@
                           }
                           
                           // Add optional params (CMISUrlUtil will not append if the param name or value is nil)
-                          downLink = [CMISURLUtil urlStringByAppendingParameter:kCMISParameterFilter value:filter urlString:downLink];
-                          downLink = [CMISURLUtil urlStringByAppendingParameter:kCMISParameterOrderBy value:orderBy urlString:downLink];
-                          downLink = [CMISURLUtil urlStringByAppendingParameter:kCMISParameterIncludeAllowableActions value:(includeAllowableActions ? @"true" : @"false") urlString:downLink];
-                          downLink = [CMISURLUtil urlStringByAppendingParameter:kCMISParameterIncludeRelationships value:[CMISEnums stringForIncludeRelationShip:relationships] urlString:downLink];
-                          downLink = [CMISURLUtil urlStringByAppendingParameter:kCMISParameterRenditionFilter value:renditionFilter urlString:downLink];
-                          downLink = [CMISURLUtil urlStringByAppendingParameter:kCMISParameterIncludePathSegment value:(includePathSegment ? @"true" : @"false") urlString:downLink];
-                          downLink = [CMISURLUtil urlStringByAppendingParameter:kCMISParameterMaxItems value:[maxItems stringValue] urlString:downLink];
-                          downLink = [CMISURLUtil urlStringByAppendingParameter:kCMISParameterSkipCount value:[skipCount stringValue] urlString:downLink];
+                          CMISURLBuilder *downLinkBuilder = [CMISURLBuilder builderWithUrlString:downLink];
+                          [downLinkBuilder addParameter:kCMISParameterFilter value:filter];
+                          [downLinkBuilder addParameter:kCMISParameterOrderBy value:orderBy];
+                          [downLinkBuilder addParameter:kCMISParameterIncludeAllowableActions value:(includeAllowableActions ? @"true" : @"false")];
+                          [downLinkBuilder addParameter:kCMISParameterIncludeRelationships value:[CMISEnums stringForIncludeRelationShip:relationships]];
+                          [downLinkBuilder addParameter:kCMISParameterRenditionFilter value:renditionFilter];
+                          [downLinkBuilder addParameter:kCMISParameterIncludePathSegment value:(includePathSegment ? @"true" : @"false")];
+                          [downLinkBuilder addParameter:kCMISParameterMaxItems value:[maxItems stringValue]];
+                          [downLinkBuilder addParameter:kCMISParameterSkipCount value:[skipCount stringValue]];
+                          downLink = downLinkBuilder.urlString;
                           
                           // execute the request
                           [self.bindingSession.networkProvider invokeGET:[NSURL URLWithString:downLink]
@@ -80,6 +84,7 @@
                                       CMISAtomFeedParser *parser = [[CMISAtomFeedParser alloc] initWithData:httpResponse.data];
                                       NSError *internalError = nil;
                                       if ([parser parseAndReturnError:&internalError]) {
+                                          [[self linkCache] addLinksForObjects:parser.entries];
                                           NSString *nextLink = [parser.linkRelations linkHrefForRel:kCMISLinkRelationNext];
                                           
                                           CMISObjectList *objectList = [[CMISObjectList alloc] init];
@@ -144,6 +149,7 @@
                         CMISLogError(@"Failing because parsing the Atom Feed XML returns an error");
                         completionBlock([NSArray array], error);
                     } else {
+                        [[self linkCache] addLinksForObjects:parser.entries];
                         completionBlock(parser.entries, nil);
                     }
                 } else {
@@ -174,14 +180,16 @@
     }
     
     // add the parameters to the URL (CMISUrlUtil will not append if the param name or value is nil)
-    checkedoutLink = [CMISURLUtil urlStringByAppendingParameter:kCMISParameterFolderId value:folderId urlString:checkedoutLink];
-    checkedoutLink = [CMISURLUtil urlStringByAppendingParameter:kCMISParameterFilter value:filter urlString:checkedoutLink];
-    checkedoutLink = [CMISURLUtil urlStringByAppendingParameter:kCMISParameterOrderBy value:orderBy urlString:checkedoutLink];
-    checkedoutLink = [CMISURLUtil urlStringByAppendingParameter:kCMISParameterIncludeAllowableActions value:(includeAllowableActions ? @"true" : @"false") urlString:checkedoutLink];
-    checkedoutLink = [CMISURLUtil urlStringByAppendingParameter:kCMISParameterIncludeRelationships value:[CMISEnums stringForIncludeRelationShip:relationships] urlString:checkedoutLink];
-    checkedoutLink = [CMISURLUtil urlStringByAppendingParameter:kCMISParameterRenditionFilter value:renditionFilter urlString:checkedoutLink];
-    checkedoutLink = [CMISURLUtil urlStringByAppendingParameter:kCMISParameterMaxItems value:[maxItems stringValue] urlString:checkedoutLink];
-    checkedoutLink = [CMISURLUtil urlStringByAppendingParameter:kCMISParameterSkipCount value:[skipCount stringValue] urlString:checkedoutLink];
+    CMISURLBuilder *checkedoutLinkBuilder = [CMISURLBuilder builderWithUrlString:checkedoutLink];
+    [checkedoutLinkBuilder addParameter:kCMISParameterFolderId value:folderId];
+    [checkedoutLinkBuilder addParameter:kCMISParameterFilter value:filter];
+    [checkedoutLinkBuilder addParameter:kCMISParameterOrderBy value:orderBy];
+    [checkedoutLinkBuilder addParameter:kCMISParameterIncludeAllowableActions value:(includeAllowableActions ? @"true" : @"false")];
+    [checkedoutLinkBuilder addParameter:kCMISParameterIncludeRelationships value:[CMISEnums stringForIncludeRelationShip:relationships]];
+    [checkedoutLinkBuilder addParameter:kCMISParameterRenditionFilter value:renditionFilter];
+    [checkedoutLinkBuilder addParameter:kCMISParameterMaxItems value:[maxItems stringValue]];
+    [checkedoutLinkBuilder addParameter:kCMISParameterSkipCount value:[skipCount stringValue]];
+    checkedoutLink = checkedoutLinkBuilder.urlString;
     
     // retrieve the list
     CMISRequest *request = [[CMISRequest alloc] init];
@@ -200,6 +208,7 @@
             CMISAtomFeedParser *parser = [[CMISAtomFeedParser alloc] initWithData:httpResponse.data];
             NSError *internalError = nil;
             if ([parser parseAndReturnError:&internalError]) {
+                [[self linkCache] addLinksForObjects:parser.entries];
                 NSString *nextLink = [parser.linkRelations linkHrefForRel:kCMISLinkRelationNext];
                  
                 CMISObjectList *objectList = [[CMISObjectList alloc] init];
@@ -25,8 +25,10 @@
 #import "CMISErrors.h"
 #import "CMISStringInOutParameter.h"
 #import "CMISURLUtil.h"
-#import "CMISFileUtil.h"
+#import "CMISURLBuilder.h"
+#import "CMISContentSource.h"
 #import "CMISLog.h"
+#import "CMISLinkCache.h"
 
 @implementation CMISAtomPubObjectService
 
@@ -273,29 +275,27 @@
                       completionBlock:(void (^)(NSError *error))completionBlock
                         progressBlock:(void (^)(unsigned long long bytesUploaded, unsigned long long bytesTotal))progressBlock
 {
-    NSInputStream *inputStream = [NSInputStream inputStreamWithFileAtPath:filePath];
-    if (inputStream == nil) {
-        CMISLogError(@"Could not find file %@", filePath);
+    NSError *fileError = nil;
+    CMISContentSource *contentSource = [CMISContentSource contentSourceWithFileAtPath:filePath error:&fileError];
+    if (contentSource == nil) {
+        CMISLogError(@"Could not read file %@: %@", filePath, fileError);
         if (completionBlock) {
-            completionBlock([CMISErrors createCMISErrorWithCode:kCMISErrorCodeInvalidArgument detailedDescription:nil]);
+            completionBlock(fileError);
         }
         return nil;
     }
     
-    NSError *fileError = nil;
-    unsigned long long fileSize = [CMISFileUtil fileSizeForFileAtPath:filePath error:&fileError];
-    if (fileError) {
-        CMISLogError(@"Could not determine size of file %@: %@", filePath, [fileError description]);
-    }
-    
     return [self changeContentOfObject:objectIdParam
-                toContentOfInputStream:inputStream
-                         bytesExpected:fileSize
+                       toContentSource:contentSource
                               filename:[filePath lastPathComponent]
                               mimeType:mimeType
                      overwriteExisting:overwrite
                            changeToken:changeTokenParam
-                       completionBlock:completionBlock
+             objectDataCompletionBlock:^(CMISObjectData *objectData, NSError *error) {
+                 if (completionBlock) {
+                     completionBlock(error);
+                 }
+             }
                          progressBlock:progressBlock];
 }
 
@@ -309,20 +309,64 @@
                       completionBlock:(void (^)(NSError *error))completionBlock
                         progressBlock:(void (^)(unsigned long long bytesUploaded, unsigned long long bytesTotal))progressBlock
 {
-    CMISRequest *request = [[CMISRequest alloc] init];
-    // Validate object id param
-    if (objectIdParam == nil || objectIdParam.inParameter == nil) {
-        CMISLogError(@"Object id is nil or inParameter of objectId is nil");
+    return [self changeContentOfObject:objectIdParam
+                toContentOfInputStream:inputStream
+                         bytesExpected:bytesExpected
+                              filename:filename
+                              mimeType:mimeType
+                     overwriteExisting:overwrite
+                           changeToken:changeTokenParam
+             objectDataCompletionBlock:^(CMISObjectData *objectData, NSError *error) {
+                 if (completionBlock) {
+                     completionBlock(error);
+                 }
+             }
+                         progressBlock:progressBlock];
+}
+
+- (CMISRequest*)changeContentOfObject:(CMISStringInOutParameter *)objectIdParam
+               toContentOfInputStream:(NSInputStream *)inputStream
+                        bytesExpected:(unsigned long long)bytesExpected
+                             filename:(NSString*)filename
+                             mimeType:(NSString *)mimeType
+                    overwriteExisting:(BOOL)overwrite
+                          changeToken:(CMISStringInOutParameter *)changeTokenParam
+            objectDataCompletionBlock:(void (^)(CMISObjectData *objectData, NSError *error))completionBlock
+                        progressBlock:(void (^)(unsigned long long bytesUploaded, unsigned long long bytesTotal))progressBlock
+{
+    if (inputStream == nil) {
+        CMISLogError(@"Invalid input stream");
         if (completionBlock) {
-            completionBlock([CMISErrors createCMISErrorWithCode:kCMISErrorCodeInvalidArgument detailedDescription:@"Must provide object id"]);
+            completionBlock(nil, [CMISErrors createCMISErrorWithCode:kCMISErrorCodeInvalidArgument detailedDescription:@"Invalid input stream"]);
         }
         return nil;
     }
     
-    if (inputStream == nil) {
-        CMISLogError(@"Invalid input stream");
+    return [self changeContentOfObject:objectIdParam
+                       toContentSource:[CMISContentSource contentSourceWithInputStream:inputStream length:bytesExpected]
+                              filename:filename
+                              mimeType:mimeType
+                     overwriteExisting:overwrite
+                           changeToken:changeTokenParam
+             objectDataCompletionBlock:completionBlock
+                         progressBlock:progressBlock];
+}
+
+- (CMISRequest*)changeContentOfObject:(CMISStringInOutParameter *)objectIdParam
+                      toContentSource:(CMISContentSource *)contentSource
+                             filename:(NSString*)filename
+                             mimeType:(NSString *)mimeType
+                    overwriteExisting:(BOOL)overwrite
+                          changeToken:(CMISStringInOutParameter *)changeTokenParam
+            objectDataCompletionBlock:(void (^)(CMISObjectData *objectData, NSError *error))completionBlock
+                        progressBlock:(void (^)(unsigned long long bytesUploaded, unsigned long long bytesTotal))progressBlock
+{
+    CMISRequest *request = [[CMISRequest alloc] init];
+    // Validate object id param
+    if (objectIdParam == nil || objectIdParam.inParameter == nil) {
+        CMISLogError(@"Object id is nil or inParameter of objectId is nil");
         if (completionBlock) {
-            completionBlock([CMISErrors createCMISErrorWithCode:kCMISErrorCodeInvalidArgument detailedDescription:@"Invalid input stream"]);
+            completionBlock(nil, [CMISErrors createCMISErrorWithCode:kCMISErrorCodeInvalidArgument detailedDescription:@"Must provide object id"]);
         }
         return nil;
     }
@@ -345,7 +389,7 @@
         if (editMediaLink == nil){
             CMISLogError(@"Could not retrieve %@ link for object '%@'", kCMISLinkEditMedia, objectIdParam.inParameter);
             if (completionBlock) {
-                completionBlock([CMISErrors cmisError:error cmisErrorCode:kCMISErrorCodeObjectNotFound]);
+                completionBlock(nil, [CMISErrors cmisError:error cmisErrorCode:kCMISErrorCodeObjectNotFound]);
             }
             return;
         }
@@ -367,18 +411,34 @@
         
         NSDictionary *headers = [NSDictionary dictionaryWithObjects:values forKeys:keys];
                   
-        [self.bindingSession.networkProvider invoke:[NSURL URLWithString:editMediaLink]
-                                         httpMethod:HTTP_PUT
-                                            session:self.bindingSession
-                                        inputStream:inputStream
-                                            headers:headers
-                                      bytesExpected:bytesExpected
-                                        cmisRequest:request
-                                    completionBlock:^(CMISHttpResponse *httpResponse, NSError *error) {
+        [self uploadContentSource:contentSource
+                            toUrl:[NSURL URLWithString:editMediaLink]
+                       httpMethod:HTTP_PUT
+                          headers:headers
+                        startData:nil
+                          endData:nil
+                useBase64Encoding:NO
+                      cmisRequest:request
+                  completionBlock:^(CMISHttpResponse *httpResponse, NSError *error) {
              // Check response status
+             CMISObjectData *objectData = nil;
              if (httpResponse) {
                  if (httpResponse.statusCode == 200 || httpResponse.statusCode == 201 || httpResponse.statusCode == 204) {
                      error = nil;
+                     
+                     // Some servers return the updated entry, use it to save the caller a round trip
+                     if (httpResponse.statusCode != 204 && httpResponse.data.length > 0) {
+                         CMISAtomEntryParser *parser = [[CMISAtomEntryParser alloc] initWithData:httpResponse.data];
+                         NSError *parseError = nil;
+                         if ([parser parseAndReturnError:&parseError] && parser.objectData.identifier != nil) {
+                             objectData = parser.objectData;
+                             objectIdParam.outParameter = objectData.identifier;
+                             changeTokenParam.outParameter = [objectData.properties propertyValueForId:kCMISPropertyChangeToken];
+                             [[self linkCache] addLinks:objectData.linkRelations objectId:objectData.identifier];
+                         } else {
+                             CMISLogDebug(@"Content update response did not contain an atom entry: %@", parseError);
+                         }
+                     }
                  } else {
                      CMISLogError(@"Invalid http response status code when updating content: %d", (int)httpResponse.statusCode);
                      error = [CMISErrors createCMISErrorWithCode:kCMISErrorCodeRuntime
@@ -386,10 +446,10 @@
                  }
              }
              if (completionBlock) {
-                 completionBlock(error);
+                 completionBlock(objectData, error);
              }
          }
-           progressBlock:progressBlock];
+                    progressBlock:progressBlock];
     }];
     
     return request;
@@ -403,29 +463,22 @@
                            completionBlock:(void (^)(NSString *objectId, NSError *Error))completionBlock
                              progressBlock:(void (^)(unsigned long long bytesUploaded, unsigned long long bytesTotal))progressBlock
 {
-    NSInputStream *inputStream = [NSInputStream inputStreamWithFileAtPath:filePath];
-    if (inputStream == nil) {
-        CMISLogError(@"Could not find file %@", filePath);
+    NSError *fileError = nil;
+    CMISContentSource *contentSource = [CMISContentSource contentSourceWithFileAtPath:filePath error:&fileError];
+    if (contentSource == nil) {
+        CMISLogError(@"Could not read file %@: %@", filePath, fileError);
         if (completionBlock) {
-            completionBlock(nil, [CMISErrors createCMISErrorWithCode:kCMISErrorCodeInvalidArgument
-                                                 detailedDescription:@"Invalid file"]);
+            completionBlock(nil, fileError);
         }
         return nil;
     }
     
-    NSError *fileError = nil;
-    unsigned long long bytesExpected = [CMISFileUtil fileSizeForFileAtPath:filePath error:&fileError];
-    if (fileError) {
-        CMISLogError(@"Could not determine size of file %@: %@", filePath, [fileError description]);
-    }
-    
-    return [self createDocumentFromInputStream:inputStream
-                                      mimeType:mimeType
-                                    properties:properties
-                                      inFolder:folderObjectId
-                                 bytesExpected:bytesExpected
-                               completionBlock:completionBlock
-                                 progressBlock:progressBlock];
+    return [self createDocumentFromContentSource:contentSource
+                                        mimeType:mimeType
+                                      properties:properties
+                                        inFolder:folderObjectId
+                                 completionBlock:completionBlock
+                                   progressBlock:progressBlock];
 }
 
 - (CMISRequest*)createDocumentFromInputStream:(NSInputStream *)inputStream // may be nil if you do not want to set content
@@ -435,6 +488,21 @@
                                 bytesExpected:(unsigned long long)bytesExpected // optional
                               completionBlock:(void (^)(NSString *objectId, NSError *error))completionBlock
                                 progressBlock:(void (^)(unsigned long long bytesUploaded, unsigned long long bytesTotal))progressBlock
+{
+    return [self createDocumentFromContentSource:(inputStream ? [CMISContentSource contentSourceWithInputStream:inputStream length:bytesExpected] : nil)
+                                        mimeType:mimeType
+                                      properties:properties
+                                        inFolder:folderObjectId
+                                 completionBlock:completionBlock
+                                   progressBlock:progressBlock];
+}
+
+- (CMISRequest*)createDocumentFromContentSource:(CMISContentSource *)contentSource // may be nil if you do not want to set content
+                                       mimeType:(NSString *)mimeType
+                                     properties:(CMISProperties *)properties
+                                       inFolder:(NSString *)folderObjectId
+                                completionBlock:(void (^)(NSString *objectId, NSError *error))completionBlock
+                                  progressBlock:(void (^)(unsigned long long bytesUploaded, unsigned long long bytesTotal))progressBlock
 {
     // Validate properties
     if ([properties propertyValueForId:kCMISPropertyName] == nil || [properties propertyValueForId:kCMISPropertyObjectTypeId] == nil) {
@@ -446,7 +514,7 @@
     }
     
     // Validate mimetype
-    if (inputStream && !mimeType) {
+    if (contentSource && !mimeType) {
         CMISLogError(@"Must provide a mimetype when creating a cmis document");
         if (completionBlock) {
             completionBlock(nil, [CMISErrors createCMISErrorWithCode:kCMISErrorCodeInvalidArgument detailedDescription:nil]);
@@ -470,9 +538,8 @@
                               [self sendAtomEntryXmlToLink:downLink
                                          httpRequestMethod:HTTP_POST
                                                 properties:properties
-                                        contentInputStream:inputStream
+                                             contentSource:contentSource
                                            contentMimeType:mimeType
-                                             bytesExpected:bytesExpected
                                                cmisRequest:request
                                            completionBlock:^(CMISObjectData *objectData, NSError *error) {
                                                completionBlock(objectData.identifier, error);
@@ -642,9 +709,11 @@
                 return;
             }
             
-            link = [CMISURLUtil urlStringByAppendingParameter:kCMISParameterAllVersions value:(allVersions ? @"true" : @"false") urlString:link];
-            link = [CMISURLUtil urlStringByAppendingParameter:kCMISParameterUnfileObjects value:[CMISEnums stringForUnfileObject:unfileObjects] urlString:link];
-            link = [CMISURLUtil urlStringByAppendingParameter:kCMISParameterContinueOnFailure value:(continueOnFailure ? @"true" : @"false") urlString:link];
+            CMISURLBuilder *linkBuilder = [CMISURLBuilder builderWithUrlString:link];
+            [linkBuilder addParameter:kCMISParameterAllVersions value:(allVersions ? @"true" : @"false")];
+            [linkBuilder addParameter:kCMISParameterUnfileObjects value:[CMISEnums stringForUnfileObject:unfileObjects]];
+            [linkBuilder addParameter:kCMISParameterContinueOnFailure value:(continueOnFailure ? @"true" : @"false")];
+            link = linkBuilder.urlString;
 
             [self.bindingSession.networkProvider invokeDELETE:[NSURL URLWithString:link]
                                                     session:self.bindingSession
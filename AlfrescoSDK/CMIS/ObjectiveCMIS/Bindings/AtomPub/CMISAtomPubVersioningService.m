@@ -27,7 +27,8 @@
 #import "CMISErrors.h"
 #import "CMISURLUtil.h"
 #import "CMISLog.h"
-#import "CMISFileUtil.h"
+#import "CMISLinkCache.h"
+#import "CMISContentSource.h"
 
 @implementation CMISAtomPubVersioningService
 
@@ -98,6 +99,7 @@
                     if (![feedParser parseAndReturnError:&error]) {
                         completionBlock(nil, [CMISErrors cmisError:error cmisErrorCode:kCMISErrorCodeVersioning]);
                     } else {
+                        [[self linkCache] addLinksForObjects:feedParser.entries];
                         completionBlock(feedParser.entries, nil);
                     }
                 } else {
@@ -184,25 +186,19 @@
         completionBlock:(void (^)(CMISObjectData *objectData, NSError *error))completionBlock
           progressBlock:(void (^)(unsigned long long bytesUploaded, unsigned long long bytesTotal))progressBlock
 {
-    NSInputStream *inputStream = [NSInputStream inputStreamWithFileAtPath:filePath];
-    if (inputStream == nil) {
-        CMISLogError(@"Could not find file %@", filePath);
+    NSError *fileError = nil;
+    CMISContentSource *contentSource = [CMISContentSource contentSourceWithFileAtPath:filePath error:&fileError];
+    if (contentSource == nil) {
+        CMISLogError(@"Could not read file %@: %@", filePath, fileError);
         if (completionBlock) {
-            completionBlock(nil, [CMISErrors createCMISErrorWithCode:kCMISErrorCodeInvalidArgument detailedDescription:nil]);
+            completionBlock(nil, fileError);
         }
         return nil;
     }
     
-    NSError *fileError = nil;
-    unsigned long long fileSize = [CMISFileUtil fileSizeForFileAtPath:filePath error:&fileError];
-    if (fileError) {
-        CMISLogError(@"Could not determine size of file %@: %@", filePath, [fileError description]);
-    }
-    
     return [self checkIn:objectId
           asMajorVersion:asMajorVersion
-             inputStream:inputStream
-           bytesExpected:fileSize
+           contentSource:contentSource
                 mimeType:mimeType
               properties:properties
           checkinComment:checkinComment
@@ -219,6 +215,25 @@
          checkinComment:(NSString *)checkinComment
         completionBlock:(void (^)(CMISObjectData *objectData, NSError *error))completionBlock
           progressBlock:(void (^)(unsigned long long bytesUploaded, unsigned long long bytesTotal))progressBlock
+{
+    return [self checkIn:objectId
+          asMajorVersion:asMajorVersion
+           contentSource:(inputStream ? [CMISContentSource contentSourceWithInputStream:inputStream length:bytesExpected] : nil)
+                mimeType:mimeType
+              properties:properties
+          checkinComment:checkinComment
+         completionBlock:completionBlock
+           progressBlock:progressBlock];
+}
+
+- (CMISRequest*)checkIn:(NSString *)objectId
+         asMajorVersion:(BOOL)asMajorVersion
+          contentSource:(CMISContentSource *)contentSource
+               mimeType:(NSString *)mimeType
+             properties:(CMISProperties *)properties
+         checkinComment:(NSString *)checkinComment
+        completionBlock:(void (^)(CMISObjectData *objectData, NSError *error))completionBlock
+          progressBlock:(void (^)(unsigned long long bytesUploaded, unsigned long long bytesTotal))progressBlock
 {
     // Validate params
     if (!objectId) {
@@ -244,9 +259,8 @@
         [self sendAtomEntryXmlToLink:link
                    httpRequestMethod:HTTP_PUT
                           properties:properties
-                  contentInputStream:inputStream
+                       contentSource:contentSource
                      contentMimeType:mimeType
-                       bytesExpected:bytesExpected
                          cmisRequest:request
                      completionBlock:^(CMISObjectData *objectData, NSError *error) {
                          if (error) {
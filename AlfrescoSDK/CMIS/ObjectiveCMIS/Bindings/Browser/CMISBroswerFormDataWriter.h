@@ -20,12 +20,16 @@
 #import <Foundation/Foundation.h>
 #import "CMISProperties.h"
 
+@class CMISContentSource;
+
 @interface CMISBroswerFormDataWriter : NSObject
 
 - (id)initWithAction:(NSString *)action;
 
 - (id)initWithAction:(NSString *)action contentStream:(NSInputStream *)contentStream mediaType:(NSString *)mediaType;
 
+- (id)initWithAction:(NSString *)action contentSource:(CMISContentSource *)contentSource mediaType:(NSString *)mediaType;
+
 - (void)addParameter:(NSString *)name value:(id)value;
 
 - (void)addParameter:(NSString *)name boolValue:(BOOL)value;
@@ -43,10 +47,10 @@
 /// call this method to get the http request body form data if no content stream is used
 - (NSData *)body;
 
-/// call this method to get the start of the http request body form data if a content stream is set
+/// call this method to get the start of the http request body form data if a content stream or source is set
 - (NSData *)startData;
 
-/// call this method to get the end of the http request body form data if a content stream is set
+/// call this method to get the end of the http request body form data if a content stream or source is set
 - (NSData *)endData;
 
 @end
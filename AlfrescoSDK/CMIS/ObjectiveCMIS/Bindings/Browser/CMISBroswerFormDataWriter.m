@@ -30,7 +30,7 @@ NSString * const kCMISFormDataContentTypeFormData = @"multipart/form-data; bound
 
 @interface CMISBroswerFormDataWriter ()
 
-@property (nonatomic, strong) NSInputStream *contentStream;
+@property (nonatomic, assign) BOOL hasContent;
 @property (nonatomic, strong) NSMutableDictionary *parameters;
 @property (nonatomic, strong) NSString *boundary;
 @property (nonatomic, strong) NSString *mediaType;
@@ -42,17 +42,27 @@ NSString * const kCMISFormDataContentTypeFormData = @"multipart/form-data; bound
 
 - (id)initWithAction:(NSString *)action
 {
-    return [self initWithAction:action contentStream:nil mediaType:nil];
+    return [self initWithAction:action hasContent:NO mediaType:nil];
 }
 
 - (id)initWithAction:(NSString *)action contentStream:(NSInputStream *)contentStream mediaType:(NSString *)mediaType
+{
+    return [self initWithAction:action hasContent:(contentStream != nil) mediaType:mediaType];
+}
+
+- (id)initWithAction:(NSString *)action contentSource:(CMISContentSource *)contentSource mediaType:(NSString *)mediaType
+{
+    return [self initWithAction:action hasContent:(contentSource != nil) mediaType:mediaType];
+}
+
+- (id)initWithAction:(NSString *)action hasContent:(BOOL)hasContent mediaType:(NSString *)mediaType
 {
     self = [super init];
     if (self) {
         self.parameters = [[NSMutableDictionary alloc] init];
         
         [self addParameter:kCMISBrowserJSONControlCmisAction value:action];
-        self.contentStream = contentStream;
+        self.hasContent = hasContent;
         self.mediaType = mediaType;
         self.boundary = [NSString stringWithFormat:@"aPacHeCheMIStryoBjECtivEcmiS%x%a%x", (unsigned int) action.hash, CFAbsoluteTimeGetCurrent(), (unsigned int) self.hash];
         
@@ -140,29 +150,26 @@ NSString * const kCMISFormDataContentTypeFormData = @"multipart/form-data; bound
 
 - (NSDictionary *)headers
 {
-    NSString *contentType = self.contentStream == nil ? kCMISFormDataContentTypeUrlEncoded : [NSString stringWithFormat:@"%@%@", kCMISFormDataContentTypeFormData, self.boundary];
+    NSString *contentType = !self.hasContent ? kCMISFormDataContentTypeUrlEncoded : [NSString stringWithFormat:@"%@%@", kCMISFormDataContentTypeFormData, self.boundary];
     return @{@"Content-Type" : contentType};
 }
 
 - (NSData *)body
 {
-    if (self.contentStream == nil) {
-        BOOL first = YES;
-        NSData *amp = [@"&" dataUsingEncoding:NSUTF8StringEncoding];
-        NSMutableData *data = [[NSMutableData alloc] init];
+    if (!self.hasContent) {
+        // build the whole body as one string and encode it once
+        NSMutableString *body = [[NSMutableString alloc] init];
         
         for (NSString *parameterKey in self.parameters) {
-            if (first) {
-                first = NO;
-            } else {
-                [data appendData:amp];
+            if (body.length > 0) {
+                [body appendString:@"&"];
             }
-            NSString *encodedParameterValue = [CMISURLUtil encodeUrlParameterValue:self.parameters[parameterKey]];
-            NSString *parameter = [NSString stringWithFormat:@"%@=%@", parameterKey, encodedParameterValue];
-            [data appendData:[parameter dataUsingEncoding:NSUTF8StringEncoding]];
+            [body appendString:parameterKey];
+            [body appendString:@"="];
+            [body appendString:[CMISURLUtil encodeUrlParameterValue:self.parameters[parameterKey]]];
         }
 
-        return data;
+        return [body dataUsingEncoding:NSUTF8StringEncoding];
     } else {
         CMISLogError(@"this method should not be called when content stream is set. Use startData and endData method to retrieve the data.");
         return nil;
@@ -171,18 +178,21 @@ NSString * const kCMISFormDataContentTypeFormData = @"multipart/form-data; bound
 
 - (NSData *)startData
 {
-    if (self.contentStream) {
-        NSMutableData *data = [[NSMutableData alloc] init];
+    if (self.hasContent) {
+        // build the whole envelope as one string and encode it once
+        NSMutableString *start = [[NSMutableString alloc] init];
 
-        [self appendLine:data];
+        [self appendLine:start];
         
         // parameters
         for (NSString *paramKey in self.parameters) {
-            [self appendLine:data string:[NSString stringWithFormat:@"--%@", self.boundary]];
-            [self appendLine:data string:[NSString stringWithFormat:@"Content-Disposition: form-data; name=\"%@\"", paramKey]];
-            [self appendLine:data string:@"Content-Type: text/plain; charset=utf-8"];
-            [self appendLine:data];
-            [self appendLine:data string:self.parameters[paramKey]];
+            [self appendBoundaryLine:start];
+            [start appendString:@"Content-Disposition: form-data; name=\""];
+            [start appendString:paramKey];
+            [self appendLine:start string:@"\""];
+            [self appendLine:start string:@"Content-Type: text/plain; charset=utf-8"];
+            [self appendLine:start];
+            [self appendLine:start string:self.parameters[paramKey]];
         }
         
         // content
@@ -190,21 +200,23 @@ NSString * const kCMISFormDataContentTypeFormData = @"multipart/form-data; bound
             self.fileName = @"content";
         }
         
+        NSRange slashRange = [self.mediaType rangeOfString:@"/"];
         if (self.mediaType == nil ||
-            [self.mediaType rangeOfString:@"/"].location < 1 ||
-            [self.mediaType rangeOfString:@"\n"].location > -1 ||
-            [self.mediaType rangeOfString:@"\r"].location > -1) {
+            slashRange.location == NSNotFound || slashRange.location < 1 ||
+            [self.mediaType rangeOfString:@"\n"].location != NSNotFound ||
+            [self.mediaType rangeOfString:@"\r"].location != NSNotFound) {
             self.mediaType = kCMISMediaTypeOctetStream;
         }
 
-        [self appendLine:data string:[NSString stringWithFormat:@"--%@", self.boundary]];
-        [self appendLine:data string:[NSString stringWithFormat:@"Content-Disposition: %@",
-                  [CMISMimeHelper encodeContentDisposition:kCMISMimeHelperDispositionFormDataContent fileName:self.fileName]]];
-        [self appendLine:data string:[NSString stringWithFormat:@"Content-Type: %@", self.mediaType]];
-        [self appendLine:data string:@"Content-Transfer-Encoding: binary"];
-        [self appendLine:data];
+        [self appendBoundaryLine:start];
+        [start appendString:@"Content-Disposition: "];
+        [self appendLine:start string:[CMISMimeHelper encodeContentDisposition:kCMISMimeHelperDispositionFormDataContent fileName:self.fileName]];
+        [start appendString:@"Content-Type: "];
+        [self appendLine:start string:self.mediaType];
+        [self appendLine:start string:@"Content-Transfer-Encoding: binary"];
+        [self appendLine:start];
         
-        return data;
+        return [start dataUsingEncoding:NSUTF8StringEncoding];
     } else {
         CMISLogError(@"this method should not be called when content stream is nil. Use body method to retrieve the data.");
         return nil;
@@ -213,28 +225,38 @@ NSString * const kCMISFormDataContentTypeFormData = @"multipart/form-data; bound
 
 - (NSData *)endData
 {
-    if (self.contentStream) {
-        NSMutableData *data = [[NSMutableData alloc] init];
+    if (self.hasContent) {
+        NSMutableString *end = [[NSMutableString alloc] init];
         
-        [self appendLine:data];
-        [self appendLine:data string:[NSString stringWithFormat:@"--%@--", self.boundary]];
+        [self appendLine:end];
+        [end appendString:@"--"];
+        [end appendString:self.boundary];
+        [self appendLine:end string:@"--"];
         
-        return data;
+        return [end dataUsingEncoding:NSUTF8StringEncoding];
     } else {
         CMISLogError(@"this method should not be called when content stream is nil. Use body method to retrieve the data.");
         return nil;
     }
 }
 
-- (void)appendLine:(NSMutableData *)data
+- (void)appendLine:(NSMutableString *)string
 {
-    [self appendLine:data string:nil];
+    [self appendLine:string string:nil];
+}
+
+- (void)appendLine:(NSMutableString *)string string:(NSString *)s
+{
+    if (s) {
+        [string appendString:s];
+    }
+    [string appendString:@"\r\n"];
 }
 
-- (void)appendLine:(NSMutableData *)data string:(NSString *)s
+- (void)appendBoundaryLine:(NSMutableString *)string
 {
-    s = s ? [NSString stringWithFormat:@"%@\r\n", s] : @"\r\n";
-    [data appendData:[s dataUsingEncoding:NSUTF8StringEncoding]];
+    [string appendString:@"--"];
+    [self appendLine:string string:self.boundary];
 }
 
 @end
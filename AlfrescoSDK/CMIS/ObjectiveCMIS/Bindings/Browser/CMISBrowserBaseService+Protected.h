@@ -18,6 +18,9 @@
  */
 
 #import "CMISBrowserBaseService.h"
+#import "CMISNetworkProvider.h"
+
+@class CMISContentSource;
 
 @interface CMISBrowserBaseService (Protected)
 
@@ -25,4 +28,19 @@
                                    cmisRequest:(CMISRequest *)cmisRequest
                                completionBlock:(void (^)(CMISTypeDefinition *typeDefinition, NSError *error))completionBlock;
 
+/**
+ Uploads the content of a content source between the start and end data, providers that don't support content
+ sources are passed its stream and length
+ */
+- (void)uploadContentSource:(CMISContentSource *)contentSource
+                      toUrl:(NSURL *)url
+                 httpMethod:(CMISHttpRequestMethod)httpRequestMethod
+                    headers:(NSDictionary *)headers
+                  startData:(NSData *)startData
+                    endData:(NSData *)endData
+          useBase64Encoding:(BOOL)useBase64Encoding
+                cmisRequest:(CMISRequest *)cmisRequest
+            completionBlock:(void (^)(CMISHttpResponse *httpResponse, NSError *error))completionBlock
+              progressBlock:(void (^)(unsigned long long bytesUploaded, unsigned long long bytesTotal))progressBlock;
+
 @end
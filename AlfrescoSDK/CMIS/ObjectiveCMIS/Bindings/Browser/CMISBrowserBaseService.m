@@ -23,6 +23,7 @@
 #import "CMISURLUtil.h"
 #import "CMISHttpResponse.h"
 #import "CMISBrowserUtil.h"
+#import "CMISContentSource.h"
 
 @interface CMISBrowserBaseService ()
 @property (nonatomic, strong, readwrite) CMISBindingSession *bindingSession;
@@ -109,4 +110,44 @@
     return cmisRequest;
 }
 
+- (void)uploadContentSource:(CMISContentSource *)contentSource
+                      toUrl:(NSURL *)url
+                 httpMethod:(CMISHttpRequestMethod)httpRequestMethod
+                    headers:(NSDictionary *)headers
+                  startData:(NSData *)startData
+                    endData:(NSData *)endData
+          useBase64Encoding:(BOOL)useBase64Encoding
+                cmisRequest:(CMISRequest *)cmisRequest
+            completionBlock:(void (^)(CMISHttpResponse *httpResponse, NSError *error))completionBlock
+              progressBlock:(void (^)(unsigned long long bytesUploaded, unsigned long long bytesTotal))progressBlock
+{
+    id<CMISNetworkProvider> networkProvider = self.bindingSession.networkProvider;
+    if ([networkProvider respondsToSelector:@selector(invoke:httpMethod:session:contentSource:headers:cmisRequest:startData:endData:useBase64Encoding:completionBlock:progressBlock:)]) {
+        [networkProvider invoke:url
+                     httpMethod:httpRequestMethod
+                        session:self.bindingSession
+                  contentSource:contentSource
+                        headers:headers
+                    cmisRequest:cmisRequest
+                      startData:startData
+                        endData:endData
+              useBase64Encoding:useBase64Encoding
+                completionBlock:completionBlock
+                  progressBlock:progressBlock];
+    } else {
+        [networkProvider invoke:url
+                     httpMethod:httpRequestMethod
+                        session:self.bindingSession
+                    inputStream:[contentSource inputStream]
+                        headers:headers
+                  bytesExpected:contentSource.length
+                    cmisRequest:cmisRequest
+                      startData:startData
+                        endData:endData
+              useBase64Encoding:useBase64Encoding
+                completionBlock:completionBlock
+                  progressBlock:progressBlock];
+    }
+}
+
 @end
@@ -77,6 +77,8 @@ extern NSString * const kCMISBrowserJSONPropertiesExtension;
 extern NSString * const kCMISBrowserJSONAllowableActions;
 extern NSString * const kCMISBrowserJSONRelationships;
 extern NSString * const kCMISBrowserJSONChangeEventInfo;
+extern NSString * const kCMISBrowserJSONChangeType;
+extern NSString * const kCMISBrowserJSONChangeTime;
 extern NSString * const kCMISBrowserJSONAcl;
 extern NSString * const kCMISBrowserJSONAces;
 extern NSString * const kCMISBrowserJSONExactAcl;
@@ -89,6 +89,8 @@ NSString * const kCMISBrowserJSONPropertiesExtension = @"propertiesExtension";
 NSString * const kCMISBrowserJSONAllowableActions = @"allowableActions";
 NSString * const kCMISBrowserJSONRelationships = @"relationships";
 NSString * const kCMISBrowserJSONChangeEventInfo = @"changeEventInfo";
+NSString * const kCMISBrowserJSONChangeType = @"changeType";
+NSString * const kCMISBrowserJSONChangeTime = @"changeTime";
 NSString * const kCMISBrowserJSONAcl = @"acl";
 NSString * const kCMISBrowserJSONAces = @"aces";
 NSString * const kCMISBrowserJSONExactAcl = @"exactACL";
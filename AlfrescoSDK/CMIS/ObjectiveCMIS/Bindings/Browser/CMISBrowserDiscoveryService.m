@@ -26,6 +26,9 @@
 #import "CMISBrowserConstants.h"
 #import "CMISConstants.h"
 #import "CMISEnums.h"
+#import "CMISURLUtil.h"
+#import "CMISURLBuilder.h"
+#import "CMISStringInOutParameter.h"
 
 @implementation CMISBrowserDiscoveryService
 
@@ -75,4 +78,42 @@ includeAllowableActions:(BOOL)includeAllowableActions
     return cmisRequest;
 }
 
+- (CMISRequest*)retrieveContentChanges:(CMISStringInOutParameter *)changeLogToken
+                     includeProperties:(BOOL)includeProperties
+                                filter:(NSString *)filter
+                              maxItems:(NSNumber *)maxItems
+                       completionBlock:(void (^)(CMISObjectList *objectList, NSError *error))completionBlock
+{
+    NSString *url = [self retrieveRepositoryUrlWithSelector:kCMISBrowserJSONSelectorContentChanges];
+    CMISURLBuilder *urlBuilder = [CMISURLBuilder builderWithUrlString:url];
+    [urlBuilder addParameter:kCMISParameterChangeLogToken value:changeLogToken.inParameter];
+    [urlBuilder addParameter:kCMISParameterIncludeProperties boolValue:includeProperties];
+    [urlBuilder addParameter:kCMISParameterFilter value:filter];
+    [urlBuilder addParameter:kCMISParameterMaxItems numberValue:maxItems];
+    [urlBuilder addParameter:kCMISBrowserJSONParameterSuccinct value:kCMISParameterValueTrue];
+    url = urlBuilder.urlString;
+    
+    CMISRequest *cmisRequest = [[CMISRequest alloc] init];
+    
+    [self.bindingSession.networkProvider invokeGET:[NSURL URLWithString:url]
+                                           session:self.bindingSession
+                                       cmisRequest:cmisRequest
+                                   completionBlock:^(CMISHttpResponse *httpResponse, NSError *error) {
+                                       if (httpResponse.statusCode == 200 && httpResponse.data) {
+                                           CMISBrowserTypeCache *typeCache = [[CMISBrowserTypeCache alloc] initWithRepositoryId:self.bindingSession.repositoryId bindingService:self];
+                                           [CMISBrowserUtil contentChangesFromJSONData:httpResponse.data typeCache:typeCache completionBlock:^(CMISObjectList *objectList, NSString *nextChangeLogToken, NSError *error) {
+                                               if (error) {
+                                                   completionBlock(nil, error);
+                                               } else {
+                                                   changeLogToken.outParameter = nextChangeLogToken;
+                                                   completionBlock(objectList, nil);
+                                               }
+                                           }];
+                                       } else {
+                                           completionBlock(nil, error);
+                                       }
+                                   }];
+    return cmisRequest;
+}
+
 @end
@@ -24,6 +24,7 @@
 #import "CMISBrowserUtil.h"
 #import "CMISBrowserConstants.h"
 #import "CMISURLUtil.h"
+#import "CMISURLBuilder.h"
 
 @implementation CMISBrowserNavigationService
 
@@ -39,15 +40,17 @@
                  completionBlock:(void (^)(CMISObjectList *objectList, NSError *error))completionBlock
 {
     NSString *objectUrl = [self retrieveObjectUrlForObjectWithId:objectId selector:kCMISBrowserJSONSelectorChildren];
-    objectUrl = [CMISURLUtil urlStringByAppendingParameter:kCMISParameterFilter value:filter urlString:objectUrl];
-    objectUrl = [CMISURLUtil urlStringByAppendingParameter:kCMISParameterOrderBy value:orderBy urlString:objectUrl];
-    objectUrl = [CMISURLUtil urlStringByAppendingParameter:kCMISParameterIncludeAllowableActions boolValue:includeAllowableActions urlString:objectUrl];
-    objectUrl = [CMISURLUtil urlStringByAppendingParameter:kCMISParameterIncludeRelationships value:[CMISEnums stringForIncludeRelationShip:relationships] urlString:objectUrl];
-    objectUrl = [CMISURLUtil urlStringByAppendingParameter:kCMISParameterRenditionFilter value:renditionFilter urlString:objectUrl];
-    objectUrl = [CMISURLUtil urlStringByAppendingParameter:kCMISParameterIncludePathSegment boolValue:includePathSegment urlString:objectUrl];
-    objectUrl = [CMISURLUtil urlStringByAppendingParameter:kCMISParameterMaxItems numberValue:maxItems urlString:objectUrl];
-    objectUrl = [CMISURLUtil urlStringByAppendingParameter:kCMISParameterSkipCount numberValue:skipCount urlString:objectUrl];
-    objectUrl = [CMISURLUtil urlStringByAppendingParameter:kCMISBrowserJSONParameterSuccinct value:kCMISParameterValueTrue urlString:objectUrl];
+    CMISURLBuilder *objectUrlBuilder = [CMISURLBuilder builderWithUrlString:objectUrl];
+    [objectUrlBuilder addParameter:kCMISParameterFilter value:filter];
+    [objectUrlBuilder addParameter:kCMISParameterOrderBy value:orderBy];
+    [objectUrlBuilder addParameter:kCMISParameterIncludeAllowableActions boolValue:includeAllowableActions];
+    [objectUrlBuilder addParameter:kCMISParameterIncludeRelationships value:[CMISEnums stringForIncludeRelationShip:relationships]];
+    [objectUrlBuilder addParameter:kCMISParameterRenditionFilter value:renditionFilter];
+    [objectUrlBuilder addParameter:kCMISParameterIncludePathSegment boolValue:includePathSegment];
+    [objectUrlBuilder addParameter:kCMISParameterMaxItems numberValue:maxItems];
+    [objectUrlBuilder addParameter:kCMISParameterSkipCount numberValue:skipCount];
+    [objectUrlBuilder addParameter:kCMISBrowserJSONParameterSuccinct value:kCMISParameterValueTrue];
+    objectUrl = objectUrlBuilder.urlString;
     
     CMISRequest *cmisRequest = [[CMISRequest alloc] init];
     
@@ -82,12 +85,14 @@
                          completionBlock:(void (^)(NSArray *parents, NSError *error))completionBlock
 {
     NSString *objectUrl = [self retrieveObjectUrlForObjectWithId:objectId selector:kCMISBrowserJSONSelectorParents];
-    objectUrl = [CMISURLUtil urlStringByAppendingParameter:kCMISParameterFilter value:filter urlString:objectUrl];
-    objectUrl = [CMISURLUtil urlStringByAppendingParameter:kCMISParameterIncludeAllowableActions boolValue:includeAllowableActions urlString:objectUrl];
-    objectUrl = [CMISURLUtil urlStringByAppendingParameter:kCMISParameterIncludeRelationships value:[CMISEnums stringForIncludeRelationShip:relationships] urlString:objectUrl];
-    objectUrl = [CMISURLUtil urlStringByAppendingParameter:kCMISParameterRenditionFilter value:renditionFilter urlString:objectUrl];
-    objectUrl = [CMISURLUtil urlStringByAppendingParameter:kCMISParameterRelativePathSegment boolValue:includeRelativePathSegment urlString:objectUrl];
-    objectUrl = [CMISURLUtil urlStringByAppendingParameter:kCMISBrowserJSONParameterSuccinct value:kCMISParameterValueTrue urlString:objectUrl];
+    CMISURLBuilder *objectUrlBuilder = [CMISURLBuilder builderWithUrlString:objectUrl];
+    [objectUrlBuilder addParameter:kCMISParameterFilter value:filter];
+    [objectUrlBuilder addParameter:kCMISParameterIncludeAllowableActions boolValue:includeAllowableActions];
+    [objectUrlBuilder addParameter:kCMISParameterIncludeRelationships value:[CMISEnums stringForIncludeRelationShip:relationships]];
+    [objectUrlBuilder addParameter:kCMISParameterRenditionFilter value:renditionFilter];
+    [objectUrlBuilder addParameter:kCMISParameterRelativePathSegment boolValue:includeRelativePathSegment];
+    [objectUrlBuilder addParameter:kCMISBrowserJSONParameterSuccinct value:kCMISParameterValueTrue];
+    objectUrl = objectUrlBuilder.urlString;
     
     CMISRequest *cmisRequest = [[CMISRequest alloc] init];
     
@@ -128,14 +133,16 @@
     } else {
         checkedOutUrl = [self retrieveRepositoryUrlWithSelector:kCMISBrowserJSONSelectorCheckedout];
     }
-    checkedOutUrl = [CMISURLUtil urlStringByAppendingParameter:kCMISParameterFilter value:filter urlString:checkedOutUrl];
-    checkedOutUrl = [CMISURLUtil urlStringByAppendingParameter:kCMISParameterOrderBy value:orderBy urlString:checkedOutUrl];
-    checkedOutUrl = [CMISURLUtil urlStringByAppendingParameter:kCMISParameterIncludeAllowableActions boolValue:includeAllowableActions urlString:checkedOutUrl];
-    checkedOutUrl = [CMISURLUtil urlStringByAppendingParameter:kCMISParameterIncludeRelationships value:[CMISEnums stringForIncludeRelationShip:relationships] urlString:checkedOutUrl];
-    checkedOutUrl = [CMISURLUtil urlStringByAppendingParameter:kCMISParameterRenditionFilter value:renditionFilter urlString:checkedOutUrl];
-    checkedOutUrl = [CMISURLUtil urlStringByAppendingParameter:kCMISParameterMaxItems numberValue:maxItems urlString:checkedOutUrl];
-    checkedOutUrl = [CMISURLUtil urlStringByAppendingParameter:kCMISParameterSkipCount numberValue:skipCount urlString:checkedOutUrl];
-    checkedOutUrl = [CMISURLUtil urlStringByAppendingParameter:kCMISBrowserJSONParameterSuccinct value:kCMISParameterValueTrue urlString:checkedOutUrl];
+    CMISURLBuilder *checkedOutUrlBuilder = [CMISURLBuilder builderWithUrlString:checkedOutUrl];
+    [checkedOutUrlBuilder addParameter:kCMISParameterFilter value:filter];
+    [checkedOutUrlBuilder addParameter:kCMISParameterOrderBy value:orderBy];
+    [checkedOutUrlBuilder addParameter:kCMISParameterIncludeAllowableActions boolValue:includeAllowableActions];
+    [checkedOutUrlBuilder addParameter:kCMISParameterIncludeRelationships value:[CMISEnums stringForIncludeRelationShip:relationships]];
+    [checkedOutUrlBuilder addParameter:kCMISParameterRenditionFilter value:renditionFilter];
+    [checkedOutUrlBuilder addParameter:kCMISParameterMaxItems numberValue:maxItems];
+    [checkedOutUrlBuilder addParameter:kCMISParameterSkipCount numberValue:skipCount];
+    [checkedOutUrlBuilder addParameter:kCMISBrowserJSONParameterSuccinct value:kCMISParameterValueTrue];
+    checkedOutUrl = checkedOutUrlBuilder.urlString;
     
     CMISRequest *cmisRequest = [[CMISRequest alloc] init];
     
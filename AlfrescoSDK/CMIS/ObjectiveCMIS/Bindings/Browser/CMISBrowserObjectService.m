@@ -24,7 +24,9 @@
 #import "CMISBrowserUtil.h"
 #import "CMISBrowserConstants.h"
 #import "CMISURLUtil.h"
-#import "CMISFileUtil.h"
+#import "CMISURLBuilder.h"
+#import "CMISContentSource.h"
+#import "CMISBrowserBaseService+Protected.h"
 #import "CMISErrors.h"
 #import "CMISLog.h"
 #import "CMISBroswerFormDataWriter.h"
@@ -42,13 +44,15 @@
                completionBlock:(void (^)(CMISObjectData *objectData, NSError *error))completionBlock
 {
     NSString *objectUrl = [self retrieveObjectUrlForObjectWithId:objectId selector:kCMISBrowserJSONSelectorObject];
-    objectUrl = [CMISURLUtil urlStringByAppendingParameter:kCMISParameterFilter value:filter urlString:objectUrl];
-    objectUrl = [CMISURLUtil urlStringByAppendingParameter:kCMISParameterIncludeAllowableActions boolValue:includeAllowableActions urlString:objectUrl];
-    objectUrl = [CMISURLUtil urlStringByAppendingParameter:kCMISParameterIncludeRelationships value:[CMISEnums stringForIncludeRelationShip:relationships] urlString:objectUrl];
-    objectUrl = [CMISURLUtil urlStringByAppendingParameter:kCMISParameterRenditionFilter value:renditionFilter urlString:objectUrl];
-    objectUrl = [CMISURLUtil urlStringByAppendingParameter:kCMISParameterIncludePolicyIds boolValue:includePolicyIds urlString:objectUrl];
-    objectUrl = [CMISURLUtil urlStringByAppendingParameter:kCMISParameterIncludeAcl boolValue:includeACL urlString:objectUrl];
-    objectUrl = [CMISURLUtil urlStringByAppendingParameter:kCMISBrowserJSONParameterSuccinct value:kCMISParameterValueTrue urlString:objectUrl];
+    CMISURLBuilder *objectUrlBuilder = [CMISURLBuilder builderWithUrlString:objectUrl];
+    [objectUrlBuilder addParameter:kCMISParameterFilter value:filter];
+    [objectUrlBuilder addParameter:kCMISParameterIncludeAllowableActions boolValue:includeAllowableActions];
+    [objectUrlBuilder addParameter:kCMISParameterIncludeRelationships value:[CMISEnums stringForIncludeRelationShip:relationships]];
+    [objectUrlBuilder addParameter:kCMISParameterRenditionFilter value:renditionFilter];
+    [objectUrlBuilder addParameter:kCMISParameterIncludePolicyIds boolValue:includePolicyIds];
+    [objectUrlBuilder addParameter:kCMISParameterIncludeAcl boolValue:includeACL];
+    [objectUrlBuilder addParameter:kCMISBrowserJSONParameterSuccinct value:kCMISParameterValueTrue];
+    objectUrl = objectUrlBuilder.urlString;
     
     CMISRequest *cmisRequest = [[CMISRequest alloc] init];
     
@@ -84,13 +88,15 @@
                      completionBlock:(void (^)(CMISObjectData *objectData, NSError *error))completionBlock
 {
     NSString *objectUrl = [self retrieveObjectUrlForObjectWithPath:path selector:kCMISBrowserJSONSelectorObject];
-    objectUrl = [CMISURLUtil urlStringByAppendingParameter:kCMISParameterFilter value:filter urlString:objectUrl];
-    objectUrl = [CMISURLUtil urlStringByAppendingParameter:kCMISParameterIncludeAllowableActions boolValue:includeAllowableActions urlString:objectUrl];
-    objectUrl = [CMISURLUtil urlStringByAppendingParameter:kCMISParameterIncludeRelationships value:[CMISEnums stringForIncludeRelationShip:relationships] urlString:objectUrl];
-    objectUrl = [CMISURLUtil urlStringByAppendingParameter:kCMISParameterRenditionFilter value:renditionFilter urlString:objectUrl];
-    objectUrl = [CMISURLUtil urlStringByAppendingParameter:kCMISParameterIncludePolicyIds boolValue:includePolicyIds urlString:objectUrl];
-    objectUrl = [CMISURLUtil urlStringByAppendingParameter:kCMISParameterIncludeAcl boolValue:includeACL urlString:objectUrl];
-    objectUrl = [CMISURLUtil urlStringByAppendingParameter:kCMISBrowserJSONParameterSuccinct value:kCMISParameterValueTrue urlString:objectUrl];
+    CMISURLBuilder *objectUrlBuilder = [CMISURLBuilder builderWithUrlString:objectUrl];
+    [objectUrlBuilder addParameter:kCMISParameterFilter value:filter];
+    [objectUrlBuilder addParameter:kCMISParameterIncludeAllowableActions boolValue:includeAllowableActions];
+    [objectUrlBuilder addParameter:kCMISParameterIncludeRelationships value:[CMISEnums stringForIncludeRelationShip:relationships]];
+    [objectUrlBuilder addParameter:kCMISParameterRenditionFilter value:renditionFilter];
+    [objectUrlBuilder addParameter:kCMISParameterIncludePolicyIds boolValue:includePolicyIds];
+    [objectUrlBuilder addParameter:kCMISParameterIncludeAcl boolValue:includeACL];
+    [objectUrlBuilder addParameter:kCMISBrowserJSONParameterSuccinct value:kCMISParameterValueTrue];
+    objectUrl = objectUrlBuilder.urlString;
     
     CMISRequest *cmisRequest = [[CMISRequest alloc] init];
     
@@ -126,9 +132,11 @@
     
     NSString *rootUrl = [self.bindingSession objectForKey:kCMISBrowserBindingSessionKeyRootFolderUrl];
     
-    NSString *contentUrl = [CMISURLUtil urlStringByAppendingParameter:kCMISParameterStreamId value:streamId urlString:rootUrl];
-    contentUrl = [CMISURLUtil urlStringByAppendingParameter:kCMISParameterObjectId value:objectId urlString:contentUrl];
-    contentUrl = [CMISURLUtil urlStringByAppendingParameter:kCMISBrowserJSONParameterSelector value:kCMISBrowserJSONSelectorContent urlString:contentUrl];
+    CMISURLBuilder *contentUrlBuilder = [CMISURLBuilder builderWithUrlString:rootUrl];
+    [contentUrlBuilder addParameter:kCMISParameterStreamId value:streamId];
+    [contentUrlBuilder addParameter:kCMISParameterObjectId value:objectId];
+    [contentUrlBuilder addParameter:kCMISBrowserJSONParameterSelector value:kCMISBrowserJSONSelectorContent];
+    NSString *contentUrl = contentUrlBuilder.urlString;
     
     [self.bindingSession.networkProvider invoke:[NSURL URLWithString:contentUrl]
                                      httpMethod:HTTP_GET
@@ -195,9 +203,11 @@
     
     NSString *rootUrl = [self.bindingSession objectForKey:kCMISBrowserBindingSessionKeyRootFolderUrl];
     
-    NSString *contentUrl = [CMISURLUtil urlStringByAppendingParameter:kCMISParameterStreamId value:streamId urlString:rootUrl];
-    contentUrl = [CMISURLUtil urlStringByAppendingParameter:kCMISParameterObjectId value:objectId urlString:contentUrl];
-    contentUrl = [CMISURLUtil urlStringByAppendingParameter:kCMISBrowserJSONParameterSelector value:kCMISBrowserJSONSelectorContent urlString:contentUrl];
+    CMISURLBuilder *contentUrlBuilder = [CMISURLBuilder builderWithUrlString:rootUrl];
+    [contentUrlBuilder addParameter:kCMISParameterStreamId value:streamId];
+    [contentUrlBuilder addParameter:kCMISParameterObjectId value:objectId];
+    [contentUrlBuilder addParameter:kCMISBrowserJSONParameterSelector value:kCMISBrowserJSONSelectorContent];
+    NSString *contentUrl = contentUrlBuilder.urlString;
 
     [self.bindingSession.networkProvider invoke:[NSURL URLWithString:contentUrl]
                                   httpMethod:HTTP_GET
@@ -272,29 +282,27 @@
                       completionBlock:(void (^)(NSError *error))completionBlock
                         progressBlock:(void (^)(unsigned long long bytesUploaded, unsigned long long bytesTotal))progressBlock
 {
-    NSInputStream *inputStream = [NSInputStream inputStreamWithFileAtPath:filePath];
-    if (inputStream == nil) {
-        CMISLogError(@"Could not find file %@", filePath);
+    NSError *fileError = nil;
+    CMISContentSource *contentSource = [CMISContentSource contentSourceWithFileAtPath:filePath error:&fileError];
+    if (contentSource == nil) {
+        CMISLogError(@"Could not read file %@: %@", filePath, fileError);
         if (completionBlock) {
-            completionBlock([CMISErrors createCMISErrorWithCode:kCMISErrorCodeInvalidArgument detailedDescription:nil]);
+            completionBlock(fileError);
         }
         return nil;
     }
     
-    NSError *fileError = nil;
-    unsigned long long fileSize = [CMISFileUtil fileSizeForFileAtPath:filePath error:&fileError];
-    if (fileError) {
-        CMISLogError(@"Could not determine size of file %@: %@", filePath, [fileError description]);
-    }
-    
     return [self changeContentOfObject:objectIdParam
-                toContentOfInputStream:inputStream
-                         bytesExpected:fileSize
+                       toContentSource:contentSource
                               filename:[filePath lastPathComponent]
                               mimeType:mimeType
                      overwriteExisting:overwrite
                            changeToken:changeTokenParam
-                       completionBlock:completionBlock
+             objectDataCompletionBlock:^(CMISObjectData *objectData, NSError *error) {
+                 if (completionBlock) {
+                     completionBlock(error);
+                 }
+             }
                          progressBlock:progressBlock];
 }
 
@@ -307,18 +315,63 @@
                           changeToken:(CMISStringInOutParameter *)changeToken
                       completionBlock:(void (^)(NSError *error))completionBlock
                         progressBlock:(void (^)(unsigned long long bytesUploaded, unsigned long long bytesTotal))progressBlock
+{
+    return [self changeContentOfObject:objectId
+                toContentOfInputStream:inputStream
+                         bytesExpected:bytesExpected
+                              filename:filename
+                              mimeType:mimeType
+                     overwriteExisting:overwrite
+                           changeToken:changeToken
+             objectDataCompletionBlock:^(CMISObjectData *objectData, NSError *error) {
+                 if (completionBlock) {
+                     completionBlock(error);
+                 }
+             }
+                         progressBlock:progressBlock];
+}
+
+- (CMISRequest*)changeContentOfObject:(CMISStringInOutParameter *)objectId
+               toContentOfInputStream:(NSInputStream *)inputStream
+                        bytesExpected:(unsigned long long)bytesExpected
+                             filename:(NSString *)filename
+                             mimeType:(NSString *)mimeType
+                    overwriteExisting:(BOOL)overwrite
+                          changeToken:(CMISStringInOutParameter *)changeToken
+            objectDataCompletionBlock:(void (^)(CMISObjectData *objectData, NSError *error))completionBlock
+                        progressBlock:(void (^)(unsigned long long bytesUploaded, unsigned long long bytesTotal))progressBlock
+{
+    return [self changeContentOfObject:objectId
+                       toContentSource:(inputStream ? [CMISContentSource contentSourceWithInputStream:inputStream length:bytesExpected] : nil)
+                              filename:filename
+                              mimeType:mimeType
+                     overwriteExisting:overwrite
+                           changeToken:changeToken
+             objectDataCompletionBlock:completionBlock
+                         progressBlock:progressBlock];
+}
+
+- (CMISRequest*)changeContentOfObject:(CMISStringInOutParameter *)objectId
+                      toContentSource:(CMISContentSource *)contentSource
+                             filename:(NSString *)filename
+                             mimeType:(NSString *)mimeType
+                    overwriteExisting:(BOOL)overwrite
+                          changeToken:(CMISStringInOutParameter *)changeToken
+            objectDataCompletionBlock:(void (^)(CMISObjectData *objectData, NSError *error))completionBlock
+                        progressBlock:(void (^)(unsigned long long bytesUploaded, unsigned long long bytesTotal))progressBlock
 {
     // we need an object id
     if ((objectId.inParameter == nil) || (objectId.inParameter.length == 0)) {
-        completionBlock([CMISErrors createCMISErrorWithCode:kCMISErrorCodeInvalidArgument
-                                        detailedDescription:@"Object id must be set!"]);
+        completionBlock(nil, [CMISErrors createCMISErrorWithCode:kCMISErrorCodeInvalidArgument
+                                             detailedDescription:@"Object id must be set!"]);
+        return nil;
     }
     
     // Validate mimetype
-    if (inputStream && !mimeType) {
+    if (contentSource && !mimeType) {
         CMISLogError(@"Must provide a mimetype when creating a cmis document");
         if (completionBlock) {
-            completionBlock([CMISErrors createCMISErrorWithCode:kCMISErrorCodeInvalidArgument detailedDescription:nil]);
+            completionBlock(nil, [CMISErrors createCMISErrorWithCode:kCMISErrorCodeInvalidArgument detailedDescription:nil]);
         }
         return nil;
     }
@@ -327,7 +380,7 @@
     NSString *objectUrl = [self retrieveObjectUrlForObjectWithId:objectId.inParameter];
     
     // prepare form data
-    CMISBroswerFormDataWriter *formData = [[CMISBroswerFormDataWriter alloc] initWithAction:kCMISBrowserJSONActionSetContent contentStream:inputStream mediaType:mimeType];
+    CMISBroswerFormDataWriter *formData = [[CMISBroswerFormDataWriter alloc] initWithAction:kCMISBrowserJSONActionSetContent contentSource:contentSource mediaType:mimeType];
     [formData setFileName:filename];
     [formData addParameter:kCMISParameterOverwriteFlag boolValue:overwrite];
     [formData addParameter:kCMISParameterChangeToken value:changeToken.inParameter];
@@ -337,34 +390,32 @@
     CMISRequest *cmisRequest = [[CMISRequest alloc] init];
     
     // send
-    [self.bindingSession.networkProvider invoke:[NSURL URLWithString:objectUrl]
-                                     httpMethod:HTTP_POST
-                                        session:self.bindingSession
-                                    inputStream:inputStream
-                                        headers:formData.headers
-                                  bytesExpected:bytesExpected
-                                    cmisRequest:cmisRequest
-                                      startData:formData.startData
-                                        endData:formData.endData
-                              useBase64Encoding:NO
-                                completionBlock:^(CMISHttpResponse *httpResponse, NSError *error) {
-                                    if ((httpResponse.statusCode == 200 || httpResponse.statusCode == 201) && httpResponse.data) {
-                                        CMISBrowserTypeCache *typeCache = [[CMISBrowserTypeCache alloc] initWithRepositoryId:self.bindingSession.repositoryId bindingService:self];
-                                        [CMISBrowserUtil objectDataFromJSONData:httpResponse.data typeCache:typeCache completionBlock:^(CMISObjectData *objectData, NSError *error) {
-                                            if (error) {
-                                                completionBlock(error);
-                                            } else {
-                                                objectId.outParameter = objectData.identifier;
-                                                changeToken.outParameter = objectData.properties.propertiesDictionary[kCMISPropertyChangeToken];
+    [self uploadContentSource:contentSource
+                        toUrl:[NSURL URLWithString:objectUrl]
+                   httpMethod:HTTP_POST
+                      headers:formData.headers
+                    startData:formData.startData
+                      endData:formData.endData
+            useBase64Encoding:NO
+                  cmisRequest:cmisRequest
+              completionBlock:^(CMISHttpResponse *httpResponse, NSError *error) {
+                  if ((httpResponse.statusCode == 200 || httpResponse.statusCode == 201) && httpResponse.data) {
+                      CMISBrowserTypeCache *typeCache = [[CMISBrowserTypeCache alloc] initWithRepositoryId:self.bindingSession.repositoryId bindingService:self];
+                      [CMISBrowserUtil objectDataFromJSONData:httpResponse.data typeCache:typeCache completionBlock:^(CMISObjectData *objectData, NSError *error) {
+                          if (error) {
+                              completionBlock(nil, error);
+                          } else {
+                              objectId.outParameter = objectData.identifier;
+                              changeToken.outParameter = [objectData.properties propertyValueForId:kCMISPropertyChangeToken];
                                                 
-                                                completionBlock(nil);
-                                            }
-                                        }];
-                                    } else {
-                                        completionBlock(error);
-                                    }
-                                }
-                                  progressBlock:progressBlock];
+                              completionBlock(objectData, nil);
+                          }
+                      }];
+                  } else {
+                      completionBlock(nil, error);
+                  }
+              }
+                progressBlock:progressBlock];
     return cmisRequest;
 }
 
@@ -375,29 +426,22 @@
                            completionBlock:(void (^)(NSString *objectId, NSError *error))completionBlock
                              progressBlock:(void (^)(unsigned long long bytesUploaded, unsigned long long bytesTotal))progressBlock
 {
-    NSInputStream *inputStream = [NSInputStream inputStreamWithFileAtPath:filePath];
-    if (inputStream == nil) {
-        CMISLogError(@"Could not find file %@", filePath);
+    NSError *fileError = nil;
+    CMISContentSource *contentSource = [CMISContentSource contentSourceWithFileAtPath:filePath error:&fileError];
+    if (contentSource == nil) {
+        CMISLogError(@"Could not read file %@: %@", filePath, fileError);
         if (completionBlock) {
-            completionBlock(nil, [CMISErrors createCMISErrorWithCode:kCMISErrorCodeInvalidArgument
-                                                 detailedDescription:@"Invalid file"]);
+            completionBlock(nil, fileError);
         }
         return nil;
     }
     
-    NSError *fileError = nil;
-    unsigned long long bytesExpected = [CMISFileUtil fileSizeForFileAtPath:filePath error:&fileError];
-    if (fileError) {
-        CMISLogError(@"Could not determine size of file %@: %@", filePath, [fileError description]);
-    }
-    
-    return [self createDocumentFromInputStream:inputStream
-                                      mimeType:mimeType
-                                    properties:properties
-                                      inFolder:folderObjectId
-                                 bytesExpected:bytesExpected
-                               completionBlock:completionBlock
-                                 progressBlock:progressBlock];
+    return [self createDocumentFromContentSource:contentSource
+                                        mimeType:mimeType
+                                      properties:properties
+                                        inFolder:folderObjectId
+                                 completionBlock:completionBlock
+                                   progressBlock:progressBlock];
 }
 
 - (CMISRequest*)createDocumentFromInputStream:(NSInputStream *)inputStream
@@ -407,6 +451,21 @@
                                 bytesExpected:(unsigned long long)bytesExpected // optional
                               completionBlock:(void (^)(NSString *objectId, NSError *error))completionBlock
                                 progressBlock:(void (^)(unsigned long long bytesUploaded, unsigned long long bytesTotal))progressBlock
+{
+    return [self createDocumentFromContentSource:(inputStream ? [CMISContentSource contentSourceWithInputStream:inputStream length:bytesExpected] : nil)
+                                        mimeType:mimeType
+                                      properties:properties
+                                        inFolder:folderObjectId
+                                 completionBlock:completionBlock
+                                   progressBlock:progressBlock];
+}
+
+- (CMISRequest*)createDocumentFromContentSource:(CMISContentSource *)contentSource
+                                       mimeType:(NSString *)mimeType
+                                     properties:(CMISProperties *)properties
+                                       inFolder:(NSString *)folderObjectId
+                                completionBlock:(void (^)(NSString *objectId, NSError *error))completionBlock
+                                  progressBlock:(void (^)(unsigned long long bytesUploaded, unsigned long long bytesTotal))progressBlock
 {
     // Validate properties
     if ([properties propertyValueForId:kCMISPropertyName] == nil || [properties propertyValueForId:kCMISPropertyObjectTypeId] == nil) {
@@ -418,7 +477,7 @@
     }
     
     // Validate mimetype
-    if (inputStream && !mimeType) {
+    if (contentSource && !mimeType) {
         CMISLogError(@"Must provide a mimetype when creating a cmis document");
         if (completionBlock) {
             completionBlock(nil, [CMISErrors createCMISErrorWithCode:kCMISErrorCodeInvalidArgument detailedDescription:nil]);
@@ -430,7 +489,7 @@
     NSString *folderObjectUrl = (folderObjectId != nil ? [self retrieveObjectUrlForObjectWithId:folderObjectId] : [self retrieveRepositoryUrl]);
     
     // prepare form data
-    CMISBroswerFormDataWriter *formData = [[CMISBroswerFormDataWriter alloc] initWithAction:kCMISBrowserJSONActionCreateDocument contentStream:inputStream mediaType:mimeType];
+    CMISBroswerFormDataWriter *formData = [[CMISBroswerFormDataWriter alloc] initWithAction:kCMISBrowserJSONActionCreateDocument contentSource:contentSource mediaType:mimeType];
     [formData addPropertiesParameters:properties];
     // TODO [formData addParameter:kCMISParameterVersioningState value:versioningState];
     // TODO [formData addPoliciesParameters:policies];
@@ -457,19 +516,17 @@
     };
     
     // send
-    if (inputStream) {
-        [self.bindingSession.networkProvider invoke:[NSURL URLWithString:folderObjectUrl]
-                                         httpMethod:HTTP_POST
-                                            session:self.bindingSession
-                                        inputStream:inputStream
-                                            headers:formData.headers
-                                      bytesExpected:bytesExpected
-                                        cmisRequest:cmisRequest
-                                          startData:formData.startData
-                                            endData:formData.endData
-                                  useBase64Encoding:NO
-                                    completionBlock:responseHandlingBlock
-                                      progressBlock:progressBlock];
+    if (contentSource) {
+        [self uploadContentSource:contentSource
+                            toUrl:[NSURL URLWithString:folderObjectUrl]
+                       httpMethod:HTTP_POST
+                          headers:formData.headers
+                        startData:formData.startData
+                          endData:formData.endData
+                useBase64Encoding:NO
+                      cmisRequest:cmisRequest
+                  completionBlock:responseHandlingBlock
+                    progressBlock:progressBlock];
     } else {
         [self.bindingSession.networkProvider invokePOST:[NSURL URLWithString:folderObjectUrl]
                                                 session:self.bindingSession
@@ -696,9 +753,11 @@
                    completionBlock:(void (^)(NSArray *renditions, NSError *error))completionBlock
 {
     NSString *objectUrl = [self retrieveObjectUrlForObjectWithId:objectId selector:kCMISBrowserJSONSelectorRenditions];
-    objectUrl = [CMISURLUtil urlStringByAppendingParameter:kCMISParameterRenditionFilter value:renditionFilter urlString:objectUrl];
-    objectUrl = [CMISURLUtil urlStringByAppendingParameter:kCMISParameterMaxItems value:[maxItems stringValue] urlString:objectUrl];
-    objectUrl = [CMISURLUtil urlStringByAppendingParameter:kCMISParameterSkipCount value:[skipCount stringValue] urlString:objectUrl];
+    CMISURLBuilder *objectUrlBuilder = [CMISURLBuilder builderWithUrlString:objectUrl];
+    [objectUrlBuilder addParameter:kCMISParameterRenditionFilter value:renditionFilter];
+    [objectUrlBuilder addParameter:kCMISParameterMaxItems value:[maxItems stringValue]];
+    [objectUrlBuilder addParameter:kCMISParameterSkipCount value:[skipCount stringValue]];
+    objectUrl = objectUrlBuilder.urlString;
     
     CMISRequest *cmisRequest = [[CMISRequest alloc] init];
     
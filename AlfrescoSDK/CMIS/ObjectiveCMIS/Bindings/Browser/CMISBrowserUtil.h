@@ -46,6 +46,11 @@
  */
 + (void)objectListFromJSONData:(NSData *)jsonData typeCache:(CMISBrowserTypeCache *)typeCache isQueryResult:(BOOL)isQueryResult completionBlock:(void(^)(CMISObjectList *objectList, NSError *error))completionBlock;
 
+/**
+ Returns a CMISObjectList object of content changes and the change log token to continue from, parsed from the given JSON data.
+ */
++ (void)contentChangesFromJSONData:(NSData *)jsonData typeCache:(CMISBrowserTypeCache *)typeCache completionBlock:(void(^)(CMISObjectList *objectList, NSString *changeLogToken, NSError *error))completionBlock;
+
 /**
  Returns an array of CMISRenditionData objects, parsed from the given JSON data.
  */
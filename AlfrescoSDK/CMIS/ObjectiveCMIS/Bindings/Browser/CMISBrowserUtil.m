@@ -36,6 +36,7 @@
 #import "CMISAce.h"
 #import "CMISPrincipal.h"
 #import "CMISAllowableActions.h"
+#import "CMISChangeEventInfo.h"
 
 NSString * const kCMISBrowserMinValueAlfrescoJSONProperty = @"\"minValue\":0.0000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000049,";
 NSString * const kCMISBrowserMinValueECMJSONProperty = @"\"minValue\":-179769313486231570000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000,";
@@ -261,52 +262,76 @@ NSString * const kCMISBrowserMaxValueECMJSONProperty = @"\"maxValue\":1797693134
     NSError *serialisationError = nil;
     id jsonDictionary = [NSJSONSerialization JSONObjectWithData:jsonData options:0 error:&serialisationError];
     
-    CMISObjectList *objectList = nil;
     if (!serialisationError) {
-        // parse the json into a CMISObjectList object
-        objectList = [CMISObjectList new];
-        
-        // parse the objects
-        NSArray *objectsArray;
-        if ([jsonDictionary isKindOfClass:NSArray.class]){
-            objectsArray = jsonDictionary;
-            
-            objectList.hasMoreItems = NO;
-            objectList.numItems = (int)objectsArray.count;
-        } else { // is NSDictionary
-            if (isQueryResult) {
-                objectsArray = [jsonDictionary cmis_objectForKeyNotNull:kCMISBrowserJSONResults];
-            } else {
-                objectsArray = [jsonDictionary cmis_objectForKeyNotNull:kCMISBrowserJSONObjects];
-            }
-            // retrieve the paging data
-            objectList.hasMoreItems = [jsonDictionary cmis_boolForKey:kCMISBrowserJSONHasMoreItems];
-            objectList.numItems = [jsonDictionary cmis_intForKey:kCMISBrowserJSONNumberItems];
+        [CMISBrowserUtil objectListFromJSONObject:jsonDictionary typeCache:typeCache isQueryResult:isQueryResult completionBlock:completionBlock];
+    } else {
+        completionBlock(nil, [CMISErrors cmisError:serialisationError cmisErrorCode:kCMISErrorCodeRuntime]);
+    }
+}
+
++ (void)contentChangesFromJSONData:(NSData *)jsonData typeCache:(CMISBrowserTypeCache *)typeCache completionBlock:(void(^)(CMISObjectList *objectList, NSString *changeLogToken, NSError *error))completionBlock
+{
+    // parse the JSON response
+    NSError *serialisationError = nil;
+    id jsonDictionary = [NSJSONSerialization JSONObjectWithData:jsonData options:0 error:&serialisationError];
+    
+    if (!serialisationError) {
+        NSString *changeLogToken = nil;
+        if ([jsonDictionary isKindOfClass:NSDictionary.class]) {
+            changeLogToken = [jsonDictionary cmis_objectForKeyNotNull:kCMISBrowserJSONChangeLogToken];
         }
         
-        [CMISBrowserUtil convertObjects:objectsArray typeCache:typeCache completionBlock:^(NSArray *objects, NSError *error) {
-            if (error){
-                completionBlock(nil, error);
-            } else {
-                // pass objects to list
-                objectList.objects = objects;
-                
-                // handle extension data
-                if([jsonDictionary isKindOfClass:NSDictionary.class]) {
-                    if (isQueryResult) {
-                        objectList.extensions = [CMISObjectConverter convertExtensions:jsonDictionary cmisKeys:[CMISBrowserConstants queryResultListKeys]];
-                    } else {
-                        objectList.extensions = [CMISObjectConverter convertExtensions:jsonDictionary cmisKeys:[CMISBrowserConstants objectListKeys]];
-                    }
-                }
-                completionBlock(objectList, nil);
-            }
+        [CMISBrowserUtil objectListFromJSONObject:jsonDictionary typeCache:typeCache isQueryResult:NO completionBlock:^(CMISObjectList *objectList, NSError *error) {
+            completionBlock(objectList, changeLogToken, error);
         }];
     } else {
-        completionBlock(nil, [CMISErrors cmisError:serialisationError cmisErrorCode:kCMISErrorCodeRuntime]);
+        completionBlock(nil, nil, [CMISErrors cmisError:serialisationError cmisErrorCode:kCMISErrorCodeRuntime]);
     }
 }
 
++ (void)objectListFromJSONObject:(id)jsonDictionary typeCache:(CMISBrowserTypeCache *)typeCache isQueryResult:(BOOL)isQueryResult completionBlock:(void(^)(CMISObjectList *objectList, NSError *error))completionBlock
+{
+    // parse the json into a CMISObjectList object
+    CMISObjectList *objectList = [CMISObjectList new];
+    
+    // parse the objects
+    NSArray *objectsArray;
+    if ([jsonDictionary isKindOfClass:NSArray.class]){
+        objectsArray = jsonDictionary;
+        
+        objectList.hasMoreItems = NO;
+        objectList.numItems = (int)objectsArray.count;
+    } else { // is NSDictionary
+        if (isQueryResult) {
+            objectsArray = [jsonDictionary cmis_objectForKeyNotNull:kCMISBrowserJSONResults];
+        } else {
+            objectsArray = [jsonDictionary cmis_objectForKeyNotNull:kCMISBrowserJSONObjects];
+        }
+        // retrieve the paging data
+        objectList.hasMoreItems = [jsonDictionary cmis_boolForKey:kCMISBrowserJSONHasMoreItems];
+        objectList.numItems = [jsonDictionary cmis_intForKey:kCMISBrowserJSONNumberItems];
+    }
+    
+    [CMISBrowserUtil convertObjects:objectsArray typeCache:typeCache completionBlock:^(NSArray *objects, NSError *error) {
+        if (error){
+            completionBlock(nil, error);
+        } else {
+            // pass objects to list
+            objectList.objects = objects;
+            
+            // handle extension data
+            if([jsonDictionary isKindOfClass:NSDictionary.class]) {
+                if (isQueryResult) {
+                    objectList.extensions = [CMISObjectConverter convertExtensions:jsonDictionary cmisKeys:[CMISBrowserConstants queryResultListKeys]];
+                } else {
+                    objectList.extensions = [CMISObjectConverter convertExtensions:jsonDictionary cmisKeys:[CMISBrowserConstants objectListKeys]];
+                }
+            }
+            completionBlock(objectList, nil);
+        }
+    }];
+}
+
 + (NSArray *)renditionsFromJSONData:(NSData *)jsonData error:(NSError **)outError
 {
     // TODO: error handling i.e. if jsonData is nil, also handle outError being nil
@@ -413,6 +438,8 @@ NSString * const kCMISBrowserMaxValueECMJSONProperty = @"\"maxValue\":1797693134
     objectData.allowableActions = [CMISBrowserUtil convertAllowableActions:[dictionary cmis_objectForKeyNotNull:kCMISBrowserJSONAllowableActions]];
     
     objectData.isExactAcl = isExactAcl;
+    
+    objectData.changeEventInfo = [CMISBrowserUtil convertChangeEventInfo:[dictionary cmis_objectForKeyNotNull:kCMISBrowserJSONChangeEventInfo]];
 
     // TODO set policyIds
     
@@ -901,6 +928,25 @@ NSString * const kCMISBrowserMaxValueECMJSONProperty = @"\"maxValue\":1797693134
     return result;
 }
 
++ (CMISChangeEventInfo *)convertChangeEventInfo:(NSDictionary *)jsonDictionary
+{
+    if (!jsonDictionary) {
+        return nil;
+    }
+    
+    CMISChangeEventInfo *result = [CMISChangeEventInfo new];
+    result.changeType = [CMISEnums enumForChangeType:[jsonDictionary cmis_objectForKeyNotNull:kCMISBrowserJSONChangeType]];
+    
+    NSNumber *miliseconds = [jsonDictionary cmis_objectForKeyNotNull:kCMISBrowserJSONChangeTime];
+    if ([miliseconds isKindOfClass:NSNumber.class]) {
+        result.changeTime = [NSDate dateWithTimeIntervalSince1970:[miliseconds unsignedLongLongValue] / 1000.0]; // miliseconds to seconds
+    }
+    
+    result.extensions = [CMISObjectConverter convertExtensions:jsonDictionary cmisKeys:[NSSet setWithObjects:kCMISBrowserJSONChangeType, kCMISBrowserJSONChangeTime, nil]];
+    
+    return result;
+}
+
 + (void)retrieveTypeDefinitions:(NSArray *)objectTypeIds position:(NSInteger)position typeCache:(CMISBrowserTypeCache *)typeCache completionBlock:(void (^)(NSMutableArray *typeDefinitions, NSError *error))completionBlock
 {
     [typeCache typeDefinition:[objectTypeIds objectAtIndex:position]
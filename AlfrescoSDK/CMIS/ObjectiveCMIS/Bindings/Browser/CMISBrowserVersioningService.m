@@ -23,10 +23,12 @@
 #import "CMISHttpResponse.h"
 #import "CMISBrowserUtil.h"
 #import "CMISURLUtil.h"
+#import "CMISURLBuilder.h"
 #import "CMISConstants.h"
 #import "CMISErrors.h"
 #import "CMISBroswerFormDataWriter.h"
-#import "CMISFileUtil.h"
+#import "CMISContentSource.h"
+#import "CMISBrowserBaseService+Protected.h"
 #import "CMISLog.h"
 
 @implementation CMISBrowserVersioningService
@@ -42,14 +44,16 @@
                               completionBlock:(void (^)(CMISObjectData *objectData, NSError *error))completionBlock
 {
     NSString *objectUrl = [self retrieveObjectUrlForObjectWithId:objectId selector:kCMISBrowserJSONSelectorObject];
-    objectUrl = [CMISURLUtil urlStringByAppendingParameter:kCMISParameterFilter value:filter urlString:objectUrl];
-    objectUrl = [CMISURLUtil urlStringByAppendingParameter:kCMISParameterIncludeAllowableActions boolValue:includeAllowableActions urlString:objectUrl];
-    objectUrl = [CMISURLUtil urlStringByAppendingParameter:kCMISParameterIncludeRelationships value:[CMISEnums stringForIncludeRelationShip:relationships] urlString:objectUrl];
-    objectUrl = [CMISURLUtil urlStringByAppendingParameter:kCMISParameterRenditionFilter value:renditionFilter urlString:objectUrl];
-    objectUrl = [CMISURLUtil urlStringByAppendingParameter:kCMISParameterIncludePolicyIds boolValue:includePolicyIds urlString:objectUrl];
-    objectUrl = [CMISURLUtil urlStringByAppendingParameter:kCMISParameterIncludeAcl boolValue:includeACL urlString:objectUrl];
-    objectUrl = [CMISURLUtil urlStringByAppendingParameter:kCMISParameterReturnVersion value:[CMISEnums stringForReturnVersion:major] urlString:objectUrl];
-    objectUrl = [CMISURLUtil urlStringByAppendingParameter:kCMISBrowserJSONParameterSuccinct value:kCMISParameterValueTrue urlString:objectUrl];
+    CMISURLBuilder *objectUrlBuilder = [CMISURLBuilder builderWithUrlString:objectUrl];
+    [objectUrlBuilder addParameter:kCMISParameterFilter value:filter];
+    [objectUrlBuilder addParameter:kCMISParameterIncludeAllowableActions boolValue:includeAllowableActions];
+    [objectUrlBuilder addParameter:kCMISParameterIncludeRelationships value:[CMISEnums stringForIncludeRelationShip:relationships]];
+    [objectUrlBuilder addParameter:kCMISParameterRenditionFilter value:renditionFilter];
+    [objectUrlBuilder addParameter:kCMISParameterIncludePolicyIds boolValue:includePolicyIds];
+    [objectUrlBuilder addParameter:kCMISParameterIncludeAcl boolValue:includeACL];
+    [objectUrlBuilder addParameter:kCMISParameterReturnVersion value:[CMISEnums stringForReturnVersion:major]];
+    [objectUrlBuilder addParameter:kCMISBrowserJSONParameterSuccinct value:kCMISParameterValueTrue];
+    objectUrl = objectUrlBuilder.urlString;
     
     CMISRequest *cmisRequest = [[CMISRequest alloc] init];
     
@@ -82,9 +86,11 @@
                     completionBlock:(void (^)(NSArray *objects, NSError *error))completionBlock
 {    
     NSString *objectUrl = [self retrieveObjectUrlForObjectWithId:objectId selector:kCMISBrowserJSONSelectorVersions];
-    objectUrl = [CMISURLUtil urlStringByAppendingParameter:kCMISParameterFilter value:filter urlString:objectUrl];
-    objectUrl = [CMISURLUtil urlStringByAppendingParameter:kCMISParameterIncludeAllowableActions value:(includeAllowableActions ? @"true" : @"false") urlString:objectUrl];
-    objectUrl = [CMISURLUtil urlStringByAppendingParameter:kCMISBrowserJSONParameterSuccinct value:@"true" urlString:objectUrl];
+    CMISURLBuilder *objectUrlBuilder = [CMISURLBuilder builderWithUrlString:objectUrl];
+    [objectUrlBuilder addParameter:kCMISParameterFilter value:filter];
+    [objectUrlBuilder addParameter:kCMISParameterIncludeAllowableActions value:(includeAllowableActions ? @"true" : @"false")];
+    [objectUrlBuilder addParameter:kCMISBrowserJSONParameterSuccinct value:@"true"];
+    objectUrl = objectUrlBuilder.urlString;
     
     CMISRequest *cmisRequest = [[CMISRequest alloc] init];
     
@@ -218,25 +224,19 @@
         completionBlock:(void (^)(CMISObjectData *objectData, NSError *error))completionBlock
           progressBlock:(void (^)(unsigned long long bytesUploaded, unsigned long long bytesTotal))progressBlock
 {
-    NSInputStream *inputStream = [NSInputStream inputStreamWithFileAtPath:filePath];
-    if (inputStream == nil) {
-        CMISLogError(@"Could not find file %@", filePath);
+    NSError *fileError = nil;
+    CMISContentSource *contentSource = [CMISContentSource contentSourceWithFileAtPath:filePath error:&fileError];
+    if (contentSource == nil) {
+        CMISLogError(@"Could not read file %@: %@", filePath, fileError);
         if (completionBlock) {
-            completionBlock(nil, [CMISErrors createCMISErrorWithCode:kCMISErrorCodeInvalidArgument detailedDescription:nil]);
+            completionBlock(nil, fileError);
         }
         return nil;
     }
     
-    NSError *fileError = nil;
-    unsigned long long fileSize = [CMISFileUtil fileSizeForFileAtPath:filePath error:&fileError];
-    if (fileError) {
-        CMISLogError(@"Could not determine size of file %@: %@", filePath, [fileError description]);
-    }
-    
     return [self checkIn:objectId
           asMajorVersion:asMajorVersion
-             inputStream:inputStream
-           bytesExpected:fileSize
+           contentSource:contentSource
                 mimeType:mimeType
               properties:properties
           checkinComment:checkinComment
@@ -266,6 +266,25 @@
          checkinComment:(NSString *)checkinComment
         completionBlock:(void (^)(CMISObjectData *objectData, NSError *error))completionBlock
           progressBlock:(void (^)(unsigned long long bytesUploaded, unsigned long long bytesTotal))progressBlock
+{
+    return [self checkIn:objectId
+          asMajorVersion:asMajorVersion
+           contentSource:(inputStream ? [CMISContentSource contentSourceWithInputStream:inputStream length:bytesExpected] : nil)
+                mimeType:mimeType
+              properties:properties
+          checkinComment:checkinComment
+         completionBlock:completionBlock
+           progressBlock:progressBlock];
+}
+
+- (CMISRequest*)checkIn:(NSString *)objectId
+         asMajorVersion:(BOOL)asMajorVersion
+          contentSource:(CMISContentSource *)contentSource
+               mimeType:(NSString *)mimeType
+             properties:(CMISProperties *)properties
+         checkinComment:(NSString *)checkinComment
+        completionBlock:(void (^)(CMISObjectData *objectData, NSError *error))completionBlock
+          progressBlock:(void (^)(unsigned long long bytesUploaded, unsigned long long bytesTotal))progressBlock
 {
     // we need an object id
     if ((objectId == nil) || (objectId.length == 0)) {
@@ -274,7 +293,7 @@
     }
     
     // Validate mimetype
-    if (inputStream && !mimeType) {
+    if (contentSource && !mimeType) {
         CMISLogError(@"Must provide a mimetype when creating a cmis document");
         if (completionBlock) {
             completionBlock(nil, [CMISErrors createCMISErrorWithCode:kCMISErrorCodeInvalidArgument detailedDescription:nil]);
@@ -286,7 +305,7 @@
     NSString *objectUrl = [self retrieveObjectUrlForObjectWithId:objectId];
     
     // prepare form data
-    CMISBroswerFormDataWriter *formData = [[CMISBroswerFormDataWriter alloc] initWithAction:kCMISBrowserJSONActionCheckIn contentStream:inputStream mediaType:mimeType];
+    CMISBroswerFormDataWriter *formData = [[CMISBroswerFormDataWriter alloc] initWithAction:kCMISBrowserJSONActionCheckIn contentSource:contentSource mediaType:mimeType];
     [formData addParameter:kCMISParameterMajor boolValue:asMajorVersion];
     [formData addPropertiesParameters:properties];
     [formData addParameter:kCMISParameterCheckinComment value:checkinComment];
@@ -300,31 +319,29 @@
     CMISRequest *cmisRequest = [[CMISRequest alloc] init];
     
     // send
-    [self.bindingSession.networkProvider invoke:[NSURL URLWithString:objectUrl]
-                                     httpMethod:HTTP_POST
-                                        session:self.bindingSession
-                                    inputStream:inputStream
-                                        headers:formData.headers
-                                  bytesExpected:bytesExpected
-                                    cmisRequest:cmisRequest
-                                      startData:formData.startData
-                                        endData:formData.endData
-                              useBase64Encoding:NO
-                                completionBlock:^(CMISHttpResponse *httpResponse, NSError *error) {
-                                    if ((httpResponse.statusCode == 200 || httpResponse.statusCode == 201) && httpResponse.data) {
-                                        CMISBrowserTypeCache *typeCache = [[CMISBrowserTypeCache alloc] initWithRepositoryId:self.bindingSession.repositoryId bindingService:self];
-                                        [CMISBrowserUtil objectDataFromJSONData:httpResponse.data typeCache:typeCache completionBlock:^(CMISObjectData *objectData, NSError *error) {
-                                            if (error) {
-                                                completionBlock(nil, error);
-                                            } else {
-                                                completionBlock(objectData, nil);
-                                            }
-                                        }];
-                                    } else {
-                                        completionBlock(nil, error);
-                                    }
-                                }
-                                  progressBlock:progressBlock];
+    [self uploadContentSource:contentSource
+                        toUrl:[NSURL URLWithString:objectUrl]
+                   httpMethod:HTTP_POST
+                      headers:formData.headers
+                    startData:formData.startData
+                      endData:formData.endData
+            useBase64Encoding:NO
+                  cmisRequest:cmisRequest
+              completionBlock:^(CMISHttpResponse *httpResponse, NSError *error) {
+                  if ((httpResponse.statusCode == 200 || httpResponse.statusCode == 201) && httpResponse.data) {
+                      CMISBrowserTypeCache *typeCache = [[CMISBrowserTypeCache alloc] initWithRepositoryId:self.bindingSession.repositoryId bindingService:self];
+                      [CMISBrowserUtil objectDataFromJSONData:httpResponse.data typeCache:typeCache completionBlock:^(CMISObjectData *objectData, NSError *error) {
+                          if (error) {
+                              completionBlock(nil, error);
+                          } else {
+                              completionBlock(objectData, nil);
+                          }
+                      }];
+                  } else {
+                      completionBlock(nil, error);
+                  }
+              }
+                progressBlock:progressBlock];
     return cmisRequest;
 }
 
@@ -36,10 +36,12 @@ extern NSString * const kCMISBindingSessionKeyUrl;
 
 - (id)initWithSessionParameters:(CMISSessionParameters *)sessionParameters;
 
-/// @name Object storage methods
+/// @name Object storage methods, safe to call from any thread
 - (NSArray *)allKeys;
 - (id)objectForKey:(id)key;
 - (id)objectForKey:(id)key defaultValue:(id)defaultValue;
+/// Returns the object stored for the key, creating and storing it with the block if there is none, the block is called at most once per key
+- (id)objectForKey:(id)key createIfAbsentWithBlock:(id (^)(void))createBlock;
 - (void)setObject:(id)object forKey:(id)key;
 - (void)addEntriesFromDictionary:(NSDictionary *)dictionary;
 - (void)removeKey:(id)key;
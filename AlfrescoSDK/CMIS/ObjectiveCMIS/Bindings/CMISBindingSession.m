@@ -18,6 +18,7 @@
  */
 
 #import "CMISBindingSession.h"
+#import "CMISParameterStore.h"
 
 NSString * const kCMISBindingSessionKeyUrl = @"cmis_session_key_url";
 
@@ -27,7 +28,7 @@ NSString * const kCMISBindingSessionKeyUrl = @"cmis_session_key_url";
 @property (nonatomic, strong, readwrite) id<CMISAuthenticationProvider> authenticationProvider;
 @property (nonatomic, strong, readwrite) id<CMISNetworkProvider> networkProvider;
 @property (nonatomic, strong, readwrite) CMISTypeDefinitionCache *typeDefinitionCache;
-@property (nonatomic, strong, readwrite) NSMutableDictionary *sessionData;
+@property (nonatomic, strong, readwrite) CMISParameterStore *sessionData;
 @end
 
 @implementation CMISBindingSession
@@ -37,7 +38,7 @@ NSString * const kCMISBindingSessionKeyUrl = @"cmis_session_key_url";
 {
     self = [super init];
     if (self) {
-        self.sessionData = [[NSMutableDictionary alloc] init];
+        self.sessionData = [[CMISParameterStore alloc] init];
         
         // grab common data from session parameters
         self.username = sessionParameters.username;
@@ -52,10 +53,12 @@ NSString * const kCMISBindingSessionKeyUrl = @"cmis_session_key_url";
             [self.sessionData setObject:sessionParameters.browserUrl forKey:kCMISBindingSessionKeyUrl];
         }
         
-        // store all other data in the dictionary
+        // store all other data in the parameter store
+        NSMutableDictionary *parameters = [NSMutableDictionary dictionary];
         for (id key in sessionParameters.allKeys) {
-            [self.sessionData setObject:[sessionParameters objectForKey:key] forKey:key];
+            [parameters setObject:[sessionParameters objectForKey:key] forKey:key];
         }
+        [self.sessionData addEntriesFromDictionary:parameters];
         
         //set type definition cache after other data stored in the dictionary as the cache size is retrieved from the sessionData in the init method of the CMISTypeDefinitionCache
         if(sessionParameters.typeDefinitionCache == nil) {
@@ -84,6 +87,11 @@ NSString * const kCMISBindingSessionKeyUrl = @"cmis_session_key_url";
     return value != nil ? value : defaultValue;
 }
 
+- (id)objectForKey:(id)key createIfAbsentWithBlock:(id (^)(void))createBlock
+{
+    return [self.sessionData objectForKey:key createIfAbsentWithBlock:createBlock];
+}
+
 - (void)setObject:(id)object forKey:(id)key
 {
     [self.sessionData setObject:object forKey:key];
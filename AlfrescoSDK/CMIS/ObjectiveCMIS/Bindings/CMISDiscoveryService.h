@@ -22,6 +22,7 @@
 
 @class CMISObjectList;
 @class CMISRequest;
+@class CMISStringInOutParameter;
 
 @protocol CMISDiscoveryService <NSObject>
 
@@ -42,4 +43,15 @@
                                                     skipCount:(NSNumber *)skipCount
                                               completionBlock:(void (^)(CMISObjectList *objectList, NSError *error))completionBlock;
 
+/** retrieves the changes recorded in the change log of the repository, starting with the given change log token
+ * (or the beginning of the log when the token is nil). Each object of the returned list has its changeEventInfo set.
+ * On completion changeLogToken holds the token to continue reading the change log from.
+ * completionBlock returns the object list or nil if unsuccessful
+ */
+- (CMISRequest*)retrieveContentChanges:(CMISStringInOutParameter *)changeLogToken
+                     includeProperties:(BOOL)includeProperties
+                                filter:(NSString *)filter
+                              maxItems:(NSNumber *)maxItems
+                       completionBlock:(void (^)(CMISObjectList *objectList, NSError *error))completionBlock;
+
 @end
@@ -25,6 +25,15 @@
 
 @interface CMISLinkCache : NSObject
 
+/// number of lookups answered from the cached links
+@property (nonatomic, assign, readonly) NSUInteger hitCount;
+
+/// number of lookups answered by deriving the link from a learnt URL pattern
+@property (nonatomic, assign, readonly) NSUInteger derivedCount;
+
+/// number of lookups that could not be answered, each one forces the object to be fetched again
+@property (nonatomic, assign, readonly) NSUInteger missCount;
+
 /// initialise with CMISBindingSession instance
 - (id)initWithBindingSession:(CMISBindingSession *)bindingSession;
 
@@ -37,6 +46,9 @@
 /// adds a link for object Id
 - (void)addLinks:(CMISLinkRelations *)links objectId:(NSString *)objectId;
 
+/// adds the links of every CMISObjectData in the given array, e.g. the entries of a feed
+- (void)addLinksForObjects:(NSArray *)objectDataArray;
+
 /// removes link for object Id
 - (void)removeLinksForObjectId:(NSString *)objectId;
 
@@ -45,4 +57,13 @@
  */
 - (void)removeAllLinks;
 
-@end
\ No newline at end of file
+/**
+ * writes the cached links to the file set with kCMISSessionParameterLinkCachePersistencePath.
+ * Returns NO if no path has been set or the file could not be written.
+ */
+- (BOOL)persistLinks;
+
+/// resets the hit, derived and miss counters
+- (void)resetStatistics;
+
+@end
@@ -19,18 +19,107 @@
 
 #import "CMISLinkCache.h"
 #import "CMISBindingSession.h"
+#import "CMISLinkRelations.h"
+#import "CMISAtomLink.h"
+#import "CMISObjectData.h"
+#import "CMISURLUtil.h"
 #import "CMISLog.h"
 
-// Default link cache size is 50 entries
-#define DEFAULT_LINK_CACHE_SIZE 50
+// Default link cache memory limit is 2MB
+#define DEFAULT_LINK_CACHE_MEMORY_LIMIT (2 * 1024 * 1024)
+// Approximate overhead in bytes of each cached object and link, on top of the strings it holds
+#define LINK_CACHE_ENTRY_OVERHEAD 64
+// Number of different objects a URL pattern has to be seen with before links are derived from it
+#define LINK_TEMPLATE_CONFIRMATIONS 2
+// Number of tracked object ids after which ids of evicted objects are pruned
+#define LINK_CACHE_PRUNE_THRESHOLD 1024
 
-@interface CMISLinkCache () <NSCacheDelegate>
+static NSString * const kCMISLinkCachePersistedRel = @"rel";
+static NSString * const kCMISLinkCachePersistedType = @"type";
+static NSString * const kCMISLinkCachePersistedHref = @"href";
+
+/**
+ * A URL pattern learnt from the links of cached objects: the href of a link with the
+ * object id taken out, e.g. "http://host/atom/children?id=" + objectId + "&filter=..."
+ */
+@interface CMISLinkTemplate : NSObject
+@property (nonatomic, strong) NSString *prefix;
+@property (nonatomic, strong) NSString *suffix;
+@property (nonatomic, assign) BOOL encodedObjectId;
+@property (nonatomic, strong) NSString *lastObjectId;
+@property (nonatomic, assign) NSUInteger confirmations;
+@end
+
+@implementation CMISLinkTemplate
+
++ (CMISLinkTemplate *)templateForHref:(NSString *)href objectId:(NSString *)objectId
+{
+    CMISLinkTemplate *template = [self templateForHref:href objectIdString:[CMISURLUtil encodeUrlParameterValue:objectId]];
+    if (template) {
+        template.encodedObjectId = YES;
+    } else {
+        template = [self templateForHref:href objectIdString:objectId];
+    }
+    template.lastObjectId = objectId;
+    template.confirmations = 1;
+    return template;
+}
+
++ (CMISLinkTemplate *)templateForHref:(NSString *)href objectIdString:(NSString *)objectIdString
+{
+    if (objectIdString.length == 0) {
+        return nil;
+    }
+
+    // the object id has to appear exactly once for the pattern to be unambiguous
+    NSRange range = [href rangeOfString:objectIdString];
+    if (range.location == NSNotFound) {
+        return nil;
+    }
+    NSUInteger suffixLocation = NSMaxRange(range);
+    if ([href rangeOfString:objectIdString options:0 range:NSMakeRange(suffixLocation, href.length - suffixLocation)].location != NSNotFound) {
+        return nil;
+    }
+
+    CMISLinkTemplate *template = [[CMISLinkTemplate alloc] init];
+    template.prefix = [href substringToIndex:range.location];
+    template.suffix = [href substringFromIndex:suffixLocation];
+    return template;
+}
+
+- (BOOL)isEqualToTemplate:(CMISLinkTemplate *)template
+{
+    return self.encodedObjectId == template.encodedObjectId &&
+        [self.prefix isEqualToString:template.prefix] &&
+        [self.suffix isEqualToString:template.suffix];
+}
+
+- (NSString *)linkForObjectId:(NSString *)objectId
+{
+    NSString *objectIdString = self.encodedObjectId ? [CMISURLUtil encodeUrlParameterValue:objectId] : objectId;
+    return [NSString stringWithFormat:@"%@%@%@", self.prefix, objectIdString, self.suffix];
+}
+
+@end
+
+
+@interface CMISLinkCache ()
 
 /**
  * Using an NSCache, as it gives us automatic cache cleanup and thread-safe operations
  * https://developer.apple.com/library/mac/#documentation/Cocoa/Reference/NSCache_Class/Reference/Reference.html
  */
 @property (nonatomic, strong) NSCache *linkCache;
+/// ids of the objects added to the cache, some of which may since have been evicted
+@property (nonatomic, strong) NSMutableSet *cachedObjectIds;
+@property (nonatomic, assign) NSUInteger pruneThreshold;
+/// learnt URL patterns keyed by relation, then type (empty string for none); NSNull marks conflicting patterns
+@property (nonatomic, strong) NSMutableDictionary *linkTemplates;
+@property (nonatomic, assign) BOOL deriveLinks;
+@property (nonatomic, strong) NSString *persistencePath;
+@property (nonatomic, assign, readwrite) NSUInteger hitCount;
+@property (nonatomic, assign, readwrite) NSUInteger derivedCount;
+@property (nonatomic, assign, readwrite) NSUInteger missCount;
 
 @end
 
@@ -41,8 +130,11 @@
 {
     self = [super init];
     if (self) {
+        self.cachedObjectIds = [NSMutableSet set];
+        self.pruneThreshold = LINK_CACHE_PRUNE_THRESHOLD;
+        self.linkTemplates = [NSMutableDictionary dictionary];
         [self setupLinkCache:bindingSession];
-
+        [self loadPersistedLinks];
     }
     return self;
 }
@@ -51,55 +143,266 @@
 {
     self.linkCache = [[NSCache alloc] init];
 
+    // the cache is bounded by memory, a count limit is only applied when explicitly requested
     id linkCacheSize = [bindingSession objectForKey:kCMISSessionParameterLinkCacheSize];
     if (linkCacheSize != nil) {
-        if ([[linkCacheSize class] isEqual:[NSNumber class]]) {
+        if ([linkCacheSize isKindOfClass:[NSNumber class]]) {
             self.linkCache.countLimit = [(NSNumber *) linkCacheSize unsignedIntValue];
         } else {
             CMISLogError(@"Invalid object set for %@ session parameter. Ignoring and using default instead", kCMISSessionParameterLinkCacheSize);
         }
     }
 
-    if (self.linkCache.countLimit <= 0) {
-        self.linkCache.countLimit = DEFAULT_LINK_CACHE_SIZE;
+    id memoryLimit = [bindingSession objectForKey:kCMISSessionParameterLinkCacheMemoryLimit];
+    if (memoryLimit != nil) {
+        if ([memoryLimit isKindOfClass:[NSNumber class]]) {
+            self.linkCache.totalCostLimit = [(NSNumber *) memoryLimit unsignedIntegerValue];
+        } else {
+            CMISLogError(@"Invalid object set for %@ session parameter. Ignoring and using default instead", kCMISSessionParameterLinkCacheMemoryLimit);
+        }
     }
 
-    // Uncomment for debugging
-//    self.linkCache.delegate = self;
+    if (self.linkCache.totalCostLimit <= 0) {
+        self.linkCache.totalCostLimit = DEFAULT_LINK_CACHE_MEMORY_LIMIT;
+    }
+
+    self.deriveLinks = [[bindingSession objectForKey:kCMISSessionParameterLinkCacheDeriveLinks defaultValue:@NO] boolValue];
+
+    id persistencePath = [bindingSession objectForKey:kCMISSessionParameterLinkCachePersistencePath];
+    if ([persistencePath isKindOfClass:[NSString class]]) {
+        self.persistencePath = persistencePath;
+    } else if (persistencePath != nil) {
+        CMISLogError(@"Invalid object set for %@ session parameter. Ignoring, links will not be persisted", kCMISSessionParameterLinkCachePersistencePath);
+    }
 }
 
 - (NSString *)linkForObjectId:(NSString *)objectId relation:(NSString *)rel
 {
-    CMISLinkRelations *linkRelations = [self.linkCache objectForKey:objectId];
-    return [linkRelations linkHrefForRel:rel];
+    return [self linkForObjectId:objectId relation:rel type:nil];
 }
 
 - (NSString *)linkForObjectId:(NSString *)objectId relation:(NSString *)rel type:(NSString *)type
 {
     CMISLinkRelations *linkRelations = [self.linkCache objectForKey:objectId];
-    return [linkRelations linkHrefForRel:rel type:type];
+    NSString *link = [linkRelations linkHrefForRel:rel type:type];
+
+    @synchronized(self) {
+        if (link) {
+            self.hitCount++;
+        } else {
+            // only derive links for objects we know nothing about, a cached object without the link simply doesn't have it
+            if (linkRelations == nil && self.deriveLinks) {
+                link = [[self templateForRelation:rel type:type] linkForObjectId:objectId];
+            }
+
+            if (link) {
+                self.derivedCount++;
+            } else {
+                self.missCount++;
+            }
+        }
+    }
+
+    return link;
 }
 
 - (void)addLinks:(CMISLinkRelations *)links objectId:(NSString *)objectId
 {
-    [self.linkCache setObject:links forKey:objectId];
+    if (links == nil || objectId == nil) {
+        return;
+    }
+
+    [self.linkCache setObject:links forKey:objectId cost:[self costOfLinks:links objectId:objectId]];
+
+    @synchronized(self) {
+        [self.cachedObjectIds addObject:objectId];
+        if (self.cachedObjectIds.count > self.pruneThreshold) {
+            [self pruneCachedObjectIds];
+        }
+
+        if (self.deriveLinks) {
+            [self learnTemplatesFromLinks:links objectId:objectId];
+        }
+    }
+}
+
+- (void)addLinksForObjects:(NSArray *)objectDataArray
+{
+    for (CMISObjectData *objectData in objectDataArray) {
+        if (objectData.linkRelations.linkRelationSet.count > 0) {
+            [self addLinks:objectData.linkRelations objectId:objectData.identifier];
+        }
+    }
 }
 
 - (void)removeLinksForObjectId:(NSString *)objectId
 {
     [self.linkCache removeObjectForKey:objectId];
+
+    @synchronized(self) {
+        [self.cachedObjectIds removeObject:objectId];
+    }
 }
 
 - (void)removeAllLinks
 {
     [self.linkCache removeAllObjects];
+
+    @synchronized(self) {
+        [self.cachedObjectIds removeAllObjects];
+    }
+}
+
+- (void)resetStatistics
+{
+    @synchronized(self) {
+        self.hitCount = 0;
+        self.derivedCount = 0;
+        self.missCount = 0;
+    }
+}
+
+- (NSString *)description
+{
+    return [NSString stringWithFormat:@"<%@: %p> hits: %lu, derived: %lu, misses: %lu", NSStringFromClass([self class]), self,
+            (unsigned long)self.hitCount, (unsigned long)self.derivedCount, (unsigned long)self.missCount];
+}
+
+#pragma mark - Cost
+
+- (NSUInteger)costOfLinks:(CMISLinkRelations *)links objectId:(NSString *)objectId
+{
+    NSUInteger cost = LINK_CACHE_ENTRY_OVERHEAD + objectId.length * sizeof(unichar);
+    for (CMISAtomLink *link in links.linkRelationSet) {
+        cost += LINK_CACHE_ENTRY_OVERHEAD + (link.rel.length + link.type.length + link.href.length) * sizeof(unichar);
+    }
+    return cost;
+}
+
+/// removes the ids of objects the cache has evicted, must be called while synchronized
+- (void)pruneCachedObjectIds
+{
+    NSMutableSet *evictedObjectIds = [NSMutableSet set];
+    for (NSString *objectId in self.cachedObjectIds) {
+        if ([self.linkCache objectForKey:objectId] == nil) {
+            [evictedObjectIds addObject:objectId];
+        }
+    }
+    [self.cachedObjectIds minusSet:evictedObjectIds];
+    self.pruneThreshold = MAX(LINK_CACHE_PRUNE_THRESHOLD, self.cachedObjectIds.count * 2);
+}
+
+#pragma mark - Link derivation
+
+/// must be called while synchronized
+- (void)learnTemplatesFromLinks:(CMISLinkRelations *)links objectId:(NSString *)objectId
+{
+    for (CMISAtomLink *link in links.linkRelationSet) {
+        if (link.rel == nil || link.href == nil) {
+            continue;
+        }
+
+        NSMutableDictionary *templatesForRelation = self.linkTemplates[link.rel];
+        if (templatesForRelation == nil) {
+            templatesForRelation = [NSMutableDictionary dictionary];
+            self.linkTemplates[link.rel] = templatesForRelation;
+        }
+
+        NSString *typeKey = link.type ?: @"";
+        id existingTemplate = templatesForRelation[typeKey];
+        if (existingTemplate == [NSNull null]) {
+            continue;
+        }
+
+        // links that don't contain the object id, or whose pattern differs between objects, are never derived
+        CMISLinkTemplate *template = [CMISLinkTemplate templateForHref:link.href objectId:objectId];
+        if (template == nil || (existingTemplate != nil && ![existingTemplate isEqualToTemplate:template])) {
+            templatesForRelation[typeKey] = [NSNull null];
+        } else if (existingTemplate == nil) {
+            templatesForRelation[typeKey] = template;
+        } else if (![[existingTemplate lastObjectId] isEqualToString:objectId]) {
+            [existingTemplate setLastObjectId:objectId];
+            [existingTemplate setConfirmations:[existingTemplate confirmations] + 1];
+        }
+    }
+}
+
+/// must be called while synchronized, mirrors the matching rules of CMISLinkRelations
+- (CMISLinkTemplate *)templateForRelation:(NSString *)rel type:(NSString *)type
+{
+    NSDictionary *templatesForRelation = self.linkTemplates[rel];
+    id template = nil;
+    if (type.length > 0) {
+        template = templatesForRelation[type];
+    } else if (templatesForRelation.count == 1) {
+        template = templatesForRelation.allValues.firstObject;
+    }
+
+    if ([template isKindOfClass:[CMISLinkTemplate class]] && [template confirmations] >= LINK_TEMPLATE_CONFIRMATIONS) {
+        return template;
+    }
+    return nil;
 }
 
+#pragma mark - Persistence
+
+- (void)loadPersistedLinks
+{
+    if (self.persistencePath == nil || ![[NSFileManager defaultManager] fileExistsAtPath:self.persistencePath]) {
+        return;
+    }
 
-// Debugging
-//- (void)cache:(NSCache *)cache willEvictObject:(id)obj
-//{
-//    CMISLogDebug(@"Link cache will evict cached links for object '%@'", obj);
-//}
+    NSDictionary *persistedLinks = [NSDictionary dictionaryWithContentsOfFile:self.persistencePath];
+    if (persistedLinks == nil) {
+        CMISLogError(@"Could not read persisted links from %@", self.persistencePath);
+        return;
+    }
+
+    [persistedLinks enumerateKeysAndObjectsUsingBlock:^(NSString *objectId, NSArray *persistedLinkArray, BOOL *stop) {
+        NSMutableSet *linkRelationSet = [NSMutableSet setWithCapacity:persistedLinkArray.count];
+        for (NSDictionary *persistedLink in persistedLinkArray) {
+            [linkRelationSet addObject:[[CMISAtomLink alloc] initWithRelation:persistedLink[kCMISLinkCachePersistedRel]
+                                                                         type:persistedLink[kCMISLinkCachePersistedType]
+                                                                         href:persistedLink[kCMISLinkCachePersistedHref]]];
+        }
+        [self addLinks:[[CMISLinkRelations alloc] initWithLinkRelationSet:linkRelationSet] objectId:objectId];
+    }];
+    CMISLogDebug(@"Restored links for %lu objects from %@", (unsigned long)persistedLinks.count, self.persistencePath);
+}
+
+- (BOOL)persistLinks
+{
+    if (self.persistencePath == nil) {
+        return NO;
+    }
+
+    NSMutableDictionary *persistedLinks = [NSMutableDictionary dictionary];
+    @synchronized(self) {
+        [self pruneCachedObjectIds];
+        for (NSString *objectId in self.cachedObjectIds) {
+            CMISLinkRelations *linkRelations = [self.linkCache objectForKey:objectId];
+            NSMutableArray *persistedLinkArray = [NSMutableArray arrayWithCapacity:linkRelations.linkRelationSet.count];
+            for (CMISAtomLink *link in linkRelations.linkRelationSet) {
+                if (link.rel && link.href) {
+                    NSMutableDictionary *persistedLink = [NSMutableDictionary dictionaryWithObjectsAndKeys:link.rel, kCMISLinkCachePersistedRel,
+                                                          link.href, kCMISLinkCachePersistedHref, nil];
+                    if (link.type) {
+                        persistedLink[kCMISLinkCachePersistedType] = link.type;
+                    }
+                    [persistedLinkArray addObject:persistedLink];
+                }
+            }
+            if (persistedLinkArray.count > 0) {
+                persistedLinks[objectId] = persistedLinkArray;
+            }
+        }
+    }
+
+    BOOL persisted = [persistedLinks writeToFile:self.persistencePath atomically:YES];
+    if (!persisted) {
+        CMISLogError(@"Could not persist links to %@", self.persistencePath);
+    }
+    return persisted;
+}
 
 @end
\ No newline at end of file
@@ -159,6 +159,25 @@
                       completionBlock:(void (^)(NSError *error))completionBlock
                         progressBlock:(void (^)(unsigned long long bytesUploaded, unsigned long long bytesTotal))progressBlock;
 
+/**
+ * Changes the content of the given document to the content from a given input stream and hands back the updated
+ * object as returned by the repository in the response to the update, avoiding a separate retrieval.
+ *
+ * The object id and change token are sent as given, the object is not fetched beforehand.
+ * If the binding's response does not contain the updated object (e.g. an AtomPub server answering with 204 No Content)
+ * objectData is nil and the caller has to retrieve the object itself.
+ * completionBlock - returns the updated object data (maybe nil) and NSError nil if successful
+ */
+- (CMISRequest*)changeContentOfObject:(CMISStringInOutParameter *)objectId
+               toContentOfInputStream:(NSInputStream *)inputStream
+                        bytesExpected:(unsigned long long)bytesExpected
+                             filename:(NSString *)filename
+                             mimeType:(NSString *)mimeType
+                    overwriteExisting:(BOOL)overwrite
+                          changeToken:(CMISStringInOutParameter *)changeToken
+            objectDataCompletionBlock:(void (^)(CMISObjectData *objectData, NSError *error))completionBlock
+                        progressBlock:(void (^)(unsigned long long bytesUploaded, unsigned long long bytesTotal))progressBlock;
+
 /**
  * uploads the file from the given path to the given folder.
  *
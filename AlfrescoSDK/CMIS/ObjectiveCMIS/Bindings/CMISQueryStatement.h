@@ -39,6 +39,9 @@
  * [qs setStringAtIndex:4 string:@"8, bob, tom, lisa"];
  *
  * NSString *statement = [qs queryString];
+ *
+ * The statement is split at its placeholders once when the object is created, so the same object can be
+ * used like a prepared statement: set new parameters, or clear them, and call queryString again.
  */
 @interface CMISQueryStatement : NSObject
 
@@ -172,6 +175,11 @@
 - (void)setDateTimeAtIndex:(NSUInteger)parameterIndex date:(NSDate*)date;
 
 
+/**
+ * Removes all parameters that have been set.
+ */
+- (void)clearParameters;
+
 /**
  * Returns the query statement.
  *
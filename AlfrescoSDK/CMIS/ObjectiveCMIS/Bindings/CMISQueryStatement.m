@@ -24,6 +24,8 @@ static NSDateFormatter *cmisQueryStatementTimeStampFormatter;
 @interface CMISQueryStatement ()
 
 @property (nonatomic, strong) NSString* statement;
+// the literal parts of the statement around its placeholders, there is one more segment than placeholders
+@property (nonatomic, strong) NSArray *statementSegments;
 @property (nonatomic, strong) NSMutableDictionary *parametersDictionary;
 
 @end
@@ -34,6 +36,7 @@ static NSDateFormatter *cmisQueryStatementTimeStampFormatter;
     self = [super init];
     if (self) {
         self.statement = statement;
+        self.statementSegments = [CMISQueryStatement segmentsOfStatement:statement];
         self.parametersDictionary = [NSMutableDictionary dictionary];
     }
     
@@ -111,103 +114,140 @@ static NSDateFormatter *cmisQueryStatementTimeStampFormatter;
 }
 
 
+- (void)clearParameters {
+    [self.parametersDictionary removeAllObjects];
+}
+
 - (NSString*)queryString {
-    BOOL inStr = false;
+    NSUInteger capacity = self.statement.length;
+    for (NSObject *parameter in self.parametersDictionary.objectEnumerator) {
+        capacity += [parameter isKindOfClass:NSString.class] ? ((NSString *)parameter).length : 20;
+    }
+    NSMutableString *retStr = [NSMutableString stringWithCapacity:capacity];
+    
     NSUInteger parameterIndex = 0;
+    for (NSString *segment in self.statementSegments) {
+        if (parameterIndex > 0) {
+            NSObject *parameter = self.parametersDictionary[@(parameterIndex)];
+            if ([parameter isKindOfClass:NSString.class]) {
+                // Replace placeholder
+                [retStr appendString:(NSString*)parameter];
+            } else if ([parameter isKindOfClass:NSNumber.class]) {
+                [retStr appendString:[(NSNumber*)parameter stringValue]];
+            }
+        }
+        [retStr appendString:segment];
+        parameterIndex++;
+    }
     
-    NSMutableString *retStr = [NSMutableString string];
+    return retStr;
+}
+
+#pragma mark - Statement tokenizing
+
++ (NSArray*)segmentsOfStatement:(NSString*)statement {
+    NSMutableArray *segments = [NSMutableArray array];
+    NSUInteger length = statement.length;
+    unichar *characters = malloc(sizeof(unichar) * MAX(length, 1));
+    [statement getCharacters:characters range:NSMakeRange(0, length)];
     
-    for (NSUInteger i = 0; i < self.statement.length; i++) {
-        unichar c = [self.statement characterAtIndex:i];
+    BOOL inStr = NO;
+    NSUInteger segmentStart = 0;
+    for (NSUInteger i = 0; i < length; i++) {
+        unichar c = characters[i];
         
         if (c == '\'') {
-            if (inStr && [retStr characterAtIndex:i - 1] == '\\') {
-                inStr = true;
-            } else {
+            // an escaped quote does not end the string literal
+            if (!(inStr && i > 0 && characters[i - 1] == '\\')) {
                 inStr = !inStr;
             }
-            [retStr appendString:[NSString stringWithCharacters:&c length:1]];
         } else if (c == '?' && !inStr) {
-            parameterIndex++;
-            NSObject *parameter = self.parametersDictionary[@(parameterIndex)];
-            NSString *paramValue = nil;
-            if ([parameter isKindOfClass:NSString.class]) {
-                paramValue = (NSString*)parameter;
-            } else if ([parameter isKindOfClass:NSNumber.class]) {
-                paramValue = [(NSNumber*)parameter stringValue];
-            }
-            if (paramValue) {
-                // Replace placeholder
-                [retStr appendString:paramValue];
-            }
-        } else {
-            [retStr appendString:[NSString stringWithCharacters:&c length:1]];
+            [segments addObject:[NSString stringWithCharacters:characters + segmentStart length:i - segmentStart]];
+            segmentStart = i + 1;
         }
     }
+    [segments addObject:[NSString stringWithCharacters:characters + segmentStart length:length - segmentStart]];
     
-    return retStr;
+    free(characters);
+    return segments;
 }
 
 #pragma mark - Escaping methods
 
 + (NSString*)escapeString:(NSString*)string withSurroundingQuotes:(BOOL)quotes {
-    NSMutableString *escapedString = [NSMutableString string];
-    [escapedString appendString:quotes ? @"'" : @"" ];
-    for (NSUInteger i = 0; i < string.length; i++) {
+    NSUInteger length = string.length;
+    // worst case every character is escaped
+    unichar *escaped = malloc(sizeof(unichar) * (length * 2 + 2));
+    NSUInteger escapedLength = 0;
+    
+    if (quotes) {
+        escaped[escapedLength++] = '\'';
+    }
+    for (NSUInteger i = 0; i < length; i++) {
         unichar c = [string characterAtIndex:i];
         
         if (c == '\'' || c == '\\') {
-            [escapedString appendString:@"\\"];
+            escaped[escapedLength++] = '\\';
         }
         
-        [escapedString appendString:[NSString stringWithCharacters:&c length:1]];
+        escaped[escapedLength++] = c;
     }
-    
     if (quotes) {
-        [escapedString appendString:@"\'"];
+        escaped[escapedLength++] = '\'';
     }
     
-    return escapedString;
+    return [[NSString alloc] initWithCharactersNoCopy:escaped length:escapedLength freeWhenDone:YES];
 }
 
 + (NSString*)escapeLike:(NSString*)string {
-    NSMutableString *escapedString = [NSMutableString stringWithString:@"'"];
-    for (NSUInteger i = 0; i < string.length; i++) {
+    NSUInteger length = string.length;
+    unichar *escaped = malloc(sizeof(unichar) * (length * 2 + 2));
+    NSUInteger escapedLength = 0;
+    
+    escaped[escapedLength++] = '\'';
+    for (NSUInteger i = 0; i < length; i++) {
         unichar c = [string characterAtIndex:i];
         
         if (c == '\'') {
-            [escapedString appendString:@"\\"];
+            escaped[escapedLength++] = '\\';
         } else if (c == '\\') {
-            if (i + 1 < string.length && ([string characterAtIndex:(i + 1)] == '%' || [string characterAtIndex:(i + 1)] == '_')) {
+            if (i + 1 < length && ([string characterAtIndex:(i + 1)] == '%' || [string characterAtIndex:(i + 1)] == '_')) {
                 // no additional back slash
             } else {
-                [escapedString appendString:@"\\"];
+                escaped[escapedLength++] = '\\';
             }
         }
         
-        [escapedString appendString:[NSString stringWithCharacters:&c length:1]];
+        escaped[escapedLength++] = c;
     }
+    escaped[escapedLength++] = '\'';
     
-    [escapedString appendString:@"\'"];
-    return escapedString;
+    return [[NSString alloc] initWithCharactersNoCopy:escaped length:escapedLength freeWhenDone:YES];
 }
 
 + (NSString*)escapeContains:(NSString*)string {
-    NSMutableString *escapedString = [NSMutableString stringWithString:@"'"];
-    for (NSUInteger i = 0; i < string.length; i++) {
+    NSUInteger length = string.length;
+    // quotes are escaped with three back slashes
+    unichar *escaped = malloc(sizeof(unichar) * (length * 4 + 2));
+    NSUInteger escapedLength = 0;
+    
+    escaped[escapedLength++] = '\'';
+    for (NSUInteger i = 0; i < length; i++) {
         unichar c = [string characterAtIndex:i];
         
         if (c == '\\') {
-            [escapedString appendString:@"\\"];
+            escaped[escapedLength++] = '\\';
         } else if (c == '\'' || c == '\"') {
-            [escapedString appendString:@"\\\\\\"];
+            escaped[escapedLength++] = '\\';
+            escaped[escapedLength++] = '\\';
+            escaped[escapedLength++] = '\\';
         }
         
-        [escapedString appendString:[NSString stringWithCharacters:&c length:1]];
+        escaped[escapedLength++] = c;
     }
+    escaped[escapedLength++] = '\'';
     
-    [escapedString appendString:@"\'"];
-    return escapedString;
+    return [[NSString alloc] initWithCharactersNoCopy:escaped length:escapedLength freeWhenDone:YES];
 }
 
 + (NSString*)convert:(NSDate*)date {
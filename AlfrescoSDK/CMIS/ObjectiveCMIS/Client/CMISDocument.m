@@ -48,16 +48,16 @@
 {
     self = [super initWithObjectData:objectData session:session];
     if (self) {
-        self.contentStreamId = [[objectData.properties.propertiesDictionary objectForKey:kCMISPropertyContentStreamId] firstValue];
-        self.contentStreamMediaType = [[objectData.properties.propertiesDictionary objectForKey:kCMISPropertyContentStreamMediaType] firstValue];
-        self.contentStreamLength = [[[objectData.properties.propertiesDictionary objectForKey:kCMISPropertyContentStreamLength] firstValue] unsignedLongLongValue];
-        self.contentStreamFileName = [[objectData.properties.propertiesDictionary objectForKey:kCMISPropertyContentStreamFileName] firstValue];
+        self.contentStreamId = [[objectData.properties propertyForId:kCMISPropertyContentStreamId] firstValue];
+        self.contentStreamMediaType = [[objectData.properties propertyForId:kCMISPropertyContentStreamMediaType] firstValue];
+        self.contentStreamLength = [[[objectData.properties propertyForId:kCMISPropertyContentStreamLength] firstValue] unsignedLongLongValue];
+        self.contentStreamFileName = [[objectData.properties propertyForId:kCMISPropertyContentStreamFileName] firstValue];
 
-        self.versionLabel = [[objectData.properties.propertiesDictionary objectForKey:kCMISPropertyVersionLabel] firstValue];
-        self.versionSeriesId = [[objectData.properties.propertiesDictionary objectForKey:kCMISPropertyVersionSeriesId] firstValue];
-        self.latestVersion = [[[objectData.properties.propertiesDictionary objectForKey:kCMISPropertyIsLatestVersion] firstValue] boolValue];
-        self.latestMajorVersion = [[[objectData.properties.propertiesDictionary objectForKey:kCMISPropertyIsLatestMajorVersion] firstValue] boolValue];
-        self.majorVersion = [[[objectData.properties.propertiesDictionary objectForKey:kCMISPropertyIsMajorVersion] firstValue] boolValue];
+        self.versionLabel = [[objectData.properties propertyForId:kCMISPropertyVersionLabel] firstValue];
+        self.versionSeriesId = [[objectData.properties propertyForId:kCMISPropertyVersionSeriesId] firstValue];
+        self.latestVersion = [[[objectData.properties propertyForId:kCMISPropertyIsLatestVersion] firstValue] boolValue];
+        self.latestMajorVersion = [[[objectData.properties propertyForId:kCMISPropertyIsLatestMajorVersion] firstValue] boolValue];
+        self.majorVersion = [[[objectData.properties propertyForId:kCMISPropertyIsMajorVersion] firstValue] boolValue];
     }
     return self;
 }
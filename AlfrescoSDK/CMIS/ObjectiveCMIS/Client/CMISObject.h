@@ -23,6 +23,7 @@
 #import "CMISObjectId.h"
 
 @class CMISSession;
+@class CMISRequest;
 
 @interface CMISObject : CMISObjectId
 
@@ -56,6 +57,11 @@
  */
 - (void)fetchTypeDefinitionWithCompletionBlock:(void (^)(NSError *error))completionBlock;
 
+/**
+ * set the typeDefinition property initally, retrieving it as a sub request of the given request if it isn't cached
+ */
+- (void)fetchTypeDefinitionWithCMISRequest:(CMISRequest *)cmisRequest completionBlock:(void (^)(NSError *error))completionBlock;
+
 
 /**
  * Updates the properties that are provided.
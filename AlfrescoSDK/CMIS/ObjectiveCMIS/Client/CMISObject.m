@@ -26,6 +26,7 @@
 #import "CMISRenditionData.h"
 #import "CMISRendition.h"
 #import "CMISLog.h"
+#import "CMISRequest.h"
 
 
 @interface CMISObject ()
@@ -96,14 +97,35 @@
 
 
 - (void)fetchTypeDefinitionWithCompletionBlock:(void (^)(NSError *error))completionBlock
+{
+    [self fetchTypeDefinitionWithCMISRequest:nil completionBlock:completionBlock];
+}
+
+- (void)fetchTypeDefinitionWithCMISRequest:(CMISRequest *)cmisRequest completionBlock:(void (^)(NSError *error))completionBlock
 {
     if (self.typeDefinition) {
         if (completionBlock) {
             completionBlock(nil);
         }
+    } else if (cmisRequest.isCancelled) {
+        // the operation the object is converted for has been cancelled, don't go to the server for its type
+        if (completionBlock) {
+            completionBlock([CMISErrors createCMISErrorWithCode:kCMISErrorCodeCancelled detailedDescription:@"Request was cancelled"]);
+        }
     } else {
-        [self.session retrieveTypeDefinition:self.objectType
+        // cmisRequest holds the type definition request until it completes, which may happen before it has been returned
+        __block CMISRequest *typeDefinitionRequest = nil;
+        __block BOOL completed = NO;
+        CMISRequest *request = [self.session retrieveTypeDefinition:self.objectType
                              completionBlock:^(CMISTypeDefinition *typeDefinition, NSError *error) {
+                                 CMISRequest *completedRequest = nil;
+                                 @synchronized(cmisRequest) {
+                                     completed = YES;
+                                     completedRequest = typeDefinitionRequest;
+                                     typeDefinitionRequest = nil;
+                                 }
+                                 [cmisRequest removeSubRequest:completedRequest];
+
                                  if (error == nil) {
                                      self.typeDefinition = typeDefinition;
                                  } else {
@@ -113,6 +135,12 @@
                                      completionBlock(error);
                                  }
                              }];
+        @synchronized(cmisRequest) {
+            if (!completed) {
+                typeDefinitionRequest = request;
+                [cmisRequest addSubRequest:request];
+            }
+        }
     }
 }
 
@@ -26,16 +26,42 @@
 
 @end
 
+/// Priority classes of requests, requests with higher values are more urgent
+typedef NS_ENUM(NSInteger, CMISRequestPriority)
+{
+    CMISRequestPriorityBackgroundSync = -2,
+    CMISRequestPriorityPrefetch = -1,
+    CMISRequestPriorityDefault = 0,
+    CMISRequestPriorityUserInteractive = 1
+};
+
 @interface CMISRequest : NSObject
 
 @property (nonatomic, strong) id httpRequest;
 @property (nonatomic, readonly, getter = isCancelled) BOOL cancelled;
 
+/// Name of the operation the request is made for, recorded in the request metrics when a metrics observer is set
+@property (nonatomic, strong) NSString *operationName;
+
+/// The priority of the network requests made for the request and its sub requests, can be changed while they are in flight
+@property (nonatomic, assign) CMISRequestPriority priority;
+
 /**
  cancel a network request
  */
 - (void)cancel;
 
+/**
+ Links a request made to carry on the operation of this one, e.g. retrieving the type definitions needed to convert an object.
+ The sub request takes on the priority of this request and is cancelled along with it, straight away if this request already is.
+ */
+- (void)addSubRequest:(CMISRequest *)subRequest;
+
+/**
+ Unlinks a sub request once it has completed. Sub requests are held by this request until they are removed or this request is cancelled.
+ */
+- (void)removeSubRequest:(CMISRequest *)subRequest;
+
 
 @end
 
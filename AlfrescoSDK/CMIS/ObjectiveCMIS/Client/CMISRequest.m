@@ -18,10 +18,13 @@
  */
 
 #import "CMISRequest.h"
+#import "CMISHttpRequest.h"
+#import "CMISRequestMetrics.h"
 
 @interface CMISRequest ()
 
 @property (nonatomic, getter = isCancelled) BOOL cancelled;
+@property (nonatomic, strong) NSMutableArray *subRequests;
 @end
 
 
@@ -39,16 +42,86 @@
 
 - (void)cancel
 {
-    self.cancelled = YES;
+    NSArray *subRequests = nil;
+    @synchronized(self) {
+        self.cancelled = YES;
+        subRequests = [self.subRequests copy];
+        self.subRequests = nil;
+    }
+    
     if ([self.httpRequest respondsToSelector:@selector(cancel)]){
         [self.httpRequest cancel];
     }
+    
+    // cancel outside of the lock as completion blocks may call back into the request
+    for (CMISRequest *subRequest in subRequests) {
+        [subRequest cancel];
+    }
+}
+
+- (void)addSubRequest:(CMISRequest *)subRequest
+{
+    if (subRequest == nil) {
+        return;
+    }
+    
+    BOOL cancelled = NO;
+    @synchronized(self) {
+        cancelled = self.isCancelled;
+        if (!cancelled) {
+            if (!self.subRequests) {
+                // sub requests are held until they complete, the caller that made them usually keeps no reference
+                self.subRequests = [NSMutableArray array];
+            }
+            if ([self.subRequests indexOfObjectIdenticalTo:subRequest] == NSNotFound) {
+                [self.subRequests addObject:subRequest];
+            }
+        }
+    }
+    
+    if (cancelled) {
+        [subRequest cancel];
+    } else {
+        subRequest.priority = self.priority;
+        if (!subRequest.operationName) {
+            subRequest.operationName = self.operationName;
+        }
+    }
+}
+
+- (void)removeSubRequest:(CMISRequest *)subRequest
+{
+    if (subRequest == nil) {
+        return;
+    }
+    
+    @synchronized(self) {
+        [self.subRequests removeObjectIdenticalTo:subRequest];
+    }
+}
+
+- (void)setPriority:(CMISRequestPriority)priority
+{
+    NSArray *subRequests = nil;
+    @synchronized(self) {
+        _priority = priority;
+        subRequests = [self.subRequests copy];
+    }
+    
+    [self applyPriorityToHttpRequest];
+    for (CMISRequest *subRequest in subRequests) {
+        subRequest.priority = priority;
+    }
 }
 
 
 - (void)setHttpRequest:(id)httpRequest
 {
     _httpRequest = httpRequest;
+    [self applyOperationNameToHttpRequest];
+    if (self.priority != CMISRequestPriorityDefault) {
+        [self applyPriorityToHttpRequest];
+    }
     if (self.isCancelled){
         if ([httpRequest respondsToSelector:@selector(cancel)]) {
             [httpRequest cancel];
@@ -56,4 +129,34 @@
     }
 }
 
+- (void)setOperationName:(NSString *)operationName
+{
+    _operationName = operationName;
+    [self applyOperationNameToHttpRequest];
+}
+
+- (void)applyPriorityToHttpRequest
+{
+    id httpRequest = self.httpRequest;
+    if ([httpRequest isKindOfClass:[CMISHttpRequest class]]) {
+        ((CMISHttpRequest *)httpRequest).priority = self.priority;
+    } else if ([httpRequest isKindOfClass:[CMISRequest class]] && httpRequest != self) {
+        ((CMISRequest *)httpRequest).priority = self.priority;
+    }
+}
+
+- (void)applyOperationNameToHttpRequest
+{
+    id httpRequest = self.httpRequest;
+    if (!self.operationName) {
+        return;
+    }
+    
+    if ([httpRequest isKindOfClass:[CMISHttpRequest class]]) {
+        ((CMISHttpRequest *)httpRequest).metrics.operationName = self.operationName;
+    } else if ([httpRequest isKindOfClass:[CMISRequest class]] && httpRequest != self && !((CMISRequest *)httpRequest).operationName) {
+        ((CMISRequest *)httpRequest).operationName = self.operationName;
+    }
+}
+
 @end
@@ -197,6 +197,12 @@
     CMISRequest *request = [[CMISRequest alloc] init];
     CMISFetchNextPageBlock fetchNextPageBlock = ^(int skipCount, int maxItems, CMISFetchNextPageBlockCompletionBlock pageBlockCompletionBlock)
     {
+        // don't fetch another page once the caller has cancelled
+        if (request.isCancelled) {
+            pageBlockCompletionBlock(nil, [CMISErrors createCMISErrorWithCode:kCMISErrorCodeCancelled detailedDescription:@"Request was cancelled"]);
+            return;
+        }
+        
         // Fetch results through navigationService
         CMISRequest * checkedoutRequest = [self.binding.navigationService retrieveCheckedOutDocumentsInFolder:nil
                                                                                  orderBy:operationContext.orderBy
@@ -215,6 +221,7 @@
                                                                                  result.numItems = objectList.numItems;
                                                                                  
                                                                                  [self.objectConverter convertObjects:objectList.objects
+                                                                                                          cmisRequest:request
                                                                                                       completionBlock:^(NSArray *objects, NSError *error) {
                                                                                                           result.resultArray = objects;
                                                                                                           pageBlockCompletionBlock(result, error);
@@ -255,7 +262,8 @@
 
     // TODO: cache the object
 
-    return [self.binding.objectService retrieveObject:objectId
+    __block CMISRequest *request = nil;
+    request = [self.binding.objectService retrieveObject:objectId
                                                filter:operationContext.filterString
                                         relationships:operationContext.relationships
                                      includePolicyIds:operationContext.includePolicies
@@ -269,6 +277,7 @@
                                                 CMISObject *object = nil;
                                                 if (objectData) {
                                                     [self.objectConverter convertObject:objectData
+                                                                            cmisRequest:request
                                                                         completionBlock:^(CMISObject *object, NSError *error) {
                                                                             completionBlock(object, error);
                                                     }];
@@ -277,6 +286,7 @@
                                                 }
                                             }
                                         }];
+    return request;
 }
 
 - (CMISRequest*)retrieveObjectByPath:(NSString *)path completionBlock:(void (^)(CMISObject *object, NSError *error))completionBlock
@@ -288,7 +298,8 @@
             operationContext:(CMISOperationContext *)operationContext
              completionBlock:(void (^)(CMISObject *object, NSError *error))completionBlock
 {
-    return [self.binding.objectService retrieveObjectByPath:path
+    __block CMISRequest *request = nil;
+    request = [self.binding.objectService retrieveObjectByPath:path
                                               filter:operationContext.filterString
                                        relationships:operationContext.relationships
                                     includePolicyIds:operationContext.includePolicies
@@ -298,6 +309,7 @@
                                      completionBlock:^(CMISObjectData *objectData, NSError *error) {
                                         if (objectData != nil && error == nil) {
                                             [self.objectConverter convertObject:objectData
+                                                                    cmisRequest:request
                                                                 completionBlock:^(CMISObject *object, NSError *error) {
                                                                     completionBlock(object, error);
                                                                 }];
@@ -308,6 +320,7 @@
                                              completionBlock(nil, error);
                                          }
                                      }];
+    return request;
 }
 
 - (CMISRequest*)retrieveDocumentOfLatestVersion:(NSString *)objectId completionBlock:(void (^)(CMISDocument *document, NSError *error))completionBlock
@@ -402,6 +415,12 @@
 {
     CMISRequest *request = [[CMISRequest alloc] init];
     CMISFetchNextPageBlock fetchNextPageBlock = ^(int skipCount, int maxItems, CMISFetchNextPageBlockCompletionBlock pageBlockCompletionBlock){
+        // don't fetch another page once the caller has cancelled
+        if (request.isCancelled) {
+            pageBlockCompletionBlock(nil, [CMISErrors createCMISErrorWithCode:kCMISErrorCodeCancelled detailedDescription:@"Request was cancelled"]);
+            return;
+        }
+        
         // Fetch results through discovery service
        CMISRequest *queryRequest = [self.binding.discoveryService query:statement
                                                   searchAllVersions:searchAllVersion
@@ -476,6 +495,12 @@
     // Fetch block for paged results
     CMISFetchNextPageBlock fetchNextPageBlock = ^(int skipCount, int maxItems, CMISFetchNextPageBlockCompletionBlock pageBlockCompletionBlock)
     {
+        // don't fetch another page once the caller has cancelled
+        if (request.isCancelled) {
+            pageBlockCompletionBlock(nil, [CMISErrors createCMISErrorWithCode:kCMISErrorCodeCancelled detailedDescription:@"Request was cancelled"]);
+            return;
+        }
+        
         // Fetch results through discovery service
         CMISRequest *queryRequest = [self.binding.discoveryService query:statement
                                      searchAllVersions:searchAllVersion
@@ -494,6 +519,7 @@
                                      result.numItems = objectList.numItems;
                                      
                                      [self.objectConverter convertObjects:objectList.objects
+                                                              cmisRequest:request
                                                           completionBlock:^(NSArray *objects, NSError *error) {
                                                               result.resultArray = objects;
                                                               pageBlockCompletionBlock(result, error);
@@ -57,4 +57,14 @@
 - (void)didReceiveChallenge:(NSURLAuthenticationChallenge *)challenge
           completionHandler:(void (^)(NSURLSessionAuthChallengeDisposition, NSURLCredential *))completionHandler;
 
+@optional
+
+/**
+ * callback when a request was rejected with a 401 status code, the request is sent again
+ * with the httpHeadersToApply if the completion block is called with YES
+ */
+- (void)renewCredentialsRejectedByResponse:(NSHTTPURLResponse *)response
+                            requestHeaders:(NSDictionary *)requestHeaders
+                           completionBlock:(void (^)(BOOL renewed))completionBlock;
+
 @end
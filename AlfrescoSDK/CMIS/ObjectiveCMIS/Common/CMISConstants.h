@@ -129,6 +129,8 @@ extern NSString * const kCMISParameterReturnVersion;
 extern NSString * const kCMISParameterTypeId;
 extern NSString * const kCMISParameterStatement;
 extern NSString * const kCMISParameterSearchAllVersions;
+extern NSString * const kCMISParameterChangeLogToken;
+extern NSString * const kCMISParameterIncludeProperties;
 
 // Parameter Values
 extern NSString * const kCMISParameterValueTrue;
@@ -137,6 +139,12 @@ extern NSString * const kCMISParameterValueReturnValueThis;
 extern NSString * const kCMISParameterValueReturnValueLatest;
 extern NSString * const kCMISParameterValueReturnValueLatestMajor;
 
+// Change Type values
+extern NSString * const kCMISChangeTypeValueCreated;
+extern NSString * const kCMISChangeTypeValueUpdated;
+extern NSString * const kCMISChangeTypeValueDeleted;
+extern NSString * const kCMISChangeTypeValueSecurity;
+
 // Common Media Types
 extern NSString * const kCMISMediaTypeOctetStream;
 
@@ -140,6 +140,8 @@ NSString * const kCMISParameterReturnVersion = @"returnVersion";
 NSString * const kCMISParameterTypeId = @"typeId";
 NSString * const kCMISParameterStatement = @"statement";
 NSString * const kCMISParameterSearchAllVersions = @"searchAllVersions";
+NSString * const kCMISParameterChangeLogToken = @"changeLogToken";
+NSString * const kCMISParameterIncludeProperties = @"includeProperties";
 
 // Parameter Values
 NSString * const kCMISParameterValueTrue = @"true";
@@ -148,6 +150,12 @@ NSString * const kCMISParameterValueReturnValueThis = @"this";
 NSString * const kCMISParameterValueReturnValueLatest = @"latest";
 NSString * const kCMISParameterValueReturnValueLatestMajor = @"latestmajor";
 
+// Change Type values
+NSString * const kCMISChangeTypeValueCreated = @"created";
+NSString * const kCMISChangeTypeValueUpdated = @"updated";
+NSString * const kCMISChangeTypeValueDeleted = @"deleted";
+NSString * const kCMISChangeTypeValueSecurity = @"security";
+
 // Common Media Types
 NSString * const kCMISMediaTypeOctetStream = @"application/octet-stream";
 
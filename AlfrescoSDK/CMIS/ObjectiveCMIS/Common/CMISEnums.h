@@ -207,6 +207,15 @@ typedef NS_ENUM(NSInteger, CMISCapabilityOrderBy)
     CMISCapabilityOrderByCustom
 };
 
+// Change Type
+typedef NS_ENUM(NSInteger, CMISChangeType)
+{
+    CMISChangeTypeCreated,
+    CMISChangeTypeUpdated,
+    CMISChangeTypeDeleted,
+    CMISChangeTypeSecurity
+};
+
 // ReturnVersion
 typedef NS_ENUM(NSInteger, CMISReturnVersion)
 {
@@ -224,5 +233,6 @@ typedef NS_ENUM(NSInteger, CMISReturnVersion)
 + (CMISBaseType)enumForBaseId:(NSString *)baseId;
 + (CMISContentStreamAllowedType)enumForContentStreamAllowed:(NSString *)contentStreamAllowed;
 + (CMISPropertyType)enumForPropertyType:(NSString *)typeString;
++ (CMISChangeType)enumForChangeType:(NSString *)changeTypeString;
 
 @end
@@ -129,4 +129,20 @@
     return propertyType;
 }
 
++ (CMISChangeType)enumForChangeType:(NSString *)changeTypeString
+{
+    CMISChangeType changeType;
+    if ([changeTypeString isEqualToString:kCMISChangeTypeValueCreated]) {
+        changeType = CMISChangeTypeCreated;
+    } else if ([changeTypeString isEqualToString:kCMISChangeTypeValueDeleted]) {
+        changeType = CMISChangeTypeDeleted;
+    } else if ([changeTypeString isEqualToString:kCMISChangeTypeValueSecurity]) {
+        changeType = CMISChangeTypeSecurity;
+    } else {
+        // treat anything unexpected as an update so the object gets looked at again
+        changeType = CMISChangeTypeUpdated;
+    }
+    return changeType;
+}
+
 @end
\ No newline at end of file
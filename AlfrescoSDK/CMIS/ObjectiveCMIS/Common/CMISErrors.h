@@ -100,6 +100,9 @@ extern NSString * const kCMISErrorDescriptionStreamNotSupported;
 extern NSString * const kCMISErrorDescriptionUpdateConflict;
 extern NSString * const kCMISErrorDescriptionVersioning;
 
+//to be used in the userInfo dictionary of errors caused by an HTTP error response, the status code as an NSNumber
+extern NSString * const kCMISErrorKeyHTTPStatusCode;
+
 /** This class defines Errors in the Objective-C CMIS library
  
  All CMIS errors are based on NSError class.
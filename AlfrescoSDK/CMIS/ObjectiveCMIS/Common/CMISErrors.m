@@ -58,6 +58,8 @@ NSString * const kCMISErrorDescriptionStreamNotSupported = @"Stream Not Supporte
 NSString * const kCMISErrorDescriptionUpdateConflict = @"Update Conflict Error";
 NSString * const kCMISErrorDescriptionVersioning = @"Versioning Error";
 
+NSString * const kCMISErrorKeyHTTPStatusCode = @"HTTPStatusCode";
+
 @interface CMISErrors ()
 + (NSString *)localizedDescriptionForCode:(CMISErrorCodes)code;
 @end
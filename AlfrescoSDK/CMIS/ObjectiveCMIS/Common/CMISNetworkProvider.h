@@ -22,7 +22,7 @@ typedef NS_ENUM(NSInteger, CMISHttpRequestMethod)
     HTTP_DELETE
 };
 
-@class CMISBindingSession, CMISRequest, CMISHttpResponse;
+@class CMISBindingSession, CMISRequest, CMISHttpResponse, CMISContentSource;
 
 
 @protocol CMISNetworkProvider <NSObject>
@@ -32,7 +32,7 @@ typedef NS_ENUM(NSInteger, CMISHttpRequestMethod)
  * In case a custom network provider is to be used, this protocol must be implemented and an instance of the
  * custom class provided in the CMISSessionParameters when creating a CMIS Session.
  * CMISSessionParameters provides a networkProvider property for that purpose.
- * All methods in this protocol must be implemented
+ * All methods in this protocol must be implemented, except for the optional ones at its end
  */
 
 /**
@@ -250,7 +250,34 @@ completionBlock:(void (^)(CMISHttpResponse *httpResponse, NSError *error))comple
          cmisRequest:(CMISRequest *)cmisRequest
      completionBlock:(void (^)(CMISHttpResponse *httpResponse, NSError *error))completionBlock;
 
+@optional
 
-
+/**
+ * Invoke method used for uploads from a content source, i.e. POST/PUT requests. Content held in memory or mapped from a
+ * file can be sent without being read through a stream, and rewindable content can be sent again when the request is
+ * retried. Providers that don't implement this method are passed the stream and length of the content source instead.
+ * @param url the RESTful API URL to be used
+ * @param httpRequestMethod
+ * @param session
+ * @param contentSource the content to be uploaded
+ * @param headers any additional headers to be used in the request (maybe nil)
+ * @param cmisRequest will be used to set the cancellable request to the one created by the invoked method
+ * @param startData start payload e.g. containing the form data before the content is written (maybe nil)
+ * @param endData end payload e.g. containing the form data after the content is written (maybe nil)
+ * @param useBase64Encoding Determines whether the content is encoded as base64 as it's sent to the server
+ * @param completionBlock returns an instance of the HTTPResponse if successful or nil otherwise
+ * @param progressBlock
+ */
+- (void)invoke:(NSURL *)url
+    httpMethod:(CMISHttpRequestMethod)httpRequestMethod
+       session:(CMISBindingSession *)session
+ contentSource:(CMISContentSource *)contentSource
+       headers:(NSDictionary *)additionalHeaders
+   cmisRequest:(CMISRequest *)cmisRequest
+     startData:(NSData *)startData
+       endData:(NSData *)endData
+useBase64Encoding:(BOOL)useBase64Encoding
+completionBlock:(void (^)(CMISHttpResponse *httpResponse, NSError *error))completionBlock
+ progressBlock:(void (^)(unsigned long long bytesUploaded, unsigned long long bytesTotal))progressBlock;
 
 @end
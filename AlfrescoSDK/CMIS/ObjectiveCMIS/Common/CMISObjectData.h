@@ -26,6 +26,7 @@
 #import "CMISAcl.h"
 
 @class CMISRenditionData;
+@class CMISChangeEventInfo;
 
 @interface CMISObjectData : CMISExtensionData
 
@@ -39,5 +40,6 @@
 @property (nonatomic, strong) NSArray *renditions; // An array containing CMISRenditionData objects
 @property (nonatomic, strong) NSArray *relationships; // An array containing CMISObjectData objects; Relationships from and to this object.
 @property (nonatomic, assign) BOOL isExactAcl; //TODO set this value also from atom
+@property (nonatomic, strong) CMISChangeEventInfo *changeEventInfo; // Only set for objects returned from the change log
 
 @end
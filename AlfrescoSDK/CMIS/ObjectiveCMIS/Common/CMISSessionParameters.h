@@ -40,6 +40,26 @@ extern NSString * const kCMISSessionParameterObjectConverterClassName;
  */
 extern NSString * const kCMISSessionParameterLinkCacheSize;
 
+/**
+ * Key for setting the amount of memory the cache of links may use.
+ * Value should be an NSNumber, indicating the approximate number of bytes, default is 2MB.
+ */
+extern NSString * const kCMISSessionParameterLinkCacheMemoryLimit;
+
+/**
+ * Key for setting whether links missing from the cache may be derived from the URL patterns
+ * learnt from previously cached objects, rather than fetching the object again.
+ * Value should be a boolean flag, default is NO.
+ */
+extern NSString * const kCMISSessionParameterLinkCacheDeriveLinks;
+
+/**
+ * Key for setting the path of a file the cache of links is persisted to when the binding is closed,
+ * and restored from when the cache is created. The file should be specific to the repository and user.
+ * Value should be an NSString, if not set the cache is not persisted.
+ */
+extern NSString * const kCMISSessionParameterLinkCachePersistencePath;
+
 /**
  * Key for setting the value of the cache of type definitions.
  * Value should be an NSNumber, indicating the amount of type defintions will be cached.
@@ -63,6 +83,30 @@ extern NSString * const kCMISSessionParameterCheckNetworkReachability;
  */
 extern NSString * const kCMISSessionParameterRequestTimeout;
 
+/**
+ * Key for setting an observer that receives the metrics of every network request made for the session.
+ * Value should be an object conforming to the CMISRequestMetricsObserver protocol, if not set no metrics are collected.
+ */
+extern NSString * const kCMISSessionParameterRequestMetricsObserver;
+
+/**
+ * Key for setting the policy deciding whether failed network requests are retried.
+ * Value should be an object conforming to the CMISRetryPolicy protocol, if not set requests are not retried.
+ */
+extern NSString * const kCMISSessionParameterRetryPolicy;
+
+/**
+ * Key for setting the cache used to make GET requests conditional and answer 304 Not Modified responses.
+ * Value should be a CMISHttpResponseCache, if not set responses are not cached.
+ */
+extern NSString * const kCMISSessionParameterResponseCache;
+
+/**
+ * Key for setting the dispatch queue the completion and progress blocks of network requests are called on.
+ * If not set they are called on the thread the request was started on, which must run a run loop.
+ */
+extern NSString * const kCMISSessionParameterCallbackQueue;
+
 /**
  * Key for setting whether a background session should be used for network calls,
  * default is NO.
@@ -83,6 +127,12 @@ extern NSString * const kCMISSessionParameterBackgroundNetworkSessionId;
  */
 extern NSString * const kCMISSessionParameterBackgroundNetworkSessionSharedContainerId;
 
+/**
+ * Key for setting the maximum number of transfers the background network session runs at once,
+ * further transfers are queued in priority order. If not set, 4 transfers will run concurrently.
+ */
+extern NSString * const kCMISSessionParameterBackgroundNetworkSessionMaxConcurrentTransfers;
+
 /**
  * Key for overriding the default upload buffer chunk size during the Base64 encoding phase.
  * If not specified, the default chunk size of 32768 bytes will be used.
@@ -22,14 +22,22 @@
 // Session param keys
 NSString * const kCMISSessionParameterObjectConverterClassName = @"session_param_object_converter_class";
 NSString * const kCMISSessionParameterLinkCacheSize = @"session_param_cache_size_links";
+NSString * const kCMISSessionParameterLinkCacheMemoryLimit = @"session_param_cache_memory_limit_links";
+NSString * const kCMISSessionParameterLinkCacheDeriveLinks = @"session_param_cache_derive_links";
+NSString * const kCMISSessionParameterLinkCachePersistencePath = @"session_param_cache_persistence_path_links";
 NSString * const kCMISSessionParameterTypeDefinitionCacheSize = @"session_param_cache_size_type_definition";
 NSString * const kCMISSessionParameterSendCookies = @"session_param_send_cookies";
 
 NSString * const kCMISSessionParameterCheckNetworkReachability = @"session_param_check_network_reachability";
 NSString * const kCMISSessionParameterRequestTimeout = @"session_param_request_timeout";
+NSString * const kCMISSessionParameterRequestMetricsObserver = @"session_param_request_metrics_observer";
+NSString * const kCMISSessionParameterRetryPolicy = @"session_param_retry_policy";
+NSString * const kCMISSessionParameterResponseCache = @"session_param_response_cache";
+NSString * const kCMISSessionParameterCallbackQueue = @"session_param_callback_queue";
 NSString * const kCMISSessionParameterUseBackgroundNetworkSession = @"session_param_use_background_session";
 NSString * const kCMISSessionParameterBackgroundNetworkSessionId = @"session_param_background_session_id";
 NSString * const kCMISSessionParameterBackgroundNetworkSessionSharedContainerId = @"session_param_background_session_shared_container_id";
+NSString * const kCMISSessionParameterBackgroundNetworkSessionMaxConcurrentTransfers = @"session_param_background_session_max_concurrent_transfers";
 
 NSString * const kCMISSessionParameterUploadBufferChunkSize = @"session_param_upload_chunk_size";
 
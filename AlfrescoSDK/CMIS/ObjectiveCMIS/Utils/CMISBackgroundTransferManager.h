@@ -0,0 +1,102 @@
+/*
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+ 
+    http://www.apache.org/licenses/LICENSE-2.0
+ 
+  Unless required by applicable law or agreed to in writing,
+  software distributed under the License is distributed on an
+  "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+  KIND, either express or implied.  See the License for the
+  specific language governing permissions and limitations
+  under the License.
+ */
+
+#import <Foundation/Foundation.h>
+
+@class CMISBindingSession;
+@class CMISHttpRequest;
+@class CMISHttpResponse;
+
+/**
+ * Runs the transfers of all requests made with a background network session on a single background NSURLSession.
+ *
+ * There is one manager per background session identifier in the process. Transfers are queued in priority order
+ * and at most maxConcurrentTransfers of them run at once. The manager records every running transfer on disk,
+ * keyed by the request's transferIdentifier. After a relaunch, reattachTransferWithIdentifier:completionBlock:progressBlock:
+ * hands back the progress and outcome of transfers that continued while the app was not running.
+ *
+ * To deliver the events of a background session that woke the app, look the manager up using
+ * transferManagerWithIdentifier:sharedContainerIdentifier: from application:handleEventsForBackgroundURLSession:completionHandler:
+ * and set its backgroundEventsCompletionHandler.
+ */
+@interface CMISBackgroundTransferManager : NSObject <NSURLSessionDataDelegate, NSURLSessionDownloadDelegate>
+
+@property (nonatomic, strong, readonly) NSString *identifier;
+@property (nonatomic, strong, readonly) NSURLSession *urlSession;
+
+/// The maximum number of transfers running at once, defaults to 4. The first binding session using the manager that sets
+/// kCMISSessionParameterBackgroundNetworkSessionMaxConcurrentTransfers sets it, later sessions sharing the identifier don't change it.
+@property (atomic, assign) NSUInteger maxConcurrentTransfers;
+
+/// Called on the main thread once all pending events of the background session have been delivered
+@property (atomic, copy) void (^backgroundEventsCompletionHandler)(void);
+
+/// The number of transfers currently running
+@property (nonatomic, assign, readonly) NSUInteger runningTransferCount;
+
+/// The number of transfers waiting for a free slot
+@property (nonatomic, assign, readonly) NSUInteger queuedTransferCount;
+
+/// The identifiers of the recorded transfers that have not been delivered to a request yet
+@property (nonatomic, strong, readonly) NSArray *transferIdentifiers;
+
+/**
+ * Returns the manager for the background network session configured in the given binding session,
+ * or nil if kCMISSessionParameterUseBackgroundNetworkSession is not set.
+ */
++ (CMISBackgroundTransferManager *)transferManagerForSession:(CMISBindingSession *)session;
+
+/// Returns the manager for the given background session identifier, creating it if necessary
++ (CMISBackgroundTransferManager *)transferManagerWithIdentifier:(NSString *)identifier
+                                       sharedContainerIdentifier:(NSString *)containerIdentifier;
+
+/// Makes the given manager the one returned for its identifier
++ (void)registerTransferManager:(CMISBackgroundTransferManager *)transferManager;
+
+/**
+ * Initialises a manager with the given session configuration, normally a background configuration with the same identifier.
+ * The transfer records are stored at storePath, if nil they are stored in the caches directory.
+ */
+- (id)initWithIdentifier:(NSString *)identifier
+           configuration:(NSURLSessionConfiguration *)configuration
+               storePath:(NSString *)storePath;
+
+/// Queues the transfer of the given request, it is started as soon as fewer than maxConcurrentTransfers are running
+- (void)enqueueRequest:(CMISHttpRequest *)request urlRequest:(NSURLRequest *)urlRequest;
+
+/// Moves a queued request to its place for its current priority, running transfers keep their slot
+- (void)reprioritizeRequest:(CMISHttpRequest *)request;
+
+/// Cancels the transfer of the given request, whether it is running or still queued
+- (void)cancelRequest:(CMISHttpRequest *)request;
+
+/**
+ * Attaches new blocks to a recorded transfer, typically one started before the app was relaunched.
+ * If the transfer has already finished the completion block is called with its outcome, downloads having been
+ * moved to their output file path. Blocks are called on the current thread.
+ * Returns NO if there is no record of the transfer.
+ */
+- (BOOL)reattachTransferWithIdentifier:(NSString *)transferIdentifier
+                       completionBlock:(void (^)(CMISHttpResponse *httpResponse, NSError *error))completionBlock
+                         progressBlock:(void (^)(unsigned long long bytesTransferred, unsigned long long bytesTotal))progressBlock;
+
+/// Cancels all transfers and invalidates the URL session, the manager is unregistered and can no longer be used
+- (void)invalidateAndCancel;
+
+@end
@@ -0,0 +1,647 @@
+/*
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+ 
+    http://www.apache.org/licenses/LICENSE-2.0
+ 
+  Unless required by applicable law or agreed to in writing,
+  software distributed under the License is distributed on an
+  "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+  KIND, either express or implied.  See the License for the
+  specific language governing permissions and limitations
+  under the License.
+ */
+
+#import "CMISBackgroundTransferManager.h"
+#import "CMISHttpRequest.h"
+#import "CMISHttpDownloadRequest.h"
+#import "CMISHttpUploadRequest.h"
+#import "CMISHttpResponse.h"
+#import "CMISBindingSession.h"
+#import "CMISSessionParameters.h"
+#import "CMISConstants.h"
+#import "CMISErrors.h"
+#import "CMISLog.h"
+
+static NSUInteger const kCMISDefaultMaxConcurrentTransfers = 4;
+
+// keys of the recorded transfers
+static NSString * const kCMISTransferRecordURL = @"url";
+static NSString * const kCMISTransferRecordHttpMethod = @"httpMethod";
+static NSString * const kCMISTransferRecordKind = @"kind";
+static NSString * const kCMISTransferRecordOutputFilePath = @"outputFilePath";
+static NSString * const kCMISTransferRecordBodyFilePath = @"bodyFilePath";
+static NSString * const kCMISTransferRecordFinished = @"finished";
+static NSString * const kCMISTransferRecordStatusCode = @"statusCode";
+static NSString * const kCMISTransferRecordErrorCode = @"errorCode";
+static NSString * const kCMISTransferRecordErrorDescription = @"errorDescription";
+
+static NSString * const kCMISTransferKindData = @"data";
+static NSString * const kCMISTransferKindDownload = @"download";
+static NSString * const kCMISTransferKindUpload = @"upload";
+
+
+@interface CMISQueuedTransfer : NSObject
+@property (nonatomic, strong) CMISHttpRequest *request;
+@property (nonatomic, strong) NSURLRequest *urlRequest;
+@property (nonatomic, assign) unsigned long long sequenceNumber;
+@end
+
+@implementation CMISQueuedTransfer
+@end
+
+
+@interface CMISBackgroundTransferManager ()
+@property (nonatomic, strong, readwrite) NSString *identifier;
+@property (nonatomic, strong, readwrite) NSURLSession *urlSession;
+@property (nonatomic, strong) NSString *storePath;
+@property (nonatomic, strong) NSOperationQueue *delegateQueue;
+@property (nonatomic, strong) NSMutableArray *queuedTransfers;
+@property (nonatomic, strong) NSMutableDictionary *requestsByTaskIdentifier;
+@property (nonatomic, strong) NSMutableDictionary *records;
+@property (nonatomic, assign) unsigned long long nextSequenceNumber;
+@property (nonatomic, assign) BOOL maxConcurrentTransfersConfigured;
+@end
+
+@implementation CMISBackgroundTransferManager
+
++ (CMISBackgroundTransferManager *)transferManagerForSession:(CMISBindingSession *)session
+{
+    id useBackgroundSession = [session objectForKey:kCMISSessionParameterUseBackgroundNetworkSession];
+    if (!useBackgroundSession || ![useBackgroundSession boolValue]) {
+        return nil;
+    }
+    
+    NSString *backgroundId = [session objectForKey:kCMISSessionParameterBackgroundNetworkSessionId
+                                      defaultValue:kCMISDefaultBackgroundNetworkSessionId];
+    NSString *containerId = [session objectForKey:kCMISSessionParameterBackgroundNetworkSessionSharedContainerId
+                                     defaultValue:kCMISDefaultBackgroundNetworkSessionSharedContainerId];
+    
+    CMISBackgroundTransferManager *transferManager = [self transferManagerWithIdentifier:backgroundId sharedContainerIdentifier:containerId];
+    
+    // the limit applies to the manager shared by every session using the identifier, the first session to give one sets it
+    id maxConcurrentTransfers = [session objectForKey:kCMISSessionParameterBackgroundNetworkSessionMaxConcurrentTransfers];
+    if (maxConcurrentTransfers) {
+        @synchronized(transferManager) {
+            if (!transferManager.maxConcurrentTransfersConfigured) {
+                transferManager.maxConcurrentTransfersConfigured = YES;
+                transferManager.maxConcurrentTransfers = [maxConcurrentTransfers unsignedIntegerValue];
+            }
+        }
+    }
+    
+    return transferManager;
+}
+
++ (CMISBackgroundTransferManager *)transferManagerWithIdentifier:(NSString *)identifier
+                                       sharedContainerIdentifier:(NSString *)containerIdentifier
+{
+    @synchronized(self) {
+        CMISBackgroundTransferManager *transferManager = [self registeredTransferManagers][identifier];
+        if (!transferManager) {
+            // only one session may exist per background identifier, so it is created once and shared by all requests
+            NSURLSessionConfiguration *configuration = [NSURLSessionConfiguration backgroundSessionConfigurationWithIdentifier:identifier];
+            configuration.sharedContainerIdentifier = containerIdentifier;
+            transferManager = [[self alloc] initWithIdentifier:identifier configuration:configuration storePath:nil];
+            [self registeredTransferManagers][identifier] = transferManager;
+            
+            CMISLogDebug(@"Using background network session with identifier '%@' and shared container '%@'",
+                         identifier, containerIdentifier);
+        }
+        return transferManager;
+    }
+}
+
++ (void)registerTransferManager:(CMISBackgroundTransferManager *)transferManager
+{
+    @synchronized(self) {
+        [self registeredTransferManagers][transferManager.identifier] = transferManager;
+    }
+}
+
++ (NSMutableDictionary *)registeredTransferManagers
+{
+    static NSMutableDictionary *transferManagers = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        transferManagers = [[NSMutableDictionary alloc] init];
+    });
+    return transferManagers;
+}
+
++ (NSString *)defaultStorePathForIdentifier:(NSString *)identifier
+{
+    NSString *cachesPath = [NSSearchPathForDirectoriesInDomains(NSCachesDirectory, NSUserDomainMask, YES) firstObject];
+    NSString *fileName = [[identifier stringByReplacingOccurrencesOfString:@"/" withString:@"_"] stringByAppendingPathExtension:@"plist"];
+    return [[cachesPath stringByAppendingPathComponent:@"CMISBackgroundTransfers"] stringByAppendingPathComponent:fileName];
+}
+
+- (id)initWithIdentifier:(NSString *)identifier
+           configuration:(NSURLSessionConfiguration *)configuration
+               storePath:(NSString *)storePath
+{
+    self = [super init];
+    if (self) {
+        _identifier = identifier;
+        _maxConcurrentTransfers = kCMISDefaultMaxConcurrentTransfers;
+        _storePath = storePath ? storePath : [CMISBackgroundTransferManager defaultStorePathForIdentifier:identifier];
+        _queuedTransfers = [[NSMutableArray alloc] init];
+        _requestsByTaskIdentifier = [[NSMutableDictionary alloc] init];
+        _records = [self loadRecords];
+        
+        // callbacks for a task are delivered in order on a serial queue
+        _delegateQueue = [[NSOperationQueue alloc] init];
+        _delegateQueue.maxConcurrentOperationCount = 1;
+        _delegateQueue.name = [NSString stringWithFormat:@"CMISBackgroundTransferManager.%@", identifier];
+        
+        _urlSession = [NSURLSession sessionWithConfiguration:configuration delegate:self delegateQueue:_delegateQueue];
+        
+        [self reconcileRecordsWithTasks];
+    }
+    return self;
+}
+
+#pragma mark Transfers
+
+- (NSUInteger)runningTransferCount
+{
+    @synchronized(self) {
+        return self.requestsByTaskIdentifier.count;
+    }
+}
+
+- (NSUInteger)queuedTransferCount
+{
+    @synchronized(self) {
+        return self.queuedTransfers.count;
+    }
+}
+
+- (NSArray *)transferIdentifiers
+{
+    @synchronized(self) {
+        return self.records.allKeys;
+    }
+}
+
+- (void)enqueueRequest:(CMISHttpRequest *)request urlRequest:(NSURLRequest *)urlRequest
+{
+    request.transferManager = self;
+    request.urlSession = self.urlSession;
+    if (!request.transferIdentifier) {
+        request.transferIdentifier = [[NSUUID UUID] UUIDString];
+    }
+    
+    @synchronized(self) {
+        CMISQueuedTransfer *transfer = [[CMISQueuedTransfer alloc] init];
+        transfer.request = request;
+        transfer.urlRequest = urlRequest;
+        transfer.sequenceNumber = self.nextSequenceNumber++;
+        [self insertQueuedTransfer:transfer];
+    }
+    
+    [self startQueuedTransfers];
+}
+
+- (void)reprioritizeRequest:(CMISHttpRequest *)request
+{
+    @synchronized(self) {
+        NSUInteger index = [self.queuedTransfers indexOfObjectPassingTest:^BOOL(CMISQueuedTransfer *transfer, NSUInteger idx, BOOL *stop) {
+            return transfer.request == request;
+        }];
+        if (index != NSNotFound) {
+            // the transfer keeps its sequence number so it stays in order with the others of its new priority
+            CMISQueuedTransfer *transfer = self.queuedTransfers[index];
+            [self.queuedTransfers removeObjectAtIndex:index];
+            [self insertQueuedTransfer:transfer];
+        }
+    }
+}
+
+/// Must be called while synchronized on self
+- (void)insertQueuedTransfer:(CMISQueuedTransfer *)transfer
+{
+    // the queue is kept ordered by descending priority, and first in first out within a priority
+    NSUInteger index = [self.queuedTransfers indexOfObject:transfer
+                                             inSortedRange:NSMakeRange(0, self.queuedTransfers.count)
+                                                   options:NSBinarySearchingInsertionIndex | NSBinarySearchingLastEqual
+                                           usingComparator:^NSComparisonResult(CMISQueuedTransfer *transfer1, CMISQueuedTransfer *transfer2) {
+        if (transfer1.request.priority != transfer2.request.priority) {
+            return transfer1.request.priority > transfer2.request.priority ? NSOrderedAscending : NSOrderedDescending;
+        }
+        if (transfer1.sequenceNumber != transfer2.sequenceNumber) {
+            return transfer1.sequenceNumber < transfer2.sequenceNumber ? NSOrderedAscending : NSOrderedDescending;
+        }
+        return NSOrderedSame;
+    }];
+    [self.queuedTransfers insertObject:transfer atIndex:index];
+}
+
+- (void)cancelRequest:(CMISHttpRequest *)request
+{
+    NSURLSessionTask *task = nil;
+    @synchronized(self) {
+        NSUInteger index = [self.queuedTransfers indexOfObjectPassingTest:^BOOL(CMISQueuedTransfer *transfer, NSUInteger idx, BOOL *stop) {
+            return transfer.request == request;
+        }];
+        if (index != NSNotFound) {
+            [self.queuedTransfers removeObjectAtIndex:index];
+        } else {
+            task = request.sessionTask;
+        }
+    }
+    
+    // the slot is freed once the task reports its cancellation
+    [task cancel];
+}
+
+- (void)startQueuedTransfers
+{
+    NSMutableArray *startedTransfers = [NSMutableArray array];
+    
+    @synchronized(self) {
+        NSUInteger maxConcurrentTransfers = MAX(self.maxConcurrentTransfers, 1);
+        while (self.queuedTransfers.count > 0 && self.requestsByTaskIdentifier.count < maxConcurrentTransfers) {
+            CMISQueuedTransfer *transfer = self.queuedTransfers.firstObject;
+            [self.queuedTransfers removeObjectAtIndex:0];
+            [startedTransfers addObject:transfer];
+            
+            CMISHttpRequest *request = transfer.request;
+            NSURLSessionTask *task = [request taskForRequest:transfer.urlRequest];
+            request.sessionTask = task;
+            if (task) {
+                // the description survives a relaunch, it is how restored tasks are matched with their records
+                task.taskDescription = request.transferIdentifier;
+                self.requestsByTaskIdentifier[@(task.taskIdentifier)] = request;
+                self.records[request.transferIdentifier] = [self recordForRequest:request urlRequest:transfer.urlRequest];
+            }
+        }
+        
+        if (startedTransfers.count > 0) {
+            [self saveRecords];
+        }
+    }
+    
+    // tasks are resumed outside the lock, their callbacks block on it until the task has been registered anyway
+    for (CMISQueuedTransfer *transfer in startedTransfers) {
+        [transfer.request resumeTaskForRequest:transfer.urlRequest];
+    }
+}
+
+- (CMISHttpRequest *)requestForTask:(NSURLSessionTask *)task
+{
+    @synchronized(self) {
+        return self.requestsByTaskIdentifier[@(task.taskIdentifier)];
+    }
+}
+
+- (BOOL)reattachTransferWithIdentifier:(NSString *)transferIdentifier
+                       completionBlock:(void (^)(CMISHttpResponse *httpResponse, NSError *error))completionBlock
+                         progressBlock:(void (^)(unsigned long long bytesTransferred, unsigned long long bytesTotal))progressBlock
+{
+    NSDictionary *record = nil;
+    @synchronized(self) {
+        record = self.records[transferIdentifier];
+    }
+    if (!record) {
+        return NO;
+    }
+    
+    // a request created on the current thread delivers the callbacks of the transfer from now on
+    CMISHttpRequestMethod httpMethod = [record[kCMISTransferRecordHttpMethod] integerValue];
+    CMISHttpRequest *request = nil;
+    if ([record[kCMISTransferRecordKind] isEqualToString:kCMISTransferKindUpload]) {
+        request = [[CMISHttpUploadRequest alloc] initWithHttpMethod:httpMethod completionBlock:completionBlock progressBlock:progressBlock];
+    } else {
+        CMISHttpDownloadRequest *downloadRequest = [[CMISHttpDownloadRequest alloc] initWithHttpMethod:httpMethod completionBlock:completionBlock progressBlock:progressBlock];
+        downloadRequest.outputFilePath = record[kCMISTransferRecordOutputFilePath];
+        request = downloadRequest;
+    }
+    request.transferIdentifier = transferIdentifier;
+    request.transferManager = self;
+    request.urlSession = self.urlSession;
+    
+    [self.urlSession getAllTasksWithCompletionHandler:^(NSArray *tasks) {
+        NSDictionary *finishedRecord = nil;
+        @synchronized(self) {
+            NSDictionary *currentRecord = self.records[transferIdentifier];
+            NSURLSessionTask *runningTask = nil;
+            for (NSURLSessionTask *task in tasks) {
+                if ([task.taskDescription isEqualToString:transferIdentifier] && task.state != NSURLSessionTaskStateCompleted) {
+                    runningTask = task;
+                    break;
+                }
+            }
+            
+            if (currentRecord && ![currentRecord[kCMISTransferRecordFinished] boolValue] && runningTask) {
+                request.sessionTask = runningTask;
+                self.requestsByTaskIdentifier[@(runningTask.taskIdentifier)] = request;
+            } else if (currentRecord) {
+                finishedRecord = [currentRecord[kCMISTransferRecordFinished] boolValue] ? currentRecord : [self interruptedRecord:currentRecord];
+                [self.records removeObjectForKey:transferIdentifier];
+                [self saveRecords];
+            } else {
+                // delivered to another reattached request in the meantime
+                CMISLogDebug(@"Background transfer %@ was reattached more than once", transferIdentifier);
+            }
+        }
+        
+        if (finishedRecord) {
+            [self deliverOutcomeOfRecord:finishedRecord toRequest:request];
+        }
+    }];
+    
+    return YES;
+}
+
+- (void)deliverOutcomeOfRecord:(NSDictionary *)record toRequest:(CMISHttpRequest *)request
+{
+    NSError *error = nil;
+    CMISHttpResponse *httpResponse = nil;
+    if (record[kCMISTransferRecordErrorCode]) {
+        error = [CMISErrors createCMISErrorWithCode:[record[kCMISTransferRecordErrorCode] integerValue]
+                                detailedDescription:record[kCMISTransferRecordErrorDescription]];
+    } else {
+        int statusCode = [record[kCMISTransferRecordStatusCode] intValue];
+        httpResponse = [CMISHttpResponse responseWithStatusCode:statusCode
+                                                  statusMessage:[NSHTTPURLResponse localizedStringForStatusCode:statusCode]
+                                                        headers:nil
+                                                   responseData:nil];
+        if (![request checkStatusCodeForResponse:httpResponse httpRequestMethod:request.requestMethod error:&error]) {
+            httpResponse = nil;
+        }
+    }
+    
+    // call the completion block on the request's callback queue or the thread the transfer was reattached on
+    [request performCallback:^{
+        if (error) {
+            [request executeCompletionBlockError:error];
+        } else {
+            [request executeCompletionBlockResponse:httpResponse];
+        }
+    }];
+}
+
+- (void)invalidateAndCancel
+{
+    NSArray *queuedTransfers = nil;
+    @synchronized(self) {
+        queuedTransfers = [self.queuedTransfers copy];
+        [self.queuedTransfers removeAllObjects];
+    }
+    for (CMISQueuedTransfer *transfer in queuedTransfers) {
+        [transfer.request cancel];
+    }
+    
+    [self.urlSession invalidateAndCancel];
+    
+    @synchronized([CMISBackgroundTransferManager class]) {
+        NSMutableDictionary *transferManagers = [CMISBackgroundTransferManager registeredTransferManagers];
+        if (transferManagers[self.identifier] == self) {
+            [transferManagers removeObjectForKey:self.identifier];
+        }
+    }
+}
+
+#pragma mark Records
+
+- (NSDictionary *)recordForRequest:(CMISHttpRequest *)request urlRequest:(NSURLRequest *)urlRequest
+{
+    NSMutableDictionary *record = [NSMutableDictionary dictionary];
+    record[kCMISTransferRecordURL] = urlRequest.URL.absoluteString;
+    record[kCMISTransferRecordHttpMethod] = @(request.requestMethod);
+    record[kCMISTransferRecordKind] = kCMISTransferKindData;
+    
+    if ([request isKindOfClass:[CMISHttpUploadRequest class]]) {
+        record[kCMISTransferRecordKind] = kCMISTransferKindUpload;
+        NSString *bodyFilePath = [(CMISHttpUploadRequest *)request bodyFilePath];
+        if (bodyFilePath) {
+            record[kCMISTransferRecordBodyFilePath] = bodyFilePath;
+        }
+    } else if ([request isKindOfClass:[CMISHttpDownloadRequest class]]) {
+        NSString *outputFilePath = [(CMISHttpDownloadRequest *)request outputFilePath];
+        if (outputFilePath) {
+            record[kCMISTransferRecordKind] = kCMISTransferKindDownload;
+            record[kCMISTransferRecordOutputFilePath] = outputFilePath;
+        }
+    }
+    
+    return record;
+}
+
+- (NSDictionary *)record:(NSDictionary *)record finishedWithTask:(NSURLSessionTask *)task error:(NSError *)error
+{
+    NSMutableDictionary *finishedRecord = [record mutableCopy];
+    finishedRecord[kCMISTransferRecordFinished] = @(YES);
+    if ([task.response isKindOfClass:[NSHTTPURLResponse class]]) {
+        finishedRecord[kCMISTransferRecordStatusCode] = @([(NSHTTPURLResponse *)task.response statusCode]);
+    }
+    if (error && !finishedRecord[kCMISTransferRecordErrorCode]) {
+        CMISErrorCodes errorCode = (error.code == NSURLErrorCancelled) ? kCMISErrorCodeCancelled : kCMISErrorCodeConnection;
+        finishedRecord[kCMISTransferRecordErrorCode] = @(errorCode);
+        finishedRecord[kCMISTransferRecordErrorDescription] = error.localizedDescription ? error.localizedDescription : @"";
+    }
+    return finishedRecord;
+}
+
+- (NSDictionary *)interruptedRecord:(NSDictionary *)record
+{
+    NSMutableDictionary *interruptedRecord = [record mutableCopy];
+    interruptedRecord[kCMISTransferRecordFinished] = @(YES);
+    interruptedRecord[kCMISTransferRecordErrorCode] = @(kCMISErrorCodeConnection);
+    interruptedRecord[kCMISTransferRecordErrorDescription] = @"The background transfer was interrupted";
+    return interruptedRecord;
+}
+
+/**
+ * Tasks started by a previous process keep running outside of it. Recorded transfers without a task and
+ * without an outcome were lost, their tasks having been discarded by the system.
+ */
+- (void)reconcileRecordsWithTasks
+{
+    NSArray *restoredTransferIdentifiers = self.records.allKeys;
+    if (restoredTransferIdentifiers.count == 0) {
+        return;
+    }
+    
+    [self.urlSession getAllTasksWithCompletionHandler:^(NSArray *tasks) {
+        NSMutableSet *runningTransferIdentifiers = [NSMutableSet set];
+        for (NSURLSessionTask *task in tasks) {
+            if (task.taskDescription) {
+                [runningTransferIdentifiers addObject:task.taskDescription];
+            }
+        }
+        
+        @synchronized(self) {
+            BOOL recordsChanged = NO;
+            for (NSString *transferIdentifier in restoredTransferIdentifiers) {
+                NSDictionary *record = self.records[transferIdentifier];
+                if (record && ![record[kCMISTransferRecordFinished] boolValue] && ![runningTransferIdentifiers containsObject:transferIdentifier]) {
+                    CMISLogDebug(@"Background transfer %@ of %@ was interrupted", transferIdentifier, record[kCMISTransferRecordURL]);
+                    self.records[transferIdentifier] = [self interruptedRecord:record];
+                    recordsChanged = YES;
+                }
+            }
+            if (recordsChanged) {
+                [self saveRecords];
+            }
+        }
+    }];
+}
+
+- (NSMutableDictionary *)loadRecords
+{
+    NSMutableDictionary *records = [NSMutableDictionary dictionaryWithContentsOfFile:self.storePath];
+    return records ? records : [[NSMutableDictionary alloc] init];
+}
+
+/// Must be called while synchronized on self
+- (void)saveRecords
+{
+    NSFileManager *fileManager = [NSFileManager defaultManager];
+    NSString *storeDirectory = [self.storePath stringByDeletingLastPathComponent];
+    if (![fileManager fileExistsAtPath:storeDirectory]) {
+        [fileManager createDirectoryAtPath:storeDirectory withIntermediateDirectories:YES attributes:nil error:nil];
+    }
+    
+    if (![self.records writeToFile:self.storePath atomically:YES]) {
+        CMISLogError(@"Could not save background transfer records to %@", self.storePath);
+    }
+}
+
+#pragma mark Session delegate methods
+
+- (void)URLSession:(NSURLSession *)session task:(NSURLSessionTask *)task didCompleteWithError:(NSError *)error
+{
+    CMISHttpRequest *request = [self requestForTask:task];
+    [request URLSession:session task:task didCompleteWithError:error];
+    
+    @synchronized(self) {
+        [self.requestsByTaskIdentifier removeObjectForKey:@(task.taskIdentifier)];
+        
+        NSString *transferIdentifier = task.taskDescription;
+        NSDictionary *record = transferIdentifier ? self.records[transferIdentifier] : nil;
+        if (record) {
+            if (request) {
+                // the request has delivered the outcome so there is nothing left to reattach to
+                [self.records removeObjectForKey:transferIdentifier];
+            } else {
+                // keep the outcome until the transfer is reattached
+                self.records[transferIdentifier] = [self record:record finishedWithTask:task error:error];
+            }
+            [self saveRecords];
+            
+            NSString *bodyFilePath = record[kCMISTransferRecordBodyFilePath];
+            if (bodyFilePath) {
+                [[NSFileManager defaultManager] removeItemAtPath:bodyFilePath error:nil];
+            }
+        }
+    }
+    
+    [self startQueuedTransfers];
+}
+
+- (void)URLSession:(NSURLSession *)session dataTask:(NSURLSessionDataTask *)dataTask didReceiveResponse:(NSURLResponse *)response completionHandler:(void (^)(NSURLSessionResponseDisposition))completionHandler
+{
+    CMISHttpRequest *request = [self requestForTask:dataTask];
+    if (request) {
+        [request URLSession:session dataTask:dataTask didReceiveResponse:response completionHandler:completionHandler];
+    } else {
+        completionHandler(NSURLSessionResponseAllow);
+    }
+}
+
+- (void)URLSession:(NSURLSession *)session dataTask:(NSURLSessionDataTask *)dataTask didReceiveData:(NSData *)data
+{
+    // the response bodies of data tasks without a request are not kept, only their status code is recorded
+    [[self requestForTask:dataTask] URLSession:session dataTask:dataTask didReceiveData:data];
+}
+
+- (void)URLSession:(NSURLSession *)session task:(NSURLSessionTask *)task didSendBodyData:(int64_t)bytesSent totalBytesSent:(int64_t)totalBytesSent totalBytesExpectedToSend:(int64_t)totalBytesExpectedToSend
+{
+    CMISHttpRequest *request = [self requestForTask:task];
+    if ([request respondsToSelector:@selector(URLSession:task:didSendBodyData:totalBytesSent:totalBytesExpectedToSend:)]) {
+        [(id<NSURLSessionTaskDelegate>)request URLSession:session task:task didSendBodyData:bytesSent totalBytesSent:totalBytesSent totalBytesExpectedToSend:totalBytesExpectedToSend];
+    }
+}
+
+- (void)URLSession:(NSURLSession *)session downloadTask:(NSURLSessionDownloadTask *)downloadTask didFinishDownloadingToURL:(NSURL *)location
+{
+    CMISHttpRequest *request = [self requestForTask:downloadTask];
+    if ([request isKindOfClass:[CMISHttpDownloadRequest class]]) {
+        [(CMISHttpDownloadRequest *)request URLSession:session downloadTask:downloadTask didFinishDownloadingToURL:location];
+        return;
+    }
+    
+    // the temporary file is removed once this method returns, move it to the recorded output file path
+    @synchronized(self) {
+        NSString *transferIdentifier = downloadTask.taskDescription;
+        NSDictionary *record = transferIdentifier ? self.records[transferIdentifier] : nil;
+        NSString *outputFilePath = record[kCMISTransferRecordOutputFilePath];
+        if (outputFilePath) {
+            NSFileManager *fileManager = [NSFileManager defaultManager];
+            [fileManager removeItemAtPath:outputFilePath error:nil];
+            if ([fileManager moveItemAtURL:location toURL:[NSURL fileURLWithPath:outputFilePath] error:nil]) {
+                CMISLogDebug(@"Moved downloaded file from %@ to %@", location, outputFilePath);
+            } else {
+                NSMutableDictionary *failedRecord = [record mutableCopy];
+                failedRecord[kCMISTransferRecordErrorCode] = @(kCMISErrorCodeStorage);
+                failedRecord[kCMISTransferRecordErrorDescription] = [NSString stringWithFormat:@"Could not move temporary file to %@", outputFilePath];
+                self.records[transferIdentifier] = failedRecord;
+            }
+        }
+    }
+}
+
+- (void)URLSession:(NSURLSession *)session downloadTask:(NSURLSessionDownloadTask *)downloadTask didWriteData:(int64_t)bytesWritten totalBytesWritten:(int64_t)totalBytesWritten totalBytesExpectedToWrite:(int64_t)totalBytesExpectedToWrite
+{
+    CMISHttpRequest *request = [self requestForTask:downloadTask];
+    if ([request isKindOfClass:[CMISHttpDownloadRequest class]]) {
+        [(CMISHttpDownloadRequest *)request URLSession:session downloadTask:downloadTask didWriteData:bytesWritten totalBytesWritten:totalBytesWritten totalBytesExpectedToWrite:totalBytesExpectedToWrite];
+    }
+}
+
+- (void)URLSession:(NSURLSession *)session downloadTask:(NSURLSessionDownloadTask *)downloadTask didResumeAtOffset:(int64_t)fileOffset expectedTotalBytes:(int64_t)expectedTotalBytes
+{
+    CMISHttpRequest *request = [self requestForTask:downloadTask];
+    if ([request isKindOfClass:[CMISHttpDownloadRequest class]]) {
+        [(CMISHttpDownloadRequest *)request URLSession:session downloadTask:downloadTask didResumeAtOffset:fileOffset expectedTotalBytes:expectedTotalBytes];
+    }
+}
+
+- (void)URLSession:(NSURLSession *)session task:(NSURLSessionTask *)task didFinishCollectingMetrics:(NSURLSessionTaskMetrics *)metrics API_AVAILABLE(ios(10.0), macos(10.12))
+{
+    [[self requestForTask:task] URLSession:session task:task didFinishCollectingMetrics:metrics];
+}
+
+- (void)URLSession:(NSURLSession *)session task:(NSURLSessionTask *)task didReceiveChallenge:(NSURLAuthenticationChallenge *)challenge completionHandler:(void (^)(NSURLSessionAuthChallengeDisposition, NSURLCredential *))completionHandler
+{
+    // challenges are answered by the authentication provider of the session the request was made for
+    CMISHttpRequest *request = [self requestForTask:task];
+    if (request.session.authenticationProvider) {
+        [request URLSession:session didReceiveChallenge:challenge completionHandler:completionHandler];
+    } else {
+        completionHandler(NSURLSessionAuthChallengePerformDefaultHandling, nil);
+    }
+}
+
+- (void)URLSessionDidFinishEventsForBackgroundURLSession:(NSURLSession *)session
+{
+    void (^completionHandler)(void) = self.backgroundEventsCompletionHandler;
+    self.backgroundEventsCompletionHandler = nil;
+    if (completionHandler) {
+        dispatch_async(dispatch_get_main_queue(), completionHandler);
+    }
+}
+
+- (void)URLSession:(NSURLSession *)session didBecomeInvalidWithError:(NSError *)error
+{
+    CMISLogDebug(@"Background network session with identifier '%@' was invalidated", self.identifier);
+}
+
+@end
@@ -0,0 +1,61 @@
+/*
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+ 
+    http://www.apache.org/licenses/LICENSE-2.0
+ 
+  Unless required by applicable law or agreed to in writing,
+  software distributed under the License is distributed on an
+  "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+  KIND, either express or implied.  See the License for the
+  specific language governing permissions and limitations
+  under the License.
+ */
+
+#import <Foundation/Foundation.h>
+
+@class CMISContentSource;
+
+/**
+ * An input stream that reads a prologue, the content of another stream and an epilogue in turn, used to send
+ * multipart request bodies without copying the content into memory.
+ *
+ * When the length of the content is known the stream knows its total length up front and can be reopened to send
+ * the body again, i.e. when the URL session needs a new body stream after a redirect, an authentication challenge or
+ * a retry. The content stream is not closed with this stream so it can be rewound, it has to be closed by its owner.
+ * Content held in memory or mapped from a file is copied straight from its bytes into the reader's buffer.
+ */
+@interface CMISCompositeInputStream : NSInputStream
+
+/// total number of bytes the stream delivers, 0 if the length of the content is unknown
+@property (nonatomic, assign, readonly) unsigned long long length;
+/// number of bytes read from the stream so far
+@property (nonatomic, assign, readonly) unsigned long long bytesRead;
+
+/**
+ * initialises the stream, contentLength is the number of bytes to read from the content stream or 0 to read it
+ * until its end.
+ */
+- (id)initWithPrologue:(NSData *)prologue
+         contentStream:(NSInputStream *)contentStream
+         contentLength:(unsigned long long)contentLength
+              epilogue:(NSData *)epilogue;
+
+/// initialises the stream with the content of a content source, its length is used as the content length
+- (id)initWithPrologue:(NSData *)prologue
+         contentSource:(CMISContentSource *)contentSource
+              epilogue:(NSData *)epilogue;
+
+/**
+ * returns a new, unopened stream delivering the same bytes from the beginning.
+ * Returns nil if the content can't be read again, which is the case if its length is unknown or the content is
+ * neither a rewindable content source nor a file stream.
+ */
+- (CMISCompositeInputStream *)reopenedStream;
+
+@end
@@ -0,0 +1,304 @@
+/*
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+ 
+    http://www.apache.org/licenses/LICENSE-2.0
+ 
+  Unless required by applicable law or agreed to in writing,
+  software distributed under the License is distributed on an
+  "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+  KIND, either express or implied.  See the License for the
+  specific language governing permissions and limitations
+  under the License.
+ */
+
+#import "CMISCompositeInputStream.h"
+#import "CMISContentSource.h"
+#import "CMISErrors.h"
+
+typedef NS_ENUM(NSInteger, CMISCompositeInputStreamPart) {
+    CMISCompositeInputStreamPartPrologue = 0,
+    CMISCompositeInputStreamPartContent,
+    CMISCompositeInputStreamPartEpilogue,
+    CMISCompositeInputStreamPartDone
+};
+
+@interface CMISCompositeInputStream ()
+
+@property (nonatomic, strong) NSData *prologue;
+@property (nonatomic, strong) NSInputStream *contentStream;
+@property (nonatomic, strong) CMISContentSource *contentSource;
+@property (nonatomic, strong) NSData *contentData;
+@property (nonatomic, assign) unsigned long long contentLength;
+@property (nonatomic, strong) NSData *epilogue;
+@property (nonatomic, strong) NSNumber *contentStartOffset;
+@property (nonatomic, assign) CMISCompositeInputStreamPart part;
+@property (nonatomic, assign) unsigned long long partOffset;
+@property (nonatomic, assign, readwrite) unsigned long long bytesRead;
+@property (nonatomic, assign) NSStreamStatus status;
+@property (nonatomic, strong) NSError *error;
+@property (nonatomic, weak) id<NSStreamDelegate> streamDelegate;
+
+@end
+
+@implementation CMISCompositeInputStream
+
+- (id)initWithPrologue:(NSData *)prologue
+         contentStream:(NSInputStream *)contentStream
+         contentLength:(unsigned long long)contentLength
+              epilogue:(NSData *)epilogue
+{
+    self = [super init];
+    if (self) {
+        _prologue = prologue;
+        _contentStream = contentStream;
+        _contentLength = contentLength;
+        _epilogue = epilogue;
+        _part = CMISCompositeInputStreamPartPrologue;
+        _status = NSStreamStatusNotOpen;
+    }
+    return self;
+}
+
+- (id)initWithPrologue:(NSData *)prologue
+         contentSource:(CMISContentSource *)contentSource
+              epilogue:(NSData *)epilogue
+{
+    // content with bytes at hand is copied from them, anything else is read from a stream of the source
+    NSData *contentData = contentSource.data;
+    self = [self initWithPrologue:prologue
+                    contentStream:(contentData ? nil : [contentSource inputStream])
+                    contentLength:(contentData ? contentData.length : contentSource.length)
+                         epilogue:epilogue];
+    if (self) {
+        _contentSource = contentSource;
+        _contentData = contentData;
+    }
+    return self;
+}
+
+- (unsigned long long)length
+{
+    if (self.contentStream && self.contentLength == 0) {
+        return 0;
+    }
+    return self.prologue.length + self.contentLength + self.epilogue.length;
+}
+
+- (CMISCompositeInputStream *)reopenedStream
+{
+    if (self.contentSource.isRewindable) {
+        return [[CMISCompositeInputStream alloc] initWithPrologue:self.prologue contentSource:self.contentSource epilogue:self.epilogue];
+    }
+    
+    if (self.status != NSStreamStatusNotOpen) {
+        // the content can only be read again if this stream hasn't run over its end and it can be rewound
+        BOOL canRewind = self.contentStream == nil ||
+                         (self.contentLength > 0 && self.contentStartOffset != nil && self.contentStream.streamStatus == NSStreamStatusOpen);
+        if (!canRewind) {
+            return nil;
+        }
+    }
+    
+    CMISCompositeInputStream *stream = [[CMISCompositeInputStream alloc] initWithPrologue:self.prologue
+                                                                            contentStream:self.contentStream
+                                                                            contentLength:self.contentLength
+                                                                                 epilogue:self.epilogue];
+    stream.contentStartOffset = self.contentStartOffset;
+    return stream;
+}
+
+#pragma mark NSStream methods
+
+- (void)open
+{
+    if (self.status != NSStreamStatusNotOpen) {
+        return;
+    }
+    self.status = NSStreamStatusOpening;
+    
+    if (self.contentStream) {
+        if (self.contentStream.streamStatus == NSStreamStatusNotOpen) {
+            [self.contentStream open];
+        }
+        
+        if (self.contentStartOffset) {
+            // reopened stream, go back to where the content started
+            if (![self.contentStream setProperty:self.contentStartOffset forKey:NSStreamFileCurrentOffsetKey]) {
+                self.error = [CMISErrors createCMISErrorWithCode:kCMISErrorCodeStorage detailedDescription:@"Could not rewind the content stream"];
+                self.status = NSStreamStatusError;
+                return;
+            }
+        } else {
+            // only file streams have an offset, others can't be rewound
+            self.contentStartOffset = [self.contentStream propertyForKey:NSStreamFileCurrentOffsetKey];
+        }
+    }
+    
+    self.status = NSStreamStatusOpen;
+}
+
+- (void)close
+{
+    // streams of rewindable sources are opened for this stream alone, a reopened stream gets its own
+    if (self.contentSource.isRewindable) {
+        [self.contentStream close];
+    }
+    self.status = NSStreamStatusClosed;
+}
+
+- (id<NSStreamDelegate>)delegate
+{
+    return self.streamDelegate;
+}
+
+- (void)setDelegate:(id<NSStreamDelegate>)delegate
+{
+    self.streamDelegate = delegate;
+}
+
+- (NSStreamStatus)streamStatus
+{
+    return self.status;
+}
+
+- (NSError *)streamError
+{
+    return self.error;
+}
+
+- (void)scheduleInRunLoop:(NSRunLoop *)aRunLoop forMode:(NSString *)mode
+{
+    // reads never block on the network so there are no events to deliver
+}
+
+- (void)removeFromRunLoop:(NSRunLoop *)aRunLoop forMode:(NSString *)mode
+{
+}
+
+- (id)propertyForKey:(NSString *)key
+{
+    return nil;
+}
+
+- (BOOL)setProperty:(id)property forKey:(NSString *)key
+{
+    return NO;
+}
+
+#pragma mark NSInputStream methods
+
+- (NSInteger)read:(uint8_t *)buffer maxLength:(NSUInteger)maxLength
+{
+    if (self.status == NSStreamStatusAtEnd) {
+        return 0;
+    } else if (self.status != NSStreamStatusOpen) {
+        return -1;
+    }
+    
+    NSUInteger totalBytesRead = 0;
+    while (totalBytesRead < maxLength && self.part != CMISCompositeInputStreamPartDone) {
+        NSUInteger available = maxLength - totalBytesRead;
+        
+        if (self.part == CMISCompositeInputStreamPartContent && self.contentData) {
+            NSUInteger length = (NSUInteger)MIN((unsigned long long)available, self.contentLength - self.partOffset);
+            if (length > 0) {
+                [self.contentData getBytes:buffer + totalBytesRead range:NSMakeRange((NSUInteger)self.partOffset, length)];
+                totalBytesRead += length;
+                self.partOffset += length;
+            }
+            if (self.partOffset == self.contentLength) {
+                [self moveToNextPart];
+            }
+        } else if (self.part == CMISCompositeInputStreamPartContent) {
+            if (self.contentLength > 0) {
+                available = (NSUInteger)MIN((unsigned long long)available, self.contentLength - self.partOffset);
+            }
+            
+            NSInteger contentBytesRead = 0;
+            if (available > 0 && self.contentStream) {
+                contentBytesRead = [self.contentStream read:buffer + totalBytesRead maxLength:available];
+            }
+            
+            if (contentBytesRead < 0) {
+                self.error = self.contentStream.streamError;
+                self.status = NSStreamStatusError;
+                return -1;
+            } else if (contentBytesRead == 0 && self.contentLength > 0 && self.partOffset < self.contentLength) {
+                // the length was announced in the Content-Length header, sending less would leave the server waiting
+                self.error = [CMISErrors createCMISErrorWithCode:kCMISErrorCodeStorage
+                                             detailedDescription:[NSString stringWithFormat:@"Content stream ended after %llu of %llu bytes", self.partOffset, self.contentLength]];
+                self.status = NSStreamStatusError;
+                return -1;
+            } else if (contentBytesRead == 0) {
+                [self moveToNextPart];
+            } else {
+                totalBytesRead += contentBytesRead;
+                self.partOffset += contentBytesRead;
+                if (self.contentLength > 0 && self.partOffset == self.contentLength) {
+                    // stop before the content stream reaches its end so it can still be rewound
+                    [self moveToNextPart];
+                }
+            }
+        } else {
+            NSData *data = (self.part == CMISCompositeInputStreamPartPrologue) ? self.prologue : self.epilogue;
+            NSUInteger length = (NSUInteger)MIN((unsigned long long)available, data.length - self.partOffset);
+            if (length > 0) {
+                [data getBytes:buffer + totalBytesRead range:NSMakeRange((NSUInteger)self.partOffset, length)];
+                totalBytesRead += length;
+                self.partOffset += length;
+            }
+            if (self.partOffset == data.length) {
+                [self moveToNextPart];
+            }
+        }
+    }
+    
+    self.bytesRead += totalBytesRead;
+    if (self.part == CMISCompositeInputStreamPartDone) {
+        self.status = NSStreamStatusAtEnd;
+    }
+    return totalBytesRead;
+}
+
+- (BOOL)getBuffer:(uint8_t **)buffer length:(NSUInteger *)len
+{
+    return NO;
+}
+
+- (BOOL)hasBytesAvailable
+{
+    return self.status == NSStreamStatusOpen;
+}
+
+#pragma mark Private methods
+
+- (void)moveToNextPart
+{
+    self.part++;
+    self.partOffset = 0;
+}
+
+#pragma mark Core Foundation bridging
+
+// NSURLSession schedules the body stream through the toll-free bridged CFReadStream functions, which call these on NSInputStream subclasses
+
+- (void)_scheduleInCFRunLoop:(CFRunLoopRef)runLoop forMode:(CFStringRef)mode
+{
+}
+
+- (void)_unscheduleFromCFRunLoop:(CFRunLoopRef)runLoop forMode:(CFStringRef)mode
+{
+}
+
+- (BOOL)_setCFClientFlags:(CFOptionFlags)flags callback:(CFReadStreamClientCallBack)callback context:(CFStreamClientContext *)context
+{
+    return NO;
+}
+
+@end
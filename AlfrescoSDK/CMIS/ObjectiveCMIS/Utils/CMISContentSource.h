@@ -0,0 +1,61 @@
+/*
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+ 
+    http://www.apache.org/licenses/LICENSE-2.0
+ 
+  Unless required by applicable law or agreed to in writing,
+  software distributed under the License is distributed on an
+  "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+  KIND, either express or implied.  See the License for the
+  specific language governing permissions and limitations
+  under the License.
+ */
+
+#import <Foundation/Foundation.h>
+
+/**
+ * The content of an upload, which can be a file, data in memory or an arbitrary input stream.
+ *
+ * Files are memory mapped so their bytes are handed to the network layer straight from the page cache, without being
+ * read into intermediate buffers first. Files above the mapping limit, or on volumes that can't be mapped, are read as
+ * a stream instead, never into memory as a whole. Content that can be read again from the start is rewindable, which lets an
+ * upload be sent again after a redirect, an authentication challenge or a transient failure.
+ * A file must not be truncated while it is being uploaded from its mapping.
+ */
+@interface CMISContentSource : NSObject
+
+/// number of bytes of content, 0 if the length is unknown
+@property (nonatomic, assign, readonly) unsigned long long length;
+/// YES if the content can be read again from the start
+@property (nonatomic, assign, readonly, getter = isRewindable) BOOL rewindable;
+/// the content as contiguous bytes, memory mapped for files, nil if the content is only available as a stream
+@property (nonatomic, strong, readonly) NSData *data;
+
+/**
+ * returns a source for the content of the file, which is memory mapped if it is no larger than 256 MB and the file
+ * system allows it, and read as a stream otherwise. Returns nil if the file can't be opened.
+ */
++ (CMISContentSource *)contentSourceWithFileAtPath:(NSString *)filePath error:(NSError **)outError;
+
+/// as above, files larger than mappingLimit bytes are read as a stream
++ (CMISContentSource *)contentSourceWithFileAtPath:(NSString *)filePath mappingLimit:(unsigned long long)mappingLimit error:(NSError **)outError;
+
+/// returns a source for data in memory
++ (CMISContentSource *)contentSourceWithData:(NSData *)data;
+
+/// returns a source for an input stream, length is the number of bytes the stream delivers or 0 if unknown
++ (CMISContentSource *)contentSourceWithInputStream:(NSInputStream *)inputStream length:(unsigned long long)length;
+
+/**
+ * returns a stream reading the content. Rewindable sources return a new, unopened stream reading from the start,
+ * stream sources return their stream.
+ */
+- (NSInputStream *)inputStream;
+
+@end
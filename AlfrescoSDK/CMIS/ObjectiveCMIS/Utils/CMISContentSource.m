@@ -0,0 +1,141 @@
+/*
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+ 
+    http://www.apache.org/licenses/LICENSE-2.0
+ 
+  Unless required by applicable law or agreed to in writing,
+  software distributed under the License is distributed on an
+  "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+  KIND, either express or implied.  See the License for the
+  specific language governing permissions and limitations
+  under the License.
+ */
+
+#import "CMISContentSource.h"
+#import "CMISErrors.h"
+#import "CMISFileUtil.h"
+#import "CMISLog.h"
+#import <fcntl.h>
+#import <sys/mman.h>
+#import <unistd.h>
+
+// larger files are read as a stream rather than taking up that much of the address space
+static unsigned long long const kCMISContentSourceDefaultMappingLimit = 256 * 1024 * 1024;
+
+@interface CMISContentSource ()
+
+@property (nonatomic, assign, readwrite) unsigned long long length;
+@property (nonatomic, strong, readwrite) NSData *data;
+@property (nonatomic, strong) NSString *filePath;
+@property (nonatomic, strong) NSInputStream *stream;
+
+@end
+
+@implementation CMISContentSource
+
++ (CMISContentSource *)contentSourceWithFileAtPath:(NSString *)filePath error:(NSError **)outError
+{
+    return [self contentSourceWithFileAtPath:filePath mappingLimit:kCMISContentSourceDefaultMappingLimit error:outError];
+}
+
++ (CMISContentSource *)contentSourceWithFileAtPath:(NSString *)filePath mappingLimit:(unsigned long long)mappingLimit error:(NSError **)outError
+{
+    if (filePath == nil || ![[NSFileManager defaultManager] isReadableFileAtPath:filePath]) {
+        if (outError) {
+            *outError = [CMISErrors createCMISErrorWithCode:kCMISErrorCodeInvalidArgument
+                                        detailedDescription:[NSString stringWithFormat:@"Could not find file %@", filePath]];
+        }
+        return nil;
+    }
+    
+    NSError *fileError = nil;
+    unsigned long long length = [CMISFileUtil fileSizeForFileAtPath:filePath error:&fileError];
+    if (fileError) {
+        if (outError) {
+            *outError = [CMISErrors cmisError:fileError cmisErrorCode:kCMISErrorCodeStorage];
+        }
+        return nil;
+    }
+    
+    CMISContentSource *contentSource = [[self alloc] init];
+    contentSource.length = length;
+    if (length <= mappingLimit) {
+        contentSource.data = [self mappedDataOfFileAtPath:filePath length:length];
+    } else {
+        CMISLogDebug(@"File %@ of %llu bytes is above the mapping limit, reading it as a stream", filePath, length);
+    }
+    if (contentSource.data == nil) {
+        contentSource.filePath = filePath;
+    }
+    return contentSource;
+}
+
++ (CMISContentSource *)contentSourceWithData:(NSData *)data
+{
+    CMISContentSource *contentSource = [[self alloc] init];
+    contentSource.data = [data copy];
+    contentSource.length = data.length;
+    return contentSource;
+}
+
++ (CMISContentSource *)contentSourceWithInputStream:(NSInputStream *)inputStream length:(unsigned long long)length
+{
+    CMISContentSource *contentSource = [[self alloc] init];
+    contentSource.stream = inputStream;
+    contentSource.length = length;
+    return contentSource;
+}
+
+#pragma mark - Private methods
+
+// maps the file with mmap rather than NSDataReadingMappedIfSafe, which quietly reads files it decides not to map into memory.
+// Returns nil if the file can't be mapped, e.g. because its volume doesn't support it or the address space is exhausted.
++ (NSData *)mappedDataOfFileAtPath:(NSString *)filePath length:(unsigned long long)length
+{
+    if (length == 0) {
+        return [NSData data]; // mmap refuses empty mappings
+    }
+    if (length > NSUIntegerMax) {
+        return nil;
+    }
+    
+    int fileDescriptor = open(filePath.fileSystemRepresentation, O_RDONLY);
+    if (fileDescriptor < 0) {
+        CMISLogDebug(@"Could not open file %@ for mapping, reading it as a stream: %s", filePath, strerror(errno));
+        return nil;
+    }
+    void *bytes = mmap(NULL, (size_t)length, PROT_READ, MAP_FILE | MAP_SHARED, fileDescriptor, 0);
+    int mappingErrno = errno;
+    close(fileDescriptor); // the mapping holds its own reference to the file
+    if (bytes == MAP_FAILED) {
+        CMISLogDebug(@"Could not map file %@, reading it as a stream: %s", filePath, strerror(mappingErrno));
+        return nil;
+    }
+    
+    return [[NSData alloc] initWithBytesNoCopy:bytes length:(NSUInteger)length deallocator:^(void *mappedBytes, NSUInteger mappedLength) {
+        munmap(mappedBytes, mappedLength);
+    }];
+}
+
+- (BOOL)isRewindable
+{
+    return self.data != nil || self.filePath != nil;
+}
+
+- (NSInputStream *)inputStream
+{
+    if (self.data) {
+        return [NSInputStream inputStreamWithData:self.data];
+    } else if (self.filePath) {
+        return [NSInputStream inputStreamWithFileAtPath:self.filePath];
+    }
+    return self.stream;
+}
+
+@end
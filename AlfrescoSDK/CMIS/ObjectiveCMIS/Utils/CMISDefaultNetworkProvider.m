@@ -18,11 +18,13 @@
 #import "CMISHttpDownloadRequest.h"
 #import "CMISHttpUploadRequest.h"
 #import "CMISLog.h"
+#import "CMISRequestMetrics.h"
 
 @interface CMISDefaultNetworkProvider ()
 + (NSMutableURLRequest *)createRequestForUrl:(NSURL *)url
                                   httpMethod:(CMISHttpRequestMethod)httpRequestMethod
-                                     session:(CMISBindingSession *)session;
+                                     session:(CMISBindingSession *)session
+                                 cmisRequest:(CMISRequest *)cmisRequest;
 @end
 
 @implementation CMISDefaultNetworkProvider
@@ -39,7 +41,8 @@ completionBlock:(void (^)(CMISHttpResponse *httpResponse, NSError *error))comple
 {
     NSMutableURLRequest *urlRequest = [CMISDefaultNetworkProvider createRequestForUrl:url
                                                                            httpMethod:httpRequestMethod
-                                                                              session:session];
+                                                                              session:session
+                                                                          cmisRequest:cmisRequest];
     if (!cmisRequest.isCancelled)
     {
         CMISHttpRequest* request = [CMISHttpRequest startRequest:urlRequest
@@ -71,7 +74,8 @@ completionBlock:(void (^)(CMISHttpResponse *httpResponse, NSError *error))comple
     if (!cmisRequest.isCancelled) {
         NSMutableURLRequest *urlRequest = [CMISDefaultNetworkProvider createRequestForUrl:url
                                                                                httpMethod:httpRequestMethod
-                                                                                  session:session];
+                                                                                  session:session
+                                                                              cmisRequest:cmisRequest];
         
         CMISHttpUploadRequest* request = [CMISHttpUploadRequest startRequest:urlRequest
                                                                   httpMethod:httpRequestMethod
@@ -106,7 +110,8 @@ completionBlock:(void (^)(CMISHttpResponse *httpResponse, NSError *error))comple
     if (!cmisRequest.isCancelled) {
         NSMutableURLRequest *urlRequest = [CMISDefaultNetworkProvider createRequestForUrl:url
                                                                                httpMethod:httpRequestMethod
-                                                                                  session:session];
+                                                                                  session:session
+                                                                              cmisRequest:cmisRequest];
         
         CMISHttpUploadRequest* request = [CMISHttpUploadRequest startRequest:urlRequest
                                                                   httpMethod:httpRequestMethod
@@ -143,7 +148,8 @@ completionBlock:(void (^)(CMISHttpResponse *, NSError *))completionBlock
     if (!cmisRequest.isCancelled) {
         NSMutableURLRequest *urlRequest = [CMISDefaultNetworkProvider createRequestForUrl:url
                                                                                httpMethod:httpRequestMethod
-                                                                                  session:session];
+                                                                                  session:session
+                                                                              cmisRequest:cmisRequest];
         
         CMISHttpUploadRequest* request = [CMISHttpUploadRequest startRequest:urlRequest
                                                                   httpMethod:httpRequestMethod
@@ -167,6 +173,45 @@ completionBlock:(void (^)(CMISHttpResponse *, NSError *))completionBlock
     }
 }
 
+- (void)invoke:(NSURL *)url
+    httpMethod:(CMISHttpRequestMethod)httpRequestMethod
+       session:(CMISBindingSession *)session
+ contentSource:(CMISContentSource *)contentSource
+       headers:(NSDictionary *)additionalHeaders
+   cmisRequest:(CMISRequest *)cmisRequest
+     startData:(NSData *)startData
+       endData:(NSData *)endData
+useBase64Encoding:(BOOL)useBase64Encoding
+completionBlock:(void (^)(CMISHttpResponse *, NSError *))completionBlock
+ progressBlock:(void (^)(unsigned long long, unsigned long long))progressBlock
+{
+    if (!cmisRequest.isCancelled) {
+        NSMutableURLRequest *urlRequest = [CMISDefaultNetworkProvider createRequestForUrl:url
+                                                                               httpMethod:httpRequestMethod
+                                                                                  session:session
+                                                                              cmisRequest:cmisRequest];
+        
+        CMISHttpUploadRequest* request = [CMISHttpUploadRequest startRequest:urlRequest
+                                                                  httpMethod:httpRequestMethod
+                                                               contentSource:contentSource
+                                                                     headers:additionalHeaders
+                                                                     session:session
+                                                                   startData:startData
+                                                                     endData:endData
+                                                           useBase64Encoding:useBase64Encoding
+                                                             completionBlock:completionBlock
+                                                               progressBlock:progressBlock];
+        if (request){
+            cmisRequest.httpRequest = request;
+        }
+    } else {
+        if (completionBlock) {
+            completionBlock(nil, [CMISErrors createCMISErrorWithCode:kCMISErrorCodeCancelled
+                                                 detailedDescription:@"Request was cancelled"]);
+        }
+    }
+}
+
 - (void)invoke:(NSURL *)url
     httpMethod:(CMISHttpRequestMethod)httpRequestMethod
        session:(CMISBindingSession *)session
@@ -179,7 +224,8 @@ completionBlock:(void (^)(CMISHttpResponse *httpResponse, NSError *error))comple
     if (!cmisRequest.isCancelled) {
         NSMutableURLRequest *urlRequest = [CMISDefaultNetworkProvider createRequestForUrl:url
                                                                                httpMethod:HTTP_GET
-                                                                                  session:session];
+                                                                                  session:session
+                                                                              cmisRequest:cmisRequest];
         
         CMISHttpDownloadRequest* request = [CMISHttpDownloadRequest startRequest:urlRequest
                                                                       httpMethod:httpRequestMethod
@@ -235,7 +281,8 @@ completionBlock:(void (^)(CMISHttpResponse *httpResponse, NSError *error))comple
     if (!cmisRequest.isCancelled) {
         NSMutableURLRequest *urlRequest = [CMISDefaultNetworkProvider createRequestForUrl:url
                                                                                httpMethod:HTTP_GET
-                                                                                  session:session];
+                                                                                  session:session
+                                                                              cmisRequest:cmisRequest];
         
         CMISHttpDownloadRequest* request = [CMISHttpDownloadRequest startRequest:urlRequest
                                                                       httpMethod:httpRequestMethod
@@ -322,6 +369,7 @@ completionBlock:(void (^)(CMISHttpResponse *httpResponse, NSError *error))comple
 + (NSMutableURLRequest *)createRequestForUrl:(NSURL *)url
                                   httpMethod:(CMISHttpRequestMethod)httpRequestMethod
                                      session:(CMISBindingSession *)session
+                                 cmisRequest:(CMISRequest *)cmisRequest
 {
     NSNumber *timeout = [session objectForKey:kCMISSessionParameterRequestTimeout defaultValue:@(60)];
     
@@ -357,6 +405,9 @@ completionBlock:(void (^)(CMISHttpResponse *httpResponse, NSError *error))comple
         request.HTTPShouldHandleCookies = NO;
     }
     
+    // the metrics are created as the request starts, before the CMIS request gets hold of it
+    [CMISRequestMetrics setOperationName:cmisRequest.operationName forRequest:request];
+    
     return request;
 }
 
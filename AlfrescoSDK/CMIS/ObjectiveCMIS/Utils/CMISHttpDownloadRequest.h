@@ -58,6 +58,12 @@
    completionBlock:(void (^)(CMISHttpResponse *httpResponse, NSError *error))completionBlock
      progressBlock:(void (^)(unsigned long long bytesDownloaded, unsigned long long bytesTotal))progressBlock;
 
+/** initialises with a specified HTTP method, used to reattach to background transfers
+ */
+- (id)initWithHttpMethod:(CMISHttpRequestMethod)httpRequestMethod
+         completionBlock:(void (^)(CMISHttpResponse *httpResponse, NSError *error))completionBlock
+           progressBlock:(void (^)(unsigned long long bytesDownloaded, unsigned long long bytesTotal))progressBlock;
+
 /** starts a URL request for download. Data is written to the provided file path.
  * completionBlock returns a CMISHttpResponse object or nil if unsuccessful
  */
@@ -28,10 +28,6 @@
 @property (nonatomic, assign) BOOL cancelled;
 @property (nonatomic, strong) NSError *fileCopyError;
 
-- (id)initWithHttpMethod:(CMISHttpRequestMethod)httpRequestMethod
-         completionBlock:(void (^)(CMISHttpResponse *httpResponse, NSError *error))completionBlock
-           progressBlock:(void (^)(unsigned long long bytesDownloaded, unsigned long long bytesTotal))progressBlock;
-
 @end
 
 
@@ -129,6 +125,18 @@
     return self;
 }
 
+- (BOOL)canRetry
+{
+    // the received data has already been passed on to the output stream or file
+    return NO;
+}
+
+- (BOOL)canCacheResponse
+{
+    // content is streamed to its destination rather than held in memory
+    return NO;
+}
+
 - (NSURLSessionTask *)taskForRequest:(NSURLRequest *)request
 {
     if (self.outputFilePath) {
@@ -181,7 +189,7 @@
             NSUInteger written = [self.outputStream write:&bytes[offset] maxLength:length - offset];
             if (written <= 0) {
                 CMISLogError(@"Error while writing downloaded data to stream");
-                [session invalidateAndCancel];
+                [self cancelTransfer];
                 return;
             } else {
                 offset += written;
@@ -192,10 +200,11 @@
     // update statistics
     self.bytesDownloaded += data.length;
     
-    // pass progress to progressBlock, on the original thread
-    if (self.originalThread) {
-        [self performSelector:@selector(executeProgressBlock:) onThread:self.originalThread withObject:@[@(self.bytesDownloaded), @(self.bytesExpected)] waitUntilDone:NO];
-    }
+    // pass progress to progressBlock, on the callback queue or the original thread
+    NSArray *progress = @[@(self.bytesDownloaded), @(self.bytesExpected)];
+    [self performCallback:^{
+        [self executeProgressBlock:progress];
+    }];
 }
 
 - (void)URLSession:(NSURLSession *)session dataTask:(NSURLSessionDataTask *)dataTask didReceiveResponse:(NSURLResponse *)response completionHandler:(void (^)(NSURLSessionResponseDisposition))completionHandler
@@ -219,17 +228,17 @@
         if (isStreamReady) {
             [super URLSession:session dataTask:dataTask didReceiveResponse:response completionHandler:completionHandler];
         } else {
-            [session invalidateAndCancel];
+            [self cancelTransfer];
             
             if (self.completionBlock)
             {
                 NSError *cmisError = [CMISErrors createCMISErrorWithCode:kCMISErrorCodeStorage
                                                      detailedDescription:@"Could not open output stream"];
                 
-                // call the completion block on the original thread
-                if (self.originalThread) {
-                    [self performSelector:@selector(executeCompletionBlockError:) onThread:self.originalThread withObject:cmisError waitUntilDone:NO];
-                }
+                // call the completion block on the callback queue or the original thread
+                [self performCallback:^{
+                    [self executeCompletionBlockError:cmisError];
+                }];
             }
         }
     }
@@ -267,10 +276,11 @@
         if (totalBytesExpected == NSURLSessionTransferSizeUnknown && self.bytesExpected != 0) {
             totalBytesExpected = self.bytesExpected;
         }
-        // pass progress to progressBlock, on the original thread
-        if (self.originalThread) {
-            [self performSelector:@selector(executeProgressBlock:) onThread:self.originalThread withObject:@[@(totalBytesWritten), @(totalBytesExpected)] waitUntilDone:NO];
-        }
+        // pass progress to progressBlock, on the callback queue or the original thread
+        NSArray *progress = @[@(totalBytesWritten), @(totalBytesExpected)];
+        [self performCallback:^{
+            [self executeProgressBlock:progress];
+        }];
     }
 }
 
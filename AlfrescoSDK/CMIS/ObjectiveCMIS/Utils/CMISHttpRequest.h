@@ -22,6 +22,8 @@
 #import "CMISNetworkProvider.h"
 #import "CMISRequest.h"
 @class CMISAuthenticationProvider;
+@class CMISRequestMetrics;
+@class CMISBackgroundTransferManager;
 
 @interface CMISHttpRequest : NSObject <CMISCancellableRequest, NSURLSessionDelegate, NSURLSessionTaskDelegate, NSURLSessionDataDelegate>
 
@@ -35,6 +37,20 @@
 @property (nonatomic, strong) CMISBindingSession *session;
 @property (nonatomic, copy) void (^completionBlock)(CMISHttpResponse *httpResponse, NSError *error);
 @property (nonatomic, weak) NSThread *originalThread;
+/// The queue the completion and progress blocks are called on instead of the original thread, taken from the session's
+/// kCMISSessionParameterCallbackQueue parameter when the request starts
+@property (nonatomic, strong) dispatch_queue_t callbackQueue;
+/// The metrics of the request, nil unless a metrics observer is set for the session
+@property (nonatomic, strong) CMISRequestMetrics *metrics;
+/// The priority of the request, requests with higher values start first when queued for a background transfer and
+/// get a higher NSURLSessionTask priority, can be changed while the request is in flight
+@property (nonatomic, assign) NSInteger priority;
+/// Identifies the background transfer of the request across relaunches, nil unless a background network session is used
+@property (nonatomic, strong) NSString *transferIdentifier;
+/// The manager running the request, nil unless a background network session is used
+@property (nonatomic, weak) CMISBackgroundTransferManager *transferManager;
+/// YES once the last attempt of the request has completed, NO while a retry or a replay with renewed credentials is pending
+@property (nonatomic, assign, readonly, getter = isFinished) BOOL finished;
 
 /**
  * starts a URL request for given HTTP method 
@@ -59,9 +75,30 @@
 /// starts the URL request
 - (BOOL)startRequest:(NSMutableURLRequest*)urlRequest;
 
+/// Returns the NSURLSessionTask priority for the given request priority, 0 maps to NSURLSessionTaskPriorityDefault
++ (float)taskPriorityForPriority:(NSInteger)priority;
+
+/// Returns YES if the request can be sent again when it fails, the body of streamed uploads and downloads can't be replayed
+- (BOOL)canRetry;
+
+/// Returns YES if the response can be kept in the session's response cache, only whole responses held in memory can be
+- (BOOL)canCacheResponse;
+
 /// Creates an appropriate task for the given request object.
 - (NSURLSessionTask *)taskForRequest:(NSURLRequest *)request;
 
+/// Resumes the session task, or calls the completion block with an error if no task could be created for the given request.
+- (BOOL)resumeTaskForRequest:(NSURLRequest *)urlRequest;
+
+/// Cancels the session task, the URL session is invalidated unless it is shared by a background transfer manager
+- (void)cancelTransfer;
+
+/// Checks the status code of the response is expected for the HTTP method, returns NO and sets error if not
+- (BOOL)checkStatusCodeForResponse:(CMISHttpResponse *)response httpRequestMethod:(CMISHttpRequestMethod)httpRequestMethod error:(NSError **)error;
+
+/// Calls the block on the callback queue, or on the original thread if there is no callback queue and the thread is still running
+- (void)performCallback:(void (^)(void))callback;
+
 /// Call completion block with response returned from server
 - (void)executeCompletionBlockResponse:(CMISHttpResponse*)response;
 
@@ -23,6 +23,10 @@
 #import "CMISLog.h"
 #import "CMISReachability.h"
 #import "CMISConstants.h"
+#import "CMISRequestMetrics.h"
+#import "CMISBackgroundTransferManager.h"
+#import "CMISRetryPolicy.h"
+#import "CMISHttpResponseCache.h"
 
 //Exception names as returned in the <!--exception> tag
 NSString * const kCMISExceptionInvalidArgument         = @"invalidArgument";
@@ -39,6 +43,18 @@ NSString * const kCMISExceptionStreamNotSupported      = @"streamNotSupported";
 NSString * const kCMISExceptionUpdateConflict          = @"updateConflict";
 NSString * const kCMISExceptionVersioning              = @"versioning";
 
+@interface CMISHttpRequest ()
+@property (nonatomic, strong) id<CMISRequestMetricsObserver> metricsObserver;
+@property (nonatomic, strong) id<CMISRetryPolicy> retryPolicy;
+@property (nonatomic, strong) NSURLRequest *urlRequest;
+@property (nonatomic, assign) NSUInteger attempt;
+@property (nonatomic, assign) BOOL waitingToRetry;
+@property (nonatomic, assign) BOOL renewedCredentials;
+@property (nonatomic, assign, readwrite, getter = isFinished) BOOL finished;
+@property (nonatomic, strong) CMISHttpResponseCache *responseCache;
+@property (nonatomic, strong) NSCachedURLResponse *cachedResponse;
+@end
+
 @implementation CMISHttpRequest
 
 
@@ -78,6 +94,17 @@ NSString * const kCMISExceptionVersioning              = @"versioning";
 
 - (BOOL)startRequest:(NSMutableURLRequest*)urlRequest
 {
+    if (!self.callbackQueue) {
+        self.callbackQueue = [self.session objectForKey:kCMISSessionParameterCallbackQueue];
+    }
+    
+    // metrics are only collected when an observer has been configured
+    self.metricsObserver = [CMISRequestMetrics observerFromParameter:[self.session objectForKey:kCMISSessionParameterRequestMetricsObserver]];
+    if (self.metricsObserver) {
+        self.metrics = [[CMISRequestMetrics alloc] initWithURL:urlRequest.URL httpMethod:urlRequest.HTTPMethod];
+        self.metrics.operationName = [CMISRequestMetrics operationNameForRequest:urlRequest];
+    }
+    
     // check network reachability (unless it's disabled) and return early if appropriate
     id checkNetworkReachability = [self.session objectForKey:kCMISSessionParameterCheckNetworkReachability];
     if (!checkNetworkReachability || [checkNetworkReachability boolValue]) {
@@ -89,8 +116,6 @@ NSString * const kCMISExceptionVersioning              = @"versioning";
         }
     }
     
-    BOOL startedRequest = NO;
-    
     if (self.requestBody) {
         if ([CMISLog sharedInstance].logLevel == CMISLogLevelTrace) {
             CMISLogTrace(@"Request body: %@", [[NSString alloc] initWithData:self.requestBody encoding:NSUTF8StringEncoding]);
@@ -113,34 +138,84 @@ NSString * const kCMISExceptionVersioning              = @"versioning";
         }
     }];
     
-    // determine the type of session configuration to create
-    NSURLSessionConfiguration *sessionConfiguration = nil;
-    id useBackgroundSession = [self.session objectForKey:kCMISSessionParameterUseBackgroundNetworkSession];
-    if (useBackgroundSession && [useBackgroundSession boolValue]) {
-        // get session and container identifiers from session
-        NSString *backgroundId = [self.session objectForKey:kCMISSessionParameterBackgroundNetworkSessionId
-                                               defaultValue:kCMISDefaultBackgroundNetworkSessionId];
-        NSString *containerId = [self.session objectForKey:kCMISSessionParameterBackgroundNetworkSessionSharedContainerId
-                                              defaultValue:kCMISDefaultBackgroundNetworkSessionSharedContainerId];
-        
-        // use the background session configuration, cache settings and timeout will be provided by the request object
-        sessionConfiguration = [NSURLSessionConfiguration backgroundSessionConfigurationWithIdentifier:backgroundId];
-        sessionConfiguration.sharedContainerIdentifier = containerId;
-        
-        CMISLogDebug(@"Using background network session with identifier '%@' and shared container '%@'",
-                     backgroundId, containerId);
+    self.urlRequest = urlRequest;
+    
+    // GET requests are made conditional if a response with validators is cached for them
+    if ([self canCacheResponse]) {
+        self.responseCache = [CMISHttpResponseCache responseCacheFromParameter:[self.session objectForKey:kCMISSessionParameterResponseCache]];
+        self.cachedResponse = [self.responseCache prepareConditionalRequest:urlRequest user:self.session.username];
     }
-    else {
-        // use the default session configuration, cache settings and timeout will be provided by the request object
-        sessionConfiguration = [NSURLSessionConfiguration defaultSessionConfiguration];
+    
+    // background transfers share one session per identifier, the manager starts them as slots become free
+    CMISBackgroundTransferManager *transferManager = [CMISBackgroundTransferManager transferManagerForSession:self.session];
+    if (transferManager) {
+        [transferManager enqueueRequest:self urlRequest:urlRequest];
+        return YES;
     }
     
+    // failed requests are sent again if a retry policy is set, its circuit breaker may fail them without sending them at all
+    if ([self canRetry]) {
+        self.retryPolicy = [CMISDefaultRetryPolicy retryPolicyFromParameter:[self.session objectForKey:kCMISSessionParameterRetryPolicy]];
+    }
+    self.attempt = 1;
+    if (self.retryPolicy && ![self.retryPolicy shouldAttemptRequest:urlRequest]) {
+        [self URLSession:self.urlSession task:self.sessionTask didCompleteWithError:[self circuitOpenErrorForRequest:urlRequest]];
+        return NO;
+    }
+    
+    // use the default session configuration, cache settings and timeout will be provided by the request object
+    NSURLSessionConfiguration *sessionConfiguration = [NSURLSessionConfiguration defaultSessionConfiguration];
+    
     // create session and task
     self.urlSession = [NSURLSession sessionWithConfiguration:sessionConfiguration delegate:self delegateQueue:nil];
     self.sessionTask = [self taskForRequest:urlRequest];
     
+    return [self resumeTaskForRequest:urlRequest];
+}
+
+- (BOOL)canRetry
+{
+    return YES;
+}
+
+- (BOOL)canCacheResponse
+{
+    return self.requestMethod == HTTP_GET;
+}
+
++ (float)taskPriorityForPriority:(NSInteger)priority
+{
+    // each step up or down is a quarter of the range, so the named priority classes map to high, default and low
+    return MAX(0.0f, MIN(1.0f, NSURLSessionTaskPriorityDefault + 0.25f * priority));
+}
+
+- (void)setPriority:(NSInteger)priority
+{
+    if (_priority == priority) {
+        return;
+    }
+    _priority = priority;
+    
+    NSURLSessionTask *task = self.sessionTask;
+    if (task) {
+        task.priority = [CMISHttpRequest taskPriorityForPriority:priority];
+    }
+    [self.transferManager reprioritizeRequest:self];
+}
+
+- (BOOL)resumeTaskForRequest:(NSURLRequest *)urlRequest
+{
+    BOOL startedRequest = NO;
+    
     if (self.sessionTask) {
-        // start the task
+        // start the task, retries are part of the same request as far as the metrics are concerned
+        if (self.metrics && !self.metrics.startDate) {
+            self.metrics.startDate = [NSDate date];
+            if ([self.metricsObserver respondsToSelector:@selector(requestWillStartWithMetrics:)]) {
+                [self.metricsObserver requestWillStartWithMetrics:self.metrics];
+            }
+        }
+        self.sessionTask.priority = [CMISHttpRequest taskPriorityForPriority:self.priority];
         [self.sessionTask resume];
         startedRequest = YES;
     } else {
@@ -163,20 +238,45 @@ NSString * const kCMISExceptionVersioning              = @"versioning";
 
 - (void)cancel
 {
-    if (self.urlSession) {
+    BOOL wasWaitingToRetry;
+    @synchronized(self) {
+        wasWaitingToRetry = self.waitingToRetry;
+        self.waitingToRetry = NO;
+    }
+    
+    if (self.urlSession || wasWaitingToRetry) {
         void (^completionBlock)(CMISHttpResponse *httpResponse, NSError *error);
         completionBlock = self.completionBlock; // remember completion block in order to invoke it after the connection was cancelled
         
         self.completionBlock = nil; // prevent potential NSURLSession delegate callbacks to invoke the completion block redundantly
         
-        [self.urlSession invalidateAndCancel];
+        // without the completion block the session's callback no longer reaches the policy, the cancelled attempt is reported here
+        BOOL attemptInFlight = !wasWaitingToRetry && self.sessionTask && self.sessionTask.state != NSURLSessionTaskStateCompleted;
+        
+        [self cancelTransfer];
         
         self.urlSession = nil;
         
+        if (attemptInFlight) {
+            [self reportCancelledAttemptToRetryPolicy];
+        }
+        
+        NSError *cmisError = [CMISErrors createCMISErrorWithCode:kCMISErrorCodeCancelled detailedDescription:@"Request was cancelled"];
+        [self.metrics recordCompletionOfTask:self.sessionTask statusCode:self.response.statusCode error:cmisError];
+        
         if (completionBlock) {
-            NSError *cmisError = [CMISErrors createCMISErrorWithCode:kCMISErrorCodeCancelled detailedDescription:@"Request was cancelled"];
             completionBlock(nil, cmisError);
         }
+        [self notifyMetricsObserver];
+    }
+}
+
+- (void)cancelTransfer
+{
+    if (self.transferManager) {
+        [self.transferManager cancelRequest:self];
+    } else {
+        [self.urlSession invalidateAndCancel];
     }
 }
 
@@ -185,6 +285,19 @@ NSString * const kCMISExceptionVersioning              = @"versioning";
 - (void)URLSession:(NSURLSession *)session task:(NSURLSessionTask *)task didCompleteWithError:(NSError *)error
 {
     [self.session.authenticationProvider updateWithHttpURLResponse:self.response];
+    
+    // a request rejected because its credentials expired waits for them to be renewed and is then sent again
+    if (task && self.completionBlock && [self renewCredentialsAfterCompletionWithError:error]) {
+        return;
+    }
+    
+    // the policy is told about every attempt that was actually sent so its circuit breaker sees successes as well as failures
+    if (task && self.retryPolicy && self.completionBlock && [self retryAfterCompletionWithError:error]) {
+        return;
+    }
+    
+    self.finished = YES;
+    [self.metrics recordCompletionOfTask:task statusCode:self.response.statusCode error:error];
 
     if (self.completionBlock) {
         
@@ -203,20 +316,22 @@ NSString * const kCMISExceptionVersioning              = @"versioning";
             
             cmisError = [CMISErrors cmisError:error cmisErrorCode:cmisErrorCode];
         } else {
+            [self applyResponseCache];
+            
             // no error returned but we also need to check response code
             httpResponse = [CMISHttpResponse responseUsingURLHTTPResponse:self.response data:self.responseBody];
             if (![self checkStatusCodeForResponse:httpResponse httpRequestMethod:self.requestMethod error:&cmisError]) {
                 httpResponse = nil;
             }
         }
-        // call the completion block on the original thread
-        if (self.originalThread) {
-            if(cmisError) {
-                [self performSelector:@selector(executeCompletionBlockError:) onThread:self.originalThread withObject:cmisError waitUntilDone:NO];
-            } else {
-                [self performSelector:@selector(executeCompletionBlockResponse:) onThread:self.originalThread withObject:httpResponse waitUntilDone:NO];
-            }
-        }
+        self.metrics.error = cmisError;
+        
+        // call the completion block on the callback queue or the original thread
+        [self performCallback:^{
+            [self executeCompletionBlockResponse:httpResponse error:cmisError];
+        }];
+    } else {
+        [self notifyMetricsObserver];
     }
     
     // clean up
@@ -229,6 +344,162 @@ NSString * const kCMISExceptionVersioning              = @"versioning";
     [self.responseBody appendData:data];
 }
 
+#pragma mark Response cache
+
+- (void)applyResponseCache
+{
+    if (!self.responseCache) {
+        return;
+    }
+    
+    NSCachedURLResponse *cachedResponse = [self.responseCache cachedResponseForNotModifiedResponse:self.response cachedResponse:self.cachedResponse];
+    if (cachedResponse) {
+        // carry on as if the server had sent the cached response again
+        self.response = (NSHTTPURLResponse *)cachedResponse.response;
+        self.responseBody = [cachedResponse.data mutableCopy];
+        self.metrics.notModified = YES;
+    } else {
+        [self.responseCache storeResponse:self.response data:self.responseBody forRequest:self.urlRequest user:self.session.username];
+    }
+}
+
+#pragma mark Credential renewal
+
+- (BOOL)renewCredentialsAfterCompletionWithError:(NSError *)error
+{
+    id<CMISAuthenticationProvider> authenticationProvider = self.session.authenticationProvider;
+    if (error || self.response.statusCode != 401 || self.renewedCredentials || self.transferManager || ![self canRetry] ||
+        ![authenticationProvider respondsToSelector:@selector(renewCredentialsRejectedByResponse:requestHeaders:completionBlock:)]) {
+        return NO;
+    }
+    
+    CMISLogDebug(@"Renewing credentials rejected for %@ %@", self.urlRequest.HTTPMethod, self.urlRequest.URL);
+    self.renewedCredentials = YES; // only once, a request rejected with renewed credentials fails
+    NSHTTPURLResponse *rejectedResponse = self.response;
+    NSMutableData *rejectedResponseBody = self.responseBody;
+    
+    [self.urlSession finishTasksAndInvalidate];
+    @synchronized(self) {
+        self.urlSession = nil;
+        self.sessionTask = nil;
+        self.waitingToRetry = YES;
+    }
+    
+    [authenticationProvider renewCredentialsRejectedByResponse:rejectedResponse
+                                                requestHeaders:self.urlRequest.allHTTPHeaderFields
+                                               completionBlock:^(BOOL renewed) {
+        [self replayWithRenewedCredentials:renewed rejectedResponse:rejectedResponse body:rejectedResponseBody];
+    }];
+    return YES;
+}
+
+- (void)replayWithRenewedCredentials:(BOOL)renewed rejectedResponse:(NSHTTPURLResponse *)rejectedResponse body:(NSMutableData *)rejectedResponseBody
+{
+    @synchronized(self) {
+        if (!self.waitingToRetry) {
+            return; // cancelled while waiting
+        }
+        self.waitingToRetry = NO;
+        
+        if (renewed) {
+            NSMutableURLRequest *urlRequest = [self.urlRequest mutableCopy];
+            [self.session.authenticationProvider.httpHeadersToApply enumerateKeysAndObjectsUsingBlock:^(NSString *headerName, NSString *header, BOOL *stop) {
+                [urlRequest setValue:header forHTTPHeaderField:headerName];
+            }];
+            self.urlRequest = urlRequest;
+            self.response = nil;
+            self.responseBody = nil;
+            
+            NSURLSessionConfiguration *sessionConfiguration = [NSURLSessionConfiguration defaultSessionConfiguration];
+            self.urlSession = [NSURLSession sessionWithConfiguration:sessionConfiguration delegate:self delegateQueue:nil];
+            self.sessionTask = [self taskForRequest:urlRequest];
+        }
+    }
+    
+    if (self.urlSession) {
+        [self resumeTaskForRequest:self.urlRequest];
+    } else {
+        // the credentials could not be renewed, the request fails with the original response
+        self.response = rejectedResponse;
+        self.responseBody = rejectedResponseBody;
+        [self URLSession:nil task:nil didCompleteWithError:nil];
+    }
+}
+
+#pragma mark Retries
+
+- (BOOL)retryAfterCompletionWithError:(NSError *)error
+{
+    NSTimeInterval delay = [self.retryPolicy retryDelayAfterAttempt:self.attempt
+                                                          ofRequest:self.urlRequest
+                                                           response:self.response
+                                                              error:error
+                                                        rateLimited:NO];
+    if (delay < 0) {
+        return NO;
+    }
+    
+    CMISLogDebug(@"Retrying %@ %@ in %.2f seconds after attempt %lu failed with status %ld, error: %@", self.urlRequest.HTTPMethod,
+                 self.urlRequest.URL, delay, (unsigned long)self.attempt, (long)self.response.statusCode, error);
+    self.attempt++;
+    self.metrics.retryCount++;
+    self.metrics.retryWaitDuration += delay;
+    self.response = nil;
+    self.responseBody = nil;
+    
+    // the session of the failed attempt is done with, a new one is created for the retry
+    [self.urlSession finishTasksAndInvalidate];
+    @synchronized(self) {
+        self.urlSession = nil;
+        self.sessionTask = nil;
+        self.waitingToRetry = YES;
+    }
+    
+    dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(delay * NSEC_PER_SEC)), dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
+        [self startRetry];
+    });
+    return YES;
+}
+
+- (void)startRetry
+{
+    @synchronized(self) {
+        if (!self.waitingToRetry) {
+            return; // cancelled while waiting
+        }
+        self.waitingToRetry = NO;
+        
+        if ([self.retryPolicy shouldAttemptRequest:self.urlRequest]) {
+            NSURLSessionConfiguration *sessionConfiguration = [NSURLSessionConfiguration defaultSessionConfiguration];
+            self.urlSession = [NSURLSession sessionWithConfiguration:sessionConfiguration delegate:self delegateQueue:nil];
+            self.sessionTask = [self taskForRequest:self.urlRequest];
+        }
+    }
+    
+    if (self.urlSession) {
+        [self resumeTaskForRequest:self.urlRequest];
+    } else {
+        [self URLSession:nil task:nil didCompleteWithError:[self circuitOpenErrorForRequest:self.urlRequest]];
+    }
+}
+
+- (void)reportCancelledAttemptToRetryPolicy
+{
+    // a cancelled trial request must give its trial back, or the circuit of its host stays open
+    NSError *cancelledError = [NSError errorWithDomain:NSURLErrorDomain code:NSURLErrorCancelled userInfo:nil];
+    [self.retryPolicy retryDelayAfterAttempt:self.attempt
+                                   ofRequest:self.urlRequest
+                                    response:nil
+                                       error:cancelledError
+                                 rateLimited:NO];
+}
+
+- (NSError *)circuitOpenErrorForRequest:(NSURLRequest *)urlRequest
+{
+    NSString *detailedDescription = [NSString stringWithFormat:@"Requests to %@ are failing, not sending %@ until the server recovers", urlRequest.URL.host, urlRequest.URL];
+    return [CMISErrors createCMISErrorWithCode:kCMISErrorCodeConnection detailedDescription:detailedDescription];
+}
+
 - (void)URLSession:(NSURLSession *)session dataTask:(NSURLSessionDataTask *)dataTask didReceiveResponse:(NSURLResponse *)response completionHandler:(void (^)(NSURLSessionResponseDisposition))completionHandler
 {
     self.responseBody = [[NSMutableData alloc] init];
@@ -239,6 +510,11 @@ NSString * const kCMISExceptionVersioning              = @"versioning";
     completionHandler(NSURLSessionResponseAllow);
 }
 
+- (void)URLSession:(NSURLSession *)session task:(NSURLSessionTask *)task didFinishCollectingMetrics:(NSURLSessionTaskMetrics *)metrics API_AVAILABLE(ios(10.0), macos(10.12))
+{
+    [self.metrics recordTaskMetrics:metrics];
+}
+
 - (void)URLSession:(NSURLSession *)session didReceiveChallenge:(NSURLAuthenticationChallenge *)challenge completionHandler:(void (^)(NSURLSessionAuthChallengeDisposition, NSURLCredential *))completionHandler
 {
     [self.session.authenticationProvider didReceiveChallenge:challenge completionHandler:completionHandler];
@@ -324,12 +600,29 @@ NSString * const kCMISExceptionVersioning              = @"versioning";
                                                  detailedDescription:response.errorMessage];
                     }
             }
+
+            // keep the status code so callers can tell server failures from other runtime errors
+            NSMutableDictionary *userInfo = [NSMutableDictionary dictionaryWithDictionary:(*error).userInfo];
+            userInfo[kCMISErrorKeyHTTPStatusCode] = @(response.statusCode);
+            *error = [NSError errorWithDomain:(*error).domain code:(*error).code userInfo:userInfo];
         }
         return NO;
     }
     return YES;
 }
 
+- (void)performCallback:(void (^)(void))callback {
+    if (self.callbackQueue) {
+        dispatch_async(self.callbackQueue, callback);
+    } else if (self.originalThread) {
+        [self performSelector:@selector(executeCallback:) onThread:self.originalThread withObject:[callback copy] waitUntilDone:NO];
+    }
+}
+
+- (void)executeCallback:(void (^)(void))callback {
+    callback();
+}
+
 - (void)executeCompletionBlockResponse:(CMISHttpResponse*)response {
     [self executeCompletionBlockResponse:response error:nil];
 }
@@ -343,7 +636,27 @@ NSString * const kCMISExceptionVersioning              = @"versioning";
         void (^completionBlock)(CMISHttpResponse *httpResponse, NSError *error);
         completionBlock = self.completionBlock;
         self.completionBlock = nil; // Prevent multiple execution if method on this request gets called inside completion block
+        
+        // the time spent in the completion block is the time taken to parse and convert the response
+        NSDate *processingStartDate = self.metrics ? [NSDate date] : nil;
         completionBlock(response, error);
+        if (processingStartDate) {
+            self.metrics.error = error;
+            self.metrics.processingDuration = -[processingStartDate timeIntervalSinceNow];
+        }
+    }
+    [self notifyMetricsObserver];
+}
+
+- (void)notifyMetricsObserver
+{
+    if (self.metrics) {
+        CMISRequestMetrics *metrics = self.metrics;
+        self.metrics = nil; // only report a request once
+        if (!metrics.endDate) {
+            metrics.endDate = [NSDate date];
+        }
+        [self.metricsObserver requestDidFinishWithMetrics:metrics];
     }
 }
 
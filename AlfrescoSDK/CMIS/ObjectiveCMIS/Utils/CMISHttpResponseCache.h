@@ -0,0 +1,66 @@
+/*
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+ 
+    http://www.apache.org/licenses/LICENSE-2.0
+ 
+  Unless required by applicable law or agreed to in writing,
+  software distributed under the License is distributed on an
+  "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+  KIND, either express or implied.  See the License for the
+  specific language governing permissions and limitations
+  under the License.
+ */
+
+#import <Foundation/Foundation.h>
+
+/**
+ * Keeps the bodies of GET responses that carry an ETag or Last-Modified validator, set using the
+ * kCMISSessionParameterResponseCache session parameter. The next request for the same resource is made conditional
+ * with If-None-Match and If-Modified-Since, when the server answers 304 Not Modified the body is taken from the cache
+ * instead of being transferred again. Responses are always revalidated, the cache never answers a request on its own.
+ *
+ * Entries are keyed by user and URL so a cache shared by several sessions can't hand one user's response to another,
+ * they are kept in memory and evicted once the cost limit is reached. All methods are thread safe.
+ */
+@interface CMISHttpResponseCache : NSObject
+
+/// The maximum total size of the cached bodies in bytes, defaults to 10MB
+@property (nonatomic, assign) NSUInteger totalCostLimit;
+/// Bodies larger than this aren't cached, defaults to 1MB
+@property (nonatomic, assign) NSUInteger maxEntryLength;
+
+/// The number of requests that were made conditional
+@property (nonatomic, assign, readonly) NSUInteger conditionalRequestCount;
+/// The number of requests answered with 304 Not Modified and served from the cache
+@property (nonatomic, assign, readonly) NSUInteger notModifiedCount;
+/// The number of responses stored
+@property (nonatomic, assign, readonly) NSUInteger storeCount;
+
+/// Returns the response cache configured for the given session parameter value, nil if responses are not cached.
++ (CMISHttpResponseCache *)responseCacheFromParameter:(id)parameter;
+
+/// Returns YES for requests whose responses can be cached, i.e. GET requests for a whole resource.
++ (BOOL)isCacheableRequest:(NSURLRequest *)urlRequest;
+
+/**
+ * Adds the validators of the response cached for the request, if any. Returns the cached response which the caller
+ * should hold on to and use if the server answers 304 Not Modified, nil if the request was not made conditional.
+ */
+- (NSCachedURLResponse *)prepareConditionalRequest:(NSMutableURLRequest *)urlRequest user:(NSString *)user;
+
+/// Called when the server answered a conditional request with 304 Not Modified, returns the cached response to use instead.
+- (NSCachedURLResponse *)cachedResponseForNotModifiedResponse:(NSHTTPURLResponse *)response
+                                               cachedResponse:(NSCachedURLResponse *)cachedResponse;
+
+/// Stores a successful response if it carries a validator and may be stored, otherwise removes any response cached for the request.
+- (void)storeResponse:(NSHTTPURLResponse *)response data:(NSData *)data forRequest:(NSURLRequest *)urlRequest user:(NSString *)user;
+
+- (void)removeAllResponses;
+
+@end
@@ -0,0 +1,162 @@
+/*
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+ 
+    http://www.apache.org/licenses/LICENSE-2.0
+ 
+  Unless required by applicable law or agreed to in writing,
+  software distributed under the License is distributed on an
+  "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+  KIND, either express or implied.  See the License for the
+  specific language governing permissions and limitations
+  under the License.
+ */
+
+#import "CMISHttpResponseCache.h"
+#import "CMISLog.h"
+
+static NSUInteger const kCMISHttpResponseCacheDefaultTotalCostLimit = 10 * 1024 * 1024;
+static NSUInteger const kCMISHttpResponseCacheDefaultMaxEntryLength = 1024 * 1024;
+
+@interface CMISHttpResponseCache ()
+@property (nonatomic, strong) NSCache *responses;
+@property (nonatomic, assign, readwrite) NSUInteger conditionalRequestCount;
+@property (nonatomic, assign, readwrite) NSUInteger notModifiedCount;
+@property (nonatomic, assign, readwrite) NSUInteger storeCount;
+@end
+
+@implementation CMISHttpResponseCache
+
++ (CMISHttpResponseCache *)responseCacheFromParameter:(id)parameter
+{
+    if ([parameter isKindOfClass:[CMISHttpResponseCache class]]) {
+        return parameter;
+    }
+    return nil;
+}
+
++ (BOOL)isCacheableRequest:(NSURLRequest *)urlRequest
+{
+    NSString *method = urlRequest.HTTPMethod ?: @"GET";
+    return [method isEqualToString:@"GET"] && [urlRequest valueForHTTPHeaderField:@"Range"] == nil;
+}
+
+- (id)init
+{
+    self = [super init];
+    if (self) {
+        _responses = [[NSCache alloc] init];
+        _responses.name = @"CMISHttpResponseCache";
+        self.totalCostLimit = kCMISHttpResponseCacheDefaultTotalCostLimit;
+        _maxEntryLength = kCMISHttpResponseCacheDefaultMaxEntryLength;
+    }
+    return self;
+}
+
+- (NSUInteger)totalCostLimit
+{
+    return self.responses.totalCostLimit;
+}
+
+- (void)setTotalCostLimit:(NSUInteger)totalCostLimit
+{
+    self.responses.totalCostLimit = totalCostLimit;
+}
+
+- (NSCachedURLResponse *)prepareConditionalRequest:(NSMutableURLRequest *)urlRequest user:(NSString *)user
+{
+    if (![CMISHttpResponseCache isCacheableRequest:urlRequest]) {
+        return nil;
+    }
+    
+    NSCachedURLResponse *cachedResponse = [self.responses objectForKey:[self keyForURL:urlRequest.URL user:user]];
+    if (!cachedResponse) {
+        return nil;
+    }
+    
+    NSHTTPURLResponse *response = (NSHTTPURLResponse *)cachedResponse.response;
+    NSString *entityTag = [self headerValue:@"ETag" ofResponse:response];
+    NSString *lastModified = [self headerValue:@"Last-Modified" ofResponse:response];
+    if (entityTag) {
+        [urlRequest setValue:entityTag forHTTPHeaderField:@"If-None-Match"];
+    }
+    if (lastModified) {
+        [urlRequest setValue:lastModified forHTTPHeaderField:@"If-Modified-Since"];
+    }
+    
+    @synchronized(self) {
+        self.conditionalRequestCount++;
+    }
+    return cachedResponse;
+}
+
+- (NSCachedURLResponse *)cachedResponseForNotModifiedResponse:(NSHTTPURLResponse *)response
+                                               cachedResponse:(NSCachedURLResponse *)cachedResponse
+{
+    if (response.statusCode != 304 || !cachedResponse) {
+        return nil;
+    }
+    
+    CMISLogDebug(@"Using cached response for %@, it has not been modified", response.URL);
+    @synchronized(self) {
+        self.notModifiedCount++;
+    }
+    return cachedResponse;
+}
+
+- (void)storeResponse:(NSHTTPURLResponse *)response data:(NSData *)data forRequest:(NSURLRequest *)urlRequest user:(NSString *)user
+{
+    if (![CMISHttpResponseCache isCacheableRequest:urlRequest] || response.statusCode != 200) {
+        return;
+    }
+    
+    NSString *key = [self keyForURL:urlRequest.URL user:user];
+    NSString *cacheControl = [[self headerValue:@"Cache-Control" ofResponse:response] lowercaseString];
+    BOOL hasValidator = [self headerValue:@"ETag" ofResponse:response] || [self headerValue:@"Last-Modified" ofResponse:response];
+    BOOL mayStore = [cacheControl rangeOfString:@"no-store"].location == NSNotFound
+                 && ![[self headerValue:@"Vary" ofResponse:response] isEqualToString:@"*"];
+    if (!hasValidator || !mayStore || data.length > self.maxEntryLength) {
+        // whatever was cached before is out of date now
+        [self.responses removeObjectForKey:key];
+        return;
+    }
+    
+    NSCachedURLResponse *cachedResponse = [[NSCachedURLResponse alloc] initWithResponse:response
+                                                                                   data:[data copy]
+                                                                               userInfo:nil
+                                                                          storagePolicy:NSURLCacheStorageAllowedInMemoryOnly];
+    [self.responses setObject:cachedResponse forKey:key cost:data.length];
+    @synchronized(self) {
+        self.storeCount++;
+    }
+}
+
+- (void)removeAllResponses
+{
+    [self.responses removeAllObjects];
+}
+
+#pragma mark - Private methods
+
+- (NSString *)keyForURL:(NSURL *)url user:(NSString *)user
+{
+    return [NSString stringWithFormat:@"%@\n%@", user ?: @"", url.absoluteString];
+}
+
+- (NSString *)headerValue:(NSString *)headerName ofResponse:(NSHTTPURLResponse *)response
+{
+    // header names are case insensitive but allHeaderFields is only guaranteed to be canonicalised on recent systems
+    for (NSString *name in response.allHeaderFields) {
+        if ([name caseInsensitiveCompare:headerName] == NSOrderedSame) {
+            return response.allHeaderFields[name];
+        }
+    }
+    return nil;
+}
+
+@end
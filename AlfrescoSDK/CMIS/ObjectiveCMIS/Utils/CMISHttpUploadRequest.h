@@ -18,11 +18,18 @@
  */
 
 #import "CMISHttpRequest.h"
+@class CMISContentSource;
+
 @interface CMISHttpUploadRequest : CMISHttpRequest <NSStreamDelegate>
 
 @property (nonatomic, strong) NSInputStream *inputStream;
+/// The source the content is read from, nil if the request was started with an input stream as its whole body
+@property (nonatomic, strong, readonly) CMISContentSource *contentSource;
 @property (nonatomic, assign) unsigned long long bytesExpected; // optional; if not set, expected content length from HTTP header is used
 @property (nonatomic, readonly) unsigned long long bytesUploaded;
+/// The file the request body is written to when a background network session is used, background sessions only upload from files.
+/// The file is written on a background queue once the request has started, the transfer is queued when it is complete.
+@property (nonatomic, strong, readonly) NSString *bodyFilePath;
 
 /**
  * starts a URL request with a provided input stream. The input stream provided will be used directly to send the data upstream.
@@ -54,4 +61,27 @@
    completionBlock:(void (^)(CMISHttpResponse *httpResponse, NSError *error))completionBlock
      progressBlock:(void (^)(unsigned long long bytesUploaded, unsigned long long bytesTotal))progressBlock;
 
+/**
+ * starts a URL request sending the provided start data, the content of the content source (optionally encoding it as
+ * base64) and the end data. Unencoded content of a rewindable source is sent again if the request is retried, content
+ * held in memory or mapped from a file is copied straight from its bytes into the URL session's buffers.
+ */
++ (id)startRequest:(NSMutableURLRequest *)urlRequest
+        httpMethod:(CMISHttpRequestMethod)httpRequestMethod
+     contentSource:(CMISContentSource *)contentSource
+           headers:(NSDictionary*)additionalHeaders
+           session:(CMISBindingSession *)session
+         startData:(NSData *)startData
+           endData:(NSData *)endData
+ useBase64Encoding:(BOOL)useBase64Encoding
+   completionBlock:(void (^)(CMISHttpResponse *httpResponse, NSError *error))completionBlock
+     progressBlock:(void (^)(unsigned long long bytesUploaded, unsigned long long bytesTotal))progressBlock;
+
+/**
+ * initialises with a specified HTTP method, used to reattach to background transfers
+ */
+- (id)initWithHttpMethod:(CMISHttpRequestMethod)httpRequestMethod
+         completionBlock:(void (^)(CMISHttpResponse *httpResponse, NSError *error))completionBlock
+           progressBlock:(void (^)(unsigned long long bytesUploaded, unsigned long long bytesTotal))progressBlock;
+
 @end
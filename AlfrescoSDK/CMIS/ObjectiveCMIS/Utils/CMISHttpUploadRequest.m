@@ -28,6 +28,9 @@
 #import "CMISAtomEntryWriter.h"
 #import "CMISLog.h"
 #import "CMISErrors.h"
+#import "CMISBackgroundTransferManager.h"
+#import "CMISCompositeInputStream.h"
+#import "CMISContentSource.h"
 
 /**
  * The default buffer size for the input/output stream pair containing the base64 encoded data.
@@ -94,6 +97,10 @@ const NSUInteger kDefaultBufferChunkSize = 32768;
 @property (nonatomic, assign, readwrite) size_t bufferOffset;
 @property (nonatomic, assign, readwrite) size_t bufferLimit;
 @property (nonatomic, assign) NSUInteger bufferChunkSize;
+@property (nonatomic, strong, readwrite) NSString *bodyFilePath;
+@property (nonatomic, strong, readwrite) CMISContentSource *contentSource;
+@property (nonatomic, assign) BOOL writingBodyFile;
+@property (nonatomic, assign) BOOL cancelledWhileWritingBodyFile;
 
 @end
 
@@ -141,16 +148,41 @@ const NSUInteger kDefaultBufferChunkSize = 32768;
  useBase64Encoding:(BOOL)useBase64Encoding
    completionBlock:(void (^)(CMISHttpResponse *, NSError *))completionBlock
      progressBlock:(void (^)(unsigned long long, unsigned long long))progressBlock
+{
+    return [self startRequest:urlRequest
+                   httpMethod:httpRequestMethod
+                contentSource:[CMISContentSource contentSourceWithInputStream:inputStream length:bytesExpected]
+                      headers:additionalHeaders
+                      session:session
+                    startData:startData
+                      endData:endData
+            useBase64Encoding:useBase64Encoding
+              completionBlock:completionBlock
+                progressBlock:progressBlock];
+}
+
++ (id)startRequest:(NSMutableURLRequest *)urlRequest
+        httpMethod:(CMISHttpRequestMethod)httpRequestMethod
+     contentSource:(CMISContentSource *)contentSource
+           headers:(NSDictionary *)additionalHeaders
+           session:(CMISBindingSession *)session
+         startData:(NSData *)startData
+           endData:(NSData *)endData
+ useBase64Encoding:(BOOL)useBase64Encoding
+   completionBlock:(void (^)(CMISHttpResponse *, NSError *))completionBlock
+     progressBlock:(void (^)(unsigned long long, unsigned long long))progressBlock
 {
     CMISHttpUploadRequest *httpRequest = [[self alloc] initWithHttpMethod:httpRequestMethod
                                                           completionBlock:completionBlock
                                                             progressBlock:progressBlock];
     
-    httpRequest.inputStream = inputStream;
+    // rewindable sources hand out a new stream whenever the content is read, the stream of any other source is the content
+    httpRequest.contentSource = contentSource;
+    httpRequest.inputStream = contentSource.isRewindable ? nil : [contentSource inputStream];
     httpRequest.streamStartData = startData;
     httpRequest.streamEndData = endData;
     httpRequest.additionalHeaders = additionalHeaders;
-    httpRequest.bytesExpected = bytesExpected;
+    httpRequest.bytesExpected = contentSource.length;
     httpRequest.session = session;
     httpRequest.useCombinedInputStream = YES;
     httpRequest.base64Encoding = useBase64Encoding;
@@ -165,7 +197,6 @@ const NSUInteger kDefaultBufferChunkSize = 32768;
     return httpRequest;
 }
 
-
 - (id)initWithHttpMethod:(CMISHttpRequestMethod)httpRequestMethod
          completionBlock:(void (^)(CMISHttpResponse *httpResponse, NSError *error))completionBlock
            progressBlock:(void (^)(unsigned long long bytesUploaded, unsigned long long bytesTotal))progressBlock
@@ -180,17 +211,46 @@ const NSUInteger kDefaultBufferChunkSize = 32768;
 }
 
 /**
- if we are using on-the-go base64 encoding, we will use the combinedInputStream in URL connections/request.
- In this case a little extra work is required: i.e. we need to provide the length of the encoded data stream (including
- the XML data).
+ if we are using the combinedInputStream in URL connections/request a little extra work is required: i.e. we need to provide
+ the length of the (encoded) data stream including the start and end data, otherwise the body is sent chunked.
  */
 - (BOOL)startRequest:(NSMutableURLRequest*)urlRequest
 {
-    if (self.useCombinedInputStream && self.combinedInputStream && self.base64Encoding) {
+    if (self.useCombinedInputStream && self.combinedInputStream && (self.base64Encoding || self.encodedLength > 0)) {
         NSMutableDictionary *headers = [NSMutableDictionary dictionaryWithDictionary:self.additionalHeaders];
         [headers setValue:[NSString stringWithFormat:@"%llu", self.encodedLength] forKey:@"Content-Length"];
         self.additionalHeaders = [NSDictionary dictionaryWithDictionary:headers];
     }
+    
+    // background sessions don't support streamed uploads so the body is written to a file before the transfer is queued,
+    // encoding the content can take a while so the file is written off the caller's thread
+    if ([CMISBackgroundTransferManager transferManagerForSession:self.session]) {
+        [self closeEncoderStream];
+        self.writingBodyFile = YES;
+        dispatch_async(dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
+            NSError *writeError = nil;
+            BOOL written = [self writeBodyToFileWithError:&writeError];
+            
+            // a request cancelled while its body was written has already called back, it is never queued
+            BOOL cancelled;
+            @synchronized(self) {
+                self.writingBodyFile = NO;
+                cancelled = self.cancelledWhileWritingBodyFile;
+                if (written && !cancelled) {
+                    [super startRequest:urlRequest];
+                }
+            }
+            
+            if (cancelled) {
+                [self removeBodyFile];
+            } else if (!written) {
+                [self performCallback:^{
+                    [self executeCompletionBlockError:writeError];
+                }];
+            }
+        });
+        return YES;
+    }
 
     BOOL startSuccess = [super startRequest:urlRequest];
     
@@ -201,9 +261,19 @@ const NSUInteger kDefaultBufferChunkSize = 32768;
     return startSuccess;
 }
 
+- (BOOL)canRetry
+{
+    // the body can only be sent again if its content can be read again, base64 encoded content is consumed as it is encoded
+    return self.useCombinedInputStream && !self.base64Encoding && self.contentSource.isRewindable;
+}
+
 - (NSURLSessionTask *)taskForRequest:(NSURLRequest *)request
 {
-    return [self.urlSession uploadTaskWithStreamedRequest:request];
+    if (self.bodyFilePath) {
+        return [self.urlSession uploadTaskWithRequest:request fromFile:[NSURL fileURLWithPath:self.bodyFilePath]];
+    } else {
+        return [self.urlSession uploadTaskWithStreamedRequest:request];
+    }
 }
 
 #pragma mark CMISCancellableRequest method
@@ -215,17 +285,38 @@ const NSUInteger kDefaultBufferChunkSize = 32768;
     }
     self.progressBlock = nil;
     
+    BOOL writingBodyFile;
+    @synchronized(self) {
+        writingBodyFile = self.writingBodyFile;
+        if (writingBodyFile) {
+            self.cancelledWhileWritingBodyFile = YES;
+        }
+    }
+    if (writingBodyFile) {
+        // nothing has been sent yet, the body file is removed as soon as it has been written
+        NSError *cmisError = [CMISErrors createCMISErrorWithCode:kCMISErrorCodeCancelled detailedDescription:@"Request was cancelled"];
+        [self executeCompletionBlockError:cmisError];
+        return;
+    }
+    
     [super cancel];
     if (self.useCombinedInputStream) {
         [self stopSendWithStatus:@"connection has been cancelled."];
     }
+    [self removeBodyFile];
 }
 
 #pragma mark Session delegate methods
 
 - (void)URLSession:(NSURLSession *)session task:(NSURLSessionTask *)task needNewBodyStream:(void (^)(NSInputStream *))completionHandler
 {
-    if (self.combinedInputStream) {
+    if ([self.combinedInputStream isKindOfClass:[CMISCompositeInputStream class]]) {
+        // asked again after a redirect or an authentication challenge the body has to start over, nil fails the task if it can't
+        if (self.combinedInputStream.streamStatus != NSStreamStatusNotOpen) {
+            self.combinedInputStream = [(CMISCompositeInputStream *)self.combinedInputStream reopenedStream];
+        }
+        completionHandler(self.combinedInputStream);
+    } else if (self.combinedInputStream) {
         completionHandler(self.combinedInputStream);
     } else {
         completionHandler(self.inputStream);
@@ -236,6 +327,12 @@ const NSUInteger kDefaultBufferChunkSize = 32768;
 {
     [super URLSession:session task:task didCompleteWithError:error];
     
+    if (!self.isFinished) {
+        // the body is sent again from a reopened stream, everything has to stay in place for the next attempt
+        self.transferCompleted = NO;
+        return;
+    }
+    
     if (self.useCombinedInputStream) {
         if (error) {
             [self stopSendWithStatus:@"connection is being terminated with error."];
@@ -243,6 +340,7 @@ const NSUInteger kDefaultBufferChunkSize = 32768;
             [self stopSendWithStatus:@"Connection finished as expected."];
         }
     }
+    [self removeBodyFile];
     
     self.progressBlock = nil;
 }
@@ -269,18 +367,20 @@ const NSUInteger kDefaultBufferChunkSize = 32768;
             if (totalBytesSent >= totalBytesExpectedToSend) {
                 self.transferCompleted = YES;
             }
-            // pass progress to progressBlock, on the original thread
-            if (self.originalThread) {
-                [self performSelector:@selector(executeProgressBlock:) onThread:self.originalThread withObject:@[@(totalBytesSent), @(totalBytesExpectedToSend)] waitUntilDone:NO];
-            }
+            // pass progress to progressBlock, on the callback queue or the original thread
+            NSArray *progress = @[@(totalBytesSent), @(totalBytesExpectedToSend)];
+            [self performCallback:^{
+                [self executeProgressBlock:progress];
+            }];
         } else {
             if (totalBytesSent >= self.bytesExpected) {
                 self.transferCompleted = YES;
             }
-            // pass progress to progressBlock, on the original thread
-            if (self.originalThread) {
-                [self performSelector:@selector(executeProgressBlock:) onThread:self.originalThread withObject:@[@(totalBytesSent), @(self.bytesExpected)] waitUntilDone:NO];
-            }
+            // pass progress to progressBlock, on the callback queue or the original thread
+            NSArray *progress = @[@(totalBytesSent), @(self.bytesExpected)];
+            [self performCallback:^{
+                [self executeProgressBlock:progress];
+            }];
         }
     }
 }
@@ -360,11 +460,11 @@ const NSUInteger kDefaultBufferChunkSize = 32768;
                         
                         NSData *encodedBuffer;
                         if (self.base64Encoding) {
-                            encodedBuffer = [CMISBase64Encoder dataByEncodingText:[NSData dataWithBytes:rawBuffer length:rawBytesRead]];
+                            encodedBuffer = [CMISBase64Encoder dataByEncodingText:[NSData dataWithBytesNoCopy:rawBuffer length:rawBytesRead freeWhenDone:NO]];
                         } else {
                             encodedBuffer = [NSData dataWithBytes:rawBuffer length:rawBytesRead];
                         }
-                        self.dataBuffer = [NSData dataWithData:encodedBuffer];
+                        self.dataBuffer = encodedBuffer;
                         self.bufferOffset = 0;
                         self.bufferLimit = encodedBuffer.length;
                     } else {
@@ -372,7 +472,7 @@ const NSUInteger kDefaultBufferChunkSize = 32768;
                         self.inputStream = nil;
                         self.bufferOffset = 0;
                         self.bufferLimit = self.streamEndData.length;
-                        self.dataBuffer = [NSData dataWithData:self.streamEndData];
+                        self.dataBuffer = self.streamEndData;
                         self.streamEndData = nil;
                     }
                     if ((self.bufferLimit == self.bufferOffset) && self.encoderStream != nil) {
@@ -382,7 +482,7 @@ const NSUInteger kDefaultBufferChunkSize = 32768;
                 } else if (self.streamEndData != nil) {
                     self.bufferOffset = 0;
                     self.bufferLimit = self.streamEndData.length;
-                    self.dataBuffer = [NSData dataWithData:self.streamEndData];
+                    self.dataBuffer = self.streamEndData;
                     self.streamEndData = nil;
                 }
                 
@@ -393,9 +493,7 @@ const NSUInteger kDefaultBufferChunkSize = 32768;
                 
             }
             if (self.bufferOffset != self.bufferLimit) {
-                NSUInteger length = self.dataBuffer.length;
-                uint8_t buffer[length];
-                [self.dataBuffer getBytes:buffer length:length];
+                const uint8_t *buffer = self.dataBuffer.bytes;
                 NSInteger bytesWritten;
                 bytesWritten = [self.encoderStream write:&buffer[self.bufferOffset] maxLength:self.bufferLimit - self.bufferOffset];
                 if (bytesWritten <= 0) {
@@ -438,6 +536,17 @@ const NSUInteger kDefaultBufferChunkSize = 32768;
 
 - (void)prepareStreams
 {
+    if (!self.base64Encoding) {
+        // unencoded content is read straight from the source stream, so the length is exact whenever the content length is known
+        CMISCompositeInputStream *compositeInputStream = [[CMISCompositeInputStream alloc] initWithPrologue:self.streamStartData
+                                                                                              contentSource:self.contentSource
+                                                                                                   epilogue:self.streamEndData];
+        self.bytesExpected = compositeInputStream.length;
+        self.encodedLength = compositeInputStream.length;
+        self.combinedInputStream = compositeInputStream;
+        return;
+    }
+    
     self.bufferOffset = 0;
     
     self.bufferLimit = self.streamStartData.length;
@@ -458,6 +567,9 @@ const NSUInteger kDefaultBufferChunkSize = 32768;
     self.bytesExpected = encodedLength;
     self.encodedLength = self.bytesExpected;
     
+    if (self.inputStream == nil) {
+        self.inputStream = [self.contentSource inputStream];
+    }
     if (self.inputStream.streamStatus != NSStreamStatusOpen) {
         [self.inputStream open];
     }
@@ -475,6 +587,111 @@ const NSUInteger kDefaultBufferChunkSize = 32768;
 }
 
 
+/**
+ The encoder stream pair set up by prepareStreams is not used when the body is written to a file,
+ it is torn down on the thread whose run loop it was scheduled in before any of its events are delivered.
+ */
+- (void)closeEncoderStream
+{
+    if (self.encoderStream != nil) {
+        self.encoderStream.delegate = nil;
+        [self.encoderStream removeFromRunLoop:[NSRunLoop currentRunLoop] forMode:NSDefaultRunLoopMode];
+        [self.encoderStream close];
+        self.encoderStream = nil;
+    }
+    self.combinedInputStream = nil;
+}
+
+/**
+ Writes the start data, the (optionally base64 encoded) content of the input stream and the end data to a temporary file.
+ Runs on a background queue, the content is read synchronously.
+ */
+- (BOOL)writeBodyToFileWithError:(NSError **)error
+{
+    NSString *bodyFilePath = [NSTemporaryDirectory() stringByAppendingPathComponent:[NSString stringWithFormat:@"%@.upload", [[NSUUID UUID] UUIDString]]];
+    NSOutputStream *fileStream = [NSOutputStream outputStreamToFileAtPath:bodyFilePath append:NO];
+    [fileStream open];
+    
+    BOOL success = [self writeData:self.streamStartData toStream:fileStream];
+    
+    if (!self.base64Encoding && self.contentSource.data) {
+        // the content is written from its bytes, there's nothing to read
+        success = success && [self writeData:self.contentSource.data toStream:fileStream];
+    } else if (self.inputStream == nil) {
+        self.inputStream = [self.contentSource inputStream];
+    }
+    if (self.inputStream.streamStatus != NSStreamStatusOpen) {
+        [self.inputStream open];
+    }
+    
+    // base64 is encoded in groups of 3 bytes, any remainder of a read is carried over to the next one
+    NSUInteger rawBufferSize = self.base64Encoding ? (NSUInteger)[CMISHttpUploadRequest rawEncodedLength:self.bufferChunkSize] : self.bufferChunkSize;
+    uint8_t rawBuffer[rawBufferSize];
+    NSMutableData *pendingData = [NSMutableData data];
+    while (success && self.inputStream) {
+        NSInteger rawBytesRead = [self.inputStream read:rawBuffer maxLength:rawBufferSize];
+        if (rawBytesRead < 0) {
+            success = NO;
+        } else if (rawBytesRead == 0) {
+            break;
+        } else if (self.base64Encoding) {
+            [pendingData appendBytes:rawBuffer length:rawBytesRead];
+            NSUInteger encodableLength = pendingData.length - (pendingData.length % 3);
+            if (encodableLength > 0) {
+                success = [self writeData:[CMISBase64Encoder dataByEncodingText:[pendingData subdataWithRange:NSMakeRange(0, encodableLength)]] toStream:fileStream];
+                [pendingData replaceBytesInRange:NSMakeRange(0, encodableLength) withBytes:NULL length:0];
+            }
+        } else {
+            success = [self writeData:[NSData dataWithBytesNoCopy:rawBuffer length:rawBytesRead freeWhenDone:NO] toStream:fileStream];
+        }
+    }
+    if (success && pendingData.length > 0) {
+        success = [self writeData:[CMISBase64Encoder dataByEncodingText:pendingData] toStream:fileStream];
+    }
+    success = success && [self writeData:self.streamEndData toStream:fileStream];
+    
+    [fileStream close];
+    [self.inputStream close];
+    self.inputStream = nil;
+    self.streamStartData = nil;
+    self.streamEndData = nil;
+    self.dataBuffer = nil;
+    
+    if (!success) {
+        [[NSFileManager defaultManager] removeItemAtPath:bodyFilePath error:nil];
+        if (error) {
+            *error = [CMISErrors createCMISErrorWithCode:kCMISErrorCodeStorage
+                                     detailedDescription:[NSString stringWithFormat:@"Could not write upload body to %@", bodyFilePath]];
+        }
+        return NO;
+    }
+    
+    self.bodyFilePath = bodyFilePath;
+    return YES;
+}
+
+- (BOOL)writeData:(NSData *)data toStream:(NSOutputStream *)outputStream
+{
+    const uint8_t *bytes = data.bytes;
+    NSUInteger offset = 0;
+    while (offset < data.length) {
+        NSInteger written = [outputStream write:&bytes[offset] maxLength:data.length - offset];
+        if (written <= 0) {
+            return NO;
+        }
+        offset += written;
+    }
+    return YES;
+}
+
+- (void)removeBodyFile
+{
+    if (self.bodyFilePath) {
+        [[NSFileManager defaultManager] removeItemAtPath:self.bodyFilePath error:nil];
+        self.bodyFilePath = nil;
+    }
+}
+
 + (unsigned long long)base64EncodedLength:(unsigned long long)contentSize
 {
     if (0 == contentSize) {
@@ -505,7 +722,7 @@ const NSUInteger kDefaultBufferChunkSize = 32768;
         self.bufferLimit  = 0;
         self.dataBuffer = nil;
         if (self.urlSession != nil) {
-            [self.urlSession invalidateAndCancel];
+            [self cancelTransfer];
             self.urlSession = nil;
         }
         if (self.encoderStream != nil) {
@@ -22,6 +22,7 @@
 #import "CMISObjectData.h"
 
 @class CMISSession;
+@class CMISRequest;
 
 @interface CMISObjectConverter : NSObject
 
@@ -30,6 +31,13 @@
 - (void)convertObject:(CMISObjectData *)objectData completionBlock:(void (^)(CMISObject *object, NSError *error))completionBlock;
 - (void)convertObjects:(NSArray *)objectDatas completionBlock:(void (^)(NSArray *objects, NSError *error))completionBlock;
 
+/**
+ * Converts as above, the type definitions the conversion needs are retrieved as sub requests of the given request
+ * so they take on its priority and none are retrieved once it has been cancelled.
+ */
+- (void)convertObject:(CMISObjectData *)objectData cmisRequest:(CMISRequest *)cmisRequest completionBlock:(void (^)(CMISObject *object, NSError *error))completionBlock;
+- (void)convertObjects:(NSArray *)objectDatas cmisRequest:(CMISRequest *)cmisRequest completionBlock:(void (^)(NSArray *objects, NSError *error))completionBlock;
+
 /**
  * Converts the given dictionary of properties, where the key is the property id and the value
  * can be a CMISPropertyData or a regular string.
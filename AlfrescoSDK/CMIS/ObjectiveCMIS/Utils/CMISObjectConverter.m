@@ -46,6 +46,11 @@
 }
 
 - (void)convertObject:(CMISObjectData *)objectData completionBlock:(void (^)(CMISObject *object, NSError *error))completionBlock
+{
+    [self convertObject:objectData cmisRequest:nil completionBlock:completionBlock];
+}
+
+- (void)convertObject:(CMISObjectData *)objectData cmisRequest:(CMISRequest *)cmisRequest completionBlock:(void (^)(CMISObject *object, NSError *error))completionBlock
 {
     CMISObject *object = nil;
     
@@ -55,15 +60,16 @@
         object = [[CMISFolder alloc] initWithObjectData:objectData session:self.session];
     }
     
-    [object fetchTypeDefinitionWithCompletionBlock:^(NSError *error) {
+    [object fetchTypeDefinitionWithCMISRequest:cmisRequest completionBlock:^(NSError *error) {
         completionBlock(object, error);
     }];
 }
 
 
-- (void)internalConvertObject:(NSArray *)objectDatas position:(NSInteger)position completionBlock:(void (^)(NSMutableArray *objects, NSError *error))completionBlock
+- (void)internalConvertObject:(NSArray *)objectDatas position:(NSInteger)position cmisRequest:(CMISRequest *)cmisRequest completionBlock:(void (^)(NSMutableArray *objects, NSError *error))completionBlock
 {
     [self convertObject:[objectDatas objectAtIndex:position]
+            cmisRequest:cmisRequest
         completionBlock:^(CMISObject *object, NSError *error) {
             if(error){
                 completionBlock(nil, error);
@@ -73,7 +79,7 @@
                     [objects addObject:object];
                     completionBlock(objects, error);
                 } else {
-                    [self internalConvertObject:objectDatas position:(position - 1) completionBlock:^(NSMutableArray *objects, NSError *error) {
+                    [self internalConvertObject:objectDatas position:(position - 1) cmisRequest:cmisRequest completionBlock:^(NSMutableArray *objects, NSError *error) {
                         [objects addObject:object];
                         completionBlock(objects, error);
                     }];
@@ -84,10 +90,16 @@
 
 
 - (void)convertObjects:(NSArray *)objectDatas completionBlock:(void (^)(NSArray *objects, NSError *error))completionBlock
+{
+    [self convertObjects:objectDatas cmisRequest:nil completionBlock:completionBlock];
+}
+
+- (void)convertObjects:(NSArray *)objectDatas cmisRequest:(CMISRequest *)cmisRequest completionBlock:(void (^)(NSArray *objects, NSError *error))completionBlock
 {
     if (objectDatas.count > 0) {
         [self internalConvertObject:objectDatas
                            position:(objectDatas.count - 1) // start recursion with last item
+                        cmisRequest:cmisRequest
                     completionBlock:^(NSMutableArray *objects, NSError *error) {
                         completionBlock(objects, error);
                     }];
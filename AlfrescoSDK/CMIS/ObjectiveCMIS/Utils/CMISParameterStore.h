@@ -0,0 +1,62 @@
+/*
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+ 
+    http://www.apache.org/licenses/LICENSE-2.0
+ 
+  Unless required by applicable law or agreed to in writing,
+  software distributed under the License is distributed on an
+  "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+  KIND, either express or implied.  See the License for the
+  specific language governing permissions and limitations
+  under the License.
+ */
+
+#import <Foundation/Foundation.h>
+
+/**
+ * A thread safe key value store for session parameters and the caches kept with them. Entries are spread over a set of
+ * stripes, each holding an immutable snapshot of its entries that is replaced as a whole when it changes: reads never
+ * take a lock and writes only lock the stripe the key belongs to.
+ * Each key is updated atomically, changes to several keys may be seen by other threads one key at a time.
+ */
+@interface CMISParameterStore : NSObject
+
+/// Initialises a store holding the entries of the given dictionary
+- (id)initWithDictionary:(NSDictionary *)dictionary;
+
+/// Returns the keys of all entries
+- (NSArray *)allKeys;
+
+/// Returns the object stored for the key, nil if there is none
+- (id)objectForKey:(id)key;
+
+/// Stores the object for the key, a nil object removes the entry
+- (void)setObject:(id)object forKey:(id)key;
+
+/// Stores all entries of the given dictionary
+- (void)addEntriesFromDictionary:(NSDictionary *)dictionary;
+
+/// Removes the entry for the key
+- (void)removeObjectForKey:(id)key;
+
+/**
+ * Returns the object stored for the key, if there is none the block is called to create it and its result is stored.
+ * The block is called at most once per key even if several threads ask for the same missing key, the others wait
+ * for and return the object it created. Writes to keys sharing the lock wait while the block runs.
+ */
+- (id)objectForKey:(id)key createIfAbsentWithBlock:(id (^)(void))createBlock;
+
+/// Subscripting support, same as objectForKey: and setObject:forKey:
+- (id)objectForKeyedSubscript:(id)key;
+- (void)setObject:(id)object forKeyedSubscript:(id)key;
+
+/// Returns a copy of all entries
+- (NSDictionary *)dictionaryRepresentation;
+
+@end
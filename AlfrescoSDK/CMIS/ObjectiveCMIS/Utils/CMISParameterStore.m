@@ -0,0 +1,183 @@
+/*
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+ 
+    http://www.apache.org/licenses/LICENSE-2.0
+ 
+  Unless required by applicable law or agreed to in writing,
+  software distributed under the License is distributed on an
+  "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+  KIND, either express or implied.  See the License for the
+  specific language governing permissions and limitations
+  under the License.
+ */
+
+#import "CMISParameterStore.h"
+
+// enough stripes for writes to distinct keys to rarely wait for each other, few enough to keep allKeys cheap
+static NSUInteger const kCMISParameterStoreStripeCount = 16;
+
+@interface CMISParameterStoreStripe : NSObject
+// immutable, replaced while holding the stripe's lock and read without locking
+@property (atomic, strong) NSDictionary *entries;
+@end
+
+@implementation CMISParameterStoreStripe
+@end
+
+@interface CMISParameterStore ()
+@property (nonatomic, strong) NSArray *stripes;
+@end
+
+@implementation CMISParameterStore
+
+- (id)init
+{
+    return [self initWithDictionary:nil];
+}
+
+- (id)initWithDictionary:(NSDictionary *)dictionary
+{
+    self = [super init];
+    if (self) {
+        NSMutableArray *stripes = [NSMutableArray arrayWithCapacity:kCMISParameterStoreStripeCount];
+        for (NSUInteger i = 0; i < kCMISParameterStoreStripeCount; i++) {
+            CMISParameterStoreStripe *stripe = [CMISParameterStoreStripe new];
+            stripe.entries = [NSDictionary dictionary];
+            [stripes addObject:stripe];
+        }
+        self.stripes = stripes;
+        [self addEntriesFromDictionary:dictionary];
+    }
+    return self;
+}
+
+- (NSArray *)allKeys
+{
+    NSMutableArray *keys = [NSMutableArray array];
+    for (CMISParameterStoreStripe *stripe in self.stripes) {
+        [keys addObjectsFromArray:stripe.entries.allKeys];
+    }
+    return keys;
+}
+
+- (id)objectForKey:(id)key
+{
+    if (key == nil) {
+        return nil;
+    }
+    return [self stripeForKey:key].entries[key];
+}
+
+- (void)setObject:(id)object forKey:(id)key
+{
+    if (object == nil) {
+        [self removeObjectForKey:key];
+        return;
+    }
+    [self addEntriesFromDictionary:@{key : object}];
+}
+
+- (void)addEntriesFromDictionary:(NSDictionary *)dictionary
+{
+    if (dictionary.count == 0) {
+        return;
+    }
+    
+    // group the entries by stripe so every stripe is copied once however many of its keys change
+    NSMapTable *entriesByStripe = [NSMapTable strongToStrongObjectsMapTable];
+    [dictionary enumerateKeysAndObjectsUsingBlock:^(id key, id object, BOOL *stop) {
+        CMISParameterStoreStripe *stripe = [self stripeForKey:key];
+        NSMutableDictionary *stripeEntries = [entriesByStripe objectForKey:stripe];
+        if (stripeEntries == nil) {
+            stripeEntries = [NSMutableDictionary dictionary];
+            [entriesByStripe setObject:stripeEntries forKey:stripe];
+        }
+        stripeEntries[key] = object;
+    }];
+    
+    for (CMISParameterStoreStripe *stripe in entriesByStripe) {
+        @synchronized(stripe) {
+            NSMutableDictionary *entries = [stripe.entries mutableCopy];
+            [entries addEntriesFromDictionary:[entriesByStripe objectForKey:stripe]];
+            stripe.entries = [entries copy];
+        }
+    }
+}
+
+- (void)removeObjectForKey:(id)key
+{
+    if (key == nil) {
+        return;
+    }
+    
+    CMISParameterStoreStripe *stripe = [self stripeForKey:key];
+    @synchronized(stripe) {
+        if (stripe.entries[key] != nil) {
+            NSMutableDictionary *entries = [stripe.entries mutableCopy];
+            [entries removeObjectForKey:key];
+            stripe.entries = [entries copy];
+        }
+    }
+}
+
+- (id)objectForKey:(id)key createIfAbsentWithBlock:(id (^)(void))createBlock
+{
+    CMISParameterStoreStripe *stripe = [self stripeForKey:key];
+    id object = stripe.entries[key];
+    if (object != nil || createBlock == nil) {
+        return object;
+    }
+    
+    @synchronized(stripe) {
+        // another thread may have created the object while this one was waiting for the lock
+        object = stripe.entries[key];
+        if (object == nil) {
+            object = createBlock();
+            if (object != nil) {
+                NSMutableDictionary *entries = [stripe.entries mutableCopy];
+                entries[key] = object;
+                stripe.entries = [entries copy];
+            }
+        }
+    }
+    return object;
+}
+
+- (id)objectForKeyedSubscript:(id)key
+{
+    return [self objectForKey:key];
+}
+
+- (void)setObject:(id)object forKeyedSubscript:(id)key
+{
+    [self setObject:object forKey:key];
+}
+
+- (NSDictionary *)dictionaryRepresentation
+{
+    NSMutableDictionary *dictionary = [NSMutableDictionary dictionary];
+    for (CMISParameterStoreStripe *stripe in self.stripes) {
+        [dictionary addEntriesFromDictionary:stripe.entries];
+    }
+    return dictionary;
+}
+
+- (NSString *)description
+{
+    return [NSString stringWithFormat:@"%@ %@", [super description], [self dictionaryRepresentation]];
+}
+
+#pragma mark Private methods
+
+- (CMISParameterStoreStripe *)stripeForKey:(id)key
+{
+    return self.stripes[[key hash] % kCMISParameterStoreStripeCount];
+}
+
+@end
@@ -0,0 +1,98 @@
+/*
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+ 
+    http://www.apache.org/licenses/LICENSE-2.0
+ 
+  Unless required by applicable law or agreed to in writing,
+  software distributed under the License is distributed on an
+  "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+  KIND, either express or implied.  See the License for the
+  specific language governing permissions and limitations
+  under the License.
+ */
+
+#import <Foundation/Foundation.h>
+
+@class CMISRequestMetrics;
+
+/**
+ * Receives the metrics of network requests, set using the kCMISSessionParameterRequestMetricsObserver session parameter.
+ * Methods are called on the thread the request's completion block was called on and should return quickly.
+ */
+@protocol CMISRequestMetricsObserver <NSObject>
+
+/// Called once the request has completed and its completion block has returned.
+- (void)requestDidFinishWithMetrics:(CMISRequestMetrics *)metrics;
+
+@optional
+
+/// Called just before the request is sent.
+- (void)requestWillStartWithMetrics:(CMISRequestMetrics *)metrics;
+
+@end
+
+/**
+ * The timings, sizes and outcome of a single network request.
+ */
+@interface CMISRequestMetrics : NSObject
+
+@property (nonatomic, strong) NSURL *url;
+@property (nonatomic, strong) NSString *httpMethod;
+/// Name of the operation that caused the request, i.e. the service method, if known.
+@property (nonatomic, strong) NSString *operationName;
+
+@property (nonatomic, strong) NSDate *enqueueDate;
+@property (nonatomic, strong) NSDate *startDate;
+@property (nonatomic, strong) NSDate *endDate;
+
+/// Time spent resolving the host name, connecting, negotiating TLS, waiting for the first byte and receiving the body,
+/// only available when the system provides task metrics (iOS 10 and OS X 10.12 onwards), otherwise 0.
+@property (nonatomic, assign) NSTimeInterval domainLookupDuration;
+@property (nonatomic, assign) NSTimeInterval connectDuration;
+@property (nonatomic, assign) NSTimeInterval secureConnectionDuration;
+@property (nonatomic, assign) NSTimeInterval waitDuration;
+@property (nonatomic, assign) NSTimeInterval responseDuration;
+@property (nonatomic, assign) BOOL reusedConnection;
+
+@property (nonatomic, assign) NSInteger statusCode;
+@property (nonatomic, assign) int64_t bytesSent;
+@property (nonatomic, assign) int64_t bytesReceived;
+/// Size of the response body as transferred, i.e. before it was decompressed, only available from iOS 13 and OS X 10.15, otherwise 0.
+@property (nonatomic, assign) int64_t encodedBytesReceived;
+/// YES when the server answered a conditional request with 304 Not Modified and the body was taken from the response cache.
+@property (nonatomic, assign) BOOL notModified;
+@property (nonatomic, assign) NSUInteger retryCount;
+/// Time spent waiting between attempts when the request was retried.
+@property (nonatomic, assign) NSTimeInterval retryWaitDuration;
+@property (nonatomic, strong) NSError *error;
+
+/// Time spent in the completion block, i.e. parsing the response and converting it to model objects.
+@property (nonatomic, assign) NSTimeInterval processingDuration;
+
+/// Returns the time from the request being enqueued until its completion block returned.
+@property (nonatomic, assign, readonly) NSTimeInterval totalDuration;
+
+/// Returns the metrics observer configured for the given session parameter value, nil if metrics are not collected.
++ (id<CMISRequestMetricsObserver>)observerFromParameter:(id)parameter;
+
+/// Attaches the name of the operation to the URL request, so the metrics are named before the request starts.
++ (void)setOperationName:(NSString *)operationName forRequest:(NSMutableURLRequest *)urlRequest;
+
+/// Returns the name of the operation attached to the URL request, nil if there is none.
++ (NSString *)operationNameForRequest:(NSURLRequest *)urlRequest;
+
+- (id)initWithURL:(NSURL *)url httpMethod:(NSString *)httpMethod;
+
+/// Records the phases of the request from the system's task metrics.
+- (void)recordTaskMetrics:(NSURLSessionTaskMetrics *)taskMetrics API_AVAILABLE(ios(10.0), macos(10.12));
+
+/// Records the outcome of the task once it completed.
+- (void)recordCompletionOfTask:(NSURLSessionTask *)task statusCode:(NSInteger)statusCode error:(NSError *)error;
+
+@end
@@ -0,0 +1,110 @@
+/*
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+ 
+    http://www.apache.org/licenses/LICENSE-2.0
+ 
+  Unless required by applicable law or agreed to in writing,
+  software distributed under the License is distributed on an
+  "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+  KIND, either express or implied.  See the License for the
+  specific language governing permissions and limitations
+  under the License.
+ */
+
+#import "CMISRequestMetrics.h"
+
+static NSString * const kCMISRequestMetricsOperationNameKey = @"CMISRequestMetricsOperationName";
+
+@implementation CMISRequestMetrics
+
++ (id<CMISRequestMetricsObserver>)observerFromParameter:(id)parameter
+{
+    if ([parameter conformsToProtocol:@protocol(CMISRequestMetricsObserver)]) {
+        return parameter;
+    }
+    return nil;
+}
+
++ (void)setOperationName:(NSString *)operationName forRequest:(NSMutableURLRequest *)urlRequest
+{
+    if (operationName) {
+        [NSURLProtocol setProperty:operationName forKey:kCMISRequestMetricsOperationNameKey inRequest:urlRequest];
+    }
+}
+
++ (NSString *)operationNameForRequest:(NSURLRequest *)urlRequest
+{
+    return [NSURLProtocol propertyForKey:kCMISRequestMetricsOperationNameKey inRequest:urlRequest];
+}
+
+- (id)initWithURL:(NSURL *)url httpMethod:(NSString *)httpMethod
+{
+    self = [super init];
+    if (self) {
+        _url = url;
+        _httpMethod = httpMethod;
+        _enqueueDate = [NSDate date];
+    }
+    return self;
+}
+
+- (NSTimeInterval)totalDuration
+{
+    if (!self.enqueueDate || !self.endDate) {
+        return 0;
+    }
+    return [self.endDate timeIntervalSinceDate:self.enqueueDate] + self.processingDuration;
+}
+
+- (void)recordTaskMetrics:(NSURLSessionTaskMetrics *)taskMetrics
+{
+    // redirects and authentication challenges add transactions, the last one delivered the response
+    NSURLSessionTaskTransactionMetrics *transaction = taskMetrics.transactionMetrics.lastObject;
+    if (!transaction) {
+        return;
+    }
+    
+    self.domainLookupDuration = [self intervalFrom:transaction.domainLookupStartDate to:transaction.domainLookupEndDate];
+    self.connectDuration = [self intervalFrom:transaction.connectStartDate to:transaction.connectEndDate];
+    self.secureConnectionDuration = [self intervalFrom:transaction.secureConnectionStartDate to:transaction.secureConnectionEndDate];
+    self.waitDuration = [self intervalFrom:transaction.requestEndDate to:transaction.responseStartDate];
+    self.responseDuration = [self intervalFrom:transaction.responseStartDate to:transaction.responseEndDate];
+    self.reusedConnection = transaction.reusedConnection;
+    if (@available(iOS 13.0, macOS 10.15, *)) {
+        self.encodedBytesReceived = transaction.countOfResponseBodyBytesReceived;
+    }
+}
+
+- (void)recordCompletionOfTask:(NSURLSessionTask *)task statusCode:(NSInteger)statusCode error:(NSError *)error
+{
+    self.endDate = [NSDate date];
+    self.statusCode = statusCode;
+    self.error = error;
+    if (task) {
+        self.bytesSent = task.countOfBytesSent;
+        self.bytesReceived = task.countOfBytesReceived;
+    }
+}
+
+- (NSTimeInterval)intervalFrom:(NSDate *)startDate to:(NSDate *)endDate
+{
+    if (!startDate || !endDate) {
+        return 0;
+    }
+    return [endDate timeIntervalSinceDate:startDate];
+}
+
+- (NSString *)description
+{
+    return [NSString stringWithFormat:@"%@ %@ %@ status: %ld%@, sent: %lld, received: %lld, total: %.3fs, wait: %.3fs, processing: %.3fs",
+            self.operationName ?: @"", self.httpMethod, self.url, (long)self.statusCode, self.notModified ? @" (not modified)" : @"", self.bytesSent, self.bytesReceived,
+            self.totalDuration, self.waitDuration, self.processingDuration];
+}
+
+@end
@@ -0,0 +1,96 @@
+/*
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+ 
+    http://www.apache.org/licenses/LICENSE-2.0
+ 
+  Unless required by applicable law or agreed to in writing,
+  software distributed under the License is distributed on an
+  "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+  KIND, either express or implied.  See the License for the
+  specific language governing permissions and limitations
+  under the License.
+ */
+
+#import <Foundation/Foundation.h>
+
+/// Returned by a retry policy when a request should not be sent again
+extern NSTimeInterval const kCMISRetryPolicyNoRetry;
+
+/**
+ * Decides whether and when failed network requests are sent again, set using the kCMISSessionParameterRetryPolicy
+ * session parameter. Methods are called from the network session's delegate queue and must be thread safe.
+ */
+@protocol CMISRetryPolicy <NSObject>
+
+/// Called before every attempt, returning NO fails the request without sending it, i.e. while the host is considered down.
+- (BOOL)shouldAttemptRequest:(NSURLRequest *)request;
+
+/**
+ * Called once an attempt has completed, successful or not, returns the delay before the request is sent again or
+ * kCMISRetryPolicyNoRetry. The response is nil if none was received, the error is the transport error if any.
+ * rateLimited is YES if the server's response says the client has exceeded its request rate.
+ */
+- (NSTimeInterval)retryDelayAfterAttempt:(NSUInteger)attempt
+                               ofRequest:(NSURLRequest *)request
+                                response:(NSHTTPURLResponse *)response
+                                   error:(NSError *)error
+                             rateLimited:(BOOL)rateLimited;
+
+@end
+
+/**
+ * The default retry policy:
+ * - transient failures (lost connections, time outs, 502, 503 and 504 responses) of idempotent requests are retried,
+ *   requests that never reached the server and throttled requests (429 responses) are retried whatever their method
+ * - retries are delayed by an exponential backoff with full jitter, or by the server's Retry-After header if given
+ * - a retry budget limits retries to a fraction of all requests so retries can't multiply the load on a struggling server
+ * - a circuit breaker per host fails requests straight away after a run of failures, until a trial request succeeds.
+ *   Only lost or failed connections and 502, 503 and 504 responses count as failures, other server errors don't
+ */
+@interface CMISDefaultRetryPolicy : NSObject <CMISRetryPolicy>
+
+/// The maximum number of times a request is retried, defaults to 3
+@property (nonatomic, assign) NSUInteger maxRetryCount;
+/// The upper bound of the delay before the first retry, doubled for every further retry, defaults to 0.5 seconds
+@property (nonatomic, assign) NSTimeInterval initialRetryDelay;
+/// The maximum delay between retries, defaults to 30 seconds
+@property (nonatomic, assign) NSTimeInterval maxRetryDelay;
+/// Requests the server asks to retry after a longer time than this fail straight away, defaults to 60 seconds
+@property (nonatomic, assign) NSTimeInterval maxRetryAfter;
+/// The status codes of transient failures, defaults to 429, 502, 503 and 504
+@property (nonatomic, strong) NSIndexSet *retryableStatusCodes;
+/// The number of retries earned per request, defaults to 0.2 i.e. one retry for every five requests
+@property (nonatomic, assign) double retryBudgetRatio;
+/// The number of retries available up front and the most that can be saved up, defaults to 10
+@property (nonatomic, assign) double retryBudgetCapacity;
+/// The number of consecutive failures that open the circuit of a host, defaults to 5, 0 switches the circuit breaker off
+@property (nonatomic, assign) NSUInteger circuitBreakerFailureThreshold;
+/// How long requests to a host fail straight away once its circuit opened, defaults to 30 seconds
+@property (nonatomic, assign) NSTimeInterval circuitBreakerOpenDuration;
+
+/// The number of retries the policy has allowed
+@property (nonatomic, assign, readonly) NSUInteger retryCount;
+/// The number of retries denied because the retry budget was used up
+@property (nonatomic, assign, readonly) NSUInteger budgetExhaustedCount;
+/// The number of requests failed straight away because the circuit of their host was open
+@property (nonatomic, assign, readonly) NSUInteger circuitOpenCount;
+
+/// Returns the retry policy set with the given session parameter value, nil if requests are not retried.
++ (id<CMISRetryPolicy>)retryPolicyFromParameter:(id)parameter;
+
+/// Returns the number of seconds a Retry-After header value asks to wait, either seconds or an HTTP date, or a negative value if it can't be parsed
++ (NSTimeInterval)retryAfterIntervalFromHeaderValue:(NSString *)headerValue;
+
+/// Returns YES if sending the request more than once has the same effect as sending it once
++ (BOOL)isIdempotentRequest:(NSURLRequest *)request;
+
+/// Returns YES if the circuit of the given host is open
+- (BOOL)isCircuitOpenForHost:(NSString *)host;
+
+@end
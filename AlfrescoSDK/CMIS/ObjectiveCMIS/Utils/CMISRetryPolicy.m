@@ -0,0 +1,274 @@
+/*
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+ 
+    http://www.apache.org/licenses/LICENSE-2.0
+ 
+  Unless required by applicable law or agreed to in writing,
+  software distributed under the License is distributed on an
+  "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+  KIND, either express or implied.  See the License for the
+  specific language governing permissions and limitations
+  under the License.
+ */
+
+#import "CMISRetryPolicy.h"
+
+NSTimeInterval const kCMISRetryPolicyNoRetry = -1;
+
+/// State of the circuit breaker of one host
+@interface CMISRetryPolicyCircuit : NSObject
+@property (nonatomic, assign) NSUInteger consecutiveFailures;
+@property (nonatomic, strong) NSDate *openUntil;
+@property (nonatomic, assign) BOOL trialInProgress;
+@end
+
+@implementation CMISRetryPolicyCircuit
+@end
+
+@interface CMISDefaultRetryPolicy ()
+@property (nonatomic, assign, readwrite) NSUInteger retryCount;
+@property (nonatomic, assign, readwrite) NSUInteger budgetExhaustedCount;
+@property (nonatomic, assign, readwrite) NSUInteger circuitOpenCount;
+@property (nonatomic, assign) double retryBudget;
+@property (nonatomic, strong) NSMutableDictionary *circuits;
+@end
+
+@implementation CMISDefaultRetryPolicy
+
+- (id)init
+{
+    self = [super init];
+    if (self) {
+        self.maxRetryCount = 3;
+        self.initialRetryDelay = 0.5;
+        self.maxRetryDelay = 30;
+        self.maxRetryAfter = 60;
+        NSMutableIndexSet *statusCodes = [NSMutableIndexSet indexSet];
+        [statusCodes addIndex:429];
+        [statusCodes addIndexesInRange:NSMakeRange(502, 3)];
+        self.retryableStatusCodes = statusCodes;
+        self.retryBudgetRatio = 0.2;
+        self.retryBudgetCapacity = 10;
+        self.retryBudget = self.retryBudgetCapacity;
+        self.circuitBreakerFailureThreshold = 5;
+        self.circuitBreakerOpenDuration = 30;
+        self.circuits = [NSMutableDictionary dictionary];
+    }
+    return self;
+}
+
+- (void)setRetryBudgetCapacity:(double)retryBudgetCapacity
+{
+    @synchronized(self) {
+        _retryBudgetCapacity = retryBudgetCapacity;
+        self.retryBudget = MIN(self.retryBudget, retryBudgetCapacity);
+    }
+}
+
++ (id<CMISRetryPolicy>)retryPolicyFromParameter:(id)parameter
+{
+    if ([parameter conformsToProtocol:@protocol(CMISRetryPolicy)]) {
+        return parameter;
+    }
+    return nil;
+}
+
++ (NSTimeInterval)retryAfterIntervalFromHeaderValue:(NSString *)headerValue
+{
+    NSString *value = [headerValue stringByTrimmingCharactersInSet:[NSCharacterSet whitespaceCharacterSet]];
+    if (value.length == 0) {
+        return -1;
+    }
+    
+    NSScanner *scanner = [NSScanner scannerWithString:value];
+    NSInteger seconds;
+    if ([scanner scanInteger:&seconds] && scanner.isAtEnd) {
+        return seconds >= 0 ? seconds : -1;
+    }
+    
+    static NSDateFormatter *httpDateFormatter;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        httpDateFormatter = [[NSDateFormatter alloc] init];
+        httpDateFormatter.locale = [[NSLocale alloc] initWithLocaleIdentifier:@"en_US_POSIX"];
+        httpDateFormatter.timeZone = [NSTimeZone timeZoneWithAbbreviation:@"GMT"];
+        httpDateFormatter.dateFormat = @"EEE, dd MMM yyyy HH:mm:ss zzz";
+    });
+    NSDate *date;
+    @synchronized(httpDateFormatter) {
+        date = [httpDateFormatter dateFromString:value];
+    }
+    if (date == nil) {
+        return -1;
+    }
+    return MAX(0, [date timeIntervalSinceNow]);
+}
+
++ (BOOL)isIdempotentRequest:(NSURLRequest *)request
+{
+    static NSSet *idempotentMethods;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        idempotentMethods = [NSSet setWithObjects:@"GET", @"HEAD", @"PUT", @"DELETE", @"OPTIONS", nil];
+    });
+    NSString *method = request.HTTPMethod.uppercaseString ?: @"GET";
+    return [idempotentMethods containsObject:method];
+}
+
+/// Returns YES if the error shows the request never reached the server, sending it again is safe whatever its method
++ (BOOL)isConnectionNeverMadeError:(NSError *)error
+{
+    if (![error.domain isEqualToString:NSURLErrorDomain]) {
+        return NO;
+    }
+    switch (error.code) {
+        case NSURLErrorCannotFindHost:
+        case NSURLErrorCannotConnectToHost:
+        case NSURLErrorDNSLookupFailed:
+        case NSURLErrorNotConnectedToInternet:
+            return YES;
+        default:
+            return NO;
+    }
+}
+
+/// Returns YES if the error is transient but the server may have processed the request
++ (BOOL)isInterruptedConnectionError:(NSError *)error
+{
+    if (![error.domain isEqualToString:NSURLErrorDomain]) {
+        return NO;
+    }
+    return error.code == NSURLErrorTimedOut || error.code == NSURLErrorNetworkConnectionLost;
+}
+
+#pragma mark - CMISRetryPolicy
+
+- (BOOL)shouldAttemptRequest:(NSURLRequest *)request
+{
+    NSString *host = request.URL.host;
+    @synchronized(self) {
+        CMISRetryPolicyCircuit *circuit = host ? self.circuits[host] : nil;
+        if (circuit.openUntil == nil) {
+            return YES;
+        }
+        // half open once the open duration has passed, a single trial request decides whether the circuit closes
+        if ([circuit.openUntil timeIntervalSinceNow] <= 0 && !circuit.trialInProgress) {
+            circuit.trialInProgress = YES;
+            return YES;
+        }
+        self.circuitOpenCount++;
+        return NO;
+    }
+}
+
+- (NSTimeInterval)retryDelayAfterAttempt:(NSUInteger)attempt
+                               ofRequest:(NSURLRequest *)request
+                                response:(NSHTTPURLResponse *)response
+                                   error:(NSError *)error
+                             rateLimited:(BOOL)rateLimited
+{
+    if ([error.domain isEqualToString:NSURLErrorDomain] && error.code == NSURLErrorCancelled) {
+        [self releaseTrialForHost:request.URL.host];
+        return kCMISRetryPolicyNoRetry;
+    }
+    
+    NSInteger statusCode = response.statusCode;
+    BOOL throttled = rateLimited || statusCode == 429 || statusCode == 503;
+    // only transport failures and gateway or availability errors say the server is struggling, other 5xx responses are
+    // application errors of the request itself and must not fail the requests of everyone else
+    BOOL failed = (error != nil && response == nil) || (statusCode >= 502 && statusCode <= 504);
+    
+    @synchronized(self) {
+        if (attempt == 1) {
+            self.retryBudget = MIN(self.retryBudgetCapacity, self.retryBudget + self.retryBudgetRatio);
+        }
+        [self recordOutcomeForHost:request.URL.host failed:failed];
+    }
+    
+    BOOL retryable;
+    if ([CMISDefaultRetryPolicy isConnectionNeverMadeError:error] || throttled) {
+        retryable = YES;
+    } else if ([CMISDefaultRetryPolicy isInterruptedConnectionError:error] || [self.retryableStatusCodes containsIndex:statusCode]) {
+        retryable = [CMISDefaultRetryPolicy isIdempotentRequest:request];
+    } else {
+        retryable = NO;
+    }
+    if (!retryable || attempt > self.maxRetryCount) {
+        return kCMISRetryPolicyNoRetry;
+    }
+    
+    NSTimeInterval delay;
+    NSString *retryAfterValue = response.allHeaderFields[@"Retry-After"];
+    NSTimeInterval retryAfter = retryAfterValue ? [CMISDefaultRetryPolicy retryAfterIntervalFromHeaderValue:retryAfterValue] : -1;
+    if (retryAfter > self.maxRetryAfter) {
+        return kCMISRetryPolicyNoRetry;
+    } else if (retryAfter >= 0) {
+        delay = retryAfter;
+    } else {
+        // full jitter: a random delay up to the exponential backoff spreads out clients that failed at the same time
+        NSTimeInterval backoff = MIN(self.maxRetryDelay, self.initialRetryDelay * pow(2, attempt - 1));
+        delay = backoff * ((double)arc4random_uniform(10001) / 10000.0);
+    }
+    
+    @synchronized(self) {
+        if (self.retryBudget < 1) {
+            self.budgetExhaustedCount++;
+            return kCMISRetryPolicyNoRetry;
+        }
+        self.retryBudget -= 1;
+        self.retryCount++;
+    }
+    return delay;
+}
+
+- (BOOL)isCircuitOpenForHost:(NSString *)host
+{
+    if (host == nil) {
+        return NO;
+    }
+    @synchronized(self) {
+        return [self.circuits[host] openUntil] != nil;
+    }
+}
+
+#pragma mark - Circuit breaker
+
+/// Must be called while synchronized on self
+- (void)recordOutcomeForHost:(NSString *)host failed:(BOOL)failed
+{
+    if (host == nil || self.circuitBreakerFailureThreshold == 0) {
+        return;
+    }
+    CMISRetryPolicyCircuit *circuit = self.circuits[host];
+    if (!failed) {
+        [self.circuits removeObjectForKey:host];
+        return;
+    }
+    if (circuit == nil) {
+        circuit = [CMISRetryPolicyCircuit new];
+        self.circuits[host] = circuit;
+    }
+    circuit.consecutiveFailures++;
+    if (circuit.trialInProgress || circuit.consecutiveFailures >= self.circuitBreakerFailureThreshold) {
+        circuit.openUntil = [NSDate dateWithTimeIntervalSinceNow:self.circuitBreakerOpenDuration];
+        circuit.trialInProgress = NO;
+    }
+}
+
+- (void)releaseTrialForHost:(NSString *)host
+{
+    if (host == nil) {
+        return;
+    }
+    @synchronized(self) {
+        [self.circuits[host] setTrialInProgress:NO];
+    }
+}
+
+@end
@@ -0,0 +1,48 @@
+/*
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing,
+  software distributed under the License is distributed on an
+  "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+  KIND, either express or implied.  See the License for the
+  specific language governing permissions and limitations
+  under the License.
+ */
+ 
+#import <Foundation/Foundation.h>
+
+/**
+ * Builds a URL string from a base URL and any number of query parameters in a single buffer, which avoids the copy and
+ * rescan of the whole URL that every call to CMISURLUtil's urlStringByAppendingParameter methods costs.
+ * Parameters with a nil name or value are ignored, as they are by CMISURLUtil.
+ */
+@interface CMISURLBuilder : NSObject
+
+/// The URL string built so far
+@property (nonatomic, strong, readonly) NSString *urlString;
+
+/// The URL built so far
+@property (nonatomic, strong, readonly) NSURL *url;
+
+- (id)initWithUrlString:(NSString *)urlString;
+
++ (CMISURLBuilder *)builderWithUrlString:(NSString *)urlString;
+
+/// appends the given parameter with the given string value, the value is encoded
+- (void)addParameter:(NSString *)parameterName value:(NSString *)parameterValue;
+
+/// appends the given parameter with the given boolean value
+- (void)addParameter:(NSString *)parameterName boolValue:(BOOL)parameterValue;
+
+/// appends the given parameter with the given number value
+- (void)addParameter:(NSString *)parameterName numberValue:(NSNumber *)parameterValue;
+
+@end
@@ -0,0 +1,94 @@
+/*
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing,
+  software distributed under the License is distributed on an
+  "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+  KIND, either express or implied.  See the License for the
+  specific language governing permissions and limitations
+  under the License.
+ */
+ 
+#import "CMISURLBuilder.h"
+#import "CMISURLUtil.h"
+#import "CMISConstants.h"
+
+@interface CMISURLBuilder ()
+@property (nonatomic, strong) NSMutableString *buffer;
+@property (nonatomic, assign) BOOL hasQuery;
+@property (nonatomic, assign) BOOL needsSeparator;
+@end
+
+@implementation CMISURLBuilder
+
+- (id)initWithUrlString:(NSString *)urlString
+{
+    self = [super init];
+    if (self) {
+        if (urlString) {
+            self.buffer = [NSMutableString stringWithCapacity:urlString.length + 256];
+            [self.buffer appendString:urlString];
+            
+            // the url is only scanned once for an existing query, parameters are then appended without looking back
+            NSRange queryRange = [urlString rangeOfString:@"?"];
+            self.hasQuery = (queryRange.location != NSNotFound);
+            // only add ampersand if there is already a parameter added
+            self.needsSeparator = self.hasQuery && (queryRange.location != urlString.length - 1);
+        }
+    }
+    return self;
+}
+
++ (CMISURLBuilder *)builderWithUrlString:(NSString *)urlString
+{
+    return [[self alloc] initWithUrlString:urlString];
+}
+
+- (void)addParameter:(NSString *)parameterName value:(NSString *)parameterValue
+{
+    if (parameterName == nil || parameterValue == nil || self.buffer == nil) {
+        return;
+    }
+    
+    if (!self.hasQuery) {
+        [self.buffer appendString:@"?"];
+        self.hasQuery = YES;
+    } else if (self.needsSeparator) {
+        [self.buffer appendString:@"&"];
+    }
+    [self.buffer appendString:parameterName];
+    [self.buffer appendString:@"="];
+    [self.buffer appendString:[CMISURLUtil encodeUrlParameterValue:parameterValue]];
+    self.needsSeparator = YES;
+}
+
+- (void)addParameter:(NSString *)parameterName boolValue:(BOOL)parameterValue
+{
+    [self addParameter:parameterName value:parameterValue ? kCMISParameterValueTrue : kCMISParameterValueFalse];
+}
+
+- (void)addParameter:(NSString *)parameterName numberValue:(NSNumber *)parameterValue
+{
+    [self addParameter:parameterName value:[parameterValue stringValue]];
+}
+
+- (NSString *)urlString
+{
+    return [self.buffer copy];
+}
+
+- (NSURL *)url
+{
+    NSString *urlString = self.urlString;
+    return urlString ? [NSURL URLWithString:urlString] : nil;
+}
+
+@end
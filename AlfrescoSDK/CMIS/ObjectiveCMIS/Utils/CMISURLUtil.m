@@ -18,6 +18,7 @@
  */
  
 #import "CMISURLUtil.h"
+#import "CMISURLBuilder.h"
 #import "CMISConstants.h"
 
 NSString * const kCMISRFC7232Reserved = @";?:@&=+$,[]";
@@ -42,23 +43,9 @@ NSString * const kCMISRFC3986Reserved = @"!*'();:@&=+$,/?%#[]";
         return urlString;
     }
 
-    NSMutableString *result = [NSMutableString stringWithString:urlString];
-
-    // Append '?' if not yet in url, else append ampersand
-    if ([result rangeOfString:@"?"].location == NSNotFound) {
-        [result appendString:@"?"];
-    } else {
-        if([result rangeOfString:@"?"].location != result.length -1){ // Only add ampersand if there is already a parameter added
-            [result appendString:@"&"];
-        }
-    }
-
-    // Append param
-    [result appendString:parameterName];
-    [result appendString:@"="];
-    [result appendString:[CMISURLUtil encodeUrlParameterValue:parameterValue]];
-
-    return result;
+    CMISURLBuilder *urlBuilder = [CMISURLBuilder builderWithUrlString:urlString];
+    [urlBuilder addParameter:parameterName value:parameterValue];
+    return urlBuilder.urlString;
 }
 
 + (NSString *)urlStringByAppendingPath:(NSString *)path urlString:(NSString *)urlString
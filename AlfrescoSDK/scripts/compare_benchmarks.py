@@ -0,0 +1,70 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2005-2020 Alfresco Software Limited.
+#
+# This file is part of the Alfresco Mobile SDK.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#  http://www.apache.org/licenses/LICENSE-2.0
+#
+#  Unless required by applicable law or agreed to in writing, software
+#  distributed under the License is distributed on an "AS IS" BASIS,
+#  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+#  See the License for the specific language governing permissions and
+#  limitations under the License.
+
+"""Compares two result files written by AlfrescoBenchmarkTests.
+
+Exits with a non-zero status when the median of any scenario present in both
+files grew by more than the threshold percentage.
+"""
+
+import argparse
+import json
+import sys
+
+
+def load_results(path):
+    with open(path) as results_file:
+        return json.load(results_file).get('results', {})
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument('baseline', help='results of the reference run')
+    parser.add_argument('current', help='results of the run being checked')
+    parser.add_argument('--threshold', type=float, default=10.0,
+                        help='percentage a median may grow before it counts as a regression (default 10)')
+    args = parser.parse_args()
+
+    baseline = load_results(args.baseline)
+    current = load_results(args.current)
+
+    regressions = []
+    print('%-36s %12s %12s %9s' % ('scenario', 'baseline', 'current', 'change'))
+    for scenario in sorted(set(baseline) | set(current)):
+        before = baseline.get(scenario, {}).get('median')
+        after = current.get(scenario, {}).get('median')
+        if before is None or after is None:
+            print('%-36s %12s %12s %9s' % (scenario, before or '-', after or '-', 'n/a'))
+            continue
+
+        change = ((after - before) / before * 100.0) if before > 0 else 0.0
+        marker = ''
+        if change > args.threshold:
+            regressions.append(scenario)
+            marker = '  REGRESSION'
+        print('%-36s %11.4fs %11.4fs %+8.1f%%%s' % (scenario, before, after, change, marker))
+
+    if regressions:
+        print('\n%d scenario(s) regressed by more than %.1f%%: %s'
+              % (len(regressions), args.threshold, ', '.join(regressions)))
+        return 1
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,75 @@
+#!/bin/bash
+
+# Copyright (C) 2005-2020 Alfresco Software Limited.
+#
+# This file is part of the Alfresco Mobile SDK.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#  http://www.apache.org/licenses/LICENSE-2.0
+#
+#  Unless required by applicable law or agreed to in writing, software
+#  distributed under the License is distributed on an "AS IS" BASIS,
+#  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+#  See the License for the specific language governing permissions and
+#  limitations under the License.
+
+. ${ALFRESCO_SDK_SCRIPT:-$(dirname $0)}/common.sh
+
+# -----------------------------------------------------------------------------
+# Script Parameters
+#
+underline=`tput smul`
+nounderline=`tput rmul`
+bold=`tput bold`
+normal=`tput sgr0`
+
+usage ()
+{
+   echo 
+   echo "usage: $(basename $0) ${underline}results file${nounderline} [${underline}baseline file${nounderline}]"
+   echo "  results file : JSON file the benchmark results are written to"
+   echo "  baseline file : previous results to compare against, the script fails if a scenario regressed"
+   echo
+   echo "  The stub server and workload can be tuned with the following environment variables:"
+   echo "  BENCHMARK_ITERATIONS, BENCHMARK_CHILD_COUNT, BENCHMARK_SEARCH_RESULT_COUNT, BENCHMARK_SITE_COUNT,"
+   echo "  BENCHMARK_CONTENT_MB, BENCHMARK_LATENCY_MS, BENCHMARK_BANDWIDTH_KBPS, BENCHMARK_FAILURE_RATE"
+   echo "  and BENCHMARK_THRESHOLD (percentage a median may grow before it counts as a regression, defaults to 10)"
+   echo
+   exit 1
+}
+
+if [[ "$1" == "" ]] ; then
+   usage
+fi
+
+RESULTS_FILE=$1
+BASELINE_FILE=$2
+
+# xcodebuild only passes environment variables prefixed with TEST_RUNNER_ through to the test process
+for variable in BENCHMARK_ITERATIONS BENCHMARK_CHILD_COUNT BENCHMARK_SEARCH_RESULT_COUNT BENCHMARK_SITE_COUNT \
+                BENCHMARK_CONTENT_MB BENCHMARK_LATENCY_MS BENCHMARK_BANDWIDTH_KBPS BENCHMARK_FAILURE_RATE
+do
+   if [[ -n "${!variable}" ]] ; then
+      export TEST_RUNNER_${variable}="${!variable}"
+   fi
+done
+
+if [[ -f "$RESULTS_FILE" ]] ; then
+   progress_message "Removing previous benchmark results..."
+   rm "$RESULTS_FILE"
+fi
+
+progress_message "Running benchmarks, results will be written to $RESULTS_FILE..."
+$XCODEBUILD test -scheme $ALFRESCO_SDK_PRODUCT_NAME -destination OS=latest,name="iPhone 6" \
+   -only-testing:AlfrescoSDK-iOSTests/AlfrescoBenchmarkTests BENCHMARK_RESULTS="$RESULTS_FILE"
+if [[ $? -ne 0 ]] ; then
+   exit 1
+fi
+
+if [[ -n "$BASELINE_FILE" ]] ; then
+   progress_message "Comparing against $BASELINE_FILE..."
+   python3 $(dirname $0)/compare_benchmarks.py "$BASELINE_FILE" "$RESULTS_FILE" --threshold ${BENCHMARK_THRESHOLD:-10}
+fi